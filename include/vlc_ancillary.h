@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 
+#include <vlc_tick.h>
+
 /**
  * \defgroup ancillary Ancillary
  * \ingroup input
@@ -217,6 +219,35 @@ typedef struct vlc_icc_profile_t
     uint8_t data[]; /* binary profile data, see ICC.1:2022 (or later) */
 } vlc_icc_profile_t;
 
+/**
+ * Per-frame QoS timestamp ledger
+ *
+ * Compact record of when a frame went through each stage of the video
+ * pipeline, stamped by the core as the frame travels from the decoder fifo
+ * to the display. It is only attached when the "frame-qos" option is
+ * enabled; the stages aggregate the stamps into latency histograms that the
+ * video output logs when it stops.
+ */
+
+#define VLC_ANCILLARY_ID_FRAMEQOS VLC_FOURCC('f','Q','o','S')
+
+enum vlc_frame_qos_stage
+{
+    VLC_FRAME_QOS_DEMUX_OUT = 0,  /**< frame queued to the decoder fifo */
+    VLC_FRAME_QOS_DECODE_START,   /**< frame submitted to the decoder module */
+    VLC_FRAME_QOS_DECODE_END,     /**< picture queued by the decoder module */
+    VLC_FRAME_QOS_FILTER_END,     /**< picture out of the vout filter chains */
+    VLC_FRAME_QOS_RENDER,         /**< picture prepared by the display */
+    VLC_FRAME_QOS_DISPLAY,        /**< picture submitted to the display */
+    VLC_FRAME_QOS_STAGE_COUNT
+};
+
+typedef struct vlc_frame_qos_t
+{
+    /** vlc_tick_now() date per stage, VLC_TICK_INVALID when not reached */
+    vlc_tick_t stages[VLC_FRAME_QOS_STAGE_COUNT];
+} vlc_frame_qos_t;
+
 /**
  * VPx alpha data
  */
@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * vlc_arena.h: region-based memory allocator
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_ARENA_H
+#define VLC_ARENA_H
+
+#include <vlc_common.h>
+
+/**
+ * \defgroup arena Arena allocator
+ * \ingroup cext
+ *
+ * Region-based memory allocator.
+ *
+ * An arena hands out small allocations from larger chunks and frees them
+ * all at once when it is deleted. It is intended for parsers building many
+ * short-lived nodes sharing a single lifetime (e.g. a demuxer box tree),
+ * where individual malloc()/free() calls would dominate the profile.
+ *
+ * Arenas are not thread-safe: a given arena must only be used from one
+ * thread at a time. Individual allocations cannot be freed.
+ *
+ * @{
+ */
+
+typedef struct vlc_arena vlc_arena_t;
+
+/**
+ * Create a new arena.
+ *
+ * \param chunk_size granularity of the underlying allocations (a larger
+ *                   value means fewer malloc() calls but more memory held);
+ *                   allocations larger than this still succeed, using a
+ *                   dedicated chunk
+ * \return a new arena, or NULL on allocation error
+ */
+VLC_API vlc_arena_t *vlc_arena_New(size_t chunk_size) VLC_USED;
+
+/**
+ * Allocate memory from an arena.
+ *
+ * The returned memory is uninitialized, suitably aligned for any built-in
+ * type, and remains valid until vlc_arena_Delete() is called. It must not
+ * be passed to free() or realloc().
+ *
+ * \param arena the arena
+ * \param size number of bytes to allocate
+ * \return a pointer to the allocated memory, or NULL on error
+ */
+VLC_API void *vlc_arena_Alloc(vlc_arena_t *arena, size_t size)
+VLC_USED VLC_MALLOC;
+
+/**
+ * Delete an arena and free every allocation made from it at once.
+ *
+ * \param arena the arena
+ */
+VLC_API void vlc_arena_Delete(vlc_arena_t *arena);
+
+/** @} */
+
+#endif
@@ -71,12 +71,15 @@ static inline int bo_extend(bo_t *p_bo, size_t i_total)
     const size_t i_size = p_bo->b->i_size - (p_bo->b->p_buffer - p_bo->b->p_start);
     if (i_total >= i_size)
     {
-        int i_growth = p_bo->basesize;
-        while(i_total >= i_size + i_growth)
-            i_growth += p_bo->basesize;
+        /* Grow geometrically, so that appending remains amortized linear
+         * even for boxes far larger than the base size (sample tables of
+         * long recordings can reach tens of megabytes) */
+        size_t i_newsize = i_size ? i_size : p_bo->basesize;
+        while(i_total >= i_newsize)
+            i_newsize *= 2;
 
         int i = p_bo->b->i_buffer; /* Realloc would set payload size == buffer size */
-        p_bo->b = block_Realloc(p_bo->b, 0, i_size + i_growth);
+        p_bo->b = block_Realloc(p_bo->b, 0, i_newsize);
         if (!p_bo->b)
             return false;
         p_bo->b->i_buffer = i;
@@ -66,6 +66,9 @@ struct decoder_owner_callbacks
             /* Display rate
              * cf. decoder_GetDisplayRate */
             float       (*get_display_rate)( decoder_t * );
+            /* Display chroma
+             * cf. decoder_GetDisplayChroma */
+            vlc_fourcc_t (*get_display_chroma)( decoder_t * );
         } video;
         struct
         {
@@ -115,6 +118,11 @@ struct decoder_t
     /* Tell the decoder if it is allowed to drop frames */
     bool                b_frame_drop_allowed;
 
+    /* Tell the decoder that only one usable picture is wanted (thumbnail
+     * extraction): it may trade fidelity for speed, e.g. decode at reduced
+     * resolution or skip in-loop filtering. */
+    bool                b_thumbnailing;
+
     /**
      * Number of extra (ie in addition to the DPB) picture buffers
      * needed for decoding.
@@ -571,6 +579,25 @@ static inline float decoder_GetDisplayRate( decoder_t *dec )
     return dec->cbs->video.get_display_rate( dec );
 }
 
+/**
+ * Get the chroma currently consumed by the video display, if any.
+ *
+ * This is only a negotiation hint: a decoder able to output several formats
+ * may pick the one matching the display to spare a converter in the video
+ * output filter chain. It must cope with any other format being displayed.
+ *
+ * \return the display chroma, or 0 when no display is set up (yet)
+ */
+static inline vlc_fourcc_t decoder_GetDisplayChroma( decoder_t *dec )
+{
+    vlc_assert( dec->fmt_in->i_cat == VIDEO_ES && dec->cbs != NULL );
+
+    if( !dec->cbs->video.get_display_chroma )
+        return 0;
+
+    return dec->cbs->video.get_display_chroma( dec );
+}
+
 /** @} */
 
 /**
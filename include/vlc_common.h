@@ -91,6 +91,35 @@
 #  define VLC_NOINLINE_FUNC
 # endif
 
+# if __has_attribute(hot)
+#  define VLC_HOT  __attribute__((hot))
+# else
+/**
+ * Hot function annotation
+ *
+ * Use this macro in front of the definition of a function known to sit on a
+ * per-sample or per-packet path. The compiler may optimize it more
+ * aggressively and group it with other hot functions in the text section,
+ * reducing instruction cache misses. Keep it for functions backed by
+ * profiling; most code does not qualify.
+ */
+#  define VLC_HOT
+# endif
+
+# if __has_attribute(cold)
+#  define VLC_COLD  __attribute__((cold))
+# else
+/**
+ * Cold function annotation
+ *
+ * Use this macro in front of the definition of a function that is rarely
+ * executed (error handling, reloads, teardown). The compiler may optimize it
+ * for size, move it out of the hot text section and treat all paths leading
+ * to it as unlikely.
+ */
+#  define VLC_COLD
+# endif
+
 # if __has_attribute(deprecated)
 #  define VLC_DEPRECATED  __attribute__((deprecated))
 # else
@@ -152,10 +181,14 @@
 # define VLC_MALLOC
 // # define VLC_DEPRECATED __declspec(deprecated)
 # define VLC_DEPRECATED
+# define VLC_HOT
+# define VLC_COLD
 #else // !GCC && !MSVC
 # define VLC_USED
 # define VLC_MALLOC
 # define VLC_DEPRECATED
+# define VLC_HOT
+# define VLC_COLD
 #endif
 
 
@@ -297,6 +297,16 @@ VLC_API int demux_vaControlHelper( stream_t *, int64_t i_start, int64_t i_end,
 VLC_API int demux_Demux( demux_t *p_demux ) VLC_USED;
 VLC_API int demux_vaControl( demux_t *p_demux, int i_query, va_list args );
 
+/**
+ * Sends a chain of blocks for one ES to the demuxer's es_out.
+ *
+ * cf. es_out_SendBatch(). This is preferable to calling es_out_Send() once
+ * per block when a demux iteration produces several blocks for the same ES.
+ * Ownership of the whole chain is transferred; a NULL chain is a no-op.
+ */
+VLC_API int demux_SendBatch( demux_t *p_demux, es_out_id_t *id,
+                             block_t *p_chain );
+
 static inline int demux_Control( demux_t *p_demux, int i_query, ... )
 {
     va_list args;
@@ -615,6 +625,29 @@ VLC_API vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
                                                    const char *name,
                                                    es_out_t *out);
 
+/**
+ * Creates a pull-mode chained demuxer.
+ *
+ * Unlike vlc_demux_chained_New(), no thread is spawned: the chained demuxer
+ * runs on the caller thread, inside vlc_demux_chained_Send(), until the
+ * queued data is exhausted. Queued blocks are passed through without copy
+ * when the chained demuxer reads whole blocks.
+ *
+ * \warning This only works with demuxers that treat a short read as a
+ * transient end-of-stream and retry on the next call, without blocking and
+ * without corrupting their state; streamable formats (e.g. MPEG-TS, Ogg)
+ * behave that way. The limitations of vlc_demux_chained_New() on controls
+ * and seeking apply here too.
+ *
+ * \param parent parent VLC object
+ * \param name chained demux module name (e.g. "ts")
+ * \param out elementary stream output for the chained demux
+ * \return a non-NULL pointer on success, NULL on failure.
+ */
+VLC_API vlc_demux_chained_t *vlc_demux_chained_NewPull(vlc_object_t *parent,
+                                                       const char *name,
+                                                       es_out_t *out);
+
 /**
  * Destroys a chained demuxer.
  *
@@ -693,6 +693,16 @@ VLC_API int es_format_Copy( es_format_t *p_dst, const es_format_t *p_src );
  */
 VLC_API void es_format_Clean( es_format_t *fmt );
 
+/**
+ * This function will replace an initialized es_format_t by a copy of
+ * another one.
+ *
+ * It is equivalent to es_format_Clean() followed by es_format_Copy(),
+ * except that nothing is reallocated when both formats are identical, so
+ * repeated format re-announcements (e.g. from adaptive streams) are cheap.
+ */
+VLC_API int es_format_Update( es_format_t *p_dst, const es_format_t *p_src );
+
 /**
  * This function will check if the first ES format is similar
  * to the second one.
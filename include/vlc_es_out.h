@@ -24,6 +24,7 @@
 #define VLC_ES_OUT_H 1
 
 #include <vlc_es.h>
+#include <vlc_frame.h>
 
 #include <vlc_tick.h>
 
@@ -128,6 +129,9 @@ struct es_out_callbacks
 {
     es_out_id_t *(*add)(es_out_t *, input_source_t *in, const es_format_t *);
     int          (*send)(es_out_t *, es_out_id_t *, block_t *);
+    /** Optional: sends a whole block chain in one transaction. May be NULL,
+     * in which case es_out_SendBatch() falls back on send(). */
+    int          (*send_batch)(es_out_t *, es_out_id_t *, block_t *);
     void         (*del)(es_out_t *, es_out_id_t *);
     int          (*control)(es_out_t *, input_source_t *in, int query, va_list);
     void         (*destroy)(es_out_t *);
@@ -155,6 +159,34 @@ static inline int es_out_Send( es_out_t *out, es_out_id_t *id,
     return out->cbs->send( out, id, p_block );
 }
 
+/**
+ * Sends a chain of blocks for one ES in a single transaction.
+ *
+ * This amortizes the per-block locking and clock bookkeeping of
+ * es_out_Send() when a demuxer has several blocks ready for the same ES.
+ * Ownership of the whole chain is transferred to the es_out.
+ */
+static inline int es_out_SendBatch( es_out_t *out, es_out_id_t *id,
+                                    block_t *p_chain )
+{
+    if( out->cbs->send_batch != NULL )
+        return out->cbs->send_batch( out, id, p_chain );
+
+    int ret = VLC_SUCCESS;
+    while( p_chain != NULL )
+    {
+        block_t *p_block = p_chain;
+
+        p_chain = p_block->p_next;
+        p_block->p_next = NULL;
+
+        int err = out->cbs->send( out, id, p_block );
+        if( err != VLC_SUCCESS )
+            ret = err;
+    }
+    return ret;
+}
+
 static inline int es_out_vaControl( es_out_t *out, int i_query, va_list args )
 {
     return out->cbs->control( out, NULL, i_query, args );
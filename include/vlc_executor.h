@@ -60,6 +60,7 @@ struct vlc_runnable {
 
     /* Private data used by the vlc_executor_t (do not touch) */
     struct vlc_list node;
+    vlc_tick_t deadline;
 };
 
 /**
@@ -145,6 +146,40 @@ vlc_executor_Delete(vlc_executor_t *executor);
 VLC_API void
 vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable);
 
+/**
+ * Submit a runnable for execution ahead of the pending queue.
+ *
+ * Same contract as vlc_executor_Submit(), except that the runnable is
+ * executed before all currently pending (not yet started) runnables. Useful
+ * for latency-sensitive tasks, e.g. preparsing the items currently visible
+ * on screen while thousands of background items are queued.
+ *
+ * \param executor the executor
+ * \param runnable the task to run
+ */
+VLC_API void
+vlc_executor_SubmitUrgent(vlc_executor_t *executor,
+                          struct vlc_runnable *runnable);
+
+/**
+ * Submit a runnable with a completion deadline.
+ *
+ * Same contract as vlc_executor_Submit(), except that pending runnables are
+ * started in deadline order: a runnable with an earlier deadline is executed
+ * before one with a later deadline, regardless of submission order. The
+ * deadline is a scheduling hint only; nothing aborts a runnable that misses
+ * it. Runnables submitted with vlc_executor_Submit() behave as if their
+ * deadline were infinitely far away.
+ *
+ * \param executor the executor
+ * \param runnable the task to run
+ * \param deadline the vlc_tick_now() based completion target
+ */
+VLC_API void
+vlc_executor_SubmitDeadline(vlc_executor_t *executor,
+                            struct vlc_runnable *runnable,
+                            vlc_tick_t deadline);
+
 /**
  * Cancel a runnable previously submitted.
  *
@@ -129,6 +129,17 @@ struct vlc_filter_operations
      */
     void (*change_viewpoint)(filter_t *, const vlc_viewpoint_t *);
 
+    /** Change the input format (optional).
+     *
+     * Asks the filter to adopt a new input format without being closed and
+     * reopened. On success, the filter must have updated fmt_in, vctx_in and,
+     * where its output follows the input, fmt_out/vctx_out accordingly.
+     * If this callback is NULL or fails, the owner re-creates the filter
+     * instead.
+     */
+    int (*change_fmt)(filter_t *, const es_format_t *fmt_in,
+                      vlc_video_context *vctx_in);
+
     /** Filter mouse state (video filter).
      *
      * If non-NULL, you must convert from output to input formats:
@@ -524,6 +535,28 @@ VLC_API void filter_chain_Reset( filter_chain_t *p_chain,
                                  vlc_video_context *vctx_in,
                                  const es_format_t *p_fmt_out );
 
+/**
+ * Renegotiate the chain formats in place.
+ *
+ * Propagates a new input format through the existing filters without tearing
+ * the chain down: each filter is asked to adopt its new input format via the
+ * change_fmt operation, and only filters that refuse (or do not implement it)
+ * are re-created, reusing the same module without a new probe round.
+ *
+ * On failure, the chain is left in an undefined state and must be rebuilt
+ * with filter_chain_Reset() as on any other format change.
+ *
+ * \param p_chain pointer to filter chain
+ * \param p_fmt_in new fmt_in params
+ * \param vctx_in new input video context
+ * \param p_fmt_out new fmt_out params
+ * \return VLC_SUCCESS if every filter adopted the new formats
+ */
+VLC_API int filter_chain_ChangeFormat( filter_chain_t *p_chain,
+                                       const es_format_t *p_fmt_in,
+                                       vlc_video_context *vctx_in,
+                                       const es_format_t *p_fmt_out );
+
 /**
  * Remove all existing filters
  *
@@ -182,6 +182,20 @@ VLC_API input_attachment_t *vlc_input_attachment_New( const char *psz_name,
                                                       const void *p_data,
                                                       size_t i_data );
 
+/**
+ * Creates an attachment, taking ownership of the data buffer.
+ *
+ * Unlike vlc_input_attachment_New(), the payload is not copied: the
+ * attachment adopts the heap-allocated buffer, which will be released with
+ * free(), including on failure or when an identical payload is already
+ * shared with another attachment.
+ */
+VLC_API input_attachment_t *vlc_input_attachment_NewFromData( const char *psz_name,
+                                                              const char *psz_mime,
+                                                              const char *psz_description,
+                                                              void *p_data,
+                                                              size_t i_data );
+
 VLC_API input_attachment_t *vlc_input_attachment_Hold( input_attachment_t *a );
 
 /**
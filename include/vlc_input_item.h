@@ -204,6 +204,12 @@ struct input_item_node_t
     input_item_t *         p_item;
     int                    i_children;
     input_item_node_t      **pp_children;
+
+    /* Private: periodic announcement hook set by the node owner for
+     * streaming directory reads. Do not use directly, see
+     * input_item_node_Flush(). */
+    void                   (*pf_flush)( input_item_node_t *, void * );
+    void *                 p_flush_opaque;
 };
 
 VLC_API void input_item_CopyOptions( input_item_t *p_child, input_item_t *p_parent );
@@ -232,6 +238,18 @@ VLC_API void input_item_node_AppendNode( input_item_node_t *p_parent, input_item
 VLC_API void input_item_node_RemoveNode( input_item_node_t *parent,
                                          input_item_node_t *child );
 
+/**
+ * Announce the children added to the node so far without waiting for the
+ * directory read to complete.
+ *
+ * Directory/playlist readers may call this periodically (e.g. every few
+ * hundred entries) so that the first items of a large playlist become
+ * available while parsing continues. The announced children are detached
+ * from the node. No-op when the node owner does not support streaming
+ * announcements.
+ */
+VLC_API void input_item_node_Flush( input_item_node_t *p_node );
+
 /**
  * Delete a node created with input_item_node_Create() and all its children.
  */
@@ -550,6 +568,14 @@ struct input_stats_t
     /* Aout */
     uint64_t i_played_abuffers;
     uint64_t i_lost_abuffers;
+
+    /* CPU time, expressed in VLC ticks, or 0 when unsupported */
+    uint64_t i_demux_cpu;
+    uint64_t i_decoder_cpu;
+
+    /* Timeshift buffer occupancy */
+    uint64_t i_timeshift_ram_bytes;
+    uint64_t i_timeshift_spill_bytes;
 };
 
 /**
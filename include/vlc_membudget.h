@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * vlc_membudget.h: LibVLC instance memory budget
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_MEMBUDGET_H_
+#define VLC_MEMBUDGET_H_ 1
+
+#include <vlc_list.h>
+
+/**
+ * \defgroup membudget Memory budget
+ * \ingroup vlc
+ *
+ * Shared memory budget of a LibVLC instance.
+ *
+ * Caches and queues throughout the pipeline (stream read-ahead, decoder
+ * FIFOs, picture pools...) size themselves independently; on constrained
+ * systems the sum can overrun the available memory under multi-input load.
+ * When the "memory-budget" option is set, consumers registered here share
+ * one per-instance ceiling: each reports its planned usage, and when the
+ * sum exceeds the budget, the largest consumers are asked to trim in turn
+ * until the total fits again.
+ *
+ * Registration is always permitted; when no budget is configured, all
+ * operations are no-ops with negligible cost.
+ *
+ * @{
+ * \file
+ * Memory budget interface
+ */
+
+struct vlc_membudget_cbs
+{
+    /**
+     * Requests that the consumer shrinks toward the given target.
+     *
+     * Called with the budget lock held: the callback may update its own
+     * usage with vlc_membudget_SetUsage() but must not attach or detach
+     * clients, and must not block. The target is advisory; a consumer
+     * that cannot release memory right away may shrink lazily and report
+     * the lower usage once done.
+     *
+     * \param data opaque pointer of the client
+     * \param target_bytes usage the consumer should shrink to
+     */
+    void (*trim)(void *data, size_t target_bytes);
+};
+
+/**
+ * Memory budget client.
+ *
+ * The structure is allocated by the consumer and must remain valid from
+ * vlc_membudget_Attach() to vlc_membudget_Detach(). All members are
+ * private to the budget implementation.
+ */
+struct vlc_membudget_client
+{
+    struct vlc_list node;
+    struct vlc_membudget *budget;
+    const char *name;
+    const struct vlc_membudget_cbs *cbs;
+    void *data;
+    size_t usage;
+    unsigned epoch;
+};
+
+/**
+ * Registers a memory consumer with the instance budget.
+ *
+ * \param obj VLC object used to reach the LibVLC instance
+ * \param client caller-allocated client storage
+ * \param name static stage name for introspection (e.g. "prefetch")
+ * \param cbs pressure callbacks (or NULL if the consumer cannot shrink)
+ * \param data opaque pointer passed to the callbacks
+ */
+VLC_API void vlc_membudget_Attach(vlc_object_t *obj,
+                                  struct vlc_membudget_client *client,
+                                  const char *name,
+                                  const struct vlc_membudget_cbs *cbs,
+                                  void *data);
+
+/**
+ * Unregisters a memory consumer, dropping its accounted usage.
+ */
+VLC_API void vlc_membudget_Detach(struct vlc_membudget_client *client);
+
+/**
+ * Updates the usage accounted to a consumer.
+ *
+ * If the new total exceeds the configured budget, pressure callbacks are
+ * invoked synchronously from this call.
+ *
+ * \param usage planned or current usage of the consumer, in bytes
+ */
+VLC_API void vlc_membudget_SetUsage(struct vlc_membudget_client *client,
+                                    size_t usage);
+
+/**
+ * Enumerates the registered consumers and their usage.
+ *
+ * The callback is invoked with the budget lock held and must not call
+ * back into the budget.
+ *
+ * \return the total accounted usage in bytes (0 when no budget is set)
+ */
+VLC_API size_t vlc_membudget_Enum(vlc_object_t *obj,
+                                  void (*cb)(void *, const char *name,
+                                             size_t usage), void *opaque);
+
+/** @} */
+#endif
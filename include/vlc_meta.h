@@ -102,6 +102,18 @@ VLC_API unsigned vlc_meta_GetExtraCount( const vlc_meta_t *m );
  */
 VLC_API char ** vlc_meta_CopyExtraNames( const vlc_meta_t *m ) VLC_USED;
 
+/**
+ * Calls cb on every extra meta of m, without copying names nor values.
+ *
+ * The callback must not add or remove extra meta. The passed strings are
+ * only valid for the duration of the call.
+ */
+VLC_API void vlc_meta_ForeachExtra( const vlc_meta_t *m,
+                                    void (*cb)( const char *psz_name,
+                                                const char *psz_value,
+                                                void *data ),
+                                    void *data );
+
 VLC_API void vlc_meta_Merge( vlc_meta_t *dst, const vlc_meta_t *src );
 
 VLC_API int vlc_meta_GetStatus( vlc_meta_t *m );
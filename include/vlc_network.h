@@ -311,6 +311,31 @@ VLC_API int vlc_getaddrinfo (const char *node, unsigned i_port,
 VLC_API int vlc_getaddrinfo_i11e(const char *, unsigned,
                                  const struct addrinfo *, struct addrinfo **);
 
+/**
+ * Resolves a host name with caching (like vlc_getaddrinfo_i11e()).
+ *
+ * Successful resolutions are kept in a process-wide cache for
+ * --dns-cache-ttl seconds, so that repeatedly connecting to the same few
+ * servers (e.g. when zapping between streams) does not block on DNS every
+ * time. Concurrent lookups for the same name share a single resolution.
+ *
+ * @param node host name to resolve (encoded as UTF-8), or NULL
+ * @param i_port port number for the socket addresses
+ * @param p_hints parameters (see getaddrinfo() manual page)
+ * @param res pointer set to the resulting chained list.
+ * @return 0 on success, a getaddrinfo() error otherwise.
+ * On failure, *res is undefined. On success, it must be freed with
+ * vlc_resolver_Free(), <b>not</b> with freeaddrinfo().
+ */
+VLC_API int vlc_resolver_Lookup(const char *node, unsigned i_port,
+                                const struct addrinfo *p_hints,
+                                struct addrinfo **res);
+
+/**
+ * Releases an address list returned by vlc_resolver_Lookup().
+ */
+VLC_API void vlc_resolver_Free(struct addrinfo *res);
+
 static inline bool
 net_SockAddrIsMulticast (const struct sockaddr *addr, socklen_t len)
 {
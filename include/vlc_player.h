@@ -1530,6 +1530,26 @@ vlc_player_SelectTracksByStringIds(vlc_player_t *player,
                                    enum es_format_category_e cat,
                                    const char *str_ids);
 
+/**
+ * Mark a track category as on-demand
+ *
+ * Tracks of an on-demand category are still listed and their events still
+ * delivered, but the player won't select any of them automatically: no decoder
+ * is created until a track is explicitly selected, for example with
+ * vlc_player_SelectEsId() or vlc_player_SelectTracksByStringIds().
+ *
+ * This setting persists across played media. Enabling it doesn't unselect
+ * tracks that are already selected.
+ *
+ * @param player locked player instance
+ * @param cat VIDEO_ES, AUDIO_ES or SPU_ES
+ * @param on_demand true to disable automatic track selection for the category
+ */
+VLC_API void
+vlc_player_SetTrackCategoryOnDemand(vlc_player_t *player,
+                                    enum es_format_category_e cat,
+                                    bool on_demand);
+
 /**
  * Select a track from an ES identifier
  *
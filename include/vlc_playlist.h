@@ -335,6 +335,31 @@ struct vlc_playlist_callbacks
     void (*on_media_stopped_action_changed)(vlc_playlist_t *playlist,
                                             enum vlc_playlist_media_stopped_action new_action,
                                             void *userdata);
+
+    /**
+     * Called before a group of related changes is notified.
+     *
+     * A single logical operation (e.g. a sort notified as a sequence of
+     * removals and insertions, followed by a current index change) may
+     * trigger several of the callbacks above. When it does, the sequence is
+     * surrounded by on_update_begin/on_update_end, so that interfaces may
+     * coalesce the whole group into one model update. Every event within the
+     * group is complete on its own; these callbacks are pure grouping hints.
+     *
+     * \param playlist the playlist
+     * \param userdata userdata provided to AddListener()
+     */
+    void
+    (*on_update_begin)(vlc_playlist_t *playlist, void *userdata);
+
+    /**
+     * Called after a group of related changes has been notified.
+     *
+     * \param playlist the playlist
+     * \param userdata userdata provided to AddListener()
+     */
+    void
+    (*on_update_end)(vlc_playlist_t *playlist, void *userdata);
 };
 
 /* Playlist items */
@@ -927,6 +952,35 @@ VLC_API int
 vlc_playlist_Export(vlc_playlist_t *playlist, const char *filename,
                     const char *type);
 
+/**
+ * Save the playlist to a binary snapshot file.
+ *
+ * The snapshot is a versioned, native-endian format intended for fast
+ * save/restore on the same machine (e.g. session restore); use
+ * vlc_playlist_Export() to produce interchangeable playlist files.
+ *
+ * \param playlist the playlist, locked
+ * \param filename the location where the snapshot will be saved
+ * \return VLC_SUCCESS on success, another value on error
+ */
+VLC_API int
+vlc_playlist_SaveSnapshot(vlc_playlist_t *playlist, const char *filename);
+
+/**
+ * Replace the playlist content from a binary snapshot file.
+ *
+ * Restoring maps the file and rebuilds the items in a single linear pass,
+ * without any text parsing. Invalid or truncated snapshots are rejected
+ * and leave the playlist untouched.
+ *
+ * \param playlist the playlist, locked
+ * \param filename the location of a file created by
+ *                 vlc_playlist_SaveSnapshot()
+ * \return VLC_SUCCESS on success, another value on error
+ */
+VLC_API int
+vlc_playlist_LoadSnapshot(vlc_playlist_t *playlist, const char *filename);
+
 /** @} */
 # ifdef __cplusplus
 }
@@ -56,6 +56,9 @@ typedef size_t vlc_preparser_req_id;
 
 #define VLC_PREPARSER_OPTION_INTERACT 0x1000
 #define VLC_PREPARSER_OPTION_SUBITEMS 0x2000
+/** Jump ahead of already queued requests; for items that just became
+ * visible to the user while a large batch is still pending. */
+#define VLC_PREPARSER_OPTION_URGENT   0x4000
 
 /**
  * Preparser thumbnailer callbacks
@@ -40,6 +40,18 @@ extern "C" {
  * Byte streams and byte stream filter modules interface
  */
 
+/**
+ * Extent of a scatter read.
+ *
+ * Describes one of the byte ranges fetched by vlc_stream_ReadVec().
+ */
+struct vlc_stream_extent
+{
+    uint64_t offset; /**< Byte offset from the start of the stream */
+    size_t   length; /**< Number of bytes to read */
+    void     *buf;   /**< Buffer to read the data into */
+};
+
 struct vlc_stream_operations {
     /* Cannot fail */
     bool (*can_seek)(stream_t *);
@@ -64,6 +76,8 @@ struct vlc_stream_operations {
             block_t *(*block)(stream_t *, bool *restrict eof);
             int (*readdir)(stream_t *, input_item_node_t *);
             int (*seek)(stream_t *, uint64_t);
+            ssize_t (*readvec)(stream_t *, const struct vlc_stream_extent *,
+                               unsigned);
 
             int (*get_title)(stream_t *, unsigned *);
             int (*get_seekpoint)(stream_t *, unsigned *);
@@ -222,6 +236,21 @@ struct stream_t
      */
     int         (*pf_seek)(stream_t *, uint64_t);
 
+    /**
+     * Scatter read.
+     *
+     * Callback to read several byte ranges in a single operation
+     * (see vlc_stream_ReadVec() for the exact semantics).
+     *
+     * This is the legacy implementer, using \ref vlc_stream_operations
+     * should be preferred.
+     *
+     * May be NULL; vlc_stream_ReadVec() then emulates the operation with
+     * seeks and reads.
+     */
+    ssize_t     (*pf_readvec)(stream_t *, const struct vlc_stream_extent *,
+                              unsigned);
+
     /**
      * Stream control.
      *
@@ -318,6 +347,28 @@ VLC_API ssize_t vlc_stream_Read(stream_t *s, void *buf, size_t len) VLC_USED;
 VLC_API ssize_t vlc_stream_ReadPartial(stream_t *s, void *buf, size_t len)
 VLC_USED;
 
+/**
+ * Reads several byte ranges from a stream.
+ *
+ * This function reads the supplied extents in order, filling each buffer
+ * completely before starting the next one. Accesses able to fetch multiple
+ * ranges in one round trip implement this natively; otherwise the operation
+ * is emulated with vlc_stream_Seek() and vlc_stream_Read(), so the stream
+ * must be seekable.
+ *
+ * The stream read offset is unspecified after this function returns; seek
+ * before resuming sequential reads.
+ *
+ * \param s the stream object to read from
+ * \param extents array of byte ranges to read [IN/OUT]
+ * \param count number of extents
+ * \return the total number of bytes read; on a short count, the extents are
+ * still filled in order, so only the last non-empty one can be partial.
+ */
+VLC_API ssize_t vlc_stream_ReadVec(stream_t *s,
+                                   const struct vlc_stream_extent *extents,
+                                   unsigned count) VLC_USED;
+
 /**
  * Peeks at data from a byte stream.
  *
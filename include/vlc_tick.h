@@ -239,6 +239,13 @@ struct date_t
     uint32_t i_divider_num;
     uint32_t i_divider_den;
     uint32_t i_remainder;
+    /* Cached by date_Init()/date_Change(): quotient and remainder of
+     * (CLOCK_FREQ * i_divider_den) / i_divider_num, and the fixed-point
+     * reciprocal of i_divider_num, so that incrementing by n samples does
+     * not need a 64-bit division on the fast path. */
+    uint64_t i_tick_inc;
+    uint32_t i_tick_rem;
+    uint64_t i_divider_inv;
 };
 
 /**
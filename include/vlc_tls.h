@@ -200,6 +200,49 @@ VLC_API vlc_tls_t *vlc_tls_ClientSessionCreate(vlc_tls_client_t *creds,
                                                const char *const *alpn,
                                                char **alp);
 
+/**
+ * Starts a client TLS session without handshaking.
+ *
+ * Creates the TLS session object like vlc_tls_ClientSessionCreate() would,
+ * but does not perform the handshake. The handshake must then be driven with
+ * vlc_tls_ClientSessionHandshake() until it returns zero, waiting for the
+ * socket event it requests in between. As no call blocks on the network,
+ * several session setups can be overlapped from a single thread.
+ *
+ * @param creds X.509 credentials
+ * @param sock socket through which to establish the secure channel
+ * @param hostname expected server name, used both as Server Name Indication
+ *                 and as expected Common Name of the peer certificate [IN]
+ * @param alpn NULL-terminated list of Application Layer Protocols
+ *             to negotiate, or NULL to not negotiate protocols [IN]
+ *
+ * @return TLS session, or NULL on error.
+ **/
+VLC_API vlc_tls_t *vlc_tls_ClientSessionOpen(vlc_tls_client_t *creds,
+                                             vlc_tls_t *sock,
+                                             const char *hostname,
+                                             const char *const *alpn);
+
+/**
+ * Performs one step of a client TLS handshake.
+ *
+ * This processes any pending handshake data and returns without waiting for
+ * further network events.
+ *
+ * @param alp storage space for the negotiated Application Layer
+ *            Protocol or NULL if negotiation was not performed [OUT]
+ *
+ * @retval -1 fatal error, the session must be deleted
+ * @retval 0 the handshake is complete
+ * @retval 1 poll the socket for reading before the next step
+ * @retval 2 poll the socket for writing before the next step
+ **/
+VLC_API int vlc_tls_ClientSessionHandshake(vlc_tls_client_t *creds,
+                                           vlc_tls_t *session,
+                                           const char *hostname,
+                                           const char *service,
+                                           char **alp);
+
 /**
  * @}
  * \defgroup tls_server TLS server
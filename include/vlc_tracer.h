@@ -159,12 +159,24 @@ VLC_API void vlc_tracer_Destroy(struct vlc_tracer *tracer);
 
 VLC_API void vlc_tracer_TraceWithTs(struct vlc_tracer *tracer, vlc_tick_t ts,
                                     const struct vlc_tracer_trace *trace);
+#ifndef __cplusplus
 #define vlc_tracer_TraceWithTs(tracer, ts, ...) \
     (vlc_tracer_TraceWithTs)(tracer, ts, &(const struct vlc_tracer_trace) { \
         .entries = (const struct vlc_tracer_entry[]) { \
             __VA_ARGS__ \
         } \
     })
+#else
+/* C++ has no compound literals, use a statement form instead */
+#define vlc_tracer_TraceWithTs(tracer, ts, ...) \
+    do { \
+        const struct vlc_tracer_entry vlc_entries__[] = { \
+            __VA_ARGS__ \
+        }; \
+        const struct vlc_tracer_trace vlc_trace__ = { vlc_entries__ }; \
+        (vlc_tracer_TraceWithTs)(tracer, ts, &vlc_trace__); \
+    } while (0)
+#endif
 
 #define vlc_tracer_Trace(tracer, ...) \
     vlc_tracer_TraceWithTs(tracer, vlc_tick_now(), __VA_ARGS__)
@@ -267,6 +279,40 @@ static inline void vlc_tracer_TraceEvent(struct vlc_tracer *tracer, const char *
                              VLC_TRACE_END);
 }
 
+/**
+ * Begins a trace span.
+ *
+ * The span covers the processing of one frame, identified by \p frame (for
+ * instance its DTS), and lasts until vlc_tracer_TraceSpanEnd() is called with
+ * the same name on the same thread. Exporters understanding duration events
+ * (such as the Chrome trace format) render the pair as a span; other
+ * exporters report two plain traces.
+ */
+static inline void vlc_tracer_TraceSpanBegin(struct vlc_tracer *tracer,
+                                             const char *type, const char *id,
+                                             const char *name, int64_t frame)
+{
+    vlc_tracer_Trace(tracer, VLC_TRACE("type", type),
+                             VLC_TRACE("id", id),
+                             VLC_TRACE("frame", frame),
+                             VLC_TRACE("begin", name),
+                             VLC_TRACE_END);
+}
+
+/**
+ * Ends a trace span started with vlc_tracer_TraceSpanBegin().
+ */
+static inline void vlc_tracer_TraceSpanEnd(struct vlc_tracer *tracer,
+                                           const char *type, const char *id,
+                                           const char *name, int64_t frame)
+{
+    vlc_tracer_Trace(tracer, VLC_TRACE("type", type),
+                             VLC_TRACE("id", id),
+                             VLC_TRACE("frame", frame),
+                             VLC_TRACE("end", name),
+                             VLC_TRACE_END);
+}
+
 static inline void vlc_tracer_TracePCR( struct vlc_tracer *tracer, const char *type,
                                     const char *id, vlc_tick_t pcr)
 {
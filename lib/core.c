@@ -48,6 +48,11 @@ int libvlc_abi_version(void)
     return LIBVLC_ABI_VERSION_INT;
 }
 
+/* The module bank and the configuration parameter table are process-wide
+ * and reference-counted: they are built by the first instance and shared
+ * by any instance created while another one is alive. An application
+ * spawning many short-lived instances (e.g. a thumbnailing service) can
+ * therefore keep one "warm" instance resident to make the others cheap. */
 libvlc_instance_t * libvlc_new( int argc, const char *const *argv )
 {
     libvlc_threads_init ();
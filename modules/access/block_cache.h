@@ -0,0 +1,194 @@
+/*****************************************************************************
+ * block_cache.h: block-aligned read cache helper for network accesses
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_ACCESS_BLOCK_CACHE_H
+#define VLC_ACCESS_BLOCK_CACHE_H
+
+#include <vlc_common.h>
+#include <vlc_tick.h>
+#include <vlc_threads.h>
+
+/* Demuxers playing interleaved files (typically MP4) alternate small reads
+ * between two extents, one per elementary stream cursor. Network file
+ * protocols turn every one of those reads into a round trip. This helper
+ * turns the access reads into large aligned block reads and keeps the last
+ * blocks around, so the alternating audio and video positions each stay
+ * served from their own cached block. */
+
+/** Cached blocks: two per typical demuxer cursor (audio and video) */
+#define VLC_BLK_CACHE_BLOCKS 4
+
+/** Delay between two mtime revalidations of the remote file */
+#define VLC_BLK_CACHE_TTL VLC_TICK_FROM_SEC(5)
+
+struct vlc_blk_cache_ops
+{
+    /** Reads up to len bytes at the current position of the wrapped access,
+     * returning 0 on end of stream or error */
+    ssize_t (*read)(stream_t *, void *buf, size_t len);
+    /** Repositions the wrapped access */
+    int (*seek)(stream_t *, uint64_t offset);
+    /** Fetches the current mtime of the remote file, or NULL if the protocol
+     * cannot revalidate */
+    int (*get_mtime)(stream_t *, uint64_t *mtime);
+};
+
+struct vlc_blk
+{
+    uint64_t offset;
+    size_t   length;
+    uint64_t use;
+    uint8_t *data;
+};
+
+struct vlc_blk_cache
+{
+    const struct vlc_blk_cache_ops *ops;
+    size_t     block_size;
+    uint64_t   offset;          /**< Logical stream position */
+    uint64_t   backend_offset;  /**< Position of the wrapped access */
+    uint64_t   use_count;
+    uint64_t   mtime;
+    vlc_tick_t next_check;
+    struct vlc_blk blocks[VLC_BLK_CACHE_BLOCKS];
+};
+
+static inline void
+vlc_blk_cache_Init(struct vlc_blk_cache *cache,
+                   const struct vlc_blk_cache_ops *ops, size_t block_size,
+                   uint64_t mtime)
+{
+    memset(cache, 0, sizeof (*cache));
+    cache->ops = ops;
+    cache->block_size = block_size;
+    cache->backend_offset = UINT64_MAX; /* force the initial seek */
+    cache->mtime = mtime;
+    cache->next_check = vlc_tick_now() + VLC_BLK_CACHE_TTL;
+}
+
+static inline void
+vlc_blk_cache_Destroy(struct vlc_blk_cache *cache)
+{
+    for (unsigned i = 0; i < VLC_BLK_CACHE_BLOCKS; ++i)
+        free(cache->blocks[i].data);
+}
+
+/** Invalidates all cached data (the remote file changed) */
+static inline void
+vlc_blk_cache_Drop(struct vlc_blk_cache *cache)
+{
+    for (unsigned i = 0; i < VLC_BLK_CACHE_BLOCKS; ++i)
+        cache->blocks[i].length = 0;
+    cache->backend_offset = UINT64_MAX;
+}
+
+/** Seeks are virtual: the wrapped access is repositioned lazily when a block
+ * actually has to be fetched */
+static inline void
+vlc_blk_cache_Seek(struct vlc_blk_cache *cache, uint64_t offset)
+{
+    cache->offset = offset;
+}
+
+static inline ssize_t
+vlc_blk_cache_Read(stream_t *access, struct vlc_blk_cache *cache,
+                   void *buf, size_t len)
+{
+    const uint64_t block_offset =
+        cache->offset - cache->offset % cache->block_size;
+    struct vlc_blk *blk = NULL;
+
+    for (unsigned i = 0; i < VLC_BLK_CACHE_BLOCKS; ++i)
+        if (cache->blocks[i].length > 0
+         && cache->blocks[i].offset == block_offset)
+        {
+            blk = &cache->blocks[i];
+            break;
+        }
+
+    if (blk == NULL)
+    {
+        /* Revalidate on misses only: hits must stay free of round trips */
+        if (cache->ops->get_mtime != NULL)
+        {
+            vlc_tick_t now = vlc_tick_now();
+            if (now >= cache->next_check)
+            {
+                uint64_t mtime;
+                if (cache->ops->get_mtime(access, &mtime) == VLC_SUCCESS
+                 && mtime != cache->mtime)
+                {
+                    cache->mtime = mtime;
+                    vlc_blk_cache_Drop(cache);
+                }
+                cache->next_check = now + VLC_BLK_CACHE_TTL;
+            }
+        }
+
+        /* Evict the least recently used block */
+        blk = &cache->blocks[0];
+        for (unsigned i = 1; i < VLC_BLK_CACHE_BLOCKS; ++i)
+            if (cache->blocks[i].use < blk->use)
+                blk = &cache->blocks[i];
+
+        if (blk->data == NULL)
+        {
+            blk->data = malloc(cache->block_size);
+            if (unlikely(blk->data == NULL))
+                return -1;
+        }
+
+        blk->length = 0;
+        if (cache->backend_offset != block_offset)
+        {
+            if (cache->ops->seek(access, block_offset) != VLC_SUCCESS)
+                return -1;
+            cache->backend_offset = block_offset;
+        }
+
+        while (blk->length < cache->block_size)
+        {
+            ssize_t val = cache->ops->read(access, blk->data + blk->length,
+                                           cache->block_size - blk->length);
+            if (val <= 0) /* end of stream, or error reported upstream */
+                break;
+            blk->length += val;
+            cache->backend_offset += val;
+        }
+        blk->offset = block_offset;
+        /* Zero-length blocks are not kept: the length > 0 lookup test above
+         * skips them, so a failed fetch is retried on the next read */
+    }
+
+    blk->use = ++cache->use_count;
+
+    const uint64_t skip = cache->offset - blk->offset;
+    if (skip >= blk->length)
+        return 0; /* end of stream at the current position */
+
+    size_t copy = blk->length - skip;
+    if (copy > len)
+        copy = len;
+    memcpy(buf, blk->data + skip, copy);
+    cache->offset += copy;
+    return copy;
+}
+
+#endif
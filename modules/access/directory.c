@@ -31,6 +31,7 @@
 #endif
 
 #include <limits.h>
+#include <stdatomic.h>
 #include <sys/stat.h>
 
 #include <vlc_common.h>
@@ -39,6 +40,7 @@
 #include <vlc_input_item.h>
 
 #include <vlc_fs.h>
+#include <vlc_threads.h>
 #include <vlc_url.h>
 
 typedef struct
@@ -131,6 +133,87 @@ void DirClose(vlc_object_t *obj)
     vlc_closedir(sys->dir);
 }
 
+struct dir_entry
+{
+    char *name;
+    struct stat st;
+    bool ok;
+};
+
+#ifdef HAVE_FSTATAT
+/* Maximum number of concurrent stat() calls. The traversal is bound by
+ * per-entry round-trip latency on network filesystems, not by CPU. */
+#define DIR_STAT_THREADS 4
+/* Below this entry count, spawning workers costs more than it saves */
+#define DIR_STAT_PARALLEL_MIN 64
+
+struct dir_stat_job
+{
+    struct dir_entry *entries;
+    size_t count;
+    atomic_size_t index;
+    int fd;
+};
+
+static void *DirStatWorker(void *data)
+{
+    struct dir_stat_job *job = data;
+    size_t i;
+
+    while ((i = atomic_fetch_add_explicit(&job->index, 1,
+                                          memory_order_relaxed)) < job->count)
+    {
+        struct dir_entry *e = &job->entries[i];
+
+        e->ok = fstatat(job->fd, e->name, &e->st, 0) == 0;
+    }
+    return NULL;
+}
+#endif
+
+static void DirStat(stream_t *access, struct dir_entry *entries, size_t count)
+{
+#ifdef HAVE_FSTATAT
+    access_sys_t *sys = access->p_sys;
+    struct dir_stat_job job =
+    {
+        .entries = entries,
+        .count = count,
+        .index = 0,
+        .fd = dirfd(sys->dir),
+    };
+
+    if (count >= DIR_STAT_PARALLEL_MIN)
+    {
+        vlc_thread_t workers[DIR_STAT_THREADS];
+        size_t n = 0;
+
+        while (n < DIR_STAT_THREADS - 1
+            && vlc_clone(&workers[n], DirStatWorker, &job) == 0)
+            n++;
+
+        DirStatWorker(&job);
+
+        while (n > 0)
+            vlc_join(workers[--n], NULL);
+    }
+    else
+        DirStatWorker(&job);
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        struct dir_entry *e = &entries[i];
+        char *path;
+
+        if (asprintf(&path, "%s"DIR_SEP"%s", access->psz_filepath,
+                     e->name) == -1)
+            continue;
+        e->ok = vlc_stat(path, &e->st) == 0;
+        free(path);
+    }
+#endif
+}
+
 static int DirRead (stream_t *access, input_item_node_t *node)
 {
     access_sys_t *sys = access->p_sys;
@@ -139,24 +222,54 @@ static int DirRead (stream_t *access, input_item_node_t *node)
 
     bool special_files = var_InheritBool(access, "list-special-files");
 
+    /* Read all the entry names first: readdir() is batched by the kernel
+     * and the protocol, while each stat() below is a full round-trip on
+     * network filesystems. Collecting the names up front lets the stats
+     * run concurrently. */
+    struct dir_entry *entries = NULL;
+    size_t count = 0, capacity = 0;
+
+    while ((entry = vlc_readdir(sys->dir)) != NULL)
+    {
+        if (count == capacity)
+        {
+            size_t new_capacity = capacity ? capacity * 2 : 64;
+            struct dir_entry *grown = vlc_reallocarray(entries, new_capacity,
+                                                       sizeof (*entries));
+            if (unlikely(grown == NULL))
+            {
+                ret = VLC_ENOMEM;
+                break;
+            }
+            entries = grown;
+            capacity = new_capacity;
+        }
+
+        entries[count].name = strdup(entry);
+        if (unlikely(entries[count].name == NULL))
+        {
+            ret = VLC_ENOMEM;
+            break;
+        }
+        entries[count].ok = false;
+        count++;
+    }
+
+    if (ret == VLC_SUCCESS && count > 0)
+        DirStat(access, entries, count);
+
     struct vlc_readdir_helper rdh;
     vlc_readdir_helper_init(&rdh, access, node);
 
-    while (ret == VLC_SUCCESS && (entry = vlc_readdir(sys->dir)) != NULL)
+    for (size_t i = 0; ret == VLC_SUCCESS && i < count; i++)
     {
-        struct stat st;
+        struct stat st = entries[i].st;
         int type;
 
-#ifdef HAVE_FSTATAT
-        if (fstatat(dirfd(sys->dir), entry, &st, 0))
+        entry = entries[i].name;
+        if (!entries[i].ok)
             continue;
-#else
-        char *path;
 
-        if (asprintf(&path, "%s"DIR_SEP"%s", access->psz_filepath, entry) == -1
-         || (type = vlc_stat(path, &st), free(path), type))
-            continue;
-#endif
         switch (st.st_mode & S_IFMT)
         {
 #ifdef S_IFBLK
@@ -221,5 +334,9 @@ static int DirRead (stream_t *access, input_item_node_t *node)
 
     vlc_readdir_helper_finish(&rdh, ret == VLC_SUCCESS);
 
+    for (size_t i = 0; i < count; i++)
+        free(entries[i].name);
+    free(entries);
+
     return ret;
 }
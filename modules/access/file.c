@@ -32,6 +32,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#ifdef HAVE_MMAP
+#   include <sys/mman.h>
+#endif
 #ifdef HAVE_FSTATVFS
 #   include <sys/statvfs.h>
 #   if defined (HAVE_SYS_MOUNT_H)
@@ -66,6 +69,13 @@ typedef struct
     int fd;
 
     bool b_pace_control;
+    bool b_readahead;
+    uint64_t offset;
+    uint64_t readahead_offset; /* end of the last advised readahead window */
+#ifdef HAVE_MMAP
+    uint64_t mmap_offset;
+    uint64_t mmap_size;
+#endif
 } access_sys_t;
 
 #if !defined (_WIN32) && !defined (__OS2__)
@@ -165,9 +175,23 @@ static bool IsRemote (const char *path)
 # define posix_fadvise(fd, off, len, adv)
 #endif
 
+/* Keep the kernel reading this far ahead of the consumer, so that disk (or
+ * network file system) latency overlaps with demuxing instead of stalling
+ * it. Refreshed once the consumer gets within the margin of the window. */
+#define FILE_READAHEAD_SIZE   (4 << 20)
+#define FILE_READAHEAD_MARGIN (1 << 20)
+
 static ssize_t Read (stream_t *, void *, size_t);
+#ifndef _WIN32
+static ssize_t FileReadVec (stream_t *, const struct vlc_stream_extent *,
+                            unsigned);
+#endif
 static int FileSeek (stream_t *, uint64_t);
 static int FileControl (stream_t *, int, va_list);
+#ifdef HAVE_MMAP
+static block_t *MmapBlock (stream_t *, bool *);
+static int MmapSeek (stream_t *, uint64_t);
+#endif
 
 /*****************************************************************************
  * FileOpen: open the file
@@ -252,11 +276,21 @@ int FileOpen( vlc_object_t *p_this )
     p_access->pf_control = FileControl;
     p_access->p_sys = p_sys;
     p_sys->fd = fd;
+    p_sys->b_readahead = false;
+    p_sys->offset = 0;
+    p_sys->readahead_offset = 0;
 
     if (S_ISREG (st.st_mode) || S_ISBLK (st.st_mode))
     {
+        off_t pos = lseek (fd, 0, SEEK_CUR);
+        if (pos > 0) /* inherited "fd" descriptors may not start at zero */
+            p_sys->offset = pos;
         p_access->pf_seek = FileSeek;
+#ifndef _WIN32
+        p_access->pf_readvec = FileReadVec;
+#endif
         p_sys->b_pace_control = true;
+        p_sys->b_readahead = true;
 
         /* Demuxers will need the beginning of the file for probing. */
         posix_fadvise (fd, 0, 4096, POSIX_FADV_WILLNEED);
@@ -270,6 +304,21 @@ int FileOpen( vlc_object_t *p_this )
             fcntl (fd, F_RDAHEAD, 0);
         else
             fcntl (fd, F_RDAHEAD, 1);
+#endif
+#ifdef HAVE_MMAP
+        /* Zero-copy path: hand out blocks pointing straight into the page
+         * cache rather than copying through read(). Only for local regular
+         * files, where the mapping cannot trigger network I/O on fault. */
+        if (S_ISREG (st.st_mode) && st.st_size > 0
+         && !IsRemote (fd, p_access->psz_filepath)
+         && var_InheritBool (p_access, "file-mmap"))
+        {
+            p_access->pf_read = NULL;
+            p_access->pf_block = MmapBlock;
+            p_access->pf_seek = MmapSeek;
+            p_sys->mmap_offset = 0;
+            p_sys->mmap_size = st.st_size;
+        }
 #endif
     }
     else
@@ -292,7 +341,7 @@ void FileClose (vlc_object_t * p_this)
 {
     stream_t     *p_access = (stream_t*)p_this;
 
-    if (p_access->pf_read == NULL)
+    if (p_access->pf_readdir != NULL)
     {
         DirClose (p_this);
         return;
@@ -322,10 +371,127 @@ static ssize_t Read (stream_t *p_access, void *p_buffer, size_t i_len)
         msg_Err (p_access, "read error: %s", vlc_strerror_c(errno));
         val = 0;
     }
+    else if (p_sys->b_readahead)
+    {
+        p_sys->offset += val;
+
+        /* Asynchronous readahead: tell the kernel to start fetching the
+         * next window while the demuxer chews on this one. */
+        if (p_sys->readahead_offset < p_sys->offset + FILE_READAHEAD_MARGIN)
+        {
+            uint64_t end = p_sys->offset + FILE_READAHEAD_SIZE;
+
+            posix_fadvise (fd, p_sys->readahead_offset,
+                           end - p_sys->readahead_offset,
+                           POSIX_FADV_WILLNEED);
+            p_sys->readahead_offset = end;
+        }
+    }
 
     return val;
 }
 
+#ifndef _WIN32
+/* Scatter read: fetch each extent with pread(), leaving both the file
+ * descriptor position and the sequential readahead window untouched. */
+static ssize_t FileReadVec (stream_t *p_access,
+                            const struct vlc_stream_extent *extents,
+                            unsigned count)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+    ssize_t total = 0;
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        unsigned char *buf = extents[i].buf;
+        size_t len = extents[i].length;
+        uint64_t offset = extents[i].offset;
+
+        while (len > 0)
+        {
+            if (vlc_killed ())
+                return total;
+
+            ssize_t val = pread (p_sys->fd, buf, len, offset);
+            if (val < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN)
+                    continue;
+
+                msg_Err (p_access, "read error: %s", vlc_strerror_c(errno));
+                return (total > 0) ? total : -1;
+            }
+            if (val == 0) /* end of file */
+                return total;
+
+            buf += val;
+            len -= val;
+            offset += val;
+            total += val;
+        }
+    }
+    return total;
+}
+#endif
+
+#ifdef HAVE_MMAP
+/* Granularity of the file mappings. Large enough to amortize the block and
+ * syscall overhead, small enough to keep address space use bounded. */
+#define FILE_MMAP_BLOCK (1 << 20)
+
+static block_t *MmapBlock (stream_t *p_access, bool *restrict eof)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    if (p_sys->mmap_offset >= p_sys->mmap_size)
+    {
+        *eof = true;
+        return NULL;
+    }
+
+    /* mmap() requires a page-aligned file offset */
+    const uint64_t page_mask = sysconf (_SC_PAGESIZE) - 1;
+    uint64_t aligned = p_sys->mmap_offset & ~page_mask;
+    size_t delta = p_sys->mmap_offset - aligned;
+    size_t length = FILE_MMAP_BLOCK;
+
+    if (length > p_sys->mmap_size - aligned)
+        length = p_sys->mmap_size - aligned;
+
+    void *base = mmap (NULL, length, PROT_READ, MAP_SHARED, p_sys->fd,
+                       aligned);
+    if (base == MAP_FAILED)
+    {
+        msg_Err (p_access, "mmap error: %s", vlc_strerror_c(errno));
+        *eof = true;
+        return NULL;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise (base, length, MADV_SEQUENTIAL);
+#endif
+
+    block_t *block = block_mmap_Alloc (base, length);
+    if (unlikely(block == NULL))
+    {
+        munmap (base, length);
+        return NULL;
+    }
+
+    block->p_buffer += delta;
+    block->i_buffer -= delta;
+    p_sys->mmap_offset = aligned + length;
+    return block;
+}
+
+static int MmapSeek (stream_t *p_access, uint64_t i_pos)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    p_sys->mmap_offset = i_pos;
+    return VLC_SUCCESS;
+}
+#endif
+
 /*****************************************************************************
  * Seek: seek to a specific location in a file
  *****************************************************************************/
@@ -335,6 +501,9 @@ static int FileSeek (stream_t *p_access, uint64_t i_pos)
 
     if (lseek(sys->fd, i_pos, SEEK_SET) == (off_t)-1)
         return VLC_EGENERIC;
+
+    sys->offset = i_pos;
+    sys->readahead_offset = i_pos; /* start a fresh readahead window */
     return VLC_SUCCESS;
 }
 
@@ -37,6 +37,11 @@ vlc_module_begin ()
     set_capability( "access", 50 )
     add_shortcut( "file", "fd", "stream" )
     set_callbacks( FileOpen, FileClose )
+#ifdef HAVE_MMAP
+    add_bool( "file-mmap", false, N_("Memory-map files"),
+              N_("Read local files through zero-copy memory mapping "
+                 "instead of read().") )
+#endif
 
     add_submodule()
     set_section( N_("Directory" ), NULL )
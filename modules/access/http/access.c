@@ -40,11 +40,13 @@
 #include "resource.h"
 #include "file.h"
 #include "live.h"
+#include "parallel.h"
 
 typedef struct
 {
     struct vlc_http_mgr *manager;
     struct vlc_http_resource *resource;
+    struct vlc_http_parallel *parallel;
 } access_sys_t;
 
 static block_t *FileRead(stream_t *access, bool *restrict eof)
@@ -113,6 +115,24 @@ static int FileControl(stream_t *access, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+static block_t *ParallelRead(stream_t *access, bool *restrict eof)
+{
+    access_sys_t *sys = access->p_sys;
+
+    block_t *b = vlc_http_parallel_read(sys->parallel);
+    if (b == NULL)
+        *eof = true;
+    return b;
+}
+
+static int ParallelSeek(stream_t *access, uint64_t pos)
+{
+    access_sys_t *sys = access->p_sys;
+
+    vlc_http_parallel_seek(sys->parallel, pos);
+    return VLC_SUCCESS;
+}
+
 static block_t *LiveRead(stream_t *access, bool *restrict eof)
 {
     access_sys_t *sys = access->p_sys;
@@ -162,6 +182,7 @@ static int Open(vlc_object_t *obj)
 
     sys->manager = NULL;
     sys->resource = NULL;
+    sys->parallel = NULL;
 
     void *jar = NULL;
     if (var_InheritBool(obj, "http-forward-cookies"))
@@ -254,8 +275,21 @@ static int Open(vlc_object_t *obj)
     }
     else
     {
-        access->pf_block = FileRead;
-        access->pf_seek = FileSeek;
+        if (var_InheritBool(obj, "http-parallel")
+         && vlc_http_file_can_seek(sys->resource))
+            sys->parallel = vlc_http_parallel_create(obj, sys->resource,
+                                     vlc_http_file_get_size(sys->resource));
+
+        if (sys->parallel != NULL)
+        {
+            access->pf_block = ParallelRead;
+            access->pf_seek = ParallelSeek;
+        }
+        else
+        {
+            access->pf_block = FileRead;
+            access->pf_seek = FileSeek;
+        }
         access->pf_control = FileControl;
     }
     access->p_sys = sys;
@@ -278,6 +312,8 @@ static void Close(vlc_object_t *obj)
     stream_t *access = (stream_t *)obj;
     access_sys_t *sys = access->p_sys;
 
+    if (sys->parallel != NULL)
+        vlc_http_parallel_destroy(sys->parallel);
     vlc_http_res_destroy(sys->resource);
     vlc_http_mgr_destroy(sys->manager);
     free(sys);
@@ -294,6 +330,11 @@ vlc_module_begin()
     add_bool("http-continuous", false, N_("Continuous stream"),
              N_("Keep reading a resource that keeps being updated."))
         change_volatile()
+    add_bool("http-parallel", false, N_("Parallel downloading"),
+             N_("Download seekable files over several HTTP connections in "
+                "parallel. This can improve throughput with servers that "
+                "limit the bandwidth of each connection, at the cost of "
+                "additional requests and connections."))
     add_bool("http-forward-cookies", true, N_("Cookies forwarding"),
              N_("Forward cookies across HTTP redirections."))
     add_string("http-referrer", NULL, N_("Referrer"),
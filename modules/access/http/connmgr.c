@@ -23,8 +23,13 @@
 #endif
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 #include <vlc_common.h>
+#include <vlc_list.h>
 #include <vlc_network.h>
+#include <vlc_strings.h>
+#include <vlc_threads.h>
 #include <vlc_tls.h>
 #include <vlc_url.h>
 #include "transport.h"
@@ -99,35 +104,256 @@ static char *vlc_http_proxy_find(const char *hostname, unsigned port,
 struct vlc_http_mgr
 {
     struct vlc_logger *logger;
+    /** Logger for connections eligible for pooling, cf. the pool notes */
+    struct vlc_logger *pool_logger;
     vlc_object_t *obj;
-    vlc_tls_client_t *creds;
+    /** Pool state shared by all managers of the libvlc instance */
+    struct vlc_http_pool_instance *shared;
+    vlc_tls_client_t *creds; /**< pool-owned, fetched on first TLS use */
     struct vlc_http_cookie_jar_t *jar;
+    /* Protects request dispatch and the cached connection, so that several
+     * threads can issue requests on one manager. With HTTP/2, concurrent
+     * requests then multiplex as streams of the shared connection; response
+     * payloads are read outside the lock. */
+    vlc_mutex_t lock;
     struct vlc_http_conn *conn;
+    char *conn_host; /**< origin of the cached connection (NULL if unusable) */
+    unsigned conn_port;
+    bool conn_secure;
+    bool conn_poolable; /**< direct connection, fit for the idle pool */
 };
 
-static struct vlc_http_conn *vlc_http_mgr_find(struct vlc_http_mgr *mgr,
-                                               const char *host, unsigned port)
+/*
+ * Idle connection pool
+ *
+ * A process-wide pool keeps established connections alive for a while after
+ * their manager stops using them, keyed by origin host, port and TLS use.
+ * Several inputs streaming from a single origin - a mosaic of cameras, or
+ * adaptive streaming cycling its connections - then skip name resolution and
+ * the TCP and TLS handshakes entirely when one of them needs a connection
+ * that another just gave up.
+ *
+ * There is no reliable way to probe a pooled connection for liveness without
+ * issuing a request, so staleness is handled like a closing connection on
+ * the reuse path: only idempotent requests are sent on pooled connections,
+ * and a failure falls back to a fresh connection. Entries additionally
+ * expire after an idle timeout well below common server keep-alive limits.
+ * Connections through an HTTP proxy are never pooled: their request syntax
+ * differs and the origin key would not identify them.
+ *
+ * A pooled connection outlives the manager (and the object) that created
+ * it, so it cannot borrow that manager's logger or TLS credentials. Both
+ * are owned per libvlc instance instead: connections eligible for pooling
+ * log through the libvlc instance and share one TLS client, and the
+ * instance's pooled entries, credentials and bookkeeping are torn down
+ * together when its last manager is destroyed. Entries never match across
+ * instances.
+ */
+#define VLC_HTTP_POOL_SIZE      10
+#define VLC_HTTP_POOL_IDLE_AGE  VLC_TICK_FROM_SEC(30)
+
+struct vlc_http_pool_entry
+{
+    struct vlc_list node;
+    struct vlc_http_conn *conn;
+    libvlc_int_t *instance;
+    char *host;
+    unsigned port;
+    bool secure;
+    vlc_tick_t deadline;
+};
+
+struct vlc_http_pool_instance
+{
+    struct vlc_list node;
+    libvlc_int_t *instance;
+    vlc_tls_client_t *creds;
+    unsigned managers;
+};
+
+static vlc_mutex_t vlc_http_pool_lock = VLC_STATIC_MUTEX;
+static struct vlc_list vlc_http_pool = VLC_LIST_INITIALIZER(&vlc_http_pool);
+static struct vlc_list vlc_http_pool_instances =
+    VLC_LIST_INITIALIZER(&vlc_http_pool_instances);
+static unsigned vlc_http_pool_count = 0;
+
+/** Looks up or creates the pool state of an instance. Pool lock held. */
+static struct vlc_http_pool_instance *
+vlc_http_pool_instance_get(libvlc_int_t *instance)
+{
+    struct vlc_http_pool_instance *shared;
+
+    vlc_list_foreach(shared, &vlc_http_pool_instances, node)
+        if (shared->instance == instance)
+            return shared;
+
+    shared = malloc(sizeof (*shared));
+    if (likely(shared != NULL))
+    {
+        shared->instance = instance;
+        shared->creds = NULL;
+        shared->managers = 0;
+        vlc_list_append(&shared->node, &vlc_http_pool_instances);
+    }
+    return shared;
+}
+
+static void vlc_http_pool_entry_delete(struct vlc_http_pool_entry *entry)
+{
+    vlc_list_remove(&entry->node);
+    vlc_http_pool_count--;
+    vlc_http_conn_release(entry->conn);
+    free(entry->host);
+    free(entry);
+}
+
+static void vlc_http_pool_expire(void)
+{
+    vlc_tick_t now = vlc_tick_now();
+    struct vlc_http_pool_entry *entry;
+
+    vlc_list_foreach(entry, &vlc_http_pool, node)
+        if (entry->deadline <= now)
+            vlc_http_pool_entry_delete(entry);
+}
+
+static void vlc_http_pool_park(struct vlc_http_conn *conn,
+                               libvlc_int_t *instance, const char *host,
+                               unsigned port, bool secure)
+{
+    struct vlc_http_pool_entry *entry = malloc(sizeof (*entry));
+
+    if (likely(entry != NULL))
+        entry->host = strdup(host);
+    if (unlikely(entry == NULL || entry->host == NULL))
+    {
+        free(entry);
+        vlc_http_conn_release(conn);
+        return;
+    }
+
+    entry->conn = conn;
+    entry->instance = instance;
+    entry->port = port;
+    entry->secure = secure;
+    entry->deadline = vlc_tick_now() + VLC_HTTP_POOL_IDLE_AGE;
+
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    vlc_http_pool_expire();
+    if (vlc_http_pool_count >= VLC_HTTP_POOL_SIZE)
+    {   /* Evict the entry that has been idle the longest */
+        struct vlc_http_pool_entry *oldest =
+            vlc_list_first_entry_or_null(&vlc_http_pool,
+                                         struct vlc_http_pool_entry, node);
+        vlc_http_pool_entry_delete(oldest);
+    }
+    vlc_list_append(&entry->node, &vlc_http_pool);
+    vlc_http_pool_count++;
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+}
+
+static struct vlc_http_conn *vlc_http_pool_claim(libvlc_int_t *instance,
+                                                 const char *host,
+                                                 unsigned port, bool secure)
 {
-    (void) host; (void) port;
-    return mgr->conn;
+    struct vlc_http_conn *conn = NULL;
+    struct vlc_http_pool_entry *entry;
+
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    vlc_http_pool_expire();
+    /* Newest first: the most recently parked connection is the least likely
+     * to have been closed by the server in the meantime. */
+    vlc_list_reverse_foreach(entry, &vlc_http_pool, node)
+        if (entry->instance == instance
+         && entry->port == port && entry->secure == secure
+         && !vlc_ascii_strcasecmp(entry->host, host))
+        {
+            conn = entry->conn;
+            vlc_list_remove(&entry->node);
+            vlc_http_pool_count--;
+            free(entry->host);
+            free(entry);
+            break;
+        }
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+    return conn;
 }
 
-static void vlc_http_mgr_release(struct vlc_http_mgr *mgr,
-                                 struct vlc_http_conn *conn)
+/** Flushes the entries of one instance. The pool lock must be held. */
+static void vlc_http_pool_flush(libvlc_int_t *instance)
 {
-    assert(mgr->conn == conn);
+    struct vlc_http_pool_entry *entry;
+
+    vlc_list_foreach(entry, &vlc_http_pool, node)
+        if (entry->instance == instance)
+            vlc_http_pool_entry_delete(entry);
+}
+
+static unsigned vlc_http_default_port(unsigned port, bool secure)
+{
+    return port ? port : (secure ? 443 : 80);
+}
+
+static void vlc_http_mgr_attach(struct vlc_http_mgr *mgr,
+                                struct vlc_http_conn *conn, const char *host,
+                                unsigned port, bool secure, bool poolable)
+{
+    assert(mgr->conn == NULL);
+    mgr->conn = conn;
+    /* On allocation failure, the connection serves the current request but
+     * is never matched again nor pooled. */
+    mgr->conn_host = strdup(host);
+    mgr->conn_port = vlc_http_default_port(port, secure);
+    mgr->conn_secure = secure;
+    mgr->conn_poolable = poolable && mgr->conn_host != NULL;
+}
+
+static void vlc_http_mgr_detach(struct vlc_http_mgr *mgr, bool reusable)
+{
+    assert(mgr->conn != NULL);
+    if (reusable && mgr->conn_poolable)
+        vlc_http_pool_park(mgr->conn, mgr->shared->instance, mgr->conn_host,
+                           mgr->conn_port, mgr->conn_secure);
+    else
+        vlc_http_conn_release(mgr->conn);
+
+    free(mgr->conn_host);
     mgr->conn = NULL;
+    mgr->conn_host = NULL;
+}
 
-    vlc_http_conn_release(conn);
+static struct vlc_http_conn *vlc_http_mgr_find(struct vlc_http_mgr *mgr,
+                                               const char *host, unsigned port,
+                                               bool secure)
+{
+    port = vlc_http_default_port(port, secure);
+
+    if (mgr->conn != NULL)
+    {
+        if (mgr->conn_host == NULL /* unknown origin: reuse blindly */
+         || (mgr->conn_port == port && mgr->conn_secure == secure
+          && !vlc_ascii_strcasecmp(mgr->conn_host, host)))
+            return mgr->conn;
+        /* Cached connection for another origin (e.g. after a redirection):
+         * park it for whoever needs that origin next. */
+        vlc_http_mgr_detach(mgr, true);
+    }
+
+    struct vlc_http_conn *conn = vlc_http_pool_claim(mgr->shared->instance,
+                                                     host, port, secure);
+    if (conn != NULL)
+        vlc_http_mgr_attach(mgr, conn, host, port, secure, true);
+    return conn;
 }
 
 static
 struct vlc_http_msg *vlc_http_mgr_reuse(struct vlc_http_mgr *mgr,
                                         const char *host, unsigned port,
+                                        bool secure,
                                         const struct vlc_http_msg *req,
                                         bool payload)
 {
-    struct vlc_http_conn *conn = vlc_http_mgr_find(mgr, host, port);
+    struct vlc_http_conn *conn = vlc_http_mgr_find(mgr, host, port, secure);
     if (conn == NULL)
         return NULL;
 
@@ -139,7 +365,7 @@ struct vlc_http_msg *vlc_http_mgr_reuse(struct vlc_http_mgr *mgr,
             return m;
     }
     /* Get rid of closing or reset connection */
-    vlc_http_mgr_release(mgr, conn);
+    vlc_http_mgr_detach(mgr, false);
     return NULL;
 }
 
@@ -155,8 +381,17 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
         return NULL; /* switch from HTTP to HTTPS not implemented */
 
     if (mgr->creds == NULL)
-    {   /* First TLS connection: load x509 credentials */
-        mgr->creds = vlc_tls_ClientCreate(mgr->obj);
+    {   /* First TLS connection: fetch the x509 credentials shared by the
+         * managers of the instance, loading them if need be. They belong
+         * to the pool so that pooled TLS sessions do not outlive them. */
+        struct vlc_http_pool_instance *shared = mgr->shared;
+
+        vlc_mutex_lock(&vlc_http_pool_lock);
+        if (shared->creds == NULL)
+            shared->creds =
+                vlc_tls_ClientCreate(VLC_OBJECT(shared->instance));
+        mgr->creds = shared->creds;
+        vlc_mutex_unlock(&vlc_http_pool_lock);
         if (mgr->creds == NULL)
             return NULL;
     }
@@ -167,13 +402,14 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
          * the nonidempotent request was processed if the connection fails
          * before the response is received.
          */
-        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, req,
-                                                       payload);
+        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, true,
+                                                       req, payload);
         if (resp != NULL)
             return resp; /* existing connection reused */
     }
 
     char *proxy = vlc_http_proxy_find(host, port, true);
+    bool proxied = proxy != NULL;
     if (proxy != NULL)
     {
         tls = vlc_https_connect_proxy(mgr->creds, mgr->creds,
@@ -195,10 +431,14 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
      * supported by the server.
      * NOTE: We do not enforce TLS version 1.2 for HTTP 2.0 explicitly.
      */
+    /* A direct connection may end up pooled past this manager's lifetime,
+     * so it logs through the instance rather than through the manager. */
+    struct vlc_logger *logger = proxied ? mgr->logger : mgr->pool_logger;
+
     if (http2)
-        conn = vlc_h2_conn_create(mgr->logger, tls);
+        conn = vlc_h2_conn_create(logger, tls);
     else
-        conn = vlc_h1_conn_create(mgr->logger, tls, false);
+        conn = vlc_h1_conn_create(logger, tls, false);
 
     if (unlikely(conn == NULL))
     {
@@ -207,10 +447,10 @@ static struct vlc_http_msg *vlc_https_request(struct vlc_http_mgr *mgr,
     }
 
     if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
+        vlc_http_mgr_detach(mgr, true);
 
-    mgr->conn = conn;
-    return vlc_http_mgr_reuse(mgr, host, port, req, payload);
+    vlc_http_mgr_attach(mgr, conn, host, port, true, !proxied);
+    return vlc_http_mgr_reuse(mgr, host, port, true, req, payload);
 }
 
 static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
@@ -223,8 +463,8 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
 
     if (idempotent)
     {
-        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, req,
-                                                       payload);
+        struct vlc_http_msg *resp = vlc_http_mgr_reuse(mgr, host, port, false,
+                                                       req, payload);
         if (resp != NULL)
             return resp;
     }
@@ -233,6 +473,7 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
     struct vlc_http_stream *stream;
 
     char *proxy = vlc_http_proxy_find(host, port, false);
+    bool proxied = proxy != NULL;
     if (proxy != NULL)
     {
         vlc_url_t url;
@@ -249,9 +490,9 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
 
         vlc_UrlClean(&url);
     }
-    else
-        stream = vlc_h1_request(mgr->logger, host, port ? port : 80, false,
-                                req, idempotent, payload, &conn);
+    else /* cf. vlc_https_request(): a direct connection may get pooled */
+        stream = vlc_h1_request(mgr->pool_logger, host, port ? port : 80,
+                                false, req, idempotent, payload, &conn);
 
     if (stream == NULL)
         return NULL;
@@ -264,9 +505,9 @@ static struct vlc_http_msg *vlc_http_request(struct vlc_http_mgr *mgr,
     }
 
     if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
+        vlc_http_mgr_detach(mgr, true);
 
-    mgr->conn = conn;
+    vlc_http_mgr_attach(mgr, conn, host, port, false, !proxied);
     return resp;
 }
 
@@ -278,8 +519,12 @@ struct vlc_http_msg *vlc_http_mgr_request(struct vlc_http_mgr *mgr, bool https,
     if (port && vlc_http_port_blocked(port))
         return NULL;
 
-    return (https ? vlc_https_request : vlc_http_request)(mgr, host, port, m,
-                                                          idempotent, payload);
+    vlc_mutex_lock(&mgr->lock);
+    struct vlc_http_msg *resp =
+        (https ? vlc_https_request : vlc_http_request)(mgr, host, port, m,
+                                                       idempotent, payload);
+    vlc_mutex_unlock(&mgr->lock);
+    return resp;
 }
 
 struct vlc_http_cookie_jar_t *vlc_http_mgr_get_jar(struct vlc_http_mgr *mgr)
@@ -294,19 +539,55 @@ struct vlc_http_mgr *vlc_http_mgr_create(vlc_object_t *obj,
     if (unlikely(mgr == NULL))
         return NULL;
 
+    libvlc_int_t *instance = vlc_object_instance(obj);
+
     mgr->logger = obj->logger;
+    mgr->pool_logger = vlc_object_logger(instance);
     mgr->obj = obj;
     mgr->creds = NULL;
     mgr->jar = jar;
+    vlc_mutex_init(&mgr->lock);
     mgr->conn = NULL;
+    mgr->conn_host = NULL;
+
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    mgr->shared = vlc_http_pool_instance_get(instance);
+    if (likely(mgr->shared != NULL))
+        mgr->shared->managers++;
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+    if (unlikely(mgr->shared == NULL))
+    {
+        free(mgr);
+        return NULL;
+    }
     return mgr;
 }
 
 void vlc_http_mgr_destroy(struct vlc_http_mgr *mgr)
 {
+    struct vlc_http_pool_instance *shared = mgr->shared;
+
     if (mgr->conn != NULL)
-        vlc_http_mgr_release(mgr, mgr->conn);
-    if (mgr->creds != NULL)
-        vlc_tls_ClientDelete(mgr->creds);
+        vlc_http_mgr_detach(mgr, true);
+
+    /* The pooled connections and the shared TLS client must not outlive
+     * the managers of their instance: whoever releases the last one drains
+     * them (in particular before the plugin can be unloaded). */
+    vlc_mutex_lock(&vlc_http_pool_lock);
+    if (--shared->managers > 0)
+        shared = NULL;
+    else
+    {
+        vlc_http_pool_flush(shared->instance);
+        vlc_list_remove(&shared->node);
+    }
+    vlc_mutex_unlock(&vlc_http_pool_lock);
+
+    if (shared != NULL)
+    {
+        if (shared->creds != NULL)
+            vlc_tls_ClientDelete(shared->creds);
+        free(shared);
+    }
     free(mgr);
 }
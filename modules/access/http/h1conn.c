@@ -377,7 +377,7 @@ struct vlc_http_stream *vlc_h1_request(void *ctx, const char *hostname,
 
     vlc_http_dbg(ctx, "resolving %s ...", hostname);
 
-    int val = vlc_getaddrinfo_i11e(hostname, port, &hints, &res);
+    int val = vlc_resolver_Lookup(hostname, port, &hints, &res);
     if (val != 0)
     {   /* TODO: C locale for gai_strerror() */
         vlc_http_err(ctx, "cannot resolve %s: %s", hostname,
@@ -412,7 +412,7 @@ struct vlc_http_stream *vlc_h1_request(void *ctx, const char *hostname,
             else
                 vlc_http_conn_release(conn);
 
-            freeaddrinfo(res);
+            vlc_resolver_Free(res);
             return stream;
         }
 
@@ -423,6 +423,6 @@ struct vlc_http_stream *vlc_h1_request(void *ctx, const char *hostname,
     }
 
     /* All address info failed. */
-    freeaddrinfo(res);
+    vlc_resolver_Free(res);
     return NULL;
 }
@@ -0,0 +1,493 @@
+/*****************************************************************************
+ * parallel.c: HTTP parallel range downloader
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_block.h>
+#include "message.h"
+#include "connmgr.h"
+#include "resource.h"
+#include "parallel.h"
+
+#pragma GCC visibility push(default)
+
+/** Byte length of each range request */
+#define VLC_HTTP_PAR_CHUNK   (2u << 20)
+/** Reassembly window depth, in chunks */
+#define VLC_HTTP_PAR_DEPTH    16
+/** Initial number of connections */
+#define VLC_HTTP_PAR_MIN_CONNS 2
+/** Maximum number of connections */
+#define VLC_HTTP_PAR_MAX_CONNS 8
+
+enum vlc_http_par_state
+{
+    SEG_EMPTY,
+    SEG_BUSY,
+    SEG_DONE,
+    SEG_FAILED,
+};
+
+struct vlc_http_par_seg
+{
+    uintmax_t num;
+    enum vlc_http_par_state state;
+    block_t *chain;
+};
+
+struct vlc_http_parallel
+{
+    vlc_object_t *obj;
+    struct vlc_http_cookie_jar_t *jar;
+    char *url;
+    char *agent;
+    char *referrer;
+    char *username;
+    char *password;
+    char *etag;
+    time_t mtime;
+    uintmax_t size;
+
+    vlc_mutex_t lock;
+    vlc_cond_t data; /**< reader waits for a completed segment */
+    vlc_cond_t space; /**< workers wait for room in the window */
+    uintmax_t dispatch; /**< next segment number to download */
+    uintmax_t next; /**< next segment number to hand to the reader */
+    size_t skip; /**< bytes to drop from the front of segment next */
+    unsigned generation; /**< seek counter, invalidates stale downloads */
+    bool failed;
+    bool dying;
+    block_t *pending; /**< remainder of the last consumed segment */
+
+    unsigned conns;
+    vlc_tick_t last_growth;
+    struct vlc_http_par_seg window[VLC_HTTP_PAR_DEPTH];
+    vlc_thread_t conn[VLC_HTTP_PAR_MAX_CONNS];
+};
+
+struct vlc_http_par_range
+{
+    const struct vlc_http_parallel *dl;
+    uintmax_t start;
+    uintmax_t end; /**< inclusive */
+};
+
+static int vlc_http_par_req(const struct vlc_http_resource *res,
+                            struct vlc_http_msg *req, void *opaque)
+{
+    const struct vlc_http_par_range *range = opaque;
+    const struct vlc_http_parallel *dl = range->dl;
+
+    /* Ensure all connections fetch the same entity version */
+    if (dl->etag != NULL)
+        vlc_http_msg_add_header(req, "If-Match", "%s", dl->etag);
+    else if (dl->mtime != -1)
+        vlc_http_msg_add_time(req, "If-Unmodified-Since", &dl->mtime);
+
+    if (vlc_http_msg_add_header(req, "Range", "bytes=%" PRIuMAX "-%" PRIuMAX,
+                                range->start, range->end))
+        return -1;
+
+    (void) res;
+    return 0;
+}
+
+static int vlc_http_par_resp(const struct vlc_http_resource *res,
+                             const struct vlc_http_msg *resp, void *opaque)
+{
+    const struct vlc_http_par_range *range = opaque;
+
+    /* Unlike a plain file, only an exact range match is usable here: a full
+     * response would duplicate what the other connections download. */
+    if (vlc_http_msg_get_status(resp) != 206)
+        goto fail;
+
+    const char *str = vlc_http_msg_get_header(resp, "Content-Range");
+    uintmax_t start, end;
+
+    if (str == NULL
+     || sscanf(str, "bytes %" SCNuMAX "-%" SCNuMAX, &start, &end) != 2
+     || start != range->start || start > end)
+        goto fail;
+
+    (void) res;
+    return 0;
+
+fail:
+    errno = EIO;
+    return -1;
+}
+
+static const struct vlc_http_resource_cbs vlc_http_par_callbacks =
+{
+    vlc_http_par_req,
+    vlc_http_par_resp,
+};
+
+static bool vlc_http_par_dying(struct vlc_http_parallel *dl)
+{
+    vlc_mutex_lock(&dl->lock);
+    bool dying = dl->dying;
+    vlc_mutex_unlock(&dl->lock);
+    return dying;
+}
+
+static block_t *vlc_http_par_fetch(struct vlc_http_parallel *dl,
+                                   struct vlc_http_resource *res,
+                                   uintmax_t start, uintmax_t end)
+{
+    struct vlc_http_par_range range = { dl, start, end };
+    struct vlc_http_msg *resp = vlc_http_res_open(res, &range);
+    if (resp == NULL)
+        return NULL;
+
+    const uintmax_t length = end - start + 1;
+    block_t *head = NULL, **tailp = &head;
+    uintmax_t got = 0;
+
+    while (got < length)
+    {
+        block_t *block = vlc_http_msg_read(resp);
+        if (block == vlc_http_error || block == NULL)
+            break;
+
+        got += block->i_buffer;
+        *tailp = block;
+        tailp = &block->p_next;
+
+        if (vlc_http_par_dying(dl))
+            break; /* aborted, the truncated chain is discarded below */
+    }
+    vlc_http_msg_destroy(resp);
+
+    if (got < length)
+    {   /* Short response (or tear-down) */
+        block_ChainRelease(head);
+        return NULL;
+    }
+
+    if (got > length)
+    {   /* Trim extraneous data past the requested range */
+        uintmax_t offset = 0;
+
+        for (block_t *block = head; block != NULL; block = block->p_next)
+        {
+            if (offset + block->i_buffer >= length)
+            {
+                block->i_buffer = length - offset;
+                block_ChainRelease(block->p_next);
+                block->p_next = NULL;
+                break;
+            }
+            offset += block->i_buffer;
+        }
+    }
+    return head;
+}
+
+static void *vlc_http_par_thread(void *opaque)
+{
+    struct vlc_http_parallel *dl = opaque;
+    struct vlc_http_resource *res = NULL;
+    struct vlc_http_mgr *mgr = vlc_http_mgr_create(dl->obj, dl->jar);
+
+    if (mgr != NULL)
+    {
+        res = malloc(sizeof (*res));
+        if (res != NULL
+         && vlc_http_res_init(res, &vlc_http_par_callbacks, mgr, dl->url,
+                              dl->agent, dl->referrer))
+        {
+            free(res);
+            res = NULL;
+        }
+        if (res != NULL && dl->username != NULL)
+            vlc_http_res_set_login(res, dl->username, dl->password);
+    }
+
+    vlc_mutex_lock(&dl->lock);
+    if (res == NULL)
+    {
+        dl->failed = true;
+        vlc_cond_broadcast(&dl->data);
+        goto out;
+    }
+
+    for (;;)
+    {
+        while (!dl->dying
+            && !(dl->dispatch * VLC_HTTP_PAR_CHUNK < dl->size
+              && dl->dispatch - dl->next < VLC_HTTP_PAR_DEPTH))
+            vlc_cond_wait(&dl->space, &dl->lock);
+        if (dl->dying)
+            break;
+
+        const uintmax_t seg = dl->dispatch++;
+        const unsigned generation = dl->generation;
+        struct vlc_http_par_seg *s = &dl->window[seg % VLC_HTTP_PAR_DEPTH];
+
+        s->num = seg;
+        s->state = SEG_BUSY;
+        s->chain = NULL;
+        vlc_mutex_unlock(&dl->lock);
+
+        const uintmax_t start = seg * VLC_HTTP_PAR_CHUNK;
+        uintmax_t end = start + VLC_HTTP_PAR_CHUNK - 1;
+        if (end >= dl->size)
+            end = dl->size - 1;
+
+        block_t *chain = vlc_http_par_fetch(dl, res, start, end);
+        if (chain == NULL) /* retry transient failures once */
+            chain = vlc_http_par_fetch(dl, res, start, end);
+
+        vlc_mutex_lock(&dl->lock);
+        if (generation == dl->generation && s->num == seg
+         && s->state == SEG_BUSY)
+        {
+            s->chain = chain;
+            s->state = (chain != NULL) ? SEG_DONE : SEG_FAILED;
+            vlc_cond_broadcast(&dl->data);
+        }
+        else /* seek occurred while downloading, the data is stale */
+        if (chain != NULL)
+            block_ChainRelease(chain);
+    }
+out:
+    vlc_mutex_unlock(&dl->lock);
+    if (res != NULL)
+        vlc_http_res_destroy(res);
+    if (mgr != NULL)
+        vlc_http_mgr_destroy(mgr);
+    return NULL;
+}
+
+/* Called with the lock held whenever the reader has to wait: the established
+ * connections cannot sustain the consumption rate, presumably because the
+ * server caps per-connection throughput. Add one connection at a time - with
+ * at most one addition per second so each one gets a chance to contribute
+ * before the count is grown further. */
+static void vlc_http_par_grow(struct vlc_http_parallel *dl)
+{
+    vlc_tick_t now = vlc_tick_now();
+
+    if (dl->conns >= VLC_HTTP_PAR_MAX_CONNS
+     || now - dl->last_growth < VLC_TICK_FROM_SEC(1))
+        return;
+
+    if (vlc_clone(&dl->conn[dl->conns], vlc_http_par_thread, dl) == 0)
+        dl->conns++;
+    dl->last_growth = now;
+}
+
+block_t *vlc_http_parallel_read(struct vlc_http_parallel *dl)
+{
+    vlc_mutex_lock(&dl->lock);
+    while (dl->pending == NULL)
+    {
+        if (dl->failed
+         || dl->next * VLC_HTTP_PAR_CHUNK + dl->skip >= dl->size)
+        {
+            vlc_mutex_unlock(&dl->lock);
+            return NULL; /* error or end of file */
+        }
+
+        struct vlc_http_par_seg *s =
+            &dl->window[dl->next % VLC_HTTP_PAR_DEPTH];
+
+        if (s->num == dl->next && s->state == SEG_FAILED)
+        {
+            dl->failed = true;
+            continue;
+        }
+
+        if (s->num != dl->next || s->state != SEG_DONE)
+        {
+            vlc_http_par_grow(dl);
+            vlc_cond_wait(&dl->data, &dl->lock);
+            continue;
+        }
+
+        dl->pending = s->chain;
+        s->chain = NULL;
+        s->state = SEG_EMPTY;
+        s->num = UINTMAX_MAX;
+
+        size_t skip = dl->skip;
+        dl->skip = 0;
+        dl->next++;
+        vlc_cond_broadcast(&dl->space);
+
+        /* Seeks are served from the enclosing chunk, drop the head */
+        while (skip > 0 && dl->pending != NULL)
+        {
+            block_t *block = dl->pending;
+
+            if (block->i_buffer <= skip)
+            {
+                skip -= block->i_buffer;
+                dl->pending = block->p_next;
+                block_Release(block);
+            }
+            else
+            {
+                block->p_buffer += skip;
+                block->i_buffer -= skip;
+                skip = 0;
+            }
+        }
+    }
+
+    block_t *block = dl->pending;
+    dl->pending = block->p_next;
+    block->p_next = NULL;
+    vlc_mutex_unlock(&dl->lock);
+    return block;
+}
+
+void vlc_http_parallel_seek(struct vlc_http_parallel *dl, uintmax_t offset)
+{
+    vlc_mutex_lock(&dl->lock);
+    dl->generation++;
+    dl->dispatch = offset / VLC_HTTP_PAR_CHUNK;
+    dl->next = dl->dispatch;
+    dl->skip = offset % VLC_HTTP_PAR_CHUNK;
+    dl->failed = false;
+
+    block_ChainRelease(dl->pending);
+    dl->pending = NULL;
+
+    for (size_t i = 0; i < VLC_HTTP_PAR_DEPTH; i++)
+    {
+        if (dl->window[i].chain != NULL)
+            block_ChainRelease(dl->window[i].chain);
+        dl->window[i].chain = NULL;
+        dl->window[i].state = SEG_EMPTY;
+        dl->window[i].num = UINTMAX_MAX;
+    }
+    vlc_cond_broadcast(&dl->space);
+    vlc_mutex_unlock(&dl->lock);
+}
+
+static void vlc_http_par_destroy(struct vlc_http_parallel *dl)
+{
+    block_ChainRelease(dl->pending);
+    for (size_t i = 0; i < VLC_HTTP_PAR_DEPTH; i++)
+        if (dl->window[i].chain != NULL)
+            block_ChainRelease(dl->window[i].chain);
+
+    free(dl->etag);
+    free(dl->password);
+    free(dl->username);
+    free(dl->referrer);
+    free(dl->agent);
+    free(dl->url);
+    free(dl);
+}
+
+void vlc_http_parallel_destroy(struct vlc_http_parallel *dl)
+{
+    vlc_mutex_lock(&dl->lock);
+    dl->dying = true;
+    vlc_cond_broadcast(&dl->space);
+    vlc_mutex_unlock(&dl->lock);
+
+    for (unsigned i = 0; i < dl->conns; i++)
+        vlc_join(dl->conn[i], NULL);
+
+    vlc_http_par_destroy(dl);
+}
+
+static char *vlc_http_par_dup(const char *str)
+{
+    return (str != NULL) ? strdup(str) : NULL;
+}
+
+struct vlc_http_parallel *vlc_http_parallel_create(vlc_object_t *obj,
+                                        const struct vlc_http_resource *proto,
+                                                   uintmax_t size)
+{
+    /* Small files do not warrant the extra connections */
+    if (size == (uintmax_t)-1 || size < 2 * VLC_HTTP_PAR_CHUNK)
+        return NULL;
+
+    struct vlc_http_parallel *dl = calloc(1, sizeof (*dl));
+    if (unlikely(dl == NULL))
+        return NULL;
+
+    dl->obj = obj;
+    dl->jar = vlc_http_mgr_get_jar(proto->manager);
+    dl->agent = vlc_http_par_dup(proto->agent);
+    dl->referrer = vlc_http_par_dup(proto->referrer);
+    dl->username = vlc_http_par_dup(proto->username);
+    dl->password = vlc_http_par_dup(proto->password);
+    dl->mtime = -1;
+    dl->size = size;
+
+    if (unlikely(asprintf(&dl->url, "http%s://%s%s",
+                          proto->secure ? "s" : "", proto->authority,
+                          proto->path) == -1))
+        dl->url = NULL;
+
+    if (proto->response != NULL)
+    {
+        const char *str = vlc_http_msg_get_header(proto->response, "ETag");
+        if (str != NULL)
+        {
+            if (!memcmp(str, "W/", 2))
+                str += 2; /* skip weak mark */
+            dl->etag = strdup(str);
+        }
+        else
+            dl->mtime = vlc_http_msg_get_mtime(proto->response);
+    }
+
+    vlc_mutex_init(&dl->lock);
+    vlc_cond_init(&dl->data);
+    vlc_cond_init(&dl->space);
+
+    for (size_t i = 0; i < VLC_HTTP_PAR_DEPTH; i++)
+        dl->window[i].num = UINTMAX_MAX;
+    dl->last_growth = vlc_tick_now();
+
+    if (unlikely(dl->url == NULL))
+        goto error;
+
+    for (unsigned i = 0; i < VLC_HTTP_PAR_MIN_CONNS; i++)
+        if (vlc_clone(&dl->conn[dl->conns], vlc_http_par_thread, dl) == 0)
+            dl->conns++;
+    if (dl->conns == 0)
+        goto error;
+
+    return dl;
+
+error:
+    vlc_http_parallel_destroy(dl);
+    return NULL;
+}
@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * parallel.h: HTTP parallel range downloader
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#include <stdint.h>
+
+/**
+ * \defgroup http_parallel Parallel download
+ * Parallel byte range download of HTTP files
+ * \ingroup http_res
+ * @{
+ */
+
+struct vlc_http_resource;
+struct vlc_http_parallel;
+
+/**
+ * Creates a parallel downloader.
+ *
+ * Downloads a seekable remote file as a sequence of bounded byte range
+ * requests spread over multiple HTTP connections, and reassembles the
+ * responses in file order. This works around servers which cap the
+ * throughput of each individual connection.
+ *
+ * Connections are added one at a time, up to a fixed maximum, whenever the
+ * already established ones cannot sustain the consumption rate.
+ *
+ * @param obj VLC object to create connections from
+ * @param proto an open HTTP file resource to take the target URL,
+ *              request context and entity tag from
+ * @param size total byte size of the file (must be known)
+ *
+ * @return a parallel downloader, or NULL on error (in particular if the
+ *         file is too small for parallel download to make sense)
+ */
+struct vlc_http_parallel *vlc_http_parallel_create(vlc_object_t *obj,
+                                        const struct vlc_http_resource *proto,
+                                                   uintmax_t size);
+
+/**
+ * Reads data.
+ *
+ * Reads downloaded data in file order, waiting for it if need be.
+ *
+ * @return a data block, or NULL on end-of-file or unrecoverable error
+ */
+block_t *vlc_http_parallel_read(struct vlc_http_parallel *);
+
+/**
+ * Sets the read offset.
+ *
+ * Discards buffered and in-flight data, and restarts downloading at the
+ * given byte offset.
+ */
+void vlc_http_parallel_seek(struct vlc_http_parallel *, uintmax_t offset);
+
+/**
+ * Destroys a parallel downloader.
+ *
+ * Closes all connections and releases all data held by the downloader.
+ */
+void vlc_http_parallel_destroy(struct vlc_http_parallel *);
+
+/** @} */
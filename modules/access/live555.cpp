@@ -89,6 +89,12 @@ static void Close( vlc_object_t * );
 #define PASS_TEXT N_("Password")
 #define PASS_LONGTEXT N_("Sets the password for the connection, " \
     "if no username or password are set in the url.")
+#define PIPELINE_TEXT N_("Pipeline RTSP SETUP requests")
+#define PIPELINE_LONGTEXT N_("Send the SETUP request of every track " \
+    "back to back instead of waiting for each response, saving one " \
+    "network round trip per track at stream start. Disable this if a " \
+    "server mishandles pipelined requests.")
+
 #define FRAME_BUFFER_SIZE_TEXT N_("RTSP frame buffer size")
 #define FRAME_BUFFER_SIZE_LONGTEXT N_("RTSP start frame buffer size of the video " \
     "track, can be increased in case of broken pictures due " \
@@ -123,6 +129,9 @@ vlc_module_begin ()
         add_integer( "rtsp-http-port", 80,
                   N_("HTTP tunnel port"),
                   N_("Port to use for tunneling the RTSP/RTP over HTTP.") )
+        add_bool(   "rtsp-pipeline", true, PIPELINE_TEXT,
+                    PIPELINE_LONGTEXT )
+            change_safe()
         add_bool(   "rtsp-kasenna", false, KASENNA_TEXT,
                     KASENNA_LONGTEXT )
             change_safe()
@@ -239,6 +248,7 @@ struct demux_sys_t
     bool             b_paused;      /* Are we paused? */
     bool             b_error;
     int              i_live555_ret; /* live555 callback return code */
+    int              i_pending_cmds;/* pipelined commands awaiting a response */
 
     float            f_seek_request;/* In case we receive a seek request while paused*/
 };
@@ -559,6 +569,44 @@ static bool wait_Live555_response( demux_t *p_demux, int i_timeout = 0 /* ms */
     return !p_sys->b_error;
 }
 
+/* Callback for pipelined commands: responses arrive in CSeq order, the
+ * event loop is only woken up once the last one got answered. Individual
+ * failures are detected afterwards (cf. SessionsSetup). */
+static void batch_live555_callback( RTSPClient* client, int result_code,
+                                    char* result_string )
+{
+    RTSPClientVlc *client_vlc = static_cast<RTSPClientVlc *> ( client );
+    demux_sys_t *p_sys = client_vlc->p_sys;
+    delete []result_string;
+    p_sys->i_live555_ret = result_code;
+    if( --p_sys->i_pending_cmds <= 0 )
+        p_sys->event_rtsp = 1;
+}
+
+/* wait until all the pipelined commands got their response (or timeout) */
+static bool wait_Live555_pipelined( demux_t *p_demux, int i_timeout = 0 /* ms */ )
+{
+    TaskToken task;
+    demux_sys_t * p_sys = (demux_sys_t *)p_demux->p_sys;
+    if( p_sys->i_pending_cmds <= 0 )
+        return true;
+    p_sys->event_rtsp = 0;
+    if( i_timeout > 0 )
+    {
+        /* Create a task that will be called if we wait more than timeout ms */
+        task = p_sys->scheduler->scheduleDelayedTask( i_timeout*1000,
+                                                      TaskInterruptRTSP,
+                                                      p_demux );
+    }
+    p_sys->scheduler->doEventLoop( &p_sys->event_rtsp );
+    if( i_timeout > 0 )
+    {
+        /* remove the task */
+        p_sys->scheduler->unscheduleDelayedTask( task );
+    }
+    return p_sys->i_pending_cmds <= 0;
+}
+
 static void continueAfterDESCRIBE( RTSPClient* client, int result_code,
                                    char* result_string )
 {
@@ -750,6 +798,8 @@ static int SessionsSetup( demux_t *p_demux )
                     var_GetBool( p_demux, "rtsp-http" );
     i_client_port = var_InheritInteger( p_demux, "rtp-client-port" );
 
+    bool b_setup_pipelined = p_sys->rtsp != NULL &&
+                             var_InheritBool( p_demux, "rtsp-pipeline" );
 
     /* Create the session from the SDP */
     if( !( p_sys->ms = MediaSession::createNew( *p_sys->env, p_sys->p_sdp ) ) )
@@ -773,6 +823,58 @@ static int SessionsSetup( demux_t *p_demux )
             p_sess_lang = NULL;
     }
 
+    /* Issue the SETUP of every track up front, pipelined: the first one is
+     * sent alone so that its response settles the session identifier and the
+     * transport, then the remaining ones go back to back and their responses
+     * are collected in a single round trip instead of one per track. The
+     * regular pass below skips the subsessions set up here and retries the
+     * failed ones serially. */
+    if( b_setup_pipelined )
+    {
+        MediaSubsessionIterator setup_iter( *p_sys->ms );
+        int i_setup_port = i_client_port;
+        bool b_first = true;
+
+        while( ( sub = setup_iter.next() ) != NULL )
+        {
+            if( strcmp( sub->mediumName(), "audio" ) &&
+                strcmp( sub->mediumName(), "video" ) &&
+                strcmp( sub->mediumName(), "text" ) )
+                continue;
+            if( strcasestr( sub->codecName(), "REAL" ) )
+                continue;
+
+            if( i_setup_port != -1 )
+            {
+                sub->setClientPortNum( i_setup_port );
+                i_setup_port += 2;
+            }
+
+            if( !( !strcmp( sub->codecName(), "X-ASF-PF" ) ?
+                   sub->initiate( 0 ) : sub->initiate() ) )
+                continue; /* the regular pass warns about it */
+
+            if( b_first )
+            {
+                b_first = false;
+                p_sys->rtsp->sendSetupCommand( *sub, default_live555_callback, False,
+                                               toBool( b_rtsp_tcp ),
+                                               toBool( p_sys->b_force_mcast && !b_rtsp_tcp ) );
+                if( !wait_Live555_response( p_demux ) )
+                    break; /* fall back to the serial path for all tracks */
+            }
+            else
+            {
+                p_sys->i_pending_cmds++;
+                p_sys->rtsp->sendSetupCommand( *sub, batch_live555_callback, False,
+                                               toBool( b_rtsp_tcp ),
+                                               toBool( p_sys->b_force_mcast && !b_rtsp_tcp ) );
+            }
+        }
+
+        wait_Live555_pipelined( p_demux );
+    }
+
     /* Initialise each media subsession */
     iter = new MediaSubsessionIterator( *p_sys->ms );
     while( ( sub = iter->next() ) != NULL )
@@ -834,8 +936,8 @@ static int SessionsSetup( demux_t *p_demux )
             msg_Dbg( p_demux, "RTP subsession '%s/%s'", sub->mediumName(),
                      sub->codecName() );
 
-            /* Issue the SETUP */
-            if( p_sys->rtsp )
+            /* Issue the SETUP, unless the pipelined pass already did */
+            if( p_sys->rtsp && sub->sessionId() == NULL )
             {
                 p_sys->rtsp->sendSetupCommand( *sub, default_live555_callback, False,
                                                toBool( b_rtsp_tcp ),
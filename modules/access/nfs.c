@@ -46,10 +46,17 @@
 #include <nfsc/libnfs-raw-nfs.h>
 #include <nfsc/libnfs-raw-mount.h>
 
+#include "block_cache.h"
+
 #define AUTO_GUID_TEXT N_("Set NFS uid/guid automatically")
 #define AUTO_GUID_LONGTEXT N_("If uid/gid are not specified in " \
     "the url, VLC will automatically set a uid/gid.")
 
+#define BLOCK_SIZE_TEXT N_("Read block size")
+#define BLOCK_SIZE_LONGTEXT N_( \
+    "Size in bytes of the aligned blocks fetched from the server and cached " \
+    "locally. 0 disables the cache and issues the demuxer reads directly.")
+
 static int Open(vlc_object_t *);
 static void Close(vlc_object_t *);
 
@@ -58,6 +65,7 @@ vlc_module_begin()
     set_description(N_("NFS input"))
     set_subcategory(SUBCAT_INPUT_ACCESS)
     add_bool("nfs-auto-guid", true, AUTO_GUID_TEXT, AUTO_GUID_LONGTEXT)
+    add_integer("nfs-block-size", 1 << 20, BLOCK_SIZE_TEXT, BLOCK_SIZE_LONGTEXT)
     set_capability("access", 0)
     add_shortcut("nfs")
     set_callbacks(Open, Close)
@@ -78,6 +86,9 @@ typedef struct
     bool                    b_error;
     bool                    b_auto_guid;
 
+    struct vlc_blk_cache    blk_cache;
+    bool                    b_blk_cache;
+
     union {
         struct
         {
@@ -93,6 +104,10 @@ typedef struct
         {
             bool b_done;
         } seek;
+        struct
+        {
+            bool b_done;
+        } refresh;
     } res;
 } access_sys_t;
 
@@ -201,7 +216,7 @@ nfs_read_finished_cb(stream_t *p_access)
 }
 
 static ssize_t
-FileRead(stream_t *p_access, void *p_buf, size_t i_len)
+FileReadUncached(stream_t *p_access, void *p_buf, size_t i_len)
 {
     access_sys_t *p_sys = p_access->p_sys;
 
@@ -252,7 +267,7 @@ nfs_seek_finished_cb(stream_t *p_access)
 }
 
 static int
-FileSeek(stream_t *p_access, uint64_t i_pos)
+FileSeekUncached(stream_t *p_access, uint64_t i_pos)
 {
     access_sys_t *p_sys = p_access->p_sys;
 
@@ -272,6 +287,79 @@ FileSeek(stream_t *p_access, uint64_t i_pos)
     return VLC_SUCCESS;
 }
 
+static void
+nfs_refresh_stat_cb(int i_status, struct nfs_context *p_nfs, void *p_data,
+                    void *p_private_data)
+{
+    VLC_UNUSED(p_nfs);
+    stream_t *p_access = p_private_data;
+    access_sys_t *p_sys = p_access->p_sys;
+    assert(p_sys->p_nfs == p_nfs);
+    if (NFS_CHECK_STATUS(p_access, i_status, p_data))
+        return;
+
+    p_sys->stat = *(struct nfs_stat_64 *)p_data;
+    p_sys->res.refresh.b_done = true;
+}
+
+static bool
+nfs_refresh_stat_finished_cb(stream_t *p_access)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+    return p_sys->res.refresh.b_done;
+}
+
+static int
+FileGetMtime(stream_t *p_access, uint64_t *pi_mtime)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    p_sys->res.refresh.b_done = false;
+    if (nfs_stat64_async(p_sys->p_nfs, p_sys->p_nfs_url->file,
+                         nfs_refresh_stat_cb, p_access) < 0)
+    {
+        msg_Err(p_access, "nfs_stat64_async failed");
+        return VLC_EGENERIC;
+    }
+
+    if (vlc_nfs_mainloop(p_access, nfs_refresh_stat_finished_cb) < 0)
+        return VLC_EGENERIC;
+
+    *pi_mtime = p_sys->stat.nfs_mtime;
+    return VLC_SUCCESS;
+}
+
+static const struct vlc_blk_cache_ops nfs_blk_cache_ops = {
+    .read = FileReadUncached,
+    .seek = FileSeekUncached,
+    .get_mtime = FileGetMtime,
+};
+
+static ssize_t
+FileRead(stream_t *p_access, void *p_buf, size_t i_len)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    if (!p_sys->b_blk_cache)
+        return FileReadUncached(p_access, p_buf, i_len);
+
+    ssize_t i_val = vlc_blk_cache_Read(p_access, &p_sys->blk_cache, p_buf,
+                                       i_len);
+    return i_val < 0 ? 0 : i_val;
+}
+
+static int
+FileSeek(stream_t *p_access, uint64_t i_pos)
+{
+    access_sys_t *p_sys = p_access->p_sys;
+
+    if (!p_sys->b_blk_cache)
+        return FileSeekUncached(p_access, i_pos);
+
+    vlc_blk_cache_Seek(&p_sys->blk_cache, i_pos);
+    return VLC_SUCCESS;
+}
+
 static int
 FileControl(stream_t *p_access, int i_query, va_list args)
 {
@@ -706,6 +794,14 @@ Open(vlc_object_t *p_obj)
 
         if (p_sys->p_nfsfh != NULL)
         {
+            uint64_t i_block_size = var_InheritInteger(p_access,
+                                                       "nfs-block-size");
+            if (i_block_size > 0)
+            {
+                vlc_blk_cache_Init(&p_sys->blk_cache, &nfs_blk_cache_ops,
+                                   i_block_size, p_sys->stat.nfs_mtime);
+                p_sys->b_blk_cache = true;
+            }
             p_access->pf_read = FileRead;
             p_access->pf_seek = FileSeek;
             p_access->pf_control = FileControl;
@@ -763,6 +859,9 @@ Close(vlc_object_t *p_obj)
     stream_t *p_access = (stream_t *)p_obj;
     access_sys_t *p_sys = p_access->p_sys;
 
+    if (p_sys->b_blk_cache)
+        vlc_blk_cache_Destroy(&p_sys->blk_cache);
+
     if (p_sys->p_nfsfh != NULL)
         nfs_close(p_sys->p_nfs, p_sys->p_nfsfh);
 
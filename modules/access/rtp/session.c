@@ -25,6 +25,7 @@
 #endif
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -125,6 +126,12 @@ int rtp_add_type(rtp_session_t *ses, rtp_pt_t *pt)
     return 0;
 }
 
+/* Bounds for the adaptive packet reordering window */
+#define RTP_WINDOW_MIN VLC_TICK_FROM_MS(25)
+#define RTP_WINDOW_MAX VLC_TICK_FROM_MS(500)
+/* Interval between periodic per-source statistics reports */
+#define RTP_STATS_PERIOD VLC_TICK_FROM_SEC(10)
+
 /** State for an RTP source */
 struct rtp_source_t
 {
@@ -133,6 +140,16 @@ struct rtp_source_t
     vlc_tick_t  last_rx; /* last received packet local timestamp */
     uint32_t last_ts; /* last received packet RTP timestamp */
 
+    vlc_tick_t window; /* adaptive reordering window (floor) */
+    vlc_tick_t next_report; /* deadline for the next statistics report */
+    struct {
+        uint64_t received; /* packets queued */
+        uint64_t lost; /* packets given up waiting for */
+        uint64_t late; /* packets received after their window expired */
+        uint64_t duplicates; /* duplicate packets dropped */
+        unsigned depth; /* currently queued packets */
+    } stats;
+
     uint32_t ref_rtp; /* sender RTP timestamp reference */
     vlc_tick_t  ref_ntp; /* sender NTP timestamp reference */
 
@@ -162,6 +179,9 @@ rtp_source_create (struct vlc_logger *logger, const rtp_session_t *session,
 
     source->ssrc = ssrc;
     source->jitter = 0;
+    source->window = RTP_WINDOW_MIN;
+    source->next_report = VLC_TICK_INVALID;
+    memset (&source->stats, 0, sizeof (source->stats));
     source->ref_rtp = 0;
     source->ref_ntp = UINT64_C (1) << 51;
     source->max_seq = source->bad_seq = init_seq;
@@ -179,6 +199,10 @@ rtp_source_create (struct vlc_logger *logger, const rtp_session_t *session,
 static void rtp_source_destroy(struct vlc_logger *logger, rtp_source_t *source)
 {
     vlc_debug (logger, "removing RTP source (%08x)", source->ssrc);
+    vlc_debug (logger, "source %08x: %"PRIu64" packets received, "
+               "%"PRIu64" lost, %"PRIu64" late, %"PRIu64" duplicate(s)",
+               source->ssrc, source->stats.received, source->stats.lost,
+               source->stats.late, source->stats.duplicates);
     if (source->pt.instance != NULL)
         vlc_rtp_pt_end(source->pt.instance, source->pt.opaque);
     block_ChainRelease (source->blocks);
@@ -325,6 +349,7 @@ rtp_queue (struct vlc_logger *logger, rtp_session_t *session, block_t *block)
             vlc_warning (logger, "sequence resynchronized");
             block_ChainRelease (src->blocks);
             src->blocks = NULL;
+            src->stats.depth = 0;
         }
         else
         {
@@ -347,12 +372,15 @@ rtp_queue (struct vlc_logger *logger, rtp_session_t *session, block_t *block)
         if (delta_seq.s == 0)
         {
             vlc_debug (logger, "duplicate packet (sequence: %"PRIu16")", seq);
+            src->stats.duplicates++;
             goto drop; /* duplicate */
         }
         pp = &prev->p_next;
     }
     block->p_next = *pp;
     *pp = block;
+    src->stats.received++;
+    src->stats.depth++;
 
     /*rtp_decode (demux, session, src);*/
     return;
@@ -387,6 +415,17 @@ bool rtp_dequeue (struct vlc_logger *logger, const rtp_session_t *session,
         rtp_source_t *src = session->srcv[i];
         block_t *block;
 
+        if (src->next_report == VLC_TICK_INVALID)
+            src->next_report = now + RTP_STATS_PERIOD;
+        else if (now >= src->next_report)
+        {
+            vlc_debug (logger, "source %08x: depth %u, %"PRIu64" lost, "
+                       "%"PRIu64" late, window %"PRId64" ms", src->ssrc,
+                       src->stats.depth, src->stats.lost, src->stats.late,
+                       MS_FROM_VLC_TICK(src->window));
+            src->next_report = now + RTP_STATS_PERIOD;
+        }
+
         /* Because of IP packet delay variation (IPDV), we need to guesstimate
          * how long to wait for a missing packet in the RTP sequence
          * (see RFC3393 for background on IPDV).
@@ -421,9 +460,14 @@ bool rtp_dequeue (struct vlc_logger *logger, const rtp_session_t *session,
             else
                 deadline = 0; /* no jitter estimate with no frequency :( */
 
-            /* Make sure we wait at least for 25 msec */
-            if (deadline < VLC_TICK_FROM_MS(25))
-                deadline = VLC_TICK_FROM_MS(25);
+            /* The adaptive window provides the floor: it grows whenever
+             * packets turn out to arrive after we gave up on them, and
+             * decays back while the stream is in order, so the added
+             * latency floats at the minimum safe value. */
+            if (deadline < src->window)
+                deadline = src->window;
+            if (deadline > RTP_WINDOW_MAX)
+                deadline = RTP_WINDOW_MAX;
 
             /* Additionally, we implicitly wait for the packetization time
              * multiplied by the number of missing packets. block is the first
@@ -456,6 +500,7 @@ rtp_decode (struct vlc_logger *logger, const rtp_session_t *session, rtp_source_
     assert (block);
     src->blocks = block->p_next;
     block->p_next = NULL;
+    src->stats.depth--;
 
     /* Discontinuity detection */
     uint16_t delta_seq = rtp_seq (block) - (src->last_seq + 1);
@@ -465,11 +510,22 @@ rtp_decode (struct vlc_logger *logger, const rtp_session_t *session, rtp_source_
         {   /* Trash too late packets (and PIM Assert duplicates) */
             vlc_debug (logger, "ignoring late packet (sequence: %"PRIu16")",
                       rtp_seq (block));
+            /* The reordering window was too small: grow it so the next
+             * comparable delay spike does not cost packets. */
+            src->stats.late++;
+            src->window *= 2;
+            if (src->window > RTP_WINDOW_MAX)
+                src->window = RTP_WINDOW_MAX;
             goto drop;
         }
         vlc_warning (logger, "%"PRIu16" packet(s) lost", delta_seq);
+        src->stats.lost += delta_seq;
         block->i_flags |= BLOCK_FLAG_DISCONTINUITY;
     }
+    else
+        /* In-order delivery: let the window decay back towards its floor
+         * (geometric, roughly a few seconds at usual packet rates) */
+        src->window -= (src->window - RTP_WINDOW_MIN) >> 8;
     src->last_seq = rtp_seq (block);
 
     /* Match the payload type */
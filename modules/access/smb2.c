@@ -95,6 +95,12 @@ netbios_ns_interrupt_unregister(void)
 
 #include "smb_common.h"
 #include "cache.h"
+#include "block_cache.h"
+
+#define SMB2_BLOCK_SIZE_TEXT N_("Read block size")
+#define SMB2_BLOCK_SIZE_LONGTEXT N_( \
+    "Size in bytes of the aligned blocks fetched from the server and cached " \
+    "locally. 0 disables the cache and issues the demuxer reads directly.")
 
 static int Open(vlc_object_t *);
 static void Close(vlc_object_t *);
@@ -108,6 +114,8 @@ vlc_module_begin()
     add_string("smb-user", NULL, SMB_USER_TEXT, SMB_USER_LONGTEXT)
     add_password("smb-pwd", NULL, SMB_PASS_TEXT, SMB_PASS_LONGTEXT)
     add_string("smb-domain", NULL, SMB_DOMAIN_TEXT, SMB_DOMAIN_LONGTEXT)
+    add_integer("smb2-block-size", 1 << 20,
+                SMB2_BLOCK_SIZE_TEXT, SMB2_BLOCK_SIZE_LONGTEXT)
     add_shortcut("smb", "smb2")
     set_callbacks(Open, Close)
 vlc_module_end()
@@ -121,10 +129,14 @@ struct access_sys
     struct smb2dir *        smb2dir;
     struct srvsvc_netshareenumall_rep *share_enum;
     uint64_t                smb2_size;
+    uint64_t                smb2_mtime;
     vlc_url_t               encoded_url;
     bool                    eof;
     bool                    smb2_connected;
 
+    struct vlc_blk_cache    blk_cache;
+    bool                    blk_cache_enabled;
+
     struct vlc_access_cache_entry *cache_entry;
 };
 
@@ -282,7 +294,7 @@ smb2_read_cb(struct smb2_context *smb2, int status, void *data,
 }
 
 static ssize_t
-FileRead(stream_t *access, void *buf, size_t len)
+FileReadUncached(stream_t *access, void *buf, size_t len)
 {
     struct access_sys *sys = access->p_sys;
 
@@ -316,7 +328,7 @@ FileRead(stream_t *access, void *buf, size_t len)
 }
 
 static int
-FileSeek(stream_t *access, uint64_t i_pos)
+FileSeekUncached(stream_t *access, uint64_t i_pos)
 {
     struct access_sys *sys = access->p_sys;
 
@@ -343,6 +355,66 @@ FileSeek(stream_t *access, uint64_t i_pos)
     return VLC_SUCCESS;
 }
 
+static int
+FileGetMtime(stream_t *access, uint64_t *mtime)
+{
+    struct access_sys *sys = access->p_sys;
+
+    if (sys->smb2 == NULL)
+        return VLC_EGENERIC;
+
+    struct smb2_stat_64 smb2_stat;
+    struct vlc_smb2_op op = VLC_SMB2_OP(access, &sys->smb2);
+
+    int err = smb2_fstat_async(op.smb2, sys->smb2fh, &smb2_stat,
+                               smb2_generic_cb, &op);
+    if (err < 0)
+    {
+        VLC_SMB2_SET_ERROR(&op, "smb2_fstat_async", err);
+        return VLC_EGENERIC;
+    }
+
+    if (vlc_smb2_mainloop(&op) != 0)
+        return VLC_EGENERIC;
+
+    sys->smb2_size = smb2_stat.smb2_size; /* the file may have grown */
+    *mtime = smb2_stat.smb2_mtime;
+    return VLC_SUCCESS;
+}
+
+static const struct vlc_blk_cache_ops smb2_blk_cache_ops = {
+    .read = FileReadUncached,
+    .seek = FileSeekUncached,
+    .get_mtime = FileGetMtime,
+};
+
+static ssize_t
+FileRead(stream_t *access, void *buf, size_t len)
+{
+    struct access_sys *sys = access->p_sys;
+
+    if (!sys->blk_cache_enabled)
+        return FileReadUncached(access, buf, len);
+
+    ssize_t val = vlc_blk_cache_Read(access, &sys->blk_cache, buf, len);
+    return val < 0 ? 0 : val;
+}
+
+static int
+FileSeek(stream_t *access, uint64_t i_pos)
+{
+    struct access_sys *sys = access->p_sys;
+
+    if (!sys->blk_cache_enabled)
+        return FileSeekUncached(access, i_pos);
+
+    if (sys->smb2 == NULL)
+        return VLC_EGENERIC;
+
+    vlc_blk_cache_Seek(&sys->blk_cache, i_pos);
+    return VLC_SUCCESS;
+}
+
 static int
 FileControl(stream_t *access, int i_query, va_list args)
 {
@@ -608,6 +680,7 @@ vlc_smb2_open_share(stream_t *access, struct smb2_context **smb2p,
             vlc_smb2_op_reset(&op, smb2p);
 
             sys->smb2_size = smb2_stat.smb2_size;
+            sys->smb2_mtime = smb2_stat.smb2_mtime;
             ret = smb2_open_async(op.smb2, smb2_url->path, O_RDONLY,
                                   smb2_open_cb, &op);
         }
@@ -946,6 +1019,13 @@ Open(vlc_object_t *p_obj)
 
     if (sys->smb2fh != NULL)
     {
+        uint64_t block_size = var_InheritInteger(access, "smb2-block-size");
+        if (block_size > 0)
+        {
+            vlc_blk_cache_Init(&sys->blk_cache, &smb2_blk_cache_ops,
+                               block_size, sys->smb2_mtime);
+            sys->blk_cache_enabled = true;
+        }
         access->pf_read = FileRead;
         access->pf_seek = FileSeek;
         access->pf_control = FileControl;
@@ -988,6 +1068,8 @@ Close(vlc_object_t *p_obj)
 
     if (sys->smb2fh != NULL)
     {
+        if (sys->blk_cache_enabled)
+            vlc_blk_cache_Destroy(&sys->blk_cache);
         if (sys->smb2)
             vlc_smb2_close_fh(access, &sys->smb2, sys->smb2fh);
     }
@@ -41,6 +41,9 @@
 #include <vlc_network.h>
 #include <vlc_block.h>
 #include <vlc_interrupt.h>
+#include <vlc_queue.h>
+
+#include <stdatomic.h>
 #ifdef HAVE_POLL_H
 # include <poll.h>
 #endif
@@ -53,13 +56,33 @@
  */
 #define MRU 65507u
 
+#ifdef HAVE_RECVMMSG
+/* How many datagrams to read from the kernel per wake-up. High bitrate
+ * multicast TS easily reaches 70+ kpps; batching amortizes the syscall
+ * and poll() costs. */
+# define UDP_BATCH 16
+#endif
+
 typedef struct {
     int fd;
     int timeout;
 
+    struct fanout_consumer *consumer; /* shared-socket mode, or NULL */
+    vlc_tick_t last_recv; /* time of the last dequeued datagram */
+
+#ifdef HAVE_RECVMMSG
+    struct mmsghdr msgv[UDP_BATCH];
+    struct iovec iov[UDP_BATCH];
+# ifdef SO_RXQ_OVFL
+    char ctl[UDP_BATCH][CMSG_SPACE(sizeof (uint32_t))];
+    uint32_t dropped; /* cumulative kernel receive queue drop count */
+# endif
+    char (*bufv)[MRU]; /* pre-allocated receive ring, UDP_BATCH slots */
+#else
     size_t length;
     char *offset;
     char buf[MRU];
+#endif
 } access_sys_t;
 
 static int Control(stream_t *access, int query, va_list args)
@@ -83,6 +106,381 @@ static int Control(stream_t *access, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+/*****************************************************************************
+ * Shared-socket fanout
+ *****************************************************************************
+ * Several inputs in the same process tuned to one multicast group each get
+ * their own socket and kernel delivery path, so a 16-tile mosaic makes the
+ * kernel duplicate every datagram 16 times. With udp-fanout enabled, streams
+ * with the same bind/source addresses and ports share a single socket: a
+ * reader thread receives each datagram once into a refcounted payload and
+ * queues a lightweight reference to every local consumer.
+ *****************************************************************************/
+
+/* Refcounted datagram payload shared by all consumers of a source */
+struct fanout_payload
+{
+    atomic_uint refs;
+    uint8_t data[];
+};
+
+struct fanout_consumer
+{
+    struct fanout_consumer *next;
+    struct fanout_source *source;
+    vlc_queue_t queue; /* of vlc_frame_t */
+    atomic_size_t queued; /* bytes pending in the queue */
+    atomic_uint dropped; /* datagrams dropped on overload */
+};
+
+struct fanout_source
+{
+    struct fanout_source *next;
+    char *key; /* "bind:port/server:port" */
+    int fd;
+    unsigned refs;
+    vlc_thread_t thread;
+    vlc_mutex_t lock; /* protects the consumers list */
+    struct fanout_consumer *consumers;
+    uint8_t *buf; /* MRU-sized receive buffer of the reader thread */
+};
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct fanout_source *sources;
+} fanout = { VLC_STATIC_MUTEX, NULL };
+
+/* Per-consumer backlog bound: beyond this, datagrams are dropped (and
+ * counted) for that consumer rather than eating memory when it stalls. */
+#define FANOUT_QUEUE_MAX (4u << 20)
+
+static void fanout_payload_Release(struct fanout_payload *payload)
+{
+    if (atomic_fetch_sub_explicit(&payload->refs, 1,
+                                  memory_order_release) == 1)
+        free(payload);
+}
+
+static void fanout_frame_Release(vlc_frame_t *frame)
+{
+    struct fanout_payload *payload = (struct fanout_payload *)
+        (frame->p_start - offsetof(struct fanout_payload, data));
+
+    fanout_payload_Release(payload);
+    free(frame);
+}
+
+static const struct vlc_frame_callbacks fanout_frame_cbs =
+{
+    fanout_frame_Release,
+};
+
+static void *fanout_Thread(void *opaque)
+{
+    struct fanout_source *source = opaque;
+
+    vlc_thread_set_name("vlc-udp-fanout");
+
+    for (;;)
+    {
+        /* recv() is the cancellation point of this loop */
+        ssize_t len = recv(source->fd, source->buf, MRU, 0);
+        if (len < 0)
+        {   /* Do not spin on persistent socket errors */
+            vlc_tick_sleep(VLC_TICK_FROM_MS(100));
+            continue;
+        }
+
+        struct fanout_payload *payload = malloc(sizeof (*payload) + len);
+        if (unlikely(payload == NULL))
+            continue;
+        atomic_init(&payload->refs, 1); /* creator reference */
+        memcpy(payload->data, source->buf, len);
+
+        vlc_mutex_lock(&source->lock);
+        for (struct fanout_consumer *c = source->consumers;
+             c != NULL; c = c->next)
+        {
+            if (atomic_load_explicit(&c->queued, memory_order_relaxed)
+                    + (size_t)len > FANOUT_QUEUE_MAX)
+            {
+                atomic_fetch_add_explicit(&c->dropped, 1,
+                                          memory_order_relaxed);
+                continue;
+            }
+
+            vlc_frame_t *frame = vlc_frame_New(&fanout_frame_cbs,
+                                               payload->data, len);
+            if (unlikely(frame == NULL))
+                continue;
+            atomic_fetch_add_explicit(&payload->refs, 1,
+                                      memory_order_relaxed);
+            atomic_fetch_add_explicit(&c->queued, len,
+                                      memory_order_relaxed);
+            vlc_queue_Enqueue(&c->queue, frame);
+        }
+        vlc_mutex_unlock(&source->lock);
+
+        fanout_payload_Release(payload);
+    }
+
+    vlc_assert_unreachable();
+}
+
+static void fanout_source_Delete(struct fanout_source *source)
+{
+    vlc_cancel(source->thread);
+    vlc_join(source->thread, NULL);
+    net_Close(source->fd);
+    free(source->buf);
+    free(source->key);
+    free(source);
+}
+
+static struct fanout_consumer *
+fanout_ConsumerNew(stream_t *access, const char *bind_addr, int bind_port,
+                   const char *server_addr, int server_port)
+{
+    char *key;
+
+    if (asprintf(&key, "%s:%d/%s:%d", bind_addr, bind_port,
+                 server_addr, server_port) == -1)
+        return NULL;
+
+    struct fanout_consumer *consumer = malloc(sizeof (*consumer));
+    if (unlikely(consumer == NULL))
+    {
+        free(key);
+        return NULL;
+    }
+    vlc_queue_Init(&consumer->queue, offsetof (vlc_frame_t, p_next));
+    atomic_init(&consumer->queued, 0);
+    atomic_init(&consumer->dropped, 0);
+
+    vlc_mutex_lock(&fanout.lock);
+    struct fanout_source *source;
+    for (source = fanout.sources; source != NULL; source = source->next)
+        if (!strcmp(source->key, key))
+            break;
+
+    if (source != NULL)
+    {
+        source->refs++;
+        msg_Dbg(access, "sharing socket of %s (%u consumers)",
+                source->key, source->refs);
+        free(key);
+    }
+    else
+    {
+        source = malloc(sizeof (*source));
+        if (unlikely(source == NULL))
+            goto error;
+        source->buf = malloc(MRU);
+        if (unlikely(source->buf == NULL))
+        {
+            free(source);
+            goto error;
+        }
+
+        source->fd = net_OpenDgram(access, bind_addr, bind_port,
+                                   server_addr, server_port, IPPROTO_UDP);
+        if (source->fd == -1)
+        {
+            msg_Err(access, "cannot open socket");
+            free(source->buf);
+            free(source);
+            goto error;
+        }
+
+        source->key = key;
+        source->refs = 1;
+        vlc_mutex_init(&source->lock);
+        source->consumers = NULL;
+
+        if (vlc_clone(&source->thread, fanout_Thread, source))
+        {
+            net_Close(source->fd);
+            free(source->buf);
+            free(source);
+            goto error;
+        }
+
+        source->next = fanout.sources;
+        fanout.sources = source;
+    }
+
+    consumer->source = source;
+    vlc_mutex_lock(&source->lock);
+    consumer->next = source->consumers;
+    source->consumers = consumer;
+    vlc_mutex_unlock(&source->lock);
+    vlc_mutex_unlock(&fanout.lock);
+
+    return consumer;
+
+error:
+    vlc_mutex_unlock(&fanout.lock);
+    free(key);
+    free(consumer);
+    return NULL;
+}
+
+static void fanout_ConsumerDelete(struct fanout_consumer *consumer)
+{
+    struct fanout_source *source = consumer->source;
+    struct fanout_source *unused = NULL;
+
+    vlc_mutex_lock(&fanout.lock);
+    vlc_mutex_lock(&source->lock);
+    for (struct fanout_consumer **pp = &source->consumers; *pp != NULL;
+         pp = &(*pp)->next)
+        if (*pp == consumer)
+        {
+            *pp = consumer->next;
+            break;
+        }
+    vlc_mutex_unlock(&source->lock);
+
+    if (--source->refs == 0)
+    {
+        for (struct fanout_source **pp = &fanout.sources; *pp != NULL;
+             pp = &(*pp)->next)
+            if (*pp == source)
+            {
+                *pp = source->next;
+                break;
+            }
+        unused = source;
+    }
+    vlc_mutex_unlock(&fanout.lock);
+
+    if (unused != NULL)
+        fanout_source_Delete(unused);
+
+    /* The reader cannot reach this consumer any more: flush and free */
+    vlc_frame_t *frame = vlc_queue_DequeueAll(&consumer->queue);
+    while (frame != NULL)
+    {
+        vlc_frame_t *next = frame->p_next;
+        vlc_frame_Release(frame);
+        frame = next;
+    }
+    free(consumer);
+}
+
+static block_t *BlockFanout(stream_t *access, bool *restrict eof)
+{
+    access_sys_t *sys = access->p_sys;
+    struct fanout_consumer *consumer = sys->consumer;
+
+    /* Wake up regularly so the input thread can process interruptions */
+    vlc_tick_t deadline = vlc_tick_now() + VLC_TICK_FROM_MS(500);
+    vlc_frame_t *frame;
+
+    vlc_queue_Lock(&consumer->queue);
+    while (vlc_queue_IsEmpty(&consumer->queue)
+        && vlc_cond_timedwait(&consumer->queue.wait, &consumer->queue.lock,
+                              deadline) == 0);
+    frame = vlc_queue_DequeueUnlocked(&consumer->queue);
+    vlc_queue_Unlock(&consumer->queue);
+
+    if (frame == NULL)
+    {
+        if (sys->timeout > 0
+         && vlc_tick_now() >= sys->last_recv
+                            + VLC_TICK_FROM_MS(sys->timeout))
+        {
+            msg_Err(access, "receive time-out");
+            *eof = true;
+        }
+        return NULL;
+    }
+
+    atomic_fetch_sub_explicit(&consumer->queued, frame->i_buffer,
+                              memory_order_relaxed);
+    sys->last_recv = vlc_tick_now();
+
+    unsigned dropped = atomic_exchange_explicit(&consumer->dropped, 0,
+                                                memory_order_relaxed);
+    if (dropped > 0)
+        msg_Warn(access, "%u datagram(s) dropped on fanout overload",
+                 dropped);
+    return frame;
+}
+
+#ifdef HAVE_RECVMMSG
+static block_t *BlockUDP(stream_t *access, bool *restrict eof)
+{
+    access_sys_t *sys = access->p_sys;
+
+    struct pollfd ufd[1];
+
+    ufd[0].fd = sys->fd;
+    ufd[0].events = POLLIN;
+
+    switch (vlc_poll_i11e(ufd, 1, sys->timeout)) {
+        case 0:
+            msg_Err(access, "receive time-out");
+            *eof = true;
+            /* fall through */
+        case -1:
+            return NULL;
+    }
+
+#ifdef SO_RXQ_OVFL
+    for (size_t i = 0; i < UDP_BATCH; i++) {
+        /* The kernel rewrites the control length on each receive */
+        sys->msgv[i].msg_hdr.msg_control = sys->ctl[i];
+        sys->msgv[i].msg_hdr.msg_controllen = sizeof (sys->ctl[i]);
+    }
+#endif
+
+    int n = recvmmsg(sys->fd, sys->msgv, UDP_BATCH, MSG_DONTWAIT, NULL);
+    if (n <= 0) /* empty (0 datagrams) is a spurious wake-up, not EOF */
+        return NULL;
+
+    size_t total = 0;
+    for (int i = 0; i < n; i++)
+        total += sys->msgv[i].msg_len;
+
+    block_t *block = block_Alloc(total);
+    if (unlikely(block == NULL))
+        return NULL;
+
+    /* This access provides a byte stream, so datagram boundaries need not
+     * be preserved: compact the batch into a single block. */
+    uint8_t *p = block->p_buffer;
+    for (int i = 0; i < n; i++) {
+        memcpy(p, sys->bufv[i], sys->msgv[i].msg_len);
+        p += sys->msgv[i].msg_len;
+    }
+
+#ifdef SO_RXQ_OVFL
+    /* The kernel reports its cumulative receive queue drop count as
+     * ancillary data on each datagram; the last one is the most recent. */
+    struct msghdr *hdr = &sys->msgv[n - 1].msg_hdr;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET
+         && cmsg->cmsg_type == SO_RXQ_OVFL) {
+            uint32_t dropped;
+
+            memcpy(&dropped, CMSG_DATA(cmsg), sizeof (dropped));
+            if (dropped != sys->dropped) {
+                msg_Warn(access, "%"PRIu32" datagram(s) dropped by the "
+                         "kernel receive queue (%"PRIu32" total)",
+                         dropped - sys->dropped, dropped);
+                sys->dropped = dropped;
+            }
+        }
+    }
+#endif
+    return block;
+}
+
+#else /* !HAVE_RECVMMSG */
+
 static ssize_t Read(stream_t *access, void *buf, size_t len)
 {
     access_sys_t *sys = access->p_sys;
@@ -131,6 +529,7 @@ static ssize_t Read(stream_t *access, void *buf, size_t len)
 
     return val;
 }
+#endif /* !HAVE_RECVMMSG */
 
 /*****************************************************************************
  * Open: open the socket
@@ -147,10 +546,28 @@ static int Open( vlc_object_t *p_this )
     if( unlikely( sys == NULL ) )
         return VLC_ENOMEM;
 
-    sys->length = 0;
     p_access->p_sys = sys;
+#ifdef HAVE_RECVMMSG
+    sys->bufv = vlc_obj_malloc( p_this, UDP_BATCH * sizeof( *sys->bufv ) );
+    if( unlikely( sys->bufv == NULL ) )
+        return VLC_ENOMEM;
+
+    for( size_t i = 0; i < UDP_BATCH; i++ )
+    {
+        sys->iov[i] = (struct iovec) {
+            .iov_base = sys->bufv[i], .iov_len = MRU,
+        };
+        sys->msgv[i] = (struct mmsghdr) { .msg_hdr = {
+            .msg_iov = &sys->iov[i], .msg_iovlen = 1,
+        } };
+    }
+    p_access->pf_read = NULL;
+    p_access->pf_block = BlockUDP;
+#else
+    sys->length = 0;
     p_access->pf_read = Read;
     p_access->pf_block = NULL;
+#endif
     p_access->pf_control = Control;
     p_access->pf_seek = NULL;
 
@@ -204,6 +621,27 @@ static int Open( vlc_object_t *p_this )
     msg_Dbg( p_access, "opening server=%s:%d local=%s:%d",
              psz_server_addr, i_server_port, psz_bind_addr, i_bind_port );
 
+    sys->timeout = var_InheritInteger( p_access, "udp-timeout");
+    if( sys->timeout > 0)
+        sys->timeout *= 1000;
+
+    if( var_InheritBool( p_access, "udp-fanout" ) )
+    {
+        sys->consumer = fanout_ConsumerNew( p_access, psz_bind_addr,
+                                            i_bind_port, psz_server_addr,
+                                            i_server_port );
+        free( psz_name );
+        if( sys->consumer == NULL )
+            return VLC_EGENERIC;
+
+        sys->fd = -1;
+        sys->last_recv = vlc_tick_now();
+        p_access->pf_read = NULL;
+        p_access->pf_block = BlockFanout;
+        return VLC_SUCCESS;
+    }
+    sys->consumer = NULL;
+
     sys->fd = net_OpenDgram( p_access, psz_bind_addr, i_bind_port,
                              psz_server_addr, i_server_port, IPPROTO_UDP );
     free( psz_name );
@@ -213,9 +651,12 @@ static int Open( vlc_object_t *p_this )
         return VLC_EGENERIC;
     }
 
-    sys->timeout = var_InheritInteger( p_access, "udp-timeout");
-    if( sys->timeout > 0)
-        sys->timeout *= 1000;
+#if defined (HAVE_RECVMMSG) && defined (SO_RXQ_OVFL)
+    /* Ask the kernel to report receive queue overflows (best effort) */
+    setsockopt( sys->fd, SOL_SOCKET, SO_RXQ_OVFL,
+                &(int){ 1 }, sizeof (int) );
+    sys->dropped = 0;
+#endif
 
     return VLC_SUCCESS;
 }
@@ -228,11 +669,20 @@ static void Close( vlc_object_t *p_this )
     stream_t     *p_access = (stream_t*)p_this;
     access_sys_t *sys = p_access->p_sys;
 
-    net_Close( sys->fd );
+    if( sys->consumer != NULL )
+        fanout_ConsumerDelete( sys->consumer );
+    else
+        net_Close( sys->fd );
 }
 
 #define TIMEOUT_TEXT N_("UDP Source timeout (sec)")
 
+#define FANOUT_TEXT N_("Share the socket between identical streams")
+#define FANOUT_LONGTEXT N_("Receive each multicast group and port on a " \
+    "single socket and distribute the datagrams to every local stream " \
+    "reading it, instead of one kernel delivery path per stream. Useful " \
+    "for mosaic setups tuning many inputs to the same group.")
+
 vlc_module_begin()
     set_shortname(N_("UDP"))
     set_description(N_("UDP input"))
@@ -240,6 +690,7 @@ vlc_module_begin()
 
     add_obsolete_integer("udp-buffer") /* since 3.0.0 */
     add_integer("udp-timeout", -1, TIMEOUT_TEXT, NULL)
+    add_bool("udp-fanout", false, FANOUT_TEXT, FANOUT_LONGTEXT)
 
     set_capability("access", 0)
     add_shortcut("udp", "udpstream", "udp4", "udp6")
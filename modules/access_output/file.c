@@ -35,6 +35,9 @@
 #include <errno.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#ifdef HAVE_SYS_UIO_H
+#   include <sys/uio.h>
+#endif
 #ifdef __OS2__
 #   include <io.h>      /* setmode() */
 #endif
@@ -72,78 +75,75 @@ static ssize_t Read( sout_access_out_t *p_access, block_t *p_buffer )
     return val;
 }
 
-/*****************************************************************************
- * Write: standard write on a file descriptor.
- *****************************************************************************/
-static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
+/* Muxers hand over long chains of small blocks (TS packets notably):
+ * gather them into one system call, in bounded batches. */
+#define FILE_IOV_MAX 64
+
+static int BlockVec(const block_t *block, struct iovec *iov)
 {
-    int *fdp = p_access->p_sys, fd = *fdp;
-    size_t i_write = 0;
+    int count = 0;
 
-    while( p_buffer )
+    for (; block != NULL && count < FILE_IOV_MAX; block = block->p_next)
     {
-        ssize_t val = write(fd, p_buffer->p_buffer, p_buffer->i_buffer);
-        if (val <= 0)
-        {
-            if (errno == EINTR)
-                continue;
-            block_ChainRelease (p_buffer);
-            msg_Err( p_access, "cannot write: %s", vlc_strerror_c(errno) );
-            return -1;
-        }
+        iov[count].iov_base = block->p_buffer;
+        iov[count].iov_len = block->i_buffer;
+        count++;
+    }
+    return count;
+}
 
-        if ((size_t)val >= p_buffer->i_buffer)
-        {
-            block_t *p_next = p_buffer->p_next;
-            block_Release (p_buffer);
-            p_buffer = p_next;
-        }
-        else
-        {
-            p_buffer->p_buffer += val;
-            p_buffer->i_buffer -= val;
-        }
-        i_write += val;
+/** Releases fully written blocks, adjusts a partially written one. */
+static block_t *ConsumeBlocks(block_t *block, size_t written)
+{
+    while (block != NULL && written >= block->i_buffer)
+    {
+        block_t *next = block->p_next;
+
+        written -= block->i_buffer;
+        block_Release(block);
+        block = next;
     }
-    return i_write;
+    if (block != NULL)
+    {
+        block->p_buffer += written;
+        block->i_buffer -= written;
+    }
+    return block;
 }
 
-static ssize_t WritePipe(sout_access_out_t *access, block_t *block)
+/*****************************************************************************
+ * Write: gathered write on a file descriptor.
+ *****************************************************************************/
+static ssize_t Write( sout_access_out_t *p_access, block_t *p_buffer )
 {
-    int *fdp = access->p_sys, fd = *fdp;
-    ssize_t total = 0;
+    int *fdp = p_access->p_sys, fd = *fdp;
+    size_t i_write = 0;
 
-    while (block != NULL)
+    while( p_buffer )
     {
-        if (block->i_buffer == 0)
+        if (p_buffer->i_buffer == 0)
         {
-            block_t *next = block->p_next;
-            block_Release(block);
-            block = next;
+            p_buffer = ConsumeBlocks(p_buffer, 0);
             continue;
         }
 
-        /* TODO: vectorized I/O with writev() */
-        ssize_t val = vlc_write(fd, block->p_buffer, block->i_buffer);
+        struct iovec iov[FILE_IOV_MAX];
+        int i_count = BlockVec(p_buffer, iov);
+
+        ssize_t val = vlc_writev(fd, iov, i_count);
         if (val < 0)
         {
             if (errno == EINTR)
                 continue;
-
-            block_ChainRelease(block);
-            msg_Err(access, "cannot write: %s", vlc_strerror_c(errno));
-            total = -1;
-            break;
+            block_ChainRelease (p_buffer);
+            msg_Err( p_access, "cannot write: %s", vlc_strerror_c(errno) );
+            return -1;
         }
 
-        total += val;
-
-        assert((size_t)val <= block->i_buffer);
-        block->p_buffer += val;
-        block->i_buffer -= val;
+        i_write += val;
+        p_buffer = ConsumeBlocks(p_buffer, val);
     }
-
-    return total;
+    return i_write;
 }
 
 #ifdef S_ISSOCK
@@ -156,14 +156,18 @@ static ssize_t Send(sout_access_out_t *access, block_t *block)
     {
         if (block->i_buffer == 0)
         {
-            block_t *next = block->p_next;
-            block_Release(block);
-            block = next;
+            block = ConsumeBlocks(block, 0);
             continue;
         }
 
-        /* TODO: vectorized I/O with sendmsg() */
-        ssize_t val = vlc_send(fd, block->p_buffer, block->i_buffer, 0);
+        struct iovec iov[FILE_IOV_MAX];
+        struct msghdr msg =
+        {
+            .msg_iov = iov,
+            .msg_iovlen = BlockVec(block, iov),
+        };
+
+        ssize_t val = vlc_sendmsg(fd, &msg, 0);
         if (val <= 0)
         {   /* FIXME: errno is meaningless if val is zero */
             if (errno == EINTR)
@@ -174,10 +178,7 @@ static ssize_t Send(sout_access_out_t *access, block_t *block)
         }
 
         total += val;
-
-        assert((size_t)val <= block->i_buffer);
-        block->p_buffer += val;
-        block->i_buffer -= val;
+        block = ConsumeBlocks(block, val);
     }
     return total;
 }
@@ -349,7 +350,7 @@ static int Open( vlc_object_t *p_this )
 #endif
     else
     {
-        p_access->pf_write = WritePipe;
+        p_access->pf_write = Write;
         p_access->pf_seek = NULL;
     }
     p_access->pf_control = Control;
@@ -47,6 +47,18 @@ vlc_module_end ()
 
 static block_t *Filter( filter_t *, block_t * );
 
+typedef struct
+{
+    void (*do_work)(filter_t *, block_t *, block_t *);
+#if defined (__i386__) || defined (__x86_64__)
+    unsigned i_in_ch, i_out_ch;
+    /* Mixing matrix columns, precomputed at open with the normalization and
+     * level constants folded in; padded to one 8-wide register per input
+     * channel for the vector kernel */
+    float cols[AOUT_CHAN_MAX][8];
+#endif
+} filter_sys_t;
+
 static void DoWork_7_x_to_2_0( filter_t * p_filter,  block_t * p_in_buf, block_t * p_out_buf ) {
     float *p_dest = (float *)p_out_buf->p_buffer;
     const float *p_src = (const float *)p_in_buf->p_buffer;
@@ -263,6 +275,10 @@ static void DoWork_6_1_to_5_x( filter_t * p_filter,  block_t * p_in_buf, block_t
 #define GET_WORK(in, out) DoWork_##in##_to_##out
 #endif
 
+#if defined (__i386__) || defined (__x86_64__)
+#include "simple_fma.h"
+#endif
+
 /*****************************************************************************
  * OpenFilter:
  *****************************************************************************/
@@ -344,11 +360,23 @@ static int OpenFilter( vlc_object_t *p_this )
     if( do_work == NULL )
         return VLC_EGENERIC;
 
+    filter_sys_t *p_sys = p_filter->p_sys =
+        vlc_obj_malloc( p_this, sizeof (*p_sys) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+#if defined (__i386__) || defined (__x86_64__)
+    p_sys->i_in_ch = aout_FormatNbChannels( &p_filter->fmt_in.audio );
+    p_sys->i_out_ch = aout_FormatNbChannels( &p_filter->fmt_out.audio );
+    memset( p_sys->cols, 0, sizeof (p_sys->cols) );
+    do_work = GET_WORK_MATRIX_FMA( p_filter, p_sys, do_work );
+#endif
+    p_sys->do_work = do_work;
+
     static const struct vlc_filter_operations filter_ops =
         { .filter_audio = Filter };
 
     p_filter->ops = &filter_ops;
-    p_filter->p_sys = do_work;
     return VLC_SUCCESS;
 }
 
@@ -357,7 +385,7 @@ static int OpenFilter( vlc_object_t *p_this )
  *****************************************************************************/
 static block_t *Filter( filter_t *p_filter, block_t *p_block )
 {
-    void (*work)(filter_t *, block_t *, block_t *) = p_filter->p_sys;
+    filter_sys_t *p_sys = p_filter->p_sys;
 
     if( !p_block || !p_block->i_nb_samples )
     {
@@ -388,7 +416,7 @@ static block_t *Filter( filter_t *p_filter, block_t *p_block )
     p_out->i_nb_samples = p_block->i_nb_samples;
     p_out->i_buffer = p_block->i_buffer * i_output_nb / i_input_nb;
 
-    work( p_filter, p_block, p_out );
+    p_sys->do_work( p_filter, p_block, p_out );
 
     block_Release( p_block );
 
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ * simple_fma.h : simple channel mixer plug-in using FMA intrinsics
+ *****************************************************************************
+ * Copyright (C) 2002, 2004, 2006-2009 VLC authors and VideoLAN
+ *
+ * Authors: Gildas Bazin <gbazin@videolan.org>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+#include <vlc_cpu.h>
+
+#include <immintrin.h>
+
+/**
+ * Folds a scalar DoWork conversion into the mixing matrix by probing it with
+ * one unit impulse per input channel. Every conversion in this filter is a
+ * linear map, so the columns of the matrix fall out of single-frame runs,
+ * normalization and level constants included.
+ */
+static void BuildMatrix( filter_t *p_filter, filter_sys_t *p_sys,
+                         void (*do_work)(filter_t *, block_t *, block_t *) )
+{
+    float in[AOUT_CHAN_MAX] = { 0.f };
+    float out[AOUT_CHAN_MAX];
+    block_t b_in = {
+        .p_buffer = (uint8_t *)in, .i_buffer = sizeof (in), .i_nb_samples = 1,
+    };
+    block_t b_out = {
+        .p_buffer = (uint8_t *)out, .i_buffer = sizeof (out),
+    };
+
+    for( unsigned i = 0; i < p_sys->i_in_ch; i++ )
+    {
+        in[i] = 1.f;
+        memset( out, 0, sizeof (out) );
+        do_work( p_filter, &b_in, &b_out );
+        for( unsigned o = 0; o < p_sys->i_out_ch; o++ )
+            p_sys->cols[i][o] = out[o];
+        in[i] = 0.f;
+    }
+}
+
+/**
+ * Generic matrix-vector remix: per frame, each input sample is broadcast and
+ * fused-multiply-added with its matrix column, yielding all output channels
+ * of the frame in one 8-wide accumulator.
+ */
+VLC_FMA
+static void DoWork_matrix_fma( filter_t * p_filter, block_t * p_in_buf, block_t * p_out_buf ) {
+    const filter_sys_t *p_sys = p_filter->p_sys;
+    const unsigned i_in = p_sys->i_in_ch;
+    const unsigned i_out = p_sys->i_out_ch;
+    const float *p_src = (const float *)p_in_buf->p_buffer;
+    float *p_dest = (float *)p_out_buf->p_buffer;
+    size_t i = p_in_buf->i_nb_samples;
+
+    __m256 cols[AOUT_CHAN_MAX];
+    for( unsigned c = 0; c < i_in; c++ )
+        cols[c] = _mm256_loadu_ps( p_sys->cols[c] );
+
+    /* The 8-wide store spills past the current output frame (the spilled
+     * lanes are rewritten by the next iteration), so stop while the output
+     * buffer still has 8 floats left and finish with the scalar loop. */
+    while( i * i_out >= 8 )
+    {
+        __m256 acc = _mm256_mul_ps( cols[0], _mm256_broadcast_ss( &p_src[0] ) );
+        for( unsigned c = 1; c < i_in; c++ )
+            acc = _mm256_fmadd_ps( _mm256_broadcast_ss( &p_src[c] ),
+                                   cols[c], acc );
+        _mm256_storeu_ps( p_dest, acc );
+
+        p_src += i_in;
+        p_dest += i_out;
+        i--;
+    }
+
+    while( i-- > 0 )
+    {
+        for( unsigned o = 0; o < i_out; o++ )
+        {
+            float f = p_sys->cols[0][o] * p_src[0];
+            for( unsigned c = 1; c < i_in; c++ )
+                f += p_sys->cols[c][o] * p_src[c];
+            p_dest[o] = f;
+        }
+        p_src += i_in;
+        p_dest += i_out;
+    }
+}
+
+static void (*GET_WORK_MATRIX_FMA( filter_t *p_filter, filter_sys_t *p_sys,
+    void (*do_work)(filter_t *, block_t *, block_t *) ))
+        (filter_t *, block_t *, block_t *)
+{
+    if( !vlc_CPU_AVX() || !vlc_CPU_FMA3() )
+        return do_work;
+
+    BuildMatrix( p_filter, p_sys, do_work );
+    return DoWork_matrix_fma;
+}
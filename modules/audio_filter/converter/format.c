@@ -37,17 +37,30 @@
 #include <vlc_plugin.h>
 #include <vlc_aout.h>
 #include <vlc_block.h>
+#include <vlc_cpu.h>
 #include <vlc_filter.h>
 
+#ifdef PLUGIN_SSE2
+# include <emmintrin.h>
+# define vlc_CPU_capable() vlc_CPU_SSE2()
+#else
+# define vlc_CPU_capable() (true)
+#endif
+
 /*****************************************************************************
  * Module descriptor
  *****************************************************************************/
 static int  Open(vlc_object_t *);
 
 vlc_module_begin()
-    set_description(N_("Audio filter for PCM format conversion"))
     set_subcategory(SUBCAT_AUDIO_AFILTER)
+#ifdef PLUGIN_SSE2
+    set_description(N_("SSE2 audio filter for PCM format conversion"))
+    set_capability("audio converter", 2)
+#else
+    set_description(N_("Audio filter for PCM format conversion"))
     set_capability("audio converter", 1)
+#endif
     set_callback(Open)
 vlc_module_end()
 
@@ -65,6 +78,8 @@ static int Open(vlc_object_t *object)
     const es_format_t *src = &filter->fmt_in;
     es_format_t       *dst = &filter->fmt_out;
 
+    if (!vlc_CPU_capable())
+        return VLC_EGENERIC;
     if (!AOUT_FMTS_SIMILAR(&src->audio, &dst->audio))
         return VLC_EGENERIC;
     if (src->i_codec == dst->i_codec)
@@ -175,7 +190,24 @@ static block_t *S16toFl32(filter_t *filter, block_t *bsrc)
     block_CopyProperties(bdst, bsrc);
     int16_t *src = (int16_t *)bsrc->p_buffer;
     float   *dst = (float *)bdst->p_buffer;
-    for (size_t i = bsrc->i_buffer / 2; i--;)
+    size_t   i   = bsrc->i_buffer / 2;
+
+#ifdef PLUGIN_SSE2
+    const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+
+    /* Blocks are not necessarily 16-byte aligned, use unaligned accesses */
+    for (; i >= 8; i -= 8, src += 8, dst += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)src);
+        /* Duplicate then shift to sign-extend each 16-bit lane to 32 bits */
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+        _mm_storeu_ps(dst,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#endif
+    for (; i--;)
 #if 0
         /* Slow version */
         *dst++ = (float)*src++ / 32768.f;
@@ -255,7 +287,26 @@ static block_t *Fl32toS16(filter_t *filter, block_t *b)
     VLC_UNUSED(filter);
     float   *src = (float *)b->p_buffer;
     int16_t *dst = (int16_t *)src;
-    for (int i = b->i_buffer / 4; i--;) {
+    size_t   i   = b->i_buffer / 4;
+
+#ifdef PLUGIN_SSE2
+    const __m128 scale = _mm_set1_ps(32768.f);
+    /* Clamp the positive side before conversion: above INT32_MAX,
+     * _mm_cvtps_epi32() would wrap around to INT32_MIN and the pack would
+     * saturate with the wrong sign. The negative side saturates fine. */
+    const __m128 max = _mm_set1_ps(32767.f);
+
+    for (; i >= 8; i -= 8, src += 8, dst += 8)
+    {
+        __m128i lo = _mm_cvtps_epi32(
+            _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src), scale), max));
+        __m128i hi = _mm_cvtps_epi32(
+            _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + 4), scale), max));
+
+        _mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+    }
+#endif
+    for (; i--;) {
 #if 0
         /* Slow version. */
         if (*src >= 1.0) *dst = 32767;
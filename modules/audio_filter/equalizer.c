@@ -112,13 +112,14 @@ typedef struct
     float f_gamp;   /* Global preamp */
     bool b_2eqz;
 
-    /* Filter state */
-    float x[32][2];
-    float y[32][128][2];
+    /* Filter state, band-major and split by history sample so that the
+     * per-channel loops in EqzFilter() vectorize */
+    float x[2][32];
+    float y[128][2][32];
 
     /* Second filter state */
-    float x2[32][2];
-    float y2[32][128][2];
+    float x2[2][32];
+    float y2[128][2][32];
 
     vlc_mutex_t lock;
 } filter_sys_t;
@@ -318,17 +319,17 @@ static int EqzInit( filter_t *p_filter, int i_rate )
     /* Filter state */
     for( ch = 0; ch < 32; ch++ )
     {
-        p_sys->x[ch][0]  =
-        p_sys->x[ch][1]  =
-        p_sys->x2[ch][0] =
-        p_sys->x2[ch][1] = 0.0f;
+        p_sys->x[0][ch]  =
+        p_sys->x[1][ch]  =
+        p_sys->x2[0][ch] =
+        p_sys->x2[1][ch] = 0.0f;
 
         for( i = 0; i < p_sys->i_band; i++ )
         {
-            p_sys->y[ch][i][0]  =
-            p_sys->y[ch][i][1]  =
-            p_sys->y2[ch][i][0] =
-            p_sys->y2[ch][i][1] = 0.0f;
+            p_sys->y[i][0][ch]  =
+            p_sys->y[i][1][ch]  =
+            p_sys->y2[i][0][ch] =
+            p_sys->y2[i][1][ch] = 0.0f;
         }
     }
 
@@ -385,6 +386,27 @@ error:
     return i_ret;
 }
 
+/* Run one biquad band over every channel of one sample. The bands are
+ * independent and the coefficients are uniform across channels, so the
+ * compiler can turn this per-channel loop into SIMD operations. */
+static inline void EqzBand( const float *restrict x, float *restrict y0,
+                            float *restrict y1, float *restrict o,
+                            float f_alpha, float f_beta, float f_gamma,
+                            float f_amp, const float *restrict x1,
+                            int i_channels )
+{
+    for( int ch = 0; ch < i_channels; ch++ )
+    {
+        const float y = f_alpha * ( x[ch] - x1[ch] ) +
+                        f_gamma * y0[ch] - f_beta * y1[ch];
+
+        y1[ch] = y0[ch];
+        y0[ch] = y;
+
+        o[ch] += y * f_amp;
+    }
+}
+
 static void EqzFilter( filter_t *p_filter, float *out, float *in,
                        int i_samples, int i_channels )
 {
@@ -392,55 +414,63 @@ static void EqzFilter( filter_t *p_filter, float *out, float *in,
     int i, ch, j;
 
     vlc_mutex_lock( &p_sys->lock );
+
+    const float *restrict f_alpha = p_sys->f_alpha;
+    const float *restrict f_beta  = p_sys->f_beta;
+    const float *restrict f_gamma = p_sys->f_gamma;
+    const float *restrict f_amp   = p_sys->f_amp;
+    const float f_gamp = p_sys->f_gamp;
+    const int i_band = p_sys->i_band;
+    const bool b_2eqz = p_sys->b_2eqz;
+
     for( i = 0; i < i_samples; i++ )
     {
+        float o[32];
+        float x2[32];
+
         for( ch = 0; ch < i_channels; ch++ )
-        {
-            const float x = in[ch];
-            float o = 0.0f;
+            o[ch] = 0.0f;
 
-            for( j = 0; j < p_sys->i_band; j++ )
-            {
-                float y = p_sys->f_alpha[j] * ( x - p_sys->x[ch][1] ) +
-                          p_sys->f_gamma[j] * p_sys->y[ch][j][0] -
-                          p_sys->f_beta[j]  * p_sys->y[ch][j][1];
+        for( j = 0; j < i_band; j++ )
+            EqzBand( in, p_sys->y[j][0], p_sys->y[j][1], o,
+                     f_alpha[j], f_beta[j], f_gamma[j], f_amp[j],
+                     p_sys->x[1], i_channels );
 
-                p_sys->y[ch][j][1] = p_sys->y[ch][j][0];
-                p_sys->y[ch][j][0] = y;
+        for( ch = 0; ch < i_channels; ch++ )
+        {
+            p_sys->x[1][ch] = p_sys->x[0][ch];
+            p_sys->x[0][ch] = in[ch];
+        }
 
-                o += y * p_sys->f_amp[j];
+        /* Second filter */
+        if( b_2eqz )
+        {
+            for( ch = 0; ch < i_channels; ch++ )
+            {
+                x2[ch] = EQZ_IN_FACTOR * in[ch] + o[ch];
+                o[ch] = 0.0f;
             }
-            p_sys->x[ch][1] = p_sys->x[ch][0];
-            p_sys->x[ch][0] = x;
 
-            /* Second filter */
-            if( p_sys->b_2eqz )
-            {
-                const float x2 = EQZ_IN_FACTOR * x + o;
-                o = 0.0f;
-                for( j = 0; j < p_sys->i_band; j++ )
-                {
-                    float y = p_sys->f_alpha[j] * ( x2 - p_sys->x2[ch][1] ) +
-                              p_sys->f_gamma[j] * p_sys->y2[ch][j][0] -
-                              p_sys->f_beta[j]  * p_sys->y2[ch][j][1];
-
-                    p_sys->y2[ch][j][1] = p_sys->y2[ch][j][0];
-                    p_sys->y2[ch][j][0] = y;
-
-                    o += y * p_sys->f_amp[j];
-                }
-                p_sys->x2[ch][1] = p_sys->x2[ch][0];
-                p_sys->x2[ch][0] = x2;
+            for( j = 0; j < i_band; j++ )
+                EqzBand( x2, p_sys->y2[j][0], p_sys->y2[j][1], o,
+                         f_alpha[j], f_beta[j], f_gamma[j], f_amp[j],
+                         p_sys->x2[1], i_channels );
 
-                /* We add source PCM + filtered PCM */
-                out[ch] = p_sys->f_gamp * p_sys->f_gamp *( EQZ_IN_FACTOR * x2 + o );
-            }
-            else
+            for( ch = 0; ch < i_channels; ch++ )
             {
+                p_sys->x2[1][ch] = p_sys->x2[0][ch];
+                p_sys->x2[0][ch] = x2[ch];
+
                 /* We add source PCM + filtered PCM */
-                out[ch] = p_sys->f_gamp *( EQZ_IN_FACTOR * x + o );
+                out[ch] = f_gamp * f_gamp * ( EQZ_IN_FACTOR * x2[ch] + o[ch] );
             }
         }
+        else
+        {
+            /* We add source PCM + filtered PCM */
+            for( ch = 0; ch < i_channels; ch++ )
+                out[ch] = f_gamp * ( EQZ_IN_FACTOR * in[ch] + o[ch] );
+        }
 
         in  += i_channels;
         out += i_channels;
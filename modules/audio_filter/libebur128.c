@@ -41,6 +41,9 @@ struct filter_sys
     ebur128_state *state;
     vlc_tick_t last_update;
     bool new_frames;
+    /* Persistent U8 to S16N conversion buffer, grown on demand */
+    short *convert_buf;
+    size_t convert_size;
 };
 
 static ebur128_state *
@@ -119,7 +122,7 @@ SendLoudnessMeter(filter_t *filter)
         for (unsigned i = 0; i < filter->fmt_in.audio.i_channels; ++i)
         {
             double truepeak;
-            error = ebur128_true_peak(sys->state, 0, &truepeak);
+            error = ebur128_true_peak(sys->state, i, &truepeak);
             if (error != EBUR128_SUCCESS)
                 return error;
             if (truepeak > loudness.truepeak)
@@ -151,19 +154,25 @@ Process(filter_t *filter, block_t *block)
     {
         case VLC_CODEC_U8:
         {
-            /* Convert to S16N */
-            short *data_s16 = malloc(block->i_buffer * 2);
-            if (unlikely(data_s16 == NULL))
-                return out;
-
-            uint8_t *src = (uint8_t *)block->p_buffer;
-            short *dst = data_s16;
-            for (size_t i = block->i_buffer; i--;)
-                *dst++ = ((*src++) << 8) - 0x8000;
-
-            error = ebur128_add_frames_short(sys->state, data_s16,
+            /* Convert to S16N, reusing the conversion buffer across blocks */
+            if (sys->convert_size < block->i_buffer)
+            {
+                short *buf = vlc_reallocarray(sys->convert_buf,
+                                              block->i_buffer, sizeof (*buf));
+                if (unlikely(buf == NULL))
+                    return out;
+                sys->convert_buf = buf;
+                sys->convert_size = block->i_buffer;
+            }
+
+            const uint8_t *src = block->p_buffer;
+            short *dst = sys->convert_buf;
+            /* (x ^ 0x80) << 8 == (x << 8) - 0x8000, and vectorizes */
+            for (size_t i = 0; i < block->i_buffer; i++)
+                dst[i] = (short)((src[i] ^ 0x80) << 8);
+
+            error = ebur128_add_frames_short(sys->state, sys->convert_buf,
                                              block->i_nb_samples);
-            free(data_s16);
             break;
         }
         case VLC_CODEC_S16N:
@@ -238,6 +247,7 @@ Close(filter_t *filter)
 
     if (sys->state != NULL)
         ebur128_destroy(&sys->state);
+    free(sys->convert_buf);
     free(filter->p_sys);
 }
 
@@ -285,6 +295,8 @@ static int Open(vlc_object_t *this)
 
     sys->last_update = VLC_TICK_INVALID;
     sys->new_frames = false;
+    sys->convert_buf = NULL;
+    sys->convert_size = 0;
     sys->state = CreateEbuR128State(filter, sys->mode);
     if (sys->state == NULL)
     {
@@ -0,0 +1,284 @@
+/*****************************************************************************
+ * polyphase.c : native windowed-sinc polyphase resampler
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Preamble
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_aout.h>
+#include <vlc_filter.h>
+
+/* Interpolation kernel: POLY_TAPS-point windowed sinc, quantized into
+ * POLY_PHASES fractional positions with linear interpolation in between.
+ * The bank is designed once at open time for the nominal rates; the small
+ * per-buffer ratio deviations requested by the clock drift compensation
+ * only move the phase increment and keep both the bank and the sample
+ * history valid, so drift corrections neither re-init nor click. */
+#define POLY_TAPS       16
+#define POLY_PHASE_BITS 7
+#define POLY_PHASES     (1 << POLY_PHASE_BITS)
+
+typedef struct
+{
+    /* One extra row so phase interpolation can read row i_phase + 1 */
+    float coeffs[POLY_PHASES + 1][POLY_TAPS];
+
+    /* Fixed-point 32.32 position of the next output in the input stream */
+    uint64_t i_pos;
+
+    float   *p_history; /**< last frames of the previous buffer */
+    unsigned i_history_frames; /**< always < POLY_TAPS */
+
+    float   *p_work; /**< history + current input, contiguous */
+    size_t   i_work_frames;
+
+    unsigned i_channels;
+} filter_sys_t;
+
+/*****************************************************************************
+ * Local prototypes
+ *****************************************************************************/
+static int Create (vlc_object_t *);
+static int CreateResampler (vlc_object_t *);
+static void Close (filter_t *);
+
+static block_t *DoWork( filter_t *, block_t * );
+
+/*****************************************************************************
+ * Module descriptor
+ *****************************************************************************/
+vlc_module_begin ()
+    set_description( N_("Polyphase audio resampler") )
+    set_capability( "audio converter", 30 )
+    set_subcategory( SUBCAT_AUDIO_RESAMPLER )
+    set_callback( Create )
+
+    add_submodule()
+    set_capability( "audio resampler", 30 )
+    set_callback( CreateResampler )
+vlc_module_end ()
+
+/*****************************************************************************
+ * BuildKernel: fill the phase-quantized windowed-sinc bank
+ *****************************************************************************/
+static void BuildKernel( filter_sys_t *p_sys,
+                         unsigned i_in_rate, unsigned i_out_rate )
+{
+    /* Cut below Nyquist with some transition margin; when downsampling,
+     * scale the passband down to the output Nyquist to avoid aliasing */
+    double f_cutoff = 0.45;
+    if( i_out_rate < i_in_rate )
+        f_cutoff *= (double)i_out_rate / i_in_rate;
+
+    for( unsigned p = 0; p <= POLY_PHASES; p++ )
+    {
+        const double f_frac = (double)p / POLY_PHASES;
+        double f_sum = 0.;
+
+        for( unsigned t = 0; t < POLY_TAPS; t++ )
+        {
+            /* Tap offset from the interpolation point */
+            const double x = (double)t - (POLY_TAPS / 2 - 1) - f_frac;
+
+            double f_coeff = f_cutoff;
+            if( x != 0. )
+                f_coeff = sin( M_PI * f_cutoff * x ) / ( M_PI * x );
+
+            /* Blackman window over the kernel support */
+            const double w = M_PI * x / (POLY_TAPS / 2);
+            f_coeff *= 0.42 + 0.5 * cos( w ) + 0.08 * cos( 2. * w );
+
+            p_sys->coeffs[p][t] = f_coeff;
+            f_sum += f_coeff;
+        }
+
+        /* Unity DC gain for every phase */
+        for( unsigned t = 0; t < POLY_TAPS; t++ )
+            p_sys->coeffs[p][t] /= f_sum;
+    }
+}
+
+/*****************************************************************************
+ * Create: allocate polyphase resampler
+ *****************************************************************************/
+static int Create( vlc_object_t *p_this )
+{
+    filter_t * p_filter = (filter_t *)p_this;
+
+    if( p_filter->fmt_in.audio.i_rate == p_filter->fmt_out.audio.i_rate )
+        return VLC_EGENERIC;
+    return CreateResampler( p_this );
+}
+
+static int CreateResampler( vlc_object_t *p_this )
+{
+    filter_t * p_filter = (filter_t *)p_this;
+
+    if( p_filter->fmt_in.audio.i_format != VLC_CODEC_FL32
+     || p_filter->fmt_out.audio.i_format != VLC_CODEC_FL32
+     || p_filter->fmt_in.audio.i_channels != p_filter->fmt_out.audio.i_channels )
+        return VLC_EGENERIC;
+
+    filter_sys_t *p_sys = malloc( sizeof(*p_sys) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+    p_sys->i_channels = aout_FormatNbChannels( &p_filter->fmt_in.audio );
+    p_sys->i_pos = 0;
+    p_sys->i_history_frames = 0;
+    p_sys->p_work = NULL;
+    p_sys->i_work_frames = 0;
+    p_sys->p_history =
+        vlc_alloc( POLY_TAPS * p_sys->i_channels, sizeof(float) );
+    if( unlikely(p_sys->p_history == NULL) )
+    {
+        free( p_sys );
+        return VLC_ENOMEM;
+    }
+
+    BuildKernel( p_sys, p_filter->fmt_in.audio.i_rate,
+                 p_filter->fmt_out.audio.i_rate );
+
+    static const struct vlc_filter_operations filter_ops =
+    {
+        .filter_audio = DoWork, .close = Close,
+    };
+    p_filter->ops = &filter_ops;
+    p_filter->p_sys = p_sys;
+    return VLC_SUCCESS;
+}
+
+static void Close( filter_t *p_filter )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    free( p_sys->p_work );
+    free( p_sys->p_history );
+    free( p_sys );
+}
+
+/*****************************************************************************
+ * DoWork: convert a buffer
+ *****************************************************************************/
+static block_t *DoWork( filter_t * p_filter, block_t * p_in_buf )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    const unsigned i_channels = p_sys->i_channels;
+    const unsigned i_in_rate = p_filter->fmt_in.audio.i_rate;
+    const unsigned i_out_rate = p_filter->fmt_out.audio.i_rate;
+    const unsigned i_framesize = p_filter->fmt_out.audio.i_bytes_per_frame;
+    block_t *p_out_buf = NULL;
+
+    /* Check if we really need to run the resampler */
+    if( i_out_rate == i_in_rate && p_sys->i_history_frames == 0
+     && p_sys->i_pos == 0 )
+        return p_in_buf;
+
+    /* Gather history + input in one contiguous buffer */
+    const size_t i_frames = p_sys->i_history_frames + p_in_buf->i_nb_samples;
+    if( i_frames > p_sys->i_work_frames )
+    {
+        float *p_work = vlc_alloc( i_frames * i_channels, sizeof(float) );
+        if( unlikely(p_work == NULL) )
+            goto error;
+        free( p_sys->p_work );
+        p_sys->p_work = p_work;
+        p_sys->i_work_frames = i_frames;
+    }
+    memcpy( p_sys->p_work, p_sys->p_history,
+            p_sys->i_history_frames * i_channels * sizeof(float) );
+    memcpy( p_sys->p_work + p_sys->i_history_frames * i_channels,
+            p_in_buf->p_buffer, p_in_buf->i_buffer );
+
+    /* 32.32 fixed-point input step per output sample; the drift-adjusted
+     * output rate only changes this increment, never the filter state */
+    const uint64_t i_step = ( (uint64_t)i_in_rate << 32 ) / i_out_rate;
+
+    uint64_t i_pos = p_sys->i_pos;
+    size_t i_out_max = 0;
+    if( i_frames >= POLY_TAPS )
+    {
+        const uint64_t i_avail = (uint64_t)(i_frames - POLY_TAPS + 1) << 32;
+        if( i_avail > i_pos )
+            i_out_max = ( i_avail - i_pos - 1 ) / i_step + 1;
+    }
+
+    if( i_out_max > 0 )
+    {
+        p_out_buf = block_Alloc( i_out_max * i_framesize );
+        if( unlikely(p_out_buf == NULL) )
+            goto error;
+
+        float *p_out = (float *)p_out_buf->p_buffer;
+        size_t i_out_nb = 0;
+
+        while( ( i_pos >> 32 ) + POLY_TAPS <= i_frames )
+        {
+            const uint32_t i_frac = (uint32_t)i_pos;
+            const unsigned i_phase = i_frac >> ( 32 - POLY_PHASE_BITS );
+            const float f_lerp = ( i_frac & ( ( 1u << ( 32 - POLY_PHASE_BITS ) ) - 1 ) )
+                               * ( 1.0f / ( 1u << ( 32 - POLY_PHASE_BITS ) ) );
+
+            const float *c0 = p_sys->coeffs[i_phase];
+            const float *c1 = p_sys->coeffs[i_phase + 1];
+            float coeffs[POLY_TAPS];
+            for( unsigned t = 0; t < POLY_TAPS; t++ )
+                coeffs[t] = c0[t] + f_lerp * ( c1[t] - c0[t] );
+
+            const float *p_frame = p_sys->p_work + ( i_pos >> 32 ) * i_channels;
+            for( unsigned ch = 0; ch < i_channels; ch++ )
+            {
+                float f_acc = 0.f;
+                for( unsigned t = 0; t < POLY_TAPS; t++ )
+                    f_acc += coeffs[t] * p_frame[t * i_channels + ch];
+                p_out[i_out_nb * i_channels + ch] = f_acc;
+            }
+
+            i_out_nb++;
+            i_pos += i_step;
+        }
+        assert( i_out_nb <= i_out_max );
+
+        p_out_buf->i_buffer = i_out_nb * i_framesize;
+        p_out_buf->i_nb_samples = i_out_nb;
+        p_out_buf->i_pts = p_in_buf->i_pts;
+        p_out_buf->i_length = vlc_tick_from_samples( i_out_nb, i_out_rate );
+    }
+
+    /* Keep the tail for the next buffer */
+    const size_t i_base = i_pos >> 32;
+    p_sys->i_history_frames = i_frames - i_base;
+    assert( p_sys->i_history_frames < POLY_TAPS );
+    memcpy( p_sys->p_history, p_sys->p_work + i_base * i_channels,
+            p_sys->i_history_frames * i_channels * sizeof(float) );
+    p_sys->i_pos = i_pos - ( (uint64_t)i_base << 32 );
+
+error:
+    block_Release( p_in_buf );
+    return p_out_buf;
+}
@@ -33,6 +33,14 @@
 #include <vlc_plugin.h>
 #include <vlc_aout.h>
 #include <vlc_aout_volume.h>
+#include <vlc_cpu.h>
+
+#ifdef PLUGIN_SSE2
+# include <emmintrin.h>
+# define vlc_CPU_capable() vlc_CPU_SSE2()
+#else
+# define vlc_CPU_capable() (true)
+#endif
 
 /*****************************************************************************
  * Local prototypes
@@ -44,8 +52,13 @@ static int Create( vlc_object_t * );
  *****************************************************************************/
 vlc_module_begin ()
     set_subcategory( SUBCAT_AUDIO_AFILTER )
+#ifdef PLUGIN_SSE2
+    set_description( N_("SSE2 single precision audio volume") )
+    set_capability( "audio volume", 12 )
+#else
     set_description( N_("Single precision audio volume") )
     set_capability( "audio volume", 10 )
+#endif
     set_callback( Create )
 vlc_module_end ()
 
@@ -59,7 +72,21 @@ static void FilterFL32( audio_volume_t *p_volume, block_t *p_buffer,
         return; /* nothing to do */
 
     float *p = (float *)p_buffer->p_buffer;
-    for( size_t i = p_buffer->i_buffer / sizeof(*p); i > 0; i-- )
+    size_t i = p_buffer->i_buffer / sizeof(*p);
+
+#ifdef PLUGIN_SSE2
+    const __m128 mult = _mm_set1_ps( f_multiplier );
+
+    /* Blocks are not necessarily 16-byte aligned, use unaligned accesses */
+    for( ; i >= 8; i -= 8, p += 8 )
+    {
+        _mm_storeu_ps( p,
+                       _mm_mul_ps( _mm_loadu_ps( p ), mult ) );
+        _mm_storeu_ps( p + 4,
+                       _mm_mul_ps( _mm_loadu_ps( p + 4 ), mult ) );
+    }
+#endif
+    for( ; i > 0; i-- )
         *(p++) *= f_multiplier;
 
     (void) p_volume;
@@ -73,7 +100,15 @@ static void FilterFL64( audio_volume_t *p_volume, block_t *p_buffer,
     if( mult == 1. )
         return; /* nothing to do */
 
-    for( size_t i = p_buffer->i_buffer / sizeof(*p); i > 0; i-- )
+    size_t i = p_buffer->i_buffer / sizeof(*p);
+
+#ifdef PLUGIN_SSE2
+    const __m128d vmult = _mm_set1_pd( mult );
+
+    for( ; i >= 2; i -= 2, p += 2 )
+        _mm_storeu_pd( p, _mm_mul_pd( _mm_loadu_pd( p ), vmult ) );
+#endif
+    for( ; i > 0; i-- )
         *(p++) *= mult;
 
     (void) p_volume;
@@ -86,6 +121,9 @@ static int Create( vlc_object_t *p_this )
 {
     audio_volume_t *p_volume = (audio_volume_t *)p_this;
 
+    if( !vlc_CPU_capable() )
+        return -1;
+
     switch (p_volume->format)
     {
         case VLC_CODEC_FL32:
@@ -103,6 +103,13 @@ typedef enum
     PAUSED,
 } pb_state_t;
 
+/** Delay histogram buckets: bucket n counts delays below 2^n milliseconds */
+#define ALSA_HISTO_BUCKETS 12
+/** Underruns within one run before the buffer is grown and the PCM reset */
+#define ALSA_TUNE_MAX_UNDERRUNS 3
+/** Writes needed before a clean run is trusted enough to shrink the buffer */
+#define ALSA_TUNE_MIN_WRITES 512
+
 /** Private data for an ALSA PCM playback stream */
 typedef struct
 {
@@ -127,6 +134,17 @@ typedef struct
     vlc_frame_t *frame_chain;
     vlc_frame_t **frame_last;
     uint64_t queued_samples;
+
+    /* Latency auto-tuning state; kept across Start/Stop cycles since ALSA
+     * hardware parameters can only be renegotiated on a fresh setup */
+    struct
+    {
+        bool enabled;
+        unsigned buffer_time; /**< Target buffer duration for Start (µs) */
+        unsigned underruns; /**< Underruns during the current run */
+        uint64_t writes; /**< Successful writes during the current run */
+        uint64_t delay_histo[ALSA_HISTO_BUCKETS];
+    } tune;
 } aout_sys_t;
 
 #include "audio_output/volume.h"
@@ -139,8 +157,30 @@ static void wake_poll(aout_sys_t *sys)
     (void) rd;
 }
 
-static int recover_from_pcm_state(snd_pcm_t *pcm)
+/* Called with sys->lock held */
+static void count_underrun(audio_output_t *aout)
 {
+    aout_sys_t *sys = aout->sys;
+
+    sys->tune.underruns++;
+    if (sys->tune.enabled && sys->tune.underruns == ALSA_TUNE_MAX_UNDERRUNS
+     && sys->tune.buffer_time < AOUT_MAX_ADVANCE_TIME)
+    {
+        /* This run is not stable at the current latency: grow the buffer and
+         * set the stream up again, hardware parameters cannot change live. */
+        sys->tune.buffer_time = __MIN(sys->tune.buffer_time * 2,
+                                      (unsigned)AOUT_MAX_ADVANCE_TIME);
+        msg_Warn(aout, "repeated underruns, restarting with %u us buffer",
+                 sys->tune.buffer_time);
+        aout_RestartRequest(aout, false);
+    }
+}
+
+/* Called with sys->lock held */
+static int recover_from_pcm_state(audio_output_t *aout)
+{
+    aout_sys_t *sys = aout->sys;
+    snd_pcm_t *pcm = sys->pcm;
     snd_pcm_state_t state = snd_pcm_state(pcm);
     int err = 0;
     switch (state)
@@ -150,6 +190,7 @@ static int recover_from_pcm_state(snd_pcm_t *pcm)
         return 0;
     case SND_PCM_STATE_XRUN:
         err = -EPIPE;
+        count_underrun(aout);
         break;
     case SND_PCM_STATE_SUSPENDED:
         err = -ESTRPIPE;
@@ -182,7 +223,7 @@ static int fill_pfds_from_state_locked(audio_output_t *aout, struct pollfd **pfd
         int cnt = snd_pcm_poll_descriptors_count(pcm);
         if (unlikely(cnt < 0))
         {
-            if (!recover_from_pcm_state(pcm))
+            if (!recover_from_pcm_state(aout))
                 return 0;
 
             msg_Err(aout, "Cannot retrieve descriptors' count (%d)", cnt);
@@ -203,7 +244,7 @@ static int fill_pfds_from_state_locked(audio_output_t *aout, struct pollfd **pfd
         cnt = snd_pcm_poll_descriptors(pcm, &(*pfds)[1], cnt);
         if (unlikely(cnt < 0))
         {
-            if (!recover_from_pcm_state(pcm))
+            if (!recover_from_pcm_state(aout))
                 return 0;
 
             msg_Err(aout, "snd_pcm_poll_descriptors failed (%d)", cnt);
@@ -280,7 +321,7 @@ static void * InjectionThread(void * data)
         cnt = snd_pcm_poll_descriptors_revents(pcm, &pfds[1], pfds_count-1, &revents);
         if (cnt != 0)
         {
-            if (!recover_from_pcm_state(pcm))
+            if (!recover_from_pcm_state(aout))
                 continue;
 
             msg_Err(aout, "snd_pcm_poll_descriptors_revents failed (%d)", cnt);
@@ -289,7 +330,7 @@ static void * InjectionThread(void * data)
 
         if (unlikely(revents & POLLERR))
         {
-            if (!recover_from_pcm_state(pcm))
+            if (!recover_from_pcm_state(aout))
                 continue;
             if (sys->draining)
             {
@@ -335,6 +376,17 @@ static void * InjectionThread(void * data)
             f->p_buffer += bytes;
             f->i_buffer -= bytes;
             sys->queued_samples -= frames;
+            sys->tune.writes++;
+
+            snd_pcm_sframes_t delay;
+            if (snd_pcm_delay(pcm, &delay) == 0 && delay >= 0)
+            {
+                unsigned ms = delay * 1000 / sys->rate;
+                unsigned bucket = stdc_bit_width(ms);
+                if (bucket >= ALSA_HISTO_BUCKETS)
+                    bucket = ALSA_HISTO_BUCKETS - 1;
+                sys->tune.delay_histo[bucket]++;
+            }
             // pts, length
             if (f->i_nb_samples == 0)
             {
@@ -348,6 +400,8 @@ static void * InjectionThread(void * data)
             continue;
         else
         {
+            if (frames == -EPIPE)
+                count_underrun(aout);
             int val = snd_pcm_recover(pcm, frames, 1);
             if (val)
             {
@@ -496,6 +550,29 @@ static void Drain (audio_output_t *aout)
     vlc_mutex_unlock(&sys->lock);
 }
 
+/**
+ * Reports the run statistics and picks the buffer duration for the next
+ * stream setup: shrink after a clean run, grow again after underruns.
+ */
+static void UpdateTuning (audio_output_t *aout)
+{
+    aout_sys_t *sys = aout->sys;
+
+    msg_Dbg (aout, "%u underrun(s) over %"PRIu64" write(s) with %u us buffer",
+             sys->tune.underruns, sys->tune.writes, sys->tune.buffer_time);
+    for (unsigned i = 0; i < ALSA_HISTO_BUCKETS; i++)
+        if (sys->tune.delay_histo[i] > 0)
+            msg_Dbg (aout, "latency < %u ms: %"PRIu64" write(s)",
+                     1u << i, sys->tune.delay_histo[i]);
+
+    if (sys->tune.underruns > 0)
+        sys->tune.buffer_time = __MIN (sys->tune.buffer_time * 2,
+                                       (unsigned)AOUT_MAX_ADVANCE_TIME);
+    else if (sys->tune.writes >= ALSA_TUNE_MIN_WRITES)
+        sys->tune.buffer_time = __MAX (sys->tune.buffer_time / 2,
+                                       2 * (unsigned)AOUT_MIN_PREPARE_TIME);
+}
+
 /**
  * Releases the audio output.
  */
@@ -518,6 +595,9 @@ static void Stop (audio_output_t *aout)
 
     vlc_join(sys->thread, NULL);
 
+    if (sys->tune.enabled)
+        UpdateTuning(aout);
+
     snd_pcm_close(pcm);
 }
 
@@ -901,7 +981,8 @@ static int Start (audio_output_t *aout, audio_sample_format_t *restrict fmt)
     }
 #endif
     /* Set buffer size */
-    param = AOUT_MAX_ADVANCE_TIME;
+    param = sys->tune.enabled ? sys->tune.buffer_time
+                              : (unsigned)AOUT_MAX_ADVANCE_TIME;
     val = snd_pcm_hw_params_set_buffer_time_near (pcm, hw, &param, NULL);
     if (val)
     {
@@ -990,6 +1071,12 @@ static int Start (audio_output_t *aout, audio_sample_format_t *restrict fmt)
 
     aout_SoftVolumeStart (aout);
 
+    if (sys->tune.enabled)
+        msg_Dbg (aout, "auto-tuning with %u us buffer", param);
+    sys->tune.underruns = 0;
+    sys->tune.writes = 0;
+    memset (sys->tune.delay_histo, 0, sizeof (sys->tune.delay_histo));
+
     sys->queued_samples = 0;
     sys->started = true;
     sys->draining = false;
@@ -1136,6 +1223,9 @@ static int Open(vlc_object_t *obj)
 
     sys->state = IDLE;
     vlc_mutex_init(&sys->lock);
+    memset(&sys->tune, 0, sizeof (sys->tune));
+    sys->tune.enabled = var_InheritBool(aout, "alsa-auto-tune");
+    sys->tune.buffer_time = AOUT_MAX_ADVANCE_TIME;
     sys->frame_chain = NULL;
     sys->frame_last = &sys->frame_chain;
     vlc_sem_init(&sys->init_sem, 0);
@@ -1185,6 +1275,12 @@ static const char *const channels_text[] = {
     N_("Surround 5.0"), N_("Surround 5.1"), N_("Surround 7.1"),
 };
 
+#define AUTO_TUNE_TEXT N_("Tune the buffering automatically")
+#define AUTO_TUNE_LONGTEXT N_( \
+    "Start with a conservative buffer duration, then shrink it across runs " \
+    "as long as playback stays free of underruns, growing it back when the " \
+    "device underruns. A latency histogram is reported in the debug log.")
+
 #define PASSTHROUGH_TEXT N_("Audio passthrough mode")
 static const int passthrough_modes[] = {
     PASSTHROUGH_NONE, PASSTHROUGH_SPDIF, PASSTHROUGH_HDMI,
@@ -1205,6 +1301,7 @@ vlc_module_begin()
     add_integer("alsa-passthrough", PASSTHROUGH_NONE, PASSTHROUGH_TEXT,
                 NULL)
         change_integer_list(passthrough_modes, passthrough_modes_text)
+    add_bool("alsa-auto-tune", false, AUTO_TUNE_TEXT, AUTO_TUNE_LONGTEXT)
     add_sw_gain()
     set_capability("audio output", 150)
     set_callbacks(Open, Close)
@@ -572,8 +572,24 @@ static int InitVideoDecCommon( decoder_t *p_dec )
         p_context->strict_std_compliance = FF_COMPLIANCE_EXPERIMENTAL;
 #endif
 
+    if( p_dec->b_thumbnailing )
+    {
+        /* A single approximate picture is wanted as fast as possible:
+         * skip the in-loop filters and decode at reduced resolution when
+         * the codec supports it. The vout is never involved, so the
+         * quality loss is acceptable. */
+        p_context->flags2 |= AV_CODEC_FLAG2_FAST;
+        if( p_codec->max_lowres > 0 )
+        {
+            p_context->lowres = 1;
+            msg_Dbg( p_dec, "thumbnailing: decoding at lowres %d",
+                     p_context->lowres );
+        }
+    }
+
     i_val = var_CreateGetInteger( p_dec, "avcodec-skiploopfilter" );
-    if( i_val >= 4 ) p_context->skip_loop_filter = AVDISCARD_ALL;
+    if( i_val >= 4 || p_dec->b_thumbnailing )
+        p_context->skip_loop_filter = AVDISCARD_ALL;
     else if( i_val == 3 ) p_context->skip_loop_filter = AVDISCARD_NONKEY;
     else if( i_val == 2 ) p_context->skip_loop_filter = AVDISCARD_BIDIR;
     else if( i_val == 1 ) p_context->skip_loop_filter = AVDISCARD_NONREF;
@@ -631,6 +647,11 @@ static int InitVideoDecCommon( decoder_t *p_dec )
         if( i_thread_count > 1 )
             i_thread_count++;
 
+        /* Share of the instance-wide decode thread budget, if any */
+        int64_t i_budget = var_InheritInteger( p_dec, "decoder-thread-budget" );
+        if( i_budget > 0 && i_thread_count > i_budget )
+            i_thread_count = i_budget;
+
         //FIXME: take in count the decoding time
         max_thread_count = p_codec->id == AV_CODEC_ID_HEVC ? 10 : 6;
 #if defined(_WIN32)
@@ -2011,8 +2032,10 @@ static enum AVPixelFormat ffmpeg_GetFormat( AVCodecContext *p_context,
     /* Enumerate available formats */
     enum AVPixelFormat defaultfmt = avcodec_default_get_format(p_context, pi_fmt);
     enum AVPixelFormat swfmt = AV_PIX_FMT_NONE;
+    enum AVPixelFormat displayfmt = AV_PIX_FMT_NONE;
     enum AVPixelFormat skipfmt = AV_PIX_FMT_NONE;
     bool can_hwaccel = false;
+    const vlc_fourcc_t display_chroma = decoder_GetDisplayChroma( p_dec );
 
     for (size_t i = 0; pi_fmt[i] != AV_PIX_FMT_NONE; i++)
     {
@@ -2032,8 +2055,18 @@ static enum AVPixelFormat ffmpeg_GetFormat( AVCodecContext *p_context,
 
             can_hwaccel = true;
         }
-        else if (swfmt == AV_PIX_FMT_NONE && !p_sys->b_hardware_only)
-            swfmt = pi_fmt[i];
+        else if (!p_sys->b_hardware_only)
+        {
+            if (swfmt == AV_PIX_FMT_NONE)
+                swfmt = pi_fmt[i];
+            if (displayfmt == AV_PIX_FMT_NONE && display_chroma != 0)
+            {
+                video_format_t fmtcheck = { .i_chroma = 0 };
+                if (GetVlcChroma(&fmtcheck, pi_fmt[i]) == VLC_SUCCESS &&
+                    fmtcheck.i_chroma == display_chroma)
+                    displayfmt = pi_fmt[i];
+            }
+        }
     }
 
     /* Use the default fmt in priority of any sw fmt if the default fmt is a hw
@@ -2051,6 +2084,15 @@ static enum AVPixelFormat ffmpeg_GetFormat( AVCodecContext *p_context,
         swfmt = defaultfmt;
     }
 
+    /* Among the offered software formats, prefer the one the display
+     * already consumes: it spares a converter in the vout filter chain. */
+    if (displayfmt != AV_PIX_FMT_NONE && swfmt != displayfmt)
+    {
+        msg_Dbg( p_dec, "picking output format %d to match the display",
+                 displayfmt );
+        swfmt = displayfmt;
+    }
+
     if (p_sys->pix_fmt == AV_PIX_FMT_NONE)
         goto no_reuse;
 
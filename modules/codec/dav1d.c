@@ -55,6 +55,10 @@ static void CloseDecoder(vlc_object_t *);
 #define THREAD_FRAMES_LONGTEXT N_( "Max number of threads used for frame decoding, default 0=auto" )
 #define THREAD_TILES_TEXT N_("Tiles Threads")
 #define THREAD_TILES_LONGTEXT N_( "Max number of threads used for tile decoding, default 0=auto" )
+#define APPLY_GRAIN_TEXT N_("Apply film grain")
+#define APPLY_GRAIN_LONGTEXT N_( "Synthesize AV1 film grain while decoding. "
+    "Grain synthesis can cost a significant share of the decode time; "
+    "disable it to trade fidelity for throughput." )
 
 
 vlc_module_begin ()
@@ -75,6 +79,7 @@ vlc_module_begin ()
                 THREAD_TILES_TEXT, THREAD_TILES_LONGTEXT)
 #endif
     add_bool( "dav1d-all-layers", false, "Display all spatial layers", NULL )
+    add_bool( "dav1d-apply-grain", true, APPLY_GRAIN_TEXT, APPLY_GRAIN_LONGTEXT )
 vlc_module_end ()
 
 /*****************************************************************************
@@ -436,8 +441,15 @@ static int OpenDecoder(vlc_object_t *p_this)
 #if DAV1D_API_VERSION_MAJOR >= 6
     p_sys->s.n_threads = var_InheritInteger(p_this, "dav1d-thread-frames");
     if (p_sys->s.n_threads == 0)
+    {
         p_sys->s.n_threads = __MAX(1, vlc_GetCPUCount());
 
+        /* Share of the instance-wide decode thread budget, if any */
+        int64_t budget = var_InheritInteger(p_this, "decoder-thread-budget");
+        if (budget > 0 && p_sys->s.n_threads > budget)
+            p_sys->s.n_threads = budget;
+    }
+
 #if DAV1D_API_VERSION_MAJOR > 6 || DAV1D_API_VERSION_MINOR >= 7
     // after dav1d 1.0.0
     p_sys->s.max_frame_delay = dav1d_get_frame_delay( &p_sys->s );
@@ -464,9 +476,17 @@ static int OpenDecoder(vlc_object_t *p_this)
         p_sys->s.n_tile_threads = VLC_CLIP(vlc_GetCPUCount(), 1, 4);
     p_sys->s.n_frame_threads = var_InheritInteger(p_this, "dav1d-thread-frames");
     if (p_sys->s.n_frame_threads == 0)
+    {
         p_sys->s.n_frame_threads = __MAX(1, vlc_GetCPUCount());
+
+        /* Share of the instance-wide decode thread budget, if any */
+        int64_t budget = var_InheritInteger(p_this, "decoder-thread-budget");
+        if (budget > 0 && p_sys->s.n_frame_threads > budget)
+            p_sys->s.n_frame_threads = budget;
+    }
 #endif
     p_sys->s.all_layers = var_InheritBool( p_this, "dav1d-all-layers" );
+    p_sys->s.apply_grain = var_InheritBool( p_this, "dav1d-apply-grain" );
     p_sys->s.allocator.cookie = dec;
     p_sys->s.allocator.alloc_picture_callback = NewPicture;
     p_sys->s.allocator.release_picture_callback = FreePicture;
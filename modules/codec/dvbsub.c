@@ -278,6 +278,9 @@ typedef struct
     dvbsub_page_t      *p_page;
     dvbsub_region_t    *p_regions;
     dvbsub_clut_t      *p_cluts;
+    /* parked across epoch resets so the next epoch reuses the allocations */
+    dvbsub_region_t    *p_spare_regions;
+    dvbsub_clut_t      *p_spare_cluts;
     /* this is very small, so keep forever */
     dvbsub_display_t   display;
     dvbsub_clut_t      default_clut;
@@ -321,6 +324,7 @@ static void decode_region_composition( decoder_t *, bs_t *, uint16_t );
 static void decode_object( decoder_t *, bs_t *, uint16_t );
 static void decode_display_definition( decoder_t *, bs_t *, uint16_t );
 static void decode_clut( decoder_t *, bs_t *, uint16_t );
+static void recycle_all( decoder_t * );
 static void free_all( decoder_t * );
 
 static void default_clut_init( decoder_t * );
@@ -690,7 +694,12 @@ static void decode_clut( decoder_t *p_dec, bs_t *s, uint16_t i_segment_length )
 #ifdef DEBUG_DVBSUB
         msg_Dbg( p_dec, "new clut: %i", i_id );
 #endif
-        p_clut = malloc( sizeof( dvbsub_clut_t ) );
+        /* Reuse a CLUT parked by the previous epoch when available */
+        p_clut = p_sys->p_spare_cluts;
+        if( p_clut )
+            p_sys->p_spare_cluts = p_clut->p_next;
+        else
+            p_clut = malloc( sizeof( dvbsub_clut_t ) );
         if( !p_clut )
             return;
         p_clut->p_next = p_sys->p_cluts;
@@ -785,7 +794,7 @@ static void decode_page_composition( decoder_t *p_dec, bs_t *s, uint16_t i_segme
 #ifdef DEBUG_DVBSUB
         msg_Dbg( p_dec, "page composition mode change" );
 #endif
-        free_all( p_dec );
+        recycle_all( p_dec );
     }
     else if( !p_sys->p_page && ( i_state != DVBSUB_PCS_STATE_ACQUISITION ) &&
              ( i_state != DVBSUB_PCS_STATE_CHANGE ) )
@@ -867,6 +876,7 @@ static void decode_region_composition( decoder_t *p_dec, bs_t *s, uint16_t i_seg
     int i_width, i_height, i_level_comp, i_depth, i_clut;
     int i_8_bg, i_4_bg, i_2_bg;
     bool b_fill;
+    bool b_reused = false;
 
     i_id = bs_read( s, 8 );
     i_version = bs_read( s, 4 );
@@ -891,11 +901,23 @@ static void decode_region_composition( decoder_t *p_dec, bs_t *s, uint16_t i_seg
 #ifdef DEBUG_DVBSUB
         msg_Dbg( p_dec, "new region: %i", i_id );
 #endif
-        p_region = *pp_region = calloc( 1, sizeof(dvbsub_region_t) );
-        if( !p_region )
-            return;
-        p_region->p_object_defs = NULL;
-        p_region->p_pixbuf = NULL;
+        /* Reuse a region parked by the previous epoch when available; its
+         * pixel buffer is kept if the dimensions still match */
+        p_region = p_sys->p_spare_regions;
+        if( p_region )
+        {
+            p_sys->p_spare_regions = p_region->p_next;
+            b_reused = true;
+        }
+        else
+        {
+            p_region = calloc( 1, sizeof(dvbsub_region_t) );
+            if( !p_region )
+                return;
+            p_region->p_object_defs = NULL;
+            p_region->p_pixbuf = NULL;
+        }
+        *pp_region = p_region;
         p_region->p_next = NULL;
     }
 
@@ -942,6 +964,8 @@ static void decode_region_composition( decoder_t *p_dec, bs_t *s, uint16_t i_seg
         p_region->i_depth = 0;
         b_fill = true;
     }
+    else if( b_reused )
+        b_fill = true; /* do not leak pixels from the previous epoch */
     if( p_region->i_depth &&
         ( ( p_region->i_depth != i_depth ) ||
           ( p_region->i_level_comp != i_level_comp ) ||
@@ -1442,18 +1466,21 @@ static void dvbsub_pdata8bpp( bs_t *s, uint8_t *p, int i_width, int *pi_off )
     bs_align( s );
 }
 
-static void free_all( decoder_t *p_dec )
+/* Park the regions and CLUTs on the spare lists instead of freeing them;
+ * channels with rapid subtitle updates reset their epoch on every page
+ * change, and reusing the allocations (including the region pixel buffers
+ * when the dimensions are unchanged) avoids churning the allocator. */
+static void recycle_all( decoder_t *p_dec )
 {
     decoder_sys_t *p_sys = p_dec->p_sys;
     dvbsub_region_t *p_reg, *p_reg_next;
     dvbsub_clut_t *p_clut, *p_clut_next;
 
-    /*free( p_sys->p_display ); No longer malloced */
-
     for( p_clut = p_sys->p_cluts; p_clut != NULL; p_clut = p_clut_next )
     {
         p_clut_next = p_clut->p_next;
-        free( p_clut );
+        p_clut->p_next = p_sys->p_spare_cluts;
+        p_sys->p_spare_cluts = p_clut;
     }
     p_sys->p_cluts = NULL;
 
@@ -1463,8 +1490,11 @@ static void free_all( decoder_t *p_dec )
         for( int i = 0; i < p_reg->i_object_defs; i++ )
             free( p_reg->p_object_defs[i].psz_text );
         if( p_reg->i_object_defs ) free( p_reg->p_object_defs );
-        free( p_reg->p_pixbuf );
-        free( p_reg );
+        p_reg->p_object_defs = NULL;
+        p_reg->i_object_defs = 0;
+        p_reg->i_depth = 0;
+        p_reg->p_next = p_sys->p_spare_regions;
+        p_sys->p_spare_regions = p_reg;
     }
     p_sys->p_regions = NULL;
 
@@ -1477,6 +1507,32 @@ static void free_all( decoder_t *p_dec )
     p_sys->p_page = NULL;
 }
 
+static void free_all( decoder_t *p_dec )
+{
+    decoder_sys_t *p_sys = p_dec->p_sys;
+    dvbsub_region_t *p_reg, *p_reg_next;
+    dvbsub_clut_t *p_clut, *p_clut_next;
+
+    /*free( p_sys->p_display ); No longer malloced */
+
+    recycle_all( p_dec );
+
+    for( p_clut = p_sys->p_spare_cluts; p_clut != NULL; p_clut = p_clut_next )
+    {
+        p_clut_next = p_clut->p_next;
+        free( p_clut );
+    }
+    p_sys->p_spare_cluts = NULL;
+
+    for( p_reg = p_sys->p_spare_regions; p_reg != NULL; p_reg = p_reg_next )
+    {
+        p_reg_next = p_reg->p_next;
+        free( p_reg->p_pixbuf );
+        free( p_reg );
+    }
+    p_sys->p_spare_regions = NULL;
+}
+
 static subpicture_t *render( decoder_t *p_dec )
 {
     decoder_sys_t *p_sys = p_dec->p_sys;
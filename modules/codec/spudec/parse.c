@@ -65,6 +65,8 @@ typedef struct
     bool b_auto_crop;
     int i_y_top_offset;
     int i_y_bottom_offset;
+    int i_x_left_offset;
+    int i_x_right_offset;
 
 } subpicture_data_t;
 
@@ -357,6 +359,8 @@ static int ParseControlSeq( decoder_t *p_dec, vlc_tick_t i_pts,
     spu_data_cmd.b_auto_crop = false;
     spu_data_cmd.i_y_top_offset = 0;
     spu_data_cmd.i_y_bottom_offset = 0;
+    spu_data_cmd.i_x_left_offset = 0;
+    spu_data_cmd.i_x_right_offset = 0;
     spu_data_cmd.pi_alpha[0] = 0x00;
     spu_data_cmd.pi_alpha[1] = 0x0f;
     spu_data_cmd.pi_alpha[2] = 0x0f;
@@ -619,6 +623,7 @@ static int ParseRLE( decoder_t *p_dec,
     bool b_empty_top = true;
     unsigned int i_skipped_top = 0, i_skipped_bottom = 0;
     unsigned int i_transparent_code = 0;
+    unsigned int i_min_x = i_width, i_max_x = 0;
 
     /* Colormap statistics */
     int i_border = -1;
@@ -663,6 +668,12 @@ static int ParseRLE( decoder_t *p_dec,
             {
                 i_border = i_code & 0x3;
                 stats[i_border] += i_code >> 2;
+
+                /* Track the horizontal extent of the visible pixels */
+                if( i_x < i_min_x )
+                    i_min_x = i_x;
+                if( i_x + (i_code >> 2) > i_max_x )
+                    i_max_x = i_x + (i_code >> 2);
             }
 
             /* Auto crop subtitles (a lot more optimized) */
@@ -768,6 +779,16 @@ static int ParseRLE( decoder_t *p_dec,
 #endif
     }
 
+    /* Also drop the fully transparent side margins, so the region (and
+     * everything derived from it: scaled pictures, blending) only covers
+     * the visible pixels. Not when COLCON commands are present, as they
+     * may re-colour pixels that are transparent at this point. */
+    if( p_spu_data->p_pxctli == NULL && i_max_x > i_min_x )
+    {
+        p_spu_data->i_x_left_offset = i_min_x;
+        p_spu_data->i_x_right_offset = i_width - i_max_x;
+    }
+
     /* Handle color if no palette was found */
     if( !p_spu_data->b_palette )
     {
@@ -842,7 +863,10 @@ static int Render( decoder_t *p_dec, subpicture_t *p_spu,
     const uint16_t *p_source = p_pixeldata;
     video_format_t fmt;
     video_palette_t palette;
-    const int width = p_spu_properties->i_width;
+    const int i_src_width = p_spu_properties->i_width;
+    const int i_x_left = p_spu_data->i_x_left_offset;
+    const int width = p_spu_properties->i_width -
+        i_x_left - p_spu_data->i_x_right_offset;
     const int height = p_spu_properties->i_height -
         p_spu_data->i_y_top_offset - p_spu_data->i_y_bottom_offset;
 
@@ -879,7 +903,7 @@ static int Render( decoder_t *p_dec, subpicture_t *p_spu,
         p_spu->i_original_picture_height = p_spu_properties->i_height;
     }
     p_region->b_absolute = true;
-    p_region->i_x = p_spu_properties->i_x;
+    p_region->i_x = p_spu_properties->i_x + i_x_left;
     p_region->i_y = p_spu_properties->i_y + p_spu_data->i_y_top_offset;
     p_p = p_region->p_picture->p->p_pixels;
     i_pitch = p_region->p_picture->p->i_pitch;
@@ -888,12 +912,17 @@ static int Render( decoder_t *p_dec, subpicture_t *p_spu,
     for( i_y = 0; i_y < height * i_pitch; i_y += i_pitch )
     {
         /* Draw until we reach the end of the line */
-        for( i_x = 0 ; i_x < width; i_x += i_len )
+        for( i_x = 0 ; i_x < i_src_width; i_x += i_len )
         {
-            /* Get the RLE part, then draw the line */
+            /* Get the RLE part, then draw the line clipped to the
+             * horizontally cropped region */
             i_color = *p_source & 0x3;
             i_len = *p_source++ >> 2;
-            memset( p_p + i_x + i_y, i_color, i_len );
+
+            int i_begin = __MAX( i_x - i_x_left, 0 );
+            int i_end = __MIN( i_x + i_len - i_x_left, width );
+            if( i_end > i_begin )
+                memset( p_p + i_begin + i_y, i_color, i_end - i_begin );
         }
     }
 
@@ -83,6 +83,15 @@ typedef struct
     } display;
 }  ttml_style_t;
 
+typedef struct
+{
+    /* computed styles, indexed by source node, shared between all the
+     * timings of one document (nodes are immutable once parsed) */
+    vlc_dictionary_t nodes;
+    unsigned         i_resolved;
+    unsigned         i_reused;
+} ttml_style_cache_t;
+
 typedef struct
 {
     vlc_dictionary_t regions;
@@ -90,6 +99,7 @@ typedef struct
     ttml_length_t    root_extent_h, root_extent_v;
     unsigned         i_cell_resolution_v;
     unsigned         i_cell_resolution_h;
+    ttml_style_cache_t *p_style_cache;
 } ttml_context_t;
 
 typedef struct
@@ -107,6 +117,12 @@ typedef struct
 {
     int                     i_align;
     struct ttml_in_pes_ctx  pes;
+    struct
+    {
+        unsigned i_relayouts;
+        unsigned i_styles_resolved;
+        unsigned i_styles_reused;
+    } stats;
 } decoder_sys_t;
 
 enum
@@ -166,6 +182,7 @@ static ttml_style_t * ttml_style_Duplicate( const ttml_style_t *p_src )
     ttml_style_t *p_dup = ttml_style_New( );
     if( p_dup )
     {
+        text_style_Delete( p_dup->font_style );
         *p_dup = *p_src;
         p_dup->font_style = text_style_Duplicate( p_src->font_style );
     }
@@ -692,11 +709,48 @@ static void DictToTTMLStyle( ttml_context_t *p_ctx, tt_namespaces_t *p_nss,
     ComputeTTMLStyles( p_ctx, p_dict, p_ttml_style );
 }
 
+static void ttml_style_cache_Init( ttml_style_cache_t *p_cache )
+{
+    vlc_dictionary_init( &p_cache->nodes, 0 );
+    p_cache->i_resolved = 0;
+    p_cache->i_reused = 0;
+}
+
+static void ttml_style_cache_FreeEntry( void *p_value, void *p_obj )
+{
+    VLC_UNUSED(p_obj);
+    ttml_style_Delete( p_value );
+}
+
+static void ttml_style_cache_Clean( ttml_style_cache_t *p_cache )
+{
+    vlc_dictionary_clear( &p_cache->nodes, ttml_style_cache_FreeEntry, NULL );
+}
+
+static void ttml_style_cache_Key( char *psz_key, size_t i_size,
+                                  const tt_node_t *p_node )
+{
+    snprintf( psz_key, i_size, "%p", (const void *) p_node );
+}
+
 static ttml_style_t * InheritTTMLStyles( ttml_context_t *p_ctx, tt_namespaces_t *p_nss,
                                          tt_node_t *p_node )
 {
     assert( p_node );
     ttml_style_t *p_ttml_style = NULL;
+    char psz_key[sizeof(void *) * 2 + 3];
+
+    /* Sibling text nodes and other timings of the same document share the
+     * same ancestor chain, hence the same computed style */
+    ttml_style_cache_Key( psz_key, sizeof(psz_key), p_node );
+    ttml_style_t *p_cached =
+        vlc_dictionary_value_for_key( &p_ctx->p_style_cache->nodes, psz_key );
+    if( p_cached != kVLCDictionaryNotFound )
+    {
+        p_ctx->p_style_cache->i_reused++;
+        return ttml_style_Duplicate( p_cached );
+    }
+
     vlc_dictionary_t merged;
     vlc_dictionary_init( &merged, 0 );
 
@@ -721,6 +775,14 @@ static ttml_style_t * InheritTTMLStyles( ttml_context_t *p_ctx, tt_namespaces_t
 
     vlc_dictionary_clear( &merged, NULL, NULL );
 
+    p_ctx->p_style_cache->i_resolved++;
+    if( p_ttml_style )
+    {
+        ttml_style_t *p_copy = ttml_style_Duplicate( p_ttml_style );
+        if( p_copy )
+            vlc_dictionary_insert( &p_ctx->p_style_cache->nodes, psz_key, p_copy );
+    }
+
     return p_ttml_style;
 }
 
@@ -1102,6 +1164,7 @@ static void InitTTMLContext( tt_namespaces_t *p_nss, tt_node_t *p_rootnode,
 }
 
 static ttml_region_t *GenerateRegions( tt_namespaces_t *p_nss, tt_node_t *p_rootnode,
+                                       ttml_style_cache_t *p_style_cache,
                                        tt_time_t playbacktime )
 {
     ttml_region_t*  p_regions = NULL;
@@ -1115,6 +1178,7 @@ static ttml_region_t *GenerateRegions( tt_namespaces_t *p_nss, tt_node_t *p_root
             ttml_context_t context;
             InitTTMLContext( p_nss, p_rootnode, &context );
             context.p_rootnode = p_rootnode;
+            context.p_style_cache = p_style_cache;
 
             vlc_dictionary_init( &context.regions, 1 );
             ConvertNodesToRegionContent( &context, p_nss, p_bodynode, NULL, NULL, playbacktime );
@@ -1350,6 +1414,9 @@ static int ParseBlock( decoder_t *p_dec, const block_t *p_block )
     tt_timings_Resolve( (tt_basenode_t *) p_rootnode, &temporal_extent,
                         &p_timings_array, &i_timings_count );
 
+    ttml_style_cache_t style_cache;
+    ttml_style_cache_Init( &style_cache );
+
 #ifdef TTML_DEBUG
     for( size_t i=0; i<i_timings_count; i++ )
         printf("%ld ", tt_time_Convert( &p_timings_array[i] ) );
@@ -1375,7 +1442,8 @@ static int ParseBlock( decoder_t *p_dec, const block_t *p_block )
 
         bool b_bitmap_regions = false;
         subpicture_t *p_spu = NULL;
-        ttml_region_t *p_regions = GenerateRegions( &namespaces, p_rootnode, p_timings_array[i] );
+        ttml_region_t *p_regions = GenerateRegions( &namespaces, p_rootnode,
+                                                    &style_cache, p_timings_array[i] );
         if( p_regions )
         {
             if( p_regions->bgbitmap.i_bytes > 0 && p_regions->updt.p_segments == NULL )
@@ -1391,6 +1459,7 @@ static int ParseBlock( decoder_t *p_dec, const block_t *p_block )
 
         if( p_regions && p_spu )
         {
+            p_sys->stats.i_relayouts++;
             p_spu->i_start    = p_sys->pes.i_offset +
                                 VLC_TICK_0 + tt_time_Convert( &p_timings_array[i] );
             p_spu->i_stop     = p_sys->pes.i_offset +
@@ -1415,6 +1484,10 @@ static int ParseBlock( decoder_t *p_dec, const block_t *p_block )
             decoder_QueueSub( p_dec, p_spu );
     }
 
+    p_sys->stats.i_styles_resolved += style_cache.i_resolved;
+    p_sys->stats.i_styles_reused += style_cache.i_reused;
+    ttml_style_cache_Clean( &style_cache );
+
     tt_node_RecursiveDelete( p_rootnode );
     tt_namespaces_Clean( &namespaces );
 
@@ -1486,3 +1559,16 @@ int tt_OpenDecoder( vlc_object_t *p_this )
 
     return VLC_SUCCESS;
 }
+
+/*****************************************************************************
+ * tt_CloseDecoder: clean up the decoder
+ *****************************************************************************/
+void tt_CloseDecoder( vlc_object_t *p_this )
+{
+    decoder_t *p_dec = (decoder_t *)p_this;
+    decoder_sys_t *p_sys = p_dec->p_sys;
+
+    msg_Dbg( p_dec, "laid out %u regions, resolved %u styles, reused %u from cache",
+             p_sys->stats.i_relayouts, p_sys->stats.i_styles_resolved,
+             p_sys->stats.i_styles_reused );
+}
@@ -44,7 +44,7 @@ vlc_module_begin ()
     set_capability( "spu decoder", 10 )
     set_shortname( N_("TTML decoder"))
     set_description( N_("TTML subtitles decoder") )
-    set_callback( tt_OpenDecoder )
+    set_callbacks( tt_OpenDecoder, tt_CloseDecoder )
     set_subcategory( SUBCAT_INPUT_SCODEC )
     add_integer( "ttml-align", 0, ALIGN_TEXT, ALIGN_LONGTEXT )
 
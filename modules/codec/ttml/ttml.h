@@ -27,6 +27,7 @@ int tt_OpenDemux( vlc_object_t* p_this );
 void tt_CloseDemux( vlc_object_t* p_demux );
 
 int  tt_OpenDecoder   ( vlc_object_t * );
+void tt_CloseDecoder  ( vlc_object_t * );
 
 int  tt_OpenEncoder   ( vlc_object_t * );
 
@@ -129,6 +129,8 @@ struct webvtt_dom_cue_t
     unsigned i_lines;
     text_style_t *p_cssstyle;
     webvtt_dom_node_t *p_child;
+    /* styled segments from the last layout, reused until the cue changes */
+    text_segment_t *p_segmentcache;
 };
 
 typedef struct
@@ -159,6 +161,11 @@ typedef struct
     /* CSS */
     vlc_css_rule_t *p_css_rules;
 #endif
+    struct
+    {
+        unsigned i_relayouts;
+        unsigned i_reused;
+    } cuestats;
 } decoder_sys_t;
 
 /*****************************************************************************
@@ -960,13 +967,21 @@ static webvtt_dom_cue_t * webvtt_dom_cue_New( vlc_tick_t i_nzstart, vlc_tick_t i
         p_cue->p_child = NULL;
         p_cue->i_lines = 0;
         p_cue->p_cssstyle = NULL;
+        p_cue->p_segmentcache = NULL;
         webvtt_cue_settings_Init( &p_cue->settings );
     }
     return p_cue;
 }
 
+static void webvtt_dom_cue_InvalidateSegments( webvtt_dom_cue_t *p_cue )
+{
+    text_segment_ChainDelete( p_cue->p_segmentcache );
+    p_cue->p_segmentcache = NULL;
+}
+
 static void webvtt_dom_cue_ClearText( webvtt_dom_cue_t *p_cue )
 {
+    webvtt_dom_cue_InvalidateSegments( p_cue );
     webvtt_domnode_ChainDelete( p_cue->p_child );
     p_cue->p_child = NULL;
     p_cue->i_lines = 0;
@@ -987,6 +1002,8 @@ static unsigned webvtt_dom_cue_Reduced( webvtt_dom_cue_t *p_cue )
     if( p_cue->i_lines < 1 )
         return 0;
 
+    webvtt_dom_cue_InvalidateSegments( p_cue );
+
     for( webvtt_dom_node_t *p_node = p_cue->p_child;
                            p_node; p_node = p_node->p_next )
     {
@@ -1593,9 +1610,33 @@ static text_segment_t *ConvertNodesToSegments( decoder_t *p_dec,
 
 static text_segment_t *ConvertCueToSegments( decoder_t *p_dec,
                                              struct render_variables_s *p_vars,
-                                             const webvtt_dom_cue_t *p_cue )
+                                             webvtt_dom_cue_t *p_cue )
 {
-    return ConvertNodesToSegments( p_dec, p_vars, p_cue, p_cue->p_child );
+    decoder_sys_t *p_sys = p_dec->p_sys;
+
+#ifdef HAVE_CSS
+    /* CSS selectors can depend on playback time: no reuse across renders */
+    const bool b_cacheable = ( p_sys->p_css_rules == NULL );
+#else
+    const bool b_cacheable = true;
+#endif
+
+    if( b_cacheable && p_cue->p_segmentcache )
+    {
+        text_segment_t *p_copy = text_segment_Copy( p_cue->p_segmentcache );
+        if( p_copy )
+        {
+            p_sys->cuestats.i_reused++;
+            return p_copy;
+        }
+    }
+
+    text_segment_t *p_segments =
+            ConvertNodesToSegments( p_dec, p_vars, p_cue, p_cue->p_child );
+    p_sys->cuestats.i_relayouts++;
+    if( b_cacheable && p_segments )
+        p_cue->p_segmentcache = text_segment_Copy( p_segments );
+    return p_segments;
 }
 
 static void ChainCueSegments( const webvtt_dom_cue_t *p_cue, text_segment_t *p_new,
@@ -1635,13 +1676,13 @@ static void ChainCueSegments( const webvtt_dom_cue_t *p_cue, text_segment_t *p_n
 
 static text_segment_t * ConvertCuesToSegments( decoder_t *p_dec, vlc_tick_t i_nzstart, vlc_tick_t i_nzstop,
                                                struct render_variables_s *p_vars,
-                                               const webvtt_dom_cue_t *p_cue )
+                                               webvtt_dom_cue_t *p_cue )
 {
     text_segment_t *p_segments = NULL;
     text_segment_t **pp_append = &p_segments;
     VLC_UNUSED(i_nzstop);
 
-    for( ; p_cue; p_cue = (const webvtt_dom_cue_t *) p_cue->p_next )
+    for( ; p_cue; p_cue = (webvtt_dom_cue_t *) p_cue->p_next )
     {
         if( p_cue->type != NODE_CUE )
             continue;
@@ -1765,9 +1806,9 @@ static void RenderRegions( decoder_t *p_dec, vlc_tick_t i_nzstart, vlc_tick_t i_
     ApplyCSSRules( p_dec, p_sys->p_css_rules, i_nzstart );
 #endif
 
-    const webvtt_dom_cue_t *p_rlcue = NULL;
-    for( const webvtt_dom_node_t *p_node = p_sys->p_root->p_child;
-                                  p_node; p_node = p_node->p_next )
+    webvtt_dom_cue_t *p_rlcue = NULL;
+    for( webvtt_dom_node_t *p_node = p_sys->p_root->p_child;
+                            p_node; p_node = p_node->p_next )
     {
         if( p_node->type == NODE_REGION )
         {
@@ -1784,7 +1825,7 @@ static void RenderRegions( decoder_t *p_dec, vlc_tick_t i_nzstart, vlc_tick_t i_
 
             text_segment_t *p_segments =
                     ConvertCuesToSegments( p_dec, i_nzstart, i_nzstop, &v,
-                                          (const webvtt_dom_cue_t *)p_vttregion->p_child );
+                                          (webvtt_dom_cue_t *)p_vttregion->p_child );
             if( !p_segments )
                 continue;
 
@@ -1809,7 +1850,7 @@ static void RenderRegions( decoder_t *p_dec, vlc_tick_t i_nzstart, vlc_tick_t i_
         else if ( p_node->type == NODE_CUE )
         {
             if( p_rlcue == NULL )
-                p_rlcue = ( const webvtt_dom_cue_t * ) p_node;
+                p_rlcue = ( webvtt_dom_cue_t * ) p_node;
         }
     }
 
@@ -1825,8 +1866,8 @@ static void RenderRegions( decoder_t *p_dec, vlc_tick_t i_nzstart, vlc_tick_t i_
         v.i_top = 0.0;
         /* !Variables */
 
-        for( const webvtt_dom_cue_t *p_cue = p_rlcue; p_cue;
-             p_cue = (const webvtt_dom_cue_t *) p_cue->p_next )
+        for( webvtt_dom_cue_t *p_cue = p_rlcue; p_cue;
+             p_cue = (webvtt_dom_cue_t *) p_cue->p_next )
         {
             if( p_cue->type != NODE_CUE )
                 continue;
@@ -2149,6 +2190,9 @@ void webvtt_CloseDecoder( vlc_object_t *p_this )
     decoder_t *p_dec = (decoder_t *)p_this;
     decoder_sys_t *p_sys = p_dec->p_sys;
 
+    msg_Dbg( p_dec, "laid out %u cues, reused %u cached cue layouts",
+             p_sys->cuestats.i_relayouts, p_sys->cuestats.i_reused );
+
     webvtt_domnode_ChainDelete( (webvtt_dom_node_t *) p_sys->p_root );
 
 #ifdef HAVE_CSS
@@ -408,6 +408,13 @@ static void x264_log( void *, int i_level, const char *psz, va_list );
 #define X264_OPTIONS_TEXT N_("x264 advanced options")
 #define X264_OPTIONS_LONGTEXT N_("x264 advanced options, in the form {opt=val,op2=val2}.")
 
+#define LOWLATENCY_TEXT N_("Low-latency streaming mode")
+#define LOWLATENCY_LONGTEXT N_( "Coordinated settings for sub-second " \
+    "glass-to-glass streaming: intra-refresh instead of periodic key " \
+    "frames, sliced threads, no lookahead and no B-frames. Each encoded " \
+    "slice is output as a separate block so the sender can packetize it " \
+    "without waiting for the whole frame.")
+
 static const char *const enc_me_list[] =
   { "dia", "hex", "umh", "esa", "tesa" };
 static const char *const enc_me_list_text[] =
@@ -715,6 +722,9 @@ vlc_module_begin ()
     add_string( SOUT_CFG_PREFIX "options", NULL, X264_OPTIONS_TEXT,
                 X264_OPTIONS_LONGTEXT )
 
+    add_bool( SOUT_CFG_PREFIX "low-latency", false, LOWLATENCY_TEXT,
+              LOWLATENCY_LONGTEXT )
+
 vlc_module_end ()
 
 /*****************************************************************************
@@ -735,7 +745,7 @@ static const char *const ppsz_sout_options[] = {
     "aq-mode", "aq-strength", "psy-rd", "psy", "profile", "lookahead", "slices",
     "slice-max-size", "slice-max-mbs", "intra-refresh", "mbtree", "hrd",
     "tune","preset", "opengop", "bluray-compat", "frame-packing", "options",
-    "fullrange",
+    "fullrange", "low-latency",
     NULL
 };
 
@@ -750,6 +760,7 @@ typedef struct
     int             i_sei_size;
     uint32_t         i_colorspace;
     uint8_t         *p_sei;
+    bool            b_slice_output;
 } encoder_sys_t;
 
 /*****************************************************************************
@@ -850,6 +861,7 @@ static int  Open ( vlc_object_t *p_this )
     p_sys->psz_stat_name = NULL;
     p_sys->i_sei_size = 0;
     p_sys->p_sei = NULL;
+    p_sys->b_slice_output = false;
 
     char *psz_preset = var_GetString( p_enc, SOUT_CFG_PREFIX  "preset" );
     char *psz_tune = var_GetString( p_enc, SOUT_CFG_PREFIX  "tune" );
@@ -1327,6 +1339,25 @@ static int  Open ( vlc_object_t *p_this )
     if( i_val != 40 )
         p_sys->param.rc.i_lookahead = i_val;
 
+    if( var_GetBool( p_enc, SOUT_CFG_PREFIX "low-latency" ) )
+    {
+        /* Coordinated settings for sub-second contribution: nothing may
+         * queue frames inside the encoder (lookahead, B-frames, frame
+         * threading), the refresh is spread over P-frames instead of
+         * periodic large IDRs, and parallelism comes from slices, which
+         * also lets the sender packetize slice by slice. */
+        p_sys->param.b_intra_refresh = 1;
+        p_sys->param.i_frame_reference = 1;
+        p_sys->param.i_scenecut_threshold = 0;
+        p_sys->param.b_sliced_threads = 1;
+        p_sys->param.rc.i_lookahead = 0;
+        p_sys->param.i_sync_lookahead = 0;
+        p_sys->param.i_bframe = 0;
+        p_sys->param.rc.b_mb_tree = 0;
+        p_sys->param.b_vfr_input = 0;
+        p_sys->b_slice_output = true;
+    }
+
     /* We don't want repeated headers, we repeat p_extra ourself if needed */
     p_sys->param.b_repeat_headers = 0;
 
@@ -1470,6 +1501,66 @@ static block_t *Encode( encoder_t *p_enc, picture_t *p_pict )
 
     if( !i_nal ) return NULL;
 
+    uint32_t i_flags;
+    if( pic.b_keyframe )
+        i_flags = BLOCK_FLAG_TYPE_I;
+    else if( pic.i_type == X264_TYPE_P || pic.i_type == X264_TYPE_I )
+        i_flags = BLOCK_FLAG_TYPE_P;
+    else if( IS_X264_TYPE_B( pic.i_type ) )
+        i_flags = BLOCK_FLAG_TYPE_B;
+    else
+        i_flags = BLOCK_FLAG_TYPE_PB;
+
+    /* If we happen to have vfr stream, don't set length at all */
+    vlc_tick_t i_length = 0;
+    if( !p_sys->param.b_vfr_input )
+    {
+        /* This isn't really valid for streams with B-frames */
+        i_length = vlc_tick_from_samples(
+                    p_enc->fmt_out.video.i_frame_rate_base,
+                    p_enc->fmt_out.video.i_frame_rate );
+    }
+
+    if( p_sys->b_slice_output )
+    {
+        /* Low-latency mode: one block per NAL, so that downstream can
+         * packetize and send each slice without waiting for the rest of
+         * the frame. The last block carries the end of the access unit. */
+        block_t *p_chain = NULL, **pp_last = &p_chain;
+
+        for( i = 0; i < i_nal; i++ )
+        {
+            unsigned int i_offset = ( i == 0 ) ? p_sys->i_sei_size : 0;
+
+            p_block = block_Alloc( nal[i].i_payload + i_offset );
+            if( !p_block )
+            {
+                block_ChainRelease( p_chain );
+                return NULL;
+            }
+            if( unlikely( i_offset ) )
+            {
+                /* insert x264 headers SEI nal at the start of the frame */
+                memcpy( p_block->p_buffer, p_sys->p_sei, i_offset );
+                p_sys->i_sei_size = 0;
+                free( p_sys->p_sei );
+                p_sys->p_sei = NULL;
+            }
+            memcpy( p_block->p_buffer + i_offset, nal[i].p_payload,
+                    nal[i].i_payload );
+
+            p_block->i_flags = i_flags;
+            if( i == i_nal - 1 )
+                p_block->i_flags |= BLOCK_FLAG_AU_END;
+            /* account the whole frame duration on its first block */
+            p_block->i_length = ( i == 0 ) ? i_length : 0;
+            p_block->i_pts = pic.i_pts;
+            p_block->i_dts = pic.i_dts;
+
+            block_ChainLastAppend( &pp_last, p_block );
+        }
+        return p_chain;
+    }
 
     /* Get size of block we need */
     for( i = 0; i < i_nal; i++ )
@@ -1491,23 +1582,8 @@ static block_t *Encode( encoder_t *p_enc, picture_t *p_pict )
     /* copy encoded data directly to block */
     memcpy( p_block->p_buffer + i_offset, nal[0].p_payload, i_out );
 
-    if( pic.b_keyframe )
-        p_block->i_flags |= BLOCK_FLAG_TYPE_I;
-    else if( pic.i_type == X264_TYPE_P || pic.i_type == X264_TYPE_I )
-        p_block->i_flags |= BLOCK_FLAG_TYPE_P;
-    else if( IS_X264_TYPE_B( pic.i_type ) )
-        p_block->i_flags |= BLOCK_FLAG_TYPE_B;
-    else
-        p_block->i_flags |= BLOCK_FLAG_TYPE_PB;
-
-    /* If we happen to have vfr stream, don't set length at all */
-    if( !p_sys->param.b_vfr_input )
-    {
-        /* This isn't really valid for streams with B-frames */
-        p_block->i_length = vlc_tick_from_samples(
-                    p_enc->fmt_out.video.i_frame_rate_base,
-                    p_enc->fmt_out.video.i_frame_rate );
-    }
+    p_block->i_flags |= i_flags | BLOCK_FLAG_AU_END;
+    p_block->i_length = i_length;
 
     /* scale pts-values back*/
     p_block->i_pts = pic.i_pts;
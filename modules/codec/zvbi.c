@@ -180,6 +180,21 @@ typedef struct
         int pgno, subno;
     }                 nav_link[6];
     int               i_key[3];
+
+    /* Bitmap render cache (Decode thread only): rows whose cell attributes
+     * did not change since the last rendering are copied from here instead
+     * of being expanded from glyphs again. */
+    struct {
+        vbi_char *p_text;   /* cell attributes of the cached rows */
+        uint8_t  *p_rgba;   /* rendered rows, 10 lines of columns*12 px each */
+        vbi_rgba  color_map[40];
+        unsigned  i_page;
+        int       i_columns;
+        int       i_first_row;
+        int       i_num_rows;
+        bool      b_opaque;
+        bool      b_valid;
+    } cache;
 } decoder_sys_t;
 
 static int Decode( decoder_t *, block_t * );
@@ -191,7 +206,8 @@ static subpicture_t *Subpicture( decoder_t *p_dec,
 
 static void EventHandler( vbi_event *ev, void *user_data );
 static int OpaquePage( picture_t *p_src, const vbi_page *p_page,
-                       bool b_opaque, const int text_offset );
+                       bool b_opaque, const int text_offset,
+                       unsigned int i_first_line, unsigned int i_num_lines );
 static int get_first_visible_row( vbi_char *p_text, int rows, int columns);
 static int get_last_visible_row( vbi_char *p_text, int rows, int columns);
 
@@ -299,6 +315,8 @@ static void Close( vlc_object_t *p_this )
 
     if( p_sys->p_vbi_dec )
         vbi_decoder_delete( p_sys->p_vbi_dec );
+    free( p_sys->cache.p_text );
+    free( p_sys->cache.p_rgba );
     free( p_sys );
 }
 
@@ -504,16 +522,70 @@ static int Decode( decoder_t *p_dec, block_t *p_block )
             p_spu->i_original_picture_height = p_page.rows*10;
         }
 
-        vbi_draw_vt_page_region( &p_page, ZVBI_PIXFMT_RGBA32,
-                          p_region->p_picture->p->p_pixels, -1,
-                          0, i_first_row, p_page.columns, i_num_rows,
-                          1, 1);
+        /* A row is redrawn only if its cell attributes differ from the
+         * cached rendering; static captions then cost a memcpy per row. */
+        const size_t i_row_cells = p_page.columns * sizeof (vbi_char);
+        const size_t i_row_bytes = (size_t)p_pic->p->i_pitch * 10;
+        bool b_cache_ok = p_sys->cache.b_valid
+                       && p_sys->cache.i_page == i_wanted_page
+                       && p_sys->cache.b_opaque == b_opaque
+                       && p_sys->cache.i_columns == p_page.columns
+                       && p_sys->cache.i_first_row == i_first_row
+                       && p_sys->cache.i_num_rows == i_num_rows
+                       && !memcmp( p_sys->cache.color_map, p_page.color_map,
+                                   sizeof( p_page.color_map ) );
+        if( !b_cache_ok )
+        {
+            free( p_sys->cache.p_text );
+            free( p_sys->cache.p_rgba );
+            p_sys->cache.p_text = malloc( i_num_rows * i_row_cells );
+            p_sys->cache.p_rgba = malloc( i_num_rows * i_row_bytes );
+            p_sys->cache.b_valid = p_sys->cache.p_text != NULL
+                                && p_sys->cache.p_rgba != NULL;
+        }
+
+        for( int i_row = 0; i_row < i_num_rows; i_row++ )
+        {
+            const vbi_char *p_cells =
+                &p_page.text[(i_first_row + i_row) * p_page.columns];
+            uint8_t *p_dst = p_pic->p->p_pixels + i_row * i_row_bytes;
+
+            if( b_cache_ok
+             && !memcmp( &p_sys->cache.p_text[i_row * p_page.columns],
+                         p_cells, i_row_cells ) )
+            {
+                memcpy( p_dst, p_sys->cache.p_rgba + i_row * i_row_bytes,
+                        i_row_bytes );
+                continue;
+            }
+
+            vbi_draw_vt_page_region( &p_page, ZVBI_PIXFMT_RGBA32,
+                              p_dst, -1,
+                              0, i_first_row + i_row, p_page.columns, 1,
+                              1, 1);
+            OpaquePage( p_pic, &p_page, b_opaque,
+                        i_first_row * p_page.columns, i_row * 10, 10 );
+
+            if( p_sys->cache.b_valid )
+            {
+                memcpy( &p_sys->cache.p_text[i_row * p_page.columns],
+                        p_cells, i_row_cells );
+                memcpy( p_sys->cache.p_rgba + i_row * i_row_bytes, p_dst,
+                        i_row_bytes );
+            }
+        }
+
+        p_sys->cache.i_page = i_wanted_page;
+        p_sys->cache.b_opaque = b_opaque;
+        p_sys->cache.i_columns = p_page.columns;
+        p_sys->cache.i_first_row = i_first_row;
+        p_sys->cache.i_num_rows = i_num_rows;
+        memcpy( p_sys->cache.color_map, p_page.color_map,
+                sizeof( p_page.color_map ) );
 
         vlc_mutex_lock( &p_sys->lock );
         memcpy( p_sys->nav_link, &p_page.nav_link, sizeof( p_sys->nav_link )) ;
         vlc_mutex_unlock( &p_sys->lock );
-
-        OpaquePage( p_pic, &p_page, b_opaque, i_first_row * p_page.columns );
     }
 
 exit:
@@ -663,22 +735,31 @@ static int get_last_visible_row( vbi_char *p_text, int rows, int columns)
 }
 
 static int OpaquePage( picture_t *p_src, const vbi_page *p_page,
-                       bool b_opaque, const int text_offset )
+                       bool b_opaque, const int text_offset,
+                       unsigned int i_first_line, unsigned int i_num_lines )
 {
     unsigned int    x, y;
 
     assert( p_src->format.i_chroma == VLC_CODEC_RGBA );
 
-    /* Kludge since zvbi doesn't provide an option to specify opacity. */
-    for( y = 0; y < p_src->format.i_height; y++ )
+    /* Kludge since zvbi doesn't provide an option to specify opacity.
+     * The cell attributes are constant over the 12 pixels of a glyph, so
+     * the decision is taken per cell and the per-pixel work reduces to
+     * plain compare-and-clear loops the compiler can vectorize. */
+    for( y = i_first_line; y < i_first_line + i_num_lines; y++ )
     {
-        for( x = 0; x < p_src->format.i_width; x++ )
+        const vbi_char *p_cells =
+            &p_page->text[ text_offset + y/10 * p_page->columns ];
+        uint32_t *p_pixels =
+            (uint32_t*)&p_src->p->p_pixels[y * p_src->p->i_pitch];
+
+        for( unsigned int col = 0; col < p_src->format.i_width / 12; col++ )
         {
-            const vbi_opacity opacity = p_page->text[ text_offset + y/10 * p_page->columns + x/12 ].opacity;
-            const int background = p_page->text[ text_offset + y/10 * p_page->columns + x/12 ].background;
-            uint32_t *p_pixel = (uint32_t*)&p_src->p->p_pixels[y * p_src->p->i_pitch + 4*x];
+            const uint32_t i_bg =
+                0xff000000 | p_page->color_map[p_cells[col].background];
+            uint32_t *p_pixel = p_pixels + col * 12;
 
-            switch( opacity )
+            switch( p_cells[col].opacity )
             {
             /* Display foreground and background color */
             /* To make the boxed text "closed captioning" transparent
@@ -692,12 +773,14 @@ static int OpaquePage( picture_t *p_src, const vbi_page *p_page,
                 /* fallthrough */
             /* Full text transparency. only foreground color is show */
             case VBI_TRANSPARENT_FULL:
-                if( (*p_pixel) != (0xff000000 | p_page->color_map[background] ) )
-                    break;
-                /* fallthrough */
+                for( x = 0; x < 12; x++ )
+                    if( p_pixel[x] == i_bg )
+                        p_pixel[x] = 0;
+                break;
             /* Show video instead of this character */
             case VBI_TRANSPARENT_SPACE:
-                *p_pixel = 0;
+                for( x = 0; x < 12; x++ )
+                    p_pixel[x] = 0;
                 break;
             }
         }
@@ -36,6 +36,7 @@
 #include "logic/AlwaysLowestAdaptationLogic.hpp"
 #include "logic/PredictiveAdaptationLogic.hpp"
 #include "logic/NearOptimalAdaptationLogic.hpp"
+#include "logic/ExternalAdaptationLogic.hpp"
 #include "logic/BufferingLogic.hpp"
 #include "tools/Debug.hpp"
 #ifdef ADAPTIVE_DEBUGGING_LOGIC
@@ -116,6 +117,8 @@ bool PlaylistManager::setupPeriod()
     if(!bufferingLogic && !(bufferingLogic = createBufferingLogic()))
         return false;
 
+    unsigned pipelinedepth = var_InheritInteger(p_demux, "adaptive-pipeline");
+
     const std::vector<BaseAdaptationSet*> &sets = currentPeriod->getAdaptationSets();
     for(BaseAdaptationSet *set : sets)
     {
@@ -126,6 +129,7 @@ bool PlaylistManager::setupPeriod()
                                                          &synchronizationReferences);
             if(!tracker)
                 continue;
+            tracker->setPipelineDepth(pipelinedepth);
 
             AbstractStream *st = streamFactory->create(p_demux, set->getStreamFormat(),
                                                        tracker);
@@ -903,6 +907,33 @@ AbstractAdaptationLogic *PlaylistManager::createLogic(AbstractAdaptationLogic::L
             if(predictivelogic)
                 conn->setDownloadRateObserver(predictivelogic);
             logic = predictivelogic;
+            break;
+        }
+
+        case AbstractAdaptationLogic::LogicType::External:
+        {
+            char *psz_logic = var_InheritString(p_demux, "adaptive-logic");
+            if(psz_logic)
+            {
+                ExternalAdaptationLogic *extlogic =
+                        new (std::nothrow) ExternalAdaptationLogic(obj);
+                if(extlogic && !extlogic->initialize(std::string(psz_logic)))
+                {
+                    delete extlogic;
+                    extlogic = nullptr;
+                }
+                if(extlogic)
+                    conn->setDownloadRateObserver(extlogic);
+                logic = extlogic;
+                free(psz_logic);
+            }
+            if(logic == nullptr)
+            {
+                msg_Warn(p_demux, "falling back to default adaptation logic");
+                return createLogic(AbstractAdaptationLogic::LogicType::Default,
+                                   conn);
+            }
+            break;
         }
 
         default:
@@ -137,6 +137,7 @@ SegmentTracker::SegmentTracker(SharedResources *res,
     resources = res;
     first = true;
     initializing = true;
+    pipelinedepth = 1;
     bufferingLogic = bl;
     setAdaptationLogic(logic_);
     adaptationSet = adaptSet;
@@ -335,6 +336,44 @@ SegmentTracker::prepareChunk(bool switch_allowed, Position pos) const
     return ChunkEntry(segmentChunk, pos, startTime, duration, displayTime);
 }
 
+void SegmentTracker::setPipelineDepth(unsigned depth)
+{
+    pipelinedepth = (depth > 0) ? depth : 1;
+}
+
+/* Keeps up to pipelinedepth segment requests in flight. Creating a chunk
+ * starts its download on the downloader thread, so requests issued ahead
+ * overlap the demux of the current segment and hide the connection RTT. */
+void SegmentTracker::fillChunksSequence(bool switch_allowed)
+{
+    if(chunkssequence.empty())
+    {
+        ChunkEntry chunk = prepareChunk(switch_allowed, next);
+        chunkssequence.push_back(chunk);
+        if(!chunk.isValid())
+            return;
+    }
+
+    while(chunkssequence.size() < pipelinedepth)
+    {
+        const ChunkEntry &last = chunkssequence.back();
+        if(!last.isValid())
+            break;
+
+        Position pos = last.pos;
+        ++pos;
+        if(!pos.isValid())
+            break;
+
+        /* Adaptation decisions apply to the request being issued now,
+           not to the ones already in flight */
+        ChunkEntry chunk = prepareChunk(switch_allowed, pos);
+        if(!chunk.isValid())
+            break; /* segment not (yet) available, don't queue a dead end */
+        chunkssequence.push_back(chunk);
+    }
+}
+
 void SegmentTracker::resetChunksSequence()
 {
     while(!chunkssequence.empty())
@@ -349,11 +388,7 @@ ChunkInterface * SegmentTracker::getNextChunk(bool switch_allowed)
     if(!adaptationSet || !next.isValid())
         return nullptr;
 
-    if(chunkssequence.empty())
-    {
-        ChunkEntry chunk = prepareChunk(switch_allowed, next);
-        chunkssequence.push_back(chunk);
-    }
+    fillChunksSequence(switch_allowed);
 
     ChunkEntry chunk = chunkssequence.front();
     if(!chunk.isValid())
@@ -222,6 +222,7 @@ namespace adaptive
             void getCodecsDesc(CodecDescriptionList *) const;
             const Role & getStreamRole() const;
             void reset();
+            void setPipelineDepth(unsigned);
             ChunkInterface* getNextChunk(bool);
             bool setPositionByTime(vlc_tick_t, bool, bool);
             void setPosition(const Position &, bool);
@@ -253,11 +254,13 @@ namespace adaptive
             };
             std::list<ChunkEntry> chunkssequence;
             ChunkEntry prepareChunk(bool switch_allowed, Position pos) const;
+            void fillChunksSequence(bool switch_allowed);
             void resetChunksSequence();
             void setAdaptationLogic(AbstractAdaptationLogic *);
             void notify(const TrackerEvent &) const;
             bool first;
             bool initializing;
+            unsigned pipelinedepth;
             Position current;
             Position next;
             StreamFormat format;
@@ -26,6 +26,7 @@
 #include "http/HTTPConnectionManager.h"
 #include "http/HTTPConnection.hpp"
 #include "encryption/Keyring.hpp"
+#include "encryption/CommonEncryption.hpp"
 
 using namespace adaptive;
 
@@ -34,12 +35,14 @@ SharedResources::SharedResources(AuthStorage *auth, Keyring *ring,
 {
     authStorage = auth;
     encryptionKeyring = ring;
+    cipherPool = new CipherPool();
     connManager = conn;
 }
 
 SharedResources::~SharedResources()
 {
     delete connManager;
+    delete cipherPool;
     delete encryptionKeyring;
     delete authStorage;
 }
@@ -54,6 +57,11 @@ Keyring * SharedResources::getKeyring()
     return encryptionKeyring;
 }
 
+CipherPool * SharedResources::getCipherPool()
+{
+    return cipherPool;
+}
+
 AbstractConnectionManager * SharedResources::getConnManager()
 {
     return connManager;
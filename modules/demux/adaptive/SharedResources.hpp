@@ -34,6 +34,7 @@ namespace adaptive
     namespace encryption
     {
         class Keyring;
+        class CipherPool;
     }
 
     using namespace http;
@@ -46,6 +47,7 @@ namespace adaptive
             ~SharedResources();
             AuthStorage *getAuthStorage();
             Keyring     *getKeyring();
+            CipherPool  *getCipherPool();
             AbstractConnectionManager *getConnManager();
             /* Helper */
             static SharedResources * createDefault(vlc_object_t *, const std::string &);
@@ -53,6 +55,7 @@ namespace adaptive
         private:
             AuthStorage *authStorage;
             Keyring *encryptionKeyring;
+            CipherPool *cipherPool;
             AbstractConnectionManager *connManager;
     };
 }
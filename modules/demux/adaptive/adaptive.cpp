@@ -77,6 +77,8 @@ static void Close   (vlc_object_t *);
 #define ADAPT_MAXBUFFER_TEXT N_("Max buffering (ms)")
 
 #define ADAPT_LOGIC_TEXT N_("Adaptive Logic")
+#define ADAPT_LOGIC_LONGTEXT N_("Built-in adaptation algorithm, or the " \
+    "name of an \"adaptive logic\" capability module")
 
 #define ADAPT_ACCESS_TEXT N_("Use regular HTTP modules")
 #define ADAPT_ACCESS_LONGTEXT N_("Connect using HTTP access instead of custom HTTP code")
@@ -84,6 +86,11 @@ static void Close   (vlc_object_t *);
 #define ADAPT_LOWLATENCY_TEXT N_("Low latency")
 #define ADAPT_LOWLATENCY_LONGTEXT N_("Overrides low latency parameters")
 
+#define ADAPT_PIPELINE_TEXT N_("Segment requests in flight")
+#define ADAPT_PIPELINE_LONGTEXT N_("Number of segments downloaded ahead per stream. " \
+    "Higher values improve throughput on high latency connections " \
+    "at the cost of memory and adaptation reactivity.")
+
 static const AbstractAdaptationLogic::LogicType pi_logics[] = {
                                 AbstractAdaptationLogic::LogicType::Default,
                                 AbstractAdaptationLogic::LogicType::Predictive,
@@ -127,7 +134,7 @@ vlc_module_begin ()
         set_description( N_("Unified adaptive streaming for DASH/HLS") )
         set_capability( "demux", 12 )
         set_subcategory( SUBCAT_INPUT_DEMUX )
-        add_string( "adaptive-logic",  "", ADAPT_LOGIC_TEXT, nullptr )
+        add_string( "adaptive-logic",  "", ADAPT_LOGIC_TEXT, ADAPT_LOGIC_LONGTEXT )
             change_string_list( ppsz_logics_values, ppsz_logics )
         add_integer( "adaptive-maxwidth",  0,
                      ADAPT_WIDTH_TEXT,  nullptr )
@@ -143,6 +150,8 @@ vlc_module_begin ()
                      ADAPT_MAXBUFFER_TEXT, nullptr )
         add_integer( "adaptive-lowlatency", -1, ADAPT_LOWLATENCY_TEXT, ADAPT_LOWLATENCY_LONGTEXT )
             change_integer_list(rgi_latency, ppsz_latency)
+        add_integer_with_range( "adaptive-pipeline", 3, 1, 16,
+                                ADAPT_PIPELINE_TEXT, ADAPT_PIPELINE_LONGTEXT )
         set_callbacks( Open, Close )
 vlc_module_end ()
 
@@ -192,7 +201,13 @@ static int Open(vlc_object_t *p_obj)
             }
         }
         if(!b_found)
-            msg_Err(p_demux, "Unknown adaptive-logic value '%s'", psz_logic);
+        {
+            /* Not a built-in algorithm: treat the value as the name of an
+             * "adaptive logic" capability module */
+            logic = AbstractAdaptationLogic::LogicType::External;
+            msg_Dbg(p_demux, "no built-in adaptive-logic '%s', "
+                    "will probe a module", psz_logic);
+        }
         free( psz_logic );
     }
 
@@ -52,8 +52,87 @@ void CommonEncryption::mergeWith(const CommonEncryption &other)
         iv = other.iv;
 }
 
+CipherPool::CipherPool()
+{
+    vlc_mutex_init(&lock);
+}
+
+CipherPool::~CipherPool()
+{
+#ifdef HAVE_GCRYPT
+    for(auto &entry : handles)
+        gcry_cipher_close(reinterpret_cast<gcry_cipher_hd_t>(entry.second));
+#endif
+}
+
+void * CipherPool::acquire(const std::vector<unsigned char> &key)
+{
+#ifndef HAVE_GCRYPT
+    VLC_UNUSED(key);
+    return nullptr;
+#else
+    gcry_cipher_hd_t handle = nullptr;
+    bool needskey = true;
+
+    vlc_mutex_lock(&lock);
+    for(auto it = handles.begin(); it != handles.end(); ++it)
+    {
+        if((*it).first == key)
+        {
+            handle = reinterpret_cast<gcry_cipher_hd_t>((*it).second);
+            needskey = false;
+            handles.erase(it);
+            break;
+        }
+    }
+    if(handle == nullptr && !handles.empty())
+    {
+        handle = reinterpret_cast<gcry_cipher_hd_t>(handles.front().second);
+        handles.pop_front();
+    }
+    vlc_mutex_unlock(&lock);
+
+    if(handle == nullptr)
+    {
+        vlc_gcrypt_init();
+        if(gcry_cipher_open(&handle, GCRY_CIPHER_AES, GCRY_CIPHER_MODE_CBC, 0))
+            return nullptr;
+    }
+
+    if(needskey && gcry_cipher_setkey(handle, &key[0], key.size()))
+    {
+        gcry_cipher_close(handle);
+        return nullptr;
+    }
+
+    return handle;
+#endif
+}
+
+void CipherPool::recycle(void *ctx, const std::vector<unsigned char> &key)
+{
+#ifndef HAVE_GCRYPT
+    VLC_UNUSED(ctx);
+    VLC_UNUSED(key);
+#else
+    gcry_cipher_hd_t handle = reinterpret_cast<gcry_cipher_hd_t>(ctx);
+    /* back to the post-setkey state, the key schedule stays valid */
+    gcry_cipher_reset(handle);
+
+    vlc_mutex_lock(&lock);
+    bool keep = handles.size() < MAX_POOLED;
+    if(keep)
+        handles.push_back(std::make_pair(key, ctx));
+    vlc_mutex_unlock(&lock);
+
+    if(!keep)
+        gcry_cipher_close(handle);
+#endif
+}
+
 CommonEncryptionSession::CommonEncryptionSession()
 {
+    pool = nullptr;
     ctx = nullptr;
 }
 
@@ -82,11 +161,12 @@ bool CommonEncryptionSession::start(SharedResources *res, const CommonEncryption
                 return false;
         }
 
-        vlc_gcrypt_init();
-        gcry_cipher_hd_t handle;
-        if( gcry_cipher_open(&handle, GCRY_CIPHER_AES, GCRY_CIPHER_MODE_CBC, 0) ||
-                gcry_cipher_setkey(handle, &key[0], 16) ||
-                gcry_cipher_setiv(handle, &encryption.iv[0], 16) )
+        pool = res->getCipherPool();
+        gcry_cipher_hd_t handle =
+            reinterpret_cast<gcry_cipher_hd_t>(pool->acquire(key));
+        if(handle == nullptr)
+            return false;
+        if(gcry_cipher_setiv(handle, &encryption.iv[0], 16))
         {
             gcry_cipher_close(handle);
             ctx = nullptr;
@@ -103,7 +183,12 @@ void CommonEncryptionSession::close()
 #ifdef HAVE_GCRYPT
     gcry_cipher_hd_t handle = reinterpret_cast<gcry_cipher_hd_t>(ctx);
     if(ctx)
-        gcry_cipher_close(handle);
+    {
+        if(pool)
+            pool->recycle(handle, key);
+        else
+            gcry_cipher_close(handle);
+    }
     ctx = nullptr;
 #endif
 }
@@ -20,8 +20,13 @@
 #ifndef COMMONENCRYPTION_H
 #define COMMONENCRYPTION_H
 
+#include <vlc_common.h>
+#include <vlc_threads.h>
+
 #include <vector>
 #include <string>
+#include <list>
+#include <utility>
 
 namespace adaptive
 {
@@ -44,6 +49,23 @@ namespace adaptive
                 std::vector<unsigned char> iv;
         };
 
+        /* Pools opened cipher contexts, so that consecutive segments
+         * sharing a key skip the per-segment cipher setup, including
+         * the AES key schedule */
+        class CipherPool
+        {
+            public:
+                CipherPool();
+                ~CipherPool();
+                void *acquire(const std::vector<unsigned char> &key);
+                void recycle(void *, const std::vector<unsigned char> &key);
+
+            private:
+                static const size_t MAX_POOLED = 4;
+                std::list<std::pair<std::vector<unsigned char>, void *>> handles;
+                vlc_mutex_t lock;
+        };
+
         class CommonEncryptionSession
         {
             public:
@@ -57,6 +79,7 @@ namespace adaptive
             private:
                 std::vector<unsigned char> key;
                 CommonEncryption encryption;
+                CipherPool *pool;
                 void *ctx;
         };
     }
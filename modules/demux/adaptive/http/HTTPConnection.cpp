@@ -88,17 +88,14 @@ class adaptive::http::LibVLCHTTPSource : public adaptive::AbstractSource
      friend class LibVLCHTTPConnection;
 
      public:
-        LibVLCHTTPSource(vlc_object_t *p_object, struct vlc_http_cookie_jar_t *jar)
+        LibVLCHTTPSource(struct vlc_http_mgr *mgr)
         {
-            http_mgr = vlc_http_mgr_create(p_object, jar);
+            /* Not owned: shared with the other connections of the factory */
+            http_mgr = mgr;
             http_res = nullptr;
             totalRead = 0;
         }
-        virtual ~LibVLCHTTPSource()
-        {
-            if(http_mgr)
-                vlc_http_mgr_destroy(http_mgr);
-        }
+        virtual ~LibVLCHTTPSource() = default;
         block_t *readNextBlock() override
         {
             if(http_res == nullptr)
@@ -239,10 +236,11 @@ const struct vlc_http_resource_cbs LibVLCHTTPSource::callbacks =
     LibVLCHTTPSource::validateresponse_handler,
 };
 
-LibVLCHTTPConnection::LibVLCHTTPConnection(vlc_object_t *p_object_, AuthStorage *auth)
+LibVLCHTTPConnection::LibVLCHTTPConnection(vlc_object_t *p_object_,
+                                           struct vlc_http_mgr *http_mgr)
     : AbstractConnection( p_object_ )
 {
-    source = new adaptive::http::LibVLCHTTPSource(p_object_, auth->getJar());
+    source = new adaptive::http::LibVLCHTTPSource(http_mgr);
     sourceStream = new ChunksSourceStream(p_object, source);
     stream = nullptr;
     char *psz_useragent = var_InheritString(p_object_, "http-user-agent");
@@ -550,6 +548,13 @@ LibVLCHTTPConnectionFactory::LibVLCHTTPConnectionFactory( AuthStorage *auth )
     : AbstractConnectionFactory()
 {
     authStorage = auth;
+    http_mgr = nullptr;
+}
+
+LibVLCHTTPConnectionFactory::~LibVLCHTTPConnectionFactory()
+{
+    if(http_mgr)
+        vlc_http_mgr_destroy(http_mgr);
 }
 
 AbstractConnection * LibVLCHTTPConnectionFactory::createConnection(vlc_object_t *p_object,
@@ -558,7 +563,11 @@ AbstractConnection * LibVLCHTTPConnectionFactory::createConnection(vlc_object_t
     if((params.getScheme() != "http" && params.getScheme() != "https") ||
        params.getHostname().empty())
         return nullptr;
-    return new LibVLCHTTPConnection(p_object, authStorage);
+    if(http_mgr == nullptr)
+        http_mgr = vlc_http_mgr_create(p_object, authStorage->getJar());
+    if(http_mgr == nullptr)
+        return nullptr;
+    return new LibVLCHTTPConnection(p_object, http_mgr);
 }
 
 StreamUrlConnectionFactory::StreamUrlConnectionFactory()
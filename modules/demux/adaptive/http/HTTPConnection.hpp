@@ -30,6 +30,8 @@
 #include <vlc_common.h>
 #include <string>
 
+struct vlc_http_mgr;
+
 namespace adaptive
 {
     class ChunksSourceStream;
@@ -75,7 +77,7 @@ namespace adaptive
        class LibVLCHTTPConnection : public AbstractConnection
        {
             public:
-               LibVLCHTTPConnection(vlc_object_t *, AuthStorage *);
+               LibVLCHTTPConnection(vlc_object_t *, struct vlc_http_mgr *);
                virtual ~LibVLCHTTPConnection();
                bool    canReuse     (const ConnectionParams &) const override;
                RequestStatus request(const std::string& path,
@@ -123,10 +125,13 @@ namespace adaptive
        {
            public:
                LibVLCHTTPConnectionFactory( AuthStorage * );
-               virtual ~LibVLCHTTPConnectionFactory() = default;
+               virtual ~LibVLCHTTPConnectionFactory();
                AbstractConnection * createConnection(vlc_object_t *, const ConnectionParams &) override;
            private:
                AuthStorage *authStorage;
+               /* Shared by all created connections: concurrent requests to an
+                * HTTP/2 origin multiplex over a single coalesced connection */
+               struct vlc_http_mgr *http_mgr;
        };
 
        class StreamUrlConnectionFactory : public AbstractConnectionFactory
@@ -0,0 +1,228 @@
+/*
+ * ExternalAdaptationLogic.cpp
+ *****************************************************************************
+ * Copyright (C) 2026 VideoLAN and VLC Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "ExternalAdaptationLogic.hpp"
+
+#include "../playlist/BaseRepresentation.h"
+#include "../playlist/BaseAdaptationSet.h"
+#include "../tools/Debug.hpp"
+
+#include <vlc_modules.h>
+#include <vlc_tracer.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace adaptive::logic;
+using namespace adaptive;
+
+ExternalAdaptationLogic::ExternalAdaptationLogic(vlc_object_t *obj) :
+    AbstractAdaptationLogic(obj)
+{
+    handle = nullptr;
+    module = nullptr;
+    bpsAvg = 0;
+    dlsize = 0;
+    dllength = 0;
+    vlc_mutex_init(&lock);
+}
+
+ExternalAdaptationLogic::~ExternalAdaptationLogic()
+{
+    if(module)
+    {
+        if(handle->ops->close)
+            handle->ops->close(handle);
+        module_unneed(handle, module);
+    }
+    if(handle)
+        vlc_object_delete(handle);
+}
+
+bool ExternalAdaptationLogic::initialize(const std::string &name)
+{
+    handle = vlc_object_create<vlc_adaptive_logic_t>(p_obj);
+    if(unlikely(handle == nullptr))
+        return false;
+    handle->p_sys = nullptr;
+    handle->ops = nullptr;
+
+    module = module_need(VLC_OBJECT(handle), "adaptive logic",
+                         name.c_str(), true);
+    if(module == nullptr ||
+       handle->ops == nullptr || handle->ops->select == nullptr)
+    {
+        msg_Err(p_obj, "cannot load adaptation logic module '%s'",
+                name.c_str());
+        if(module)
+        {
+            module_unneed(handle, module);
+            module = nullptr;
+        }
+        vlc_object_delete(handle);
+        handle = nullptr;
+        return false;
+    }
+
+    msg_Dbg(p_obj, "using adaptation logic module '%s'", name.c_str());
+    return true;
+}
+
+BaseRepresentation *
+ExternalAdaptationLogic::getNextRepresentation(BaseAdaptationSet *adaptSet,
+                                               BaseRepresentation *currep)
+{
+    if(adaptSet == nullptr)
+        return nullptr;
+
+    /* Apply the device resolution limits here, so logic modules never see
+     * representations they must not pick. */
+    std::vector<BaseRepresentation *> candidates;
+    for(BaseRepresentation *rep : adaptSet->getRepresentations())
+        if(rep->getWidth() <= maxwidth && rep->getHeight() <= maxheight)
+            candidates.push_back(rep);
+    if(candidates.empty())
+        candidates = adaptSet->getRepresentations();
+    if(candidates.empty())
+        return nullptr;
+
+    std::sort(candidates.begin(), candidates.end(),
+              BaseRepresentation::bwCompare);
+
+    /* Keep the id strings alive for the duration of the call */
+    std::vector<std::string> ids;
+    ids.reserve(candidates.size());
+    for(const BaseRepresentation *rep : candidates)
+        ids.push_back(rep->getID().str());
+
+    std::vector<struct vlc_adaptive_rep> reps(candidates.size());
+    for(size_t i = 0; i < candidates.size(); i++)
+    {
+        reps[i].bitrate = candidates[i]->getBandwidth();
+        reps[i].width = candidates[i]->getWidth();
+        reps[i].height = candidates[i]->getHeight();
+        reps[i].id = ids[i].c_str();
+    }
+
+    struct vlc_adaptive_status status;
+    status.reps = reps.data();
+    status.count = reps.size();
+    status.current = -1;
+    for(size_t i = 0; i < candidates.size(); i++)
+        if(candidates[i] == currep)
+            status.current = i;
+
+    vlc_mutex_lock(&lock);
+    status.bandwidth = bpsAvg;
+    /* Adapt on the least filled stream: it is the one at risk */
+    status.buffer_level = VLC_TICK_INVALID;
+    status.buffer_target = VLC_TICK_INVALID;
+    for(const auto &entry : buffering)
+        if(status.buffer_level == VLC_TICK_INVALID ||
+           entry.second.current < status.buffer_level)
+        {
+            status.buffer_level = entry.second.current;
+            status.buffer_target = entry.second.target;
+        }
+    vlc_mutex_unlock(&lock);
+
+    ssize_t choice = handle->ops->select(handle, &status);
+    if(choice >= (ssize_t) status.count)
+    {
+        msg_Warn(p_obj, "adaptation logic module picked out of range "
+                 "representation %zd of %zu", choice, status.count);
+        choice = -1;
+    }
+
+    BaseRepresentation *selected;
+    if(choice >= 0)
+        selected = candidates[choice];
+    else
+        selected = currep ? currep : candidates.front();
+
+    struct vlc_tracer *tracer = vlc_object_get_tracer(p_obj);
+    if(tracer != nullptr)
+        vlc_tracer_Trace(tracer, VLC_TRACE("type", "ABR"),
+                         VLC_TRACE("id", adaptSet->getID().str().c_str()),
+                         VLC_TRACE("bandwidth", (int64_t) status.bandwidth),
+                         VLC_TRACE_TICK_NS("buffer", status.buffer_level),
+                         VLC_TRACE("bitrate", (int64_t) selected->getBandwidth()),
+                         VLC_TRACE("representation",
+                                   selected->getID().str().c_str()),
+                         VLC_TRACE_END);
+    BwDebug(msg_Dbg(p_obj, "picked %s %" PRIu64 " bps (bw %zu buffer %" PRId64
+                    " ms)", selected->getID().str().c_str(),
+                    selected->getBandwidth(), bpsAvg,
+                    MS_FROM_VLC_TICK(status.buffer_level)));
+
+    return selected;
+}
+
+void ExternalAdaptationLogic::updateDownloadRate(const ID &, size_t size,
+                                                 vlc_tick_t time, vlc_tick_t)
+{
+    if(unlikely(time == 0))
+        return;
+    /* Accumulate up to observation window */
+    dllength += time;
+    dlsize += size;
+
+    if(dllength < VLC_TICK_FROM_MS(250))
+        return;
+
+    const size_t bps = CLOCK_FREQ * dlsize * 8 / dllength;
+
+    vlc_mutex_locker locker(&lock);
+    bpsAvg = average.push(bps);
+    dlsize = dllength = 0;
+}
+
+void ExternalAdaptationLogic::trackerEvent(const TrackerEvent &ev)
+{
+    switch(ev.getType())
+    {
+    case TrackerEvent::Type::BufferingStateUpdate:
+        {
+            const BufferingStateUpdatedEvent &event =
+                    static_cast<const BufferingStateUpdatedEvent &>(ev);
+            vlc_mutex_locker locker(&lock);
+            if(!event.enabled)
+                buffering.erase(*event.id);
+        }
+        break;
+
+    case TrackerEvent::Type::BufferingLevelChange:
+        {
+            const BufferingLevelChangedEvent &event =
+                    static_cast<const BufferingLevelChangedEvent &>(ev);
+            vlc_mutex_locker locker(&lock);
+            BufferingLevel &level = buffering[*event.id];
+            level.current = event.current;
+            level.target = event.target;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * ExternalAdaptationLogic.hpp
+ *****************************************************************************
+ * Copyright (C) 2026 VideoLAN and VLC Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifndef EXTERNALADAPTATIONLOGIC_HPP
+#define EXTERNALADAPTATIONLOGIC_HPP
+
+#include "AbstractAdaptationLogic.h"
+#include "vlc_adaptive_logic.h"
+
+#include <vlc_threads.h>
+#include "../tools/MovingAverage.hpp"
+
+#include <map>
+#include <string>
+
+namespace adaptive
+{
+    namespace logic
+    {
+        /* Bridges an "adaptive logic" module (see vlc_adaptive_logic.h)
+         * into the adaptation logic interface: builds the plain C candidate
+         * list for each decision, feeds the module with the smoothed
+         * download rate and buffering level, and traces every decision. */
+        class ExternalAdaptationLogic : public AbstractAdaptationLogic
+        {
+            public:
+                ExternalAdaptationLogic             (vlc_object_t *);
+                virtual ~ExternalAdaptationLogic    ();
+
+                bool initialize(const std::string &name);
+
+                BaseRepresentation *getNextRepresentation(BaseAdaptationSet *,
+                                                          BaseRepresentation *) override;
+                void updateDownloadRate(const ID &, size_t,
+                                        vlc_tick_t, vlc_tick_t) override;
+                void trackerEvent(const TrackerEvent &) override;
+
+            private:
+                vlc_adaptive_logic_t   *handle;
+                module_t               *module;
+
+                MovingAverage<size_t>   average;
+                size_t                  bpsAvg;
+                size_t                  dlsize;
+                vlc_tick_t              dllength;
+
+                struct BufferingLevel
+                {
+                    vlc_tick_t current;
+                    vlc_tick_t target;
+                };
+                std::map<ID, BufferingLevel> buffering;
+
+                mutable vlc_mutex_t     lock;
+        };
+    }
+}
+
+#endif /* EXTERNALADAPTATIONLOGIC_HPP */
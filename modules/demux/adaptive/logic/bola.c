@@ -0,0 +1,123 @@
+/*
+ * bola.c: buffer-based (BOLA) adaptation logic module
+ *****************************************************************************
+ * Copyright (C) 2026 VideoLAN and VLC Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+
+#include "vlc_adaptive_logic.h"
+
+/*
+ * Reference implementation of the "adaptive logic" capability, following
+ * BOLA (Spiteri, Urgaonkar, Sitaraman: "BOLA: Near-Optimal Bitrate
+ * Adaptation for Online Videos"), basic variant: the decision only depends
+ * on the buffering level, not on a bandwidth estimate. Each representation
+ * gets a logarithmic utility relative to the lowest one, and the
+ * representation maximizing (V * (utility + gp) - buffer) / bitrate is
+ * selected. V is derived from the buffering target so that the highest
+ * representation is only sustained at a full buffer; gp trades stability
+ * against quality, larger values holding low representations longer.
+ *
+ * Selected with --adaptive-logic=bola.
+ */
+
+#define BOLA_GP_TEXT N_("BOLA stability factor")
+#define BOLA_GP_LONGTEXT N_("Utility offset added to every quality level. " \
+    "Larger values keep lower qualities until the buffer is more filled, " \
+    "trading quality for rebuffering margin.")
+
+typedef struct
+{
+    double gp;
+} bola_sys_t;
+
+static ssize_t Select(vlc_adaptive_logic_t *logic,
+                      const struct vlc_adaptive_status *status)
+{
+    bola_sys_t *sys = logic->p_sys;
+
+    if (status->count == 1)
+        return 0;
+    if (status->buffer_level == VLC_TICK_INVALID
+     || status->buffer_target == VLC_TICK_INVALID
+     || status->buffer_target <= 0)
+        return -1; /* no buffering info yet: keep the current one */
+
+    const uint64_t base = status->reps[0].bitrate;
+    const double vmax = log((double)status->reps[status->count - 1].bitrate
+                            / base);
+    const double gp = sys->gp;
+    const double V = secf_from_vlc_tick(status->buffer_target) / (vmax + gp);
+    const double buffer = secf_from_vlc_tick(status->buffer_level);
+
+    ssize_t best = -1;
+    double best_score = 0.;
+
+    for (size_t i = 0; i < status->count; i++)
+    {
+        const double utility = log((double)status->reps[i].bitrate / base);
+        const double score = (V * (utility + gp) - buffer)
+                           / status->reps[i].bitrate;
+
+        if (best < 0 || score > best_score)
+        {
+            best = i;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+static const struct vlc_adaptive_logic_ops ops =
+{
+    .select = Select,
+};
+
+static int Open(vlc_object_t *obj)
+{
+    vlc_adaptive_logic_t *logic = (vlc_adaptive_logic_t *)obj;
+
+    bola_sys_t *sys = vlc_obj_malloc(obj, sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
+    sys->gp = var_InheritFloat(obj, "bola-gp");
+    if (sys->gp <= 0.)
+        sys->gp = 1.;
+
+    logic->p_sys = sys;
+    logic->ops = &ops;
+    return VLC_SUCCESS;
+}
+
+vlc_module_begin()
+    set_shortname(N_("BOLA"))
+    set_description(N_("Buffer-based (BOLA) adaptation logic"))
+    set_subcategory(SUBCAT_INPUT_DEMUX)
+    set_capability("adaptive logic", 0)
+    add_shortcut("bola")
+    set_callback(Open)
+    add_float("bola-gp", 1.0, BOLA_GP_TEXT, BOLA_GP_LONGTEXT)
+vlc_module_end()
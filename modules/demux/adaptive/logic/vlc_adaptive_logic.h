@@ -0,0 +1,85 @@
+/*
+ * vlc_adaptive_logic.h: adaptation logic module capability
+ *****************************************************************************
+ * Copyright (C) 2026 VideoLAN and VLC Authors
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifndef VLC_ADAPTIVE_LOGIC_H
+#define VLC_ADAPTIVE_LOGIC_H 1
+
+#include <vlc_common.h>
+#include <vlc_tick.h>
+
+/**
+ * \defgroup adaptive_logic Adaptation logic modules
+ *
+ * Plug-in interface for adaptive streaming rate adaptation (ABR).
+ *
+ * Modules of capability "adaptive logic" are probed by the adaptive demux
+ * when the --adaptive-logic option names no built-in algorithm: the option
+ * value is used as the module shortcut, so third-party logics can be
+ * deployed and tuned without modifying the demux. The interface is kept to
+ * plain C types on purpose: a logic module only needs this header.
+ *
+ * Candidates above the device resolution limits are filtered out before the
+ * module is consulted. The module is called once per segment decision, from
+ * the downloader thread.
+ */
+
+/** One selectable representation (quality level) */
+struct vlc_adaptive_rep
+{
+    uint64_t bitrate;  /**< required bitrate, in bits per second */
+    int width;         /**< video width, 0 if unknown or not video */
+    int height;        /**< video height, 0 if unknown or not video */
+    const char *id;    /**< opaque identifier, unique within the set */
+};
+
+/** Inputs of one adaptation decision */
+struct vlc_adaptive_status
+{
+    const struct vlc_adaptive_rep *reps; /**< candidates, lowest bitrate first */
+    size_t count;                        /**< number of candidates, > 0 */
+    ssize_t current;          /**< index of the active candidate, -1 if none */
+    uint64_t bandwidth;       /**< smoothed download rate in bits per second,
+                                   0 when no measurement exists yet */
+    vlc_tick_t buffer_level;  /**< currently buffered playback time */
+    vlc_tick_t buffer_target; /**< buffering target of the stream */
+};
+
+typedef struct vlc_adaptive_logic
+{
+    struct vlc_object_t obj;
+    void *p_sys;
+    const struct vlc_adaptive_logic_ops *ops; /**< set by the module open */
+} vlc_adaptive_logic_t;
+
+struct vlc_adaptive_logic_ops
+{
+    /**
+     * Picks the representation of the next segment.
+     *
+     * \return an index into status->reps, or -1 to keep the current
+     *         representation (the lowest one is used if there is none yet)
+     */
+    ssize_t (*select)(vlc_adaptive_logic_t *,
+                      const struct vlc_adaptive_status *status);
+
+    /** Releases the module private data (can be NULL) */
+    void (*close)(vlc_adaptive_logic_t *);
+};
+
+#endif
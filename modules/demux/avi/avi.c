@@ -44,6 +44,8 @@
 #include <vlc_codecs.h>
 #include <vlc_charset.h>
 #include <vlc_arrays.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
 
 #include "libavi.h"
 #include "../rawdv.h"
@@ -236,7 +238,9 @@ static int AVI_PacketNext     ( demux_t * );
 static int AVI_PacketSearch   ( demux_t * );
 
 static void AVI_IndexLoad    ( demux_t * );
-static void AVI_IndexCreate  ( demux_t * );
+static bool AVI_IndexCreate  ( demux_t * );
+static bool AVI_IndexCacheLoad ( demux_t * );
+static void AVI_IndexCacheStore( demux_t * );
 
 static void AVI_ExtractSubtitle( demux_t *, unsigned int i_stream, avi_chunk_list_t *, avi_chunk_STRING_t * );
 static avi_track_t * AVI_GetVideoTrackForXsub( demux_sys_t * );
@@ -776,7 +780,8 @@ static int Open( vlc_object_t * p_this )
 aviindex:
         if( p_sys->b_fastseekable )
         {
-            AVI_IndexCreate( p_demux );
+            if( AVI_IndexCreate( p_demux ) )
+                AVI_IndexCacheStore( p_demux );
         }
         else if( p_sys->b_seekable )
         {
@@ -792,6 +797,7 @@ aviindex:
         AVI_IndexLoad( p_demux );
     }
 
+aviindex_cached:
     /* *** movie length in vlc_tick_t *** */
     p_sys->i_length = AVI_MovieGetLength( p_demux );
 
@@ -815,6 +821,13 @@ aviindex:
                 b_index = true;
                 goto aviindex;
             }
+            /* A previous run already paid for the full scan: reuse it
+             * instead of scanning again (or bothering the user) */
+            if( AVI_IndexCacheLoad( p_demux ) )
+            {
+                b_index = true;
+                goto aviindex_cached;
+            }
             if( i_do_index == 0 )
             {
                 const char *psz_msg = _(
@@ -2750,7 +2763,7 @@ static void AVI_IndexLoad( demux_t *p_demux )
     }
 }
 
-static void AVI_IndexCreate( demux_t *p_demux )
+static bool AVI_IndexCreate( demux_t *p_demux )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
 
@@ -2759,6 +2772,7 @@ static void AVI_IndexCreate( demux_t *p_demux )
 
     unsigned int i_stream;
     uint32_t i_movi_end;
+    bool b_complete = true;
 
     vlc_tick_t i_dialog_update;
     vlc_dialog_id *p_dialog_id = NULL;
@@ -2769,7 +2783,7 @@ static void AVI_IndexCreate( demux_t *p_demux )
     if( !p_movi )
     {
         msg_Err( p_demux, "cannot find p_movi" );
-        return;
+        return false;
     }
 
     for( i_stream = 0; i_stream < p_sys->i_track; i_stream++ )
@@ -2800,7 +2814,10 @@ static void AVI_IndexCreate( demux_t *p_demux )
         if( p_dialog_id != NULL && vlc_tick_now() - i_dialog_update > VLC_TICK_FROM_MS(100) )
         {
             if( vlc_dialog_is_cancelled( p_demux, p_dialog_id ) )
+            {
+                b_complete = false; /* don't cache a user-truncated index */
                 break;
+            }
 
             double f_current = vlc_stream_Tell( p_demux->s );
             double f_size    = stream_Size( p_demux->s );
@@ -2878,6 +2895,192 @@ print_stat:
         msg_Dbg( p_demux, "stream[%d] creating %d index entries",
                 i_stream, p_sys->track[i_stream]->idx.i_size );
     }
+    return b_complete;
+}
+
+/*****************************************************************************
+ * Sidecar index cache: a recreated index is persisted in the user cache
+ * directory, keyed by the file URL, so that later opens of the same
+ * (unchanged) file do not pay for the full LIST-movi scan again.
+ *****************************************************************************/
+#define AVIINDEX_CACHE_MAGIC   "VLCAVIX1"
+#define AVIINDEX_CACHE_MAXENTRIES (UINT32_C(1) << 26) /* sanity bound */
+
+static char *AVI_IndexCachePath( demux_t *p_demux )
+{
+    /* FNV-1a of the URL; the cache is per user and per machine, no
+     * stronger key is needed (content changes are caught by the size
+     * check on load) */
+    uint64_t i_hash = UINT64_C(0xcbf29ce484222325);
+    for( const char *p = p_demux->psz_url; p && *p; p++ )
+    {
+        i_hash ^= (unsigned char)*p;
+        i_hash *= UINT64_C(0x100000001b3);
+    }
+
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir == NULL )
+        return NULL;
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s" DIR_SEP "aviindex" DIR_SEP "%016" PRIx64,
+                  psz_dir, i_hash ) == -1 )
+        psz_path = NULL;
+    free( psz_dir );
+    return psz_path;
+}
+
+static bool AVI_IndexCacheLoad( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    const int64_t i_size = stream_Size( p_demux->s );
+    bool b_loaded = false;
+
+    if( i_size <= 0 )
+        return false;
+
+    char *psz_path = AVI_IndexCachePath( p_demux );
+    if( psz_path == NULL )
+        return false;
+
+    FILE *p_stream = vlc_fopen( psz_path, "rb" );
+    if( p_stream == NULL )
+    {
+        free( psz_path );
+        return false;
+    }
+
+    assert( p_sys->i_track <= 100 );
+    avi_index_t p_index[p_sys->i_track];
+    for( unsigned i = 0; i < p_sys->i_track; i++ )
+        avi_index_Init( &p_index[i] );
+
+    char magic[8];
+    uint64_t i_stored_size, i_lastchunk_pos;
+    uint32_t i_tracks;
+    if( fread( magic, 1, 8, p_stream ) != 8 ||
+        memcmp( magic, AVIINDEX_CACHE_MAGIC, 8 ) ||
+        fread( &i_stored_size, sizeof(i_stored_size), 1, p_stream ) != 1 ||
+        i_stored_size != (uint64_t)i_size ||
+        fread( &i_lastchunk_pos, sizeof(i_lastchunk_pos), 1, p_stream ) != 1 ||
+        fread( &i_tracks, sizeof(i_tracks), 1, p_stream ) != 1 ||
+        i_tracks != p_sys->i_track )
+        goto invalid;
+
+    for( unsigned i = 0; i < p_sys->i_track; i++ )
+    {
+        uint32_t i_count;
+        if( fread( &i_count, sizeof(i_count), 1, p_stream ) != 1 ||
+            i_count > AVIINDEX_CACHE_MAXENTRIES )
+            goto invalid;
+        if( i_count == 0 )
+            continue;
+
+        p_index[i].p_entry = vlc_alloc( i_count, sizeof(avi_entry_t) );
+        if( p_index[i].p_entry == NULL )
+            goto invalid;
+        p_index[i].i_size = p_index[i].i_max = i_count;
+
+        if( fread( p_index[i].p_entry, sizeof(avi_entry_t), i_count,
+                   p_stream ) != i_count )
+            goto invalid;
+    }
+
+    for( unsigned i = 0; i < p_sys->i_track; i++ )
+    {
+        free( p_sys->track[i]->idx.p_entry );
+        p_sys->track[i]->idx = p_index[i];
+        msg_Dbg( p_demux, "stream[%u] loaded %d cached index entries",
+                 i, p_index[i].i_size );
+    }
+    p_sys->i_movi_lastchunk_pos = i_lastchunk_pos;
+    b_loaded = true;
+    goto out;
+
+invalid:
+    for( unsigned i = 0; i < p_sys->i_track; i++ )
+        avi_index_Clean( &p_index[i] );
+out:
+    fclose( p_stream );
+    if( !b_loaded ) /* stale or corrupted sidecar: drop it */
+        vlc_unlink( psz_path );
+    free( psz_path );
+    return b_loaded;
+}
+
+static void AVI_IndexCacheStore( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    const int64_t i_size = stream_Size( p_demux->s );
+
+    if( i_size <= 0 )
+        return;
+
+    /* Nothing worth caching */
+    uint64_t i_entries = 0;
+    for( unsigned i = 0; i < p_sys->i_track; i++ )
+        i_entries += p_sys->track[i]->idx.i_size;
+    if( i_entries == 0 )
+        return;
+
+    char *psz_path = AVI_IndexCachePath( p_demux );
+    if( psz_path == NULL )
+        return;
+
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir != NULL )
+    {
+        char *psz_subdir;
+        if( asprintf( &psz_subdir, "%s" DIR_SEP "aviindex", psz_dir ) != -1 )
+        {
+            vlc_mkdir( psz_dir, 0700 );
+            vlc_mkdir( psz_subdir, 0700 );
+            free( psz_subdir );
+        }
+        free( psz_dir );
+    }
+
+    char *psz_tmp;
+    if( asprintf( &psz_tmp, "%s.tmp", psz_path ) == -1 )
+    {
+        free( psz_path );
+        return;
+    }
+
+    FILE *p_stream = vlc_fopen( psz_tmp, "wb" );
+    if( p_stream != NULL )
+    {
+        const uint64_t i_stored_size = i_size;
+        const uint64_t i_lastchunk_pos = p_sys->i_movi_lastchunk_pos;
+        const uint32_t i_tracks = p_sys->i_track;
+        bool b_ok = fwrite( AVIINDEX_CACHE_MAGIC, 1, 8, p_stream ) == 8 &&
+            fwrite( &i_stored_size, sizeof(i_stored_size), 1, p_stream ) == 1 &&
+            fwrite( &i_lastchunk_pos, sizeof(i_lastchunk_pos), 1, p_stream ) == 1 &&
+            fwrite( &i_tracks, sizeof(i_tracks), 1, p_stream ) == 1;
+
+        for( unsigned i = 0; b_ok && i < p_sys->i_track; i++ )
+        {
+            const avi_index_t *p_idx = &p_sys->track[i]->idx;
+            const uint32_t i_count = p_idx->i_size;
+            b_ok = fwrite( &i_count, sizeof(i_count), 1, p_stream ) == 1 &&
+                ( i_count == 0 ||
+                  fwrite( p_idx->p_entry, sizeof(avi_entry_t), i_count,
+                          p_stream ) == i_count );
+        }
+
+        b_ok &= fclose( p_stream ) == 0;
+        if( b_ok )
+        {
+            if( vlc_rename( psz_tmp, psz_path ) == 0 )
+                msg_Dbg( p_demux, "stored index sidecar %s", psz_path );
+            else
+                vlc_unlink( psz_tmp );
+        }
+        else
+            vlc_unlink( psz_tmp );
+    }
+    free( psz_tmp );
+    free( psz_path );
 }
 
 /* */
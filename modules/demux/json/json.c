@@ -124,6 +124,185 @@ char *json_unescape(const char *in, size_t inlen)
     return ret;
 }
 
+#include "grammar.h"
+
+extern int jsonlex_init_extra(const void *, void **);
+extern int jsonlex(JSONSTYPE *value, void *scanner);
+extern int jsonlex_destroy(void *);
+
+/* Pull parser states. The tokeniser is shared with the tree parser; only the
+ * grammar is reimplemented here, as an explicit state machine whose stack is
+ * the nesting bitmap in struct json_stream. */
+enum {
+    JSON_STATE_VALUE, /* expecting a value */
+    JSON_STATE_ELEM_OR_CLOSE, /* just after '[': value or ']' */
+    JSON_STATE_NAME_OR_CLOSE, /* just after '{': member name or '}' */
+    JSON_STATE_NAME, /* after ',' in an object: member name */
+    JSON_STATE_COLON, /* after a member name: ':' */
+    JSON_STATE_NEXT, /* after a value in a container: ',' or close */
+    JSON_STATE_END, /* after the root value: end of input */
+    JSON_STATE_DONE,
+    JSON_STATE_ERROR,
+};
+
+static enum json_event json_stream_fail(struct json_stream *s,
+                                        const char *msg)
+{
+    json_parse_error(s->opaque, msg);
+    s->state = JSON_STATE_ERROR;
+    return JSON_EVENT_ERROR;
+}
+
+static enum json_event json_stream_scalar(struct json_stream *s,
+                                          enum json_event event)
+{
+    s->state = (s->depth == 0) ? JSON_STATE_END : JSON_STATE_NEXT;
+    return event;
+}
+
+static enum json_event json_stream_push(struct json_stream *s, bool object)
+{
+    if (s->depth >= JSON_STREAM_DEPTH_MAX)
+        return json_stream_fail(s, "too many nested values");
+
+    unsigned char mask = 1u << (s->depth % 8);
+
+    if (object)
+        s->nesting[s->depth / 8] |= mask;
+    else
+        s->nesting[s->depth / 8] &= ~mask;
+
+    s->depth++;
+    s->state = object ? JSON_STATE_NAME_OR_CLOSE : JSON_STATE_ELEM_OR_CLOSE;
+    return object ? JSON_EVENT_OBJECT_START : JSON_EVENT_ARRAY_START;
+}
+
+static enum json_event json_stream_pop(struct json_stream *s,
+                                       enum json_event event)
+{
+    s->depth--;
+    return json_stream_scalar(s, event);
+}
+
+static bool json_stream_in_object(const struct json_stream *s)
+{
+    size_t d = s->depth - 1;
+
+    return (s->nesting[d / 8] & (1u << (d % 8))) != 0;
+}
+
+int json_stream_init(struct json_stream *s, void *opaque)
+{
+    int ret = jsonlex_init_extra(opaque, &s->lexer);
+
+    if (ret)
+        return ret;
+
+    s->opaque = opaque;
+    s->string = NULL;
+    s->state = JSON_STATE_VALUE;
+    s->depth = 0;
+    return 0;
+}
+
+enum json_event json_stream_next(struct json_stream *s)
+{
+    free(s->string);
+    s->string = NULL;
+
+    if (s->state == JSON_STATE_ERROR)
+        return JSON_EVENT_ERROR;
+    if (s->state == JSON_STATE_DONE)
+        return JSON_EVENT_END;
+
+    for (;;) {
+        JSONSTYPE value;
+        int token = jsonlex(&value, s->lexer);
+
+        switch (s->state) {
+            case JSON_STATE_ELEM_OR_CLOSE:
+                if (token == ']')
+                    return json_stream_pop(s, JSON_EVENT_ARRAY_END);
+                /* fall through */
+            case JSON_STATE_VALUE:
+                switch (token) {
+                    case VALUE_NULL:
+                        return json_stream_scalar(s, JSON_EVENT_NULL);
+                    case BOOLEAN:
+                        s->boolean = value.boolean;
+                        return json_stream_scalar(s, JSON_EVENT_BOOLEAN);
+                    case NUMBER:
+                        s->number = value.number;
+                        return json_stream_scalar(s, JSON_EVENT_NUMBER);
+                    case STRING:
+                        if (value.string == NULL)
+                            return json_stream_fail(s, "invalid string");
+                        s->string = value.string;
+                        return json_stream_scalar(s, JSON_EVENT_STRING);
+                    case '{':
+                        return json_stream_push(s, true);
+                    case '[':
+                        return json_stream_push(s, false);
+                }
+                break;
+
+            case JSON_STATE_NAME_OR_CLOSE:
+                if (token == '}')
+                    return json_stream_pop(s, JSON_EVENT_OBJECT_END);
+                /* fall through */
+            case JSON_STATE_NAME:
+                if (token == STRING) {
+                    if (value.string == NULL)
+                        return json_stream_fail(s, "invalid string");
+
+                    s->string = value.string;
+                    s->state = JSON_STATE_COLON;
+                    return JSON_EVENT_MEMBER_NAME;
+                }
+                break;
+
+            case JSON_STATE_COLON:
+                if (token == ':') {
+                    s->state = JSON_STATE_VALUE;
+                    continue;
+                }
+                break;
+
+            case JSON_STATE_NEXT:
+                assert(s->depth > 0);
+
+                if (token == ',') {
+                    s->state = json_stream_in_object(s) ? JSON_STATE_NAME
+                                                        : JSON_STATE_VALUE;
+                    continue;
+                }
+                if (token == '}' && json_stream_in_object(s))
+                    return json_stream_pop(s, JSON_EVENT_OBJECT_END);
+                if (token == ']' && !json_stream_in_object(s))
+                    return json_stream_pop(s, JSON_EVENT_ARRAY_END);
+                break;
+
+            case JSON_STATE_END:
+                if (token == YYEOF) {
+                    s->state = JSON_STATE_DONE;
+                    return JSON_EVENT_END;
+                }
+                break;
+        }
+
+        if (token == STRING)
+            free(value.string);
+
+        return json_stream_fail(s, "syntax error");
+    }
+}
+
+void json_stream_destroy(struct json_stream *s)
+{
+    free(s->string);
+    jsonlex_destroy(s->lexer);
+}
+
 const struct json_value *json_get(const struct json_object *obj,
                                   const char *name)
 {
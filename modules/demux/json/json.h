@@ -68,6 +68,67 @@ char *json_unescape(const char *, size_t);
 int json_parse(void *opaque, struct json_object *result);
 void json_free(struct json_object *);
 
+/*
+ * Streaming (pull) interface.
+ *
+ * json_parse() materialises the whole document, which is fine for API
+ * replies but needs O(document) memory. The pull parser below walks the
+ * token stream instead and reports one event at a time, keeping only the
+ * current scalar and a fixed nesting bitmap, i.e. O(depth) memory, so that
+ * arbitrarily large manifests can be consumed incrementally.
+ *
+ * Unlike json_parse(), any JSON value (not just an object) is accepted as
+ * the document root.
+ */
+
+/** Maximum container nesting depth accepted by the pull parser */
+#define JSON_STREAM_DEPTH_MAX 512
+
+enum json_event {
+    JSON_EVENT_ERROR = -1,
+    JSON_EVENT_END = 0, /**< end of document */
+    JSON_EVENT_NULL,
+    JSON_EVENT_BOOLEAN, /**< see json_stream.boolean */
+    JSON_EVENT_NUMBER, /**< see json_stream.number */
+    JSON_EVENT_STRING, /**< see json_stream.string */
+    JSON_EVENT_MEMBER_NAME, /**< see json_stream.string */
+    JSON_EVENT_OBJECT_START,
+    JSON_EVENT_OBJECT_END,
+    JSON_EVENT_ARRAY_START,
+    JSON_EVENT_ARRAY_END,
+};
+
+struct json_stream {
+    void *lexer;
+    void *opaque;
+    /** Payload of the last STRING or MEMBER_NAME event. Owned by the
+     * parser: valid until the next json_stream_next() call. */
+    char *string;
+    double number; /**< payload of the last NUMBER event */
+    bool boolean; /**< payload of the last BOOLEAN event */
+    unsigned char state;
+    size_t depth;
+    unsigned char nesting[JSON_STREAM_DEPTH_MAX / 8];
+};
+
+/**
+ * Initialises a JSON pull parser.
+ *
+ * \param opaque user data pointer for the json_read() callback
+ * \return 0 on success, an error code otherwise
+ */
+int json_stream_init(struct json_stream *, void *opaque);
+
+/**
+ * Advances to the next document event.
+ *
+ * On syntax error, json_parse_error() is called and JSON_EVENT_ERROR is
+ * returned; all further calls then keep returning JSON_EVENT_ERROR.
+ */
+enum json_event json_stream_next(struct json_stream *);
+
+void json_stream_destroy(struct json_stream *);
+
 const struct json_value *json_get(const struct json_object *obj,
                                   const char *name);
 const struct json_object *json_get_object(const struct json_object *obj,
@@ -294,7 +294,8 @@ bool demux_sys_t::PreparePlayback( virtual_segment_c & new_vsegment )
         p_current_vsegment->CurrentSegment()->ESCreate();
         i_current_title = p_current_vsegment->i_sys_title;
     }
-    if( !p_current_vsegment->CurrentSegment()->b_cues )
+    if( !p_current_vsegment->CurrentSegment()->b_cues &&
+        p_current_vsegment->CurrentSegment()->i_deferred_cues_position < 0 )
         msg_Warn( &p_current_vsegment->CurrentSegment()->sys.demuxer, "no cues/empty cues found->seek won't be precise" );
 
     i_duration = p_current_vsegment->Duration();
@@ -44,6 +44,7 @@ matroska_segment_c::matroska_segment_c( demux_sys_t & demuxer, matroska_iostream
     ,i_seekhead_count(0)
     ,i_seekhead_position(-1)
     ,i_cues_position(-1)
+    ,i_deferred_cues_position(-1)
     ,i_tracks_position(-1)
     ,i_info_position(-1)
     ,i_chapters_position(-1)
@@ -794,10 +795,26 @@ bool matroska_segment_c::LoadSeekHeadItem( const EbmlCallbacks & ClassInfos, int
     return true;
 }
 
+/* Cues referenced by a Seek Head are not loaded during Preload() as that
+ * costs a round-trip to the end of the file; fetch them on first need */
+void matroska_segment_c::EnsureCues()
+{
+    if( b_cues || i_deferred_cues_position < 0 )
+        return;
+
+    int64_t i_pos = i_deferred_cues_position;
+    i_deferred_cues_position = -1;
+
+    msg_Dbg( &sys.demuxer, "loading deferred cues at %" PRId64, i_pos );
+    LoadSeekHeadItem( EBML_INFO(KaxCues), i_pos );
+}
+
 bool matroska_segment_c::Seek( demux_t &demuxer, vlc_tick_t i_absolute_mk_date, vlc_tick_t i_mk_time_offset, bool b_accurate )
 {
     SegmentSeeker::tracks_seekpoint_t seekpoints;
 
+    EnsureCues();
+
     SegmentSeeker::fptr_t i_seek_position = std::numeric_limits<SegmentSeeker::fptr_t>::max();
     vlc_tick_t i_mk_seek_time = -1;
     vlc_tick_t i_mk_date = i_absolute_mk_date - i_mk_time_offset;
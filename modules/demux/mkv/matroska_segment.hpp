@@ -106,6 +106,7 @@ public:
     int                     i_seekhead_count;
     int64_t                 i_seekhead_position;
     int64_t                 i_cues_position;
+    int64_t                 i_deferred_cues_position;
     int64_t                 i_tracks_position;
     int64_t                 i_info_position;
     int64_t                 i_chapters_position;
@@ -147,6 +148,7 @@ public:
     void InformationCreate();
 
     bool Seek( demux_t &, vlc_tick_t i_mk_date, vlc_tick_t i_mk_time_offset, bool b_accurate );
+    void EnsureCues();
 
     int BlockGet( KaxBlock * &, KaxSimpleBlock * &, KaxBlockAdditions * &,
                   bool *, bool *, int64_t *);
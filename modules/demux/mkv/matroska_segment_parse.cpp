@@ -153,7 +153,10 @@ void matroska_segment_c::ParseSeekHead( KaxSeekHead *seekhead )
                 else if( id == EBML_ID(KaxCues) )
                 {
                     msg_Dbg( &sys.demuxer, "|   - cues at %" PRId64, i_pos );
-                    LoadSeekHeadItem( EBML_INFO(KaxCues), i_pos );
+                    if( var_InheritBool( &sys.demuxer, "mkv-preload-cues" ) )
+                        LoadSeekHeadItem( EBML_INFO(KaxCues), i_pos );
+                    else if( i_deferred_cues_position < 0 )
+                        i_deferred_cues_position = i_pos;
                 }
                 else if( id == EBML_ID(KaxInfo) )
                 {
@@ -1538,11 +1541,17 @@ void matroska_segment_c::ParseAttachments( KaxAttachments *attachments )
         try {
             KaxFileData  &img_data     = GetMandatoryChild<KaxFileData>( *attachedFile );
             std::string attached_filename( UTFstring( GetMandatoryChild<KaxFileName>( *attachedFile ) ).GetUTF8() );
-            auto new_attachment = vlc_input_attachment_New( attached_filename.c_str(),
+            /* Hand the payload over instead of holding it twice until the
+             * EBML tree is deleted: libebml malloc()s the buffer and would
+             * free() it from ~EbmlBinary, so it is safe to adopt. */
+            binary *p_img = img_data.GetBuffer();
+            size_t i_img = img_data.GetSize();
+            img_data.SetBuffer( nullptr, 0 );
+            auto new_attachment = vlc_input_attachment_NewFromData( attached_filename.c_str(),
                                                             GetMandatoryChild<KaxMimeType>( *attachedFile ).GetValue().c_str(),
                                                             nullptr,
-                                                            img_data.GetBuffer(),
-                                                            img_data.GetSize() );
+                                                            p_img,
+                                                            i_img );
             if (new_attachment)
             {
                 msg_Dbg( &sys.demuxer, "|   |   - %s (%s)", new_attachment->psz_name,
@@ -82,6 +82,10 @@ vlc_module_begin ()
             N_("Preload clusters"),
             N_("Find all cluster positions by jumping cluster-to-cluster before playback") )
 
+    add_bool( "mkv-preload-cues", false,
+            N_("Preload cues"),
+            N_("Load the cue index during open instead of on the first seek (slower open on network streams)") )
+
     add_shortcut( "mka", "mkv" )
     add_file_extension("mka")
     add_file_extension("mks")
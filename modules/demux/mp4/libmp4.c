@@ -25,6 +25,7 @@
 #endif
 
 #include <vlc_common.h>
+#include <vlc_arena.h>                                /* box node regions */
 #include <vlc_stream.h>                               /* vlc_stream_Peek*/
 #include <vlc_strings.h>                              /* vlc_ascii_tolower */
 
@@ -201,7 +202,14 @@ static uint8_t *mp4_readbox_enter_common( stream_t *s, MP4_Box_t *box,
         goto error;
     }
 
-    box->data.p_payload = calloc( 1, typesize );
+    if( box->p_arena != NULL )
+    {
+        box->data.p_payload = vlc_arena_Alloc( box->p_arena, typesize );
+        if( likely(box->data.p_payload != NULL) )
+            memset( box->data.p_payload, 0, typesize );
+    }
+    else
+        box->data.p_payload = calloc( 1, typesize );
     if( unlikely(box->data.p_payload == NULL) )
         goto error;
 
@@ -395,6 +403,22 @@ static int MP4_PeekBoxHeader( stream_t *p_stream, MP4_Box_t *p_box )
     return 1;
 }
 
+/* Allocates a box node, from the father's memory region when there is one */
+static MP4_Box_t *MP4_BoxAllocNode( MP4_Box_t *p_father )
+{
+    if( p_father && p_father->p_arena )
+        return vlc_arena_Alloc( p_father->p_arena, sizeof(MP4_Box_t) );
+    return malloc( sizeof(MP4_Box_t) );
+}
+
+/* Returns the node memory of a box which failed early (no children, no
+ * payload). Region memory is only reclaimed when the region owner is freed. */
+static void MP4_BoxDiscardNode( MP4_Box_t *p_box )
+{
+    if( p_box->p_arena == NULL )
+        free( p_box );
+}
+
 /*****************************************************************************
  * MP4_ReadBoxRestricted : Reads box from current position
  *****************************************************************************
@@ -439,10 +463,11 @@ static MP4_Box_t *MP4_ReadBoxRestricted( stream_t *p_stream, MP4_Box_t *p_father
     }
 
     /* Everything seems OK */
-    MP4_Box_t *p_box = (MP4_Box_t *) malloc( sizeof(MP4_Box_t) );
+    MP4_Box_t *p_box = MP4_BoxAllocNode( p_father );
     if( !p_box )
         return NULL;
     *p_box = peekbox;
+    p_box->p_arena = p_father ? p_father->p_arena : NULL;
 
     const uint64_t i_next = p_box->i_pos + p_box->i_size;
     p_box->p_father = p_father;
@@ -5381,14 +5406,17 @@ static int MP4_Box_Read_Specific( stream_t *p_stream, MP4_Box_t *p_box, MP4_Box_
 
 static MP4_Box_t *MP4_ReadBoxAllocateCheck( stream_t *p_stream, MP4_Box_t *p_father )
 {
-    MP4_Box_t *p_box = calloc( 1, sizeof( MP4_Box_t ) ); /* Needed to ensure simple on error handler */
+    MP4_Box_t *p_box = MP4_BoxAllocNode( p_father );
     if( p_box == NULL )
         return NULL;
+    /* Zeroing is needed to ensure simple on error handler */
+    memset( p_box, 0, sizeof( MP4_Box_t ) );
+    p_box->p_arena = p_father ? p_father->p_arena : NULL;
 
     if( !MP4_PeekBoxHeader( p_stream, p_box ) )
     {
         msg_Warn( p_stream, "cannot read one box" );
-        free( p_box );
+        MP4_BoxDiscardNode( p_box );
         return NULL;
     }
 
@@ -5396,14 +5424,14 @@ static MP4_Box_t *MP4_ReadBoxAllocateCheck( stream_t *p_stream, MP4_Box_t *p_fat
         p_father->i_pos + p_father->i_size < p_box->i_pos + p_box->i_size )
     {
         msg_Dbg( p_stream, "out of bound child" );
-        free( p_box );
+        MP4_BoxDiscardNode( p_box );
         return NULL;
     }
 
     if( !p_box->i_size )
     {
         msg_Dbg( p_stream, "found an empty box (null size)" );
-        free( p_box );
+        MP4_BoxDiscardNode( p_box );
         return NULL;
     }
     p_box->p_father = p_father;
@@ -5487,8 +5515,48 @@ void MP4_BoxFree( MP4_Box_t *p_box )
     if( p_box->pf_free )
         p_box->pf_free( p_box );
 
-    free( p_box->data.p_payload );
-    free( p_box );
+    if( p_box->p_arena == NULL )
+    {
+        free( p_box->data.p_payload );
+        free( p_box );
+    }
+    else if( p_box->b_arena_owner )
+        /* node and payload memory of the whole tree goes away at once */
+        vlc_arena_Delete( p_box->p_arena );
+}
+
+void MP4_BoxTransferArena( MP4_Box_t *p_root, MP4_Box_t *p_box )
+{
+    if( p_box && p_root->b_arena_owner && p_box->p_arena == p_root->p_arena )
+    {
+        p_root->b_arena_owner = false;
+        p_box->b_arena_owner = true;
+    }
+}
+
+/* Virtual root boxes own a memory region from which the whole box tree
+ * (nodes and fixed-size payloads) is allocated, so that parsing thousands
+ * of tiny boxes does not turn into thousands of malloc()/free() pairs. */
+#define MP4_BOX_ARENA_CHUNK (16 * 1024)
+
+static MP4_Box_t *MP4_BoxNewRoot( void )
+{
+    vlc_arena_t *p_arena = vlc_arena_New( MP4_BOX_ARENA_CHUNK );
+    if( unlikely( p_arena == NULL ) )
+        return NULL;
+
+    MP4_Box_t *p_root = vlc_arena_Alloc( p_arena, sizeof( MP4_Box_t ) );
+    if( unlikely( p_root == NULL ) )
+    {
+        vlc_arena_Delete( p_arena );
+        return NULL;
+    }
+    memset( p_root, 0, sizeof( MP4_Box_t ) );
+    p_root->i_type = ATOM_root;
+    p_root->i_shortsize = 1;
+    p_root->p_arena = p_arena;
+    p_root->b_arena_owner = true;
+    return p_root;
 }
 
 MP4_Box_t *MP4_BoxGetNextChunk( stream_t *s )
@@ -5497,10 +5565,9 @@ MP4_Box_t *MP4_BoxGetNextChunk( stream_t *s )
     MP4_Box_t *p_fakeroot;
     MP4_Box_t *p_tmp_box;
 
-    p_fakeroot = MP4_BoxNew( ATOM_root );
+    p_fakeroot = MP4_BoxNewRoot();
     if( unlikely( p_fakeroot == NULL ) )
         return NULL;
-    p_fakeroot->i_shortsize = 1;
 
     const uint32_t stoplist[] = { ATOM_moov, ATOM_moof, 0 };
     MP4_ReadBoxContainerChildren( s, p_fakeroot, stoplist );
@@ -5530,11 +5597,10 @@ MP4_Box_t *MP4_BoxGetRoot( stream_t *p_stream )
 {
     int i_result;
 
-    MP4_Box_t *p_vroot = MP4_BoxNew( ATOM_root );
+    MP4_Box_t *p_vroot = MP4_BoxNewRoot();
     if( p_vroot == NULL )
         return NULL;
 
-    p_vroot->i_shortsize = 1;
     uint64_t i_size;
     if( vlc_stream_GetSize( p_stream, &i_size ) == 0 )
         p_vroot->i_size = i_size;
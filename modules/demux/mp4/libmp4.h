@@ -1862,6 +1862,8 @@ typedef union MP4_Box_data_s
 
 #define BOXDATA(type) type->data.type
 
+typedef struct vlc_arena vlc_arena_t;
+
 typedef struct MP4_Box_s MP4_Box_t;
 /* the most basic structure */
 struct MP4_Box_s
@@ -1890,6 +1892,10 @@ struct MP4_Box_s
 
     void (*pf_free)( MP4_Box_t *p_box ); /* pointer to free function for this box */
 
+    vlc_arena_t *p_arena;    /* region the node and its payload are allocated
+                                from, NULL for standalone malloc'ed boxes */
+    bool b_arena_owner;      /* set on the single box freeing p_arena */
+
     MP4_Box_data_t   data;   /* union of pointers on extended data depending
                                 on i_type (or i_usertype) */
 };
@@ -1990,6 +1996,15 @@ unsigned MP4_BoxCount( const MP4_Box_t *p_box, const char *psz_fmt, ... );
 
 MP4_Box_t * MP4_BoxExtract( MP4_Box_t **pp_chain, uint32_t i_type );
 
+/*****************************************************************************
+ * MP4_BoxTransferArena: pass ownership of the node memory region from
+ *                       p_root to p_box
+ *****************************************************************************
+ * Must be called when a box extracted with MP4_BoxExtract() is kept after
+ * its (virtual) root is freed with MP4_BoxFree()
+ *****************************************************************************/
+void MP4_BoxTransferArena( MP4_Box_t *p_root, MP4_Box_t *p_box );
+
 /* Internal functions exposed for demuxers */
 int MP4_ReadBoxContainerChildren( stream_t *p_stream, MP4_Box_t *p_container,
                                   const uint32_t stoplist[] );
@@ -1610,6 +1610,108 @@ static uint64_t OverflowCheck( demux_t *p_demux, mp4_track_t *tk,
     return i_samplessize;
 }
 
+#define PREFETCH_MAX_EXTENTS 8
+#define PREFETCH_MAX_SIZE    (16U << 20)
+
+/*****************************************************************************
+ * PrefetchWindow: fetch the next chunk of every track due within the
+ * current demux increment with a single scatter read.
+ *****************************************************************************
+ * Interleaved files make the demuxer hop between track chunks, paying one
+ * seek/read round trip per hop. Gathering the window into one
+ * vlc_stream_ReadVec() call lets the file access serve it with positioned
+ * reads, and costs nothing extra when the operation has to be emulated.
+ *****************************************************************************/
+static void PrefetchWindow( demux_t *p_demux, vlc_tick_t i_nztime )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    struct vlc_stream_extent extents[PREFETCH_MAX_EXTENTS];
+    mp4_track_t *tracks[PREFETCH_MAX_EXTENTS];
+    unsigned i_extents = 0;
+
+    for( unsigned i = 0; i < p_sys->i_tracks &&
+                         i_extents < PREFETCH_MAX_EXTENTS; i++ )
+    {
+        mp4_track_t *tk = &p_sys->track[i];
+        uint32_t i_nb_samples;
+
+        if( !tk->b_ok || !tk->b_selected || MP4_isMetadata( tk ) ||
+            ( tk->i_use_flags & USEAS_CHAPTERS ) ||
+            tk->i_sample >= tk->i_sample_count ||
+            tk->p_prefetch != NULL )
+            continue;
+
+        if( MP4_TrackGetDTSPTS( p_demux, tk, NULL ) > i_nztime + DEMUX_INCREMENT )
+            continue;
+
+        const uint32_t i_size = MP4_TrackGetReadSize( tk, &i_nb_samples );
+        if( i_size == 0 || i_size > PREFETCH_MAX_SIZE )
+            continue;
+
+        block_t *p_block = block_Alloc( i_size );
+        if( !p_block )
+            continue;
+
+        const uint64_t i_pos = MP4_TrackGetPos( tk );
+        tk->p_prefetch = p_block;
+        tk->i_prefetchpos = i_pos;
+
+        /* keep the extents sorted by file offset */
+        unsigned j = i_extents;
+        for( ; j > 0 && extents[j - 1].offset > i_pos; j-- )
+        {
+            extents[j] = extents[j - 1];
+            tracks[j] = tracks[j - 1];
+        }
+        extents[j].offset = i_pos;
+        extents[j].length = i_size;
+        extents[j].buf = p_block->p_buffer;
+        tracks[j] = tk;
+        i_extents++;
+    }
+
+    if( i_extents < 2 ) /* nothing to coalesce */
+    {
+        if( i_extents == 1 )
+        {
+            block_Release( tracks[0]->p_prefetch );
+            tracks[0]->p_prefetch = NULL;
+        }
+        return;
+    }
+
+    const ssize_t i_total = vlc_stream_ReadVec( p_demux->s, extents, i_extents );
+
+    /* Keep only the fully read extents; anything else goes through the
+     * regular seek and read path. */
+    uint64_t i_covered = ( i_total > 0 ) ? (uint64_t)i_total : 0;
+    for( unsigned i = 0; i < i_extents; i++ )
+    {
+        if( i_covered >= extents[i].length )
+            i_covered -= extents[i].length;
+        else
+        {
+            block_Release( tracks[i]->p_prefetch );
+            tracks[i]->p_prefetch = NULL;
+        }
+    }
+}
+
+/* Returns the prefetched chunk if it matches the wanted range, drops it as
+ * stale otherwise (seek or reselection since the prefetch). */
+static block_t * MP4_TrackTakePrefetch( mp4_track_t *tk, uint64_t i_readpos,
+                                        uint32_t i_size )
+{
+    block_t *p_block = tk->p_prefetch;
+    if( p_block == NULL )
+        return NULL;
+    tk->p_prefetch = NULL;
+    if( tk->i_prefetchpos == i_readpos && p_block->i_buffer == i_size )
+        return p_block;
+    block_Release( p_block );
+    return NULL;
+}
+
 /*****************************************************************************
  * Demux: read packet and send them to decoders
  *****************************************************************************
@@ -1649,32 +1751,36 @@ static int DemuxTrack( demux_t *p_demux, mp4_track_t *tk, uint64_t i_readpos,
         i_samplessize = MP4_TrackGetReadSize( tk, &i_nb_samples );
         if( i_samplessize > 0 )
         {
-            block_t *p_block;
+            block_t *p_block =
+                MP4_TrackTakePrefetch( tk, i_readpos, i_samplessize );
 
-            if( vlc_stream_Tell( p_demux->s ) != i_readpos )
+            if( p_block == NULL )
             {
-                if( MP4_Seek( p_demux->s, i_readpos ) != VLC_SUCCESS )
+                if( vlc_stream_Tell( p_demux->s ) != i_readpos )
+                {
+                    if( MP4_Seek( p_demux->s, i_readpos ) != VLC_SUCCESS )
+                    {
+                        msg_Warn( p_demux, "track[0x%x] will be disabled (eof?)"
+                                           ": Failed to seek to %"PRIu64,
+                                  tk->i_track_ID, i_readpos );
+                        MP4_TrackSelect( p_demux, tk, false );
+                        goto end;
+                    }
+                }
+
+                i_samplessize = OverflowCheck( p_demux, tk, i_readpos, i_samplessize );
+
+                /* now read pes */
+                if( !(p_block = vlc_stream_Block( p_demux->s, i_samplessize )) )
                 {
                     msg_Warn( p_demux, "track[0x%x] will be disabled (eof?)"
-                                       ": Failed to seek to %"PRIu64,
-                              tk->i_track_ID, i_readpos );
+                                       ": Failed to read %d bytes sample at %"PRIu64,
+                              tk->i_track_ID, i_samplessize, i_readpos );
                     MP4_TrackSelect( p_demux, tk, false );
                     goto end;
                 }
             }
 
-            i_samplessize = OverflowCheck( p_demux, tk, i_readpos, i_samplessize );
-
-            /* now read pes */
-            if( !(p_block = vlc_stream_Block( p_demux->s, i_samplessize )) )
-            {
-                msg_Warn( p_demux, "track[0x%x] will be disabled (eof?)"
-                                   ": Failed to read %d bytes sample at %"PRIu64,
-                          tk->i_track_ID, i_samplessize, i_readpos );
-                MP4_TrackSelect( p_demux, tk, false );
-                goto end;
-            }
-
             /* !important! Ensure clock is set before sending data */
             if( p_sys->i_pcr == VLC_TICK_INVALID )
             {
@@ -1762,6 +1868,10 @@ static int DemuxMoov( demux_t *p_demux )
     }
 
     const vlc_tick_t i_max_preload = ( p_sys->b_fastseekable ) ? 0 : ( p_sys->b_seekable ) ? DEMUX_TRACK_MAX_PRELOAD : INVALID_PRELOAD;
+
+    if( p_sys->b_seekable )
+        PrefetchWindow( p_demux, i_nztime );
+
     int i_status;
     /* demux up to increment amount of data on every track, or just set pcr if empty data */
     for( ;; )
@@ -1993,6 +2103,7 @@ static int FragSeekLoadFragment( demux_t *p_demux, uint32_t i_moox, stime_t i_mo
         if(!p_vroot)
             return VLC_EGENERIC;
         p_moox = MP4_BoxExtract( &p_vroot->p_first, ATOM_moof );
+        MP4_BoxTransferArena( p_vroot, p_moox );
         MP4_BoxFree( p_vroot );
 
         if(!p_moox)
@@ -4078,6 +4189,9 @@ static void MP4_TrackClean( es_out_t *out, mp4_track_t *p_track )
 
     ASFPacketTrackReset( &p_track->asfinfo );
 
+    if( p_track->p_prefetch )
+        block_Release( p_track->p_prefetch );
+
     free( p_track->context.runs.p_array );
 }
 
@@ -5608,6 +5722,7 @@ static int DemuxFrag( demux_t *p_demux )
                 else
                 {
                     p_sys->context.p_fragment_atom = MP4_BoxExtract( &p_vroot->p_first, p_box->i_type );
+                    MP4_BoxTransferArena( p_vroot, p_sys->context.p_fragment_atom );
 
                     /* Detect and Handle Passive Seek */
                     const uint32_t i_sequence_number = FragGetMoofSequenceNumber( p_sys->context.p_fragment_atom );
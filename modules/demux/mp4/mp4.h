@@ -186,6 +186,10 @@ typedef struct
         int i_temp;
     } context;
 
+    /* scatter-read prefetch (see PrefetchWindow) */
+    block_t         *p_prefetch;    /* next chunk data fetched in advance */
+    uint64_t         i_prefetchpos; /* file offset p_prefetch was read from */
+
     /* ASF packets handling */
     const MP4_Box_t *p_asf;
     vlc_tick_t       i_dts_backup;
@@ -38,6 +38,7 @@
 #include <vlc_codecs.h>
 #include <vlc_input.h>
 
+#include "seekindex.h"
 #include "../../packetizer/a52.h"
 #include "../../packetizer/dts_header.h"
 #include "../../packetizer/mpegaudio.h"
@@ -366,6 +367,7 @@ typedef struct
     float rgf_replay_peak[AUDIO_REPLAY_GAIN_MAX];
 
     sync_table_t mllt;
+    seekindex_t seekindex;
     struct
     {
         size_t i_count;
@@ -436,6 +438,7 @@ static int OpenCommon( demux_t *p_demux,
     p_sys->p_packetized_data = NULL;
     p_sys->chapters.i_current = 0;
     TAB_INIT(p_sys->chapters.i_count, p_sys->chapters.p_entry);
+    SeekIndexInit( &p_sys->seekindex, VLC_TICK_FROM_SEC(2) );
 
     if( vlc_stream_Seek( p_demux->s, p_sys->i_stream_offset ) )
     {
@@ -558,8 +561,21 @@ static int Demux( demux_t *p_demux )
     if( p_block_out )
         p_sys->p_packetized_data = NULL;
     else
+    {
+        const uint64_t i_offset = vlc_stream_Tell( p_demux->s );
         ret = Parse( p_demux, &p_block_out ) ? 0 : 1;
 
+        /* Feed the seek index from the demuxed timestamps */
+        if( p_block_out && i_offset >= p_sys->i_stream_offset )
+        {
+            vlc_tick_t i_time = p_block_out->i_dts != VLC_TICK_INVALID
+                              ? p_block_out->i_dts : p_block_out->i_pts;
+            if( i_time != VLC_TICK_INVALID )
+                SeekIndexAdd( &p_sys->seekindex, i_time - VLC_TICK_0,
+                              i_offset - p_sys->i_stream_offset );
+        }
+    }
+
     /* Update chapter if any */
     IncreaseChapter( p_demux,
                      p_block_out ? p_sys->i_time_offset + p_block_out->i_dts
@@ -752,6 +768,11 @@ static int Control( demux_t *p_demux, int i_query, va_list args )
                 }
             }
 
+            /* Use the index built while demuxing when it covers the target */
+            if( i_time != VLC_TICK_INVALID &&
+                SeekIndexFind( &p_sys->seekindex, &i_time, &i_offset ) )
+                return MovetoTimePos( p_demux, i_time, i_offset );
+
             /* fallback on bitrate / file position seeking */
             i_time = VLC_TICK_INVALID;
             int ret = demux_vaControlHelper( p_demux->s, p_sys->i_stream_offset, -1,
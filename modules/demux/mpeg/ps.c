@@ -34,6 +34,7 @@
 
 #include "pes.h"
 #include "ps.h"
+#include "seekindex.h"
 
 /* TODO:
  *  - re-add pre-scanning.
@@ -95,6 +96,7 @@ typedef struct
     vlc_tick_t  i_current_pts;
     uint64_t    i_start_byte;
     uint64_t    i_lastpack_byte;
+    seekindex_t seekindex;
 
     int         i_aob_mlp_count;
 
@@ -243,6 +245,7 @@ static int OpenCommon( vlc_object_t *p_this, bool b_force )
     p_sys->i_aob_mlp_count = 0;
     p_sys->i_start_byte = i_skip;
     p_sys->i_lastpack_byte = i_skip;
+    SeekIndexInit( &p_sys->seekindex, VLC_TICK_FROM_SEC(2) );
 
     p_sys->b_lost_sync = false;
     p_sys->b_have_pack = false;
@@ -465,6 +468,8 @@ static int Demux( demux_t *p_demux )
             return VLC_DEMUXER_EGENERIC;
     }
 
+    const uint64_t i_pkt_pos = vlc_stream_Tell( p_demux->s );
+
     if( ( p_pkt = ps_pkt_read( p_demux->s ) ) == NULL )
     {
         return VLC_DEMUXER_EOF;
@@ -669,6 +674,11 @@ static int Demux( demux_t *p_demux )
                 if( p_pkt->i_pts > p_sys->i_current_pts )
                 {
                     p_sys->i_current_pts = p_pkt->i_pts;
+                    /* Feed the seek index from the demuxed timestamps */
+                    if( p_sys->b_seekable && p_sys->i_time_track_index >= 0 &&
+                        ps_id_to_tk(i_id) == (unsigned)p_sys->i_time_track_index )
+                        SeekIndexAdd( &p_sys->seekindex, p_pkt->i_pts,
+                                      i_pkt_pos );
                 }
 
                 if( tk->i_next_block_flags )
@@ -804,6 +814,21 @@ static int Control( demux_t *p_demux, int i_query, va_list args )
             {
                 vlc_tick_t i_time = va_arg( args, vlc_tick_t );
                 i_time -= p_sys->tk[p_sys->i_time_track_index].i_first_pts;
+
+                /* Use the index built while demuxing when it covers the
+                 * target, instead of guessing from the byte position */
+                vlc_tick_t i_target = i_time +
+                    p_sys->tk[p_sys->i_time_track_index].i_first_pts;
+                uint64_t i_offset;
+                if( SeekIndexFind( &p_sys->seekindex, &i_target, &i_offset ) &&
+                    vlc_stream_Seek( p_demux->s, i_offset ) == VLC_SUCCESS )
+                {
+                    p_sys->i_current_pts = VLC_TICK_INVALID;
+                    p_sys->i_scr = VLC_TICK_INVALID;
+                    NotifyDiscontinuity( p_sys->tk, p_demux->out );
+                    return VLC_SUCCESS;
+                }
+
                 return demux_SetPosition( p_demux, (double) i_time / p_sys->i_length, false );
             }
             break;
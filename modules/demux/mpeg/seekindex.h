@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * seekindex.h: incremental time to offset seek index
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifndef VLC_MPEG_SEEKINDEX_H
+#define VLC_MPEG_SEEKINDEX_H
+
+/* Incremental time to byte offset index for demuxers without one in the
+ * stream, fed from the demux loop as timestamps are seen. Entries are kept
+ * at a minimum time spacing; when the table fills up it is decimated in
+ * place and the spacing doubled, so memory stays bounded on multi-gigabyte
+ * captures while seeks land within one spacing of the target. */
+
+#define SEEKINDEX_SIZE_MAX 512
+
+typedef struct
+{
+    struct
+    {
+        vlc_tick_t i_time;
+        uint64_t   i_offset;
+    } entry[SEEKINDEX_SIZE_MAX];
+    size_t     i_count;
+    vlc_tick_t i_spacing;
+} seekindex_t;
+
+static inline void SeekIndexInit( seekindex_t *p_si, vlc_tick_t i_spacing )
+{
+    p_si->i_count = 0;
+    p_si->i_spacing = i_spacing;
+}
+
+static inline void SeekIndexAdd( seekindex_t *p_si, vlc_tick_t i_time,
+                                 uint64_t i_offset )
+{
+    if( i_time == VLC_TICK_INVALID )
+        return;
+
+    if( p_si->i_count > 0 )
+    {
+        /* Only keep monotonic entries at the configured spacing */
+        const size_t i_last = p_si->i_count - 1;
+        if( i_time < p_si->entry[i_last].i_time + p_si->i_spacing ||
+            i_offset <= p_si->entry[i_last].i_offset )
+            return;
+    }
+
+    if( p_si->i_count == SEEKINDEX_SIZE_MAX )
+    {
+        /* Decimate in place and double the spacing */
+        for( size_t i = 1; i < SEEKINDEX_SIZE_MAX / 2; i++ )
+            p_si->entry[i] = p_si->entry[i * 2];
+        p_si->i_count = SEEKINDEX_SIZE_MAX / 2;
+        p_si->i_spacing *= 2;
+        if( i_time < p_si->entry[p_si->i_count - 1].i_time + p_si->i_spacing )
+            return;
+    }
+
+    p_si->entry[p_si->i_count].i_time = i_time;
+    p_si->entry[p_si->i_count].i_offset = i_offset;
+    p_si->i_count++;
+}
+
+/* Looks up the last indexed point at or before *pi_time and refines *pi_time
+ * to the time of that point. Fails when the target lies before the first
+ * entry or beyond the indexed part of the stream. */
+static inline bool SeekIndexFind( const seekindex_t *p_si, vlc_tick_t *pi_time,
+                                  uint64_t *pi_offset )
+{
+    if( p_si->i_count == 0 || *pi_time == VLC_TICK_INVALID ||
+        *pi_time < p_si->entry[0].i_time ||
+        *pi_time > p_si->entry[p_si->i_count - 1].i_time + p_si->i_spacing )
+        return false;
+
+    size_t i_low = 0, i_high = p_si->i_count - 1;
+    while( i_low < i_high )
+    {
+        const size_t i_mid = i_low + (i_high - i_low + 1) / 2;
+        if( p_si->entry[i_mid].i_time <= *pi_time )
+            i_low = i_mid;
+        else
+            i_high = i_mid - 1;
+    }
+
+    *pi_time = p_si->entry[i_low].i_time;
+    *pi_offset = p_si->entry[i_low].i_offset;
+    return true;
+}
+
+/* Tightens the byte range [*pi_head, *pi_tail] around i_time using the
+ * indexed points at either side of it. Bounds are only ever narrowed, so
+ * callers can pass the full stream range. */
+static inline void SeekIndexBracket( const seekindex_t *p_si, vlc_tick_t i_time,
+                                     uint64_t *pi_head, uint64_t *pi_tail )
+{
+    for( size_t i = 0; i < p_si->i_count; i++ )
+    {
+        if( p_si->entry[i].i_time <= i_time )
+        {
+            if( p_si->entry[i].i_offset > *pi_head )
+                *pi_head = p_si->entry[i].i_offset;
+        }
+        else
+        {
+            if( p_si->entry[i].i_offset < *pi_tail )
+                *pi_tail = p_si->entry[i].i_offset;
+            break;
+        }
+    }
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include <vlc_access.h>    /* DVB-specific things */
 #include <vlc_demux.h>
 #include <vlc_input.h>
+#include <vlc_atomic.h>
 
 #include "ts_pid.h"
 #include "ts_streams.h"
@@ -118,6 +119,12 @@ static void Close ( vlc_object_t * );
 #define CC_CHECK_LONGTEXT   "Detect discontinuities and drop packet duplicates. " \
                             "(bluRay sources are known broken and have false positives). "
 
+#define INSPECT_TEXT        N_("Inspection mode")
+#define INSPECT_LONGTEXT    N_( \
+    "Only track PSI tables, PCR and packet continuity without creating " \
+    "elementary streams or gathering their payload. Intended for stream " \
+    "monitoring probes that only need bitrate and timing health." )
+
 #define TS_PATFIX_TEXT      "Try to generate PAT/PMT if missing"
 #define TS_SKIP_GHOST_PROGRAM_TEXT "Only create ES on program sending data"
 #define TS_OFFSETFIX_TEXT   "Try to fix too early PCR (or late DTS)"
@@ -158,6 +165,7 @@ vlc_module_begin ()
     add_bool( "ts-split-es", true, SPLIT_ES_TEXT, SPLIT_ES_LONGTEXT )
     add_bool( "ts-seek-percent", false, SEEK_PERCENT_TEXT, SEEK_PERCENT_LONGTEXT )
     add_bool( "ts-cc-check", true, CC_CHECK_TEXT, CC_CHECK_LONGTEXT )
+    add_bool( "ts-inspect", false, INSPECT_TEXT, INSPECT_LONGTEXT )
     add_bool( "ts-pmtfix-waitdata", true, TS_SKIP_GHOST_PROGRAM_TEXT, NULL )
     add_bool( "ts-patfix", true, TS_PATFIX_TEXT, NULL )
     add_bool( "ts-pcr-offsetfix", true, TS_OFFSETFIX_TEXT, NULL )
@@ -194,6 +202,7 @@ static bool GatherPESData( demux_t *p_demux, ts_pid_t *, block_t *, size_t );
 static void ProgramSetPCR( demux_t *p_demux, ts_pmt_t *p_prg, stime_t i_pcr );
 
 static block_t* ReadTSPacket( demux_t *p_demux );
+static void TsFlushPacketSlab( demux_sys_t *p_sys );
 static int SeekToTime( demux_t *p_demux, const ts_pmt_t *, stime_t time );
 static void ReadyQueuesPostSeek( demux_t *p_demux );
 static void PCRHandle( demux_t *p_demux, ts_pid_t *, stime_t );
@@ -510,6 +519,9 @@ static int Open( vlc_object_t *p_this )
     p_sys->b_lowdelay = var_InheritBool( p_demux, "low-delay" );
     p_sys->b_ignore_time_for_positions = var_InheritBool( p_demux, "ts-seek-percent" );
     p_sys->b_cc_check = var_InheritBool( p_demux, "ts-cc-check" );
+    p_sys->b_inspect = var_InheritBool( p_demux, "ts-inspect" );
+    if( p_sys->b_inspect )
+        msg_Dbg( p_demux, "inspection mode: not creating ES" );
 
     p_sys->standard = TS_STANDARD_AUTO;
     char *psz_standard = var_InheritString( p_demux, "ts-standard" );
@@ -537,6 +549,10 @@ static int Open( vlc_object_t *p_this )
     vlc_stream_Control( p_sys->stream, STREAM_CAN_FASTSEEK,
                         &p_sys->b_canfastseek );
 
+    /* On non-seekable (live) streams the stream position is never rewound,
+     * so packets can be batched into slabs without confusing seek logic */
+    p_sys->b_slab_read = !p_sys->b_canseek;
+
     if( !p_sys->b_access_control && var_CreateGetBool( p_demux, "ts-pmtfix-waitdata" ) )
         p_sys->es_creation = DELAY_ES;
     else
@@ -594,6 +610,8 @@ static void Close( vlc_object_t *p_this )
     /* Release all non default pids */
     ts_pid_list_Release( p_demux, &p_sys->pids );
 
+    TsFlushPacketSlab( p_sys );
+
     /* Clear up attachments */
     vlc_dictionary_clear( &p_sys->attachments, FreeDictAttachment, NULL );
 
@@ -626,7 +644,7 @@ static int ChangeKeyCallback( vlc_object_t *p_this, char const *psz_cmd,
 /*****************************************************************************
  * Demux:
  *****************************************************************************/
-static int Demux( demux_t *p_demux )
+static VLC_HOT int Demux( demux_t *p_demux )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
     bool b_wait_es = p_sys->i_pmt_es <= 0;
@@ -723,6 +741,14 @@ static int Demux( demux_t *p_demux )
         case TYPE_STREAM:
             p_sys->b_end_preparse = true;
 
+            if( p_sys->b_inspect )
+            {
+                /* Continuity and PCR were tracked above; skip all the ES
+                 * payload gathering and packetization work */
+                block_Release( p_pkt );
+                break;
+            }
+
             if( p_sys->es_creation == DELAY_ES ) /* No longer delay ES since that pid's program sends data */
             {
                 msg_Dbg( p_demux, "Creating delayed ES" );
@@ -1487,6 +1513,28 @@ static void SendDataChain( demux_t *p_demux, ts_es_t *p_es, block_t *p_chain )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
 
+    /* Common case: a single output es. Fix the flags up in place and hand
+     * the whole chain over in one transaction, so the es_out lock and the
+     * decoder wakeup are only paid once however small the PES payloads. */
+    if( p_chain && p_es->id && !p_es->p_extraes && !p_es->p_next &&
+        p_es->p_program->b_selected )
+    {
+        for( block_t *p_block = p_chain; p_block; p_block = p_block->p_next )
+        {
+            /* clean up any private flag */
+            p_block->i_flags &= ~BLOCK_FLAG_PRIVATE_MASK;
+
+            if( p_sys->b_lowdelay )
+                p_block->i_flags |= BLOCK_FLAG_AU_END;
+        }
+
+        p_chain->i_flags |= p_es->i_next_block_flags;
+        p_es->i_next_block_flags = 0;
+
+        demux_SendBatch( p_demux, p_es->id, p_chain );
+        return;
+    }
+
     while( p_chain )
     {
         block_t *p_block = p_chain;
@@ -1804,6 +1852,89 @@ static void PESDataChainHandle( vlc_object_t *p_obj, void *priv, block_t *p_data
     ParsePESDataChain( (demux_t *)p_obj, (ts_pid_t *) priv, p_data, i_flags, i_appendpcr );
 }
 
+/* Slab pool: packets are read from the stream by batches into a single
+ * allocation carrying its own block headers, so that the demux loop does
+ * not hit the allocator once per 188-byte packet. A slab is freed when
+ * the demux and every outstanding packet block dropped their reference. */
+#define TS_SLAB_PACKETS 64
+
+struct ts_packet
+{
+    block_t b; /* must be first */
+    struct ts_packet_slab *p_slab;
+};
+
+struct ts_packet_slab
+{
+    vlc_atomic_rc_t rc;
+    size_t i_data; /* whole packets worth of payload in data */
+    struct ts_packet pkts[TS_SLAB_PACKETS];
+    uint8_t data[];
+};
+
+static void TsPacketSlabRelease( block_t *p_block )
+{
+    struct ts_packet_slab *p_slab = ((struct ts_packet *)p_block)->p_slab;
+    if( vlc_atomic_rc_dec( &p_slab->rc ) )
+        free( p_slab );
+}
+
+static const struct vlc_block_callbacks ts_packet_slab_cbs =
+{
+    TsPacketSlabRelease,
+};
+
+static void TsFlushPacketSlab( demux_sys_t *p_sys )
+{
+    struct ts_packet_slab *p_slab = p_sys->p_slab;
+    if( p_slab != NULL )
+    {
+        if( vlc_atomic_rc_dec( &p_slab->rc ) )
+            free( p_slab );
+        p_sys->p_slab = NULL;
+    }
+}
+
+static block_t* ReadTSPacketBatch( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    struct ts_packet_slab *p_slab = p_sys->p_slab;
+
+    if( p_slab == NULL || p_sys->i_slab_offset >= p_slab->i_data )
+    {
+        TsFlushPacketSlab( p_sys );
+
+        p_slab = malloc( sizeof(*p_slab)
+                         + TS_SLAB_PACKETS * p_sys->i_packet_size );
+        if( unlikely(p_slab == NULL) )
+            return NULL;
+
+        ssize_t i_read = vlc_stream_Read( p_sys->stream, p_slab->data,
+                                          TS_SLAB_PACKETS * p_sys->i_packet_size );
+        if( i_read < (ssize_t)p_sys->i_packet_size )
+        {
+            /* Nothing left but at most a truncated packet */
+            free( p_slab );
+            return NULL;
+        }
+
+        vlc_atomic_rc_init( &p_slab->rc ); /* the demux's own reference */
+        p_slab->i_data = i_read - (i_read % p_sys->i_packet_size);
+        p_sys->p_slab = p_slab;
+        p_sys->i_slab_offset = 0;
+    }
+
+    struct ts_packet *p_pkt =
+        &p_slab->pkts[p_sys->i_slab_offset / p_sys->i_packet_size];
+    block_Init( &p_pkt->b, &ts_packet_slab_cbs,
+                p_slab->data + p_sys->i_slab_offset, p_sys->i_packet_size );
+    p_pkt->p_slab = p_slab;
+    vlc_atomic_rc_inc( &p_slab->rc );
+    p_sys->i_slab_offset += p_sys->i_packet_size;
+
+    return &p_pkt->b;
+}
+
 static block_t* ReadTSPacket( demux_t *p_demux )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
@@ -1811,7 +1942,9 @@ static block_t* ReadTSPacket( demux_t *p_demux )
     block_t     *p_pkt;
 
     /* Get a new TS packet */
-    if( !( p_pkt = vlc_stream_Block( p_sys->stream, p_sys->i_packet_size ) ) )
+    p_pkt = p_sys->b_slab_read ? ReadTSPacketBatch( p_demux )
+                               : vlc_stream_Block( p_sys->stream, p_sys->i_packet_size );
+    if( !p_pkt )
     {
         int64_t size = stream_Size( p_sys->stream );
         if( size >= 0 && (uint64_t)size == vlc_stream_Tell( p_sys->stream ) )
@@ -1839,6 +1972,8 @@ static block_t* ReadTSPacket( demux_t *p_demux )
     {
         msg_Warn( p_demux, "lost synchro" );
         block_Release( p_pkt );
+        /* Resync scans the stream itself: drop any read-ahead packets */
+        TsFlushPacketSlab( p_sys );
         for( ;; )
         {
             const uint8_t *p_peek;
@@ -1873,7 +2008,9 @@ static block_t* ReadTSPacket( demux_t *p_demux )
             }
         }
         msg_Dbg( p_demux, "resynced at %" PRIu64, vlc_stream_Tell( p_sys->stream ) );
-        if( !( p_pkt = vlc_stream_Block( p_sys->stream, p_sys->i_packet_size ) ) )
+        p_pkt = p_sys->b_slab_read ? ReadTSPacketBatch( p_demux )
+                                   : vlc_stream_Block( p_sys->stream, p_sys->i_packet_size );
+        if( !p_pkt )
         {
             msg_Dbg( p_demux, "eof ?" );
             return NULL;
@@ -1956,6 +2093,7 @@ static inline void FlushESBuffer( ts_stream_t *p_pes )
         p_pes->gather.p_data = NULL;
         p_pes->gather.pp_last = &p_pes->gather.p_data;
         p_pes->gather.i_saved = 0;
+        p_pes->gather.b_flat = false;
         p_pes->gather.i_block_flags = 0;
     }
     if( p_pes->p_proc )
@@ -2021,9 +2159,21 @@ static int SeekToTime( demux_t *p_demux, const ts_pmt_t *p_pmt, stime_t i_scaled
     /* Find the time position by using binary search algorithm. */
     uint64_t i_head_pos = 0;
     uint64_t i_tail_pos = (uint64_t) i_stream_size - p_sys->i_packet_size;
+
     if( i_head_pos >= i_tail_pos )
         return VLC_EGENERIC;
 
+    /* Narrow the search range with the PCR points harvested while
+     * demuxing, so day-long recordings don't bisect the whole file */
+    uint64_t i_bracket_head = i_head_pos, i_bracket_tail = i_tail_pos;
+    SeekIndexBracket( &p_pmt->seekindex, i_scaledtime,
+                      &i_bracket_head, &i_bracket_tail );
+    if( i_bracket_head < i_bracket_tail ) /* stale on shrunken streams */
+    {
+        i_head_pos = i_bracket_head;
+        i_tail_pos = i_bracket_tail;
+    }
+
     bool b_found = false;
     while( (i_head_pos + p_sys->i_packet_size) <= i_tail_pos && !b_found )
     {
@@ -2324,6 +2474,12 @@ static void ProgramSetPCR( demux_t *p_demux, ts_pmt_t *p_pmt, stime_t i_pcr )
         p_pmt->pcr.i_first = i_pcr; // now seen
     }
 
+    /* Harvest a seekpoint so long recordings seek without bitrate guessing */
+    if( p_sys->b_canseek )
+        SeekIndexAdd( &p_pmt->seekindex,
+                      TimeStampWrapAround( p_pmt->pcr.i_first, i_pcr ),
+                      vlc_stream_Tell( p_sys->stream ) );
+
     if ( p_sys->i_pmt_es )
     {
         es_out_Control( p_demux->out, ES_OUT_SET_GROUP_PCR, p_pmt->i_number, FROM_SCALE(i_pcr) );
@@ -2546,7 +2702,7 @@ static void PCRFixHandle( demux_t *p_demux, ts_pmt_t *p_pmt, block_t *p_block )
     }
 }
 
-static block_t * ProcessTSPacket( demux_t *p_demux, ts_pid_t *pid, block_t *p_pkt, int *pi_skip )
+static VLC_HOT block_t * ProcessTSPacket( demux_t *p_demux, ts_pid_t *pid, block_t *p_pkt, int *pi_skip )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
     const uint8_t *p = p_pkt->p_buffer;
@@ -2690,7 +2846,7 @@ static block_t * ProcessTSPacket( demux_t *p_demux, ts_pid_t *pid, block_t *p_pk
     return p_pkt;
 }
 
-static bool GatherPESData( demux_t *p_demux, ts_pid_t *p_pid, block_t *p_pkt, size_t i_skip )
+static VLC_HOT bool GatherPESData( demux_t *p_demux, ts_pid_t *p_pid, block_t *p_pkt, size_t i_skip )
 {
     demux_sys_t *p_sys = p_demux->p_sys;
     ts_pes_parse_callback cb = { .p_obj = VLC_OBJECT(p_demux),
@@ -2764,6 +2920,9 @@ static void DoCreateES( demux_t *p_demux, ts_es_t *p_es, const ts_es_t *p_parent
 {
     demux_sys_t *p_sys = p_demux->p_sys;
 
+    if( p_sys->b_inspect ) /* never materialize ES when only inspecting */
+        return;
+
     for( ; p_es ; p_es = p_es->p_next )
     {
         if( !p_es->id )
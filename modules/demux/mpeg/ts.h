@@ -72,7 +72,14 @@ struct demux_sys_t
     /* how many TS packet we read at once */
     unsigned    i_ts_read;
 
+    /* TS packet slab pool, used on non-seekable streams to batch packet
+     * reads and avoid a heap allocation per 188-byte packet */
+    struct ts_packet_slab *p_slab;
+    unsigned    i_slab_offset;
+    bool        b_slab_read;
+
     bool        b_cc_check;
+    bool        b_inspect; /* PSI/PCR/continuity tracking only, no ES */
     bool        b_ignore_time_for_positions;
 
     ts_standards_e standard;
@@ -121,6 +121,7 @@ static bool ts_pes_Push( ts_pes_parse_callback *cb,
         p_pes->gather.i_data_size = 0;
         p_pes->gather.i_gathered = 0;
         p_pes->gather.i_block_flags = 0;
+        p_pes->gather.b_flat = false;
         p_pes->gather.pp_last = &p_pes->gather.p_data;
         cb->pf_parse( cb->p_obj, cb->priv, p_datachain, i_flags, p_pes->gather.i_append_pcr );
         b_ret = true;
@@ -145,8 +146,40 @@ static bool ts_pes_Push( ts_pes_parse_callback *cb,
         return b_ret;
     }
 
-    block_ChainLastAppend( &p_pes->gather.pp_last, p_pkt );
-    p_pes->gather.i_gathered += p_pkt->i_buffer;
+    if( p_pes->gather.p_data == NULL &&
+        p_pes->gather.i_data_size >= p_pkt->i_buffer )
+    {
+        /* PES length is known up front: assemble into a single presized
+         * buffer so the output path does not need a flattening copy */
+        block_t *p_flat = block_Alloc( p_pes->gather.i_data_size );
+        if( likely(p_flat) )
+        {
+            p_flat->i_buffer = 0;
+            block_ChainLastAppend( &p_pes->gather.pp_last, p_flat );
+            p_pes->gather.b_flat = true;
+        }
+        else
+            p_pes->gather.b_flat = false;
+    }
+
+    if( p_pes->gather.b_flat &&
+        p_pes->gather.i_gathered + p_pkt->i_buffer <= p_pes->gather.i_data_size )
+    {
+        block_t *p_flat = p_pes->gather.p_data;
+        memcpy( &p_flat->p_buffer[p_flat->i_buffer],
+                p_pkt->p_buffer, p_pkt->i_buffer );
+        p_flat->i_buffer += p_pkt->i_buffer;
+        p_pes->gather.i_gathered += p_pkt->i_buffer;
+        block_Release( p_pkt );
+    }
+    else
+    {
+        /* Unknown length, alloc failure, or a buggy encoder overshooting
+         * the announced length (#28649): fall back to chaining */
+        p_pes->gather.b_flat = false;
+        block_ChainLastAppend( &p_pes->gather.pp_last, p_pkt );
+        p_pes->gather.i_gathered += p_pkt->i_buffer;
+    }
 
     if( p_pes->gather.i_data_size > 0 &&
         p_pes->gather.i_gathered >= p_pes->gather.i_data_size )
@@ -42,8 +42,10 @@ void ts_pid_list_Init( ts_pid_list_t *p_list )
     p_list->pp_all = NULL;
     p_list->i_all = 0;
     p_list->i_all_alloc = 0;
-    p_list->i_last_pid = 0;
-    p_list->p_last = NULL;
+    memset( p_list->p_map, 0, sizeof(p_list->p_map) );
+    p_list->p_map[0] = &p_list->pat;
+    p_list->p_map[0x1FFB] = &p_list->base_si;
+    p_list->p_map[0x1FFF] = &p_list->dummy;
 }
 
 void ts_pid_list_Release( demux_t *p_demux, ts_pid_list_t *p_list )
@@ -62,98 +64,39 @@ void ts_pid_list_Release( demux_t *p_demux, ts_pid_list_t *p_list )
     free( p_list->pp_all );
 }
 
-struct searchkey
-{
-    int16_t i_pid;
-    ts_pid_t *const *pp_last;
-};
-
-static int ts_bsearch_searchkey_Compare( const void *key, const void *other )
-{
-    struct searchkey *p_key = (void *)key;
-    ts_pid_t *const *pp_pid = other;
-
-    ts_pid_t *p_pid = *pp_pid;
-    p_key->pp_last = other;
-    return ( p_key->i_pid >= p_pid->i_pid ) ? p_key->i_pid - p_pid->i_pid : -1;
-}
-
 ts_pid_t * ts_pid_Get( ts_pid_list_t *p_list, uint16_t i_pid )
 {
-    switch( i_pid )
-    {
-        case 0:
-            return &p_list->pat;
-        case 0x1FFB:
-            return &p_list->base_si;
-        case 0x1FFF:
-            return &p_list->dummy;
-        default:
-            if( p_list->i_last_pid == i_pid )
-                return p_list->p_last;
-        break;
-    }
-
-    size_t i_index = 0;
-    ts_pid_t *p_pid = NULL;
-
-    if( p_list->pp_all )
-    {
-        struct searchkey pidkey;
-        pidkey.i_pid = i_pid;
-        pidkey.pp_last = NULL;
-
-        ts_pid_t **pp_pidk = bsearch( &pidkey, p_list->pp_all, p_list->i_all,
-                                      sizeof(ts_pid_t *), ts_bsearch_searchkey_Compare );
-        if ( pp_pidk )
-            p_pid = *pp_pidk;
-        else
-            i_index = (pidkey.pp_last - p_list->pp_all); /* Last visited index */
-    }
+    ts_pid_t *p_pid = p_list->p_map[i_pid & 0x1FFF];
+    if( likely(p_pid != NULL) )
+        return p_pid;
 
-    if( p_pid == NULL )
+    /* First packet ever on this pid: allocate its state.
+     * pp_all only keeps the allocated ones for iteration/release. */
+    if( p_list->i_all >= p_list->i_all_alloc )
     {
-        if( p_list->i_all >= p_list->i_all_alloc )
-        {
-            ts_pid_t **p_realloc = realloc( p_list->pp_all,
-                                            (p_list->i_all_alloc + PID_ALLOC_CHUNK) * sizeof(ts_pid_t *) );
-            if( !p_realloc )
-            {
-                abort();
-                //return NULL;
-            }
-            p_list->pp_all = p_realloc;
-            p_list->i_all_alloc += PID_ALLOC_CHUNK;
-        }
-
-        p_pid = calloc( 1, sizeof(*p_pid) );
-        if( !p_pid )
+        ts_pid_t **p_realloc = realloc( p_list->pp_all,
+                                        (p_list->i_all_alloc + PID_ALLOC_CHUNK) * sizeof(ts_pid_t *) );
+        if( !p_realloc )
         {
             abort();
             //return NULL;
         }
+        p_list->pp_all = p_realloc;
+        p_list->i_all_alloc += PID_ALLOC_CHUNK;
+    }
 
-        p_pid->i_cc  = 0xff;
-        p_pid->i_pid = i_pid;
-
-        /* Do insertion based on last bsearch mid point */
-        if( p_list->i_all )
-        {
-            if( p_list->pp_all[i_index]->i_pid < i_pid )
-                i_index++;
-
-            memmove( &p_list->pp_all[i_index + 1],
-                    &p_list->pp_all[i_index],
-                    (p_list->i_all - i_index) * sizeof(ts_pid_t *) );
-        }
-
-        p_list->pp_all[i_index] = p_pid;
-        p_list->i_all++;
-
+    p_pid = calloc( 1, sizeof(*p_pid) );
+    if( !p_pid )
+    {
+        abort();
+        //return NULL;
     }
 
-    p_list->p_last = p_pid;
-    p_list->i_last_pid = i_pid;
+    p_pid->i_cc  = 0xff;
+    p_pid->i_pid = i_pid;
+
+    p_list->pp_all[p_list->i_all++] = p_pid;
+    p_list->p_map[i_pid & 0x1FFF] = p_pid;
 
     return p_pid;
 }
@@ -95,10 +95,9 @@ struct ts_pid_list_t
     ts_pid_t **pp_all;
     int        i_all;
     int        i_all_alloc;
-    /* last recently used */
-    uint16_t   i_last_pid;
-    ts_pid_t  *p_last;
-
+    /* flat per-PID dispatch table, NULL for never seen pids.
+     * One packet lookup = one indexed load, no search. */
+    ts_pid_t  *p_map[8192];
 };
 
 /* opacified pid list */
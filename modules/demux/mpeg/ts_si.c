@@ -749,14 +749,13 @@ static void ARIB_CDT_RawCallback( dvbpsi_t *p_handle, const dvbpsi_psi_section_t
                         if( !vlc_dictionary_has_key( &p_sys->attachments, psz_name ) &&
                             ts_arib_inject_png_palette( &p_dmb[7], i_size, &p_png, &i_png ) )
                         {
-                            input_attachment_t *p_att = vlc_input_attachment_New(
+                            input_attachment_t *p_att = vlc_input_attachment_NewFromData(
                                                         psz_name, "image/png", NULL, p_png, i_png );
                             if( p_att )
                             {
                                 vlc_dictionary_insert( &p_sys->attachments, psz_name, p_att );
                                 p_sys->updates |= INPUT_UPDATE_META;
                             }
-                            free( p_png );
                         }
                         free( psz_name );
                     }
@@ -118,6 +118,8 @@ ts_pmt_t *ts_pmt_New( demux_t *p_demux )
 
     pmt->pcr.b_fix_done = false;
 
+    SeekIndexInit( &pmt->seekindex, TO_SCALE_NZ(VLC_TICK_FROM_SEC(2)) );
+
     pmt->eit.i_event_length = 0;
     pmt->eit.i_event_start = 0;
 
@@ -269,6 +271,7 @@ ts_stream_t *ts_stream_New( demux_t *p_demux, ts_pmt_t *p_program )
     pes->gather.p_data = NULL;
     pes->gather.pp_last = &pes->gather.p_data;
     pes->gather.i_saved = 0;
+    pes->gather.b_flat = false;
     pes->gather.i_block_flags = 0;
     pes->gather.i_append_pcr = VLC_TICK_INVALID;
     pes->b_broken_PUSI_conformance = false;
@@ -24,6 +24,7 @@ typedef struct ts_sections_processor_t ts_sections_processor_t;
 
 #include "mpeg4_iod.h"
 #include "timestamps.h"
+#include "seekindex.h"
 
 #include <vlc_common.h>
 #include <vlc_arrays.h>
@@ -68,6 +69,10 @@ struct ts_pmt_t
         bool    b_fix_done;
     } pcr;
 
+    /* PCR to byte offset points harvested while demuxing, in scaled
+     * (90kHz) time units relative to pcr.i_first wraparound */
+    seekindex_t seekindex;
+
     struct
     {
         time_t i_event_start;
@@ -131,6 +136,7 @@ struct ts_stream_t
         block_t     **pp_last;
         uint8_t     saved[5];
         size_t      i_saved;
+        bool        b_flat; /* assembling into a single presized buffer */
         stime_t     i_append_pcr;
         uint32_t    i_block_flags;
     } gather;
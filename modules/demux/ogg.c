@@ -528,6 +528,20 @@ static int Demux( demux_t * p_demux )
             {
                 continue;
             }
+
+            /* Feed the seek index from the pages we demux anyway: the granule
+             * gives the time, and the page start is a sync point a future
+             * bisection can reuse as a bound. */
+            if( ogg_page_granulepos( &p_sys->current_page ) > 0 )
+            {
+                int64_t i_pagepos = vlc_stream_Tell( p_demux->s )
+                                  - ( p_sys->oy.fill - p_sys->oy.returned )
+                                  - p_sys->current_page.header_len
+                                  - p_sys->current_page.body_len;
+                if( i_pagepos >= p_stream->i_data_start )
+                    Oggseek_RecordSample( p_demux, p_stream, i_pagepos,
+                                          ogg_page_granulepos( &p_sys->current_page ) );
+            }
         }
 
 
@@ -2387,6 +2401,7 @@ static void Ogg_LogicalStreamInit( logical_stream_t *p_stream )
     p_stream->i_first_frame_index = 1;
     p_stream->page_type = OGGPAGE_OTHER;
     date_Set( &p_stream->dts, VLC_TICK_INVALID );
+    p_stream->i_idx_last_sample = VLC_TICK_INVALID;
     p_stream->b_initializing = true;
     p_stream->b_contiguous = true; /* default */
     p_stream->queue.pp_append = &p_stream->queue.p_blocks;
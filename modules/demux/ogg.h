@@ -102,6 +102,9 @@ typedef struct logical_stream_s
     /* keyframe index for seeking, created as we discover keyframes */
     demux_index_entry_t *idx;
 
+    /* time of the last sample recorded into the seek index */
+    vlc_tick_t i_idx_last_sample;
+
     /* Skeleton data */
     ogg_skeleton_t *p_skel;
 
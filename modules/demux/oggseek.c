@@ -121,6 +121,41 @@ const demux_index_entry_t *OggSeek_IndexAdd ( logical_stream_t *p_stream,
     return ie;
 }
 
+/* minimum time distance between two index entries, to keep the index sparse */
+static vlc_tick_t index_interval( const demux_sys_t *p_sys )
+{
+    return p_sys->i_length
+         ? vlc_tick_from_sec( ceil( sqrt( SEC_FROM_VLC_TICK( p_sys->i_length ) ) / 2 ) )
+         : vlc_tick_from_sec( 5 );
+}
+
+/* Learn a granulepos -> byte offset sample from a page seen during regular
+   playback or while bisecting, so that the next bisection starts from narrow
+   bounds instead of the whole file. Only streams for which any page is a
+   valid entry point are sampled; a video page can lie in the middle of a
+   GOP and must not become a seek target. */
+void Oggseek_RecordSample ( demux_t *p_demux, logical_stream_t *p_stream,
+                            int64_t i_pagepos, int64_t i_granule )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+
+    if ( Ogg_GetKeyframeGranule( p_stream, i_granule ) != i_granule )
+        return;
+
+    vlc_tick_t i_timestamp = Ogg_GranuleToTime( p_stream, i_granule,
+                                                !p_stream->b_contiguous, false );
+    /* negative timestamps happen due to preskip with some codecs */
+    if ( i_timestamp == VLC_TICK_INVALID || i_timestamp < 0 )
+        return;
+
+    if ( p_stream->i_idx_last_sample != VLC_TICK_INVALID &&
+         llabs( i_timestamp - p_stream->i_idx_last_sample ) < index_interval( p_sys ) )
+        return;
+
+    if ( OggSeek_IndexAdd( p_stream, i_timestamp, i_pagepos ) )
+        p_stream->i_idx_last_sample = i_timestamp;
+}
+
 static bool OggSeekIndexFind ( logical_stream_t *p_stream, vlc_tick_t i_timestamp,
                                int64_t *pi_pos_lower, int64_t *pi_pos_upper,
                                vlc_tick_t *pi_lower_timestamp )
@@ -667,6 +702,7 @@ static int64_t OggBisectSearchByTime( demux_t *p_demux, logical_stream_t *p_stre
                                              &current.i_granule );
     if( current.i_granule != -1 )
     {
+        Oggseek_RecordSample( p_demux, p_stream, current.i_pos, current.i_granule );
         current.i_timestamp = Ogg_GranuleToTime( p_stream, current.i_granule,
                                                  !p_stream->b_contiguous, false );
         if( current.i_timestamp <= i_targettime )
@@ -711,7 +747,8 @@ static int64_t OggBisectSearchByTime( demux_t *p_demux, logical_stream_t *p_stre
 
         if ( current.i_pos != -1 && current.i_granule != -1 )
         {
-            /* found a page */
+            /* found a page; remember the probe, it narrows future bisections */
+            Oggseek_RecordSample( p_demux, p_stream, current.i_pos, current.i_granule );
 
             if ( current.i_timestamp <= i_targettime )
             {
@@ -817,11 +854,15 @@ int Oggseek_BlindSeektoAbsoluteTime( demux_t *p_demux, logical_stream_t *p_strea
     /* or search */
     if ( !b_found && b_fastseek )
     {
-        int64_t i_sync_time;
+        int64_t i_sync_time = VLC_TICK_INVALID;
         i_lowerpos = OggBisectSearchByTime( p_demux, p_stream, i_time,
                                             p_stream->i_data_start, p_sys->i_total_bytes,
                                             &i_sync_time );
         b_found = ( i_lowerpos != -1 );
+        /* Remember where that time sits so the next seek around it
+           does not bisect again */
+        if ( b_found )
+            OggSeek_IndexAdd( p_stream, i_sync_time, i_lowerpos );
     }
 
     if ( !b_found ) return -1;
@@ -926,10 +967,8 @@ int Oggseek_SeektoAbsolutetime( demux_t *p_demux, logical_stream_t *p_stream,
     }
 
     /* Insert keyframe position into index */
-    vlc_tick_t index_interval = p_sys->i_length
-              ? vlc_tick_from_sec( ceil( sqrt( SEC_FROM_VLC_TICK( p_sys->i_length ) ) / 2 ) )
-              : vlc_tick_from_sec( 5 );
-    if ( i_pagepos >= p_stream->i_data_start && ( i_sync_time - i_lower_index >= index_interval ) )
+    if ( i_pagepos >= p_stream->i_data_start &&
+         ( i_sync_time - i_lower_index >= index_interval( p_sys ) ) )
         OggSeek_IndexAdd( p_stream, i_sync_time, i_pagepos );
 
     OggDebug( msg_Dbg( p_demux, "=================== Seeked To %"PRId64" time %"PRId64, i_pagepos, i_time ) );
@@ -947,7 +986,7 @@ int Oggseek_SeektoAbsolutetime( demux_t *p_demux, logical_stream_t *p_stream,
 int64_t oggseek_read_page( demux_t *p_demux )
 {
     demux_sys_t *p_ogg = p_demux->p_sys  ;
-    uint8_t header[PAGE_HEADER_BYTES+255];
+    const uint8_t *p_peek;
     int i_nsegs;
     int i;
     int64_t i_in_pos;
@@ -965,18 +1004,21 @@ int64_t oggseek_read_page( demux_t *p_demux )
         return 0;
     }
 
-    if ( vlc_stream_Read ( p_demux->s, header, PAGE_HEADER_BYTES ) < PAGE_HEADER_BYTES )
+    /* Peek the header and the lacing table to learn the full page size, so
+       the page can be pulled in a single read instead of three. This matters
+       when bisecting over HTTP, where each read can be a range request. */
+    i_result = vlc_stream_Peek ( p_demux->s, &p_peek, PAGE_HEADER_BYTES + 255 );
+
+    if ( i_result < PAGE_HEADER_BYTES )
     {
-        vlc_stream_Seek( p_demux->s, i_in_pos );
         msg_Dbg ( p_demux, "Reached clean EOF in ogg file" );
         return 0;
     }
 
-    i_nsegs = header[ PAGE_HEADER_BYTES - 1 ];
+    i_nsegs = p_peek[ PAGE_HEADER_BYTES - 1 ];
 
-    if ( vlc_stream_Read ( p_demux->s, header+PAGE_HEADER_BYTES, i_nsegs ) < i_nsegs )
+    if ( i_result < PAGE_HEADER_BYTES + i_nsegs )
     {
-        vlc_stream_Seek( p_demux->s, i_in_pos );
         msg_Warn ( p_demux, "Reached broken EOF in ogg file" );
         return 0;
     }
@@ -985,7 +1027,7 @@ int64_t oggseek_read_page( demux_t *p_demux )
 
     for ( i = 0; i < i_nsegs; i++ )
     {
-        i_page_size += header[ PAGE_HEADER_BYTES + i ];
+        i_page_size += p_peek[ PAGE_HEADER_BYTES + i ];
     }
 
     ogg_sync_reset( &p_ogg->oy );
@@ -994,15 +1036,9 @@ int64_t oggseek_read_page( demux_t *p_demux )
     if( !buf )
         return 0;
 
-    memcpy( buf, header, PAGE_HEADER_BYTES + i_nsegs );
-
-    i_result = vlc_stream_Read ( p_demux->s, (uint8_t*)buf + PAGE_HEADER_BYTES + i_nsegs,
-                             i_page_size - PAGE_HEADER_BYTES - i_nsegs );
-
-    ogg_sync_wrote( &p_ogg->oy, i_result + PAGE_HEADER_BYTES + i_nsegs );
-
-
+    i_result = vlc_stream_Read ( p_demux->s, buf, i_page_size );
 
+    ogg_sync_wrote( &p_ogg->oy, i_result );
 
     if ( ogg_sync_pageout( &p_ogg->oy, &p_ogg->current_page ) != 1 )
     {
@@ -1011,6 +1047,6 @@ int64_t oggseek_read_page( demux_t *p_demux )
         return 0;
     }
 
-    return i_result + PAGE_HEADER_BYTES + i_nsegs;
+    return i_result;
 }
 
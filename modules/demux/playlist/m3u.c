@@ -254,10 +254,15 @@ static int CreateEntry( input_item_node_t *p_node, const struct entry_meta_s *me
     return VLC_SUCCESS;
 }
 
+/* Announce entries in batches while parsing, so the first items of a huge
+ * playlist (IPTV M3Us routinely exceed 100k lines) are playable early */
+#define M3U_ANNOUNCE_BATCH 100
+
 static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
 {
     char       *psz_line;
     char       *psz_group = NULL; /* group is toggling tag */
+    unsigned    i_entries = 0;
     struct entry_meta_s meta;
     entry_meta_Init( &meta );
     char *    (*pf_dup) (const char *) = p_demux->p_sys;
@@ -346,7 +351,9 @@ static int ReadDir( stream_t *p_demux, input_item_node_t *p_subitems )
             meta.psz_mrl = ProcessMRL( psz_parse, p_demux->psz_url );
             free( psz_parse );
 
-            CreateEntry( p_subitems, &meta );
+            if( CreateEntry( p_subitems, &meta ) == VLC_SUCCESS &&
+                ++i_entries % M3U_ANNOUNCE_BATCH == 0 )
+                input_item_node_Flush( p_subitems );
 
             /* Cleanup state after entry */
             entry_meta_Clean( &meta );
@@ -122,6 +122,7 @@ typedef struct
     vlc_tick_t i_stop;
 
     char    *psz_text;
+    uint64_t i_offset; /**< cue byte offset, only set in lazy index mode */
 } subtitle_t;
 
 typedef struct
@@ -172,6 +173,17 @@ typedef struct
         size_t      i_current;
     } subtitles;
 
+    /* Lazy index mode for huge SubRip/SSA files: only cue timestamps and
+     * byte offsets are collected on open, payloads are parsed on demand
+     * around the playback position. */
+    struct
+    {
+        bool        b_active;
+        bool        b_oneline; /* a cue is a single line (SSA/ASS dialogue) */
+        int       (*pf_read)( vlc_object_t *, subs_properties_t *,
+                              text_t *, subtitle_t *, size_t );
+    } lazy;
+
     vlc_tick_t  i_length;
 
     /* */
@@ -236,6 +248,13 @@ static const struct
 static int Demux( demux_t * );
 static int Control( demux_t *, int, va_list );
 
+/* Lazy index mode */
+#define SUB_LAZY_MIN_SIZE  (2u << 20) /* index instead of load above this */
+#define SUB_LAZY_MAX_LINES 512        /* sanity bound for a single cue */
+static int  LazyIndexLoad( demux_t * );
+static int  LazyFetch( demux_t *, size_t, subtitle_t * );
+static int  subtitle_ParseSubRipTiming( subtitle_t *, const char * );
+
 static void Fix( demux_t * );
 static char * get_language_from_filename( const char * );
 
@@ -320,6 +339,10 @@ static int Open ( vlc_object_t *p_this )
     p_sys->subtitles.i_count  = 0;
     p_sys->subtitles.p_array  = NULL;
 
+    p_sys->lazy.b_active  = false;
+    p_sys->lazy.b_oneline = false;
+    p_sys->lazy.pf_read   = NULL;
+
     p_sys->props.psz_header         = NULL;
     p_sys->props.psz_lang           = NULL;
     p_sys->props.i_microsecperframe = VLC_TICK_FROM_MS(40);
@@ -637,37 +660,65 @@ static int Open ( vlc_object_t *p_this )
         return VLC_EGENERIC;
     }
 
-    /* Load the whole file */
-    text_t txtlines;
-    TextLoad( &txtlines, p_demux->s );
+    /* Huge SubRip/SSA files: only index cue timestamps and offsets, and
+     * parse cue payloads on demand around the playback position */
+    bool b_canseek = false;
+    uint64_t i_stream_size;
+    vlc_stream_Control( p_demux->s, STREAM_CAN_SEEK, &b_canseek );
+    if( b_canseek &&
+        vlc_stream_GetSize( p_demux->s, &i_stream_size ) == VLC_SUCCESS &&
+        i_stream_size >= SUB_LAZY_MIN_SIZE &&
+        ( p_sys->props.i_type == SUB_TYPE_SUBRIP ||
+          p_sys->props.i_type == SUB_TYPE_SSA1 ||
+          p_sys->props.i_type == SUB_TYPE_SSA2_4 ||
+          p_sys->props.i_type == SUB_TYPE_ASS ) )
+    {
+        p_sys->lazy.b_active  = true;
+        p_sys->lazy.b_oneline = p_sys->props.i_type != SUB_TYPE_SUBRIP;
+        p_sys->lazy.pf_read   = pf_read;
+
+        if( LazyIndexLoad( p_demux ) != VLC_SUCCESS )
+        {
+            Close( p_this );
+            return VLC_ENOMEM;
+        }
 
-    /* Parse it */
-    for( size_t i_max = 0; i_max < SIZE_MAX - 500 * sizeof(subtitle_t); )
+        msg_Dbg( p_demux, "indexed %zu subtitles", p_sys->subtitles.i_count );
+    }
+    else
     {
-        if( p_sys->subtitles.i_count >= i_max )
+        /* Load the whole file */
+        text_t txtlines;
+        TextLoad( &txtlines, p_demux->s );
+
+        /* Parse it */
+        for( size_t i_max = 0; i_max < SIZE_MAX - 500 * sizeof(subtitle_t); )
         {
-            i_max += 500;
-            subtitle_t *p_realloc = realloc( p_sys->subtitles.p_array, sizeof(subtitle_t) * i_max );
-            if( p_realloc == NULL )
+            if( p_sys->subtitles.i_count >= i_max )
             {
-                TextUnload( &txtlines );
-                Close( p_this );
-                return VLC_ENOMEM;
+                i_max += 500;
+                subtitle_t *p_realloc = realloc( p_sys->subtitles.p_array, sizeof(subtitle_t) * i_max );
+                if( p_realloc == NULL )
+                {
+                    TextUnload( &txtlines );
+                    Close( p_this );
+                    return VLC_ENOMEM;
+                }
+                p_sys->subtitles.p_array = p_realloc;
             }
-            p_sys->subtitles.p_array = p_realloc;
-        }
 
-        if( pf_read( VLC_OBJECT(p_demux), &p_sys->props, &txtlines,
-                     &p_sys->subtitles.p_array[p_sys->subtitles.i_count],
-                     p_sys->subtitles.i_count ) )
-            break;
+            if( pf_read( VLC_OBJECT(p_demux), &p_sys->props, &txtlines,
+                         &p_sys->subtitles.p_array[p_sys->subtitles.i_count],
+                         p_sys->subtitles.i_count ) )
+                break;
 
-        p_sys->subtitles.i_count++;
-    }
-    /* Unload */
-    TextUnload( &txtlines );
+            p_sys->subtitles.i_count++;
+        }
+        /* Unload */
+        TextUnload( &txtlines );
 
-    msg_Dbg(p_demux, "loaded %zu subtitles", p_sys->subtitles.i_count );
+        msg_Dbg(p_demux, "loaded %zu subtitles", p_sys->subtitles.i_count );
+    }
 
     /* *** add subtitle ES *** */
     if( p_sys->props.i_type == SUB_TYPE_SSA1 ||
@@ -858,6 +909,7 @@ static int Demux( demux_t *p_demux )
              p_sys->f_rate ) <= i_barrier )
     {
         const subtitle_t *p_subtitle = &p_sys->subtitles.p_array[p_sys->subtitles.i_current];
+        subtitle_t lazy_subtitle = { .psz_text = NULL };
 
         if ( !p_sys->b_slave && p_sys->b_first_time )
         {
@@ -865,7 +917,17 @@ static int Demux( demux_t *p_demux )
             p_sys->b_first_time = false;
         }
 
-        if( p_subtitle->i_start >= 0 )
+        if( p_sys->lazy.b_active )
+        {
+            /* Parse the cue payload now, only around the playback position */
+            if( LazyFetch( p_demux, p_sys->subtitles.i_current,
+                           &lazy_subtitle ) == VLC_SUCCESS )
+                p_subtitle = &lazy_subtitle;
+            else
+                p_subtitle = NULL;
+        }
+
+        if( p_subtitle && p_subtitle->i_start >= 0 )
         {
             block_t *p_block = p_sys->pf_convert( p_subtitle );
             if( p_block )
@@ -878,6 +940,7 @@ static int Demux( demux_t *p_demux )
                 es_out_Send( p_demux->out, p_sys->es, p_block );
             }
         }
+        free( lazy_subtitle.psz_text );
 
         p_sys->subtitles.i_current++;
     }
@@ -978,6 +1041,124 @@ static void TextPreviousLine( text_t *txt )
         txt->i_line--;
 }
 
+/*****************************************************************************
+ * Lazy index mode
+ *****************************************************************************/
+/* LazyIndexLoad: scan the stream once, keeping only cue timestamps and byte
+ * offsets. For SSA/ASS the real parser is run on each line so header and
+ * language handling stay identical, but the payload is dropped right away. */
+static int LazyIndexLoad( demux_t *p_demux )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    stream_t *s = p_demux->s;
+    size_t i_max = 0;
+
+    for( ;; )
+    {
+        uint64_t i_offset = vlc_stream_Tell( s );
+        char *psz_line = vlc_stream_ReadLine( s );
+        if( psz_line == NULL )
+            break;
+
+        if( p_sys->subtitles.i_count >= i_max )
+        {
+            if( i_max >= SIZE_MAX / sizeof(subtitle_t) - 500 )
+            {
+                free( psz_line );
+                return VLC_ENOMEM;
+            }
+            i_max += 500;
+            subtitle_t *p_realloc = realloc( p_sys->subtitles.p_array,
+                                             sizeof(subtitle_t) * i_max );
+            if( p_realloc == NULL )
+            {
+                free( psz_line );
+                return VLC_ENOMEM;
+            }
+            p_sys->subtitles.p_array = p_realloc;
+        }
+
+        subtitle_t *p_subtitle =
+            &p_sys->subtitles.p_array[p_sys->subtitles.i_count];
+
+        if( p_sys->lazy.b_oneline )
+        {
+            text_t line_txt = { 1, 0, &psz_line };
+
+            if( p_sys->lazy.pf_read( VLC_OBJECT(p_demux), &p_sys->props,
+                                     &line_txt, p_subtitle,
+                                     p_sys->subtitles.i_count ) == VLC_SUCCESS )
+            {
+                free( p_subtitle->psz_text );
+                p_subtitle->psz_text = NULL;
+                p_subtitle->i_offset = i_offset;
+                p_sys->subtitles.i_count++;
+            }
+        }
+        else if( subtitle_ParseSubRipTiming( p_subtitle, psz_line ) == VLC_SUCCESS &&
+                 p_subtitle->i_start < p_subtitle->i_stop )
+        {
+            p_subtitle->psz_text = NULL;
+            p_subtitle->i_offset = i_offset;
+            p_sys->subtitles.i_count++;
+
+            /* Skip the payload so its lines cannot start another cue */
+            for( ;; )
+            {
+                char *psz_payload = vlc_stream_ReadLine( s );
+                if( psz_payload == NULL )
+                    break;
+                bool b_empty = *psz_payload == '\0';
+                free( psz_payload );
+                if( b_empty )
+                    break;
+            }
+        }
+
+        free( psz_line );
+    }
+
+    return VLC_SUCCESS;
+}
+
+/* LazyFetch: re-read one cue from the stream and parse its payload with the
+ * regular parser. The timestamps from the index stay authoritative. */
+static int LazyFetch( demux_t *p_demux, size_t i_idx, subtitle_t *p_out )
+{
+    demux_sys_t *p_sys = p_demux->p_sys;
+    const subtitle_t *p_entry = &p_sys->subtitles.p_array[i_idx];
+
+    if( vlc_stream_Seek( p_demux->s, p_entry->i_offset ) != VLC_SUCCESS )
+        return VLC_EGENERIC;
+
+    char *pp_lines[SUB_LAZY_MAX_LINES];
+    text_t txt = { 0, 0, pp_lines };
+
+    while( txt.i_line_count < SUB_LAZY_MAX_LINES )
+    {
+        char *psz_line = vlc_stream_ReadLine( p_demux->s );
+        if( psz_line == NULL )
+            break;
+        pp_lines[txt.i_line_count++] = psz_line;
+
+        if( p_sys->lazy.b_oneline ||
+            ( txt.i_line_count > 1 && *psz_line == '\0' ) )
+            break;
+    }
+
+    int i_ret = p_sys->lazy.pf_read( VLC_OBJECT(p_demux), &p_sys->props,
+                                     &txt, p_out, i_idx );
+    for( size_t i = 0; i < txt.i_line_count; i++ )
+        free( pp_lines[i] );
+
+    if( i_ret != VLC_SUCCESS )
+        return VLC_EGENERIC;
+
+    p_out->i_start = p_entry->i_start;
+    p_out->i_stop = p_entry->i_stop;
+    return VLC_SUCCESS;
+}
+
 /*****************************************************************************
  * Specific Subtitle function
  *****************************************************************************/
@@ -569,6 +569,10 @@ vlc_module_begin()
     set_description(N_("Direct3D11 deinterlace filter"))
     set_deinterlace_callback( D3D11OpenDeinterlace )
 
+    add_submodule()
+    set_description(N_("Direct3D11 scaler"))
+    set_callback_video_converter( D3D11OpenScaler, 10 )
+
     add_submodule()
     set_callback_video_converter( D3D11OpenConverter, 10 )
 
@@ -33,6 +33,7 @@ extern "C" {
 #endif
 
 int  D3D11OpenDeinterlace(filter_t *);
+int  D3D11OpenScaler(filter_t *);
 int  D3D11OpenConverter(filter_t *);
 int  D3D11OpenCPUConverter(filter_t *);
 int  D3D11OpenBlockDecoder(vlc_object_t *);
@@ -0,0 +1,237 @@
+/*****************************************************************************
+ * d3d11_scaler.c: D3D11 VideoProcessor based scaling filter
+ *****************************************************************************
+ * Copyright © 2026 VLC authors, VideoLAN and VideoLabs
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include <vlc_common.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+
+#define COBJMACROS
+#include <d3d11.h>
+
+#include "d3d11_filters.h"
+#include "d3d11_processor.h"
+#include "../../video_chroma/d3d11_fmt.h"
+
+typedef struct
+{
+    d3d11_device_t                 *d3d_dev;
+    d3d11_processor_t              d3d_proc;
+
+    const d3d_format_t             *output_format;
+} filter_sys_t;
+
+static picture_t *NewOutputPicture( filter_t *p_filter )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    picture_t *pic = D3D11_AllocPicture(VLC_OBJECT(p_filter), &p_filter->fmt_out.video,
+                                        p_filter->vctx_out, false, p_sys->output_format);
+    if (pic == NULL)
+        return NULL;
+
+    picture_sys_d3d11_t *p_out_sys = ActiveD3D11PictureSys(pic);
+
+    D3D11_VIDEO_PROCESSOR_OUTPUT_VIEW_DESC outDesc = {
+        .ViewDimension = D3D11_VPOV_DIMENSION_TEXTURE2D,
+    };
+
+    HRESULT hr;
+    hr = ID3D11VideoDevice_CreateVideoProcessorOutputView(p_sys->d3d_proc.d3dviddev,
+                                                         p_out_sys->resource[0],
+                                                         p_sys->d3d_proc.procEnumerator,
+                                                         &outDesc,
+                                                         &p_out_sys->processorOutput);
+    if (FAILED(hr))
+    {
+        msg_Dbg(p_filter,"Failed to create processor output. (hr=0x%lX)", hr);
+        picture_Release(pic);
+        return NULL;
+    }
+
+    return pic;
+}
+
+static picture_t *Scale(filter_t *p_filter, picture_t *p_pic)
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    picture_t *p_outpic = NULL;
+    HRESULT hr;
+
+    picture_sys_d3d11_t *p_src_sys = ActiveD3D11PictureSys(p_pic);
+    if (unlikely(!p_src_sys))
+        goto error;
+
+    d3d11_device_lock( p_sys->d3d_dev );
+
+    p_outpic = NewOutputPicture( p_filter );
+    if (p_outpic == NULL)
+        goto error_unlock;
+    picture_CopyProperties( p_outpic, p_pic );
+
+    if (FAILED( D3D11_Assert_ProcessorInput(p_filter, &p_sys->d3d_proc, p_src_sys) ))
+        goto error_unlock;
+
+    picture_sys_d3d11_t *p_out_sys = ActiveD3D11PictureSys(p_outpic);
+
+    ID3D11VideoContext_VideoProcessorSetStreamFrameFormat(p_sys->d3d_proc.d3dvidctx, p_sys->d3d_proc.videoProcessor,
+                                                          0, D3D11_VIDEO_FRAME_FORMAT_PROGRESSIVE);
+    ID3D11VideoContext_VideoProcessorSetStreamAutoProcessingMode(p_sys->d3d_proc.d3dvidctx, p_sys->d3d_proc.videoProcessor,
+                                                                 0, FALSE);
+
+    RECT srcRect;
+    srcRect.left   = p_pic->format.i_x_offset;
+    srcRect.top    = p_pic->format.i_y_offset;
+    srcRect.right  = srcRect.left + p_pic->format.i_visible_width;
+    srcRect.bottom = srcRect.top  + p_pic->format.i_visible_height;
+    ID3D11VideoContext_VideoProcessorSetStreamSourceRect(p_sys->d3d_proc.d3dvidctx, p_sys->d3d_proc.videoProcessor,
+                                                         0, TRUE, &srcRect);
+
+    RECT dstRect;
+    dstRect.left   = p_filter->fmt_out.video.i_x_offset;
+    dstRect.top    = p_filter->fmt_out.video.i_y_offset;
+    dstRect.right  = dstRect.left + p_filter->fmt_out.video.i_visible_width;
+    dstRect.bottom = dstRect.top  + p_filter->fmt_out.video.i_visible_height;
+    ID3D11VideoContext_VideoProcessorSetStreamDestRect(p_sys->d3d_proc.d3dvidctx, p_sys->d3d_proc.videoProcessor,
+                                                       0, TRUE, &dstRect);
+
+    D3D11_VIDEO_PROCESSOR_STREAM stream = {0};
+    stream.Enable = TRUE;
+    stream.pInputSurface = p_src_sys->processorInput;
+
+    hr = ID3D11VideoContext_VideoProcessorBlt(p_sys->d3d_proc.d3dvidctx, p_sys->d3d_proc.videoProcessor,
+                                              p_out_sys->processorOutput,
+                                              0, 1, &stream);
+    if (FAILED(hr))
+        goto error_unlock;
+
+    d3d11_device_unlock( p_sys->d3d_dev );
+
+    picture_Release( p_pic );
+    return p_outpic;
+
+error_unlock:
+    d3d11_device_unlock( p_sys->d3d_dev );
+error:
+    if (p_outpic)
+        picture_Release( p_outpic );
+    picture_Release( p_pic );
+    return NULL;
+}
+
+static void D3D11CloseScaler(filter_t *filter)
+{
+    filter_sys_t *sys = filter->p_sys;
+    D3D11_ReleaseProcessor( &sys->d3d_proc );
+    vlc_video_context_Release(filter->vctx_out);
+
+    free(sys);
+}
+
+static const struct vlc_filter_operations filter_ops = {
+    .filter_video = Scale, .close = D3D11CloseScaler,
+};
+
+int D3D11OpenScaler(filter_t *filter)
+{
+    HRESULT hr;
+
+    if (!is_d3d11_opaque(filter->fmt_in.video.i_chroma))
+        return VLC_EGENERIC;
+    if ( GetD3D11ContextPrivate(filter->vctx_in) == NULL )
+        return VLC_EGENERIC;
+    if (filter->fmt_out.video.i_chroma != filter->fmt_in.video.i_chroma ||
+        filter->fmt_out.video.orientation != filter->fmt_in.video.orientation)
+        return VLC_EGENERIC;
+    /* same-size conversions are handled by the other converters */
+    if (filter->fmt_out.video.i_width == filter->fmt_in.video.i_width &&
+        filter->fmt_out.video.i_height == filter->fmt_in.video.i_height)
+        return VLC_EGENERIC;
+
+    d3d11_video_context_t *vctx_sys = GetD3D11ContextPrivate( filter->vctx_in );
+
+    filter_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+    memset(sys, 0, sizeof (*sys));
+
+    d3d11_decoder_device_t *dev_sys = GetD3D11OpaqueContext( filter->vctx_in );
+    sys->d3d_dev = &dev_sys->d3d_dev;
+
+    sys->output_format = D3D11_RenderFormat(vctx_sys->format, vctx_sys->secondary ,true);
+    if (unlikely(sys->output_format == NULL))
+    {
+        free(sys);
+        return VLC_EGENERIC;
+    }
+
+    d3d11_device_lock(sys->d3d_dev);
+
+    if (D3D11_CreateProcessor(filter, sys->d3d_dev, D3D11_VIDEO_FRAME_FORMAT_PROGRESSIVE,
+                              &filter->fmt_in.video, &filter->fmt_out.video, &sys->d3d_proc) != VLC_SUCCESS)
+        goto error;
+
+    UINT flags;
+    hr = ID3D11VideoProcessorEnumerator_CheckVideoProcessorFormat(sys->d3d_proc.procEnumerator, vctx_sys->format, &flags);
+    if (!SUCCEEDED(hr))
+    {
+        msg_Dbg(filter, "can't read processor support for %s", DxgiFormatToStr(vctx_sys->format));
+        goto error;
+    }
+    if ( !(flags & D3D11_VIDEO_PROCESSOR_FORMAT_SUPPORT_INPUT) ||
+         !(flags & D3D11_VIDEO_PROCESSOR_FORMAT_SUPPORT_OUTPUT) )
+    {
+        msg_Dbg(filter, "scaling %s is not supported", DxgiFormatToStr(vctx_sys->format));
+        goto error;
+    }
+
+    hr = ID3D11VideoDevice_CreateVideoProcessor(sys->d3d_proc.d3dviddev,
+                                                sys->d3d_proc.procEnumerator, 0,
+                                                &sys->d3d_proc.videoProcessor);
+    if (FAILED(hr) || sys->d3d_proc.videoProcessor == NULL)
+    {
+        msg_Dbg(filter, "failed to create the processor");
+        goto error;
+    }
+
+    d3d11_device_unlock(sys->d3d_dev);
+
+    msg_Dbg(filter, "D3D11 scaler: %ux%u -> %ux%u",
+            filter->fmt_in.video.i_width, filter->fmt_in.video.i_height,
+            filter->fmt_out.video.i_width, filter->fmt_out.video.i_height);
+
+    filter->vctx_out = vlc_video_context_Hold(filter->vctx_in);
+    filter->ops      = &filter_ops;
+    filter->p_sys = sys;
+
+    return VLC_SUCCESS;
+error:
+    D3D11_ReleaseProcessor(&sys->d3d_proc);
+    d3d11_device_unlock(sys->d3d_dev);
+    free(sys);
+
+    return VLC_EGENERIC;
+}
@@ -1114,6 +1114,188 @@ error:
     return VLC_EGENERIC;
 }
 
+/********************
+ * Scaler functions *
+ ********************/
+
+static picture_t *
+Scale(filter_t * filter, picture_t * src)
+{
+    filter_sys_t *const filter_sys = filter->p_sys;
+    VABufferID          pipeline_buf = VA_INVALID_ID;
+    picture_t *const    dest = picture_pool_Wait(filter_sys->dest_pics);
+    if (!dest)
+        return NULL;
+
+    vlc_vaapi_PicAttachContext(dest);
+    picture_CopyProperties(dest, src);
+
+    VARectangle const   src_region = {
+        .x = filter->fmt_in.video.i_x_offset,
+        .y = filter->fmt_in.video.i_y_offset,
+        .width = filter->fmt_in.video.i_visible_width,
+        .height = filter->fmt_in.video.i_visible_height
+    };
+    VARectangle const   dest_region = {
+        .x = filter->fmt_out.video.i_x_offset,
+        .y = filter->fmt_out.video.i_y_offset,
+        .width = filter->fmt_out.video.i_visible_width,
+        .height = filter->fmt_out.video.i_visible_height
+    };
+
+    /* The scaling is performed by the pipeline itself, no VAProcFilter is
+       involved. */
+    VAProcPipelineParameterBuffer pipeline_params = {
+        .surface = vlc_vaapi_PicGetSurface(src),
+        .surface_region = &src_region,
+        .output_region = &dest_region,
+        .filter_flags = VA_FILTER_SCALING_HQ
+    };
+
+    if (filter_sys->b_pipeline_fast)
+        pipeline_params.pipeline_flags = VA_PROC_PIPELINE_FAST;
+
+    pipeline_buf =
+        vlc_vaapi_CreateBuffer(VLC_OBJECT(filter),
+                               filter_sys->va.dpy, filter_sys->va.ctx,
+                               VAProcPipelineParameterBufferType,
+                               sizeof(pipeline_params), 1, &pipeline_params);
+    if (pipeline_buf == VA_INVALID_ID)
+        goto error;
+
+    if (vlc_vaapi_BeginPicture(VLC_OBJECT(filter),
+                               filter_sys->va.dpy, filter_sys->va.ctx,
+                               vlc_vaapi_PicGetSurface(dest)))
+        goto error;
+
+    if (vlc_vaapi_RenderPicture(VLC_OBJECT(filter),
+                                filter_sys->va.dpy, filter_sys->va.ctx,
+                                &pipeline_buf, 1))
+        goto error;
+
+    if (vlc_vaapi_EndPicture(VLC_OBJECT(filter),
+                             filter_sys->va.dpy, filter_sys->va.ctx))
+        goto error;
+
+    picture_Release(src);
+
+    return dest;
+
+error:
+    if (pipeline_buf != VA_INVALID_ID)
+        vlc_vaapi_DestroyBuffer(VLC_OBJECT(filter),
+                                filter_sys->va.dpy, pipeline_buf);
+    picture_Release(dest);
+    picture_Release(src);
+    return NULL;
+}
+
+static void
+CloseScaler(filter_t *filter)
+{
+    filter_sys_t *const filter_sys = filter->p_sys;
+    vlc_object_t *const obj = VLC_OBJECT(filter);
+
+    picture_pool_Release(filter_sys->dest_pics);
+    vlc_vaapi_DestroyContext(obj, filter_sys->va.dpy, filter_sys->va.ctx);
+    vlc_vaapi_DestroyConfig(obj, filter_sys->va.dpy, filter_sys->va.conf);
+    vlc_decoder_device_Release(filter_sys->va.dec_device);
+    vlc_video_context_Release(filter->vctx_out);
+    free(filter_sys);
+}
+
+static const struct vlc_filter_operations Scaler_ops = {
+    .filter_video = Scale, .close = CloseScaler,
+};
+
+static int
+OpenScaler(filter_t *filter)
+{
+    filter_sys_t *      filter_sys;
+    VAProcPipelineCaps  pipeline_caps = { 0 };
+
+    if (filter->vctx_in == NULL ||
+        vlc_video_context_GetType(filter->vctx_in) != VLC_VIDEO_CONTEXT_VAAPI)
+        return VLC_EGENERIC;
+    if (!vlc_vaapi_IsChromaOpaque(filter->fmt_out.video.i_chroma) ||
+        filter->fmt_out.video.i_chroma != filter->fmt_in.video.i_chroma ||
+        filter->fmt_out.video.orientation != filter->fmt_in.video.orientation)
+        return VLC_EGENERIC;
+    /* Same-size conversions are not our job, only accept actual scaling so
+       that chroma conversions keep going through vlc_vaapi_OpenChroma. */
+    if (filter->fmt_out.video.i_width == filter->fmt_in.video.i_width &&
+        filter->fmt_out.video.i_height == filter->fmt_in.video.i_height)
+        return VLC_EGENERIC;
+
+    filter_sys = calloc(1, sizeof(*filter_sys));
+    if (!filter_sys)
+        return VLC_ENOMEM;
+    filter->p_sys = filter_sys;
+
+    filter_sys->va.conf = VA_INVALID_ID;
+    filter_sys->va.ctx = VA_INVALID_ID;
+    filter_sys->va.buf = VA_INVALID_ID;
+    filter_sys->va.dec_device = vlc_video_context_HoldDevice(filter->vctx_in);
+    filter_sys->va.dpy = filter_sys->va.dec_device->opaque;
+    assert(filter_sys->va.dec_device);
+
+    filter_sys->dest_pics =
+        vlc_vaapi_PoolNew(VLC_OBJECT(filter), filter->vctx_in,
+                          filter_sys->va.dpy, DEST_PICS_POOL_SZ,
+                          &filter_sys->va.surface_ids, &filter->fmt_out.video);
+    if (!filter_sys->dest_pics)
+        goto error;
+
+    filter_sys->va.conf =
+        vlc_vaapi_CreateConfigChecked(VLC_OBJECT(filter), filter_sys->va.dpy,
+                                      VAProfileNone, VAEntrypointVideoProc,
+                                      filter->fmt_out.video.i_chroma);
+    if (filter_sys->va.conf == VA_INVALID_ID)
+        goto error;
+
+    filter_sys->va.ctx =
+        vlc_vaapi_CreateContext(VLC_OBJECT(filter),
+                                filter_sys->va.dpy, filter_sys->va.conf,
+                                filter->fmt_out.video.i_width,
+                                filter->fmt_out.video.i_height,
+                                0, filter_sys->va.surface_ids,
+                                DEST_PICS_POOL_SZ);
+    if (filter_sys->va.ctx == VA_INVALID_ID)
+        goto error;
+
+    if (vlc_vaapi_QueryVideoProcPipelineCaps(VLC_OBJECT(filter),
+                                             filter_sys->va.dpy,
+                                             filter_sys->va.ctx,
+                                             NULL, 0, &pipeline_caps))
+        goto error;
+
+    filter_sys->b_pipeline_fast =
+        pipeline_caps.pipeline_flags & VA_PROC_PIPELINE_FAST;
+
+    filter->vctx_out = vlc_video_context_Hold(filter->vctx_in);
+    filter->ops = &Scaler_ops;
+
+    msg_Dbg(filter, "VAAPI VPP scaler: %ux%u -> %ux%u",
+            filter->fmt_in.video.i_width, filter->fmt_in.video.i_height,
+            filter->fmt_out.video.i_width, filter->fmt_out.video.i_height);
+
+    return VLC_SUCCESS;
+
+error:
+    if (filter_sys->va.ctx != VA_INVALID_ID)
+        vlc_vaapi_DestroyContext(VLC_OBJECT(filter),
+                                 filter_sys->va.dpy, filter_sys->va.ctx);
+    if (filter_sys->va.conf != VA_INVALID_ID)
+        vlc_vaapi_DestroyConfig(VLC_OBJECT(filter),
+                                filter_sys->va.dpy, filter_sys->va.conf);
+    if (filter_sys->dest_pics)
+        picture_pool_Release(filter_sys->dest_pics);
+    if (filter_sys->va.dec_device)
+        vlc_decoder_device_Release(filter_sys->va.dec_device);
+    free(filter_sys);
+    return VLC_EGENERIC;
+}
+
 /*********************
  * Module descriptor *
  *********************/
@@ -1144,4 +1326,7 @@ vlc_module_begin()
 
     add_submodule()
     set_callback_video_converter(vlc_vaapi_OpenChroma, 10)
+
+    add_submodule()
+    set_callback_video_converter(OpenScaler, 10)
 vlc_module_end()
@@ -70,7 +70,8 @@ static void AndroidPrintMsg(void *opaque, int type, const vlc_log_t *p_item,
 
 static const struct vlc_logger_operations ops = { AndroidPrintMsg, NULL };
 
-static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp)
+static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp,
+                                                int *restrict max_type)
 {
     int verbosity = var_InheritInteger(obj, "verbose");
 
@@ -79,6 +80,8 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp)
 
     verbosity += VLC_MSG_ERR;
     *sysp = (void *)(uintptr_t)verbosity;
+    if (verbosity < *max_type)
+        *max_type = verbosity;
 
     return &ops;
 }
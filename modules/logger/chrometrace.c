@@ -0,0 +1,206 @@
+/*****************************************************************************
+ * chrometrace.c: Chrome trace event tracer plugin
+ *****************************************************************************
+ * Copyright © 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_plugin.h>
+#include <vlc_fs.h>
+#include <vlc_charset.h>
+#include <vlc_tracer.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+# include <process.h>
+#else
+# include <unistd.h>
+#endif
+
+#define TRACE_FILENAME "vlc-trace.json"
+
+typedef struct
+{
+    FILE *stream;
+} vlc_tracer_sys_t;
+
+static void TracePrintString(FILE *stream, const char *str)
+{
+    fputc('"', stream);
+    for (const unsigned char *p = (const unsigned char *)str; *p != '\0'; p++)
+    {
+        if (*p == '"' || *p == '\\')
+            fprintf(stream, "\\%c", *p);
+        else if (*p < 0x20)
+            fprintf(stream, "\\u%04x", *p);
+        else
+            fputc(*p, stream);
+    }
+    fputc('"', stream);
+}
+
+/**
+ * Maps a trace record to one Chrome trace event:
+ * - a record carrying a "begin" (resp. "end") entry becomes a duration
+ *   begin (resp. end) event named after the entry value, so that
+ *   vlc_tracer_TraceSpanBegin()/vlc_tracer_TraceSpanEnd() pairs show up as
+ *   spans on the emitting thread's track,
+ * - any other record becomes a thread-scoped instant event.
+ * The remaining entries are exported as the event arguments.
+ */
+static void TraceChrome(void *opaque, vlc_tick_t ts,
+                        const struct vlc_tracer_trace *trace)
+{
+    vlc_tracer_sys_t *sys = opaque;
+    FILE *stream = sys->stream;
+    const struct vlc_tracer_entry *entry;
+    const char *name = NULL;
+    const char *cat = NULL;
+    char phase = 'i';
+
+    for (entry = trace->entries; entry->key != NULL; entry++)
+    {
+        if (entry->type != VLC_TRACER_STRING)
+            continue;
+        if (strcmp(entry->key, "begin") == 0)
+        {
+            phase = 'B';
+            name = entry->value.string;
+        }
+        else if (strcmp(entry->key, "end") == 0)
+        {
+            phase = 'E';
+            name = entry->value.string;
+        }
+        else if (name == NULL && strcmp(entry->key, "event") == 0)
+            name = entry->value.string;
+        else if (strcmp(entry->key, "type") == 0)
+            cat = entry->value.string;
+    }
+    if (name == NULL)
+        name = (cat != NULL) ? cat : "trace";
+
+    flockfile(stream);
+    fprintf(stream, "{\"ph\":\"%c\",\"ts\":%"PRId64",\"pid\":%ld,\"tid\":%lu,",
+            phase, US_FROM_VLC_TICK(ts), (long)getpid(), vlc_thread_id());
+    fputs("\"name\":", stream);
+    TracePrintString(stream, name);
+    fputs(",\"cat\":", stream);
+    TracePrintString(stream, (cat != NULL) ? cat : "vlc");
+    if (phase == 'i')
+        fputs(",\"s\":\"t\"", stream);
+
+    fputs(",\"args\":{", stream);
+    bool first = true;
+    for (entry = trace->entries; entry->key != NULL; entry++)
+    {
+        if (strcmp(entry->key, "begin") == 0 || strcmp(entry->key, "end") == 0
+         || strcmp(entry->key, "type") == 0)
+            continue;
+        if (!first)
+            fputc(',', stream);
+        first = false;
+        TracePrintString(stream, entry->key);
+        fputc(':', stream);
+        switch (entry->type)
+        {
+            case VLC_TRACER_INT:
+                fprintf(stream, "%"PRId64, entry->value.integer);
+                break;
+            case VLC_TRACER_DOUBLE:
+                vlc_fprintf_c(stream, "%g", entry->value.double_);
+                break;
+            case VLC_TRACER_STRING:
+                TracePrintString(stream, entry->value.string);
+                break;
+            default:
+                vlc_assert_unreachable();
+                break;
+        }
+    }
+    fputs("}},\n", stream);
+    funlockfile(stream);
+}
+
+static void Close(void *opaque)
+{
+    vlc_tracer_sys_t *sys = opaque;
+    fclose(sys->stream);
+    free(sys);
+}
+
+static const struct vlc_tracer_operations chrome_ops =
+{
+    TraceChrome,
+    Close
+};
+
+static const struct vlc_tracer_operations *Open(vlc_object_t *obj,
+                                                void **restrict sysp)
+{
+    vlc_tracer_sys_t *sys = malloc(sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return NULL;
+
+    const char *filename = TRACE_FILENAME;
+
+    char *path = var_InheritString(obj, "chrometrace-file");
+    if (path != NULL)
+        filename = path;
+
+    msg_Dbg(obj, "opening trace file `%s'", filename);
+    sys->stream = vlc_fopen(filename, "wt");
+    if (sys->stream == NULL)
+    {
+        msg_Err(obj, "error opening trace file `%s': %s", filename,
+                vlc_strerror_c(errno));
+        free(path);
+        free(sys);
+        return NULL;
+    }
+    free(path);
+
+    setvbuf(sys->stream, NULL, _IOLBF, 0);
+
+    /* The JSON array is deliberately left unterminated: the Trace Event
+     * format allows it, so the file stays loadable even if VLC dies. */
+    fputs("[\n", sys->stream);
+
+    *sysp = sys;
+    return &chrome_ops;
+}
+
+#define TRACEFILE_NAME_TEXT N_("Trace filename")
+#define TRACEFILE_NAME_LONGTEXT N_("Specify the Chrome trace event filename.")
+
+vlc_module_begin()
+    set_shortname(N_("Chrome tracer"))
+    set_description(N_("Chrome trace event tracer"))
+    set_subcategory(SUBCAT_ADVANCED_MISC)
+    set_capability("tracer", 0)
+    set_callback(Open)
+    add_shortcut("chrometrace")
+
+    add_savefile("chrometrace-file", NULL, TRACEFILE_NAME_TEXT, TRACEFILE_NAME_LONGTEXT)
+vlc_module_end()
@@ -133,7 +133,8 @@ static const struct vlc_logger_operations gray_ops =
 };
 
 static const struct vlc_logger_operations *Open(vlc_object_t *obj,
-                                                void **restrict sysp)
+                                                void **restrict sysp,
+                                                int *restrict max_type)
 {
     int verbosity = -1;
 
@@ -154,6 +155,7 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
         verbosity = VLC_MSG_DBG;
 
     *sysp = verbosities + verbosity;
+    *max_type = verbosity;
 
 #if defined (HAVE_ISATTY)
     if (isatty(STDERR_FILENO) && var_InheritBool(obj, "color"))
@@ -66,7 +66,8 @@ static void EmscriptenPrintMsg(void *opaque, int type, const vlc_log_t *p_item,
 
 static const struct vlc_logger_operations ops = { EmscriptenPrintMsg, NULL };
 
-static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp)
+static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp,
+                                                int *restrict max_type)
 {
     int verbosity = var_InheritInteger(obj, "verbose");
 
@@ -74,6 +75,8 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp)
         return NULL;
     verbosity += VLC_MSG_ERR;
     *sysp = (void *)(int)verbosity;
+    if (verbosity < *max_type)
+        *max_type = verbosity;
     return &ops;
 }
 
@@ -30,19 +30,46 @@
 #include <vlc_configuration.h>
 #include <vlc_plugin.h>
 #include <vlc_fs.h>
+#include <vlc_queue.h>
 //#include <vlc_charset.h>
 
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <assert.h>
 #include <errno.h>
 
 static const char msg_type[4][9] = { "", " error", " warning", " debug" };
 
+/* One formatted message, queued for the writer thread */
+typedef struct vlc_log_entry
+{
+    struct vlc_log_entry *next;
+    size_t length;
+    char text[];
+} vlc_log_entry_t;
+
+/* Maximum bytes of messages pending in the queue: above this, messages are
+ * dropped (and counted) rather than blocking the logging threads or hogging
+ * memory when the disk cannot keep up. */
+#define LOG_QUEUE_MAX (1 << 20)
+
 typedef struct
 {
     FILE *stream;
+    const char *header;
     const char *footer;
     int verbosity;
+
+    char *path; /**< Log file path, for rotation */
+    uint64_t rotate_size; /**< Rotate above this many bytes, 0 = never */
+    int rotate_count; /**< Number of rotated files to keep */
+    uint64_t written; /**< Bytes written to the current file */
+
+    vlc_thread_t thread;
+    vlc_queue_t queue;
+    bool dead;
+    atomic_size_t queued; /**< Bytes of messages pending in the queue */
+    atomic_uint dropped; /**< Messages dropped on overload */
 } vlc_logger_sys_t;
 
 #define TEXT_FILENAME "vlc-log.txt"
@@ -50,28 +77,138 @@ typedef struct
                     "-- logger module started --\n"
 #define TEXT_FOOTER "-- logger module stopped --\n"
 
+static void Enqueue(vlc_logger_sys_t *sys, const char *prefix,
+                    const char *format, va_list ap, const char *suffix)
+{
+    va_list copy;
+
+    va_copy(copy, ap);
+    int body = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (unlikely(body < 0))
+        return;
+
+    size_t pre = strlen(prefix), post = strlen(suffix);
+    size_t length = pre + (size_t)body + post;
+
+    if (atomic_load_explicit(&sys->queued, memory_order_relaxed) + length
+            > LOG_QUEUE_MAX)
+    {   /* The writer thread is lagging behind: drop and count */
+        atomic_fetch_add_explicit(&sys->dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    vlc_log_entry_t *entry = malloc(sizeof (*entry) + length + 1);
+    if (unlikely(entry == NULL))
+        return;
+
+    entry->length = length;
+    memcpy(entry->text, prefix, pre);
+    vsnprintf(entry->text + pre, (size_t)body + 1, format, ap);
+    memcpy(entry->text + pre + body, suffix, post + 1);
+
+    atomic_fetch_add_explicit(&sys->queued, length, memory_order_relaxed);
+    vlc_queue_Enqueue(&sys->queue, entry);
+}
+
+static void Rotate(vlc_logger_sys_t *sys)
+{
+    fputs(sys->footer, sys->stream);
+    fclose(sys->stream);
+    sys->stream = NULL;
+
+    /* Shift the numbered backups up, the live file becoming ".1". The file
+     * previously at the end of the chain is overwritten by the rename. */
+    for (int i = sys->rotate_count; i > 0; i--)
+    {
+        char *to, *from;
+
+        if (asprintf(&to, "%s.%d", sys->path, i) == -1)
+            continue;
+        if (i > 1 ? asprintf(&from, "%s.%d", sys->path, i - 1) == -1
+                  : (from = strdup(sys->path)) == NULL)
+        {
+            free(to);
+            continue;
+        }
+        vlc_rename(from, to); /* missing backups are not an error */
+        free(from);
+        free(to);
+    }
+
+    sys->stream = vlc_fopen(sys->path, "wt");
+    sys->written = strlen(sys->header);
+    if (sys->stream != NULL)
+    {
+        setvbuf(sys->stream, NULL, _IOLBF, 0);
+        fputs(sys->header, sys->stream);
+    }
+}
+
+static void *Thread(void *opaque)
+{
+    vlc_thread_set_name("vlc-log-file");
+
+    vlc_logger_sys_t *sys = opaque;
+    vlc_log_entry_t *entry;
+
+    while ((entry = vlc_queue_DequeueKillable(&sys->queue, &sys->dead)))
+    {
+        atomic_fetch_sub_explicit(&sys->queued, entry->length,
+                                  memory_order_relaxed);
+
+        if (sys->stream != NULL)
+        {
+            unsigned dropped = atomic_exchange_explicit(&sys->dropped, 0,
+                                                        memory_order_relaxed);
+            if (dropped > 0)
+            {
+                int n = fprintf(sys->stream,
+                                "-- %u messages dropped --\n", dropped);
+                if (n > 0)
+                    sys->written += n;
+            }
+
+            fwrite(entry->text, 1, entry->length, sys->stream);
+            sys->written += entry->length;
+
+            if (sys->rotate_size != 0 && sys->written >= sys->rotate_size)
+                Rotate(sys);
+        }
+        free(entry);
+    }
+    return NULL;
+}
+
 static void LogText(void *opaque, int type, const vlc_log_t *meta,
                     const char *format, va_list ap)
 {
     vlc_logger_sys_t *sys = opaque;
-    FILE *stream = sys->stream;
+    char *prefix;
 
     if (sys->verbosity < type)
         return;
 
-    flockfile(stream);
-    fprintf(stream, "%s%s: ", meta->psz_module, msg_type[type]);
-    vfprintf(stream, format, ap);
-    putc_unlocked('\n', stream);
-    funlockfile(stream);
+    if (asprintf(&prefix, "%s%s: ", meta->psz_module, msg_type[type]) == -1)
+        return;
+    Enqueue(sys, prefix, format, ap, "\n");
+    free(prefix);
 }
 
 static void Close(void *opaque)
 {
     vlc_logger_sys_t *sys = opaque;
 
-    fputs(sys->footer, sys->stream);
-    fclose(sys->stream);
+    /* The writer drains the queue before honouring the kill */
+    vlc_queue_Kill(&sys->queue, &sys->dead);
+    vlc_join(sys->thread, NULL);
+
+    if (sys->stream != NULL)
+    {
+        fputs(sys->footer, sys->stream);
+        fclose(sys->stream);
+    }
+    free(sys->path);
     free(sys);
 }
 
@@ -107,18 +244,17 @@ static void LogHtml(void *opaque, int type, const vlc_log_t *meta,
         0xffffff, 0xff6666, 0xffff66, 0xaaaaaa,
     };
     vlc_logger_sys_t *sys = opaque;
-    FILE *stream = sys->stream;
+    char *prefix;
 
     if (sys->verbosity < type)
         return;
 
-    flockfile(stream);
-    fprintf(stream, "%s%s: <span style=\"color: #%06x\">",
-            meta->psz_module, msg_type[type], color[type]);
+    if (asprintf(&prefix, "%s%s: <span style=\"color: #%06x\">",
+                 meta->psz_module, msg_type[type], color[type]) == -1)
+        return;
     /* FIXME: encode special ASCII characters */
-    vfprintf(stream, format, ap);
-    fputs("</span>\n", stream);
-    funlockfile(stream);
+    Enqueue(sys, prefix, format, ap, "</span>\n");
+    free(prefix);
 }
 
 static const struct vlc_logger_operations html_ops =
@@ -128,7 +264,8 @@ static const struct vlc_logger_operations html_ops =
 };
 
 static const struct vlc_logger_operations *Open(vlc_object_t *obj,
-                                                void **restrict sysp)
+                                                void **restrict sysp,
+                                                int *restrict max_type)
 {
     if (!var_InheritBool(obj, "file-logging"))
         return NULL;
@@ -146,11 +283,17 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
         return NULL;
 
     const char *filename = TEXT_FILENAME;
-    const char *header = TEXT_HEADER;
 
     const struct vlc_logger_operations *ops = &text_ops;
+    sys->header = TEXT_HEADER;
     sys->footer = TEXT_FOOTER;
     sys->verbosity = verbosity;
+    sys->rotate_size = var_InheritInteger(obj, "logfile-rotate-size");
+    sys->rotate_count = var_InheritInteger(obj, "logfile-rotate-count");
+    vlc_queue_Init(&sys->queue, offsetof (vlc_log_entry_t, next));
+    sys->dead = false;
+    atomic_init(&sys->queued, 0);
+    atomic_init(&sys->dropped, 0);
 
     char *mode = var_InheritString(obj, "logmode");
     if (mode != NULL)
@@ -158,7 +301,7 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
         if (!strcmp(mode, "html"))
         {
             filename = HTML_FILENAME;
-            header = HTML_HEADER;
+            sys->header = HTML_HEADER;
             ops = &html_ops;
             sys->footer = HTML_FOOTER;
         }
@@ -194,12 +337,29 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
         free(sys);
         return NULL;
     }
+    sys->path = strdup(filename);
     free(path);
+    if (unlikely(sys->path == NULL))
+    {
+        fclose(sys->stream);
+        free(sys);
+        return NULL;
+    }
 
     setvbuf(sys->stream, NULL, _IOLBF, 0);
-    fputs(header, sys->stream);
+    fputs(sys->header, sys->stream);
+    sys->written = strlen(sys->header);
+
+    if (vlc_clone(&sys->thread, Thread, sys))
+    {
+        fclose(sys->stream);
+        free(sys->path);
+        free(sys);
+        return NULL;
+    }
 
     *sysp = sys;
+    *max_type = verbosity;
     return ops;
 }
 
@@ -229,6 +389,14 @@ static const char *const verbosity_text[] = { N_("Default"), N_("Info"), N_("Err
 #define LOGVERBOSE_LONGTEXT N_("Select the logging verbosity or " \
 "default to use the same verbosity given by --verbose.")
 
+#define LOGROTATE_SIZE_TEXT N_("Maximum log file size")
+#define LOGROTATE_SIZE_LONGTEXT N_("Rotate the log file once it grows " \
+"beyond this size in bytes (0 to never rotate).")
+
+#define LOGROTATE_COUNT_TEXT N_("Number of rotated log files")
+#define LOGROTATE_COUNT_LONGTEXT N_("Number of rotated log files to keep " \
+"on disk; the oldest one is overwritten at each rotation.")
+
 vlc_module_begin()
     set_shortname(N_("Logger"))
     set_description(N_("File logger"))
@@ -242,4 +410,9 @@ vlc_module_begin()
         change_string_list(mode_list, mode_list_text)
     add_integer("log-verbose", -1, LOGVERBOSE_TEXT, LOGVERBOSE_LONGTEXT)
         change_integer_list(verbosity_values, verbosity_text)
+    add_integer("logfile-rotate-size", 0, LOGROTATE_SIZE_TEXT,
+                LOGROTATE_SIZE_LONGTEXT)
+    add_integer("logfile-rotate-count", 1, LOGROTATE_COUNT_TEXT,
+                LOGROTATE_COUNT_LONGTEXT)
+        change_integer_range(0, 99)
 vlc_module_end ()
@@ -66,12 +66,13 @@ static void Log(void *opaque, int type, const vlc_log_t *meta,
 
 static const struct vlc_logger_operations ops = { Log, NULL };
 
-static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp)
+static const struct vlc_logger_operations *Open(vlc_object_t *obj, void **sysp,
+                                                int *restrict max_type)
 {
     if (!var_InheritBool(obj, "syslog"))
         return NULL;
 
-    (void) sysp;
+    (void) sysp; (void) max_type; /* journald filters on its own */
     return &ops;
 }
 
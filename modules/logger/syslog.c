@@ -113,7 +113,8 @@ static void Close(void *opaque)
 static const struct vlc_logger_operations ops = { Log, Close };
 
 static const struct vlc_logger_operations *Open(vlc_object_t *obj,
-                                                void **restrict sysp)
+                                                void **restrict sysp,
+                                                int *restrict max_type)
 {
     if (!var_InheritBool(obj, "syslog"))
         return NULL;
@@ -132,6 +133,8 @@ static const struct vlc_logger_operations *Open(vlc_object_t *obj,
     int mask = LOG_MASK(LOG_ERR) | LOG_MASK(LOG_WARNING) | LOG_MASK(LOG_INFO);
     if (var_InheritBool(obj, "syslog-debug"))
         mask |= LOG_MASK(LOG_DEBUG);
+    else
+        *max_type = VLC_MSG_WARN;
 
     setlogmask(mask);
 
@@ -632,6 +632,8 @@ static int vlclua_input_item_stats( lua_State *L )
         STATS_INT( lost_pictures )
         STATS_INT( played_abuffers )
         STATS_INT( lost_abuffers )
+        STATS_INT( demux_cpu )
+        STATS_INT( decoder_cpu )
 #undef STATS_INT
 #undef STATS_FLOAT
     }
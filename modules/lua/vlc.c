@@ -40,6 +40,8 @@
 #include <vlc_arrays.h>
 #include <vlc_charset.h>
 #include <vlc_fs.h>
+#include <vlc_hash.h>
+#include <vlc_memstream.h>
 #include <vlc_services_discovery.h>
 #include <vlc_stream.h>
 
@@ -596,17 +598,278 @@ int vlclua_add_modules_path( lua_State *L, const char *psz_filename )
     return 0;
 }
 
+/*****************************************************************************
+ * Compiled chunk cache.
+ * Scripts are compiled once per source change: the bytecode is kept in a
+ * process-wide cache shared by all interpreter instances and persisted in
+ * the user cache directory, so that restarting an interface or spawning a
+ * new interpreter does not pay the parser again.
+ *****************************************************************************/
+#define LUAC_MAGIC "VLCluac"
+
+struct luac_header
+{
+    char magic[8];
+    uint32_t i_lua_version;
+    uint32_t i_ptr_size;
+    int64_t i_mtime;
+    uint64_t i_source_size;
+    uint64_t i_size;
+};
+
+struct luac_chunk
+{
+    struct luac_chunk *p_next;
+    char *psz_path;
+    int64_t i_mtime;
+    uint64_t i_source_size;
+    size_t i_size;
+    char p_data[];
+};
+
+static vlc_mutex_t luac_cache_lock = VLC_STATIC_MUTEX;
+static struct luac_chunk *p_luac_cache = NULL;
+
+/* Looks a script up in the shared cache, dropping the entry if the source
+ * changed on disk. The cache lock must be held. */
+static struct luac_chunk *vlclua_chunk_get( const char *psz_path,
+                                            int64_t i_mtime,
+                                            uint64_t i_source_size )
+{
+    struct luac_chunk **pp = &p_luac_cache;
+
+    while( *pp )
+    {
+        struct luac_chunk *p = *pp;
+        if( !strcmp( p->psz_path, psz_path ) )
+        {
+            if( p->i_mtime == i_mtime && p->i_source_size == i_source_size )
+                return p;
+            /* stale: the script was edited since it was compiled */
+            *pp = p->p_next;
+            free( p->psz_path );
+            free( p );
+            continue;
+        }
+        pp = &p->p_next;
+    }
+    return NULL;
+}
+
+static void vlclua_chunk_store( const char *psz_path, int64_t i_mtime,
+                                uint64_t i_source_size,
+                                const void *p_data, size_t i_size )
+{
+    struct luac_chunk *p = malloc( sizeof( *p ) + i_size );
+    if( !p )
+        return;
+    p->psz_path = strdup( psz_path );
+    if( !p->psz_path )
+    {
+        free( p );
+        return;
+    }
+    p->i_mtime = i_mtime;
+    p->i_source_size = i_source_size;
+    p->i_size = i_size;
+    memcpy( p->p_data, p_data, i_size );
+    p->p_next = p_luac_cache;
+    p_luac_cache = p;
+}
+
+/* Where the persisted bytecode of a script lives, keyed on the script path
+ * so that scripts with identical basenames do not collide */
+static char *vlclua_bytecode_path( const char *psz_script )
+{
+    char *psz_cachedir = config_GetUserDir( VLC_CACHE_DIR );
+    if( !psz_cachedir )
+        return NULL;
+
+    vlc_hash_md5_t md5;
+    char hex[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    vlc_hash_md5_Init( &md5 );
+    vlc_hash_md5_Update( &md5, psz_script, strlen( psz_script ) );
+    vlc_hash_FinishHex( &md5, hex );
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s"DIR_SEP"luac"DIR_SEP"%s.luac",
+                  psz_cachedir, hex ) == -1 )
+        psz_path = NULL;
+    free( psz_cachedir );
+    return psz_path;
+}
+
+/* Loads persisted bytecode if it matches the current source, and promotes it
+ * to the shared cache. The cache lock must be held. */
+static int vlclua_chunk_load_disk( lua_State *L, const char *psz_script,
+                                   int64_t i_mtime, uint64_t i_source_size )
+{
+    char *psz_path = vlclua_bytecode_path( psz_script );
+    if( !psz_path )
+        return -1;
+    FILE *f = vlc_fopen( psz_path, "rb" );
+    free( psz_path );
+    if( !f )
+        return -1;
+
+    int i_ret = -1;
+    struct luac_header hdr;
+    if( fread( &hdr, sizeof( hdr ), 1, f ) == 1
+     && !memcmp( hdr.magic, LUAC_MAGIC, sizeof( hdr.magic ) )
+     && hdr.i_lua_version == LUA_VERSION_NUM
+     && hdr.i_ptr_size == sizeof( void * )
+     && hdr.i_mtime == i_mtime
+     && hdr.i_source_size == i_source_size
+     && hdr.i_size > 0 && hdr.i_size <= ( 64 << 20 ) )
+    {
+        char *p_data = malloc( hdr.i_size );
+        if( p_data && fread( p_data, hdr.i_size, 1, f ) == 1
+         && !luaL_loadbuffer( L, p_data, hdr.i_size, psz_script ) )
+        {
+            vlclua_chunk_store( psz_script, i_mtime, i_source_size,
+                                p_data, hdr.i_size );
+            i_ret = 0;
+        }
+        free( p_data );
+    }
+    fclose( f );
+    return i_ret;
+}
+
+static void vlclua_chunk_save_disk( const char *psz_script, int64_t i_mtime,
+                                    uint64_t i_source_size,
+                                    const void *p_data, size_t i_size )
+{
+    char *psz_path = vlclua_bytecode_path( psz_script );
+    if( !psz_path )
+        return;
+
+    /* the cache directory may not exist yet on a fresh profile */
+    char *psz_sep = strrchr( psz_path, DIR_SEP_CHAR );
+    *psz_sep = '\0';
+    char *psz_parent = strrchr( psz_path, DIR_SEP_CHAR );
+    if( psz_parent )
+    {
+        *psz_parent = '\0';
+        vlc_mkdir( psz_path, 0700 );
+        *psz_parent = DIR_SEP_CHAR;
+    }
+    vlc_mkdir( psz_path, 0700 );
+    *psz_sep = DIR_SEP_CHAR;
+
+    /* write then rename so readers never see a partial file */
+    char *psz_tmp;
+    if( asprintf( &psz_tmp, "%s.tmp", psz_path ) == -1 )
+    {
+        free( psz_path );
+        return;
+    }
+    FILE *f = vlc_fopen( psz_tmp, "wb" );
+    if( f )
+    {
+        struct luac_header hdr = {
+            .i_lua_version = LUA_VERSION_NUM,
+            .i_ptr_size = sizeof( void * ),
+            .i_mtime = i_mtime,
+            .i_source_size = i_source_size,
+            .i_size = i_size,
+        };
+        memcpy( hdr.magic, LUAC_MAGIC, sizeof( hdr.magic ) );
+        bool ok = fwrite( &hdr, sizeof( hdr ), 1, f ) == 1
+               && fwrite( p_data, i_size, 1, f ) == 1;
+        ok = ( fclose( f ) == 0 ) && ok;
+        if( !ok || vlc_rename( psz_tmp, psz_path ) )
+            vlc_unlink( psz_tmp );
+    }
+    free( psz_tmp );
+    free( psz_path );
+}
+
+static int vlclua_dump_writer( lua_State *L, const void *p, size_t i_size,
+                               void *opaque )
+{
+    (void) L;
+    vlc_memstream_write( opaque, p, i_size );
+    return 0;
+}
+
+/** Replacement for luaL_loadfile going through the compiled chunk cache */
+static int vlclua_loadfile_cached( lua_State *L, const char *psz_file )
+{
+    struct stat st;
+    size_t i_len = strlen( psz_file );
+
+    /* .luac files are already bytecode and load without parsing */
+    if( vlc_stat( psz_file, &st ) || !S_ISREG( st.st_mode )
+     || ( i_len >= 5 && !strcmp( psz_file + i_len - 5, ".luac" ) ) )
+        return luaL_loadfile( L, psz_file );
+
+    int64_t i_mtime = st.st_mtime;
+    uint64_t i_source_size = st.st_size;
+    int i_ret;
+
+    vlc_mutex_lock( &luac_cache_lock );
+    struct luac_chunk *p = vlclua_chunk_get( psz_file, i_mtime,
+                                             i_source_size );
+    if( p )
+    {
+        i_ret = luaL_loadbuffer( L, p->p_data, p->i_size, psz_file );
+        vlc_mutex_unlock( &luac_cache_lock );
+        return i_ret;
+    }
+    if( !vlclua_chunk_load_disk( L, psz_file, i_mtime, i_source_size ) )
+    {
+        vlc_mutex_unlock( &luac_cache_lock );
+        return 0;
+    }
+
+    i_ret = luaL_loadfile( L, psz_file );
+    if( !i_ret )
+    {
+        struct vlc_memstream ms;
+        if( !vlc_memstream_open( &ms ) )
+        {
+#if LUA_VERSION_NUM >= 503
+            int i_err = lua_dump( L, vlclua_dump_writer, &ms, 0 );
+#else
+            int i_err = lua_dump( L, vlclua_dump_writer, &ms );
+#endif
+            if( !vlc_memstream_close( &ms ) )
+            {
+                if( !i_err )
+                {
+                    vlclua_chunk_store( psz_file, i_mtime, i_source_size,
+                                        ms.ptr, ms.length );
+                    vlclua_chunk_save_disk( psz_file, i_mtime, i_source_size,
+                                            ms.ptr, ms.length );
+                }
+                free( ms.ptr );
+            }
+        }
+    }
+    vlc_mutex_unlock( &luac_cache_lock );
+    return i_ret;
+}
+
+static int vlclua_dofile_cached( lua_State *L, const char *psz_file )
+{
+    int i_ret = vlclua_loadfile_cached( L, psz_file );
+    if( !i_ret )
+        i_ret = lua_pcall( L, 0, LUA_MULTRET, 0 );
+    return i_ret;
+}
+
 /** Replacement for luaL_dofile, using VLC's input capabilities */
 int vlclua_dofile( vlc_object_t *p_this, lua_State *L, const char *curi )
 {
     char *uri = ToLocaleDup( curi );
     if( !strstr( uri, "://" ) ) {
-        int ret = luaL_dofile( L, uri );
+        int ret = vlclua_dofile_cached( L, uri );
         free( uri );
         return ret;
     }
     if( !strncasecmp( uri, "file://", 7 ) ) {
-        int ret = luaL_dofile( L, uri + 7 );
+        int ret = vlclua_dofile_cached( L, uri + 7 );
         free( uri );
         return ret;
     }
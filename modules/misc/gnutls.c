@@ -36,19 +36,94 @@
 #include <vlc_common.h>
 #include <vlc_plugin.h>
 #include <vlc_tls.h>
+#include <vlc_arrays.h>
 #include <vlc_block.h>
 #include <vlc_dialog.h>
 
 #include <gnutls/gnutls.h>
 #include <gnutls/x509.h>
 
+/**
+ * Client-side TLS credentials private data
+ */
+typedef struct vlc_tls_client_sys
+{
+    gnutls_certificate_credentials_t x509;
+    vlc_mutex_t cache_lock;
+    vlc_dictionary_t cache; /**< session resumption data, keyed by host */
+} vlc_tls_client_sys_t;
+
+/* serialized session kept for resumption (ticket) */
+struct gnutls_cached_session
+{
+    size_t size;
+    unsigned char data[];
+};
+
 typedef struct vlc_tls_gnutls
 {
     vlc_tls_t tls;
     gnutls_session_t session;
     vlc_object_t *obj;
+    vlc_tls_client_sys_t *client; /**< resumption cache, NULL on server side */
+    char *host; /**< resumption cache key, NULL on server side */
 } vlc_tls_gnutls_t;
 
+static void gnutls_CachedSessionFree(void *entry, void *opaque)
+{
+    (void) opaque;
+    free(entry);
+}
+
+/* Feed a previously cached session into a new one, so the handshake can
+ * resume it instead of paying a full round trip. */
+static void gnutls_SessionCacheRestore(vlc_tls_gnutls_t *priv)
+{
+    vlc_tls_client_sys_t *sys = priv->client;
+
+    vlc_mutex_lock(&sys->cache_lock);
+    struct gnutls_cached_session *entry =
+        vlc_dictionary_value_for_key(&sys->cache, priv->host);
+    if (entry != NULL
+     && gnutls_session_set_data(priv->session, entry->data, entry->size) != 0)
+        /* stale or corrupt entry: drop it */
+        vlc_dictionary_remove_value_for_key(&sys->cache, priv->host,
+                                            gnutls_CachedSessionFree, NULL);
+    vlc_mutex_unlock(&sys->cache_lock);
+}
+
+/* Save the session resumption data for the next connection to the host.
+ * With TLS 1.3 the ticket can arrive after the handshake, in which case the
+ * next session on this host refreshes the entry. */
+static void gnutls_SessionCacheStore(vlc_tls_gnutls_t *priv)
+{
+    vlc_tls_client_sys_t *sys = priv->client;
+    gnutls_datum_t data;
+
+    if (gnutls_session_get_data2(priv->session, &data) != 0)
+        return;
+
+    if (data.size > 0)
+    {
+        struct gnutls_cached_session *entry = malloc(sizeof (*entry)
+                                                     + data.size);
+        if (likely(entry != NULL))
+        {
+            entry->size = data.size;
+            memcpy(entry->data, data.data, data.size);
+
+            vlc_mutex_lock(&sys->cache_lock);
+            if (vlc_dictionary_value_for_key(&sys->cache, priv->host) != NULL)
+                vlc_dictionary_remove_value_for_key(&sys->cache, priv->host,
+                                                    gnutls_CachedSessionFree,
+                                                    NULL);
+            vlc_dictionary_insert(&sys->cache, priv->host, entry);
+            vlc_mutex_unlock(&sys->cache_lock);
+        }
+    }
+    gnutls_free(data.data);
+}
+
 static void gnutls_Banner(vlc_object_t *obj)
 {
     msg_Dbg(obj, "using GnuTLS v%s (built with v"GNUTLS_VERSION")",
@@ -208,6 +283,7 @@ static void gnutls_Close (vlc_tls_t *tls)
     vlc_tls_gnutls_t *priv = (vlc_tls_gnutls_t *)tls;
 
     gnutls_deinit(priv->session);
+    free(priv->host);
     free(priv);
 }
 
@@ -297,6 +373,8 @@ static vlc_tls_gnutls_t *gnutls_SessionOpen(vlc_object_t *obj, int type,
 
     priv->session = session;
     priv->obj = obj;
+    priv->client = NULL;
+    priv->host = NULL;
 
     vlc_tls_t *tls = &priv->tls;
 
@@ -379,8 +457,9 @@ static vlc_tls_t *gnutls_ClientSessionOpen(vlc_tls_client_t *crd,
                                            vlc_tls_t *sk, const char *hostname,
                                            const char *const *alpn)
 {
+    vlc_tls_client_sys_t *sys = crd->sys;
     vlc_tls_gnutls_t *priv = gnutls_SessionOpen(VLC_OBJECT(crd), GNUTLS_CLIENT,
-                                                crd->sys, sk, alpn);
+                                                sys->x509, sk, alpn);
     if (priv == NULL)
         return NULL;
 
@@ -390,10 +469,19 @@ static vlc_tls_t *gnutls_ClientSessionOpen(vlc_tls_client_t *crd,
     gnutls_dh_set_prime_bits (session, 1024);
 
     if (likely(hostname != NULL))
+    {
         /* fill Server Name Indication */
         gnutls_server_name_set (session, GNUTLS_NAME_DNS,
                                 hostname, strlen (hostname));
 
+        priv->host = strdup(hostname);
+        if (likely(priv->host != NULL))
+        {
+            priv->client = sys;
+            gnutls_SessionCacheRestore(priv);
+        }
+    }
+
     return &priv->tls;
 }
 
@@ -408,8 +496,16 @@ static int gnutls_ClientHandshake(vlc_tls_t *tls,
     if (val)
         return val;
 
-    /* certificates chain verification */
     gnutls_session_t session = priv->session;
+
+    if (priv->client != NULL)
+    {
+        if (gnutls_session_is_resumed(session))
+            msg_Dbg(obj, " - session resumed");
+        gnutls_SessionCacheStore(priv);
+    }
+
+    /* certificates chain verification */
     unsigned status;
 
     val = gnutls_certificate_verify_peers3 (session, host, &status);
@@ -533,9 +629,11 @@ error:
 
 static void gnutls_ClientDestroy(vlc_tls_client_t *crd)
 {
-    gnutls_certificate_credentials_t x509 = crd->sys;
+    vlc_tls_client_sys_t *sys = crd->sys;
 
-    gnutls_certificate_free_credentials(x509);
+    vlc_dictionary_clear(&sys->cache, gnutls_CachedSessionFree, NULL);
+    gnutls_certificate_free_credentials(sys->x509);
+    free(sys);
 }
 
 static const struct vlc_tls_client_operations gnutls_ClientOps =
@@ -554,11 +652,16 @@ static int OpenClient(vlc_tls_client_t *crd)
 
     gnutls_Banner(VLC_OBJECT(crd));
 
+    vlc_tls_client_sys_t *sys = malloc (sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+
     int val = gnutls_certificate_allocate_credentials (&x509);
     if (val != 0)
     {
         msg_Err (crd, "cannot allocate credentials: %s",
                  gnutls_strerror (val));
+        free (sys);
         return VLC_EGENERIC;
     }
 
@@ -588,8 +691,12 @@ static int OpenClient(vlc_tls_client_t *crd)
     gnutls_certificate_set_verify_flags (x509,
                                          GNUTLS_VERIFY_ALLOW_X509_V1_CA_CRT);
 
+    sys->x509 = x509;
+    vlc_mutex_init (&sys->cache_lock);
+    vlc_dictionary_init (&sys->cache, 0);
+
     crd->ops = &gnutls_ClientOps;
-    crd->sys = x509;
+    crd->sys = sys;
     return VLC_SUCCESS;
 }
 
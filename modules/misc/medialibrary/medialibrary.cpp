@@ -138,16 +138,19 @@ void wrapEntityDeletedEventCallback( vlc_medialibrary_module_t* ml,
 
 void MediaLibrary::onMediaAdded( std::vector<medialibrary::MediaPtr> media )
 {
+    invalidateMediaCursor();
     wrapEntityCreatedEventCallback<vlc_ml_media_t>( m_vlc_ml, media, VLC_ML_EVENT_MEDIA_ADDED );
 }
 
 void MediaLibrary::onMediaModified( std::set<int64_t> mediaIds )
 {
+    invalidateMediaCursor();
     wrapEntityModifiedEventCallback( m_vlc_ml, mediaIds, VLC_ML_EVENT_MEDIA_UPDATED );
 }
 
 void MediaLibrary::onMediaDeleted( std::set<int64_t> mediaIds )
 {
+    invalidateMediaCursor();
     wrapEntityDeletedEventCallback( m_vlc_ml, mediaIds, VLC_ML_EVENT_MEDIA_DELETED );
 }
 
@@ -928,83 +931,13 @@ int MediaLibrary::List( int listQuery, const vlc_ml_query_params_t* params, va_l
             return listArtists( listQuery, paramsPtr, psz_pattern, nbItems, offset, args );
 
         case VLC_ML_LIST_MEDIA:
-        {
-            medialibrary::Query<medialibrary::IMedia> query;
-            if ( psz_pattern != nullptr )
-                query = m_ml->searchMedia( psz_pattern, paramsPtr );
-            else
-                query = m_ml->mediaFiles( paramsPtr );
-            if ( query == nullptr )
-                return VLC_EGENERIC;
-            auto res = ml_convert_list<vlc_ml_media_list_t, vlc_ml_media_t>(
-                        query->items( nbItems, offset ) );
-            *va_arg( args, vlc_ml_media_list_t**) = res;
-            break;
-        }
         case VLC_ML_COUNT_MEDIA:
-        {
-            medialibrary::Query<medialibrary::IMedia> query;
-            if ( psz_pattern != nullptr )
-                query = m_ml->searchMedia( psz_pattern, paramsPtr );
-            else
-                query = m_ml->mediaFiles( paramsPtr );
-            if ( query == nullptr )
-                return VLC_EGENERIC;
-            *va_arg( args, size_t* ) = query->count();
-            break;
-        }
         case VLC_ML_LIST_VIDEOS:
-        {
-            medialibrary::Query<medialibrary::IMedia> query;
-            if ( psz_pattern != nullptr )
-                query = m_ml->searchVideo( psz_pattern, paramsPtr );
-            else
-                query = m_ml->videoFiles( paramsPtr );
-            if ( query == nullptr )
-                return VLC_EGENERIC;
-            auto res = ml_convert_list<vlc_ml_media_list_t, vlc_ml_media_t>(
-                        query->items( nbItems, offset ) );
-            *va_arg( args, vlc_ml_media_list_t**) = res;
-            break;
-        }
         case VLC_ML_COUNT_VIDEOS:
-        {
-            medialibrary::Query<medialibrary::IMedia> query;
-            if ( psz_pattern != nullptr )
-                query = m_ml->searchVideo( psz_pattern, paramsPtr );
-            else
-                query = m_ml->videoFiles( paramsPtr );
-            if ( query == nullptr )
-                return VLC_EGENERIC;
-            *va_arg( args, size_t* ) = query->count();
-            break;
-        }
         case VLC_ML_LIST_AUDIOS:
-        {
-            medialibrary::Query<medialibrary::IMedia> query;
-            if ( psz_pattern != nullptr )
-                query = m_ml->searchAudio( psz_pattern, paramsPtr );
-            else
-                query = m_ml->audioFiles( paramsPtr );
-            if ( query == nullptr )
-                return VLC_EGENERIC;
-            auto res = ml_convert_list<vlc_ml_media_list_t, vlc_ml_media_t>(
-                        query->items( nbItems, offset ) );
-            *va_arg( args, vlc_ml_media_list_t**) = res;
-            break;
-        }
         case VLC_ML_COUNT_AUDIOS:
-        {
-            medialibrary::Query<medialibrary::IMedia> query;
-            if ( psz_pattern != nullptr )
-                query = m_ml->searchAudio( psz_pattern, paramsPtr );
-            else
-                query = m_ml->audioFiles( paramsPtr );
-            if ( query == nullptr )
-                return VLC_EGENERIC;
-            *va_arg( args, size_t* ) = query->count();
-            break;
-        }
+            return listAllMedia( listQuery, paramsPtr, psz_pattern, nbItems,
+                                 offset, args );
         case VLC_ML_LIST_ALBUMS:
         {
             medialibrary::Query<medialibrary::IAlbum> query;
@@ -2253,6 +2186,104 @@ int MediaLibrary::listMedia( int listQuery, const medialibrary::QueryParameters
     }
 }
 
+int MediaLibrary::listAllMedia( int listQuery, const medialibrary::QueryParameters* paramsPtr,
+                                const char* pattern, uint32_t nbItems, uint32_t offset,
+                                va_list args )
+{
+    /* LIST and COUNT of the same listing share one cursor, as the UI
+     * issues them in pairs */
+    int canonicalQuery;
+    switch ( listQuery )
+    {
+        case VLC_ML_LIST_MEDIA:
+        case VLC_ML_COUNT_MEDIA:
+            canonicalQuery = VLC_ML_LIST_MEDIA;
+            break;
+        case VLC_ML_LIST_VIDEOS:
+        case VLC_ML_COUNT_VIDEOS:
+            canonicalQuery = VLC_ML_LIST_VIDEOS;
+            break;
+        default:
+            canonicalQuery = VLC_ML_LIST_AUDIOS;
+            break;
+    }
+
+    vlc::threads::mutex_locker lock( m_cursorMutex );
+
+    const bool reusable = m_cursor.query != nullptr &&
+        m_cursor.listQuery == canonicalQuery &&
+        m_cursor.hasParams == ( paramsPtr != nullptr ) &&
+        ( paramsPtr == nullptr ||
+          ( m_cursor.desc == paramsPtr->desc &&
+            m_cursor.sort == paramsPtr->sort &&
+            m_cursor.favoriteOnly == paramsPtr->favoriteOnly &&
+            m_cursor.publicOnly == paramsPtr->publicOnly ) ) &&
+        m_cursor.hasPattern == ( pattern != nullptr ) &&
+        ( pattern == nullptr || m_cursor.pattern == pattern );
+
+    if ( reusable == false )
+    {
+        medialibrary::Query<medialibrary::IMedia> query;
+        switch ( canonicalQuery )
+        {
+            case VLC_ML_LIST_MEDIA:
+                if ( pattern != nullptr )
+                    query = m_ml->searchMedia( pattern, paramsPtr );
+                else
+                    query = m_ml->mediaFiles( paramsPtr );
+                break;
+            case VLC_ML_LIST_VIDEOS:
+                if ( pattern != nullptr )
+                    query = m_ml->searchVideo( pattern, paramsPtr );
+                else
+                    query = m_ml->videoFiles( paramsPtr );
+                break;
+            default:
+                if ( pattern != nullptr )
+                    query = m_ml->searchAudio( pattern, paramsPtr );
+                else
+                    query = m_ml->audioFiles( paramsPtr );
+                break;
+        }
+        if ( query == nullptr )
+            return VLC_EGENERIC;
+
+        m_cursor.query = std::move( query );
+        m_cursor.listQuery = canonicalQuery;
+        m_cursor.hasParams = paramsPtr != nullptr;
+        if ( paramsPtr != nullptr )
+        {
+            m_cursor.desc = paramsPtr->desc;
+            m_cursor.sort = paramsPtr->sort;
+            m_cursor.favoriteOnly = paramsPtr->favoriteOnly;
+            m_cursor.publicOnly = paramsPtr->publicOnly;
+        }
+        m_cursor.hasPattern = pattern != nullptr;
+        m_cursor.pattern = pattern != nullptr ? pattern : "";
+    }
+
+    switch ( listQuery )
+    {
+        case VLC_ML_LIST_MEDIA:
+        case VLC_ML_LIST_VIDEOS:
+        case VLC_ML_LIST_AUDIOS:
+            *va_arg( args, vlc_ml_media_list_t** ) =
+                    ml_convert_list<vlc_ml_media_list_t, vlc_ml_media_t>(
+                        m_cursor.query->items( nbItems, offset ) );
+            return VLC_SUCCESS;
+        default:
+            *va_arg( args, size_t* ) = m_cursor.query->count();
+            return VLC_SUCCESS;
+    }
+}
+
+void MediaLibrary::invalidateMediaCursor()
+{
+    vlc::threads::mutex_locker lock( m_cursorMutex );
+    m_cursor.query = nullptr;
+    m_cursor.listQuery = -1;
+}
+
 medialibrary::PriorityAccess MediaLibrary::acquirePriorityAccess()
 {
     return m_ml->acquirePriorityAccess();
@@ -36,6 +36,7 @@
 #include <vlc_cxx_helpers.hpp>
 
 #include <cstdarg>
+#include <string>
 #include <type_traits>
 
 struct vlc_event_t;
@@ -180,6 +181,9 @@ private:
                       const char* pattern, uint32_t nbItems, uint32_t offset, va_list args );
     int listMedia( int listQuery, const medialibrary::QueryParameters* paramsPtr,
                    const char* pattern, uint32_t nbItems, uint32_t offset, va_list args );
+    int listAllMedia( int listQuery, const medialibrary::QueryParameters* paramsPtr,
+                      const char* pattern, uint32_t nbItems, uint32_t offset, va_list args );
+    void invalidateMediaCursor();
 
     medialibrary::PriorityAccess acquirePriorityAccess();
 
@@ -195,6 +199,27 @@ private:
     vlc::threads::mutex m_mutex;
     bool m_initialized = false; /* protected by m_mutex */
 
+    /* Pagination cursor for the flat media listings (all/video/audio).
+     * The UI pages through these sorted listings in small slices;
+     * re-creating the medialibrary query for every page re-plans the
+     * statement and re-runs the count, so the last query is kept and its
+     * items()/count() reused while only offset and page size change.
+     * Guarded by m_cursorMutex, invalidated by the media change
+     * callbacks. */
+    struct
+    {
+        int listQuery = -1; /* canonical VLC_ML_LIST_* query, or -1 */
+        bool hasParams = false;
+        bool desc = false;
+        bool favoriteOnly = false;
+        bool publicOnly = false;
+        medialibrary::SortingCriteria sort = medialibrary::SortingCriteria::Default;
+        bool hasPattern = false;
+        std::string pattern;
+        medialibrary::Query<medialibrary::IMedia> query;
+    } m_cursor;
+    vlc::threads::mutex m_cursorMutex;
+
     std::atomic_flag m_started = ATOMIC_FLAG_INIT;
 
     // IMediaLibraryCb interface
@@ -202,15 +202,18 @@ bool mp4mux_track_AddSample(mp4mux_trackinfo_t *t, const mp4mux_sample_t *entry)
     /* XXX: -1 to always have 2 entry for easy adding of empty SPU */
     if (t->i_samples_count + 2 >= t->i_samples_max)
     {
-        if(t->i_samples_max + 1000 < t->i_samples_max)
+        /* Grow geometrically: fixed increments would make long recordings
+         * spend quadratic time copying the sample table around */
+        unsigned i_new_max = t->i_samples_max ? t->i_samples_max * 2 : 1000;
+        if(i_new_max <= t->i_samples_max)
             return false;
         mp4mux_sample_t *p_realloc = vlc_reallocarray(t->samples,
-                                                      t->i_samples_max + 1000,
+                                                      i_new_max,
                                                       sizeof(*p_realloc));
         if(!p_realloc)
             return false;
         t->samples = p_realloc;
-        t->i_samples_max += 1000;
+        t->i_samples_max = i_new_max;
     }
     t->samples[t->i_samples_count++] = *entry;
     if(!t->b_hasbframes && entry->i_pts_dts != 0)
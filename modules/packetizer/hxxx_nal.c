@@ -122,16 +122,40 @@ block_t *hxxx_AnnexB_to_xVC( block_t *p_block, uint8_t i_nal_length_size )
 
     if( p_list[i_nalcount - 1].move != 0 || i_nal_length_size != 4 )  /* We'll need to grow or shrink */
     {
-        block_t *p_newblock = block_Alloc( i_dest );
-        if( unlikely(!p_newblock) )
-            goto error;
+        /* With 4 bytes prefixes and enough room after the payload, grow the
+         * block in place and rewrite the start codes there rather than copy
+         * every NAL into a new allocation (common remux case where only a
+         * few 3 bytes start codes need to become 4 bytes prefixes). The
+         * reverse order moves below support overlapping buffers when
+         * growing. */
+        if( i_nal_length_size == 4 &&
+            (size_t)(&p_block->p_start[p_block->i_size] - p_block->p_buffer) >= i_dest )
+        {
+            const size_t i_payload = p_block->i_buffer;
+            block_t *p_newblock = block_Realloc( p_block, 0, i_dest );
+            if( unlikely(!p_newblock) )
+            {
+                /* block_Realloc released the block */
+                free( p_list );
+                return NULL;
+            }
+            p_block = p_newblock;
+            p_source = p_dest = p_block->p_buffer;
+            p_sourceend = &p_block->p_buffer[i_payload];
+        }
+        else
+        {
+            block_t *p_newblock = block_Alloc( i_dest );
+            if( unlikely(!p_newblock) )
+                goto error;
 
-        p_release = p_block; /* Will be released after use */
-        p_source = p_release->p_buffer;
-        p_sourceend = &p_release->p_buffer[p_release->i_buffer];
+            p_release = p_block; /* Will be released after use */
+            p_source = p_release->p_buffer;
+            p_sourceend = &p_release->p_buffer[p_release->i_buffer];
 
-        p_block = p_newblock;
-        p_dest = p_newblock->p_buffer;
+            p_block = p_newblock;
+            p_dest = p_newblock->p_buffer;
+        }
     }
     else
     {
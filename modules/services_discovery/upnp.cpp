@@ -40,6 +40,8 @@
 #include <vlc_interrupt.h>
 #include <vlc_services_discovery.h>
 #include <vlc_renderer_discovery.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
 
 #include <cassert>
 #include <limits.h>
@@ -56,6 +58,8 @@ const char* CONTENT_DIRECTORY_SERVICE_TYPE = "urn:schemas-upnp-org:service:Conte
 const char* SATIP_SERVER_DEVICE_TYPE = "urn:ses-com:device:SatIPServer:1";
 
 #define UPNP_SEARCH_TIMEOUT_SECONDS 15
+/* Validity of a persisted device description that was not re-announced */
+#define UPNP_CACHE_TTL (24 * 60 * 60)
 #define SATIP_CHANNEL_LIST_URL N_("Custom SAT>IP channel list URL")
 
 #define HTTP_PORT         7070
@@ -252,6 +256,64 @@ static const char *parseBaseUrl( IXML_Document *p_desc )
     return psz_base_url;
 }
 
+/*
+ * Persistent discovery cache.
+ *
+ * Known device descriptions are written to a small tab-separated file in
+ * the user cache directory, so they can be announced instantly at the
+ * next discovery start while the regular SSDP search re-verifies them in
+ * the background. Entries not re-announced within UPNP_CACHE_TTL are
+ * dropped on load; byebye notifications remove them immediately.
+ */
+static char *cacheFilePath( const char *psz_name )
+{
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if ( unlikely( psz_dir == NULL ) )
+        return NULL;
+
+    vlc_mkdir( psz_dir, 0700 );
+
+    char *psz_path;
+    if ( asprintf( &psz_path, "%s" DIR_SEP "%s", psz_dir, psz_name ) == -1 )
+        psz_path = NULL;
+    free( psz_dir );
+    return psz_path;
+}
+
+/* Record fields may not contain the separators */
+static bool cacheFieldOk( const std::string& s )
+{
+    return s.find_first_of( "\t\n" ) == std::string::npos;
+}
+
+/* Splits a record in place into exactly i_fields tab-separated fields */
+static bool cacheSplitLine( char *psz_line, const char **fields, size_t i_fields )
+{
+    char *psz_end = strchr( psz_line, '\n' );
+    if ( psz_end )
+        *psz_end = '\0';
+
+    for ( size_t i = 0; i < i_fields; i++ )
+    {
+        fields[i] = psz_line;
+        char *psz_sep = strchr( psz_line, '\t' );
+        if ( psz_sep == NULL )
+            return i == i_fields - 1;
+        *psz_sep = '\0';
+        psz_line = psz_sep + 1;
+    }
+    return false;
+}
+
+/* Returns the last-seen date of a cache record, or -1 if expired */
+static time_t cacheEntryDate( const char *psz_field, time_t now )
+{
+    long long i_seen = strtoll( psz_field, NULL, 10 );
+    if ( i_seen <= 0 || now < i_seen || now - i_seen > UPNP_CACHE_TTL )
+        return -1;
+    return (time_t)i_seen;
+}
+
 namespace SD
 {
 
@@ -311,6 +373,11 @@ static int OpenSD( vlc_object_t *p_this )
         delete p_sys;
         return VLC_EGENERIC;
     }
+
+    /* Announce the previously discovered servers right away; the search
+     * below re-verifies them in the background */
+    p_sys->p_server_list->restoreCache();
+
     p_sys->p_upnp->addListener( p_sys->p_server_list );
 
     /* XXX: Contrary to what the libupnp doc states, UpnpSearchAsync is
@@ -349,6 +416,7 @@ MediaServerDesc::MediaServerDesc( const std::string& udn, const std::string& fNa
     , iconUrl( iconUrl )
     , inputItem( NULL )
     , isSatIp( false )
+    , lastSeen( time( NULL ) )
 {
 }
 
@@ -371,11 +439,94 @@ MediaServerList::~MediaServerList()
     vlc_delete_all(m_list);
 }
 
+void MediaServerList::saveCache()
+{
+    char *psz_path = cacheFilePath( "upnp-servers.cache" );
+    if ( !psz_path )
+        return;
+
+    FILE *p_file = vlc_fopen( psz_path, "wt" );
+    free( psz_path );
+    if ( !p_file )
+        return;
+
+    for ( const MediaServerDesc* desc : m_list )
+    {
+        if ( !cacheFieldOk( desc->UDN ) || !cacheFieldOk( desc->friendlyName ) ||
+             !cacheFieldOk( desc->location ) || !cacheFieldOk( desc->iconUrl ) ||
+             !cacheFieldOk( desc->satIpHost ) )
+            continue;
+        fprintf( p_file, "%lld\t%d\t%s\t%s\t%s\t%s\t%s\n",
+                 (long long)desc->lastSeen, desc->isSatIp ? 1 : 0,
+                 desc->UDN.c_str(), desc->friendlyName.c_str(),
+                 desc->location.c_str(), desc->iconUrl.c_str(),
+                 desc->satIpHost.c_str() );
+    }
+    fclose( p_file );
+}
+
+void MediaServerList::restoreCache()
+{
+    char *psz_path = cacheFilePath( "upnp-servers.cache" );
+    if ( !psz_path )
+        return;
+
+    FILE *p_file = vlc_fopen( psz_path, "rt" );
+    free( psz_path );
+    if ( !p_file )
+        return;
+
+    const time_t now = time( NULL );
+    unsigned i_count = 0;
+    char *psz_line = NULL;
+    size_t i_size = 0;
+
+    m_restoring = true;
+    while ( getline( &psz_line, &i_size, p_file ) != -1 )
+    {
+        const char *fields[7];
+        if ( !cacheSplitLine( psz_line, fields, 7 ) )
+            continue;
+
+        time_t seen = cacheEntryDate( fields[0], now );
+        if ( seen == -1 )
+            continue;
+
+        MediaServerDesc* desc = new(std::nothrow)
+            MediaServerDesc( fields[2], fields[3], fields[4], fields[5] );
+        if ( unlikely( !desc ) )
+            break;
+        desc->lastSeen = seen;
+        if ( atoi( fields[1] ) )
+        {
+            desc->isSatIp = true;
+            desc->satIpHost = fields[6];
+        }
+
+        if ( !addServer( desc ) )
+            delete desc;
+        else
+            i_count++;
+    }
+    m_restoring = false;
+
+    free( psz_line );
+    fclose( p_file );
+    if ( i_count > 0 )
+        msg_Dbg( m_sd, "announced %u cached media server(s)", i_count );
+}
+
 bool MediaServerList::addServer( MediaServerDesc* desc )
 {
     input_item_t* p_input_item = NULL;
-    if ( getServer( desc->UDN ) )
+    if ( MediaServerDesc* p_existing = getServer( desc->UDN ) )
+    {
+        /* Re-announced: refresh the cache validity of the known device */
+        p_existing->lastSeen = time( NULL );
+        if ( !m_restoring )
+            saveCache();
         return false;
+    }
 
     msg_Dbg( m_sd, "Adding server '%s' with uuid '%s'", desc->friendlyName.c_str(), desc->UDN.c_str() );
 
@@ -435,6 +586,8 @@ bool MediaServerList::addServer( MediaServerDesc* desc )
     services_discovery_AddItem( m_sd, p_input_item );
     m_list.push_back( desc );
 
+    if ( !m_restoring )
+        saveCache();
     return true;
 }
 
@@ -518,9 +671,11 @@ void MediaServerList::parseNewServer( IXML_Document *doc, const std::string &loc
         }
 
         /* Check if server is already added */
-        if ( getServer( psz_udn ) )
+        if ( MediaServerDesc* p_existing = getServer( psz_udn ) )
         {
             msg_Warn( m_sd, "Server with uuid '%s' already exists.", psz_udn );
+            p_existing->lastSeen = time( NULL );
+            saveCache();
             continue;
         }
 
@@ -725,6 +880,7 @@ void MediaServerList::removeServer( const std::string& udn )
         m_list.erase( it );
     }
     delete p_server;
+    saveCache();
 }
 
 /*
@@ -1381,6 +1537,7 @@ MediaRendererDesc::MediaRendererDesc( const std::string& udn,
     , base_url( base )
     , location( loc )
     , inputItem( NULL )
+    , lastSeen( time( NULL ) )
 {
 }
 
@@ -1400,6 +1557,78 @@ MediaRendererList::~MediaRendererList()
     vlc_delete_all(m_list);
 }
 
+void MediaRendererList::saveCache()
+{
+    char *psz_path = cacheFilePath( "upnp-renderers.cache" );
+    if ( !psz_path )
+        return;
+
+    FILE *p_file = vlc_fopen( psz_path, "wt" );
+    free( psz_path );
+    if ( !p_file )
+        return;
+
+    for ( const MediaRendererDesc* desc : m_list )
+    {
+        if ( !cacheFieldOk( desc->UDN ) || !cacheFieldOk( desc->friendlyName ) ||
+             !cacheFieldOk( desc->base_url ) || !cacheFieldOk( desc->location ) )
+            continue;
+        fprintf( p_file, "%lld\t%s\t%s\t%s\t%s\n",
+                 (long long)desc->lastSeen, desc->UDN.c_str(),
+                 desc->friendlyName.c_str(), desc->base_url.c_str(),
+                 desc->location.c_str() );
+    }
+    fclose( p_file );
+}
+
+void MediaRendererList::restoreCache()
+{
+    char *psz_path = cacheFilePath( "upnp-renderers.cache" );
+    if ( !psz_path )
+        return;
+
+    FILE *p_file = vlc_fopen( psz_path, "rt" );
+    free( psz_path );
+    if ( !p_file )
+        return;
+
+    const time_t now = time( NULL );
+    unsigned i_count = 0;
+    char *psz_line = NULL;
+    size_t i_size = 0;
+
+    m_restoring = true;
+    while ( getline( &psz_line, &i_size, p_file ) != -1 )
+    {
+        const char *fields[5];
+        if ( !cacheSplitLine( psz_line, fields, 5 ) )
+            continue;
+
+        time_t seen = cacheEntryDate( fields[0], now );
+        if ( seen == -1 )
+            continue;
+        if ( getRenderer( fields[1] ) )
+            continue;
+
+        MediaRendererDesc *desc = new(std::nothrow)
+            MediaRendererDesc( fields[1], fields[2], fields[3], fields[4] );
+        if ( unlikely( !desc ) )
+            break;
+        desc->lastSeen = seen;
+
+        if ( !addRenderer( desc ) )
+            delete desc;
+        else
+            i_count++;
+    }
+    m_restoring = false;
+
+    free( psz_line );
+    fclose( p_file );
+    if ( i_count > 0 )
+        msg_Dbg( m_rd, "announced %u cached renderer(s)", i_count );
+}
+
 bool MediaRendererList::addRenderer(MediaRendererDesc *desc)
 {
     const char* psz_url = getUrl(desc->location.c_str());
@@ -1422,6 +1651,8 @@ bool MediaRendererList::addRenderer(MediaRendererDesc *desc)
                         desc->UDN.c_str() );
     vlc_rd_add_item(m_rd, desc->inputItem);
     m_list.push_back(desc);
+    if ( !m_restoring )
+        saveCache();
     return true;
 }
 
@@ -1458,6 +1689,7 @@ void MediaRendererList::removeRenderer( const std::string& udn )
         m_list.erase( it );
     }
     delete p_renderer;
+    saveCache();
 }
 
 void MediaRendererList::parseNewRenderer( IXML_Document* doc,
@@ -1503,9 +1735,11 @@ void MediaRendererList::parseNewRenderer( IXML_Document* doc,
         }
 
         /* Check if renderer is already added */
-        if (getRenderer( psz_udn ))
+        if (MediaRendererDesc *p_existing = getRenderer( psz_udn ))
         {
             msg_Warn( m_rd, "Renderer with UDN '%s' already exists.", psz_udn );
+            p_existing->lastSeen = time( NULL );
+            saveCache();
             continue;
         }
 
@@ -1596,6 +1830,11 @@ try
         return VLC_EGENERIC;
 
     p_sys->p_renderer_list = std::make_shared<RD::MediaRendererList>( p_rd );
+
+    /* Announce the previously discovered renderers right away; the search
+     * below re-verifies them in the background */
+    p_sys->p_renderer_list->restoreCache();
+
     p_sys->p_upnp->addListener( p_sys->p_renderer_list );
 
     if( vlc_clone( &p_sys->thread, SearchThread, (void*)p_rd ) )
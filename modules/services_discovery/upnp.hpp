@@ -26,6 +26,7 @@
 
 #include <vector>
 #include <string>
+#include <ctime>
 
 #include "upnp-wrapper.hpp"
 #include "../stream_out/dlna/dlna_common.hpp"
@@ -50,6 +51,7 @@ struct MediaServerDesc
     input_item_t* inputItem;
     bool isSatIp;
     std::string satIpHost;
+    time_t lastSeen; /* last announcement, for cache TTL validation */
 };
 
 
@@ -63,6 +65,7 @@ public:
     bool addServer(MediaServerDesc *desc );
     void removeServer(const std::string &udn );
     MediaServerDesc* getServer( const std::string& udn );
+    void restoreCache();
     int onEvent( Upnp_EventType event_type,
                  UpnpEventPtr p_event,
                  void* p_user_data ) override;
@@ -71,10 +74,12 @@ private:
     void parseNewServer( IXML_Document* doc, const std::string& location );
     void parseSatipServer( IXML_Element* p_device_elem, const char *psz_base_url, const char *psz_udn, const char *psz_friendly_name, std::string iconUrl );
     std::string getIconURL( IXML_Element* p_device_elem , const char* psz_base_url );
+    void saveCache();
 
 private:
     services_discovery_t* const m_sd;
     std::vector<MediaServerDesc*> m_list;
+    bool m_restoring = false;
 };
 
 }
@@ -139,6 +144,7 @@ struct MediaRendererDesc
     std::string base_url;               // base url of the renderer
     std::string location;               // device description url
     vlc_renderer_item_t *inputItem;
+    time_t lastSeen; /* last announcement, for cache TTL validation */
 };
 
 class MediaRendererList : public UpnpInstanceWrapper::Listener
@@ -150,16 +156,19 @@ public:
     bool addRenderer(MediaRendererDesc *desc );
     void removeRenderer(const std::string &udn );
     MediaRendererDesc* getRenderer( const std::string& udn );
+    void restoreCache();
     int onEvent( Upnp_EventType event_type,
                  UpnpEventPtr p_event,
                  void* p_user_data ) override;
 
 private:
     void parseNewRenderer( IXML_Document* doc, const std::string& location );
+    void saveCache();
 
 private:
     vlc_renderer_discovery_t* const m_rd;
     std::vector<MediaRendererDesc*> m_list;
+    bool m_restoring = false;
 
 };
 
@@ -0,0 +1,492 @@
+/*****************************************************************************
+ * watchfolder.c : watched folder discovery using inotify
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_services_discovery.h>
+#include <vlc_threads.h>
+#include <vlc_list.h>
+#include <vlc_url.h>
+#include <vlc_fs.h>
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+/* Files are announced on IN_CLOSE_WRITE or IN_MOVED_TO, not IN_CREATE, so
+ * that an ingest process still writing a file does not expose it early.
+ * Directories have no close event and are watched as soon as they appear. */
+#define WATCH_MASK (IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | \
+                    IN_MOVED_TO | IN_DELETE_SELF | IN_EXCL_UNLINK | IN_ONLYDIR)
+
+/* A burst of events (copy of a large tree, batch rename) is drained and
+ * applied in one pass once the folder has been quiet for this long... */
+#define WATCH_DEBOUNCE_MS  250
+/* ...but never later than this, so updates cannot be starved by constant
+ * churn. */
+#define WATCH_BATCH_MAX    VLC_TICK_FROM_MS(1000)
+
+struct watch
+{
+    struct vlc_list node;
+    int wd;
+    char *psz_path;
+};
+
+struct entry
+{
+    struct vlc_list node;
+    input_item_t *p_item;
+    char *psz_path;
+};
+
+struct pending
+{
+    struct vlc_list node;
+    bool b_add;
+    char *psz_path;
+};
+
+typedef struct
+{
+    int fd;
+    char *psz_root;
+    vlc_thread_t thread;
+    struct vlc_list watches; /**< list of struct watch */
+    struct vlc_list entries; /**< list of struct entry */
+    struct vlc_list pending; /**< list of struct pending */
+} services_discovery_sys_t;
+
+static struct watch *WatchFind( services_discovery_sys_t *p_sys, int wd )
+{
+    struct watch *w;
+
+    vlc_list_foreach( w, &p_sys->watches, node )
+        if( w->wd == wd )
+            return w;
+    return NULL;
+}
+
+static struct entry *EntryFind( services_discovery_sys_t *p_sys,
+                                const char *psz_path )
+{
+    struct entry *e;
+
+    vlc_list_foreach( e, &p_sys->entries, node )
+        if( !strcmp( e->psz_path, psz_path ) )
+            return e;
+    return NULL;
+}
+
+static void EntryAdd( services_discovery_t *p_sd, const char *psz_path )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    char *psz_uri = vlc_path2uri( psz_path, "file" );
+
+    if( psz_uri == NULL )
+        return;
+
+    const char *psz_name = strrchr( psz_path, '/' );
+    psz_name = ( psz_name != NULL ) ? psz_name + 1 : psz_path;
+
+    input_item_t *p_item = input_item_New( psz_uri, psz_name );
+    free( psz_uri );
+    if( p_item == NULL )
+        return;
+
+    struct entry *e = malloc( sizeof( *e ) );
+    if( e == NULL || ( e->psz_path = strdup( psz_path ) ) == NULL )
+    {
+        free( e );
+        input_item_Release( p_item );
+        return;
+    }
+    e->p_item = p_item;
+    vlc_list_append( &e->node, &p_sys->entries );
+
+    services_discovery_AddItem( p_sd, p_item );
+}
+
+static void EntryRemove( services_discovery_t *p_sd, struct entry *e )
+{
+    services_discovery_RemoveItem( p_sd, e->p_item );
+    input_item_Release( e->p_item );
+    vlc_list_remove( &e->node );
+    free( e->psz_path );
+    free( e );
+}
+
+static void QueueOp( services_discovery_t *p_sd, bool b_add,
+                     const char *psz_path )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    struct pending *p = malloc( sizeof( *p ) );
+
+    if( p == NULL || ( p->psz_path = strdup( psz_path ) ) == NULL )
+    {
+        free( p );
+        return;
+    }
+    p->b_add = b_add;
+    vlc_list_append( &p->node, &p_sys->pending );
+}
+
+static void ApplyPending( services_discovery_t *p_sd )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    struct pending *p;
+
+    vlc_list_foreach( p, &p_sys->pending, node )
+    {
+        struct entry *e = EntryFind( p_sys, p->psz_path );
+
+        if( p->b_add )
+        {
+            if( e == NULL )
+                EntryAdd( p_sd, p->psz_path );
+        }
+        else if( e != NULL )
+            EntryRemove( p_sd, e );
+
+        vlc_list_remove( &p->node );
+        free( p->psz_path );
+        free( p );
+    }
+}
+
+static void WatchAdd( services_discovery_t *p_sd, const char *psz_path );
+
+/** Watches one directory and queues its current regular files. */
+static void WatchScan( services_discovery_t *p_sd, const char *psz_path )
+{
+    vlc_DIR *p_dir = vlc_opendir( psz_path );
+
+    if( p_dir == NULL )
+        return;
+
+    const char *psz_entry;
+    while( ( psz_entry = vlc_readdir( p_dir ) ) != NULL )
+    {
+        if( psz_entry[0] == '.' ) /* hidden, "." and ".." */
+            continue;
+
+        char *psz_full;
+        if( asprintf( &psz_full, "%s/%s", psz_path, psz_entry ) == -1 )
+            continue;
+
+        struct stat st;
+        if( vlc_lstat( psz_full, &st ) == 0 )
+        {
+            if( S_ISDIR( st.st_mode ) )
+                WatchAdd( p_sd, psz_full );
+            else if( S_ISREG( st.st_mode ) )
+                QueueOp( p_sd, true, psz_full );
+        }
+        free( psz_full );
+    }
+    vlc_closedir( p_dir );
+}
+
+static void WatchAdd( services_discovery_t *p_sd, const char *psz_path )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    int wd = inotify_add_watch( p_sys->fd, psz_path, WATCH_MASK );
+
+    if( wd == -1 )
+    {
+        msg_Warn( p_sd, "cannot watch %s: %s", psz_path,
+                  vlc_strerror_c(errno) );
+        return;
+    }
+    if( WatchFind( p_sys, wd ) != NULL )
+        return; /* already watched (rename of a known directory) */
+
+    struct watch *w = malloc( sizeof( *w ) );
+    if( w == NULL || ( w->psz_path = strdup( psz_path ) ) == NULL )
+    {
+        free( w );
+        inotify_rm_watch( p_sys->fd, wd );
+        return;
+    }
+    w->wd = wd;
+    vlc_list_append( &w->node, &p_sys->watches );
+
+    /* The directory may already hold files (initial scan, or files created
+     * between mkdir and the watch registration). */
+    WatchScan( p_sd, psz_path );
+}
+
+static void WatchRemove( services_discovery_sys_t *p_sys, struct watch *w )
+{
+    inotify_rm_watch( p_sys->fd, w->wd );
+    vlc_list_remove( &w->node );
+    free( w->psz_path );
+    free( w );
+}
+
+static bool PathIsUnder( const char *psz_path, const char *psz_dir )
+{
+    size_t len = strlen( psz_dir );
+
+    return !strncmp( psz_path, psz_dir, len ) && psz_path[len] == '/';
+}
+
+/** Drops the items and watches under a directory that went away wholesale
+ * (moved out of the tree): no per-file events are generated for those. */
+static void PruneSubtree( services_discovery_t *p_sd, const char *psz_path )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    struct entry *e;
+    struct watch *w;
+
+    vlc_list_foreach( e, &p_sys->entries, node )
+        if( PathIsUnder( e->psz_path, psz_path ) )
+            EntryRemove( p_sd, e );
+
+    vlc_list_foreach( w, &p_sys->watches, node )
+        if( PathIsUnder( w->psz_path, psz_path ) )
+            WatchRemove( p_sys, w );
+}
+
+/** Rebuilds the whole tree, used when the kernel event queue overflowed. */
+static void Rescan( services_discovery_t *p_sd )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    struct entry *e;
+    struct watch *w;
+
+    msg_Warn( p_sd, "event queue overflow, rescanning %s", p_sys->psz_root );
+
+    vlc_list_foreach( e, &p_sys->entries, node )
+        EntryRemove( p_sd, e );
+    vlc_list_foreach( w, &p_sys->watches, node )
+        WatchRemove( p_sys, w );
+
+    WatchAdd( p_sd, p_sys->psz_root );
+}
+
+static void ProcessEvent( services_discovery_t *p_sd,
+                          const struct inotify_event *ev )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+
+    if( ev->mask & IN_Q_OVERFLOW )
+    {
+        Rescan( p_sd );
+        return;
+    }
+
+    struct watch *w = WatchFind( p_sys, ev->wd );
+    if( w == NULL )
+        return;
+
+    if( ev->mask & IN_DELETE_SELF )
+    {
+        WatchRemove( p_sys, w );
+        return;
+    }
+    if( ev->len == 0 || ev->name[0] == '.' )
+        return;
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s/%s", w->psz_path, ev->name ) == -1 )
+        return;
+
+    if( ev->mask & IN_ISDIR )
+    {
+        if( ev->mask & (IN_CREATE | IN_MOVED_TO) )
+            WatchAdd( p_sd, psz_path );
+        else if( ev->mask & (IN_DELETE | IN_MOVED_FROM) )
+            PruneSubtree( p_sd, psz_path );
+    }
+    else
+    {
+        if( ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO) )
+            QueueOp( p_sd, true, psz_path );
+        else if( ev->mask & (IN_DELETE | IN_MOVED_FROM) )
+            QueueOp( p_sd, false, psz_path );
+    }
+    free( psz_path );
+}
+
+static void ReadEvents( services_discovery_t *p_sd )
+{
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    union
+    {
+        struct inotify_event ev;
+        char buf[4096];
+    } u;
+    ssize_t len;
+
+    while( ( len = read( p_sys->fd, u.buf, sizeof (u.buf) ) ) > 0 )
+    {
+        for( ssize_t off = 0; off < len; )
+        {
+            const struct inotify_event *ev = (void *)(u.buf + off);
+
+            ProcessEvent( p_sd, ev );
+            off += sizeof (*ev) + ev->len;
+        }
+    }
+}
+
+/*****************************************************************************
+ * Run: main thread
+ *****************************************************************************/
+static void *Run( void *data )
+{
+    services_discovery_t *p_sd = data;
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+
+    vlc_thread_set_name("vlc-watchfold");
+
+    int canc = vlc_savecancel();
+    WatchAdd( p_sd, p_sys->psz_root );
+    ApplyPending( p_sd );
+    vlc_restorecancel( canc );
+
+    for( ;; )
+    {
+        struct pollfd ufd = { .fd = p_sys->fd, .events = POLLIN };
+
+        poll( &ufd, 1, -1 ); /* cancellation point */
+
+        canc = vlc_savecancel();
+
+        /* Debounce: drain bursts until the folder goes quiet, then apply
+         * the coalesced batch in one pass. */
+        vlc_tick_t deadline = vlc_tick_now() + WATCH_BATCH_MAX;
+        do
+            ReadEvents( p_sd );
+        while( vlc_tick_now() < deadline
+            && poll( &ufd, 1, WATCH_DEBOUNCE_MS ) > 0 );
+
+        ApplyPending( p_sd );
+        vlc_restorecancel( canc );
+    }
+    return NULL;
+}
+
+static int Open( vlc_object_t *p_this )
+{
+    services_discovery_t *p_sd = (services_discovery_t *)p_this;
+    services_discovery_sys_t *p_sys;
+
+    char *psz_root = var_InheritString( p_sd, "watchfolder-path" );
+    if( psz_root == NULL )
+    {
+        msg_Err( p_sd, "no folder configured (watchfolder-path)" );
+        return VLC_EGENERIC;
+    }
+
+    p_sys = malloc( sizeof( *p_sys ) );
+    if( p_sys == NULL )
+    {
+        free( psz_root );
+        return VLC_ENOMEM;
+    }
+
+    p_sys->fd = inotify_init1( IN_CLOEXEC | IN_NONBLOCK );
+    if( p_sys->fd == -1 )
+    {
+        msg_Err( p_sd, "cannot create inotify instance: %s",
+                 vlc_strerror_c(errno) );
+        free( psz_root );
+        free( p_sys );
+        return VLC_EGENERIC;
+    }
+
+    p_sys->psz_root = psz_root;
+    vlc_list_init( &p_sys->watches );
+    vlc_list_init( &p_sys->entries );
+    vlc_list_init( &p_sys->pending );
+
+    p_sd->p_sys = p_sys;
+    p_sd->description = _("Watched folders");
+
+    if( vlc_clone( &p_sys->thread, Run, p_sd ) )
+    {
+        vlc_close( p_sys->fd );
+        free( psz_root );
+        free( p_sys );
+        return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+static void Close( vlc_object_t *p_this )
+{
+    services_discovery_t *p_sd = (services_discovery_t *)p_this;
+    services_discovery_sys_t *p_sys = p_sd->p_sys;
+    struct watch *w;
+    struct entry *e;
+    struct pending *p;
+
+    vlc_cancel( p_sys->thread );
+    vlc_join( p_sys->thread, NULL );
+
+    vlc_list_foreach( p, &p_sys->pending, node )
+    {
+        free( p->psz_path );
+        free( p );
+    }
+    vlc_list_foreach( e, &p_sys->entries, node )
+    {
+        input_item_Release( e->p_item );
+        free( e->psz_path );
+        free( e );
+    }
+    vlc_list_foreach( w, &p_sys->watches, node )
+    {
+        free( w->psz_path );
+        free( w );
+    }
+
+    vlc_close( p_sys->fd );
+    free( p_sys->psz_root );
+    free( p_sys );
+}
+
+VLC_SD_PROBE_HELPER("watchfolder", N_("Watched folders"), SD_CAT_MYCOMPUTER)
+
+#define PATH_TEXT N_("Watched folder")
+#define PATH_LONGTEXT N_( \
+    "Absolute path of the folder whose media files are listed and kept " \
+    "up to date from filesystem change notifications." )
+
+vlc_module_begin()
+    set_shortname( "Watchfolder" )
+    set_description( N_("Watched folders") )
+    set_subcategory( SUBCAT_PLAYLIST_SD )
+    add_string( "watchfolder-path", NULL, PATH_TEXT, PATH_LONGTEXT )
+    set_capability( "services_discovery", 0 )
+    set_callbacks( Open, Close )
+    add_shortcut( "watchfolder" )
+
+    VLC_SD_PROBE_SUBMODULE
+vlc_module_end()
@@ -75,15 +75,19 @@ struct private_sys_t
 
     uint64_t i_offset;
 
-    uint8_t buffer[ 8192 ];
+    /* fewer, larger reads speed up (re-)decompression considerably */
+    uint8_t buffer[ 65536 ];
     bool b_seekable_source;
     bool b_seekable_archive;
 
     libarchive_callback_t** pp_callback_data;
     size_t i_callback_data;
 
-    const uint8_t *last_arcbuf;
-    size_t last_arcsize;
+    /* last decompressed data block, kept around so that reads within it are
+     * zero-copy and small backward seeks do not have to rewind the archive */
+    const uint8_t *p_block;
+    size_t i_block_size;
+    uint64_t i_block_offset;
 };
 
 struct libarchive_callback_t {
@@ -402,8 +406,9 @@ static int archive_extractor_reset( stream_extractor_t* p_extractor )
     p_sys->i_offset = 0;
     p_sys->b_eof = false;
     p_sys->b_dead = false;
-    p_sys->last_arcbuf = NULL;
-    p_sys->last_arcsize = 0;
+    p_sys->p_block = NULL;
+    p_sys->i_block_size = 0;
+    p_sys->i_block_offset = 0;
     return VLC_SUCCESS;
 }
 
@@ -429,8 +434,9 @@ static private_sys_t* setup( vlc_object_t* obj, stream_t* source,
 
     p_sys->source = source;
     p_sys->p_obj = obj;
-    p_sys->last_arcbuf = NULL;
-    p_sys->last_arcsize = 0;
+    p_sys->p_block = NULL;
+    p_sys->i_block_size = 0;
+    p_sys->i_block_offset = 0;
 
     return p_sys;
 
@@ -598,36 +604,40 @@ static ssize_t Read( stream_extractor_t *p_extractor, void* p_data, size_t i_siz
     if( p_sys->b_eof )
         return 0;
 
+    /* serve data still available in the last decompressed block */
+    if( p_sys->p_block != NULL
+     && p_sys->i_offset >= p_sys->i_block_offset
+     && p_sys->i_offset <  p_sys->i_block_offset + p_sys->i_block_size )
+    {
+        size_t i_skip = p_sys->i_offset - p_sys->i_block_offset;
+
+        if( i_size > p_sys->i_block_size - i_skip )
+            i_size = p_sys->i_block_size - i_skip;
+
+        if( p_data != NULL )
+            memcpy( p_data, p_sys->p_block + i_skip, i_size );
+
+        p_sys->i_offset += i_size;
+        return i_size;
+    }
+
     const void *arcbuf = NULL;
     size_t arcsize = 0;
     la_int64_t arcoffset = 0;
-    if( p_sys->last_arcbuf == NULL )
-    {
-        i_ret = archive_read_data_block( p_arc, &arcbuf, &arcsize, &arcoffset);
-        assert(arcoffset == (la_int64_t) p_sys->i_offset); (void)arcoffset;
-    }
-    else
-    {
-        i_ret = ARCHIVE_OK;
-        arcbuf = p_sys->last_arcbuf;
-        arcsize = p_sys->last_arcsize;
-    }
+    i_ret = archive_read_data_block( p_arc, &arcbuf, &arcsize, &arcoffset);
+    assert(arcoffset == (la_int64_t) p_sys->i_offset); (void)arcoffset;
 
     switch( i_ret )
     {
         case ARCHIVE_OK:
         case ARCHIVE_EOF:
+            /* the block stays valid until the next call into the archive */
+            p_sys->p_block = arcbuf;
+            p_sys->i_block_size = arcsize;
+            p_sys->i_block_offset = arcoffset;
+
             if( i_size >= arcsize )
-            {
                 i_size = arcsize;
-                p_sys->last_arcbuf = NULL;
-                p_sys->last_arcsize = 0;
-            }
-            else
-            {
-                p_sys->last_arcbuf = (uint8_t *)arcbuf + i_size;
-                p_sys->last_arcsize = arcsize - i_size;
-            }
             if( p_data != NULL)
                 memcpy( p_data, arcbuf, i_size );
             break;
@@ -688,6 +698,16 @@ static int Seek( stream_extractor_t* p_extractor, uint64_t i_req )
     p_sys->b_eof = false;
     int ret = VLC_SUCCESS;
 
+    /* seeks within the last decompressed block are O(1), no rewinding or
+     * re-decompression needed (demuxers commonly step back a few bytes) */
+    if( !p_sys->b_dead && p_sys->p_block != NULL
+     && i_req >= p_sys->i_block_offset
+     && i_req <  p_sys->i_block_offset + p_sys->i_block_size )
+    {
+        p_sys->i_offset = i_req;
+        return VLC_SUCCESS;
+    }
+
     if( !p_sys->b_seekable_archive || p_sys->b_dead
       || archive_seek_data( p_sys->p_archive, i_req, SEEK_SET ) < 0 )
     {
@@ -732,8 +752,8 @@ static int Seek( stream_extractor_t* p_extractor, uint64_t i_req )
     }
     else
     {
-        p_sys->last_arcbuf = NULL;
-        p_sys->last_arcsize = 0;
+        p_sys->p_block = NULL;
+        p_sys->i_block_size = 0;
     }
 
     p_sys->i_offset = i_req;
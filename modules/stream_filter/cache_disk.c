@@ -0,0 +1,373 @@
+/*****************************************************************************
+ * cache_disk.c: persistent on-disk cache for remote streams
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_stream.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
+#include <vlc_hash.h>
+#include <vlc_strings.h>
+
+/* Validated ranges are tracked with block granularity: a block is only
+ * served from disk once it has been fully downloaded, so a partial
+ * download never masks remote data. */
+#define CACHE_BLOCK_SIZE (1 << 20)
+
+#define CACHE_META_MAGIC UINT32_C(0x56484331) /* "VHC1" */
+
+struct meta_header
+{
+    uint32_t magic;
+    uint32_t block_size;
+    uint64_t size;
+    uint32_t url_len;
+    /* followed by the URL bytes, then the block bitmap */
+};
+
+typedef struct
+{
+    int       fd;             /* data file, sparse, pre-sized to the stream */
+    char     *meta_path;
+    uint8_t  *bitmap;         /* one bit per validated block */
+    size_t    bitmap_size;
+    uint8_t  *block;          /* fill buffer for one block */
+    bool      dirty;          /* bitmap changed since the last meta write */
+
+    uint64_t  size;           /* byte size of the remote stream */
+    uint64_t  offset;         /* logical read position */
+    uint64_t  source_offset;  /* position of the wrapped stream */
+
+    uint64_t  hit_bytes;
+    uint64_t  miss_bytes;
+} stream_sys_t;
+
+static bool BitGet(const stream_sys_t *sys, uint64_t block)
+{
+    return (sys->bitmap[block / 8] >> (block % 8)) & 1;
+}
+
+static void BitSet(stream_sys_t *sys, uint64_t block)
+{
+    sys->bitmap[block / 8] |= 1 << (block % 8);
+    sys->dirty = true;
+}
+
+static bool LoadMeta(stream_t *s, stream_sys_t *sys)
+{
+    FILE *meta = vlc_fopen(sys->meta_path, "rb");
+    if (meta == NULL)
+        return false;
+
+    const size_t url_len = strlen(s->psz_url);
+    struct meta_header hdr;
+    bool valid = fread(&hdr, sizeof (hdr), 1, meta) == 1
+              && hdr.magic == CACHE_META_MAGIC
+              && hdr.block_size == CACHE_BLOCK_SIZE
+              && hdr.size == sys->size
+              && hdr.url_len == url_len;
+    if (valid)
+    {
+        /* Detect hash collisions and recycled cache files */
+        char *url = malloc(url_len);
+        valid = url != NULL
+             && fread(url, 1, url_len, meta) == url_len
+             && memcmp(url, s->psz_url, url_len) == 0
+             && fread(sys->bitmap, 1, sys->bitmap_size, meta)
+                    == sys->bitmap_size;
+        free(url);
+    }
+    fclose(meta);
+
+    if (!valid)
+        memset(sys->bitmap, 0, sys->bitmap_size);
+    return valid;
+}
+
+static void WriteMeta(stream_t *s, stream_sys_t *sys)
+{
+    FILE *meta = vlc_fopen(sys->meta_path, "wb");
+    if (meta == NULL)
+    {
+        msg_Warn(s, "cannot write cache meta file: %s", vlc_strerror_c(errno));
+        return;
+    }
+
+    struct meta_header hdr = {
+        .magic = CACHE_META_MAGIC,
+        .block_size = CACHE_BLOCK_SIZE,
+        .size = sys->size,
+        .url_len = strlen(s->psz_url),
+    };
+    if (fwrite(&hdr, sizeof (hdr), 1, meta) != 1
+     || fwrite(s->psz_url, 1, hdr.url_len, meta) != hdr.url_len
+     || fwrite(sys->bitmap, 1, sys->bitmap_size, meta) != sys->bitmap_size)
+        msg_Warn(s, "short write on cache meta file");
+    fclose(meta);
+}
+
+/**
+ * Downloads one block from the wrapped stream into the data file.
+ *
+ * The seek on the wrapped stream turns into a ranged request on HTTP
+ * accesses, so only the missing block is transferred.
+ *
+ * @return the number of leading valid bytes of the block, or -1 on error
+ */
+static ssize_t Fill(stream_t *s, uint64_t block)
+{
+    stream_sys_t *sys = s->p_sys;
+    const uint64_t block_offset = block * CACHE_BLOCK_SIZE;
+    const size_t block_length =
+        __MIN(CACHE_BLOCK_SIZE, sys->size - block_offset);
+
+    if (sys->source_offset != block_offset)
+    {
+        if (vlc_stream_Seek(s->s, block_offset) != VLC_SUCCESS)
+            return -1;
+        sys->source_offset = block_offset;
+    }
+
+    size_t got = 0;
+    while (got < block_length)
+    {
+        ssize_t val = vlc_stream_Read(s->s, sys->block + got,
+                                      block_length - got);
+        if (val <= 0)
+            break;
+        got += val;
+        sys->source_offset += val;
+    }
+
+    if (got > 0 && pwrite(sys->fd, sys->block, got, block_offset)
+                       < (ssize_t)got)
+        return -1;
+    if (got == block_length)
+        BitSet(sys, block);
+    return got;
+}
+
+static ssize_t Read(stream_t *s, void *buf, size_t len)
+{
+    stream_sys_t *sys = s->p_sys;
+
+    if (sys->offset >= sys->size)
+        return 0;
+
+    const uint64_t block = sys->offset / CACHE_BLOCK_SIZE;
+    const uint64_t block_offset = block * CACHE_BLOCK_SIZE;
+    const size_t block_length =
+        __MIN(CACHE_BLOCK_SIZE, sys->size - block_offset);
+    const size_t skip = sys->offset - block_offset;
+
+    size_t avail;
+    const bool hit = BitGet(sys, block);
+    if (hit)
+        avail = block_length;
+    else
+    {
+        ssize_t filled = Fill(s, block);
+        if (filled < 0 || (size_t)filled <= skip)
+            return 0;
+        avail = filled;
+    }
+
+    ssize_t val = pread(sys->fd, buf, __MIN(len, avail - skip), sys->offset);
+    if (val <= 0)
+        return 0;
+
+    if (hit)
+        sys->hit_bytes += val;
+    else
+        sys->miss_bytes += val;
+    sys->offset += val;
+    return val;
+}
+
+static int Seek(stream_t *s, uint64_t offset)
+{
+    stream_sys_t *sys = s->p_sys;
+
+    /* Virtual: the wrapped stream is only repositioned on a block miss */
+    sys->offset = offset;
+    return VLC_SUCCESS;
+}
+
+static int Control(stream_t *s, int query, va_list args)
+{
+    stream_sys_t *sys = s->p_sys;
+
+    switch (query)
+    {
+        case STREAM_CAN_SEEK:
+        case STREAM_CAN_FASTSEEK:
+            /* Seeks within validated ranges never touch the network */
+            *va_arg(args, bool *) = true;
+            return VLC_SUCCESS;
+
+        case STREAM_GET_SIZE:
+            *va_arg(args, uint64_t *) = sys->size;
+            return VLC_SUCCESS;
+    }
+
+    return vlc_stream_vaControl(s->s, query, args);
+}
+
+static int Open(vlc_object_t *obj)
+{
+    stream_t *s = (stream_t *)obj;
+
+    /* Only remote HTTP(S) assets are worth a persistent copy */
+    if (s->psz_url == NULL
+     || (strncasecmp(s->psz_url, "http://", 7) != 0
+      && strncasecmp(s->psz_url, "https://", 8) != 0))
+        return VLC_EGENERIC;
+
+    bool can_seek = false;
+    vlc_stream_Control(s->s, STREAM_CAN_SEEK, &can_seek);
+
+    uint64_t size;
+    if (!can_seek || vlc_stream_GetSize(s->s, &size) != VLC_SUCCESS
+     || size == 0)
+        return VLC_EGENERIC;
+
+    stream_sys_t *sys = vlc_obj_calloc(obj, 1, sizeof (*sys));
+    if (unlikely(sys == NULL))
+        return VLC_ENOMEM;
+    sys->fd = -1;
+    sys->size = size;
+
+    char *dir = var_InheritString(obj, "httpcache-dir");
+    if (dir == NULL)
+    {
+        char *cachedir = config_GetUserDir(VLC_CACHE_DIR);
+        if (cachedir == NULL)
+            return VLC_EGENERIC;
+        int ret = asprintf(&dir, "%s" DIR_SEP "httpcache", cachedir);
+        free(cachedir);
+        if (ret == -1)
+            return VLC_ENOMEM;
+    }
+    if (vlc_mkdir_parent(dir, 0700) != 0 && errno != EEXIST)
+    {
+        msg_Warn(s, "cannot create cache directory %s: %s", dir,
+                 vlc_strerror_c(errno));
+        free(dir);
+        return VLC_EGENERIC;
+    }
+
+    vlc_hash_md5_t md5;
+    char hex[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    vlc_hash_md5_Init(&md5);
+    vlc_hash_md5_Update(&md5, s->psz_url, strlen(s->psz_url));
+    vlc_hash_FinishHex(&md5, hex);
+
+    char *data_path;
+    if (asprintf(&data_path, "%s" DIR_SEP "%s.data", dir, hex) == -1
+     || asprintf(&sys->meta_path, "%s" DIR_SEP "%s.meta", dir, hex) == -1)
+    {
+        free(dir);
+        return VLC_ENOMEM;
+    }
+    free(dir);
+
+    sys->fd = vlc_open(data_path, O_RDWR | O_CREAT, 0600);
+    if (sys->fd == -1)
+    {
+        msg_Warn(s, "cannot open cache file %s: %s", data_path,
+                 vlc_strerror_c(errno));
+        goto error;
+    }
+    if (ftruncate(sys->fd, size) != 0)
+        goto error;
+
+    const uint64_t blocks = (size + CACHE_BLOCK_SIZE - 1) / CACHE_BLOCK_SIZE;
+    sys->bitmap_size = (blocks + 7) / 8;
+    sys->bitmap = calloc(1, sys->bitmap_size);
+    sys->block = malloc(CACHE_BLOCK_SIZE);
+    if (unlikely(sys->bitmap == NULL || sys->block == NULL))
+        goto error;
+
+    if (LoadMeta(s, sys))
+        msg_Dbg(s, "reusing cached ranges for %s", s->psz_url);
+
+    sys->source_offset = vlc_stream_Tell(s->s);
+    free(data_path);
+
+    s->p_sys = sys;
+    s->pf_read = Read;
+    s->pf_seek = Seek;
+    s->pf_control = Control;
+    return VLC_SUCCESS;
+
+error:
+    free(data_path);
+    if (sys->fd != -1)
+        vlc_close(sys->fd);
+    free(sys->bitmap);
+    free(sys->block);
+    free(sys->meta_path);
+    return VLC_EGENERIC;
+}
+
+static void Close(vlc_object_t *obj)
+{
+    stream_t *s = (stream_t *)obj;
+    stream_sys_t *sys = s->p_sys;
+
+    if (sys->dirty)
+        WriteMeta(s, sys);
+
+    msg_Dbg(s, "cache served %"PRIu64" bytes from disk, %"PRIu64" from "
+            "the network", sys->hit_bytes, sys->miss_bytes);
+
+    vlc_close(sys->fd);
+    free(sys->bitmap);
+    free(sys->block);
+    free(sys->meta_path);
+}
+
+#define DIR_TEXT N_("Cache directory")
+#define DIR_LONGTEXT N_( \
+    "Directory holding the downloaded ranges. The user cache directory " \
+    "is used when unset.")
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_INPUT_STREAM_FILTER)
+    set_capability("stream_filter", 0)
+    add_shortcut("httpcache")
+
+    set_description(N_("Persistent disk cache"))
+    set_callbacks(Open, Close)
+
+    add_string("httpcache-dir", NULL, DIR_TEXT, DIR_LONGTEXT)
+vlc_module_end()
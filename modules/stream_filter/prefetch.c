@@ -34,6 +34,9 @@
 #include <vlc_stream.h>
 #include <vlc_fs.h>
 #include <vlc_interrupt.h>
+#include <vlc_membudget.h>
+
+#include <stdatomic.h>
 
 struct stream_ctrl
 {
@@ -76,9 +79,25 @@ typedef struct
     char        *buffer;
     size_t       seek_threshold;
 
+    /* Memory budget: under pressure, the occupied window of the circular
+     * buffer is capped to buffer_limit instead of buffer_size, bounding
+     * the resident set without reallocating the buffer. */
+    struct vlc_membudget_client budget;
+    atomic_size_t buffer_limit;
+
+    /* Adaptive readahead statistics (EWMA, owner: prefetch thread) */
+    bool         adaptive;
+    vlc_tick_t   read_latency; /**< mean duration of one upstream read */
+    vlc_tick_t   seek_latency; /**< mean duration of one upstream seek */
+    float        throughput; /**< mean upstream read rate, in bytes/second */
+
     struct stream_ctrl *controls;
 } stream_sys_t;
 
+/* Exponentially-weighted moving average, biased 7/8 toward history so a
+ * single slow NFS round trip does not swing the estimates. */
+#define EWMA(old, new) (((old) * 7 + (new)) / 8)
+
 static ssize_t ThreadRead(stream_t *stream, void *buf, size_t length)
 {
     stream_sys_t *sys = stream->p_sys;
@@ -86,9 +105,20 @@ static ssize_t ThreadRead(stream_t *stream, void *buf, size_t length)
     vlc_mutex_unlock(&sys->lock);
     assert(length > 0);
 
+    vlc_tick_t start = vlc_tick_now();
     ssize_t val = vlc_stream_ReadPartial(stream->s, buf, length);
+    vlc_tick_t duration = vlc_tick_now() - start;
 
     vlc_mutex_lock(&sys->lock);
+
+    if (val > 0 && duration > 0)
+    {
+        float rate = (float)val * CLOCK_FREQ / duration;
+
+        sys->read_latency = EWMA(sys->read_latency, duration);
+        sys->throughput = sys->throughput != 0.f
+            ? EWMA(sys->throughput, rate) : rate;
+    }
     return val;
 }
 
@@ -98,15 +128,37 @@ static int ThreadSeek(stream_t *stream, uint64_t seek_offset)
 
     vlc_mutex_unlock(&sys->lock);
 
+    vlc_tick_t start = vlc_tick_now();
     int val = vlc_stream_Seek(stream->s, seek_offset);
     if (val != VLC_SUCCESS)
         msg_Err(stream, "cannot seek (to offset %"PRIu64")", seek_offset);
+    vlc_tick_t duration = vlc_tick_now() - start;
 
     vlc_mutex_lock(&sys->lock);
 
+    if (val == VLC_SUCCESS)
+        sys->seek_latency = EWMA(sys->seek_latency, duration);
+
     return (val == VLC_SUCCESS) ? 0 : -1;
 }
 
+/* Number of bytes that could be read upstream in the time one seek round
+ * trip takes. Skipping forward by less than this is slower than reading
+ * through, so the forward-seek threshold tracks it when adapting. */
+static size_t ThreadSeekThreshold(const stream_sys_t *sys)
+{
+    if (!sys->adaptive || sys->throughput == 0.f || sys->seek_latency == 0)
+        return sys->seek_threshold;
+
+    float cost = sys->throughput * sys->seek_latency / CLOCK_FREQ;
+
+    if (cost < 4096.f)
+        return 4096;
+    if (cost > (float)sys->buffer_size)
+        return sys->buffer_size;
+    return (size_t)cost;
+}
+
 static int ThreadControl(stream_t *stream, int query, ...)
 {
     stream_sys_t *sys = stream->p_sys;
@@ -200,7 +252,7 @@ static void *Thread(void *data)
          * seek is a no-op, and continue as if seeking was not supported.
          * WARNING: Except problems with misbehaving access plug-ins. */
         if (sys->can_seek
-         && history >= (sys->buffer_length + sys->seek_threshold))
+         && history >= (sys->buffer_length + ThreadSeekThreshold(sys)))
         {
             if (ThreadSeek(stream, stream_offset) == 0)
             {
@@ -223,9 +275,15 @@ static void *Thread(void *data)
 
         assert(sys->buffer_size >= sys->buffer_length);
 
-        size_t len = sys->buffer_size - sys->buffer_length;
+        size_t limit = atomic_load_explicit(&sys->buffer_limit,
+                                            memory_order_relaxed);
+        if (limit > sys->buffer_size)
+            limit = sys->buffer_size;
+
+        size_t len = (limit > sys->buffer_length)
+                   ? limit - sys->buffer_length : 0;
         if (len == 0)
-        {   /* Buffer is full */
+        {   /* Buffer (or budgeted window) is full */
             if (history == 0)
             {   /* Wait for data to be read */
                 vlc_cond_wait(&sys->wait_space, &sys->lock);
@@ -233,10 +291,19 @@ static void *Thread(void *data)
             }
 
             /* Discard some historical data to make room. */
-            len = history > sys->buffer_length ? sys->buffer_length : history;
+            size_t discard = history > sys->buffer_length
+                           ? sys->buffer_length : history;
+
+            sys->buffer_offset += discard;
+            sys->buffer_length -= discard;
 
-            sys->buffer_offset += len;
-            sys->buffer_length -= len;
+            len = (limit > sys->buffer_length)
+                ? limit - sys->buffer_length : 0;
+            if (len == 0)
+            {   /* Still over the budgeted window: wait for the reader */
+                vlc_cond_wait(&sys->wait_space, &sys->lock);
+                continue;
+            }
         }
 
         size_t offset = (sys->buffer_offset + sys->buffer_length)
@@ -428,6 +495,30 @@ static int Control(stream_t *stream, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+/* Minimum readahead window kept under memory pressure */
+#define PREFETCH_TRIM_FLOOR ((size_t)(1 << 16))
+
+static void Trim(void *data, size_t target)
+{
+    stream_sys_t *sys = data;
+
+    if (target < PREFETCH_TRIM_FLOOR)
+        target = PREFETCH_TRIM_FLOOR;
+    if (target >= atomic_load_explicit(&sys->buffer_limit,
+                                       memory_order_relaxed))
+        return;
+
+    /* The prefetch thread stops refilling past the new window on its next
+     * iteration; the excess drains as the reader consumes it. */
+    atomic_store_explicit(&sys->buffer_limit, target, memory_order_relaxed);
+    vlc_membudget_SetUsage(&sys->budget, target);
+}
+
+static const struct vlc_membudget_cbs prefetch_budget_cbs =
+{
+    .trim = Trim,
+};
+
 static int Open(vlc_object_t *obj)
 {
     stream_t *stream = (stream_t *)obj;
@@ -472,6 +563,10 @@ static int Open(vlc_object_t *obj)
     sys->buffer_length = 0;
     sys->buffer_size = var_InheritInteger(obj, "prefetch-buffer-size") << 10u;
     sys->seek_threshold = var_InheritInteger(obj, "prefetch-seek-threshold");
+    sys->adaptive = var_InheritBool(obj, "prefetch-adaptive");
+    sys->read_latency = 0;
+    sys->seek_latency = 0;
+    sys->throughput = 0.f;
     sys->controls = NULL;
 
     uint64_t size = stream_Size(stream->s);
@@ -495,8 +590,14 @@ static int Open(vlc_object_t *obj)
 
     stream->p_sys = sys;
 
+    atomic_init(&sys->buffer_limit, sys->buffer_size);
+    vlc_membudget_Attach(obj, &sys->budget, "prefetch",
+                         &prefetch_budget_cbs, sys);
+    vlc_membudget_SetUsage(&sys->budget, sys->buffer_size);
+
     if (vlc_clone(&sys->thread, Thread, stream))
     {
+        vlc_membudget_Detach(&sys->budget);
         vlc_interrupt_destroy(sys->interrupt);
         goto error;
     }
@@ -529,6 +630,7 @@ static void Close (vlc_object_t *obj)
     vlc_mutex_unlock(&sys->lock);
 
     vlc_join(sys->thread, NULL);
+    vlc_membudget_Detach(&sys->budget);
     vlc_interrupt_destroy(sys->interrupt);
 
     while(sys->controls)
@@ -556,4 +658,7 @@ vlc_module_begin()
     add_integer("prefetch-seek-threshold", 1 << 14, N_("Seek threshold"),
                 N_("Prefetch forward seek threshold (bytes)"))
         change_integer_range(0, UINT64_C(1) << 60)
+    add_bool("prefetch-adaptive", true, N_("Adaptive readahead"),
+             N_("Derive the forward seek threshold from the measured "
+                "throughput and seek latency of the upstream stream"))
 vlc_module_end()
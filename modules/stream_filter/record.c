@@ -32,9 +32,11 @@
 #include <vlc_plugin.h>
 
 #include <assert.h>
+#include <vlc_block.h>
 #include <vlc_stream.h>
 #include <vlc_input_item.h>
 #include <vlc_fs.h>
+#include <vlc_threads.h>
 
 
 /*****************************************************************************
@@ -53,10 +55,21 @@ vlc_module_end()
 /*****************************************************************************
  *
  *****************************************************************************/
+/* Maximum number of bytes queued to the writer thread. Above this limit
+ * (disk congestion), further data is dropped rather than stalling the
+ * input thread or growing without bound. */
+#define RECORD_MAX_QUEUE_SIZE (16u << 20)
+
 typedef struct
 {
     FILE *f;        /* TODO it could be replaced by access_output_t one day */
-    bool b_error;
+    bool b_error;   /* writer thread only */
+
+    vlc_thread_t thread;
+    vlc_fifo_t *fifo;
+    /* The following fields are protected by the fifo lock */
+    bool b_eof;
+    uint64_t i_dropped;
 } stream_sys_t;
 
 
@@ -170,6 +183,56 @@ static void set_record_file_var(vlc_object_t *obj, const char *file)
 /****************************************************************************
  * Helpers
  ****************************************************************************/
+static void WriteBlocks( stream_t *s, block_t *p_block )
+{
+    stream_sys_t *p_sys = s->p_sys;
+
+    while( p_block != NULL )
+    {
+        block_t *p_next = p_block->p_next;
+
+        const bool b_previous_error = p_sys->b_error;
+        const size_t i_written = fwrite( p_block->p_buffer, 1,
+                                         p_block->i_buffer, p_sys->f );
+
+        p_sys->b_error = i_written != p_block->i_buffer;
+
+        /* TODO maybe a intf_UserError or something like that ? */
+        if( p_sys->b_error && !b_previous_error )
+            msg_Err( s, "Failed to record data (begin)" );
+        else if( !p_sys->b_error && b_previous_error )
+            msg_Err( s, "Failed to record data (end)" );
+
+        block_Release( p_block );
+        p_block = p_next;
+    }
+}
+
+static void *WriterThread( void *data )
+{
+    stream_t *s = data;
+    stream_sys_t *p_sys = s->p_sys;
+
+    vlc_fifo_Lock( p_sys->fifo );
+    for( ;; )
+    {
+        block_t *p_chain = vlc_fifo_DequeueAllUnlocked( p_sys->fifo );
+        if( p_chain == NULL )
+        {
+            if( p_sys->b_eof )
+                break;
+            vlc_fifo_Wait( p_sys->fifo );
+            continue;
+        }
+
+        vlc_fifo_Unlock( p_sys->fifo );
+        WriteBlocks( s, p_chain );
+        vlc_fifo_Lock( p_sys->fifo );
+    }
+    vlc_fifo_Unlock( p_sys->fifo );
+    return NULL;
+}
+
 static int Start( stream_t *s, const char *dir_path, const char *psz_extension )
 {
     stream_sys_t *p_sys = s->p_sys;
@@ -218,8 +281,26 @@ static int Start( stream_t *s, const char *dir_path, const char *psz_extension )
     free( psz_file );
 
     /* */
-    p_sys->f = f;
+    p_sys->fifo = vlc_fifo_New();
+    if( p_sys->fifo == NULL )
+    {
+        fclose( f );
+        return VLC_ENOMEM;
+    }
+
     p_sys->b_error = false;
+    p_sys->b_eof = false;
+    p_sys->i_dropped = 0;
+    p_sys->f = f;
+
+    if( vlc_clone( &p_sys->thread, WriterThread, s ) )
+    {
+        vlc_fifo_Delete( p_sys->fifo );
+        p_sys->fifo = NULL;
+        fclose( f );
+        p_sys->f = NULL;
+        return VLC_EGENERIC;
+    }
     return VLC_SUCCESS;
 }
 static int Stop( stream_t *s )
@@ -228,9 +309,23 @@ static int Stop( stream_t *s )
 
     assert( p_sys->f );
 
+    /* Ask the writer to drain the queue and exit */
+    vlc_fifo_Lock( p_sys->fifo );
+    p_sys->b_eof = true;
+    uint64_t i_dropped = p_sys->i_dropped;
+    vlc_fifo_Signal( p_sys->fifo );
+    vlc_fifo_Unlock( p_sys->fifo );
+    vlc_join( p_sys->thread, NULL );
+
+    if( i_dropped > 0 )
+        msg_Warn( s, "Dropped %"PRIu64" bytes while recording "
+                  "(writer could not keep up)", i_dropped );
+
     msg_Dbg( s, "Recording completed" );
     fclose( p_sys->f );
     p_sys->f = NULL;
+    vlc_fifo_Delete( p_sys->fifo );
+    p_sys->fifo = NULL;
     return VLC_SUCCESS;
 }
 
@@ -240,17 +335,26 @@ static void Write( stream_t *s, const uint8_t *p_buffer, size_t i_buffer )
 
     assert( p_sys->f );
 
-    if( i_buffer > 0 )
-    {
-        const bool b_previous_error = p_sys->b_error;
-        const size_t i_written = fwrite( p_buffer, 1, i_buffer, p_sys->f );
+    if( i_buffer == 0 )
+        return;
 
-        p_sys->b_error = i_written != i_buffer;
+    /* Hand the data over to the writer thread: the input thread must never
+     * block on disk I/O. Only queue admission is done here. */
+    block_t *p_block = block_Alloc( i_buffer );
+    if( p_block != NULL )
+        memcpy( p_block->p_buffer, p_buffer, i_buffer );
 
-        /* TODO maybe a intf_UserError or something like that ? */
-        if( p_sys->b_error && !b_previous_error )
-            msg_Err( s, "Failed to record data (begin)" );
-        else if( !p_sys->b_error && b_previous_error )
-            msg_Err( s, "Failed to record data (end)" );
+    vlc_fifo_Lock( p_sys->fifo );
+    if( p_block == NULL
+     || vlc_fifo_GetBytes( p_sys->fifo ) >= RECORD_MAX_QUEUE_SIZE )
+    {
+        if( p_sys->i_dropped == 0 )
+            msg_Warn( s, "record queue full, dropping data" );
+        p_sys->i_dropped += i_buffer;
+        if( p_block != NULL )
+            block_Release( p_block );
     }
+    else
+        vlc_fifo_QueueUnlocked( p_sys->fifo, p_block );
+    vlc_fifo_Unlock( p_sys->fifo );
 }
@@ -104,6 +104,8 @@ struct sout_stream_sys_t
         , has_video( false )
         , out_force_reload( false )
         , perf_warning_shown( false )
+        , fmp4_rejected( false )
+        , remux_is_fmp4( false )
         , transcoding_state( TRANSCODING_NONE )
         , venc_opt_idx ( -1 )
         , out_streams_added( 0 )
@@ -150,6 +152,8 @@ struct sout_stream_sys_t
     bool                               has_video;
     bool                               out_force_reload;
     bool                               perf_warning_shown;
+    bool                               fmp4_rejected;
+    bool                               remux_is_fmp4;
     int                                transcoding_state;
     int                                venc_opt_idx;
     std::vector<sout_stream_id_sys_t*> streams;
@@ -176,6 +180,7 @@ struct sout_stream_id_sys_t
 
 static const char DEFAULT_MUXER[] = "avformat{mux=matroska,options={live=1},reset-ts}";
 static const char DEFAULT_MUXER_WEBM[] = "avformat{mux=webm,options={live=1},reset-ts}";
+static const char DEFAULT_MUXER_FMP4[] = "mp4frag";
 
 
 /*****************************************************************************
@@ -735,6 +740,8 @@ static void DelInternal(sout_stream_t *p_stream, void *_id, bool reset_config)
         p_sys->p_intf->requestPlayerStop();
         p_sys->access_out_live.clear();
         p_sys->transcoding_state = TRANSCODING_NONE;
+        p_sys->fmp4_rejected = false;
+        p_sys->remux_is_fmp4 = false;
     }
 }
 
@@ -812,6 +819,35 @@ bool sout_stream_sys_t::canDecodeAudio( sout_stream_t *p_stream,
     }
 }
 
+/* Subset of the remuxable codecs that the native fragmented MP4 muxer can
+ * write with plain bitstream passthrough. VP8/VP9/Vorbis/Opus tracks keep
+ * going through the WebM/Matroska remux. */
+static bool canRemuxToFMP4( vlc_fourcc_t i_codec_video, vlc_fourcc_t i_codec_audio )
+{
+    switch( i_codec_video )
+    {
+        case 0: /* no video track */
+        case VLC_CODEC_H264:
+        case VLC_CODEC_HEVC:
+            break;
+        default:
+            return false;
+    }
+    switch( i_codec_audio )
+    {
+        case 0: /* no audio track */
+        case VLC_CODEC_MP4A:
+        case VLC_CODEC_MP3:
+        case VLC_CODEC_MP2:
+        case VLC_CODEC_MPGA:
+        case VLC_CODEC_A52:
+        case VLC_CODEC_EAC3:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void sout_stream_sys_t::stopSoutChain(sout_stream_t *p_stream)
 {
     (void) p_stream;
@@ -1096,23 +1132,37 @@ bool sout_stream_sys_t::UpdateOutput( sout_stream_t *p_stream )
                          ( i_codec_video == VLC_CODEC_VP8 ||
                            i_codec_video == VLC_CODEC_VP9 );
 
+    /* Prefer a local fragmented MP4 transmux when passing the bitstreams
+     * through: the native muxer is cheaper than the avformat remux and some
+     * renderers reject Matroska while accepting the same tracks in MP4. On
+     * renderer rejection (CC_INPUT_EVENT_RETRY) we retry with Matroska
+     * before falling back to transcoding. */
+    const bool is_fmp4 = canRemux && !fmp4_rejected
+                      && canRemuxToFMP4( i_codec_video, i_codec_audio );
+    remux_is_fmp4 = is_fmp4;
+
     if ( !p_original_video )
     {
-        if( is_webm )
+        if( is_fmp4 )
+            mime = "audio/mp4";
+        else if( is_webm )
             mime = "audio/webm";
         else
             mime = "audio/x-matroska";
     }
     else
     {
-        if ( is_webm )
+        if ( is_fmp4 )
+            mime = "video/mp4";
+        else if ( is_webm )
             mime = "video/webm";
         else
             mime = "video/x-matroska";
     }
 
     ssout << "chromecast-proxy:"
-          << "std{mux=" << ( is_webm ? DEFAULT_MUXER_WEBM : DEFAULT_MUXER )
+          << "std{mux=" << ( is_fmp4 ? DEFAULT_MUXER_FMP4 :
+                             is_webm ? DEFAULT_MUXER_WEBM : DEFAULT_MUXER )
           << ",access=chromecast-http}";
 
     if ( !startSoutChain( p_stream, new_streams, ssout.str(),
@@ -1239,7 +1289,17 @@ static void on_input_event_cb(void *data, enum cc_input_event event, union cc_in
             break;
         case CC_INPUT_EVENT_RETRY:
             p_sys->stopSoutChain( p_stream );
-            if( p_sys->transcodingCanFallback() )
+            if( p_sys->remux_is_fmp4 )
+            {
+                /* The renderer rejected the fragmented MP4 transmux: retry
+                 * with the Matroska remux before considering transcoding. */
+                msg_Warn(p_stream, "Load failed detected. Falling back from "
+                         "fragmented MP4 to Matroska remux");
+                p_sys->fmp4_rejected = true;
+                p_sys->remux_is_fmp4 = false;
+                p_sys->out_force_reload = p_sys->es_changed = true;
+            }
+            else if( p_sys->transcodingCanFallback() )
             {
                 p_sys->setNextTranscodingState();
                 msg_Warn(p_stream, "Load failed detected. Switching to next "
@@ -132,6 +132,14 @@
     "Default caching value for outbound RTP streams. This " \
     "value should be set in milliseconds." )
 
+#define BATCH_TEXT N_("Batching horizon (ms)")
+#define BATCH_LONGTEXT N_( \
+    "Packets due within this many milliseconds are released as a single " \
+    "burst, using one system call per burst and sink where the operating " \
+    "system supports it. This trades pacing granularity for much lower " \
+    "send overhead on high bitrate streams. 0 (the default) paces and " \
+    "sends every packet individually." )
+
 #define PROTO_TEXT N_("Transport protocol")
 #define PROTO_LONGTEXT N_( \
     "This selects which transport protocol to use for RTP." )
@@ -218,6 +226,7 @@ vlc_module_begin ()
               RTCP_MUX_TEXT, RTCP_MUX_LONGTEXT )
     add_integer( SOUT_CFG_PREFIX "caching", MS_FROM_VLC_TICK(DEFAULT_PTS_DELAY),
                  CACHING_TEXT, CACHING_LONGTEXT )
+    add_integer( SOUT_CFG_PREFIX "batch", 0, BATCH_TEXT, BATCH_LONGTEXT )
     add_integer( "rtsp-timeout", 60, RTSP_TIMEOUT_TEXT,
                  RTSP_TIMEOUT_LONGTEXT )
     add_string( "sout-rtsp-user", "",
@@ -242,7 +251,7 @@ vlc_module_end ()
  *****************************************************************************/
 static const char *const ppsz_sout_options[] = {
     "dst", "name", "cat", "port", "port-audio", "port-video", "*sdp", "ttl",
-    "mux", "sap", "description", "proto", "rtcp-mux", "caching",
+    "mux", "sap", "description", "proto", "rtcp-mux", "caching", "batch",
 #ifdef HAVE_SRTP
     "key", "salt",
 #endif
@@ -357,6 +366,10 @@ struct sout_stream_id_sys_t
     } listen;
 
     vlc_tick_t        i_caching;
+    vlc_tick_t        i_batch;
+    /* Packets sent past their deadline; written by the send thread only,
+     * read after joining it */
+    uint64_t          late_packets;
 };
 
 static int Control(sout_stream_t *stream, int query, va_list args)
@@ -956,6 +969,9 @@ static void *Add( sout_stream_t *p_stream, const es_format_t *p_fmt, const char
     id->b_first_packet = true;
     id->i_caching =
         VLC_TICK_FROM_MS(var_GetInteger( p_stream, SOUT_CFG_PREFIX "caching"));
+    id->i_batch =
+        VLC_TICK_FROM_MS(var_GetInteger( p_stream, SOUT_CFG_PREFIX "batch"));
+    id->late_packets = 0;
 
     vlc_rand_bytes (&id->i_sequence, sizeof (id->i_sequence));
     vlc_rand_bytes (id->ssrc, sizeof (id->ssrc));
@@ -1179,6 +1195,9 @@ static void Del( sout_stream_t *p_stream, void *_id )
     {
         vlc_queue_Kill(&id->queue, &id->dead);
         vlc_join( id->thread, NULL );
+        if( id->late_packets > 0 )
+            msg_Warn( p_stream, "%"PRIu64" packets sent late",
+                      id->late_packets );
      }
     free( id->rtp_fmt.fmtp );
 
@@ -1216,6 +1235,12 @@ static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
         block_t *p_next = p_buffer->p_next;
         p_buffer->p_next = NULL;
 
+        /* Sources sending an access unit as one block per slice flag only
+         * the last slice. For everybody else one block is one access unit:
+         * stamp the flag so packetizers can rely on it (RTP marker bit). */
+        if( p_next == NULL || p_next->i_pts != p_buffer->i_pts )
+            p_buffer->i_flags |= BLOCK_FLAG_AU_END;
+
         /* Send a Vorbis/Theora Packed Configuration packet (RFC 5215 §3.1)
          * as the first packet of the stream */
         if (id->b_first_packet)
@@ -1347,6 +1372,11 @@ static int  HttpCallback( httpd_file_sys_t *p_args,
 /****************************************************************************
  * RTP send
  ****************************************************************************/
+/* At most that many packets per burst (and per system call) */
+#define RTP_BATCH_MAX 32
+/* Pacing slack before a packet is accounted as late */
+#define RTP_LATE_TOLERANCE VLC_TICK_FROM_MS(1)
+
 static void* ThreadSend( void *data )
 {
     vlc_thread_set_name("vlc-rt-send");
@@ -1361,31 +1391,79 @@ static void* ThreadSend( void *data )
 #endif
     sout_stream_id_sys_t *id = data;
     vlc_tick_t i_caching = id->i_caching;
+    vlc_tick_t i_batch = id->i_batch;
+    block_t *outv[RTP_BATCH_MAX];
+    block_t *pending = NULL;
     block_t *out;
 
-    while ((out = vlc_queue_DequeueKillable(&id->queue, &id->dead)) != NULL)
+    for( ;; )
     {
+        unsigned outc = 0;
+
+        out = ( pending != NULL ) ? pending
+            : vlc_queue_DequeueKillable( &id->queue, &id->dead );
+        pending = NULL;
+        if( out == NULL )
+            break;
+        outv[outc++] = out;
+
+        if( i_batch != 0 )
+        {   /* Gather the packets due within the batching horizon, so that
+             * they go out as a single burst, with one system call per sink
+             * where possible. The queue is in sending order and this thread
+             * is its only consumer, so a packet dequeued past the horizon
+             * can simply be carried over to the next burst. */
+            vlc_queue_Lock( &id->queue );
+            while( outc < ARRAY_SIZE(outv)
+                && ( out = vlc_queue_DequeueUnlocked( &id->queue ) ) != NULL )
+            {
+                if( out->i_dts > outv[0]->i_dts + i_batch )
+                {
+                    pending = out;
+                    break;
+                }
+                outv[outc++] = out;
+            }
+            vlc_queue_Unlock( &id->queue );
+        }
+
 #ifdef HAVE_SRTP
         if( id->srtp )
         {   /* FIXME: this is awfully inefficient */
-            size_t len = out->i_buffer;
-            out = block_Realloc( out, 0, len + 10 );
-            out->i_buffer = len;
+            unsigned keep = 0;
 
-            int val = srtp_send( id->srtp, out->p_buffer, &len, len + 10 );
-            if( val )
+            for( unsigned i = 0; i < outc; i++ )
             {
-                msg_Dbg( id->p_stream, "SRTP sending error: %s",
-                         vlc_strerror_c(val) );
-                block_Release( out );
-                continue;
+                out = outv[i];
+
+                size_t len = out->i_buffer;
+                out = block_Realloc( out, 0, len + 10 );
+                out->i_buffer = len;
+
+                int val = srtp_send( id->srtp, out->p_buffer, &len, len + 10 );
+                if( val )
+                {
+                    msg_Dbg( id->p_stream, "SRTP sending error: %s",
+                             vlc_strerror_c(val) );
+                    block_Release( out );
+                    continue;
+                }
+                out->i_buffer = len;
+                outv[keep++] = out;
             }
-            out->i_buffer = len;
+            outc = keep;
+            if( outc == 0 )
+                continue;
         }
 #endif
-        vlc_tick_wait (out->i_dts + i_caching);
+        /* Absolute deadline of the first packet of the burst; the others
+         * are due within the horizon and are released (early) with it. */
+        vlc_tick_wait (outv[0]->i_dts + i_caching);
 
-        ssize_t len = out->i_buffer;
+        vlc_tick_t now = vlc_tick_now();
+        for( unsigned i = 0; i < outc; i++ )
+            if( now > outv[i]->i_dts + i_caching + RTP_LATE_TOLERANCE )
+                id->late_packets++;
 
         vlc_mutex_lock( &id->lock_sink );
         unsigned deadc = 0; /* How many dead sockets? */
@@ -1393,29 +1471,68 @@ static void* ThreadSend( void *data )
 
         for( int i = 0; i < id->sinkc; i++ )
         {
+            unsigned sent = 0;
+
 #ifdef HAVE_SRTP
             if( !id->srtp ) /* FIXME: SRTCP support */
 #endif
-                SendRTCP( id->sinkv[i].rtcp, out );
+                for( unsigned j = 0; j < outc; j++ )
+                    SendRTCP( id->sinkv[i].rtcp, outv[j] );
+
+#ifdef __linux__
+            if( outc > 1 )
+            {   /* Whole burst in one system call. On error, the unsent
+                 * packets fall through the one-at-a-time path below for
+                 * the usual error handling. */
+                struct iovec iov[RTP_BATCH_MAX];
+                struct mmsghdr msgv[RTP_BATCH_MAX];
+
+                for( unsigned j = 0; j < outc; j++ )
+                {
+                    iov[j] = (struct iovec) {
+                        .iov_base = outv[j]->p_buffer,
+                        .iov_len = outv[j]->i_buffer,
+                    };
+                    msgv[j] = (struct mmsghdr) {
+                        .msg_hdr = { .msg_iov = iov + j, .msg_iovlen = 1 },
+                    };
+                }
 
-            if( send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 ) == -1
-             && net_errno != EAGAIN && net_errno != EWOULDBLOCK
-             && net_errno != ENOBUFS && net_errno != ENOMEM )
+                int val = sendmmsg( id->sinkv[i].rtp_fd, msgv, outc, 0 );
+                if( val > 0 )
+                    sent = val;
+            }
+#endif
+            for( unsigned j = sent; j < outc; j++ )
             {
-                int type;
-                getsockopt( id->sinkv[i].rtp_fd, SOL_SOCKET, SO_TYPE,
-                            &type, &(socklen_t){ sizeof(type) });
-                if( type == SOCK_DGRAM )
-                    /* ICMP soft error: ignore and retry */
-                    send( id->sinkv[i].rtp_fd, out->p_buffer, len, 0 );
-                else
-                    /* Broken connection */
-                    deadv[deadc++] = id->sinkv[i].rtp_fd;
+                out = outv[j];
+
+                if( send( id->sinkv[i].rtp_fd, out->p_buffer, out->i_buffer,
+                          0 ) == -1
+                 && net_errno != EAGAIN && net_errno != EWOULDBLOCK
+                 && net_errno != ENOBUFS && net_errno != ENOMEM )
+                {
+                    int type;
+                    getsockopt( id->sinkv[i].rtp_fd, SOL_SOCKET, SO_TYPE,
+                                &type, &(socklen_t){ sizeof(type) });
+                    if( type == SOCK_DGRAM )
+                        /* ICMP soft error: ignore and retry */
+                        send( id->sinkv[i].rtp_fd, out->p_buffer,
+                              out->i_buffer, 0 );
+                    else
+                    {   /* Broken connection */
+                        deadv[deadc++] = id->sinkv[i].rtp_fd;
+                        break;
+                    }
+                }
             }
         }
-        id->i_seq_sent_next = ntohs(((uint16_t *) out->p_buffer)[1]) + 1;
+        id->i_seq_sent_next =
+            ntohs(((uint16_t *) outv[outc - 1]->p_buffer)[1]) + 1;
         vlc_mutex_unlock( &id->lock_sink );
-        block_Release( out );
+
+        for( unsigned i = 0; i < outc; i++ )
+            block_Release( outv[i] );
 
         for( unsigned i = 0; i < deadc; i++ )
         {
@@ -1423,6 +1540,9 @@ static void* ThreadSend( void *data )
             rtp_del_sink( id, deadv[i] );
         }
     }
+
+    if( pending != NULL )
+        block_Release( pending );
     return NULL;
 }
 
@@ -1427,6 +1427,10 @@ static int rtp_packetize_h264( sout_stream_id_sys_t *id, block_t *in )
     hxxx_iterator_ctx_t it;
     hxxx_iterator_init( &it, in->p_buffer, in->i_buffer, 0 );
 
+    /* The marker bit signals the last packet of the access unit; with
+     * slice-level blocks the access unit only ends with the flagged block */
+    bool b_au_end = in->i_flags & BLOCK_FLAG_AU_END;
+
     const uint8_t *p_nal;
     size_t i_nal;
     while( hxxx_annexb_iterate_next( &it, &p_nal, &i_nal ) )
@@ -1434,7 +1438,8 @@ static int rtp_packetize_h264( sout_stream_id_sys_t *id, block_t *in )
         /* TODO add STAP-A to remove a lot of overhead with small slice/sei/... */
         if (rtp_packetize_h264_nal( id, p_nal, i_nal,
                 (in->i_pts != VLC_TICK_INVALID ? in->i_pts : in->i_dts), in->i_dts,
-                it.p_head + 3 >= it.p_tail, in->i_length * i_nal / in->i_buffer ))
+                b_au_end && it.p_head + 3 >= it.p_tail,
+                in->i_length * i_nal / in->i_buffer ))
         {
             block_Release(in);
             return VLC_ENOMEM;
@@ -460,6 +460,60 @@ static int Open( vlc_object_t *p_this )
                  p_sys->venc_cfg.video.i_bitrate / 1000 );
     }
 
+    /* Extra ABR ladder rungs. "vladder=WIDTHxHEIGHT[@BITRATE]" may be
+     * repeated; each occurrence re-encodes the decoded pictures of the
+     * video track at another size/bitrate, sharing a single decoder. */
+    for( const config_chain_t *p_cfg = p_stream->p_cfg; p_cfg != NULL;
+         p_cfg = p_cfg->p_next )
+    {
+        if( strcmp( p_cfg->psz_name, "vladder" ) || !p_cfg->psz_value )
+            continue;
+
+        unsigned i_width = 0, i_height = 0, i_bitrate = 0;
+        if( sscanf( p_cfg->psz_value, "%ux%u@%u",
+                    &i_width, &i_height, &i_bitrate ) < 2 ||
+            !i_width || !i_height )
+        {
+            msg_Err( p_stream, "invalid ladder rung \"%s\", "
+                     "expected WIDTHxHEIGHT[@BITRATE]", p_cfg->psz_value );
+            continue;
+        }
+        if( !p_sys->venc_cfg.i_codec )
+        {
+            msg_Warn( p_stream, "ignoring ladder rung \"%s\": "
+                      "no video codec set", p_cfg->psz_value );
+            continue;
+        }
+        if( i_bitrate && i_bitrate < 16000 )
+            i_bitrate *= 1000;
+
+        transcode_encoder_config_t *p_resized =
+            realloc( p_sys->p_ladder_cfgs,
+                     (p_sys->i_ladder_count + 1) * sizeof( *p_resized ) );
+        if( !p_resized )
+            continue;
+        p_sys->p_ladder_cfgs = p_resized;
+
+        transcode_encoder_config_t *p_rung =
+            &p_sys->p_ladder_cfgs[p_sys->i_ladder_count++];
+        transcode_encoder_config_init( p_rung );
+        p_rung->i_codec = p_sys->venc_cfg.i_codec;
+        if( p_sys->venc_cfg.psz_name )
+            p_rung->psz_name = strdup( p_sys->venc_cfg.psz_name );
+        p_rung->p_config_chain =
+            config_ChainDuplicate( p_sys->venc_cfg.p_config_chain );
+        p_rung->video = p_sys->venc_cfg.video;
+        p_rung->video.i_width = i_width;
+        p_rung->video.i_height = i_height;
+        p_rung->video.f_scale = 0;
+        if( i_bitrate )
+            p_rung->video.i_bitrate = i_bitrate;
+
+        msg_Dbg( p_stream, "ladder rung %zu: %ux%u %dkb/s",
+                 p_sys->i_ladder_count, i_width, i_height,
+                 p_rung->video.i_bitrate / 1000 );
+    }
+
     /* Video Filter Parameters */
     sout_filters_config_init( &p_sys->vfilters_cfg );
 
@@ -518,6 +572,10 @@ static void Close( sout_stream_t *p_stream )
     transcode_encoder_config_clean( &p_sys->venc_cfg );
     sout_filters_config_clean( &p_sys->vfilters_cfg );
 
+    for( size_t i = 0; i < p_sys->i_ladder_count; i++ )
+        transcode_encoder_config_clean( &p_sys->p_ladder_cfgs[i] );
+    free( p_sys->p_ladder_cfgs );
+
     transcode_encoder_config_clean( &p_sys->aenc_cfg );
     sout_filters_config_clean( &p_sys->afilters_cfg );
 
@@ -653,6 +711,8 @@ Add( sout_stream_t *p_stream, const es_format_t *p_fmt, const char *es_id )
         case VIDEO_ES:
             id->p_filterscfg = &p_sys->vfilters_cfg;
             id->p_enccfg = &p_sys->venc_cfg;
+            id->p_ladder_enccfgs = p_sys->p_ladder_cfgs;
+            id->i_ladder_count = p_sys->i_ladder_count;
             break;
         case SPU_ES:
             id->p_filterscfg = NULL;
@@ -758,6 +818,11 @@ static void Del( sout_stream_t *p_stream, void *_id )
             if( id == p_sys->id_video )
                 p_sys->id_video = NULL;
             vlc_mutex_unlock( &p_sys->lock );
+            /* The ladder rung outputs are freed with the variants */
+            for( size_t i = 0; i < id->i_variant_count; i++ )
+                if( id->p_variants[i].downstream_id )
+                    sout_StreamIdDel( p_stream->p_next,
+                                      id->p_variants[i].downstream_id );
             transcode_video_clean( id );
             break;
         case SPU_ES:
@@ -862,6 +927,35 @@ static int Send( sout_stream_t *p_stream, void *_id, block_t *p_buffer )
         it = next;
     }
 
+    if( id->p_decoder->fmt_in->i_cat == VIDEO_ES )
+    {
+        /* Forward the extra ladder rungs. Their blocks are produced on the
+         * pipeline thread but must reach the next stream from here. */
+        for( size_t i = 0; i < id->i_variant_count; i++ )
+        {
+            struct transcode_video_variant *p_var = &id->p_variants[i];
+
+            vlc_fifo_Lock( p_var->output_fifo );
+            block_t *p_pending = vlc_fifo_DequeueAllUnlocked( p_var->output_fifo );
+            vlc_fifo_Unlock( p_var->output_fifo );
+
+            for( block_t *it = p_pending; it != NULL; )
+            {
+                block_t *next = it->p_next;
+                it->p_next = NULL;
+
+                if( p_var->b_error || p_var->downstream_id == NULL )
+                    block_Release( it );
+                else if( sout_StreamIdSend( p_stream->p_next,
+                                            p_var->downstream_id,
+                                            it ) != VLC_SUCCESS )
+                    p_var->b_error = true;
+
+                it = next;
+            }
+        }
+    }
+
     if (i_ret != VLC_SUCCESS)
         id->b_error = true;
 
@@ -71,8 +71,26 @@ typedef struct
     bool first_pcr_sent;
     bool pcr_sync_has_input;
     unsigned int transcoded_stream_nb;
+
+    /* Additional video encoder configurations, one per extra ABR ladder
+     * rung sharing the decoded pictures of the video track. */
+    transcode_encoder_config_t *p_ladder_cfgs;
+    size_t i_ladder_count;
 } sout_stream_sys_t;
 
+/* Extra scale+encode branch fed with the same decoded pictures as the
+ * main video encoder (one per ABR ladder rung). */
+struct transcode_video_variant
+{
+    const transcode_encoder_config_t *p_enccfg;
+    transcode_encoder_t *encoder;
+    filter_chain_t *p_conv; /**< scaler from the main encoder input format */
+    vlc_fifo_t *output_fifo;
+    void *downstream_id;
+    char *es_id;
+    bool b_error;
+};
+
 struct aout_filters;
 
 struct sout_stream_id_sys_t
@@ -134,6 +152,21 @@ struct sout_stream_id_sys_t
              spu_t           *p_spu;
              vlc_decoder_device *dec_dev;
              vlc_video_context *enc_vctx_in;
+             /* Extra ABR ladder rungs */
+             struct transcode_video_variant *p_variants;
+             size_t i_variant_count;
+             /* Filter/encode pipeline stage, fed with decoded pictures */
+             struct
+             {
+                 picture_fifo_t *fifo;
+                 vlc_mutex_t     lock;
+                 vlc_cond_t      wait; /**< worker waits for pictures */
+                 vlc_cond_t      room; /**< producer waits for a slot */
+                 size_t          depth; /**< pictures queued in fifo */
+                 bool            busy; /**< worker is processing a picture */
+                 bool            closing;
+                 vlc_thread_t    thread;
+             } pipeline;
          };
          struct
          {
@@ -151,6 +184,10 @@ struct sout_stream_id_sys_t
     const transcode_encoder_config_t *p_enccfg;
     transcode_encoder_t *encoder;
 
+    /* Extra ladder rung encoder configurations (video only) */
+    const transcode_encoder_config_t *p_ladder_enccfgs;
+    size_t i_ladder_count;
+
     /* Sync */
     date_t          next_input_pts; /**< Incoming calculated PTS */
     vlc_tick_t      i_drift; /** how much buffer is ahead of calculated PTS */
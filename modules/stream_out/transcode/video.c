@@ -114,11 +114,99 @@ static int transcode_video_filters_init( sout_stream_t *p_stream,
                                          const es_format_t *p_dst,
                                          sout_stream_id_sys_t *id );
 
+static void transcode_video_pipeline_WaitIdle( sout_stream_id_sys_t *id );
+
+/* Creates, configures and (re)builds the scaler of each ladder rung so
+ * it matches the pictures handed to the main encoder. Called with
+ * id->fifo.lock held and the pipeline idle. A failing rung is disabled
+ * instead of failing the whole track. */
+static void transcode_video_ladder_update( decoder_t *p_dec,
+                                           sout_stream_t *p_stream,
+                                           sout_stream_id_sys_t *id,
+                                           const es_format_t *p_src,
+                                           vlc_video_context *src_ctx )
+{
+    for( size_t i = 0; i < id->i_variant_count; i++ )
+    {
+        struct transcode_video_variant *p_var = &id->p_variants[i];
+        if( p_var->b_error )
+            continue;
+
+        if( p_var->encoder == NULL )
+        {
+            struct encoder_owner *p_enc_owner = (struct encoder_owner *)
+                sout_EncoderCreate( VLC_OBJECT(p_stream),
+                                    sizeof(struct encoder_owner) );
+            if( unlikely(p_enc_owner == NULL) )
+            {
+                p_var->b_error = true;
+                continue;
+            }
+
+            p_var->encoder = transcode_encoder_new( &p_enc_owner->enc,
+                                                    &p_dec->fmt_out );
+            if( !p_var->encoder )
+            {
+                vlc_object_delete( &p_enc_owner->enc );
+                p_var->b_error = true;
+                continue;
+            }
+            p_enc_owner->id = id;
+            p_enc_owner->enc.cbs = &encoder_video_transcode_cbs;
+        }
+
+        if( !transcode_encoder_opened( p_var->encoder ) )
+        {
+            transcode_encoder_video_configure( VLC_OBJECT(p_stream),
+                                               &id->p_decoder->fmt_out.video,
+                                               p_var->p_enccfg,
+                                               &p_src->video,
+                                               src_ctx,
+                                               p_var->encoder );
+            if( transcode_encoder_open( p_var->encoder,
+                                        p_var->p_enccfg ) != VLC_SUCCESS )
+            {
+                msg_Err( p_stream, "cannot open encoder for ladder rung %zu",
+                         i + 1 );
+                p_var->b_error = true;
+                continue;
+            }
+        }
+
+        /* Scale from the shared pictures down to this rung */
+        filter_owner_t chain_owner = {
+            .video = &transcode_filter_video_cbs,
+            .sys = id,
+        };
+        if( !p_var->p_conv )
+            p_var->p_conv = filter_chain_NewVideo( p_stream, false,
+                                                   &chain_owner );
+        if( !p_var->p_conv )
+        {
+            p_var->b_error = true;
+            continue;
+        }
+        filter_chain_Reset( p_var->p_conv, p_src, src_ctx,
+                            transcode_encoder_format_in( p_var->encoder ) );
+        if( filter_chain_AppendConverter( p_var->p_conv, NULL ) != VLC_SUCCESS )
+        {
+            msg_Err( p_stream, "cannot build scaler for ladder rung %zu",
+                     i + 1 );
+            transcode_remove_filters( &p_var->p_conv );
+            p_var->b_error = true;
+        }
+    }
+}
+
 static int video_update_format_decoder( decoder_t *p_dec, vlc_video_context *vctx )
 {
     struct decoder_owner *p_owner = dec_get_owner( p_dec );
     sout_stream_id_sys_t *id = p_owner->id;
 
+    /* The filter chains and encoder cannot be rebuilt while the pipeline
+     * worker is still using them on earlier pictures */
+    transcode_video_pipeline_WaitIdle( id );
+
     vlc_mutex_lock(&id->fifo.lock);
     if( id->encoder != NULL && transcode_encoder_opened( id->encoder ) )
     {
@@ -131,6 +219,8 @@ static int video_update_format_decoder( decoder_t *p_dec, vlc_video_context *vct
         transcode_remove_filters( &id->p_final_conv_static );
         transcode_remove_filters( &id->p_uf_chain );
         transcode_remove_filters( &id->p_f_chain );
+        for( size_t i = 0; i < id->i_variant_count; i++ )
+            transcode_remove_filters( &id->p_variants[i].p_conv );
     }
     else if( id->encoder == NULL )
     {
@@ -217,6 +307,13 @@ static int video_update_format_decoder( decoder_t *p_dec, vlc_video_context *vct
          if( filter_chain_AppendConverter( id->p_final_conv_static, NULL ) != VLC_SUCCESS )
              goto error;
     }
+
+    /* Ladder rungs branch off the pictures handed to the main encoder */
+    transcode_video_ladder_update( p_dec, p_owner->p_stream, id,
+                                   transcode_encoder_format_in( id->encoder ),
+                                   id->p_final_conv_static ?
+                    filter_chain_GetVideoCtxOut( id->p_final_conv_static ) :
+                    enc_vctx );
     vlc_mutex_unlock(&id->fifo.lock);
 
     if( !id->downstream_id )
@@ -225,6 +322,22 @@ static int video_update_format_decoder( decoder_t *p_dec, vlc_video_context *vct
                                              id->p_decoder->fmt_in,
                                              transcode_encoder_format_out( id->encoder ),
                                              id->es_id );
+
+    for( size_t i = 0; i < id->i_variant_count; i++ )
+    {
+        struct transcode_video_variant *p_var = &id->p_variants[i];
+        if( p_var->b_error || p_var->encoder == NULL ||
+            !transcode_encoder_opened( p_var->encoder ) ||
+            p_var->downstream_id != NULL )
+            continue;
+        p_var->downstream_id =
+            id->pf_transcode_downstream_add( p_owner->p_stream,
+                                             id->p_decoder->fmt_in,
+                                             transcode_encoder_format_out( p_var->encoder ),
+                                             p_var->es_id );
+        if( p_var->downstream_id == NULL )
+            p_var->b_error = true;
+    }
     msg_Info( p_dec, "video format update succeed" );
 
 end:
@@ -252,28 +365,95 @@ static picture_t *video_new_buffer_encoder( transcode_encoder_t *p_enc )
 static int transcode_process_picture( sout_stream_id_sys_t *id,
                                       picture_t *p_pic, block_t **out);
 
+/* Decoded pictures queued ahead of the filter/encode stage. Keeps the
+ * pipeline bounded and paces the decoder to the slowest stage. */
+#define TRANSCODE_PIPELINE_DEPTH 4
+
 static void decoder_queue_video( decoder_t *p_dec, picture_t *p_pic )
 {
     struct decoder_owner *p_owner = dec_get_owner( p_dec );
     sout_stream_id_sys_t *id = p_owner->id;
 
-    block_t *p_block = NULL;
-    int ret = transcode_process_picture( id, p_pic, &p_block );
-
-    if( p_block == NULL )
+    vlc_mutex_lock( &id->pipeline.lock );
+    while( id->pipeline.depth + id->pipeline.busy >= TRANSCODE_PIPELINE_DEPTH
+        && !id->pipeline.closing )
+        vlc_cond_wait( &id->pipeline.room, &id->pipeline.lock );
+    if( id->pipeline.closing )
+    {
+        vlc_mutex_unlock( &id->pipeline.lock );
+        picture_Release( p_pic );
         return;
+    }
+    picture_fifo_Push( id->pipeline.fifo, p_pic );
+    id->pipeline.depth++;
+    vlc_cond_signal( &id->pipeline.wait );
+    vlc_mutex_unlock( &id->pipeline.lock );
+}
 
-    vlc_fifo_Lock( id->output_fifo );
-    id->b_error |= ret != VLC_SUCCESS;
-    if( id->b_error )
+static void *TranscodeVideoWorker( void *opaque )
+{
+    sout_stream_id_sys_t *id = opaque;
+
+    vlc_mutex_lock( &id->pipeline.lock );
+    for( ;; )
     {
-        vlc_fifo_Unlock( id->output_fifo );
-        block_ChainRelease( p_block );
-        return;
+        while( id->pipeline.depth == 0 && !id->pipeline.closing )
+            vlc_cond_wait( &id->pipeline.wait, &id->pipeline.lock );
+        if( id->pipeline.depth == 0 )
+            break; /* closing and fully drained */
+
+        picture_t *p_pic = picture_fifo_Pop( id->pipeline.fifo );
+        id->pipeline.depth--;
+        id->pipeline.busy = true;
+        vlc_mutex_unlock( &id->pipeline.lock );
+
+        block_t *p_block = NULL;
+        int ret = transcode_process_picture( id, p_pic, &p_block );
+
+        if( p_block != NULL )
+        {
+            vlc_fifo_Lock( id->output_fifo );
+            id->b_error |= ret != VLC_SUCCESS;
+            if( id->b_error )
+            {
+                vlc_fifo_Unlock( id->output_fifo );
+                block_ChainRelease( p_block );
+            }
+            else
+            {
+                vlc_fifo_QueueUnlocked( id->output_fifo, p_block );
+                vlc_fifo_Unlock( id->output_fifo );
+            }
+        }
+
+        vlc_mutex_lock( &id->pipeline.lock );
+        id->pipeline.busy = false;
+        vlc_cond_signal( &id->pipeline.room );
     }
+    vlc_mutex_unlock( &id->pipeline.lock );
+    return NULL;
+}
 
-    vlc_fifo_QueueUnlocked( id->output_fifo, p_block );
-    vlc_fifo_Unlock( id->output_fifo );
+/* Waits until the worker has filtered and encoded every queued picture.
+ * The filter chains and the encoder may only be touched from another
+ * thread once the pipeline is idle. */
+static void transcode_video_pipeline_WaitIdle( sout_stream_id_sys_t *id )
+{
+    vlc_mutex_lock( &id->pipeline.lock );
+    while( id->pipeline.depth > 0 || id->pipeline.busy )
+        vlc_cond_wait( &id->pipeline.room, &id->pipeline.lock );
+    vlc_mutex_unlock( &id->pipeline.lock );
+}
+
+static void transcode_video_pipeline_Stop( sout_stream_id_sys_t *id )
+{
+    vlc_mutex_lock( &id->pipeline.lock );
+    id->pipeline.closing = true;
+    vlc_cond_broadcast( &id->pipeline.wait );
+    vlc_cond_broadcast( &id->pipeline.room );
+    vlc_mutex_unlock( &id->pipeline.lock );
+
+    vlc_join( id->pipeline.thread, NULL );
 }
 
 int transcode_video_init( sout_stream_t *p_stream, const es_format_t *p_fmt,
@@ -287,6 +467,61 @@ int transcode_video_init( sout_stream_t *p_stream, const es_format_t *p_fmt,
     if( id->output_fifo == NULL )
         return VLC_ENOMEM;
 
+    /* Start the filter/encode pipeline stage before the decoder, so that
+     * pictures can be queued as soon as the decoder emits them. */
+    id->pipeline.fifo = picture_fifo_New();
+    if( id->pipeline.fifo == NULL )
+    {
+        block_FifoRelease( id->output_fifo );
+        return VLC_ENOMEM;
+    }
+    vlc_mutex_init( &id->pipeline.lock );
+    vlc_cond_init( &id->pipeline.wait );
+    vlc_cond_init( &id->pipeline.room );
+    id->pipeline.depth = 0;
+    id->pipeline.busy = false;
+    id->pipeline.closing = false;
+    if( vlc_clone( &id->pipeline.thread, TranscodeVideoWorker, id ) )
+    {
+        picture_fifo_Delete( id->pipeline.fifo );
+        id->pipeline.fifo = NULL;
+        block_FifoRelease( id->output_fifo );
+        return VLC_EGENERIC;
+    }
+
+    /* Extra ABR ladder rungs, fed with the same decoded pictures as the
+     * main encoder. A rung that cannot be allocated is simply dropped. */
+    if( id->i_ladder_count > 0 )
+    {
+        id->p_variants = calloc( id->i_ladder_count,
+                                 sizeof( *id->p_variants ) );
+        for( size_t i = 0; id->p_variants && i < id->i_ladder_count; i++ )
+        {
+            struct transcode_video_variant *p_var = &id->p_variants[i];
+            p_var->p_enccfg = &id->p_ladder_enccfgs[i];
+            p_var->output_fifo = block_FifoNew();
+            if( p_var->output_fifo == NULL )
+                break;
+            if( asprintf( &p_var->es_id, "%s/ladder%zu",
+                          id->es_id, i + 1 ) == -1 )
+            {
+                block_FifoRelease( p_var->output_fifo );
+                p_var->output_fifo = NULL;
+                p_var->es_id = NULL;
+                break;
+            }
+            id->i_variant_count++;
+        }
+        if( id->i_variant_count == 0 )
+        {
+            free( id->p_variants );
+            id->p_variants = NULL;
+        }
+        else
+            msg_Dbg( p_stream, "video ladder: %zu extra rung(s)",
+                     id->i_variant_count );
+    }
+
     id->b_transcode = true;
     es_format_Init( &id->decoder_out, VIDEO_ES, 0 );
 
@@ -313,6 +548,9 @@ int transcode_video_init( sout_stream_t *p_stream, const es_format_t *p_fmt,
     if( !id->p_decoder->p_module )
     {
         msg_Err( p_stream, "cannot find video decoder" );
+        transcode_video_pipeline_Stop( id );
+        picture_fifo_Delete( id->pipeline.fifo );
+        id->pipeline.fifo = NULL;
         es_format_Clean( &id->decoder_out );
         return VLC_EGENERIC;
     }
@@ -396,20 +634,49 @@ static int transcode_video_filters_init( sout_stream_t *p_stream,
 
 void transcode_video_flush( sout_stream_id_sys_t *id )
 {
+    /* Discard the queued pictures and wait out the in-flight one: the
+     * filter chains cannot be flushed while the worker runs them. */
+    vlc_mutex_lock( &id->pipeline.lock );
+    picture_fifo_Flush( id->pipeline.fifo, VLC_TICK_INVALID, true );
+    id->pipeline.depth = 0;
+    while( id->pipeline.busy )
+        vlc_cond_wait( &id->pipeline.room, &id->pipeline.lock );
+    vlc_mutex_unlock( &id->pipeline.lock );
+
     if ( id->p_f_chain != NULL )
         filter_chain_VideoFlush( id->p_f_chain );
     if ( id->p_uf_chain != NULL )
         filter_chain_VideoFlush( id->p_uf_chain );
     if ( id->p_final_conv_static != NULL )
         filter_chain_VideoFlush( id->p_final_conv_static );
+    for( size_t i = 0; i < id->i_variant_count; i++ )
+        if( id->p_variants[i].p_conv != NULL )
+            filter_chain_VideoFlush( id->p_variants[i].p_conv );
 }
 
 void transcode_video_clean( sout_stream_id_sys_t *id )
 {
+    if( id->pipeline.fifo != NULL )
+    {
+        transcode_video_pipeline_Stop( id );
+        picture_fifo_Delete( id->pipeline.fifo );
+    }
+
     /* Close encoder, but only if one was opened. */
     if ( id->encoder )
         transcode_encoder_delete( id->encoder );
 
+    for( size_t i = 0; i < id->i_variant_count; i++ )
+    {
+        struct transcode_video_variant *p_var = &id->p_variants[i];
+        if( p_var->encoder )
+            transcode_encoder_delete( p_var->encoder );
+        transcode_remove_filters( &p_var->p_conv );
+        block_FifoRelease( p_var->output_fifo );
+        free( p_var->es_id );
+    }
+    free( id->p_variants );
+
     es_format_Clean( &id->decoder_out );
 
     /* Close filters */
@@ -545,6 +812,28 @@ static int transcode_process_picture( sout_stream_id_sys_t *id,
 
             if( p_in )
             {
+                /* Tee the picture into the extra ladder rungs */
+                for( size_t i = 0; i < id->i_variant_count; i++ )
+                {
+                    struct transcode_video_variant *p_var = &id->p_variants[i];
+                    if( p_var->b_error || p_var->encoder == NULL ||
+                        p_var->p_conv == NULL ||
+                        !transcode_encoder_opened( p_var->encoder ) )
+                        continue;
+
+                    picture_t *p_scaled =
+                        filter_chain_VideoFilter( p_var->p_conv,
+                                                  picture_Hold( p_in ) );
+                    if( p_scaled == NULL )
+                        continue;
+
+                    block_t *p_rung_out =
+                        transcode_encoder_encode( p_var->encoder, p_scaled );
+                    picture_Release( p_scaled );
+                    if( p_rung_out != NULL )
+                        block_FifoPut( p_var->output_fifo, p_rung_out );
+                }
+
                 /* If a packetizer is used, multiple blocks might be returned, in w */
                 block_t *p_encoded = transcode_encoder_encode( id->encoder, p_in );
                 picture_Release( p_in );
@@ -574,6 +863,11 @@ int transcode_video_process( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
     if( id->encoder == NULL )
         return VLC_SUCCESS;
 
+    if( in == NULL )
+        /* Let the pipeline catch up so the encoder drain below covers
+         * every decoded picture */
+        transcode_video_pipeline_WaitIdle( id );
+
     vlc_fifo_Lock( id->output_fifo );
     if( unlikely( !id->b_error && in == NULL ) && transcode_encoder_opened( id->encoder ) )
     {
@@ -591,6 +885,23 @@ int transcode_video_process( sout_stream_t *p_stream, sout_stream_id_sys_t *id,
     }
     vlc_fifo_Unlock( id->output_fifo );
 
+    if( in == NULL && !has_error )
+    {
+        /* Drain the ladder rungs too; Send() forwards their fifos */
+        for( size_t i = 0; i < id->i_variant_count; i++ )
+        {
+            struct transcode_video_variant *p_var = &id->p_variants[i];
+            if( p_var->b_error || p_var->encoder == NULL ||
+                !transcode_encoder_opened( p_var->encoder ) )
+                continue;
+            block_t *p_drained = NULL;
+            if( transcode_encoder_drain( p_var->encoder,
+                                         &p_drained ) == VLC_SUCCESS &&
+                p_drained != NULL )
+                block_FifoPut( p_var->output_fifo, p_drained );
+        }
+    }
+
     if( b_eos )
         tag_last_block_with_flag( out, BLOCK_FLAG_END_OF_SEQUENCE );
 
@@ -148,39 +148,73 @@ static int Control(sout_stream_t *stream, int query, va_list args)
     return VLC_SUCCESS;
 }
 
+/* How many datagrams to gather in one system call at most */
+#define UDP_DGRAM_MAX 24
+
 static ssize_t AccessOutWrite(sout_access_out_t *access, block_t *block)
 {
     struct sout_stream_udp *sys = access->p_sys;
     ssize_t total = 0;
 
     while (block != NULL) {
-        struct iovec iov[16];
+        struct iovec iov[UDP_DGRAM_MAX][16];
+#ifdef __linux__
+        struct mmsghdr msgv[UDP_DGRAM_MAX];
+#else
+        struct msghdr msgv[UDP_DGRAM_MAX];
+#endif
         block_t *unsent = block;
-        unsigned iovlen = 0;
-        size_t tosend = 0;
+        unsigned dgrams = 0;
 
-        /* Count how many blocks to gather */
+        /* Lay the blocks out as datagrams of at most one MTU each */
         do {
-            if (iovlen >= ARRAY_SIZE(iov))
-                break;
-            if (unsent->i_buffer + tosend > sys->mtu && likely(iovlen > 0))
-                break;
-
-            iov[iovlen].iov_base = unsent->p_buffer;
-            iov[iovlen].iov_len = unsent->i_buffer;
-            iovlen++;
-            tosend += unsent->i_buffer;
-            unsent = unsent->p_next;
-        } while (unsent != NULL);
+            unsigned iovlen = 0;
+            size_t tosend = 0;
+
+            do {
+                if (iovlen >= ARRAY_SIZE(iov[dgrams]))
+                    break;
+                if (unsent->i_buffer + tosend > sys->mtu && likely(iovlen > 0))
+                    break;
+
+                iov[dgrams][iovlen].iov_base = unsent->p_buffer;
+                iov[dgrams][iovlen].iov_len = unsent->i_buffer;
+                iovlen++;
+                tosend += unsent->i_buffer;
+                unsent = unsent->p_next;
+            } while (unsent != NULL);
+
+#ifdef __linux__
+            msgv[dgrams] = (struct mmsghdr) {
+                .msg_hdr = { .msg_iov = iov[dgrams], .msg_iovlen = iovlen },
+            };
+#else
+            msgv[dgrams] = (struct msghdr) {
+                .msg_iov = iov[dgrams], .msg_iovlen = iovlen,
+            };
+#endif
+            dgrams++;
+        } while (unsent != NULL && dgrams < ARRAY_SIZE(msgv));
 
         /* Send */
-        struct msghdr hdr = { .msg_iov = iov, .msg_iovlen = iovlen };
-        ssize_t val = sendmsg(sys->fd, &hdr, 0);
+#ifdef __linux__
+        int val = sendmmsg(sys->fd, msgv, dgrams, 0);
 
         if (val < 0)
             msg_Err(access, "send error: %s", vlc_strerror_c(errno));
         else
-            total += val;
+            for (int i = 0; i < val; i++)
+                total += msgv[i].msg_len;
+#else
+        for (unsigned i = 0; i < dgrams; i++) {
+            ssize_t val = sendmsg(sys->fd, msgv + i, 0);
+
+            if (val < 0)
+                msg_Err(access, "send error: %s", vlc_strerror_c(errno));
+            else
+                total += val;
+        }
+#endif
 
         /* Free */
         do {
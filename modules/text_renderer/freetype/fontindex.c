@@ -0,0 +1,398 @@
+/*****************************************************************************
+ * fontindex.c : Persistent font family lookup index
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * The platform font backends can be expensive to query: the first lookup
+ * may enumerate every installed font, and CJK font sets make this slow
+ * enough to stall the first subtitle render. Since lookup results only
+ * change when font files change on disk, resolved (lookup key, family,
+ * font files) tuples are persisted in the user cache directory and
+ * reloaded on renderer open, validated against each font file's mtime.
+ *
+ * Index file layout, one record per line, tab-separated:
+ *   VLC/FONTINDEX 1                                 (magic)
+ *   f <mtime> <index> <flags> <family> <file>       (one per font face)
+ *   l <key> <family>                                (one per lookup key)
+ * Font records are grouped by family and precede the lookup records.
+ * Negative lookups are never persisted, so newly installed fonts are
+ * picked up by the next query.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_filter.h>
+#include <vlc_fs.h>
+#include <vlc_configuration.h>
+
+#include <sys/stat.h>
+#include <inttypes.h>
+
+#include "platform_fonts.h"
+#include "fonts/backends.h"
+#include "fontindex.h"
+
+#define FONTINDEX_MAGIC "VLC/FONTINDEX 1"
+
+static char *FontIndexPath( void )
+{
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir == NULL )
+        return NULL;
+
+    char *psz_path;
+    if( asprintf( &psz_path, "%s" DIR_SEP "fontindex.dat", psz_dir ) == -1 )
+        psz_path = NULL;
+    free( psz_dir );
+    return psz_path;
+}
+
+static void FontIndexFreeEntry( void *p_data, void *p_obj )
+{
+    VLC_UNUSED( p_obj );
+    free( p_data );
+}
+
+/* Splits up to i_max tab-separated fields in place; the last field keeps
+ * any remaining separators (font file paths may contain them) */
+static size_t FontIndexSplit( char *psz_line, char **ppsz_field, size_t i_max )
+{
+    size_t i_count = 0;
+    while( i_count < i_max )
+    {
+        ppsz_field[i_count++] = psz_line;
+        if( i_count == i_max )
+            break;
+        char *psz_sep = strchr( psz_line, '\t' );
+        if( psz_sep == NULL )
+            break;
+        *psz_sep = '\0';
+        psz_line = psz_sep + 1;
+    }
+    return i_count;
+}
+
+struct fontindex_font
+{
+    char *psz_file;
+    int   i_index;
+    int   i_flags;
+};
+
+/* Fonts of a family are committed together once the whole run validated,
+ * so a single stale file drops the family instead of leaving it with a
+ * partial style set */
+struct fontindex_pending
+{
+    char *psz_family;
+    bool  b_stale;
+    struct VLC_VECTOR(struct fontindex_font) fonts;
+};
+
+static void FontIndexFlushPending( vlc_font_select_t *fs,
+                                   struct fontindex_pending *p_pending,
+                                   vlc_dictionary_t *p_broken )
+{
+    if( p_pending->psz_family )
+    {
+        if( p_pending->b_stale )
+        {
+            if( !vlc_dictionary_has_key( p_broken, p_pending->psz_family ) )
+                vlc_dictionary_insert( p_broken, p_pending->psz_family, p_broken );
+        }
+        else if( p_pending->fonts.size > 0 &&
+                 vlc_dictionary_value_for_key( &fs->family_map, p_pending->psz_family )
+                        == kVLCDictionaryNotFound )
+        {
+            vlc_family_t *p_family = NewFamily( fs, p_pending->psz_family,
+                                                &fs->p_families, &fs->family_map,
+                                                p_pending->psz_family );
+            for( size_t i = 0; p_family && i < p_pending->fonts.size; i++ )
+            {
+                /* NewFont takes ownership of the file path */
+                NewFont( p_pending->fonts.data[i].psz_file,
+                         p_pending->fonts.data[i].i_index,
+                         p_pending->fonts.data[i].i_flags, p_family );
+                p_pending->fonts.data[i].psz_file = NULL;
+            }
+        }
+        free( p_pending->psz_family );
+        p_pending->psz_family = NULL;
+    }
+
+    for( size_t i = 0; i < p_pending->fonts.size; i++ )
+        free( p_pending->fonts.data[i].psz_file );
+    vlc_vector_clear( &p_pending->fonts );
+    p_pending->b_stale = false;
+}
+
+int FontIndexLoad( vlc_font_select_t *fs )
+{
+    char *psz_path = FontIndexPath();
+    if( psz_path == NULL )
+        return VLC_EGENERIC;
+
+    FILE *p_stream = vlc_fopen( psz_path, "rt" );
+    if( p_stream == NULL )
+    {
+        free( psz_path );
+        return VLC_EGENERIC;
+    }
+
+    /* Families whose cached font files changed or vanished */
+    vlc_dictionary_t broken;
+    vlc_dictionary_init( &broken, 17 );
+
+    struct fontindex_pending pending =
+        { NULL, false, VLC_VECTOR_INITIALIZER };
+
+    char *psz_line = NULL;
+    size_t i_bufsize = 0;
+    ssize_t i_len;
+    bool b_valid = false;
+    unsigned i_lookups = 0;
+
+    while( ( i_len = getline( &psz_line, &i_bufsize, p_stream ) ) > 0 )
+    {
+        if( psz_line[i_len - 1] == '\n' )
+            psz_line[--i_len] = '\0';
+
+        if( !b_valid )
+        {
+            b_valid = !strcmp( psz_line, FONTINDEX_MAGIC );
+            if( b_valid )
+                continue;
+            break;
+        }
+
+        if( psz_line[0] == 'f' && psz_line[1] == '\t' )
+        {
+            char *ppsz_field[5]; /* mtime, index, flags, family, file */
+            if( FontIndexSplit( psz_line + 2, ppsz_field, 5 ) != 5 )
+                continue;
+
+            if( pending.psz_family == NULL ||
+                strcmp( pending.psz_family, ppsz_field[3] ) )
+            {
+                FontIndexFlushPending( fs, &pending, &broken );
+                pending.psz_family = LowercaseDup( ppsz_field[3] );
+                if( pending.psz_family == NULL )
+                    break;
+                pending.b_stale =
+                    vlc_dictionary_has_key( &broken, pending.psz_family );
+            }
+            if( pending.b_stale )
+                continue;
+
+            struct stat st;
+            if( vlc_stat( ppsz_field[4], &st ) != 0 ||
+                (intmax_t)st.st_mtime != strtoimax( ppsz_field[0], NULL, 10 ) )
+            {
+                pending.b_stale = true;
+                continue;
+            }
+
+            struct fontindex_font font =
+                { strdup( ppsz_field[4] ),
+                  atoi( ppsz_field[1] ), atoi( ppsz_field[2] ) };
+            if( font.psz_file == NULL ||
+                !vlc_vector_push( &pending.fonts, font ) )
+            {
+                free( font.psz_file );
+                break;
+            }
+        }
+        else if( psz_line[0] == 'l' && psz_line[1] == '\t' )
+        {
+            FontIndexFlushPending( fs, &pending, &broken );
+
+            char *ppsz_field[2]; /* key, family */
+            if( FontIndexSplit( psz_line + 2, ppsz_field, 2 ) != 2 )
+                continue;
+
+            if( vlc_dictionary_has_key( &broken, ppsz_field[1] ) ||
+                vlc_dictionary_value_for_key( &fs->family_map, ppsz_field[1] )
+                        == kVLCDictionaryNotFound ||
+                vlc_dictionary_has_key( &fs->lookup_map, ppsz_field[0] ) )
+                continue;
+
+            char *psz_name = strdup( ppsz_field[1] );
+            if( psz_name == NULL )
+                break;
+            vlc_dictionary_insert( &fs->lookup_map, ppsz_field[0], psz_name );
+            i_lookups++;
+        }
+    }
+    FontIndexFlushPending( fs, &pending, &broken );
+
+    free( psz_line );
+    fclose( p_stream );
+    vlc_dictionary_clear( &broken, NULL, NULL );
+
+    if( !b_valid ) /* stale or corrupted index: drop it */
+        vlc_unlink( psz_path );
+    else if( i_lookups > 0 )
+        msg_Dbg( fs->p_obj, "font index: loaded %u cached lookups", i_lookups );
+    free( psz_path );
+
+    return b_valid ? VLC_SUCCESS : VLC_EGENERIC;
+}
+
+void FontIndexStore( vlc_font_select_t *fs )
+{
+    if( !fs->b_lookup_map_dirty )
+        return;
+
+    char *psz_path = FontIndexPath();
+    if( psz_path == NULL )
+        return;
+
+    char *psz_dir = config_GetUserDir( VLC_CACHE_DIR );
+    if( psz_dir != NULL )
+    {
+        vlc_mkdir( psz_dir, 0700 );
+        free( psz_dir );
+    }
+
+    char *psz_tmp;
+    if( asprintf( &psz_tmp, "%s.tmp", psz_path ) == -1 )
+    {
+        free( psz_path );
+        return;
+    }
+
+    FILE *p_stream = vlc_fopen( psz_tmp, "wt" );
+    if( p_stream != NULL )
+    {
+        bool b_ok = fprintf( p_stream, "%s\n", FONTINDEX_MAGIC ) > 0;
+
+        char **ppsz_keys = vlc_dictionary_all_keys( &fs->lookup_map );
+        if( ppsz_keys != NULL )
+        {
+            /* Families already written, so shared families are stored once */
+            vlc_dictionary_t written;
+            vlc_dictionary_init( &written, 17 );
+
+            /* Font records first, grouped per family as the loader expects */
+            for( size_t i = 0; b_ok && ppsz_keys[i]; i++ )
+            {
+                const char *psz_name =
+                    vlc_dictionary_value_for_key( &fs->lookup_map, ppsz_keys[i] );
+                if( vlc_dictionary_has_key( &written, psz_name ) )
+                    continue;
+                vlc_dictionary_insert( &written, psz_name, (void *) psz_name );
+
+                const vlc_family_t *p_family =
+                    vlc_dictionary_value_for_key( &fs->family_map, psz_name );
+                if( p_family == kVLCDictionaryNotFound )
+                    continue;
+
+                for( const vlc_font_t *p_font = p_family->p_fonts;
+                     b_ok && p_font; p_font = p_font->p_next )
+                {
+                    struct stat st;
+                    if( p_font->psz_fontfile == NULL ||
+                        p_font->psz_fontfile[0] == ':' || /* attachment */
+                        strchr( p_font->psz_fontfile, '\n' ) != NULL ||
+                        vlc_stat( p_font->psz_fontfile, &st ) != 0 )
+                        continue;
+                    b_ok = fprintf( p_stream, "f\t%jd\t%d\t%d\t%s\t%s\n",
+                                    (intmax_t)st.st_mtime, p_font->i_index,
+                                    p_font->i_flags, p_family->psz_name,
+                                    p_font->psz_fontfile ) > 0;
+                }
+            }
+
+            for( size_t i = 0; b_ok && ppsz_keys[i]; i++ )
+            {
+                const char *psz_name =
+                    vlc_dictionary_value_for_key( &fs->lookup_map, ppsz_keys[i] );
+                if( vlc_dictionary_value_for_key( &fs->family_map, psz_name )
+                        == kVLCDictionaryNotFound )
+                    continue;
+                b_ok = fprintf( p_stream, "l\t%s\t%s\n",
+                                ppsz_keys[i], psz_name ) > 0;
+            }
+
+            vlc_dictionary_clear( &written, NULL, NULL );
+            for( size_t i = 0; ppsz_keys[i]; i++ )
+                free( ppsz_keys[i] );
+            free( ppsz_keys );
+        }
+
+        if( fclose( p_stream ) != 0 )
+            b_ok = false;
+        if( b_ok )
+            vlc_rename( psz_tmp, psz_path );
+        else
+            vlc_unlink( psz_tmp );
+    }
+
+    free( psz_tmp );
+    free( psz_path );
+}
+
+void FontIndexClear( vlc_font_select_t *fs )
+{
+    vlc_dictionary_clear( &fs->lookup_map, FontIndexFreeEntry, NULL );
+}
+
+const vlc_family_t * FontIndexGetFamily( vlc_font_select_t *fs, const char *psz_key )
+{
+    const char *psz_name =
+        vlc_dictionary_value_for_key( &fs->lookup_map, psz_key );
+    if( psz_name == kVLCDictionaryNotFound )
+        return NULL;
+
+    const vlc_family_t *p_family =
+        vlc_dictionary_value_for_key( &fs->family_map, psz_name );
+    if( p_family == kVLCDictionaryNotFound || p_family->p_fonts == NULL )
+        return NULL; /* let the backend (re)populate the family */
+
+    return p_family;
+}
+
+void FontIndexCacheFamily( vlc_font_select_t *fs, const char *psz_key,
+                           const vlc_family_t *p_family )
+{
+    if( p_family->psz_name == NULL || p_family->p_fonts == NULL ||
+        strpbrk( psz_key, "\t\n" ) != NULL ||
+        strpbrk( p_family->psz_name, "\t\n" ) != NULL )
+        return;
+
+    char *psz_name =
+        vlc_dictionary_value_for_key( &fs->lookup_map, psz_key );
+    if( psz_name != kVLCDictionaryNotFound )
+    {
+        if( !strcmp( psz_name, p_family->psz_name ) )
+            return;
+        vlc_dictionary_remove_value_for_key( &fs->lookup_map, psz_key,
+                                             FontIndexFreeEntry, NULL );
+    }
+
+    psz_name = strdup( p_family->psz_name );
+    if( psz_name != NULL )
+    {
+        vlc_dictionary_insert( &fs->lookup_map, psz_key, psz_name );
+        fs->b_lookup_map_dirty = true;
+    }
+}
@@ -0,0 +1,63 @@
+/*****************************************************************************
+ * fontindex.h : Persistent font family lookup index
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+#ifndef FONTINDEX_H
+#define FONTINDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Loads the persisted family lookup index from the user cache directory
+ * into \ref vlc_font_select_t::lookup_map and \ref vlc_font_select_t::family_map.
+ * Entries whose font files changed on disk since they were indexed are
+ * discarded. Missing or unreadable index files are not an error.
+ */
+int FontIndexLoad( vlc_font_select_t * );
+
+/**
+ * Persists the family lookup index back to the user cache directory,
+ * if any lookup was added since \ref FontIndexLoad.
+ */
+void FontIndexStore( vlc_font_select_t * );
+
+/**
+ * Releases the lookup entries held by \ref vlc_font_select_t::lookup_map.
+ */
+void FontIndexClear( vlc_font_select_t * );
+
+/**
+ * Returns the indexed family for a lookup key, or NULL when the key is
+ * unknown or the indexed family carries no usable font.
+ */
+const vlc_family_t * FontIndexGetFamily( vlc_font_select_t *, const char *psz_key );
+
+/**
+ * Records a successful system lookup so later instances can resolve
+ * \p psz_key without querying the platform font backend.
+ */
+void FontIndexCacheFamily( vlc_font_select_t *, const char *psz_key,
+                           const vlc_family_t * );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
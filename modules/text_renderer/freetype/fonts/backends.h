@@ -49,6 +49,13 @@ struct vlc_font_select_t
     /* We need to limit caching of lookups as we do not control the names */
     vlc_lru           *families_lookup_lru;
 
+    /**
+     * Lookup results persisted across instances, mapping a lookup key to
+     * the matched family name within \ref family_map. See fontindex.c
+     */
+    vlc_dictionary_t  lookup_map;
+    bool              b_lookup_map_dirty;
+
     /**
      * This maps a family name to a vlc_family_t within the master list
      */
@@ -41,6 +41,8 @@
 #include <vlc_subpicture.h>
 #include <vlc_text_style.h>                                   /* text_style_t*/
 #include <vlc_charset.h>
+#include <vlc_hash.h>
+#include <vlc_strings.h>
 
 #include <assert.h>
 
@@ -918,6 +920,111 @@ static size_t SegmentsToTextAndStyles( filter_t *p_filter, const text_segment_t
     return i_nb_char;
 }
 
+/*
+ * Cache of whole rendered strings. Individual glyphs are already cached
+ * (see ftcache.c), but identical strings re-laid out and re-blended on
+ * every update — periodic timecodes, repeated OSD labels — still pay the
+ * full layout and blending cost. The key covers everything influencing
+ * the output: text, styles, scaling, flags and target format.
+ */
+#define RENDERED_TEXT_CACHE_SIZE 32
+
+typedef struct
+{
+    picture_t *p_picture;
+    int i_x, i_y;
+} rendered_text_t;
+
+static void RenderedTextRelease( void *priv, void *value )
+{
+    rendered_text_t *p_render = value;
+    VLC_UNUSED(priv);
+    picture_Release( p_render->p_picture );
+    free( p_render );
+}
+
+static void RenderedTextHashStyle( vlc_hash_md5_t *md5,
+                                   const text_style_t *p_style )
+{
+    if( !p_style )
+        return;
+    if( p_style->psz_fontname )
+        vlc_hash_md5_Update( md5, p_style->psz_fontname,
+                             strlen( p_style->psz_fontname ) + 1 );
+    if( p_style->psz_monofontname )
+        vlc_hash_md5_Update( md5, p_style->psz_monofontname,
+                             strlen( p_style->psz_monofontname ) + 1 );
+#define HASH_FIELD( f ) vlc_hash_md5_Update( md5, &p_style->f, sizeof(p_style->f) )
+    HASH_FIELD( i_features );
+    HASH_FIELD( i_style_flags );
+    HASH_FIELD( f_font_relsize );
+    HASH_FIELD( i_font_size );
+    HASH_FIELD( i_font_color );
+    HASH_FIELD( i_font_alpha );
+    HASH_FIELD( i_spacing );
+    HASH_FIELD( i_outline_color );
+    HASH_FIELD( i_outline_alpha );
+    HASH_FIELD( i_outline_width );
+    HASH_FIELD( i_shadow_color );
+    HASH_FIELD( i_shadow_alpha );
+    HASH_FIELD( i_shadow_width );
+    HASH_FIELD( i_background_color );
+    HASH_FIELD( i_background_alpha );
+    HASH_FIELD( e_wrapinfo );
+#undef HASH_FIELD
+}
+
+/* Returns false when the region cannot be keyed reliably */
+static bool RenderedTextKey( filter_t *p_filter,
+                             const subpicture_region_t *p_region_in,
+                             const vlc_fourcc_t *p_chroma_list,
+                             char psz_key[VLC_HASH_MD5_DIGEST_HEX_SIZE] )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    vlc_hash_md5_t md5;
+
+    vlc_hash_md5_Init( &md5 );
+
+    for( const text_segment_t *s = p_region_in->p_text; s; s = s->p_next )
+    {
+        if( s->p_ruby ) /* rare, and too entangled to key reliably */
+            return false;
+        if( s->psz_text )
+            vlc_hash_md5_Update( &md5, s->psz_text, strlen( s->psz_text ) + 1 );
+        RenderedTextHashStyle( &md5, s->style );
+    }
+
+    /* segment styles are merged with these at layout time */
+    RenderedTextHashStyle( &md5, p_sys->p_default_style );
+    RenderedTextHashStyle( &md5, p_sys->p_forced_style );
+
+#define HASH_VAL( v ) vlc_hash_md5_Update( &md5, &(v), sizeof(v) )
+    HASH_VAL( p_sys->i_scale );
+    HASH_VAL( p_sys->i_font_default_size );
+    HASH_VAL( p_sys->i_outline_thickness );
+    HASH_VAL( p_filter->fmt_out.video.i_visible_width );
+    HASH_VAL( p_filter->fmt_out.video.i_visible_height );
+    HASH_VAL( p_region_in->text_flags );
+    HASH_VAL( p_region_in->i_x );
+    HASH_VAL( p_region_in->i_y );
+    HASH_VAL( p_region_in->i_max_width );
+    HASH_VAL( p_region_in->i_max_height );
+    HASH_VAL( p_region_in->fmt.i_sar_num );
+    HASH_VAL( p_region_in->fmt.i_sar_den );
+    HASH_VAL( p_region_in->fmt.transfer );
+    HASH_VAL( p_region_in->fmt.primaries );
+    HASH_VAL( p_region_in->fmt.space );
+    if( p_chroma_list )
+        for( const vlc_fourcc_t *p_chroma = p_chroma_list; *p_chroma != 0;
+             p_chroma++ )
+            HASH_VAL( *p_chroma );
+    HASH_VAL( p_sys->i_forced_chroma );
+#undef HASH_VAL
+
+    vlc_hash_FinishHex( &md5, psz_key );
+    return true;
+}
+
 /**
  * This function renders a text subpicture region into another one.
  * It also calculates the size needed for this string, and renders the
@@ -948,6 +1055,32 @@ static subpicture_region_t *Render( filter_t *p_filter,
         p_sys->i_font_default_size = i_font_default_size;
     }
 
+    char psz_key[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    bool b_cacheable = p_sys->rendered_cache != NULL
+                    && RenderedTextKey( p_filter, p_region_in, p_chroma_list,
+                                        psz_key );
+    if( b_cacheable )
+    {
+        const rendered_text_t *p_render =
+            vlc_lru_Get( p_sys->rendered_cache, psz_key );
+        if( p_render )
+        {
+            /* Same text rendered with the same parameters: reference the
+             * cached picture instead of laying out and blending again */
+            region = subpicture_region_ForPicture( NULL, p_render->p_picture );
+            if( region )
+            {
+                region->fmt.i_sar_num = p_region_in->fmt.i_sar_num;
+                region->fmt.i_sar_den = p_region_in->fmt.i_sar_den;
+                region->i_x = p_render->i_x;
+                region->i_y = p_render->i_y;
+                region->i_alpha = p_region_in->i_alpha;
+                region->i_align = p_region_in->i_align;
+                return region;
+            }
+        }
+    }
+
     layout_text_block_t text_block = { 0 };
     text_block.b_balanced = (p_region_in->text_flags & VLC_SUBPIC_TEXT_FLAG_TEXT_NOT_BALANCED) == 0;
     text_block.b_grid = b_grid;
@@ -1152,6 +1285,19 @@ static subpicture_region_t *Render( filter_t *p_filter,
 
     if (region == NULL)
         msg_Warn( p_filter, "no output chroma supported for rendering" );
+    else if( b_cacheable && region->fmt.i_chroma != VLC_CODEC_YUVP )
+    {
+        /* YUVP is excluded: its palette travels in the region format and
+         * cannot be shared between regions */
+        rendered_text_t *p_render = malloc( sizeof(*p_render) );
+        if( p_render )
+        {
+            p_render->p_picture = picture_Hold( region->p_picture );
+            p_render->i_x = region->i_x;
+            p_render->i_y = region->i_y;
+            vlc_lru_Insert( p_sys->rendered_cache, psz_key, p_render );
+        }
+    }
 
 done:
     FreeLines( text_block.p_laid );
@@ -1202,6 +1348,11 @@ static int Create( filter_t *p_filter )
     if( !p_sys->ftcache )
         goto error;
 
+    p_sys->rendered_cache = vlc_lru_New( RENDERED_TEXT_CACHE_SIZE,
+                                         RenderedTextRelease, NULL );
+    if( !p_sys->rendered_cache )
+        goto error;
+
     p_sys->i_scale = 100;
 
     /* default style to apply to incomplete segments styles */
@@ -1268,6 +1419,9 @@ static void Destroy( filter_t *p_filter )
         DumpFamilies( p_sys->fs );
 #endif
 
+    if( p_sys->rendered_cache )
+        vlc_lru_Release( p_sys->rendered_cache );
+
     if( p_sys->ftcache )
         vlc_ftcache_Delete( p_sys->ftcache );
 
@@ -47,6 +47,7 @@
 
 #include "platform_fonts.h"
 #include "freetype.h"
+#include "fontindex.h"
 #include "fonts/backends.h"
 
 FT_Face doLoadFace( void *ctx, const char *psz_fontfile, int i_idx )
@@ -875,11 +876,16 @@ vlc_font_select_t * FontSelectNew( filter_t *p_filter )
     /* Dictionaries for families */
     vlc_dictionary_init( &fs->family_map, 53 );
     vlc_dictionary_init( &fs->fallback_map, 23 );
+    vlc_dictionary_init( &fs->lookup_map, 53 );
 
     fs->families_lookup_lru = vlc_lru_New( 23, NULL, NULL );
     if( !fs->families_lookup_lru )
         goto error;
 
+    /* Reuse lookups persisted by earlier instances so the platform
+     * backends are only queried for names we have never resolved */
+    FontIndexLoad( fs );
+
 #ifdef HAVE_FONTCONFIG
     fs->pf_select_family = FontConfig_GetFamily;
     fs->pf_select_among_families = FontConfig_SelectAmongFamilies;
@@ -953,6 +959,9 @@ void FontSelectDelete( vlc_font_select_t *fs )
     if( fs->families_lookup_lru )
         vlc_lru_Release( fs->families_lookup_lru );
 
+    FontIndexStore( fs );
+    FontIndexClear( fs );
+
     /* Dicts */
     vlc_dictionary_clear( &fs->fallback_map, FreeFamilies, fs );
     vlc_dictionary_clear( &fs->family_map, NULL, NULL );
@@ -964,9 +973,14 @@ void FontSelectDelete( vlc_font_select_t *fs )
 
 const vlc_family_t * FontSelectFamily( vlc_font_select_t *fs, const char *psz_lcname )
 {
-    const vlc_family_t *p_family = NULL;
+    const vlc_family_t *p_family = FontIndexGetFamily( fs, psz_lcname );
+    if( p_family )
+        return p_family;
+
     if( fs->pf_select_family )
         fs->pf_select_family( fs, psz_lcname, &p_family );
+    if( p_family )
+        FontIndexCacheFamily( fs, psz_lcname, p_family );
     return p_family;
 }
 
@@ -976,7 +990,14 @@ const vlc_family_t * FontSelectAmongFamilies( vlc_font_select_t *fs, const fontf
     if( vlc_lru_HasKey( fs->families_lookup_lru, families->psz_key ) )
         return vlc_lru_Get( fs->families_lookup_lru, families->psz_key );
 
-    const vlc_family_t *p_family = NULL;
+    const vlc_family_t *p_family = FontIndexGetFamily( fs, families->psz_key );
+    if( p_family )
+    {
+        vlc_lru_Insert( fs->families_lookup_lru, families->psz_key,
+                        (void *) p_family );
+        return p_family;
+    }
+
     if( fs->pf_select_among_families )
     {
         if( fs->pf_select_among_families( fs, families, &p_family ) != VLC_SUCCESS )
@@ -992,6 +1013,8 @@ const vlc_family_t * FontSelectAmongFamilies( vlc_font_select_t *fs, const fontf
                 break;
         }
     }
+    if( p_family )
+        FontIndexCacheFamily( fs, families->psz_key, p_family );
     vlc_lru_Insert( fs->families_lookup_lru, families->psz_key, (void *) p_family );
     return p_family;
 }
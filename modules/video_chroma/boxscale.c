@@ -0,0 +1,278 @@
+/*****************************************************************************
+ * boxscale.c: integer box-average downscaler for planar 8-bit YUV
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Preamble
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include <vlc_cpu.h>
+
+/*
+ * Downscaling a large picture to a tiny one (thumbnails, preview walls)
+ * with a generic resampler wastes most of its work on sub-pixel filtering
+ * that cannot be seen at the target size. When the scaling factor is a
+ * plain integer, averaging each RxR input box is both the correct area
+ * filter and a single pass over the source. This converter only handles
+ * that case - same chroma, planar 8-bit, exact integer ratio - and leaves
+ * everything else to the generic scaler at a lower priority.
+ */
+
+static int Open( filter_t * );
+
+vlc_module_begin ()
+    set_description( N_("Integer box-average video downscaler") )
+    set_shortname( N_("Boxscale") )
+    set_callback_video_converter( Open, 200 )
+vlc_module_end ()
+
+typedef void (*pf_reduce_t)( uint8_t *, size_t, const uint8_t *, size_t,
+                             unsigned, unsigned, unsigned, unsigned );
+
+typedef struct
+{
+    unsigned rx;        /**< horizontal reduction factor */
+    unsigned ry;        /**< vertical reduction factor */
+    pf_reduce_t pf_reduce;
+} filter_sys_t;
+
+/* Averages every rx*ry input box into one output pixel, with rounding to
+ * nearest. Output is w*h pixels, so the input area is (w*rx)*(h*ry). */
+static void Box_C( uint8_t *dst, size_t dst_pitch,
+                   const uint8_t *src, size_t src_pitch,
+                   unsigned w, unsigned h, unsigned rx, unsigned ry )
+{
+    const unsigned area = rx * ry;
+
+    for( unsigned y = 0; y < h; y++ )
+    {
+        const uint8_t *in = src + (size_t)y * ry * src_pitch;
+        uint8_t *out = dst + (size_t)y * dst_pitch;
+
+        for( unsigned x = 0; x < w; x++ )
+        {
+            const uint8_t *px = in + (size_t)x * rx;
+            unsigned sum = area / 2;
+
+            for( unsigned j = 0; j < ry; j++ )
+            {
+                for( unsigned i = 0; i < rx; i++ )
+                    sum += px[i];
+                px += src_pitch;
+            }
+            out[x] = sum / area;
+        }
+    }
+}
+
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+
+# ifdef __SSE2__
+#  define VLC_SSE2
+# else
+#  define VLC_SSE2 __attribute__ ((__target__ ("sse2")))
+# endif
+
+/* 2x2 box average, bit identical to Box_C with rx = ry = 2: eight output
+ * pixels are produced from two 16 byte row loads per iteration. */
+VLC_SSE2 static void Halve_SSE2( uint8_t *dst, size_t dst_pitch,
+                                 const uint8_t *src, size_t src_pitch,
+                                 unsigned w, unsigned h,
+                                 unsigned rx, unsigned ry )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi32(2);
+
+    for( unsigned y = 0; y < h; y++ )
+    {
+        const uint8_t *r0 = src + (size_t)2 * y * src_pitch;
+        const uint8_t *r1 = r0 + src_pitch;
+        uint8_t *out = dst + (size_t)y * dst_pitch;
+        unsigned x = 0;
+
+        for( ; x + 8 <= w; x += 8 )
+        {
+            __m128i a = _mm_loadu_si128( (const __m128i *)&r0[2 * x] );
+            __m128i b = _mm_loadu_si128( (const __m128i *)&r1[2 * x] );
+            /* per column sums of the two rows, on 16 bits lanes */
+            __m128i lo = _mm_add_epi16( _mm_unpacklo_epi8( a, zero ),
+                                        _mm_unpacklo_epi8( b, zero ) );
+            __m128i hi = _mm_add_epi16( _mm_unpackhi_epi8( a, zero ),
+                                        _mm_unpackhi_epi8( b, zero ) );
+            /* add adjacent columns, then round */
+            lo = _mm_srli_epi32( _mm_add_epi32( _mm_madd_epi16( lo, ones ),
+                                                two ), 2 );
+            hi = _mm_srli_epi32( _mm_add_epi32( _mm_madd_epi16( hi, ones ),
+                                                two ), 2 );
+            __m128i res = _mm_packus_epi16( _mm_packs_epi32( lo, hi ), zero );
+            _mm_storel_epi64( (__m128i *)&out[x], res );
+        }
+        for( ; x < w; x++ )
+            out[x] = ( r0[2 * x] + r0[2 * x + 1] +
+                       r1[2 * x] + r1[2 * x + 1] + 2 ) >> 2;
+    }
+    (void) rx; (void) ry;
+}
+
+/* 4x4 box average, bit identical to Box_C with rx = ry = 4: four output
+ * pixels are produced from four 16 byte row loads per iteration. */
+VLC_SSE2 static void Quarter_SSE2( uint8_t *dst, size_t dst_pitch,
+                                   const uint8_t *src, size_t src_pitch,
+                                   unsigned w, unsigned h,
+                                   unsigned rx, unsigned ry )
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i eight = _mm_set1_epi32(8);
+
+    for( unsigned y = 0; y < h; y++ )
+    {
+        const uint8_t *in = src + (size_t)4 * y * src_pitch;
+        uint8_t *out = dst + (size_t)y * dst_pitch;
+        unsigned x = 0;
+
+        for( ; x + 4 <= w; x += 4 )
+        {
+            /* per column sums of the four rows; at most 4 * 255 per lane */
+            __m128i lo = zero, hi = zero;
+            for( unsigned j = 0; j < 4; j++ )
+            {
+                __m128i r = _mm_loadu_si128(
+                    (const __m128i *)&in[j * src_pitch + 4 * x] );
+                lo = _mm_add_epi16( lo, _mm_unpacklo_epi8( r, zero ) );
+                hi = _mm_add_epi16( hi, _mm_unpackhi_epi8( r, zero ) );
+            }
+            /* fold pairs of columns twice to get the four 4x4 sums */
+            lo = _mm_madd_epi16( lo, ones );
+            hi = _mm_madd_epi16( hi, ones );
+            lo = _mm_add_epi32( lo, _mm_shuffle_epi32( lo, _MM_SHUFFLE(2, 3, 0, 1) ) );
+            hi = _mm_add_epi32( hi, _mm_shuffle_epi32( hi, _MM_SHUFFLE(2, 3, 0, 1) ) );
+            __m128i sum = _mm_unpacklo_epi64(
+                _mm_shuffle_epi32( lo, _MM_SHUFFLE(2, 0, 2, 0) ),
+                _mm_shuffle_epi32( hi, _MM_SHUFFLE(2, 0, 2, 0) ) );
+            sum = _mm_srli_epi32( _mm_add_epi32( sum, eight ), 4 );
+            __m128i res = _mm_packus_epi16( _mm_packs_epi32( sum, zero ), zero );
+            *(uint32_t *)&out[x] = _mm_cvtsi128_si32( res );
+        }
+        if( x < w )
+            Box_C( &out[x], dst_pitch, &in[4 * x], src_pitch, w - x, 1, 4, 4 );
+    }
+    (void) rx; (void) ry;
+}
+#endif /* HAVE_SSE2_INTRINSICS */
+
+static void BoxScale( filter_t *p_filter, picture_t *p_source,
+                      picture_t *p_dest )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+
+    for( int i = 0; i < p_dest->i_planes; i++ )
+    {
+        const plane_t *p_src = &p_source->p[i];
+        plane_t *p_dst = &p_dest->p[i];
+
+        assert( p_src->i_visible_pitch == p_dst->i_visible_pitch * (int)p_sys->rx );
+        assert( p_src->i_visible_lines == p_dst->i_visible_lines * (int)p_sys->ry );
+        p_sys->pf_reduce( p_dst->p_pixels, p_dst->i_pitch,
+                          p_src->p_pixels, p_src->i_pitch,
+                          p_dst->i_visible_pitch, p_dst->i_visible_lines,
+                          p_sys->rx, p_sys->ry );
+    }
+}
+
+static void Close( filter_t *p_filter )
+{
+    free( p_filter->p_sys );
+}
+
+VIDEO_FILTER_WRAPPER_CLOSE( BoxScale, Close )
+
+static int Open( filter_t *p_filter )
+{
+    const video_format_t *p_in = &p_filter->fmt_in.video;
+    const video_format_t *p_out = &p_filter->fmt_out.video;
+
+    if( p_in->i_chroma != p_out->i_chroma ||
+        p_in->orientation != p_out->orientation )
+        return VLC_EGENERIC;
+    if( p_in->i_x_offset != 0 || p_in->i_y_offset != 0 ||
+        p_out->i_x_offset != 0 || p_out->i_y_offset != 0 )
+        return VLC_EGENERIC;
+
+    const vlc_chroma_description_t *desc =
+        vlc_fourcc_GetChromaDescription( p_in->i_chroma );
+    if( desc == NULL || desc->plane_count == 0 || desc->pixel_size != 1 ||
+        !vlc_fourcc_IsYUV( p_in->i_chroma ) )
+        return VLC_EGENERIC;
+
+    if( p_out->i_visible_width == 0 || p_out->i_visible_height == 0 )
+        return VLC_EGENERIC;
+
+    /* Only exact integer reductions: anything else is the generic
+     * scaler's job. */
+    unsigned rx = p_in->i_visible_width / p_out->i_visible_width;
+    unsigned ry = p_in->i_visible_height / p_out->i_visible_height;
+    if( rx < 2 || ry < 2 || rx > 64 || ry > 64 ||
+        rx * p_out->i_visible_width != p_in->i_visible_width ||
+        ry * p_out->i_visible_height != p_in->i_visible_height )
+        return VLC_EGENERIC;
+
+    /* The factor must hold exactly on every (subsampled) plane */
+    for( unsigned i = 0; i < desc->plane_count; i++ )
+    {
+        if( ( p_in->i_visible_width * desc->p[i].w.num ) % desc->p[i].w.den ||
+            ( p_out->i_visible_width * desc->p[i].w.num ) % desc->p[i].w.den ||
+            ( p_in->i_visible_height * desc->p[i].h.num ) % desc->p[i].h.den ||
+            ( p_out->i_visible_height * desc->p[i].h.num ) % desc->p[i].h.den )
+            return VLC_EGENERIC;
+    }
+
+    filter_sys_t *p_sys = malloc( sizeof (*p_sys) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+    p_sys->rx = rx;
+    p_sys->ry = ry;
+    p_sys->pf_reduce = Box_C;
+#ifdef HAVE_SSE2_INTRINSICS
+    if( vlc_CPU_SSE2() )
+    {
+        if( rx == 2 && ry == 2 )
+            p_sys->pf_reduce = Halve_SSE2;
+        else if( rx == 4 && ry == 4 )
+            p_sys->pf_reduce = Quarter_SSE2;
+    }
+#endif
+
+    p_filter->p_sys = p_sys;
+    p_filter->ops = &BoxScale_ops;
+    return VLC_SUCCESS;
+}
@@ -121,7 +121,37 @@ void CopyCleanCache(copy_cache_t *cache)
 #define COPY64(dstp, srcp, load, store) \
     COPY64_S(dstp, srcp, load, store, "")
 
+#ifdef CAN_COMPILE_AVX2
+/* Copy 128 bytes from srcp to dstp using 4 AVX2 256-bit registers. */
+
+#define COPY128_SHIFTR(x) \
+    "vpsrlw "x", %%ymm1, %%ymm1\n" \
+    "vpsrlw "x", %%ymm2, %%ymm2\n" \
+    "vpsrlw "x", %%ymm3, %%ymm3\n" \
+    "vpsrlw "x", %%ymm4, %%ymm4\n"
+#define COPY128_SHIFTL(x) \
+    "vpsllw "x", %%ymm1, %%ymm1\n" \
+    "vpsllw "x", %%ymm2, %%ymm2\n" \
+    "vpsllw "x", %%ymm3, %%ymm3\n" \
+    "vpsllw "x", %%ymm4, %%ymm4\n"
+
+#define COPY128_S(dstp, srcp, load, store, shiftstr) \
+    asm volatile (                      \
+        load "   0(%[src]), %%ymm1\n"   \
+        load "  32(%[src]), %%ymm2\n"   \
+        load "  64(%[src]), %%ymm3\n"   \
+        load "  96(%[src]), %%ymm4\n"   \
+        shiftstr                        \
+        store " %%ymm1,    0(%[dst])\n" \
+        store " %%ymm2,   32(%[dst])\n" \
+        store " %%ymm3,   64(%[dst])\n" \
+        store " %%ymm4,   96(%[dst])\n" \
+        : : [dst]"r"(dstp), [src]"r"(srcp) : "memory", "xmm1", "xmm2", "xmm3", "xmm4")
+#endif /* CAN_COMPILE_AVX2 */
+
 #ifdef COPY_TEST_NOOPTIM
+# undef vlc_CPU_AVX2
+# define vlc_CPU_AVX2() (0)
 # undef vlc_CPU_SSE4_1
 # define vlc_CPU_SSE4_1() (0)
 # undef vlc_CPU_SSE3
@@ -132,6 +162,70 @@ void CopyCleanCache(copy_cache_t *cache)
 # define vlc_CPU_SSE2() (0)
 #endif
 
+#ifdef CAN_COMPILE_AVX2
+/* AVX2 variant of CopyFromUswc: streaming loads move 32 bytes per
+ * instruction out of USWC memory, which roughly doubles the attainable
+ * bandwidth over the SSE4.1 path on CPUs with 256-bit load ports. */
+VLC_AVX
+static void AVX2_CopyFromUswc(uint8_t *dst, size_t dst_pitch,
+                              const uint8_t *src, size_t src_pitch,
+                              unsigned width, unsigned height, int bitshift)
+{
+    assert(((intptr_t)dst & 0x0f) == 0 && (dst_pitch & 0x0f) == 0);
+
+    asm volatile ("mfence");
+
+#define AVX2_USWC_COPY(shiftstr16, shiftstr128) \
+    for (unsigned y = 0; y < height; y++) { \
+        const unsigned unaligned = (-(uintptr_t)src) & 0x1f; \
+        unsigned x = unaligned; \
+        if (unaligned) { \
+            /* The prefix is rewritten by the aligned loop past x */ \
+            COPY16_S(dst, src, "movdqu", "movdqa", shiftstr16); \
+            if (unaligned > 16) \
+                COPY16_S(dst + 16, src + 16, "movdqu", "movdqa", shiftstr16); \
+        } \
+        for (; x+127 < width; x += 128) \
+            COPY128_S(&dst[x], &src[x], "vmovntdqa", "vmovdqu", shiftstr128); \
+        if (x < width) \
+            CopyPlane(&dst[x], dst_pitch - x, &src[x], src_pitch - x, 1, bitshift); \
+        src += src_pitch; \
+        dst += dst_pitch; \
+    }
+
+    switch (bitshift)
+    {
+        case 0:
+            AVX2_USWC_COPY("", "")
+            break;
+        case -6:
+            AVX2_USWC_COPY(COPY16_SHIFTL("$6"), COPY128_SHIFTL("$6"))
+            break;
+        case 6:
+            AVX2_USWC_COPY(COPY16_SHIFTR("$6"), COPY128_SHIFTR("$6"))
+            break;
+        case 2:
+            AVX2_USWC_COPY(COPY16_SHIFTR("$2"), COPY128_SHIFTR("$2"))
+            break;
+        case -2:
+            AVX2_USWC_COPY(COPY16_SHIFTL("$2"), COPY128_SHIFTL("$2"))
+            break;
+        case 4:
+            AVX2_USWC_COPY(COPY16_SHIFTR("$4"), COPY128_SHIFTR("$4"))
+            break;
+        case -4:
+            AVX2_USWC_COPY(COPY16_SHIFTL("$2"), COPY128_SHIFTL("$2"))
+            break;
+        default:
+            vlc_assert_unreachable();
+    }
+#undef AVX2_USWC_COPY
+
+    asm volatile ("vzeroupper");
+    asm volatile ("mfence");
+}
+#endif /* CAN_COMPILE_AVX2 */
+
 /* Optimized copy from "Uncacheable Speculative Write Combining" memory
  * as used by some video surface.
  * XXX It is really efficient only when SSE4.1 is available.
@@ -143,6 +237,12 @@ static void CopyFromUswc(uint8_t *dst, size_t dst_pitch,
 {
     assert(((intptr_t)dst & 0x0f) == 0 && (dst_pitch & 0x0f) == 0);
 
+#ifdef CAN_COMPILE_AVX2
+    if (vlc_CPU_AVX2() && width >= 128)
+        return AVX2_CopyFromUswc(dst, dst_pitch, src, src_pitch,
+                                 width, height, bitshift);
+#endif
+
     asm volatile ("mfence");
 
 #define SSE_USWC_COPY(shiftstr16, shiftstr64) \
@@ -233,6 +333,74 @@ static void Copy2d(uint8_t *dst, size_t dst_pitch,
     }
 }
 
+#ifdef CAN_COMPILE_AVX2
+VLC_AVX
+static void
+AVX2_InterleaveUV(uint8_t *dst, size_t dst_pitch,
+                  uint8_t *srcu, size_t srcu_pitch,
+                  uint8_t *srcv, size_t srcv_pitch,
+                  unsigned int width, unsigned int height, uint8_t pixel_size)
+{
+    assert(pixel_size == 1 || pixel_size == 2);
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        unsigned int x;
+
+#define AVX2_INTERLEAVE(unpckl, unpckh) \
+        for (x = 0; x < (width & ~63); x += 64) \
+            asm volatile ( \
+                "vmovdqu (%[src1]), %%ymm0\n" \
+                "vmovdqu (%[src2]), %%ymm1\n" \
+                "vmovdqu 32(%[src1]), %%ymm4\n" \
+                "vmovdqu 32(%[src2]), %%ymm5\n" \
+                unpckl " %%ymm1, %%ymm0, %%ymm2\n" \
+                unpckh " %%ymm1, %%ymm0, %%ymm3\n" \
+                unpckl " %%ymm5, %%ymm4, %%ymm6\n" \
+                unpckh " %%ymm5, %%ymm4, %%ymm7\n" \
+                "vperm2i128 $0x20, %%ymm3, %%ymm2, %%ymm0\n" \
+                "vperm2i128 $0x31, %%ymm3, %%ymm2, %%ymm1\n" \
+                "vperm2i128 $0x20, %%ymm7, %%ymm6, %%ymm4\n" \
+                "vperm2i128 $0x31, %%ymm7, %%ymm6, %%ymm5\n" \
+                "vmovdqu %%ymm0,   (%[dst])\n" \
+                "vmovdqu %%ymm1, 32(%[dst])\n" \
+                "vmovdqu %%ymm4, 64(%[dst])\n" \
+                "vmovdqu %%ymm5, 96(%[dst])\n" \
+                : : [dst]"r"(dst+2*x), \
+                    [src1]"r"(srcu+x), [src2]"r"(srcv+x) \
+                : "memory", "xmm0", "xmm1", "xmm2", "xmm3", \
+                  "xmm4", "xmm5", "xmm6", "xmm7" \
+            );
+
+        if (pixel_size == 1)
+        {
+            AVX2_INTERLEAVE("vpunpcklbw", "vpunpckhbw")
+            for (; x < width; x++) {
+                dst[2*x+0] = srcu[x];
+                dst[2*x+1] = srcv[x];
+            }
+        }
+        else
+        {
+            AVX2_INTERLEAVE("vpunpcklwd", "vpunpckhwd")
+            for (; x < width; x+= 2) {
+                dst[2*x+0] = srcu[x];
+                dst[2*x+1] = srcu[x + 1];
+                dst[2*x+2] = srcv[x];
+                dst[2*x+3] = srcv[x + 1];
+            }
+        }
+#undef AVX2_INTERLEAVE
+
+        srcu += srcu_pitch;
+        srcv += srcv_pitch;
+        dst += dst_pitch;
+    }
+
+    asm volatile ("vzeroupper");
+}
+#endif /* CAN_COMPILE_AVX2 */
+
 VLC_SSE
 static void
 SSE_InterleaveUV(uint8_t *dst, size_t dst_pitch,
@@ -243,6 +411,12 @@ SSE_InterleaveUV(uint8_t *dst, size_t dst_pitch,
     assert(!((intptr_t)srcu & 0xf) && !(srcu_pitch & 0x0f) &&
            !((intptr_t)srcv & 0xf) && !(srcv_pitch & 0x0f));
 
+#ifdef CAN_COMPILE_AVX2
+    if (vlc_CPU_AVX2())
+        return AVX2_InterleaveUV(dst, dst_pitch, srcu, srcu_pitch,
+                                 srcv, srcv_pitch, width, height, pixel_size);
+#endif
+
     static const uint8_t shuffle_8[] = { 0, 8,
                                          1, 9,
                                          2, 10,
@@ -349,6 +523,70 @@ SSE_InterleaveUV(uint8_t *dst, size_t dst_pitch,
     }
 }
 
+#ifdef CAN_COMPILE_AVX2
+VLC_AVX
+static void AVX2_SplitUV(uint8_t *dstu, size_t dstu_pitch,
+                         uint8_t *dstv, size_t dstv_pitch,
+                         const uint8_t *src, size_t src_pitch,
+                         unsigned width, unsigned height, uint8_t pixel_size)
+{
+    assert(pixel_size == 1 || pixel_size == 2);
+
+    /* Per 128-bit lane deinterleave, the lanes are reordered afterwards */
+    static const uint8_t shuffle_8[] = { 0, 2, 4, 6, 8, 10, 12, 14,
+                                         1, 3, 5, 7, 9, 11, 13, 15,
+                                         0, 2, 4, 6, 8, 10, 12, 14,
+                                         1, 3, 5, 7, 9, 11, 13, 15 };
+    static const uint8_t shuffle_16[] = {  0,  1,  4,  5,  8,  9, 12, 13,
+                                           2,  3,  6,  7, 10, 11, 14, 15,
+                                           0,  1,  4,  5,  8,  9, 12, 13,
+                                           2,  3,  6,  7, 10, 11, 14, 15 };
+    const uint8_t *shuffle = pixel_size == 1 ? shuffle_8 : shuffle_16;
+
+    for (unsigned y = 0; y < height; y++) {
+        unsigned x = 0;
+        for (; x < (width & ~31); x += 32) {
+            asm volatile (
+                "vmovdqu (%[shuffle]), %%ymm7\n"
+                "vmovdqu (%[src]), %%ymm0\n"
+                "vmovdqu 32(%[src]), %%ymm1\n"
+                "vpshufb %%ymm7, %%ymm0, %%ymm0\n"
+                "vpshufb %%ymm7, %%ymm1, %%ymm1\n"
+                "vpermq $0xd8, %%ymm0, %%ymm0\n"
+                "vpermq $0xd8, %%ymm1, %%ymm1\n"
+                "vperm2i128 $0x20, %%ymm1, %%ymm0, %%ymm2\n"
+                "vperm2i128 $0x31, %%ymm1, %%ymm0, %%ymm3\n"
+                "vmovdqu %%ymm2, (%[dst1])\n"
+                "vmovdqu %%ymm3, (%[dst2])\n"
+                : : [dst1]"r"(&dstu[x]), [dst2]"r"(&dstv[x]),
+                    [src]"r"(&src[2*x]), [shuffle]"r"(shuffle)
+                : "memory", "xmm0", "xmm1", "xmm2", "xmm3", "xmm7");
+        }
+        if (pixel_size == 1)
+        {
+            for (; x < width; x++) {
+                dstu[x] = src[2*x+0];
+                dstv[x] = src[2*x+1];
+            }
+        }
+        else
+        {
+            for (; x < width; x+= 2) {
+                dstu[x] = src[2*x+0];
+                dstu[x+1] = src[2*x+1];
+                dstv[x] = src[2*x+2];
+                dstv[x+1] = src[2*x+3];
+            }
+        }
+        src  += src_pitch;
+        dstu += dstu_pitch;
+        dstv += dstv_pitch;
+    }
+
+    asm volatile ("vzeroupper");
+}
+#endif /* CAN_COMPILE_AVX2 */
+
 VLC_SSE
 static void SSE_SplitUV(uint8_t *dstu, size_t dstu_pitch,
                         uint8_t *dstv, size_t dstv_pitch,
@@ -358,6 +596,12 @@ static void SSE_SplitUV(uint8_t *dstu, size_t dstu_pitch,
     assert(pixel_size == 1 || pixel_size == 2);
     assert(((intptr_t)src & 0xf) == 0 && (src_pitch & 0x0f) == 0);
 
+#ifdef CAN_COMPILE_AVX2
+    if (vlc_CPU_AVX2())
+        return AVX2_SplitUV(dstu, dstu_pitch, dstv, dstv_pitch,
+                            src, src_pitch, width, height, pixel_size);
+#endif
+
 #define LOAD64 \
     "movdqa  0(%[src]), %%xmm0\n" \
     "movdqa 16(%[src]), %%xmm1\n" \
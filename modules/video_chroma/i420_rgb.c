@@ -40,7 +40,7 @@
 #ifdef PLUGIN_PLAIN
 # include "i420_rgb_c.h"
 
-static void SetYUV( filter_t * );
+static void SetYUV( filter_t *, void * );
 static void Set8bppPalette( filter_t *, uint8_t * );
 #endif
 
@@ -85,6 +85,79 @@ VIDEO_FILTER_WRAPPER_CLOSE_EXT( I420_RGB16, Deactivate )
 VIDEO_FILTER_WRAPPER_CLOSE_EXT( I420_RGB32, Deactivate )
 #endif
 
+#ifdef PLUGIN_PLAIN
+/*****************************************************************************
+ * Conversion table cache
+ *****************************************************************************
+ * The conversion tables only depend on the output pixel packing: the YUV
+ * coefficients are compile-time constants (see i420_rgb_c.h), so every
+ * instance converting to the same pixel format derives the exact same
+ * tables. Filter chains get torn down and rebuilt on any format change
+ * (adaptive streaming quality switches in particular), hence the derived
+ * tables are shared process-wide and reference counted instead of being
+ * recomputed for each instance.
+ *****************************************************************************/
+struct rgb_table
+{
+    struct rgb_table *next;
+    vlc_fourcc_t i_chroma;             /* output pixel format */
+    unsigned  i_refs;
+    uint32_t  p_data[];
+};
+
+static vlc_mutex_t table_lock = VLC_STATIC_MUTEX;
+static struct rgb_table *p_table_cache = NULL;
+
+static struct rgb_table *rgb_table_Hold( filter_t *p_filter, uint8_t i_bytespp )
+{
+    const vlc_fourcc_t i_chroma = p_filter->fmt_out.video.i_chroma;
+    /* The palette lookup table is indexed by (quantized) YUV, not by
+     * component value, and is larger than the component tables */
+    const size_t i_size = ( i_bytespp == 1 ) ? PALETTE_TABLE_SIZE
+                                             : i_bytespp * RGB_TABLE_SIZE;
+    struct rgb_table *p_table;
+
+    vlc_mutex_lock( &table_lock );
+    for( p_table = p_table_cache; p_table != NULL; p_table = p_table->next )
+        if( p_table->i_chroma == i_chroma )
+            break;
+
+    if( p_table == NULL )
+    {
+        p_table = malloc( sizeof( *p_table ) + i_size );
+        if( p_table != NULL )
+        {
+            p_table->i_chroma = i_chroma;
+            p_table->i_refs = 0;
+            SetYUV( p_filter, p_table->p_data );
+            p_table->next = p_table_cache;
+            p_table_cache = p_table;
+        }
+    }
+    if( p_table != NULL )
+        p_table->i_refs++;
+    vlc_mutex_unlock( &table_lock );
+
+    return p_table;
+}
+
+static void rgb_table_Release( struct rgb_table *p_table )
+{
+    vlc_mutex_lock( &table_lock );
+    if( --p_table->i_refs == 0 )
+    {
+        for( struct rgb_table **pp = &p_table_cache; ; pp = &(*pp)->next )
+            if( *pp == p_table )
+            {
+                *pp = p_table->next;
+                break;
+            }
+        free( p_table );
+    }
+    vlc_mutex_unlock( &table_lock );
+}
+#endif
+
 /*****************************************************************************
  * Activate: allocate a chroma function
  *****************************************************************************
@@ -206,15 +279,19 @@ static int Activate( filter_t *p_filter )
     }
 
 #ifdef PLUGIN_PLAIN
-    p_sys->p_base = malloc( p_sys->i_bytespp * RGB_TABLE_SIZE );
-    if( p_sys->p_base == NULL )
+    p_sys->p_table = rgb_table_Hold( p_filter, p_sys->i_bytespp );
+    if( p_sys->p_table == NULL )
     {
         free( p_sys->p_offset );
         free( p_sys );
         return -1;
     }
 
-    SetYUV( p_filter );
+    /* The conversion functions each use the alias matching their depth */
+    p_sys->p_base = p_sys->p_table->p_data;
+    p_sys->p_rgb8 = p_sys->p_base;
+    p_sys->p_rgb16 = p_sys->p_base;
+    p_sys->p_rgb32 = p_sys->p_base;
 #endif
 
     return 0;
@@ -230,7 +307,7 @@ static void Deactivate( filter_t *p_filter )
     filter_sys_t *p_sys = p_filter->p_sys;
 
 #ifdef PLUGIN_PLAIN
-    free( p_sys->p_base );
+    rgb_table_Release( p_sys->p_table );
 #endif
     free( p_sys->p_offset );
     free( p_sys->p_buffer );
@@ -239,11 +316,10 @@ static void Deactivate( filter_t *p_filter )
 
 #ifdef PLUGIN_PLAIN
 /*****************************************************************************
- * SetYUV: compute tables and set function pointers
+ * SetYUV: compute the conversion tables for the output pixel format
  *****************************************************************************/
-static void SetYUV( filter_t *p_filter )
+static void SetYUV( filter_t *p_filter, void *p_base )
 {
-    filter_sys_t *p_sys = p_filter->p_sys;
     unsigned i_lrshift, i_lgshift, i_lbshift;
     unsigned i_rrshift = 0;
     unsigned i_rgshift = 0;
@@ -338,7 +414,7 @@ static void SetYUV( filter_t *p_filter )
     }
 
     /*
-     * Set pointers and build YUV tables
+     * Build YUV tables
      */
 
     /* Color: build red, green and blue tables */
@@ -347,75 +423,80 @@ static void SetYUV( filter_t *p_filter )
     case VLC_CODEC_RGB233:
     case VLC_CODEC_RGB332:
     case VLC_CODEC_BGR233:
-        p_sys->p_rgb8 = (uint8_t *)p_sys->p_base;
-        Set8bppPalette( p_filter, p_sys->p_rgb8 );
+        Set8bppPalette( p_filter, (uint8_t *)p_base );
         break;
 
     CASE_PACKED_RGB1615
-        p_sys->p_rgb16 = (uint16_t *)p_sys->p_base;
+    {
+        uint16_t *p_rgb16 = (uint16_t *)p_base;
         for( unsigned i_index = 0; i_index < RED_MARGIN; i_index++ )
         {
-            p_sys->p_rgb16[RED_OFFSET - RED_MARGIN + i_index] = 0;
-            p_sys->p_rgb16[RED_OFFSET + 256 + i_index] =        RGB2PIXEL( 255, 0, 0 );
+            p_rgb16[RED_OFFSET - RED_MARGIN + i_index] = 0;
+            p_rgb16[RED_OFFSET + 256 + i_index] =        RGB2PIXEL( 255, 0, 0 );
         }
         for( unsigned i_index = 0; i_index < GREEN_MARGIN; i_index++ )
         {
-            p_sys->p_rgb16[GREEN_OFFSET - GREEN_MARGIN + i_index] = 0;
-            p_sys->p_rgb16[GREEN_OFFSET + 256 + i_index] =          RGB2PIXEL( 0, 255, 0 );
+            p_rgb16[GREEN_OFFSET - GREEN_MARGIN + i_index] = 0;
+            p_rgb16[GREEN_OFFSET + 256 + i_index] =          RGB2PIXEL( 0, 255, 0 );
         }
         for( unsigned i_index = 0; i_index < BLUE_MARGIN; i_index++ )
         {
-            p_sys->p_rgb16[BLUE_OFFSET - BLUE_MARGIN + i_index] = 0;
-            p_sys->p_rgb16[BLUE_OFFSET + BLUE_MARGIN + i_index] = RGB2PIXEL( 0, 0, 255 );
+            p_rgb16[BLUE_OFFSET - BLUE_MARGIN + i_index] = 0;
+            p_rgb16[BLUE_OFFSET + BLUE_MARGIN + i_index] = RGB2PIXEL( 0, 0, 255 );
         }
         for( unsigned i_index = 0; i_index < 256; i_index++ )
         {
-            p_sys->p_rgb16[RED_OFFSET + i_index] =   RGB2PIXEL( i_index, 0, 0 );
-            p_sys->p_rgb16[GREEN_OFFSET + i_index] = RGB2PIXEL( 0, i_index, 0 );
-            p_sys->p_rgb16[BLUE_OFFSET + i_index] =  RGB2PIXEL( 0, 0, i_index );
+            p_rgb16[RED_OFFSET + i_index] =   RGB2PIXEL( i_index, 0, 0 );
+            p_rgb16[GREEN_OFFSET + i_index] = RGB2PIXEL( 0, i_index, 0 );
+            p_rgb16[BLUE_OFFSET + i_index] =  RGB2PIXEL( 0, 0, i_index );
         }
         break;
+    }
 
     CASE_PACKED_RGBX
     case VLC_CODEC_RGB24:
     case VLC_CODEC_BGR24:
-        p_sys->p_rgb32 = (uint32_t *)p_sys->p_base;
+    {
+        uint32_t *p_rgb32 = (uint32_t *)p_base;
         for( unsigned i_index = 0; i_index < RED_MARGIN; i_index++ )
         {
-            p_sys->p_rgb32[RED_OFFSET - RED_MARGIN + i_index] = 0;
-            p_sys->p_rgb32[RED_OFFSET + 256 + i_index] =        RGB2PIXEL( 255, 0, 0 );
+            p_rgb32[RED_OFFSET - RED_MARGIN + i_index] = 0;
+            p_rgb32[RED_OFFSET + 256 + i_index] =        RGB2PIXEL( 255, 0, 0 );
         }
         for( unsigned i_index = 0; i_index < GREEN_MARGIN; i_index++ )
         {
-            p_sys->p_rgb32[GREEN_OFFSET - GREEN_MARGIN + i_index] = 0;
-            p_sys->p_rgb32[GREEN_OFFSET + 256 + i_index] =          RGB2PIXEL( 0, 255, 0 );
+            p_rgb32[GREEN_OFFSET - GREEN_MARGIN + i_index] = 0;
+            p_rgb32[GREEN_OFFSET + 256 + i_index] =          RGB2PIXEL( 0, 255, 0 );
         }
         for( unsigned i_index = 0; i_index < BLUE_MARGIN; i_index++ )
         {
-            p_sys->p_rgb32[BLUE_OFFSET - BLUE_MARGIN + i_index] = 0;
-            p_sys->p_rgb32[BLUE_OFFSET + BLUE_MARGIN + i_index] = RGB2PIXEL( 0, 0, 255 );
+            p_rgb32[BLUE_OFFSET - BLUE_MARGIN + i_index] = 0;
+            p_rgb32[BLUE_OFFSET + BLUE_MARGIN + i_index] = RGB2PIXEL( 0, 0, 255 );
         }
         for( unsigned i_index = 0; i_index < 256; i_index++ )
         {
-            p_sys->p_rgb32[RED_OFFSET + i_index] =   RGB2PIXEL( i_index, 0, 0 );
-            p_sys->p_rgb32[GREEN_OFFSET + i_index] = RGB2PIXEL( 0, i_index, 0 );
-            p_sys->p_rgb32[BLUE_OFFSET + i_index] =  RGB2PIXEL( 0, 0, i_index );
+            p_rgb32[RED_OFFSET + i_index] =   RGB2PIXEL( i_index, 0, 0 );
+            p_rgb32[GREEN_OFFSET + i_index] = RGB2PIXEL( 0, i_index, 0 );
+            p_rgb32[BLUE_OFFSET + i_index] =  RGB2PIXEL( 0, 0, i_index );
         }
         break;
     }
+    }
 }
 
 static void Set8bppPalette( filter_t *p_filter, uint8_t *p_rgb8 )
 {
     #define CLIP( x ) ( ((x < 0) ? 0 : (x > 255) ? 255 : x) << 8 )
-    filter_sys_t *p_sys = p_filter->p_sys;
 
     int y,u,v;
     int r,g,b;
     int i = 0, j = 0;
-    uint16_t *p_cmap_r = p_sys->p_rgb_r;
-    uint16_t *p_cmap_g = p_sys->p_rgb_g;
-    uint16_t *p_cmap_b = p_sys->p_rgb_b;
+    /* To get the RGB value for palette entry i, use (p_cmap_r[i],
+     * p_cmap_g[i], p_cmap_b[i]), 16 bits per component. Only kept around
+     * while building the table: nothing consumes the palette anymore. */
+    uint16_t p_cmap_r[CMAP_RGB2_SIZE];
+    uint16_t p_cmap_g[CMAP_RGB2_SIZE];
+    uint16_t p_cmap_b[CMAP_RGB2_SIZE];
 
     unsigned char p_lookup[PALETTE_TABLE_SIZE];
 
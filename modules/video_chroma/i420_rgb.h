@@ -28,6 +28,8 @@
 /** Number of entries in RGB palette/colormap */
 #define CMAP_RGB2_SIZE 256
 
+struct rgb_table;
+
 /**
  * filter_sys_t: chroma method descriptor
 
@@ -42,19 +44,13 @@ typedef struct
     int *p_offset;
 
 #ifdef PLUGIN_PLAIN
-    /**< Pre-calculated conversion tables */
+    /**< Pre-calculated conversion tables, shared between instances through
+       a process-wide cache keyed by the output pixel format */
+    struct rgb_table *p_table;         /**< cache entry owning the tables */
     void *p_base;                      /**< base for all conversion tables */
     uint8_t   *p_rgb8;                 /**< RGB 8 bits table */
     uint16_t  *p_rgb16;                /**< RGB 16 bits table */
     uint32_t  *p_rgb32;                /**< RGB 32 bits table */
-
-    /**< To get RGB value for palette entry i, use (p_rgb_r[i], p_rgb_g[i],
-       p_rgb_b[i]). Note these are 16 bits per pixel. For 8bpp entries,
-       shift right 8 bits.
-    */
-    uint16_t  p_rgb_r[CMAP_RGB2_SIZE];  /**< Red values of palette */
-    uint16_t  p_rgb_g[CMAP_RGB2_SIZE];  /**< Green values of palette */
-    uint16_t  p_rgb_b[CMAP_RGB2_SIZE];  /**< Blue values of palette */
 #endif
 } filter_sys_t;
 
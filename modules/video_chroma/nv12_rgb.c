@@ -0,0 +1,336 @@
+/*****************************************************************************
+ * nv12_rgb.c : semiplanar NV12/P010 to RGB conversion module
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Preamble
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_plugin.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include <vlc_cpu.h>
+
+#ifdef PLUGIN_SSE2
+# include <emmintrin.h>
+# define vlc_CPU_capable() vlc_CPU_SSE2()
+#else
+# define vlc_CPU_capable() (true)
+#endif
+
+/* Limited-range YCbCr to full-range RGB, 8.8 fixed point:
+ *   R = (298 (Y - 16) + rv (V - 128) + 128) >> 8
+ * and likewise for G/B, with 10-bit sources using the same coefficients,
+ * four times larger offsets and a 10-bit shift. */
+struct yuv_coeffs
+{
+    int16_t rv;
+    int16_t gu, gv;
+    int16_t bu;
+};
+
+static const struct yuv_coeffs bt601 = { 409, -100, -208, 516 };
+static const struct yuv_coeffs bt709 = { 459,  -55, -136, 541 };
+
+typedef struct
+{
+    struct yuv_coeffs coeffs;
+    /* Offsets of the R and B bytes within an output pixel; G is always at
+     * 1 and alpha at 3. Distinguishes RGBA from BGRA. */
+    int r_off, b_off;
+} filter_sys_t;
+
+static const struct yuv_coeffs *PickCoeffs( const video_format_t *fmt )
+{
+    switch( fmt->space )
+    {
+        case COLOR_SPACE_BT709:
+            return &bt709;
+        case COLOR_SPACE_BT601:
+            return &bt601;
+        default:
+            /* SD defaults to 601, HD to 709 */
+            return fmt->i_visible_height > 576 ? &bt709 : &bt601;
+    }
+}
+
+static inline uint8_t clamp8( int v )
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+static void NV12_RGB_C( filter_t *p_filter, picture_t *p_src,
+                        picture_t *p_dst )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    const struct yuv_coeffs *c = &p_sys->coeffs;
+    const int r_off = p_sys->r_off, b_off = p_sys->b_off;
+    const unsigned width = p_src->format.i_x_offset
+                         + p_src->format.i_visible_width;
+    const unsigned height = p_src->format.i_y_offset
+                          + p_src->format.i_visible_height;
+
+    for( unsigned y = 0; y < height; y++ )
+    {
+        const uint8_t *py = &p_src->p[0].p_pixels[y * p_src->p[0].i_pitch];
+        const uint8_t *puv =
+            &p_src->p[1].p_pixels[(y / 2) * p_src->p[1].i_pitch];
+        uint8_t *out = &p_dst->p->p_pixels[y * p_dst->p->i_pitch];
+
+        for( unsigned x = 0; x < width; x++ )
+        {
+            int cy = 298 * (py[x] - 16) + 128;
+            int cu = puv[(x & ~1u)] - 128;
+            int cv = puv[(x & ~1u) + 1] - 128;
+
+            out[4 * x + r_off] = clamp8( (cy + c->rv * cv) >> 8 );
+            out[4 * x + 1]     = clamp8( (cy + c->gu * cu + c->gv * cv) >> 8 );
+            out[4 * x + b_off] = clamp8( (cy + c->bu * cu) >> 8 );
+            out[4 * x + 3]     = 0xff;
+        }
+    }
+}
+
+static void P010_RGB_C( filter_t *p_filter, picture_t *p_src,
+                        picture_t *p_dst )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    const struct yuv_coeffs *c = &p_sys->coeffs;
+    const int r_off = p_sys->r_off, b_off = p_sys->b_off;
+    const unsigned width = p_src->format.i_x_offset
+                         + p_src->format.i_visible_width;
+    const unsigned height = p_src->format.i_y_offset
+                          + p_src->format.i_visible_height;
+
+    for( unsigned y = 0; y < height; y++ )
+    {
+        const uint16_t *py = (const uint16_t *)
+            &p_src->p[0].p_pixels[y * p_src->p[0].i_pitch];
+        const uint16_t *puv = (const uint16_t *)
+            &p_src->p[1].p_pixels[(y / 2) * p_src->p[1].i_pitch];
+        uint8_t *out = &p_dst->p->p_pixels[y * p_dst->p->i_pitch];
+
+        for( unsigned x = 0; x < width; x++ )
+        {
+            /* P010 stores 10 significant bits in the top of each word */
+            int cy = 298 * ((py[x] >> 6) - 64) + 512;
+            int cu = (puv[(x & ~1u)] >> 6) - 512;
+            int cv = (puv[(x & ~1u) + 1] >> 6) - 512;
+
+            out[4 * x + r_off] = clamp8( (cy + c->rv * cv) >> 10 );
+            out[4 * x + 1]     = clamp8( (cy + c->gu * cu + c->gv * cv) >> 10 );
+            out[4 * x + b_off] = clamp8( (cy + c->bu * cu) >> 10 );
+            out[4 * x + 3]     = 0xff;
+        }
+    }
+}
+
+#ifdef PLUGIN_SSE2
+/* 16-bit multiply saturating to int16 instead of wrapping, for products
+ * that can exceed 15 bits (luma and the blue chroma coefficient). */
+static inline __m128i mul_sat_epi16( __m128i a, __m128i b )
+{
+    __m128i lo = _mm_mullo_epi16( a, b );
+    __m128i hi = _mm_mulhi_epi16( a, b );
+    return _mm_packs_epi32( _mm_unpacklo_epi16( lo, hi ),
+                            _mm_unpackhi_epi16( lo, hi ) );
+}
+
+/* Converts 8 pixels per iteration: the luma is expanded to 16 bits, the
+ * interleaved chroma pair is split and duplicated horizontally, and the
+ * matrix is applied on 16-bit lanes before packing back to bytes. */
+static void NV12_RGB_SSE2( filter_t *p_filter, picture_t *p_src,
+                           picture_t *p_dst )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    const struct yuv_coeffs *c = &p_sys->coeffs;
+    const bool swap_rb = p_sys->r_off != 0;
+    const unsigned width = p_src->format.i_x_offset
+                         + p_src->format.i_visible_width;
+    const unsigned height = p_src->format.i_y_offset
+                          + p_src->format.i_visible_height;
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c16 = _mm_set1_epi16( 16 );
+    const __m128i c128 = _mm_set1_epi16( 128 );
+    const __m128i cy_mul = _mm_set1_epi16( 149 ); /* 298 / 2 */
+    const __m128i rv = _mm_set1_epi16( c->rv / 2 );
+    const __m128i gu = _mm_set1_epi16( c->gu / 2 );
+    const __m128i gv = _mm_set1_epi16( c->gv / 2 );
+    const __m128i bu = _mm_set1_epi16( c->bu / 2 );
+    const __m128i alpha = _mm_set1_epi8( (char)0xff );
+
+    for( unsigned y = 0; y < height; y++ )
+    {
+        const uint8_t *py = &p_src->p[0].p_pixels[y * p_src->p[0].i_pitch];
+        const uint8_t *puv =
+            &p_src->p[1].p_pixels[(y / 2) * p_src->p[1].i_pitch];
+        uint8_t *out = &p_dst->p->p_pixels[y * p_dst->p->i_pitch];
+        unsigned x = 0;
+
+        for( ; x + 8 <= width; x += 8 )
+        {
+            __m128i luma =
+                _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i *)&py[x] ),
+                                   zero );
+            __m128i uv =
+                _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i *)&puv[x] ),
+                                   zero );
+            /* even 16-bit lanes: U, odd lanes: V; duplicate each per pair */
+            __m128i u = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16( uv, _MM_SHUFFLE( 2, 2, 0, 0 ) ),
+                _MM_SHUFFLE( 2, 2, 0, 0 ) );
+            __m128i v = _mm_shufflehi_epi16(
+                _mm_shufflelo_epi16( uv, _MM_SHUFFLE( 3, 3, 1, 1 ) ),
+                _MM_SHUFFLE( 3, 3, 1, 1 ) );
+
+            /* 7-bit scale. (Y - 16) * 149 reaches 35611 for super-white
+             * luma and bu/2 * (U - 128) reaches 34560 for extreme chroma,
+             * so those two products are computed with saturation; the
+             * remaining products fit in int16 for any 8-bit input. The
+             * sums saturate too, so the final shift and unsigned pack
+             * clamp instead of wrapping. */
+            __m128i cy = mul_sat_epi16( _mm_sub_epi16( luma, c16 ), cy_mul );
+            u = _mm_sub_epi16( u, c128 );
+            v = _mm_sub_epi16( v, c128 );
+
+            __m128i r = _mm_srai_epi16(
+                _mm_adds_epi16( cy, _mm_mullo_epi16( v, rv ) ), 7 );
+            __m128i g = _mm_srai_epi16(
+                _mm_adds_epi16( cy, _mm_adds_epi16( _mm_mullo_epi16( u, gu ),
+                                                    _mm_mullo_epi16( v, gv ) ) ),
+                7 );
+            __m128i b = _mm_srai_epi16(
+                _mm_adds_epi16( cy, mul_sat_epi16( u, bu ) ), 7 );
+
+            if( swap_rb )
+            {
+                __m128i tmp = r;
+                r = b;
+                b = tmp;
+            }
+
+            __m128i rb = _mm_packus_epi16( r, b ); /* R0..R7 B0..B7 */
+            __m128i ga = _mm_packus_epi16( g, g );
+            __m128i rg = _mm_unpacklo_epi8( rb, ga );
+            __m128i ba = _mm_unpacklo_epi8( _mm_unpackhi_epi64( rb, rb ),
+                                            alpha );
+            _mm_storeu_si128( (__m128i *)&out[4 * x],
+                              _mm_unpacklo_epi16( rg, ba ) );
+            _mm_storeu_si128( (__m128i *)&out[4 * x + 16],
+                              _mm_unpackhi_epi16( rg, ba ) );
+        }
+
+        for( ; x < width; x++ )
+        {
+            int cy = 298 * (py[x] - 16) + 128;
+            int cu = puv[(x & ~1u)] - 128;
+            int cv = puv[(x & ~1u) + 1] - 128;
+
+            out[4 * x + p_sys->r_off] = clamp8( (cy + c->rv * cv) >> 8 );
+            out[4 * x + 1] = clamp8( (cy + c->gu * cu + c->gv * cv) >> 8 );
+            out[4 * x + p_sys->b_off] = clamp8( (cy + c->bu * cu) >> 8 );
+            out[4 * x + 3] = 0xff;
+        }
+    }
+}
+
+VIDEO_FILTER_WRAPPER( NV12_RGB_SSE2 )
+#else
+VIDEO_FILTER_WRAPPER( NV12_RGB_C )
+#endif
+VIDEO_FILTER_WRAPPER( P010_RGB_C )
+
+/*****************************************************************************
+ * Create: allocate a chroma function
+ *****************************************************************************/
+static int Create( filter_t *p_filter )
+{
+    if( !vlc_CPU_capable() )
+        return VLC_EGENERIC;
+
+    if( p_filter->fmt_in.video.i_width  & 1
+     || p_filter->fmt_in.video.i_height & 1 )
+        return VLC_EGENERIC;
+
+    /* resizing not supported */
+    if( p_filter->fmt_in.video.i_x_offset + p_filter->fmt_in.video.i_visible_width !=
+            p_filter->fmt_out.video.i_x_offset + p_filter->fmt_out.video.i_visible_width
+       || p_filter->fmt_in.video.i_y_offset + p_filter->fmt_in.video.i_visible_height !=
+            p_filter->fmt_out.video.i_y_offset + p_filter->fmt_out.video.i_visible_height
+       || p_filter->fmt_in.video.orientation != p_filter->fmt_out.video.orientation )
+        return VLC_EGENERIC;
+
+    filter_sys_t *p_sys = vlc_obj_malloc( VLC_OBJECT( p_filter ),
+                                          sizeof(*p_sys) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+    switch( p_filter->fmt_out.video.i_chroma )
+    {
+        case VLC_CODEC_RGBA:
+            p_sys->r_off = 0;
+            p_sys->b_off = 2;
+            break;
+        case VLC_CODEC_BGRA:
+            p_sys->r_off = 2;
+            p_sys->b_off = 0;
+            break;
+        default:
+            return VLC_EGENERIC;
+    }
+
+    switch( p_filter->fmt_in.video.i_chroma )
+    {
+        case VLC_CODEC_NV12:
+#ifdef PLUGIN_SSE2
+            p_filter->ops = &NV12_RGB_SSE2_ops;
+#else
+            p_filter->ops = &NV12_RGB_C_ops;
+#endif
+            break;
+        case VLC_CODEC_P010:
+            p_filter->ops = &P010_RGB_C_ops;
+            break;
+        default:
+            return VLC_EGENERIC;
+    }
+
+    p_sys->coeffs = *PickCoeffs( &p_filter->fmt_in.video );
+    p_filter->p_sys = p_sys;
+    return VLC_SUCCESS;
+}
+
+/*****************************************************************************
+ * Module descriptor
+ *****************************************************************************/
+vlc_module_begin ()
+#ifdef PLUGIN_SSE2
+    set_description( N_("SSE2 NV12,P010 to RGBA,BGRA conversions") )
+    set_callback_video_converter( Create, 120 )
+#else
+    set_description( N_("NV12,P010 to RGBA,BGRA conversions") )
+    set_callback_video_converter( Create, 80 )
+#endif
+vlc_module_end ()
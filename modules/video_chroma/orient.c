@@ -69,11 +69,19 @@ static void transpose_##bits(void *restrict dst, ptrdiff_t dst_stride, \
     dst_stride /= bits / 8; \
     src_stride /= bits / 8; \
 \
-    for (int y = 0; y < src_height; y++) { \
-        for (int x = 0; x < src_width; x++) \
-            dst_pixels[x * dst_stride] = src_pixels[x]; \
-        src_pixels += src_stride; \
-        dst_pixels++; \
+    /* Work on square tiles so the destination lines touched by a tile \
+     * stay in cache while the tile is transposed. */ \
+    for (int by = 0; by < src_height; by += 32) { \
+        int ey = __MIN(by + 32, src_height); \
+        for (int bx = 0; bx < src_width; bx += 32) { \
+            int ex = __MIN(bx + 32, src_width); \
+            for (int y = by; y < ey; y++) { \
+                const uint##bits##_t *restrict row = src_pixels \
+                                                   + y * src_stride; \
+                for (int x = bx; x < ex; x++) \
+                    dst_pixels[x * dst_stride + y] = row[x]; \
+            } \
+        } \
     } \
 }
 
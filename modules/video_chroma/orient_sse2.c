@@ -0,0 +1,164 @@
+/*****************************************************************************
+ * orient_sse2.c: SSE2 image reorientation kernels
+ *****************************************************************************
+ * Copyright (C) 2025 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <emmintrin.h>
+
+#include <vlc_common.h>
+#include <vlc_cpu.h>
+#include <vlc_plugin.h>
+#include "orient.h"
+
+/*
+ * Transposition is performed on register-sized tiles: each tile is loaded
+ * with one (unaligned) row load per register, rotated in-register through
+ * log2(n) rounds of interleaving, and stored with one row store per
+ * register, so both source and destination are accessed along whole cache
+ * lines instead of one element per line.
+ *
+ * Each interleave round leaves the transposed rows in bit-reversed
+ * register order; the store order below undoes that permutation.
+ */
+
+static void Transpose16x16_8(uint8_t *restrict dst, ptrdiff_t dst_stride,
+                             const uint8_t *restrict src, ptrdiff_t src_stride)
+{
+    static const unsigned char order[16] = {
+        0, 8, 4, 12, 2, 10, 6, 14, 1, 9, 5, 13, 3, 11, 7, 15
+    };
+    __m128i r[16], t[16];
+
+    for (int i = 0; i < 16; i++)
+        r[i] = _mm_loadu_si128((const __m128i *)(src + i * src_stride));
+
+    for (int i = 0; i < 8; i++) {
+        t[i]     = _mm_unpacklo_epi8(r[2 * i], r[2 * i + 1]);
+        t[i + 8] = _mm_unpackhi_epi8(r[2 * i], r[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; i++) {
+        r[i]     = _mm_unpacklo_epi16(t[2 * i], t[2 * i + 1]);
+        r[i + 8] = _mm_unpackhi_epi16(t[2 * i], t[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; i++) {
+        t[i]     = _mm_unpacklo_epi32(r[2 * i], r[2 * i + 1]);
+        t[i + 8] = _mm_unpackhi_epi32(r[2 * i], r[2 * i + 1]);
+    }
+    for (int i = 0; i < 8; i++) {
+        r[i]     = _mm_unpacklo_epi64(t[2 * i], t[2 * i + 1]);
+        r[i + 8] = _mm_unpackhi_epi64(t[2 * i], t[2 * i + 1]);
+    }
+
+    for (int i = 0; i < 16; i++)
+        _mm_storeu_si128((__m128i *)(dst + i * dst_stride), r[order[i]]);
+}
+
+static void Transpose8x8_16(uint8_t *restrict dst, ptrdiff_t dst_stride,
+                            const uint8_t *restrict src, ptrdiff_t src_stride)
+{
+    static const unsigned char order[8] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+    __m128i r[8], t[8];
+
+    for (int i = 0; i < 8; i++)
+        r[i] = _mm_loadu_si128((const __m128i *)(src + i * src_stride));
+
+    for (int i = 0; i < 4; i++) {
+        t[i]     = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);
+        t[i + 4] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        r[i]     = _mm_unpacklo_epi32(t[2 * i], t[2 * i + 1]);
+        r[i + 4] = _mm_unpackhi_epi32(t[2 * i], t[2 * i + 1]);
+    }
+    for (int i = 0; i < 4; i++) {
+        t[i]     = _mm_unpacklo_epi64(r[2 * i], r[2 * i + 1]);
+        t[i + 4] = _mm_unpackhi_epi64(r[2 * i], r[2 * i + 1]);
+    }
+
+    for (int i = 0; i < 8; i++)
+        _mm_storeu_si128((__m128i *)(dst + i * dst_stride), t[order[i]]);
+}
+
+static void transpose_8_sse2(void *restrict dst, ptrdiff_t dst_stride,
+                             const void *restrict src, ptrdiff_t src_stride,
+                             int src_width, int src_height)
+{
+    const uint8_t *restrict src_pixels = src;
+    uint8_t *restrict dst_pixels = dst;
+    int x, y;
+
+    for (y = 0; y + 16 <= src_height; y += 16) {
+        for (x = 0; x + 16 <= src_width; x += 16)
+            Transpose16x16_8(dst_pixels + x * dst_stride + y, dst_stride,
+                             src_pixels + y * src_stride + x, src_stride);
+
+        for (; x < src_width; x++) /* right edge of the tile row */
+            for (int i = 0; i < 16; i++)
+                dst_pixels[x * dst_stride + y + i] =
+                    src_pixels[(y + i) * src_stride + x];
+    }
+
+    for (; y < src_height; y++) /* bottom rows */
+        for (x = 0; x < src_width; x++)
+            dst_pixels[x * dst_stride + y] = src_pixels[y * src_stride + x];
+}
+
+static void transpose_16_sse2(void *restrict dst, ptrdiff_t dst_stride,
+                              const void *restrict src, ptrdiff_t src_stride,
+                              int src_width, int src_height)
+{
+    const uint8_t *restrict src_pixels = src;
+    uint8_t *restrict dst_pixels = dst;
+    int x, y;
+
+    for (y = 0; y + 8 <= src_height; y += 8) {
+        for (x = 0; x + 8 <= src_width; x += 8)
+            Transpose8x8_16(dst_pixels + x * dst_stride + 2 * y, dst_stride,
+                            src_pixels + y * src_stride + 2 * x, src_stride);
+
+        for (; x < src_width; x++) /* right edge of the tile row */
+            for (int i = 0; i < 8; i++)
+                memcpy(dst_pixels + x * dst_stride + 2 * (y + i),
+                       src_pixels + (y + i) * src_stride + 2 * x, 2);
+    }
+
+    for (; y < src_height; y++) /* bottom rows */
+        for (x = 0; x < src_width; x++)
+            memcpy(dst_pixels + x * dst_stride + 2 * y,
+                   src_pixels + y * src_stride + 2 * x, 2);
+}
+
+static void Probe(void *data)
+{
+    if (vlc_CPU_SSE2()) {
+        struct plane_transforms *const transforms = data;
+
+        transforms->transpose[0] = transpose_8_sse2;
+        transforms->transpose[1] = transpose_16_sse2;
+    }
+}
+
+vlc_module_begin()
+    set_subcategory(SUBCAT_VIDEO_VFILTER)
+    set_description("SSE2 optimisation for video transform")
+    set_cpu_funcs("video transform", Probe, 10)
+vlc_module_end()
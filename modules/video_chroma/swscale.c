@@ -38,6 +38,13 @@
 #include <libswscale/swscale.h>
 #include <libswscale/version.h>
 
+/* libswscale can thread the scaling itself over horizontal slices
+ * since FFmpeg 5.0 */
+#if LIBSWSCALE_VERSION_INT >= AV_VERSION_INT(6, 1, 100)
+# define SWSCALE_HAS_THREADS
+# include <libavutil/opt.h>
+#endif
+
 #ifdef __APPLE__
 # include <TargetConditionals.h>
 #endif
@@ -53,6 +60,10 @@ static void CloseScaler( filter_t * );
 #define SCALEMODE_TEXT N_("Scaling mode")
 #define SCALEMODE_LONGTEXT NULL
 
+#define THREADS_TEXT N_("Scaling threads")
+#define THREADS_LONGTEXT N_("Number of threads used for scaling and chroma " \
+    "conversion, when supported by libswscale (0 for automatic selection).")
+
 static const int pi_mode_values[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
 static const char *const ppsz_mode_descriptions[] =
 { N_("Fast bilinear"), N_("Bilinear"), N_("Bicubic (good quality)"),
@@ -67,6 +78,8 @@ vlc_module_begin ()
     set_callback_video_converter( OpenScaler, 150 )
     add_integer( "swscale-mode", 2, SCALEMODE_TEXT, SCALEMODE_LONGTEXT )
         change_integer_list( pi_mode_values, ppsz_mode_descriptions )
+    add_integer_with_range( "swscale-threads", 0, 0, 64,
+                            THREADS_TEXT, THREADS_LONGTEXT )
 vlc_module_end ()
 
 /* Version checking */
@@ -81,6 +94,7 @@ typedef struct
 {
     SwsFilter *p_filter;
     int i_sws_flags;
+    int i_threads;
 
     video_format_t fmt_in;
     video_format_t fmt_out;
@@ -222,6 +236,11 @@ static int OpenScaler( filter_t *p_filter )
     default: p_sys->i_sws_flags = SWS_BICUBIC; i_sws_mode = 2; break;
     }
 
+    p_sys->i_threads = var_CreateGetInteger( p_filter, "swscale-threads" );
+    if( p_sys->i_threads == 0 )
+        /* The speed-up flattens quickly, keep some cores for the decoder */
+        p_sys->i_threads = __MIN( vlc_GetCPUCount(), 8 );
+
     /* Misc init */
     memset( &p_sys->fmt_in,  0, sizeof(p_sys->fmt_in) );
     memset( &p_sys->fmt_out, 0, sizeof(p_sys->fmt_out) );
@@ -366,6 +385,45 @@ static int GetParameters( ScalerConfiguration *p_cfg,
     return VLC_SUCCESS;
 }
 
+static struct SwsContext *GetSwsContext( filter_sys_t *p_sys,
+                                         int i_srcw, int i_srch, int i_srcfmt,
+                                         int i_dstw, int i_dsth, int i_dstfmt,
+                                         int i_flags )
+{
+#ifdef SWSCALE_HAS_THREADS
+    if( p_sys->i_threads > 1 )
+    {
+        /* sws_getContext() cannot configure threading: set up the context
+         * through the AVOption interface instead. libswscale then scales
+         * over horizontal slices with its own worker pool, taking care of
+         * the filter taps crossing slice boundaries. */
+        struct SwsContext *ctx = sws_alloc_context();
+        if( ctx != NULL )
+        {
+            av_opt_set_int( ctx, "srcw", i_srcw, 0 );
+            av_opt_set_int( ctx, "srch", i_srch, 0 );
+            av_opt_set_int( ctx, "src_format", i_srcfmt, 0 );
+            av_opt_set_int( ctx, "dstw", i_dstw, 0 );
+            av_opt_set_int( ctx, "dsth", i_dsth, 0 );
+            av_opt_set_int( ctx, "dst_format", i_dstfmt, 0 );
+            av_opt_set_int( ctx, "sws_flags", i_flags, 0 );
+            av_opt_set_int( ctx, "threads", p_sys->i_threads, 0 );
+            if( sws_init_context( ctx, p_sys->p_filter, NULL ) < 0 )
+            {
+                sws_freeContext( ctx );
+                ctx = NULL;
+            }
+        }
+        if( ctx != NULL )
+            return ctx;
+        /* Fall back to the single-threaded path */
+    }
+#endif
+    return sws_getContext( i_srcw, i_srch, i_srcfmt,
+                           i_dstw, i_dsth, i_dstfmt,
+                           i_flags, p_sys->p_filter, NULL, 0 );
+}
+
 static int Init( filter_t *p_filter )
 {
     filter_sys_t *p_sys = p_filter->p_sys;
@@ -423,10 +481,10 @@ static int Init( filter_t *p_filter )
         const int i_fmto = n == 0 ? cfg.i_fmto : AV_PIX_FMT_GRAY8;
         struct SwsContext *ctx;
 
-        ctx = sws_getContext( i_fmti_visible_width, p_fmti->i_visible_height, i_fmti,
-                              i_fmto_visible_width, p_fmto->i_visible_height, i_fmto,
-                              cfg.i_sws_flags,
-                              p_sys->p_filter, NULL, 0 );
+        ctx = GetSwsContext( p_sys,
+                             i_fmti_visible_width, p_fmti->i_visible_height, i_fmti,
+                             i_fmto_visible_width, p_fmto->i_visible_height, i_fmto,
+                             cfg.i_sws_flags );
         if( n == 0 )
             p_sys->ctx = ctx;
         else
@@ -105,9 +105,9 @@ typedef struct
     _Atomic float f_saturation;
     _Atomic float f_gamma;
     int (*pf_process_sat_hue)( picture_t *, picture_t *, int, int, int,
-                               int, int );
+                               int64_t, int64_t );
     int (*pf_process_sat_hue_clip)( picture_t *, picture_t *, int, int,
-                                    int, int, int );
+                                    int, int64_t, int64_t );
 } filter_sys_t;
 
 static int FloatCallback( vlc_object_t *obj, char const *varname,
@@ -158,7 +158,8 @@ static int Create( filter_t *p_filter )
 
         CASE_PLANAR_YUV10
         CASE_PLANAR_YUV9
-            /* Planar YUV 9-bit or 10-bit */
+        CASE_PLANAR_YUV12
+            /* Planar YUV 9-bit, 10-bit or 12-bit */
             p_filter->ops = &FilterPlanar_ops;
             p_sys->pf_process_sat_hue_clip = planar_sat_hue_clip_C_16;
             p_sys->pf_process_sat_hue = planar_sat_hue_C_16;
@@ -223,9 +224,9 @@ static void Destroy( filter_t *p_filter )
  *****************************************************************************/
 static void FilterPlanar( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
 {
-    /* The full range will only be used for 10-bit */
-    int pi_luma[1024];
-    int pi_gamma[1024];
+    /* The full range will only be used for 12-bit */
+    int pi_luma[4096];
+    int pi_gamma[4096];
 
     filter_sys_t *p_sys = p_filter->p_sys;
 
@@ -241,6 +242,10 @@ static void FilterPlanar( filter_t *p_filter, picture_t *p_pic, picture_t *p_out
             b_16bit = true;
             f_range = 512.f;
             break;
+        CASE_PLANAR_YUV12
+            b_16bit = true;
+            f_range = 4096.f;
+            break;
         default:
             b_16bit = false;
             f_range = 256.f;
@@ -358,9 +363,9 @@ static void FilterPlanar( filter_t *p_filter, picture_t *p_pic, picture_t *p_out
     int i_sin = sinf(f_hue) * f_max;
     int i_cos = cosf(f_hue) * f_max;
 
-    /* pow(2, (bpp * 2) - 1) */
-    int i_x = ( cosf(f_hue) + sinf(f_hue) ) * f_range * i_mid;
-    int i_y = ( cosf(f_hue) - sinf(f_hue) ) * f_range * i_mid;
+    /* pow(2, (bpp * 2) - 1), which exceeds 32 bits for 12-bit */
+    int64_t i_x = ( cosf(f_hue) + sinf(f_hue) ) * f_range * i_mid;
+    int64_t i_y = ( cosf(f_hue) - sinf(f_hue) ) * f_range * i_mid;
 
     if ( i_sat > i_range )
     {
@@ -396,7 +401,8 @@ static picture_t *FilterPacked( filter_t *p_filter, picture_t *p_pic )
     double  f_hue;
     double  f_gamma;
     int32_t i_cont, i_lum;
-    int i_sat, i_sin, i_cos, i_x, i_y;
+    int i_sat, i_sin, i_cos;
+    int64_t i_x, i_y;
 
     filter_sys_t *p_sys = p_filter->p_sys;
 
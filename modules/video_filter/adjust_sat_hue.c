@@ -75,7 +75,7 @@
  *****************************************************************************/
 
 int planar_sat_hue_clip_C( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
-                         int i_sat, int i_x, int i_y )
+                         int i_sat, int64_t i_x, int64_t i_y )
 {
     uint8_t *p_in, *p_in_v, *p_in_end, *p_line_end;
     uint8_t *p_out, *p_out_v;
@@ -121,7 +121,7 @@ int planar_sat_hue_clip_C( picture_t * p_pic, picture_t * p_outpic, int i_sin, i
 }
 
 int planar_sat_hue_C( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
-                         int i_sat, int i_x, int i_y )
+                         int i_sat, int64_t i_x, int64_t i_y )
 {
     uint8_t *p_in, *p_in_v, *p_in_end, *p_line_end;
     uint8_t *p_out, *p_out_v;
@@ -166,25 +166,18 @@ int planar_sat_hue_C( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_
     return VLC_SUCCESS;
 }
 
-int planar_sat_hue_clip_C_16( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
-                         int i_sat, int i_x, int i_y )
+/* 16-bit worker: i_bpp and b_clip must be compile-time constants so the
+ * shifts, midpoints and clip bounds fold per specialization, keeping the
+ * inner loop free of per-pixel branching and open to auto-vectorization.
+ * The dispatchers below instantiate it once per supported bit depth. */
+static inline void planar_sat_hue_16( picture_t * p_pic, picture_t * p_outpic,
+                                      int i_sin, int i_cos, int i_sat,
+                                      int64_t i_x, int64_t i_y,
+                                      const int i_bpp, const bool b_clip )
 {
     uint16_t *p_in, *p_in_v, *p_in_end, *p_line_end;
     uint16_t *p_out, *p_out_v;
 
-    int i_bpp;
-    switch( p_pic->format.i_chroma )
-    {
-        CASE_PLANAR_YUV10
-            i_bpp = 10;
-            break;
-        CASE_PLANAR_YUV9
-            i_bpp = 9;
-            break;
-        default:
-            vlc_assert_unreachable();
-    }
-
     p_in = (uint16_t *) p_pic->p[U_PLANE].p_pixels;
     p_in_v = (uint16_t *) p_pic->p[V_PLANE].p_pixels;
     p_in_end = p_in + p_pic->p[U_PLANE].i_visible_lines
@@ -202,14 +195,28 @@ int planar_sat_hue_clip_C_16( picture_t * p_pic, picture_t * p_outpic, int i_sin
         for( ; p_in < p_line_end ; )
         {
             /* Do 8 pixels at a time */
-            ADJUST_8_TIMES( PLANAR_WRITE_UV_CLIP( i_bpp ) );
+            if( b_clip )
+            {
+                ADJUST_8_TIMES( PLANAR_WRITE_UV_CLIP( i_bpp ) );
+            }
+            else
+            {
+                ADJUST_8_TIMES( PLANAR_WRITE_UV( i_bpp ) );
+            }
         }
 
         p_line_end += 8;
 
         for( ; p_in < p_line_end ; )
         {
-            PLANAR_WRITE_UV_CLIP( i_bpp );
+            if( b_clip )
+            {
+                PLANAR_WRITE_UV_CLIP( i_bpp );
+            }
+            else
+            {
+                PLANAR_WRITE_UV( i_bpp );
+            }
         }
 
         p_in += (p_pic->p[U_PLANE].i_pitch >> 1)
@@ -221,71 +228,58 @@ int planar_sat_hue_clip_C_16( picture_t * p_pic, picture_t * p_outpic, int i_sin
         p_out_v += (p_outpic->p[V_PLANE].i_pitch >> 1)
                     - (p_outpic->p[V_PLANE].i_visible_pitch >> 1);
     }
-
-    return VLC_SUCCESS;
 }
 
-int planar_sat_hue_C_16( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
-                            int i_sat, int i_x, int i_y )
+int planar_sat_hue_clip_C_16( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
+                         int i_sat, int64_t i_x, int64_t i_y )
 {
-    uint16_t *p_in, *p_in_v, *p_in_end, *p_line_end;
-    uint16_t *p_out, *p_out_v;
-
-    int i_bpp;
     switch( p_pic->format.i_chroma )
     {
         CASE_PLANAR_YUV10
-            i_bpp = 10;
+            planar_sat_hue_16( p_pic, p_outpic, i_sin, i_cos, i_sat, i_x, i_y,
+                               10, true );
             break;
         CASE_PLANAR_YUV9
-            i_bpp = 9;
+            planar_sat_hue_16( p_pic, p_outpic, i_sin, i_cos, i_sat, i_x, i_y,
+                               9, true );
+            break;
+        CASE_PLANAR_YUV12
+            planar_sat_hue_16( p_pic, p_outpic, i_sin, i_cos, i_sat, i_x, i_y,
+                               12, true );
             break;
         default:
             vlc_assert_unreachable();
     }
 
-    p_in = (uint16_t *) p_pic->p[U_PLANE].p_pixels;
-    p_in_v = (uint16_t *) p_pic->p[V_PLANE].p_pixels;
-    p_in_end = (uint16_t *) p_in + p_pic->p[U_PLANE].i_visible_lines
-        * (p_pic->p[U_PLANE].i_pitch >> 1) - 8;
-
-    p_out = (uint16_t *) p_outpic->p[U_PLANE].p_pixels;
-    p_out_v = (uint16_t *) p_outpic->p[V_PLANE].p_pixels;
-
-    uint16_t i_u, i_v;
+    return VLC_SUCCESS;
+}
 
-    for( ; p_in < p_in_end ; )
+int planar_sat_hue_C_16( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
+                            int i_sat, int64_t i_x, int64_t i_y )
+{
+    switch( p_pic->format.i_chroma )
     {
-        p_line_end = p_in + (p_pic->p[U_PLANE].i_visible_pitch >> 1) - 8;
-
-        for( ; p_in < p_line_end ; )
-        {
-            /* Do 8 pixels at a time */
-            ADJUST_8_TIMES( PLANAR_WRITE_UV( i_bpp ) );
-        }
-
-        p_line_end += 8;
-
-        for( ; p_in < p_line_end ; )
-        {
-            PLANAR_WRITE_UV( i_bpp );
-        }
-
-        p_in += (p_pic->p[U_PLANE].i_pitch >> 1)
-              - (p_pic->p[U_PLANE].i_visible_pitch >> 1);
-        p_in_v += (p_pic->p[V_PLANE].i_pitch >> 1)
-                - (p_pic->p[V_PLANE].i_visible_pitch >> 1);
-        p_out += (p_outpic->p[U_PLANE].i_pitch >> 1)
-               - (p_outpic->p[U_PLANE].i_visible_pitch >> 1);
-        p_out_v += (p_outpic->p[V_PLANE].i_pitch >> 1)
-                 - (p_outpic->p[V_PLANE].i_visible_pitch >> 1);
+        CASE_PLANAR_YUV10
+            planar_sat_hue_16( p_pic, p_outpic, i_sin, i_cos, i_sat, i_x, i_y,
+                               10, false );
+            break;
+        CASE_PLANAR_YUV9
+            planar_sat_hue_16( p_pic, p_outpic, i_sin, i_cos, i_sat, i_x, i_y,
+                               9, false );
+            break;
+        CASE_PLANAR_YUV12
+            planar_sat_hue_16( p_pic, p_outpic, i_sin, i_cos, i_sat, i_x, i_y,
+                               12, false );
+            break;
+        default:
+            vlc_assert_unreachable();
     }
 
     return VLC_SUCCESS;
 }
 
 int packed_sat_hue_clip_C( picture_t * p_pic, picture_t * p_outpic, int i_sin, int i_cos,
-                         int i_sat, int i_x, int i_y )
+                         int i_sat, int64_t i_x, int64_t i_y )
 {
     uint8_t *p_in, *p_in_v, *p_in_end, *p_line_end;
     uint8_t *p_out, *p_out_v;
@@ -338,7 +332,7 @@ int packed_sat_hue_clip_C( picture_t * p_pic, picture_t * p_outpic, int i_sin, i
 }
 
 int packed_sat_hue_C( picture_t * p_pic, picture_t * p_outpic, int i_sin,
-                      int i_cos, int i_sat, int i_x, int i_y )
+                      int i_cos, int i_sat, int64_t i_x, int64_t i_y )
 {
     uint8_t *p_in, *p_in_v, *p_in_end, *p_line_end;
     uint8_t *p_out, *p_out_v;
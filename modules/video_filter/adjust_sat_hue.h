@@ -42,34 +42,34 @@
  * Basic C compiler generated function for planar format, i_sat > 256
  */
 int planar_sat_hue_clip_C( picture_t * p_pic, picture_t * p_outpic,
-                           int i_sin, int i_cos, int i_sat, int i_x, int i_y );
+                           int i_sin, int i_cos, int i_sat, int64_t i_x, int64_t i_y );
 
 /**
  * Basic C compiler generated function for planar format, i_sat <= 256
  */
 int planar_sat_hue_C( picture_t * p_pic, picture_t * p_outpic,
-                      int i_sin, int i_cos, int i_sat, int i_x, int i_y );
+                      int i_sin, int i_cos, int i_sat, int64_t i_x, int64_t i_y );
 /**
- * Basic C compiler generated function for {9,10}-bit planar format, i_sat > {512,1024}
+ * Basic C compiler generated function for {9,10,12}-bit planar format, i_sat > {512,1024,4096}
  */
 int planar_sat_hue_clip_C_16( picture_t * p_pic, picture_t * p_outpic,
-        int i_sin, int i_cos, int i_sat, int i_x, int i_y );
+        int i_sin, int i_cos, int i_sat, int64_t i_x, int64_t i_y );
 
 /**
- * Basic C compiler generated function for {9,10}-bit planar format, i_sat <= {512,1024}
+ * Basic C compiler generated function for {9,10,12}-bit planar format, i_sat <= {512,1024,4096}
  */
 int planar_sat_hue_C_16( picture_t * p_pic, picture_t * p_outpic,
-        int i_sin, int i_cos, int i_sat, int i_x, int i_y );
+        int i_sin, int i_cos, int i_sat, int64_t i_x, int64_t i_y );
 
 
 /**
  * Basic C compiler generated function for packed format, i_sat > 256
  */
 int packed_sat_hue_clip_C( picture_t * p_pic, picture_t * p_outpic,
-                           int i_sin, int i_cos, int i_sat, int i_x, int i_y );
+                           int i_sin, int i_cos, int i_sat, int64_t i_x, int64_t i_y );
 
 /**
  * Basic C compiler generated function for packed format, i_sat <= 256
  */
 int packed_sat_hue_C( picture_t * p_pic, picture_t * p_outpic,
-                      int i_sin, int i_cos, int i_sat, int i_x, int i_y );
+                      int i_sin, int i_cos, int i_sat, int64_t i_x, int64_t i_y );
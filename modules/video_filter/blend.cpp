@@ -31,6 +31,7 @@
 #include <vlc_plugin.h>
 #include <vlc_filter.h>
 #include <vlc_picture.h>
+#include <vlc_cpu.h>
 #include "filter_picture.h"
 
 /*****************************************************************************
@@ -39,8 +40,14 @@
 static int  Open (filter_t *);
 static void Close(filter_t *);
 
+#define BLEND_C_TEXT N_("Use the C blending routines")
+#define BLEND_C_LONGTEXT N_("Disable the SIMD optimized blending routines " \
+    "and always use the portable C versions (for benchmarking and " \
+    "regression testing).")
+
 vlc_module_begin()
     set_description(N_("Video pictures blending"))
+    add_bool("blend-c", false, BLEND_C_TEXT, BLEND_C_LONGTEXT)
     set_callback_video_blending(Open, 100)
 vlc_module_end()
 
@@ -79,6 +86,18 @@ public:
     {
         return fmt;
     }
+    const picture_t *getPicture() const
+    {
+        return picture;
+    }
+    unsigned getX() const
+    {
+        return x;
+    }
+    unsigned getY() const
+    {
+        return y;
+    }
     bool isFull(unsigned) const
     {
         return true;
@@ -607,6 +626,267 @@ void Blend(const CPicture &dst_data, const CPicture &src_data,
 typedef void (*blend_function_t)(const CPicture &dst_data, const CPicture &src_data,
                                  unsigned width, unsigned height, int alpha);
 
+/*****************************************************************************
+ * SIMD fast paths
+ *****************************************************************************
+ * Hand written specializations for the most common subpicture blends
+ * (RGBA subtitles onto 4:2:0 video or onto a 32 bits RGB surface).  They
+ * implement exactly the same arithmetic as the template code above,
+ * including the div255() rounding and the skipping of fully transparent
+ * source pixels, so the C and SIMD versions always produce bit identical
+ * pictures (blendbench relies on this).
+ */
+#ifdef HAVE_SSE2_INTRINSICS
+# include <emmintrin.h>
+
+# ifdef __SSE2__
+#  define VLC_SSE2
+# else
+#  define VLC_SSE2 __attribute__ ((__target__ ("sse2")))
+# endif
+
+VLC_SSE2 static inline __m128i Div255(__m128i v)
+{
+    /* div255() on 16 bits lanes, exact for the same input range */
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(v, _mm_srli_epi16(v, 8)),
+                                        _mm_set1_epi16(1)), 8);
+}
+
+VLC_SSE2 static inline __m128i Merge(__m128i dst, __m128i src, __m128i f)
+{
+    /* merge() on 16 bits lanes: div255((255 - f) * dst + src * f) */
+    return Div255(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(255), f), dst),
+                                _mm_mullo_epi16(src, f)));
+}
+
+/* Blends 2 RGBA pixels unpacked on [r g b a r g b a] 16 bits lanes,
+ * following the same two steps as CPictureRGBX::merge() */
+template <bool swap_rb>
+VLC_SSE2 static inline __m128i BlendPixelsRGBA(__m128i dst16, __m128i src16, __m128i alpha16)
+{
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i colmask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+
+    if (swap_rb) {
+        src16 = _mm_shufflelo_epi16(src16, _MM_SHUFFLE(3, 0, 1, 2));
+        src16 = _mm_shufflehi_epi16(src16, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+
+    /* broadcast the source and destination alpha of each pixel on its lanes */
+    __m128i sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src16, _MM_SHUFFLE(3, 3, 3, 3)),
+                                     _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i da = _mm_shufflehi_epi16(_mm_shufflelo_epi16(dst16, _MM_SHUFFLE(3, 3, 3, 3)),
+                                     _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i a = Div255(_mm_mullo_epi16(alpha16, sa));
+
+    /* first blend the existing color based on its alpha; feeding the
+     * destination alpha back as source on the alpha lanes keeps them
+     * unchanged during this step */
+    __m128i s1 = _mm_or_si128(_mm_and_si128(src16, colmask),
+                              _mm_andnot_si128(colmask, da));
+    __m128i tmp = Merge(dst16, s1, _mm_sub_epi16(c255, da));
+    /* then blend in the new color; 255 on the alpha lanes implements
+     * dst_a = merge(dst_a, 255, a) */
+    __m128i s2 = _mm_or_si128(_mm_and_si128(src16, colmask),
+                              _mm_andnot_si128(colmask, c255));
+    __m128i res = Merge(tmp, s2, a);
+
+    /* the C version skips fully transparent source pixels entirely */
+    __m128i keep = _mm_cmpeq_epi16(a, _mm_setzero_si128());
+    return _mm_or_si128(_mm_and_si128(keep, dst16), _mm_andnot_si128(keep, res));
+}
+
+template <bool swap_rb>
+VLC_SSE2 static void BlendRGBAOnRGBA_SSE2(const CPicture &dst_data, const CPicture &src_data,
+                                          unsigned width, unsigned height, int alpha)
+{
+    const picture_t *dstp = dst_data.getPicture();
+    const picture_t *srcp = src_data.getPicture();
+    const __m128i alpha16 = _mm_set1_epi16(alpha);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (unsigned y = 0; y < height; y++) {
+        uint8_t *dst = &dstp->p[0].p_pixels[(dst_data.getY() + y) * dstp->p[0].i_pitch
+                                            + dst_data.getX() * 4];
+        const uint8_t *src = &srcp->p[0].p_pixels[(src_data.getY() + y) * srcp->p[0].i_pitch
+                                                  + src_data.getX() * 4];
+        unsigned x = 0;
+        for (; x + 4 <= width; x += 4) {
+            __m128i s = _mm_loadu_si128((const __m128i *)&src[x * 4]);
+            /* subtitle pictures are mostly transparent: when the whole
+             * group has zero alpha, leave the destination untouched */
+            __m128i sa8 = _mm_and_si128(s, _mm_set1_epi32(0xFF000000));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(sa8, zero)) == 0xFFFF)
+                continue;
+            __m128i d = _mm_loadu_si128((const __m128i *)&dst[x * 4]);
+            __m128i lo = BlendPixelsRGBA<swap_rb>(_mm_unpacklo_epi8(d, zero),
+                                                  _mm_unpacklo_epi8(s, zero), alpha16);
+            __m128i hi = BlendPixelsRGBA<swap_rb>(_mm_unpackhi_epi8(d, zero),
+                                                  _mm_unpackhi_epi8(s, zero), alpha16);
+            _mm_storeu_si128((__m128i *)&dst[x * 4], _mm_packus_epi16(lo, hi));
+        }
+        for (; x < width; x++) {
+            const uint8_t *s = &src[x * 4];
+            uint8_t *d = &dst[x * 4];
+            unsigned a = div255(alpha * s[3]);
+            if (a <= 0)
+                continue;
+            ::merge(&d[swap_rb ? 2 : 0], s[0], 255 - d[3]);
+            ::merge(&d[1],               s[1], 255 - d[3]);
+            ::merge(&d[swap_rb ? 0 : 2], s[2], 255 - d[3]);
+            ::merge(&d[swap_rb ? 2 : 0], s[0], a);
+            ::merge(&d[1],               s[1], a);
+            ::merge(&d[swap_rb ? 0 : 2], s[2], a);
+            ::merge(&d[3], 255, a);
+        }
+    }
+}
+
+/* Extracts one channel of 8 RGBA pixels on 16 bits lanes */
+VLC_SSE2 static inline __m128i UnpackChannel(__m128i lo, __m128i hi, int shift)
+{
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    return _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(lo, shift), mask),
+                           _mm_and_si128(_mm_srli_epi32(hi, shift), mask));
+}
+
+template <bool swap_uv>
+VLC_SSE2 static void BlendRGBAOnYUV420_SSE2(const CPicture &dst_data, const CPicture &src_data,
+                                            unsigned width, unsigned height, int alpha)
+{
+    const picture_t *dstp = dst_data.getPicture();
+    const picture_t *srcp = src_data.getPicture();
+    const unsigned dx = dst_data.getX(), dy = dst_data.getY();
+    const __m128i alpha16 = _mm_set1_epi16(alpha);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c128 = _mm_set1_epi16(128);
+
+    for (unsigned y = 0; y < height; y++) {
+        uint8_t *dsty = &dstp->p[0].p_pixels[(dy + y) * dstp->p[0].i_pitch + dx];
+        const uint8_t *src = &srcp->p[0].p_pixels[(src_data.getY() + y) * srcp->p[0].i_pitch
+                                                  + src_data.getX() * 4];
+        unsigned x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m128i p0 = _mm_loadu_si128((const __m128i *)&src[x * 4]);
+            __m128i p1 = _mm_loadu_si128((const __m128i *)&src[x * 4 + 16]);
+            /* subtitle pictures are mostly transparent: when the whole
+             * group has zero alpha, leave the destination untouched */
+            __m128i sa8 = _mm_and_si128(_mm_or_si128(p0, p1),
+                                        _mm_set1_epi32(0xFF000000));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(sa8, zero)) == 0xFFFF)
+                continue;
+            __m128i r = UnpackChannel(p0, p1,  0);
+            __m128i g = UnpackChannel(p0, p1,  8);
+            __m128i b = UnpackChannel(p0, p1, 16);
+            __m128i sa = UnpackChannel(p0, p1, 24);
+
+            /* the luma part of the fixed point rgb_to_yuv() */
+            __m128i luma = _mm_add_epi16(_mm_srli_epi16(
+                _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(66)),
+                                            _mm_mullo_epi16(g, _mm_set1_epi16(129))),
+                              _mm_add_epi16(_mm_mullo_epi16(b, _mm_set1_epi16(25)),
+                                            c128)), 8),
+                _mm_set1_epi16(16));
+
+            __m128i a = Div255(_mm_mullo_epi16(alpha16, sa));
+            __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&dsty[x]), zero);
+            __m128i m = Merge(d, luma, a);
+            __m128i keep = _mm_cmpeq_epi16(a, zero);
+            m = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, m));
+            _mm_storel_epi64((__m128i *)&dsty[x], _mm_packus_epi16(m, m));
+        }
+        for (; x < width; x++) {
+            const uint8_t *s = &src[x * 4];
+            unsigned a = div255(alpha * s[3]);
+            if (a <= 0)
+                continue;
+            uint8_t py, pu, pv;
+            rgb_to_yuv(&py, &pu, &pv, s[0], s[1], s[2]);
+            ::merge(&dsty[x], py, a);
+        }
+
+        /* the chroma planes are only touched on full 4:2:0 sites, one
+         * pixel out of 4: not worth vectorizing */
+        if (((dy + y) % 2) == 0) {
+            const unsigned up = swap_uv ? 2 : 1, vp = swap_uv ? 1 : 2;
+            uint8_t *dstu = &dstp->p[up].p_pixels[((dy + y) / 2) * dstp->p[up].i_pitch];
+            uint8_t *dstv = &dstp->p[vp].p_pixels[((dy + y) / 2) * dstp->p[vp].i_pitch];
+            for (unsigned cx = dx % 2; cx < width; cx += 2) {
+                const uint8_t *s = &src[cx * 4];
+                unsigned a = div255(alpha * s[3]);
+                if (a <= 0)
+                    continue;
+                uint8_t py, pu, pv;
+                rgb_to_yuv(&py, &pu, &pv, s[0], s[1], s[2]);
+                ::merge(&dstu[(dx + cx) / 2], pu, a);
+                ::merge(&dstv[(dx + cx) / 2], pv, a);
+            }
+        }
+    }
+}
+
+/* Blends a planar YUVA source (alpha VP9/AV1 overlay channels decode to
+ * this family) onto 4:2:0 video. The source planes are all full
+ * resolution, so the luma and alpha rows vectorize directly. */
+template <bool swap_uv>
+VLC_SSE2 static void BlendYUVAOnYUV420_SSE2(const CPicture &dst_data, const CPicture &src_data,
+                                            unsigned width, unsigned height, int alpha)
+{
+    const picture_t *dstp = dst_data.getPicture();
+    const picture_t *srcp = src_data.getPicture();
+    const unsigned dx = dst_data.getX(), dy = dst_data.getY();
+    const unsigned sx = src_data.getX(), sy = src_data.getY();
+    const __m128i alpha16 = _mm_set1_epi16(alpha);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (unsigned y = 0; y < height; y++) {
+        uint8_t *dsty = &dstp->p[0].p_pixels[(dy + y) * dstp->p[0].i_pitch + dx];
+        const uint8_t *srcy = &srcp->p[0].p_pixels[(sy + y) * srcp->p[0].i_pitch + sx];
+        const uint8_t *srca = &srcp->p[3].p_pixels[(sy + y) * srcp->p[3].i_pitch + sx];
+        unsigned x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m128i sa8 = _mm_loadl_epi64((const __m128i *)&srca[x]);
+            /* subtitle pictures are mostly transparent: when the whole
+             * group has zero alpha, leave the destination untouched */
+            if ((_mm_movemask_epi8(_mm_cmpeq_epi8(sa8, zero)) & 0xFF) == 0xFF)
+                continue;
+            __m128i s = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&srcy[x]), zero);
+            __m128i sa = _mm_unpacklo_epi8(sa8, zero);
+            __m128i a = Div255(_mm_mullo_epi16(alpha16, sa));
+            __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&dsty[x]), zero);
+            __m128i m = Merge(d, s, a);
+            __m128i keep = _mm_cmpeq_epi16(a, zero);
+            m = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, m));
+            _mm_storel_epi64((__m128i *)&dsty[x], _mm_packus_epi16(m, m));
+        }
+        for (; x < width; x++) {
+            unsigned a = div255(alpha * srca[x]);
+            if (a <= 0)
+                continue;
+            ::merge(&dsty[x], srcy[x], a);
+        }
+
+        /* the chroma planes are only touched on full 4:2:0 sites, one
+         * pixel out of 4: not worth vectorizing */
+        if (((dy + y) % 2) == 0) {
+            const unsigned up = swap_uv ? 2 : 1, vp = swap_uv ? 1 : 2;
+            uint8_t *dstu = &dstp->p[up].p_pixels[((dy + y) / 2) * dstp->p[up].i_pitch];
+            uint8_t *dstv = &dstp->p[vp].p_pixels[((dy + y) / 2) * dstp->p[vp].i_pitch];
+            const uint8_t *srcu = &srcp->p[1].p_pixels[(sy + y) * srcp->p[1].i_pitch + sx];
+            const uint8_t *srcv = &srcp->p[2].p_pixels[(sy + y) * srcp->p[2].i_pitch + sx];
+            for (unsigned cx = dx % 2; cx < width; cx += 2) {
+                unsigned a = div255(alpha * srca[cx]);
+                if (a <= 0)
+                    continue;
+                ::merge(&dstu[(dx + cx) / 2], srcu[cx], a);
+                ::merge(&dstv[(dx + cx) / 2], srcv[cx], a);
+            }
+        }
+    }
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
 namespace {
 
 static const struct {
@@ -747,6 +1027,38 @@ static int Open(filter_t *filter)
             sys->blend = blends[i].blend;
     }
 
+#ifdef HAVE_SSE2_INTRINSICS
+    /* Runtime dispatched fast paths, bit identical to the table versions */
+    if (sys->blend != NULL
+     && vlc_CPU_SSE2() && !var_InheritBool(filter, "blend-c")) {
+        if (src == VLC_CODEC_RGBA) {
+            switch (dst) {
+                case VLC_CODEC_RGBA:
+                    sys->blend = BlendRGBAOnRGBA_SSE2<false>;
+                    break;
+                case VLC_CODEC_BGRA:
+                    sys->blend = BlendRGBAOnRGBA_SSE2<true>;
+                    break;
+                case VLC_CODEC_I420:
+                    sys->blend = BlendRGBAOnYUV420_SSE2<false>;
+                    break;
+                case VLC_CODEC_YV12:
+                    sys->blend = BlendRGBAOnYUV420_SSE2<true>;
+                    break;
+            }
+        } else if (src == VLC_CODEC_YUVA) {
+            switch (dst) {
+                case VLC_CODEC_I420:
+                    sys->blend = BlendYUVAOnYUV420_SSE2<false>;
+                    break;
+                case VLC_CODEC_YV12:
+                    sys->blend = BlendYUVAOnYUV420_SSE2<true>;
+                    break;
+            }
+        }
+    }
+#endif
+
     if (!sys->blend) {
        msg_Err(filter, "no matching alpha blending routine (chroma: %4.4s -> %4.4s)",
                (char *)&src, (char *)&dst);
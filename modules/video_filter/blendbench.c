@@ -68,6 +68,14 @@ static picture_t *Filter( filter_t *, picture_t * );
 #define BLEND_CHROMA_LONGTEXT N_("Chroma which the blend image will be loaded" \
                                  " in")
 
+#define CHECK_TEXT N_("Check the optimized blending routines")
+#define CHECK_LONGTEXT N_("Compare the output of the blending module " \
+    "against its C reference routines and report a failure on any mismatch")
+
+#define MIN_SPEED_TEXT N_("Minimum blending speed")
+#define MIN_SPEED_LONGTEXT N_("Minimal acceptable speed in images per " \
+    "second, below which the benchmark is reported as failed (0 to disable)")
+
 #define CFG_PREFIX "blendbench-"
 
 vlc_module_begin ()
@@ -80,6 +88,9 @@ vlc_module_begin ()
               LOOPS_LONGTEXT )
     add_integer_with_range( CFG_PREFIX "alpha", 128, 0, 255, ALPHA_TEXT,
               ALPHA_LONGTEXT )
+    add_bool( CFG_PREFIX "check", true, CHECK_TEXT, CHECK_LONGTEXT )
+    add_integer( CFG_PREFIX "min-speed", 0, MIN_SPEED_TEXT,
+              MIN_SPEED_LONGTEXT )
 
     set_section( N_("Base image"), NULL )
     add_loadfile(CFG_PREFIX "base-image", NULL,
@@ -98,7 +109,7 @@ vlc_module_end ()
 
 static const char *const ppsz_filter_options[] = {
     "loops", "alpha", "base-image", "base-chroma", "blend-image",
-    "blend-chroma", NULL
+    "blend-chroma", "check", "min-speed", NULL
 };
 
 /*****************************************************************************
@@ -107,7 +118,8 @@ static const char *const ppsz_filter_options[] = {
 typedef struct
 {
     bool b_done;
-    int i_loops, i_alpha;
+    bool b_check;
+    int i_loops, i_alpha, i_min_speed;
 
     picture_t *p_base_image;
     picture_t *p_blend_image;
@@ -175,6 +187,9 @@ static int Create( filter_t *p_filter )
                                                   CFG_PREFIX "loops" );
     p_sys->i_alpha = var_CreateGetIntegerCommand( p_filter,
                                                   CFG_PREFIX "alpha" );
+    p_sys->b_check = var_CreateGetBoolCommand( p_filter, CFG_PREFIX "check" );
+    p_sys->i_min_speed = var_CreateGetIntegerCommand( p_filter,
+                                                      CFG_PREFIX "min-speed" );
 
     psz_temp = var_CreateGetStringCommand( p_filter, CFG_PREFIX "base-chroma" );
     p_sys->i_base_chroma = !psz_temp || strlen( psz_temp ) != 4 ? 0 :
@@ -226,30 +241,100 @@ static void Destroy( filter_t *p_filter )
 /*****************************************************************************
  * Render: displays previously rendered output
  *****************************************************************************/
-static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
+static filter_t *blendbench_CreateBlend( filter_t *p_filter, bool b_force_c )
 {
     filter_sys_t *p_sys = p_filter->p_sys;
     filter_t *p_blend;
 
-    if( p_sys->b_done )
-        return p_pic;
-
     p_blend = vlc_object_create( p_filter, sizeof(filter_t) );
     if( !p_blend )
-    {
-        picture_Release( p_pic );
         return NULL;
-    }
     p_blend->fmt_out.video = p_sys->p_base_image->format;
     p_blend->fmt_in.video = p_sys->p_blend_image->format;
+    if( b_force_c )
+    {
+        /* make the blending module skip its SIMD dispatch */
+        var_Create( p_blend, "blend-c", VLC_VAR_BOOL );
+        var_SetBool( p_blend, "blend-c", true );
+    }
     p_blend->p_module = vlc_filter_LoadModule( p_blend, "video blending", NULL, false );
     if( !p_blend->p_module )
     {
-        picture_Release( p_pic );
-        vlc_object_delete(p_blend);
+        vlc_object_delete( p_blend );
         return NULL;
     }
     assert( p_blend->ops != NULL );
+    return p_blend;
+}
+
+static bool blendbench_CheckOutput( filter_t *p_filter )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    bool b_ok = false;
+
+    picture_t *p_out = picture_NewFromFormat( &p_sys->p_base_image->format );
+    picture_t *p_out_c = picture_NewFromFormat( &p_sys->p_base_image->format );
+    filter_t *p_blend = blendbench_CreateBlend( p_filter, false );
+    filter_t *p_blend_c = blendbench_CreateBlend( p_filter, true );
+
+    if( p_out && p_out_c && p_blend && p_blend_c )
+    {
+        picture_Copy( p_out, p_sys->p_base_image );
+        picture_Copy( p_out_c, p_sys->p_base_image );
+        filter_Blend( p_blend, p_out,
+                      0, 0, p_sys->p_blend_image, p_sys->i_alpha );
+        filter_Blend( p_blend_c, p_out_c,
+                      0, 0, p_sys->p_blend_image, p_sys->i_alpha );
+
+        b_ok = true;
+        for( int i = 0; i < p_out->i_planes; i++ )
+        {
+            const plane_t *p_sp = &p_out->p[i];
+            const plane_t *p_cp = &p_out_c->p[i];
+            for( int j = 0; j < p_sp->i_visible_lines && b_ok; j++ )
+                if( memcmp( &p_sp->p_pixels[j * p_sp->i_pitch],
+                            &p_cp->p_pixels[j * p_cp->i_pitch],
+                            p_sp->i_visible_pitch ) )
+                {
+                    msg_Err( p_filter, "blend output mismatch against the C "
+                             "routines on plane %d line %d", i, j );
+                    b_ok = false;
+                }
+        }
+    }
+
+    if( p_blend )
+        vlc_filter_Delete( p_blend );
+    if( p_blend_c )
+        vlc_filter_Delete( p_blend_c );
+    if( p_out )
+        picture_Release( p_out );
+    if( p_out_c )
+        picture_Release( p_out_c );
+
+    return b_ok;
+}
+
+static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
+{
+    filter_sys_t *p_sys = p_filter->p_sys;
+    filter_t *p_blend;
+    bool b_failed = false;
+
+    if( p_sys->b_done )
+        return p_pic;
+
+    /* compare the selected (possibly SIMD) routines against the C
+     * reference before the base image gets modified by the timing loop */
+    if( p_sys->b_check && !blendbench_CheckOutput( p_filter ) )
+        b_failed = true;
+
+    p_blend = blendbench_CreateBlend( p_filter, false );
+    if( !p_blend )
+    {
+        picture_Release( p_pic );
+        return NULL;
+    }
 
     vlc_tick_t time = vlc_tick_now();
     for( int i_iter = 0; i_iter < p_sys->i_loops; ++i_iter )
@@ -259,14 +344,26 @@ static picture_t *Filter( filter_t *p_filter, picture_t *p_pic )
     }
     time = vlc_tick_now() - time;
 
+    float f_speed = (float) p_sys->i_loops / time * CLOCK_FREQ;
     msg_Info( p_filter, "Blended %d images in %f sec", p_sys->i_loops,
               secf_from_vlc_tick(time) );
     msg_Info( p_filter, "Speed is: %f images/second, %f pixels/second",
-              (float) p_sys->i_loops / time * CLOCK_FREQ,
-              (float) p_sys->i_loops / time * CLOCK_FREQ *
+              f_speed, f_speed *
                   p_sys->p_blend_image->p[Y_PLANE].i_visible_pitch *
                   p_sys->p_blend_image->p[Y_PLANE].i_visible_lines );
 
+    if( p_sys->i_min_speed > 0 && f_speed < (float) p_sys->i_min_speed )
+    {
+        msg_Err( p_filter, "speed is below the required %d images/second",
+                 p_sys->i_min_speed );
+        b_failed = true;
+    }
+
+    if( b_failed )
+        msg_Err( p_filter, "blending benchmark FAILED" );
+    else
+        msg_Info( p_filter, "blending benchmark passed" );
+
     vlc_filter_Delete( p_blend );
 
     p_sys->b_done = true;
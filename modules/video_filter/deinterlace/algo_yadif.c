@@ -35,6 +35,7 @@
 
 #include "deinterlace.h" /* filter_sys_t  */
 #include "common.h"      /* FFMIN3 et al. */
+#include "slice.h"       /* slice worker pool */
 
 #include "algo_yadif.h"
 
@@ -51,6 +52,69 @@ int RenderYadifSingle( filter_t *p_filter, picture_t *p_dst, picture_t *p_src )
     return RenderYadif( p_filter, p_dst, p_src, 0, 0 );
 }
 
+/**
+ * Per-plane state shared by the slices of one YadifSlice() job.
+ *
+ * Every output line only depends on the source pictures, so slices may
+ * process disjoint line bands concurrently.
+ */
+struct yadif_slice_ctx
+{
+    void (*filter)(uint8_t *dst, uint8_t *prev, uint8_t *cur, uint8_t *next,
+                   int w, int prefs, int mrefs, int parity, int mode);
+    const plane_t *prevp;
+    const plane_t *curp;
+    const plane_t *nextp;
+    plane_t *dstp;
+    int i_field;
+    int yadif_parity;
+};
+
+static void YadifSlice( void *p_data, int i_first, int i_last )
+{
+    const struct yadif_slice_ctx *p_ctx = p_data;
+    const plane_t *prevp = p_ctx->prevp;
+    const plane_t *curp  = p_ctx->curp;
+    const plane_t *nextp = p_ctx->nextp;
+    plane_t *dstp        = p_ctx->dstp;
+
+    for( int y = i_first; y < i_last; y++ )
+    {
+        if( (y % 2) == p_ctx->i_field  ||  p_ctx->yadif_parity == 2 )
+        {
+            memcpy( &dstp->p_pixels[y * dstp->i_pitch],
+                        &curp->p_pixels[y * curp->i_pitch], dstp->i_visible_pitch );
+        }
+        else
+        {
+            int mode;
+            /* Spatial checks only when enough data */
+            mode = (y >= 2 && y < dstp->i_visible_lines - 2) ? 0 : 2;
+
+            assert( prevp->i_pitch == curp->i_pitch && curp->i_pitch == nextp->i_pitch );
+            p_ctx->filter( &dstp->p_pixels[y * dstp->i_pitch],
+                    &prevp->p_pixels[y * prevp->i_pitch],
+                    &curp->p_pixels[y * curp->i_pitch],
+                    &nextp->p_pixels[y * nextp->i_pitch],
+                    dstp->i_visible_pitch,
+                    y < dstp->i_visible_lines - 2  ? curp->i_pitch : -curp->i_pitch,
+                    y  - 1  ?  -curp->i_pitch : curp->i_pitch,
+                    p_ctx->yadif_parity,
+                    mode );
+        }
+
+        /* We duplicate the first and last lines */
+        if( y == 1 )
+            memcpy(&dstp->p_pixels[(y-1) * dstp->i_pitch],
+                       &dstp->p_pixels[ y    * dstp->i_pitch],
+                       dstp->i_pitch);
+        else if( y == dstp->i_visible_lines - 2 )
+            memcpy(&dstp->p_pixels[(y+1) * dstp->i_pitch],
+                       &dstp->p_pixels[ y    * dstp->i_pitch],
+                       dstp->i_pitch);
+    }
+}
+
 int RenderYadif( filter_t *p_filter, picture_t *p_dst, picture_t *p_src,
                  int i_order, int i_field )
 {
@@ -127,46 +191,18 @@ int RenderYadif( filter_t *p_filter, picture_t *p_dst, picture_t *p_src,
 
         for( int n = 0; n < p_dst->i_planes; n++ )
         {
-            const plane_t *prevp = &p_prev->p[n];
-            const plane_t *curp  = &p_cur->p[n];
-            const plane_t *nextp = &p_next->p[n];
-            plane_t *dstp        = &p_dst->p[n];
-
-            for( int y = 1; y < dstp->i_visible_lines - 1; y++ )
-            {
-                if( (y % 2) == i_field  ||  yadif_parity == 2 )
-                {
-                    memcpy( &dstp->p_pixels[y * dstp->i_pitch],
-                                &curp->p_pixels[y * curp->i_pitch], dstp->i_visible_pitch );
-                }
-                else
-                {
-                    int mode;
-                    /* Spatial checks only when enough data */
-                    mode = (y >= 2 && y < dstp->i_visible_lines - 2) ? 0 : 2;
-
-                    assert( prevp->i_pitch == curp->i_pitch && curp->i_pitch == nextp->i_pitch );
-                    filter( &dstp->p_pixels[y * dstp->i_pitch],
-                            &prevp->p_pixels[y * prevp->i_pitch],
-                            &curp->p_pixels[y * curp->i_pitch],
-                            &nextp->p_pixels[y * nextp->i_pitch],
-                            dstp->i_visible_pitch,
-                            y < dstp->i_visible_lines - 2  ? curp->i_pitch : -curp->i_pitch,
-                            y  - 1  ?  -curp->i_pitch : curp->i_pitch,
-                            yadif_parity,
-                            mode );
-                }
-
-                /* We duplicate the first and last lines */
-                if( y == 1 )
-                    memcpy(&dstp->p_pixels[(y-1) * dstp->i_pitch],
-                               &dstp->p_pixels[ y    * dstp->i_pitch],
-                               dstp->i_pitch);
-                else if( y == dstp->i_visible_lines - 2 )
-                    memcpy(&dstp->p_pixels[(y+1) * dstp->i_pitch],
-                               &dstp->p_pixels[ y    * dstp->i_pitch],
-                               dstp->i_pitch);
-            }
+            struct yadif_slice_ctx ctx = {
+                .filter = filter,
+                .prevp = &p_prev->p[n],
+                .curp  = &p_cur->p[n],
+                .nextp = &p_next->p[n],
+                .dstp  = &p_dst->p[n],
+                .i_field = i_field,
+                .yadif_parity = yadif_parity,
+            };
+
+            DeintSlicePoolRun( p_sys->p_slice_pool, YadifSlice, &ctx,
+                               1, ctx.dstp->i_visible_lines - 1 );
         }
 
         p_sys->context.i_frame_offset = 1; /* p_cur will be rendered at next frame, too */
@@ -479,8 +479,11 @@ int Mouse( filter_t *p_filter,
  */
 static void Close( filter_t *p_filter )
 {
+    filter_sys_t *p_sys = p_filter->p_sys;
+
     Flush( p_filter );
-    free( p_filter->p_sys );
+    DeintSlicePoolDestroy( p_sys->p_slice_pool );
+    free( p_sys );
 }
 
 static const struct vlc_filter_operations filter_ops = {
@@ -554,6 +557,19 @@ notsupp:
 
     IVTCClearState( p_filter );
 
+    /* Yadif output lines are independent, so large pictures can be split
+     * into bands deinterlaced in parallel. Other algorithms either carry
+     * state across lines or are cheap enough not to bother. */
+    p_sys->p_slice_pool = NULL;
+    if( p_sys->context.pf_render_ordered == RenderYadif ||
+        p_sys->context.pf_render_single_pic == RenderYadifSingle )
+    {
+        unsigned i_cpus = vlc_GetCPUCount();
+        if( i_cpus > 1 && p_filter->fmt_in.video.i_height >= 720 )
+            p_sys->p_slice_pool =
+                DeintSlicePoolCreate( __MIN( i_cpus, 8 ) - 1 );
+    }
+
 #if defined(CAN_COMPILE_C_ALTIVEC)
     if( pixel_size == 1 && vlc_CPU_ALTIVEC() )
         p_sys->pf_merge = MergeAltivec;
@@ -42,6 +42,7 @@ struct vlc_object_t;
 #include "algo_phosphor.h"
 #include "algo_ivtc.h"
 #include "common.h"
+#include "slice.h"
 
 /*****************************************************************************
  * Local data
@@ -77,6 +78,9 @@ typedef struct
 
     struct deinterlace_ctx   context;
 
+    /** Slice worker pool for parallel algorithms, or NULL. */
+    deint_slice_pool_t *p_slice_pool;
+
     /* Algorithm-specific substructures */
     union {
         phosphor_sys_t phosphor; /**< Phosphor algorithm state. */
@@ -0,0 +1,191 @@
+/*****************************************************************************
+ * slice.c : slice worker pool for the VLC deinterlacer
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+#   include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_threads.h>
+
+#include "slice.h"
+
+/** Bands smaller than this are not worth a hand-off to another thread. */
+#define SLICE_MIN_LINES 16
+
+struct deint_slice_pool
+{
+    vlc_mutex_t lock;
+    vlc_cond_t wait_job;   /**< Signalled when a new job is posted */
+    vlc_cond_t wait_done;  /**< Signalled when the last worker goes idle */
+
+    vlc_thread_t *threads;
+    unsigned i_workers;
+    bool b_exit;
+
+    /* Current job, valid while i_busy > 0 or bands remain */
+    deint_slice_fn pf_process;
+    void *p_ctx;
+    int i_first, i_last;  /**< Full line range of the job */
+    int i_band, i_bands;  /**< Next band to claim / total band count */
+    int i_band_lines;     /**< Lines per band (last band takes the rest) */
+    unsigned i_generation; /**< Bumped on each job to wake the workers */
+    unsigned i_busy;       /**< Workers still participating in the job */
+};
+
+/* Claims and processes bands until none are left. Called with the lock
+ * held; returns with the lock held. */
+static void SliceWork( deint_slice_pool_t *p_pool )
+{
+    while( p_pool->i_band < p_pool->i_bands )
+    {
+        int i_band = p_pool->i_band++;
+        int i_first = p_pool->i_first + i_band * p_pool->i_band_lines;
+        int i_last = ( i_band + 1 == p_pool->i_bands ) ? p_pool->i_last
+                   : i_first + p_pool->i_band_lines;
+
+        deint_slice_fn pf_process = p_pool->pf_process;
+        void *p_ctx = p_pool->p_ctx;
+
+        vlc_mutex_unlock( &p_pool->lock );
+        pf_process( p_ctx, i_first, i_last );
+        vlc_mutex_lock( &p_pool->lock );
+    }
+}
+
+static void *SliceThread( void *p_data )
+{
+    deint_slice_pool_t *p_pool = p_data;
+    unsigned i_seen = 0;
+
+    vlc_thread_set_name( "vlc-deint" );
+
+    vlc_mutex_lock( &p_pool->lock );
+    for( ;; )
+    {
+        while( p_pool->i_generation == i_seen && !p_pool->b_exit )
+            vlc_cond_wait( &p_pool->wait_job, &p_pool->lock );
+        if( p_pool->b_exit )
+            break;
+        i_seen = p_pool->i_generation;
+
+        SliceWork( p_pool );
+        if( --p_pool->i_busy == 0 )
+            vlc_cond_signal( &p_pool->wait_done );
+    }
+    vlc_mutex_unlock( &p_pool->lock );
+    return NULL;
+}
+
+deint_slice_pool_t *DeintSlicePoolCreate( unsigned i_workers )
+{
+    if( i_workers == 0 )
+        return NULL;
+
+    deint_slice_pool_t *p_pool = malloc( sizeof( *p_pool ) );
+    if( !p_pool )
+        return NULL;
+
+    p_pool->threads = vlc_alloc( i_workers, sizeof( *p_pool->threads ) );
+    if( !p_pool->threads )
+    {
+        free( p_pool );
+        return NULL;
+    }
+
+    vlc_mutex_init( &p_pool->lock );
+    vlc_cond_init( &p_pool->wait_job );
+    vlc_cond_init( &p_pool->wait_done );
+    p_pool->b_exit = false;
+    p_pool->i_band = p_pool->i_bands = 0;
+    p_pool->i_generation = 0;
+    p_pool->i_busy = 0;
+
+    for( p_pool->i_workers = 0; p_pool->i_workers < i_workers;
+         p_pool->i_workers++ )
+        if( vlc_clone( &p_pool->threads[p_pool->i_workers],
+                       SliceThread, p_pool ) )
+            break;
+
+    if( p_pool->i_workers == 0 )
+    {
+        free( p_pool->threads );
+        free( p_pool );
+        return NULL;
+    }
+    return p_pool;
+}
+
+void DeintSlicePoolRun( deint_slice_pool_t *p_pool, deint_slice_fn pf_process,
+                        void *p_ctx, int i_first, int i_last )
+{
+    int i_lines = i_last - i_first;
+
+    if( i_lines <= 0 )
+        return;
+    if( p_pool == NULL || i_lines < 2 * SLICE_MIN_LINES )
+    {
+        pf_process( p_ctx, i_first, i_last );
+        return;
+    }
+
+    /* A few bands per thread so a slow band does not serialize the rest */
+    int i_bands = 4 * ( p_pool->i_workers + 1 );
+    if( i_bands > i_lines / SLICE_MIN_LINES )
+        i_bands = i_lines / SLICE_MIN_LINES;
+
+    vlc_mutex_lock( &p_pool->lock );
+    p_pool->pf_process = pf_process;
+    p_pool->p_ctx = p_ctx;
+    p_pool->i_first = i_first;
+    p_pool->i_last = i_last;
+    p_pool->i_band = 0;
+    p_pool->i_bands = i_bands;
+    p_pool->i_band_lines = i_lines / i_bands;
+    p_pool->i_busy = p_pool->i_workers;
+    p_pool->i_generation++;
+    vlc_cond_broadcast( &p_pool->wait_job );
+
+    /* The caller works too instead of just waiting */
+    SliceWork( p_pool );
+
+    while( p_pool->i_busy > 0 )
+        vlc_cond_wait( &p_pool->wait_done, &p_pool->lock );
+    vlc_mutex_unlock( &p_pool->lock );
+}
+
+void DeintSlicePoolDestroy( deint_slice_pool_t *p_pool )
+{
+    if( p_pool == NULL )
+        return;
+
+    vlc_mutex_lock( &p_pool->lock );
+    p_pool->b_exit = true;
+    vlc_cond_broadcast( &p_pool->wait_job );
+    vlc_mutex_unlock( &p_pool->lock );
+
+    for( unsigned i = 0; i < p_pool->i_workers; i++ )
+        vlc_join( p_pool->threads[i], NULL );
+
+    free( p_pool->threads );
+    free( p_pool );
+}
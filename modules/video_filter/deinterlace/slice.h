@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * slice.h : slice worker pool for the VLC deinterlacer
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_DEINTERLACE_SLICE_H
+#define VLC_DEINTERLACE_SLICE_H 1
+
+/**
+ * \file
+ * Worker pool splitting a picture into horizontal bands processed in
+ * parallel. Only algorithms whose output lines are independent of each
+ * other (such as Yadif) may use it.
+ */
+
+struct filter_t;
+
+/**
+ * Slice processing routine.
+ *
+ * Processes the destination lines in [i_first, i_last). The routine is
+ * called concurrently from several threads with disjoint line ranges and
+ * must not write outside its own band, except for the duplicated
+ * first/last picture lines which belong to the bands containing their
+ * neighbours.
+ */
+typedef void (*deint_slice_fn)( void *p_ctx, int i_first, int i_last );
+
+typedef struct deint_slice_pool deint_slice_pool_t;
+
+/**
+ * Creates a slice worker pool.
+ *
+ * @param i_workers number of worker threads to spawn; the thread calling
+ *                  DeintSlicePoolRun() takes part too, so i_workers is
+ *                  typically the CPU count minus one
+ * @return the pool, or NULL on error (callers then process sequentially)
+ */
+deint_slice_pool_t *DeintSlicePoolCreate( unsigned i_workers );
+
+/**
+ * Runs a slice routine over the line range [i_first, i_last).
+ *
+ * Blocks until all bands have been processed. The calling thread
+ * processes bands alongside the workers. A NULL pool, or a range too
+ * small to be worth splitting, degrades to a direct sequential call.
+ */
+void DeintSlicePoolRun( deint_slice_pool_t *p_pool, deint_slice_fn pf_process,
+                        void *p_ctx, int i_first, int i_last );
+
+/**
+ * Destroys a slice worker pool. NULL is a no-op.
+ */
+void DeintSlicePoolDestroy( deint_slice_pool_t *p_pool );
+
+#endif
@@ -44,6 +44,12 @@
         case VLC_CODEC_I444_9L:             \
         case VLC_CODEC_I444_9B:
 
+#define CASE_PLANAR_YUV12                   \
+        case VLC_CODEC_I420_12L:            \
+        case VLC_CODEC_I420_12B:            \
+        case VLC_CODEC_I444_12L:            \
+        case VLC_CODEC_I444_12B:
+
 #define CASE_PLANAR_YUV                     \
         CASE_PLANAR_YUV_SQUARE              \
         CASE_PLANAR_YUV_NONSQUARE
@@ -89,6 +89,7 @@ vlc_module_end()
 #define av_clip_uint8 clip_uint8_vlc
 #include <stdalign.h>
 #include "gradfun.h"
+#include "vf_workers.h"
 
 static int Callback(vlc_object_t *, char const *, vlc_value_t, vlc_value_t, void *);
 VIDEO_FILTER_WRAPPER_CLOSE(Filter, Close)
@@ -100,6 +101,7 @@ typedef struct
     int              radius;
     const vlc_chroma_description_t *chroma;
     struct vf_priv_s cfg;
+    uint16_t         *buf[3]; /* one scratch buffer per plane worker */
 } filter_sys_t;
 
 static int Open(filter_t *filter)
@@ -117,6 +119,11 @@ static int Open(filter_t *filter)
     if (!sys)
         return VLC_ENOMEM;
 
+    if (vf_workers_Hold() != VLC_SUCCESS) {
+        free(sys);
+        return VLC_ENOMEM;
+    }
+
     vlc_mutex_init(&sys->lock);
     sys->chroma   = chroma;
     sys->strength = var_CreateGetFloatCommand(filter,   CFG_PREFIX "strength");
@@ -124,6 +131,8 @@ static int Open(filter_t *filter)
     var_AddCallback(filter, CFG_PREFIX "strength", Callback, NULL);
     var_AddCallback(filter, CFG_PREFIX "radius",   Callback, NULL);
     sys->cfg.buf = NULL;
+    for (int i = 0; i < 3; i++)
+        sys->buf[i] = NULL;
 
     struct vf_priv_s *cfg = &sys->cfg;
     cfg->thresh      = 0.0;
@@ -154,8 +163,24 @@ static void Close(filter_t *filter)
 
     var_DelCallback(filter, CFG_PREFIX "radius",   Callback, NULL);
     var_DelCallback(filter, CFG_PREFIX "strength", Callback, NULL);
-    aligned_free(sys->cfg.buf);
+    for (int i = 0; i < 3; i++)
+        aligned_free(sys->buf[i]);
     free(sys);
+    vf_workers_Release();
+}
+
+struct gradfun_task
+{
+    struct vf_priv_s cfg; /* private copy pointing to this plane's scratch */
+    uint8_t *dst, *src;
+    int w, h, dstride, sstride, r;
+};
+
+static void FilterPlaneTask(void *data)
+{
+    struct gradfun_task *task = data;
+    filter_plane(&task->cfg, task->dst, task->src, task->w, task->h,
+                 task->dstride, task->sstride, task->r);
 }
 
 static void Filter(filter_t *filter, picture_t *src, picture_t *dst)
@@ -173,10 +198,17 @@ static void Filter(filter_t *filter, picture_t *src, picture_t *dst)
     cfg->thresh = (1 << 15) / strength;
     if (cfg->radius != radius) {
         cfg->radius = radius;
-        cfg->buf    = aligned_alloc(16,
-                                   (((fmt->i_width + 15) & ~15) * (cfg->radius + 1) / 2 + 32) * sizeof(*cfg->buf));
+        for (int i = 0; i < 3; i++) {
+            aligned_free(sys->buf[i]);
+            sys->buf[i] = aligned_alloc(16,
+                                   (((fmt->i_width + 15) & ~15) * (cfg->radius + 1) / 2 + 32) * sizeof(*sys->buf[i]));
+        }
     }
 
+    struct gradfun_task tasks[3];
+    struct vf_task work[3];
+    unsigned count = 0;
+
     for (int i = 0; i < dst->i_planes; i++) {
         const plane_t *srcp = &src->p[i];
         plane_t       *dstp = &dst->p[i];
@@ -187,13 +219,27 @@ static void Filter(filter_t *filter, picture_t *src, picture_t *dst)
         int r = (cfg->radius  * chroma->p[i].w.num / chroma->p[i].w.den +
                  cfg->radius  * chroma->p[i].h.num / chroma->p[i].h.den) / 2;
         r = VLC_CLIP((r + 1) & ~1, RADIUS_MIN, RADIUS_MAX);
-        if (__MIN(w, h) > 2 * r && cfg->buf) {
-            filter_plane(cfg, dstp->p_pixels, srcp->p_pixels,
-                         w, h, dstp->i_pitch, srcp->i_pitch, r);
+        if (__MIN(w, h) > 2 * r && sys->buf[i]) {
+            struct gradfun_task *task = &tasks[count];
+            task->cfg     = *cfg;
+            task->cfg.buf = sys->buf[i];
+            task->dst     = dstp->p_pixels;
+            task->src     = srcp->p_pixels;
+            task->w       = w;
+            task->h       = h;
+            task->dstride = dstp->i_pitch;
+            task->sstride = srcp->i_pitch;
+            task->r       = r;
+            work[count].run  = FilterPlaneTask;
+            work[count].data = task;
+            count++;
         } else {
             plane_CopyPixels(dstp, srcp);
         }
     }
+
+    /* Planes are independent: denoise them in parallel */
+    vf_workers_Run(work, count);
 }
 
 static int Callback(vlc_object_t *object, char const *cmd,
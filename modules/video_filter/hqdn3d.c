@@ -37,6 +37,7 @@
 
 
 #include "hqdn3d.h"
+#include "vf_workers.h"
 
 /*****************************************************************************
  * Local protypes
@@ -106,7 +107,6 @@ static int Open(filter_t *filter)
     const video_format_t *fmt_in  = &filter->fmt_in.video;
     const video_format_t *fmt_out = &filter->fmt_out.video;
     const vlc_fourcc_t fourcc_in  = fmt_in->i_chroma;
-    int wmax = 0;
 
     if ( !video_format_IsSameChroma( fmt_in, fmt_out ) ) {
         msg_Err(filter, "Input and output chromas don't match");
@@ -130,15 +130,23 @@ static int Open(filter_t *filter)
 
     sys->chroma = chroma;
 
+    if (vf_workers_Hold() != VLC_SUCCESS) {
+        free(sys);
+        return VLC_ENOMEM;
+    }
+
     for (int i = 0; i < 3; ++i) {
         sys->w[i] = fmt_in->i_width  * chroma->p[i].w.num / chroma->p[i].w.den;
-        if (sys->w[i] > wmax) wmax = sys->w[i];
         sys->h[i] = fmt_out->i_height * chroma->p[i].h.num / chroma->p[i].h.den;
-    }
-    cfg->Line = malloc(wmax*sizeof(unsigned int));
-    if (!cfg->Line) {
-        free(sys);
-        return VLC_ENOMEM;
+        /* One line buffer per plane, so the plane workers do not share it */
+        cfg->Line[i] = malloc(sys->w[i]*sizeof(unsigned int));
+        if (!cfg->Line[i]) {
+            while (i > 0)
+                free(cfg->Line[--i]);
+            vf_workers_Release();
+            free(sys);
+            return VLC_ENOMEM;
+        }
     }
 
     config_ChainParse(filter, FILTER_PREFIX, filter_options,
@@ -183,9 +191,27 @@ static void Close(filter_t *filter)
 
     for (int i = 0; i < 3; ++i) {
         free(cfg->Frame[i]);
+        free(cfg->Line[i]);
     }
-    free(cfg->Line);
     free(sys);
+    vf_workers_Release();
+}
+
+struct hqdn3d_task
+{
+    unsigned char *src, *dst;
+    unsigned int *line;
+    unsigned short **frame;
+    int w, h, sstride, dstride;
+    int *spat, *temp;
+};
+
+static void DenoisePlaneTask(void *data)
+{
+    struct hqdn3d_task *task = data;
+    deNoise(task->src, task->dst, task->line, task->frame,
+            task->w, task->h, task->sstride, task->dstride,
+            task->spat, task->spat, task->temp);
 }
 
 /*****************************************************************************
@@ -220,24 +246,27 @@ static picture_t *Filter(filter_t *filter, picture_t *src)
     }
     vlc_mutex_unlock( &sys->coefs_mutex );
 
-    deNoise(src->p[0].p_pixels, dst->p[0].p_pixels,
-            cfg->Line, &cfg->Frame[0], sys->w[0], sys->h[0],
-            src->p[0].i_pitch, dst->p[0].i_pitch,
-            cfg->Coefs[0],
-            cfg->Coefs[0],
-            cfg->Coefs[1]);
-    deNoise(src->p[1].p_pixels, dst->p[1].p_pixels,
-            cfg->Line, &cfg->Frame[1], sys->w[1], sys->h[1],
-            src->p[1].i_pitch, dst->p[1].i_pitch,
-            cfg->Coefs[2],
-            cfg->Coefs[2],
-            cfg->Coefs[3]);
-    deNoise(src->p[2].p_pixels, dst->p[2].p_pixels,
-            cfg->Line, &cfg->Frame[2], sys->w[2], sys->h[2],
-            src->p[2].i_pitch, dst->p[2].i_pitch,
-            cfg->Coefs[2],
-            cfg->Coefs[2],
-            cfg->Coefs[3]);
+    /* The spatial and temporal passes are recursive within a plane, but the
+     * three planes are independent: denoise them in parallel */
+    struct hqdn3d_task tasks[3];
+    struct vf_task work[3];
+    for (int i = 0; i < 3; i++) {
+        tasks[i] = (struct hqdn3d_task) {
+            .src     = src->p[i].p_pixels,
+            .dst     = dst->p[i].p_pixels,
+            .line    = cfg->Line[i],
+            .frame   = &cfg->Frame[i],
+            .w       = sys->w[i],
+            .h       = sys->h[i],
+            .sstride = src->p[i].i_pitch,
+            .dstride = dst->p[i].i_pitch,
+            .spat    = cfg->Coefs[i ? 2 : 0],
+            .temp    = cfg->Coefs[i ? 3 : 1],
+        };
+        work[i].run  = DenoisePlaneTask;
+        work[i].data = &tasks[i];
+    }
+    vf_workers_Run(work, 3);
 
     if(unlikely(!cfg->Frame[0] || !cfg->Frame[1] || !cfg->Frame[2]))
     {
@@ -0,0 +1,331 @@
+/*****************************************************************************
+ * roi.c : Region-of-interest mosaic video filter
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * Preamble
+ *****************************************************************************/
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <limits.h> /* INT_MAX */
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_plugin.h>
+#include <vlc_filter.h>
+#include <vlc_picture.h>
+#include "filter_picture.h"
+
+/****************************************************************************
+ * Local prototypes
+ ****************************************************************************/
+static int  OpenFilter ( filter_t * );
+
+VIDEO_FILTER_WRAPPER(Filter)
+
+#define REGIONS_TEXT N_( "Regions of interest" )
+#define REGIONS_LONGTEXT N_( \
+    "Semicolon separated list of source rectangles, each given as " \
+    "\"x,y,width,height\" in pixels. A width or height of 0 selects the " \
+    "whole picture dimension. Each region is cropped and scaled to one " \
+    "tile of the output mosaic." )
+#define TILEWIDTH_TEXT N_( "Tile width" )
+#define TILEWIDTH_LONGTEXT N_( \
+    "Width in pixels of each output tile." )
+#define TILEHEIGHT_TEXT N_( "Tile height" )
+#define TILEHEIGHT_LONGTEXT N_( \
+    "Height in pixels of each output tile." )
+#define COLS_TEXT N_( "Columns" )
+#define COLS_LONGTEXT N_( \
+    "Number of tile columns in the output picture (0 for automatic)." )
+
+#define CFG_PREFIX "roi-"
+
+#define ROI_MAX_REGIONS 64
+
+/*****************************************************************************
+ * Module descriptor
+ *****************************************************************************/
+vlc_module_begin ()
+    set_shortname( N_("ROI mosaic") )
+    set_description( N_("Region of interest mosaic video filter") )
+    set_subcategory( SUBCAT_VIDEO_VFILTER )
+
+    add_string( CFG_PREFIX "regions", "", REGIONS_TEXT, REGIONS_LONGTEXT )
+    add_integer_with_range( CFG_PREFIX "tile-width", 160, 16, INT_MAX,
+                            TILEWIDTH_TEXT, TILEWIDTH_LONGTEXT )
+    add_integer_with_range( CFG_PREFIX "tile-height", 90, 16, INT_MAX,
+                            TILEHEIGHT_TEXT, TILEHEIGHT_LONGTEXT )
+    add_integer_with_range( CFG_PREFIX "cols", 0, 0, ROI_MAX_REGIONS,
+                            COLS_TEXT, COLS_LONGTEXT )
+
+    set_callback_video_filter( OpenFilter )
+vlc_module_end ()
+
+static const char *const ppsz_filter_options[] = {
+    "regions", "tile-width", "tile-height", "cols", NULL
+};
+
+struct roi_region
+{
+    unsigned x, y, w, h;
+};
+
+typedef struct
+{
+    unsigned count;
+    unsigned cols, rows;
+    unsigned tile_w, tile_h;
+    struct roi_region region[ROI_MAX_REGIONS];
+} filter_sys_t;
+
+/*****************************************************************************
+ * ParseRegions: read the "x,y,w,h;..." region list
+ *****************************************************************************/
+static int ParseRegions( filter_t *p_filter, filter_sys_t *p_sys,
+                         const char *psz_regions )
+{
+    const video_format_t *fmt = &p_filter->fmt_in.video;
+    const char *psz = psz_regions;
+
+    p_sys->count = 0;
+    while( psz != NULL && *psz != '\0' )
+    {
+        struct roi_region r;
+
+        if( p_sys->count >= ROI_MAX_REGIONS )
+        {
+            msg_Err( p_filter, "too many regions (maximum %u)",
+                     (unsigned)ROI_MAX_REGIONS );
+            return VLC_EGENERIC;
+        }
+        if( sscanf( psz, "%u,%u,%u,%u", &r.x, &r.y, &r.w, &r.h ) != 4 )
+        {
+            msg_Err( p_filter, "invalid region specification `%s'", psz );
+            return VLC_EGENERIC;
+        }
+
+        /* Clamp to the source visible area, 0 meaning "full dimension" */
+        if( r.x >= fmt->i_visible_width || r.y >= fmt->i_visible_height )
+        {
+            msg_Err( p_filter, "region %u,%u is outside the picture",
+                     r.x, r.y );
+            return VLC_EGENERIC;
+        }
+        if( r.w == 0 || r.x + r.w > fmt->i_visible_width )
+            r.w = fmt->i_visible_width - r.x;
+        if( r.h == 0 || r.y + r.h > fmt->i_visible_height )
+            r.h = fmt->i_visible_height - r.y;
+
+        /* Keep chroma planes aligned */
+        r.x &= ~1;
+        r.y &= ~1;
+        r.w &= ~1;
+        r.h &= ~1;
+        if( r.w == 0 || r.h == 0 )
+        {
+            msg_Err( p_filter, "empty region" );
+            return VLC_EGENERIC;
+        }
+
+        p_sys->region[p_sys->count++] = r;
+
+        psz = strchr( psz, ';' );
+        if( psz != NULL )
+            psz++;
+    }
+
+    if( p_sys->count == 0 )
+    {
+        /* Default to the whole picture as a single region */
+        p_sys->region[0].x = p_sys->region[0].y = 0;
+        p_sys->region[0].w = fmt->i_visible_width & ~1;
+        p_sys->region[0].h = fmt->i_visible_height & ~1;
+        p_sys->count = 1;
+    }
+    return VLC_SUCCESS;
+}
+
+/*****************************************************************************
+ * OpenFilter
+ *****************************************************************************/
+static int OpenFilter( filter_t *p_filter )
+{
+    filter_sys_t *p_sys;
+
+    switch( p_filter->fmt_in.i_codec )
+    {
+    CASE_PLANAR_YUV
+    case VLC_CODEC_GREY:
+        break;
+    default:
+        msg_Err( p_filter, "Unsupported chroma %4.4s",
+                 (char *)&p_filter->fmt_in.i_codec );
+        return VLC_EGENERIC;
+    }
+
+    if( !p_filter->b_allow_fmt_out_change )
+    {
+        msg_Err( p_filter, "Picture format change isn't allowed" );
+        return VLC_EGENERIC;
+    }
+
+    if( !video_format_IsSameChroma( &p_filter->fmt_in.video,
+                                    &p_filter->fmt_out.video ) )
+    {
+        msg_Err( p_filter, "Input and output chromas don't match" );
+        return VLC_EGENERIC;
+    }
+
+    p_filter->p_sys = p_sys =
+        vlc_obj_malloc( VLC_OBJECT(p_filter), sizeof( *p_sys ) );
+    if( unlikely(p_sys == NULL) )
+        return VLC_ENOMEM;
+
+    config_ChainParse( p_filter, CFG_PREFIX, ppsz_filter_options,
+                       p_filter->p_cfg );
+
+    char *psz_regions = var_CreateGetNonEmptyString( p_filter,
+                                                     CFG_PREFIX "regions" );
+    int ret = ParseRegions( p_filter, p_sys, psz_regions );
+    free( psz_regions );
+    if( ret != VLC_SUCCESS )
+        return ret;
+
+    p_sys->tile_w = var_CreateGetInteger( p_filter,
+                                          CFG_PREFIX "tile-width" ) & ~1;
+    p_sys->tile_h = var_CreateGetInteger( p_filter,
+                                          CFG_PREFIX "tile-height" ) & ~1;
+
+    p_sys->cols = var_CreateGetInteger( p_filter, CFG_PREFIX "cols" );
+    if( p_sys->cols == 0 )
+        /* Roughly square grid by default */
+        while( p_sys->cols * p_sys->cols < p_sys->count )
+            p_sys->cols++;
+    if( p_sys->cols > p_sys->count )
+        p_sys->cols = p_sys->count;
+    p_sys->rows = ( p_sys->count + p_sys->cols - 1 ) / p_sys->cols;
+
+    p_filter->fmt_out.video.i_width =
+    p_filter->fmt_out.video.i_visible_width = p_sys->cols * p_sys->tile_w;
+    p_filter->fmt_out.video.i_height =
+    p_filter->fmt_out.video.i_visible_height = p_sys->rows * p_sys->tile_h;
+    p_filter->fmt_out.video.i_x_offset = 0;
+    p_filter->fmt_out.video.i_y_offset = 0;
+    p_filter->fmt_out.video.i_sar_num = 1;
+    p_filter->fmt_out.video.i_sar_den = 1;
+
+    p_filter->ops = &Filter_ops;
+
+    msg_Dbg( p_filter, "%u region(s), %ux%u tiles, %dx%d -> %dx%d",
+             p_sys->count, p_sys->cols, p_sys->rows,
+             p_filter->fmt_in.video.i_visible_width,
+             p_filter->fmt_in.video.i_visible_height,
+             p_filter->fmt_out.video.i_visible_width,
+             p_filter->fmt_out.video.i_visible_height );
+
+    return VLC_SUCCESS;
+}
+
+/*****************************************************************************
+ * ScaleLine: nearest neighbour horizontal scaling line kernel
+ *****************************************************************************/
+static void ScaleLine( uint8_t *restrict p_dst, const uint8_t *restrict p_src,
+                       unsigned i_width, unsigned i_step )
+{
+    /* 16.16 fixed point incremental source position: no per-pixel
+     * multiplication or division, and a 1:1 region degrades to a copy */
+    if( i_step == (1 << 16) )
+    {
+        memcpy( p_dst, p_src, i_width );
+        return;
+    }
+
+    unsigned acc = i_step >> 1;
+    for( unsigned x = 0; x < i_width; x++ )
+    {
+        p_dst[x] = p_src[acc >> 16];
+        acc += i_step;
+    }
+}
+
+/****************************************************************************
+ * Filter: crop and scale every region in a single pass over the source
+ ****************************************************************************/
+static void Filter( filter_t *p_filter, picture_t *p_pic, picture_t *p_outpic )
+{
+    const filter_sys_t *p_sys = p_filter->p_sys;
+    /* GREY has a single plane; its "chroma" entries are never reached */
+    static const uint8_t p_fill_color[PICTURE_PLANE_MAX] =
+        { 0x00, 0x80, 0x80, 0xff, 0x00 };
+
+    for( int i_plane = 0; i_plane < p_pic->i_planes; i_plane++ )
+    {
+        const plane_t *p_in = &p_pic->p[i_plane];
+        plane_t *p_out = &p_outpic->p[i_plane];
+
+        /* Blank the whole plane first: unused grid cells stay black */
+        if( p_sys->count < p_sys->cols * p_sys->rows )
+            memset( p_out->p_pixels, p_fill_color[i_plane],
+                    (size_t)p_out->i_pitch * p_out->i_lines );
+
+        /* Plane dimensions relative to the luma plane (chroma subsampling) */
+        const unsigned i_tile_w = ( p_sys->tile_w * p_out->i_visible_pitch )
+                                  / p_outpic->p->i_visible_pitch;
+        const unsigned i_tile_h = ( p_sys->tile_h * p_out->i_visible_lines )
+                                  / p_outpic->p->i_visible_lines;
+        if( i_tile_w == 0 || i_tile_h == 0 )
+            continue;
+
+        for( unsigned i = 0; i < p_sys->count; i++ )
+        {
+            const struct roi_region *r = &p_sys->region[i];
+            const unsigned i_sx = ( r->x * p_in->i_visible_pitch )
+                                  / p_pic->p->i_visible_pitch;
+            const unsigned i_sy = ( r->y * p_in->i_visible_lines )
+                                  / p_pic->p->i_visible_lines;
+            const unsigned i_sw = ( r->w * p_in->i_visible_pitch )
+                                  / p_pic->p->i_visible_pitch;
+            const unsigned i_sh = ( r->h * p_in->i_visible_lines )
+                                  / p_pic->p->i_visible_lines;
+            if( i_sw == 0 || i_sh == 0 )
+                continue;
+
+            const unsigned i_xstep = ( i_sw << 16 ) / i_tile_w;
+            const unsigned i_ystep = ( i_sh << 16 ) / i_tile_h;
+
+            uint8_t *p_dst = p_out->p_pixels
+                + ( i % p_sys->cols ) * i_tile_w
+                + (size_t)( i / p_sys->cols ) * i_tile_h * p_out->i_pitch;
+            const uint8_t *p_src = p_in->p_pixels
+                + i_sx + (size_t)i_sy * p_in->i_pitch;
+
+            unsigned acc = i_ystep >> 1;
+            for( unsigned y = 0; y < i_tile_h; y++ )
+            {
+                ScaleLine( p_dst, p_src + (size_t)( acc >> 16 ) * p_in->i_pitch,
+                           i_tile_w, i_xstep );
+                p_dst += p_out->i_pitch;
+                acc += i_ystep;
+            }
+        }
+    }
+}
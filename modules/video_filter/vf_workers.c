@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * vf_workers.c: shared worker pool for video filters
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_tick.h>
+#include <vlc_threads.h>
+#include <vlc_executor.h>
+#include <assert.h>
+
+#include "vf_workers.h"
+
+static vlc_mutex_t pool_lock = VLC_STATIC_MUTEX;
+static vlc_executor_t *pool = NULL;
+static unsigned pool_refs = 0;
+
+int vf_workers_Hold(void)
+{
+    vlc_mutex_lock(&pool_lock);
+    if (pool_refs == 0)
+    {
+        unsigned count = vlc_GetCPUCount();
+        if (count > VF_WORKERS_MAX_TASKS)
+            count = VF_WORKERS_MAX_TASKS;
+        pool = vlc_executor_New(count);
+        if (pool == NULL)
+        {
+            vlc_mutex_unlock(&pool_lock);
+            return VLC_ENOMEM;
+        }
+    }
+    pool_refs++;
+    vlc_mutex_unlock(&pool_lock);
+    return VLC_SUCCESS;
+}
+
+void vf_workers_Release(void)
+{
+    vlc_mutex_lock(&pool_lock);
+    assert(pool_refs > 0);
+    if (--pool_refs == 0)
+    {
+        vlc_executor_Delete(pool);
+        pool = NULL;
+    }
+    vlc_mutex_unlock(&pool_lock);
+}
+
+struct vf_completion
+{
+    vlc_mutex_t lock;
+    vlc_cond_t wait;
+    unsigned pending;
+};
+
+struct vf_job
+{
+    const struct vf_task *task;
+    struct vf_completion *completion;
+    struct vlc_runnable runnable;
+};
+
+static void vf_job_Run(void *data)
+{
+    struct vf_job *job = data;
+    struct vf_completion *completion = job->completion;
+
+    job->task->run(job->task->data);
+
+    vlc_mutex_lock(&completion->lock);
+    if (--completion->pending == 0)
+        vlc_cond_signal(&completion->wait);
+    vlc_mutex_unlock(&completion->lock);
+}
+
+void vf_workers_Run(const struct vf_task *tasks, unsigned count)
+{
+    assert(count <= VF_WORKERS_MAX_TASKS);
+    if (count == 0)
+        return;
+    assert(pool != NULL);
+
+    struct vf_completion completion;
+    vlc_mutex_init(&completion.lock);
+    vlc_cond_init(&completion.wait);
+    completion.pending = count - 1;
+
+    struct vf_job jobs[VF_WORKERS_MAX_TASKS];
+    for (unsigned i = 0; i + 1 < count; i++)
+    {
+        jobs[i].task = &tasks[i];
+        jobs[i].completion = &completion;
+        jobs[i].runnable.run = vf_job_Run;
+        jobs[i].runnable.userdata = &jobs[i];
+        vlc_executor_Submit(pool, &jobs[i].runnable);
+    }
+
+    /* Run the last task on the calling thread rather than blocking idle */
+    tasks[count - 1].run(tasks[count - 1].data);
+
+    vlc_mutex_lock(&completion.lock);
+    while (completion.pending > 0)
+        vlc_cond_wait(&completion.wait, &completion.lock);
+    vlc_mutex_unlock(&completion.lock);
+}
@@ -0,0 +1,59 @@
+/*****************************************************************************
+ * vf_workers.h: shared worker pool for video filters
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_VF_WORKERS_H
+#define VLC_VF_WORKERS_H 1
+
+/**
+ * Small worker pool shared between all filter instances of a plugin, so that
+ * every filter does not spawn its own threads. Typical use is one task per
+ * picture plane.
+ */
+
+struct vf_task
+{
+    void (*run)(void *data);
+    void *data;
+};
+
+/** Maximum number of tasks per vf_workers_Run() call */
+#define VF_WORKERS_MAX_TASKS 4
+
+/**
+ * Acquire a reference on the shared worker pool, creating it on first use.
+ *
+ * @return VLC_SUCCESS or VLC_ENOMEM
+ */
+int vf_workers_Hold(void);
+
+/**
+ * Release a reference taken with vf_workers_Hold(). The pool is torn down
+ * with the last reference.
+ */
+void vf_workers_Release(void);
+
+/**
+ * Run up to VF_WORKERS_MAX_TASKS independent tasks, in parallel when workers
+ * are available, and return once they have all completed. The last task runs
+ * on the calling thread. The caller must hold a pool reference.
+ */
+void vf_workers_Run(const struct vf_task *tasks, unsigned count);
+
+#endif
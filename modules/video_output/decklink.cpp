@@ -42,6 +42,9 @@
 #include <vlc_aout.h>
 #include <vlc_cxx_helpers.hpp>
 
+#include <atomic>
+#include <vector>
+
 #ifdef HAVE_ARPA_INET_H
 #include <arpa/inet.h>
 #endif
@@ -122,6 +125,13 @@ static const int pi_channels_maps[CHANNELS_MAX+1] =
 #define VIDEO_TENBITS_LONGTEXT N_(\
     "Use 10 bits per pixel for video frames.")
 
+#define VIDEO_PREROLL_TEXT N_("Pre-rolled frames")
+#define VIDEO_PREROLL_LONGTEXT N_(\
+    "Number of video frames to schedule ahead before starting playback. " \
+    "Pre-rolling keeps the card fed through transient scheduling hiccups, " \
+    "at the cost of the same amount of extra output latency. " \
+    "0 starts playback immediately.")
+
 #define CFG_PREFIX "decklink-output-"
 #define VIDEO_CFG_PREFIX "decklink-vout-"
 #define AUDIO_CFG_PREFIX "decklink-aout-"
@@ -184,6 +194,89 @@ static_assert(ARRAY_SIZE(rgi_ar_values) == ARRAY_SIZE(rgsz_ar_text), "afd arrays
 
 namespace {
 
+/* Scheduled frame completion callback: recycles output frames into a
+ * small pool so PrepareVideo() does not allocate one per picture, and
+ * accounts for frames the card reported as late or dropped. */
+class DeckLinkSchedulingDelegate : public IDeckLinkVideoOutputCallback
+{
+public:
+    DeckLinkSchedulingDelegate()
+    {
+        m_ref_.store(1);
+        late_.store(0);
+        dropped_.store(0);
+    }
+    virtual ~DeckLinkSchedulingDelegate()
+    {
+        for (IDeckLinkMutableVideoFrame *frame : pool_)
+            frame->Release();
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, LPVOID *) override { return E_NOINTERFACE; }
+
+    ULONG STDMETHODCALLTYPE AddRef(void) override
+    {
+        return m_ref_.fetch_add(1);
+    }
+
+    ULONG STDMETHODCALLTYPE Release(void) override
+    {
+        uintptr_t ref = m_ref_.fetch_sub(1) - 1;
+        if (ref == 0)
+            delete this;
+        return ref;
+    }
+
+    HRESULT STDMETHODCALLTYPE
+    ScheduledFrameCompleted(IDeckLinkVideoFrame *completed,
+                            BMDOutputFrameCompletionResult result) override
+    {
+        if (result == bmdOutputFrameDisplayedLate)
+            late_.fetch_add(1, std::memory_order_relaxed);
+        else if (result == bmdOutputFrameDropped)
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+
+        /* PrepareVideo() kept its reference when scheduling: recycle it */
+        IDeckLinkMutableVideoFrame *frame =
+            static_cast<IDeckLinkMutableVideoFrame *>(completed);
+        pool_lock_.lock();
+        bool keep = pool_.size() < MAX_POOLED_FRAMES;
+        if (keep)
+            pool_.push_back(frame);
+        pool_lock_.unlock();
+        if (!keep)
+            frame->Release();
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE ScheduledPlaybackHasStopped(void) override
+    {
+        return S_OK;
+    }
+
+    /* Returns a recycled frame, or NULL if none is available */
+    IDeckLinkMutableVideoFrame *GetFrame()
+    {
+        vlc::threads::mutex_locker locker(pool_lock_);
+        if (pool_.empty())
+            return NULL;
+        IDeckLinkMutableVideoFrame *frame = pool_.back();
+        pool_.pop_back();
+        return frame;
+    }
+
+    uint32_t LateCount() const { return late_.load(std::memory_order_relaxed); }
+    uint32_t DroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static const size_t MAX_POOLED_FRAMES = 8;
+    std::atomic_uint m_ref_;
+    std::atomic<uint32_t> late_;
+    std::atomic<uint32_t> dropped_;
+    vlc::threads::mutex pool_lock_;
+    std::vector<IDeckLinkMutableVideoFrame *> pool_;
+};
+
 /* Only one audio output module and one video output module
  * can be used per process.
  * We use a static mutex in audio/video submodules entry points.  */
@@ -223,6 +316,14 @@ struct decklink_sys_t
         uint8_t afd, ar;
         int nosignal_delay;
         picture_t *pic_nosignal;
+        DeckLinkSchedulingDelegate *delegate;
+        /* pre-roll: frames queued ahead before playback is started */
+        int preroll;
+        int prerolled;
+        bool started;
+        vlc_tick_t start_date;
+        /* late/dropped totals already reported to the log */
+        uint32_t reported_late, reported_dropped;
     } video;
 };
 
@@ -261,6 +362,8 @@ vlc_module_begin()
                 MODE_TEXT, MODE_LONGTEXT)
     add_bool(VIDEO_CFG_PREFIX "tenbits", true,
                 VIDEO_TENBITS_TEXT, VIDEO_TENBITS_LONGTEXT)
+    add_integer_with_range(VIDEO_CFG_PREFIX "preroll", 3, 0, 10,
+                VIDEO_PREROLL_TEXT, VIDEO_PREROLL_LONGTEXT)
     add_integer(VIDEO_CFG_PREFIX "nosignal-delay", 5,
                 NOSIGNAL_INDEX_TEXT, NOSIGNAL_INDEX_LONGTEXT)
     add_integer(VIDEO_CFG_PREFIX "afd-line", 16,
@@ -322,6 +425,7 @@ static decklink_sys_t *HoldDLSys(vlc_object_t *obj, int i_cat)
             sys->users = 1;
             sys->b_videomodule = (i_cat == VIDEO_ES);
             sys->b_recycling = false;
+            sys->video.delegate = NULL;
             sys->i_rate = var_InheritInteger(obj, AUDIO_CFG_PREFIX "audio-rate");
             if(sys->i_rate > 0)
                 sys->i_rate = -1;
@@ -351,10 +455,13 @@ static void ReleaseDLSys(vlc_object_t *obj, int i_cat)
             sys->p_output->StopScheduledPlayback(0, NULL, 0);
             sys->p_output->DisableVideoOutput();
             sys->p_output->DisableAudioOutput();
+            sys->p_output->SetScheduledFrameCompletionCallback(NULL);
             sys->p_output->Release();
         }
 
         /* Clean video specific */
+        if (sys->video.delegate)
+            sys->video.delegate->Release();
         if (sys->video.pic_nosignal)
             picture_Release(sys->video.pic_nosignal);
 
@@ -577,6 +684,10 @@ static int OpenDecklink(vout_display_t *vd, decklink_sys_t *sys, video_format_t
         result = sys->p_output->EnableVideoOutput(mode.id, flags);
         CHECK("Could not enable video output");
 
+        sys->video.delegate = new DeckLinkSchedulingDelegate();
+        result = sys->p_output->SetScheduledFrameCompletionCallback(sys->video.delegate);
+        CHECK("Could not set frame completion callback");
+
         video_format_Copy(fmt, vd->source);
         fmt->i_width = fmt->i_visible_width = p_display_mode->GetWidth();
         fmt->i_height = fmt->i_visible_height = p_display_mode->GetHeight();
@@ -599,10 +710,16 @@ static int OpenDecklink(vout_display_t *vd, decklink_sys_t *sys, video_format_t
         CHECK("Could not start audio output");
     }
 
-    /* start */
-    result = sys->p_output->StartScheduledPlayback(
-        samples_from_vlc_tick(vlc_tick_now(), sys->timescale), sys->timescale, 1.0);
-    CHECK("Could not start playback");
+    /* start, unless pre-rolling: then PrepareVideo() starts playback once
+     * enough frames have been queued against the card clock */
+    sys->video.prerolled = 0;
+    sys->video.started = (sys->video.preroll <= 0);
+    if (sys->video.started)
+    {
+        result = sys->p_output->StartScheduledPlayback(
+            samples_from_vlc_tick(vlc_tick_now(), sys->timescale), sys->timescale, 1.0);
+        CHECK("Could not start playback");
+    }
 
     p_config->Release();
     p_display_mode->Release();
@@ -673,18 +790,22 @@ static void PrepareVideo(vout_display_t *vd, picture_t *picture, const vlc_rende
 
     HRESULT result;
     int w, h, stride, length;
+    uint32_t late, dropped;
     w = vd->fmt->i_width;
     h = vd->fmt->i_height;
 
     IDeckLinkMutableVideoFrame *pDLVideoFrame;
-    result = sys->p_output->CreateVideoFrame(w, h, w*3,
-        sys->video.tenbits ? bmdFormat10BitYUV : bmdFormat8BitYUV,
-        bmdFrameFlagDefault, &pDLVideoFrame);
+    pDLVideoFrame = sys->video.delegate->GetFrame();
+    if (pDLVideoFrame == NULL) {
+        result = sys->p_output->CreateVideoFrame(w, h, w*3,
+            sys->video.tenbits ? bmdFormat10BitYUV : bmdFormat8BitYUV,
+            bmdFrameFlagDefault, &pDLVideoFrame);
 
-    if (result != S_OK) {
-        msg_Err(vd, "Failed to create video frame:0x%" PRIHR, result);
-        pDLVideoFrame = NULL;
-        goto end;
+        if (result != S_OK) {
+            msg_Err(vd, "Failed to create video frame:0x%" PRIHR, result);
+            pDLVideoFrame = NULL;
+            goto end;
+        }
     }
 
     void *frame_bytes;
@@ -742,18 +863,51 @@ static void PrepareVideo(vout_display_t *vd, picture_t *picture, const vlc_rende
         goto end;
     }
 
+    /* The frame is now owned by the completion callback, which recycles it */
+    pDLVideoFrame = NULL;
+
+    if (!sys->video.started) {
+        if (sys->video.prerolled++ == 0)
+            sys->video.start_date = date;
+        if (sys->video.prerolled < sys->video.preroll)
+            goto end;
+        /* Start the stream clock at the first queued timestamp: the card
+         * then permanently holds the pre-rolled frames ahead of output */
+        result = sys->p_output->StartScheduledPlayback(sys->video.start_date,
+                                                       CLOCK_FREQ, 1.0);
+        if (result != S_OK)
+            msg_Err(vd, "Could not start playback:0x%" PRIHR, result);
+        else
+            msg_Dbg(vd, "Pre-rolled %d frames, playback started",
+                    sys->video.prerolled);
+        sys->video.started = true;
+        goto end;
+    }
+
     now = vlc_tick_now() - sys->offset;
 
     BMDTimeValue decklink_now;
     double speed;
     sys->p_output->GetScheduledStreamTime (CLOCK_FREQ, &decklink_now, &speed);
 
-    if ((now - decklink_now) > 400000) {
+    /* the pre-rolled frames lag the stream clock behind by design */
+    if ((now - decklink_now) > 400000 +
+        (sys->video.preroll * sys->frameduration * CLOCK_FREQ) / sys->timescale) {
         /* XXX: workaround card clock drift */
         sys->offset += 50000;
         msg_Err(vd, "Delaying: offset now %" PRId64, sys->offset);
     }
 
+    late = sys->video.delegate->LateCount();
+    dropped = sys->video.delegate->DroppedCount();
+    if (late != sys->video.reported_late ||
+        dropped != sys->video.reported_dropped) {
+        msg_Warn(vd, "card reports %u late and %u dropped frames in total",
+                 late, dropped);
+        sys->video.reported_late = late;
+        sys->video.reported_dropped = dropped;
+    }
+
 end:
     if (pDLVideoFrame)
         pDLVideoFrame->Release();
@@ -801,6 +955,8 @@ static int OpenVideo(vout_display_t *vd,
         sys->video.afd = var_InheritInteger(vd, VIDEO_CFG_PREFIX "afd");
         sys->video.ar = var_InheritInteger(vd, VIDEO_CFG_PREFIX "ar");
         sys->video.pic_nosignal = NULL;
+        sys->video.preroll = var_InheritInteger(vd, VIDEO_CFG_PREFIX "preroll");
+        sys->video.reported_late = sys->video.reported_dropped = 0;
 
         if (OpenDecklink(vd, sys, fmtp) != VLC_SUCCESS)
         {
@@ -36,6 +36,7 @@
 #endif
 #include <vlc_common.h>
 #include <vlc_picture.h>
+#include <vlc_picture_pool.h>
 #include "vlc_drm.h"
 
 struct vlc_drm_buf {
@@ -182,6 +183,28 @@ picture_t *vlc_drm_dumb_alloc_fb(struct vlc_logger *log, int fd,
     return pic;
 }
 
+picture_pool_t *vlc_drm_dumb_pool(struct vlc_logger *log, int fd,
+                                  const video_format_t *restrict fmt,
+                                  unsigned count)
+{
+    picture_t *pics[count];
+
+    for (unsigned i = 0; i < count; i++) {
+        pics[i] = vlc_drm_dumb_alloc_fb(log, fd, fmt);
+        if (pics[i] == NULL) {
+            while (i > 0)
+                picture_Release(pics[--i]);
+            return NULL;
+        }
+    }
+
+    picture_pool_t *pool = picture_pool_New(count, pics);
+    if (unlikely(pool == NULL))
+        for (unsigned i = 0; i < count; i++)
+            picture_Release(pics[i]);
+    return pool;
+}
+
 uint32_t vlc_drm_dumb_get_fb_id(const picture_t *pic)
 {
     struct vlc_drm_buf *picbuf = pic->p_sys;
@@ -43,6 +43,7 @@
 #include <vlc_plugin.h>
 #include <vlc_vout_display.h>
 #include <vlc_picture.h>
+#include <vlc_picture_pool.h>
 #include <vlc_window.h>
 #include "vlc_drm.h"
 
@@ -62,9 +63,9 @@
 #define   MAXHWBUF 3
 
 typedef struct vout_display_sys_t {
-    picture_t       *buffers[MAXHWBUF];
-
-    unsigned int    front_buf;
+    picture_pool_t  *pool; /* pool of scanout-capable dumb frame buffers */
+    picture_t       *prepared; /* buffer filled by Prepare, pending display */
+    picture_t       *front; /* buffer currently being scanned out */
 /*
  * modeset information
  */
@@ -92,7 +93,11 @@ static void Prepare(vout_display_t *vd, picture_t *pic,
     VLC_UNUSED(subpic); VLC_UNUSED(date);
     vout_display_sys_t *sys = vd->sys;
 
-    picture_Copy(sys->buffers[sys->front_buf], pic);
+    assert(sys->prepared == NULL);
+    picture_t *buf = picture_pool_Wait(sys->pool);
+    if (likely(buf != NULL))
+        picture_Copy(buf, pic);
+    sys->prepared = buf;
 }
 
 static void Display(vout_display_t *vd, picture_t *picture)
@@ -101,7 +106,11 @@ static void Display(vout_display_t *vd, picture_t *picture)
     vout_display_sys_t *sys = vd->sys;
     vlc_window_t *wnd = vd->cfg->window;
     const video_format_t *fmt = vd->fmt;
-    picture_t *pic = sys->buffers[sys->front_buf];
+    picture_t *pic = sys->prepared;
+
+    if (unlikely(pic == NULL))
+        return;
+    sys->prepared = NULL;
 
     struct drm_mode_set_plane sp = {
         .plane_id = sys->plane_id,
@@ -120,12 +129,15 @@ static void Display(vout_display_t *vd, picture_t *picture)
 
     if (vlc_drm_ioctl(wnd->display.drm_fd, DRM_IOCTL_MODE_SETPLANE, &sp) < 0) {
         msg_Err(vd, "DRM plane setting error: %s", vlc_strerror_c(errno));
+        picture_Release(pic);
         return;
     }
 
-    sys->front_buf++;
-    if (sys->front_buf == MAXHWBUF)
-        sys->front_buf = 0;
+    /* The previous front buffer leaves the screen at the next page flip:
+     * recycle it through the pool */
+    if (sys->front != NULL)
+        picture_Release(sys->front);
+    sys->front = pic;
 }
 
 /**
@@ -135,8 +147,11 @@ static void Close(vout_display_t *vd)
 {
     vout_display_sys_t *sys = vd->sys;
 
-    for (size_t i = 0; i < ARRAY_SIZE(sys->buffers); i++)
-        picture_Release(sys->buffers[i]);
+    if (sys->prepared != NULL)
+        picture_Release(sys->prepared);
+    if (sys->front != NULL)
+        picture_Release(sys->front);
+    picture_pool_Release(sys->pool);
 }
 
 static const struct vlc_display_operations ops = {
@@ -219,16 +234,12 @@ static int Open(vout_display_t *vd,
     }
     fmt.i_chroma = vlc_fourcc;
 
-    for (size_t i = 0; i < ARRAY_SIZE(sys->buffers); i++) {
-        sys->buffers[i] = vlc_drm_dumb_alloc_fb(vd->obj.logger, fd, &fmt);
-        if (sys->buffers[i] == NULL) {
-            while (i > 0)
-                picture_Release(sys->buffers[--i]);
-            return -ENOBUFS;
-        }
-    }
+    sys->pool = vlc_drm_dumb_pool(vd->obj.logger, fd, &fmt, MAXHWBUF);
+    if (sys->pool == NULL)
+        return -ENOBUFS;
 
-    sys->front_buf = 0;
+    sys->prepared = NULL;
+    sys->front = NULL;
     *fmtp = fmt;
     vd->sys = sys;
     vd->ops = &ops;
@@ -69,6 +69,18 @@ picture_t *vlc_drm_dumb_alloc(struct vlc_logger *, int fd,
 picture_t *vlc_drm_dumb_alloc_fb(struct vlc_logger *, int fd,
                                  const video_format_t *restrict fmt);
 
+/**
+ * Allocates a pool of DRM dumb frame buffers.
+ *
+ * \param fd DRM device file descriptor
+ * \param fmt picture format
+ * \param count number of frame buffers to allocate
+ * \return a picture pool of DRM dumb frame buffers, or NULL on error.
+ */
+picture_pool_t *vlc_drm_dumb_pool(struct vlc_logger *, int fd,
+                                  const video_format_t *restrict fmt,
+                                  unsigned count);
+
 uint32_t vlc_drm_dumb_get_fb_id(const picture_t *pic);
 
 /**
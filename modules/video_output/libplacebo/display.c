@@ -53,6 +53,8 @@ typedef struct vout_display_sys_t
     struct pl_overlay_part *overlay_parts;
     pl_tex *overlay_tex;
     int num_overlays;
+    int64_t overlay_order; // subpicture i_order of the uploaded regions
+    int overlay_count;     // number of regions uploaded for that order
 
     // Storage for rendering parameters
     struct pl_filter_config upscaler;
@@ -103,6 +105,8 @@ static int Open(vout_display_t *vd,
     if (unlikely(sys == NULL))
         return VLC_ENOMEM;
 
+    sys->overlay_order = -1;
+
     char *name = var_InheritString(vd, "pl-gpu");
     sys->pl = vlc_placebo_Create(vd->cfg, name);
     free(name);
@@ -369,6 +373,12 @@ static void PictureRender(vout_display_t *vd, picture_t *pic,
             sys->num_overlays = num_regions;
         }
 
+        // The same subpicture may be displayed over several video frames;
+        // only re-upload the region pixels when it actually changed, the
+        // overlay geometry below is refreshed either way.
+        bool reupload = subpicture->i_order != sys->overlay_order
+                     || num_regions != sys->overlay_count;
+
         // Upload all of the regions
         int i = 0;
         vlc_vector_foreach(r, &subpicture->regions) {
@@ -377,7 +387,7 @@ static void PictureRender(vout_display_t *vd, picture_t *pic,
             if (!vlc_placebo_PlaneData(r->p_picture, subdata))
                 assert(!"Failed processing the subpicture_t into pl_plane_data!?");
 
-            if (!pl_upload_plane(gpu, NULL, &sys->overlay_tex[i], subdata)) {
+            if (reupload && !pl_upload_plane(gpu, NULL, &sys->overlay_tex[i], subdata)) {
                 msg_Err(vd, "Failed uploading subpicture region!");
                 num_regions = i; // stop here
                 break;
@@ -408,6 +418,13 @@ static void PictureRender(vout_display_t *vd, picture_t *pic,
             i++;
         }
 
+        if (i == (int) subpicture->regions.size) {
+            sys->overlay_order = subpicture->i_order;
+            sys->overlay_count = num_regions;
+        } else {
+            sys->overlay_order = -1; // retry the upload on the next frame
+        }
+
         // Update the target information to reference the subpictures
         target.overlays = sys->overlays;
         target.num_overlays = num_regions;
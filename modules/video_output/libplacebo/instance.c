@@ -61,6 +61,55 @@ static FILE *vlc_placebo_OpenCache(const char *mode)
     free(filename);
     return file;
 }
+
+/* One cache for the whole process: the tonemapping LUTs and shader variants
+ * derived by a vout (keyed by colorspace, transfer and peak inside
+ * libplacebo) stay warm for the next one, so HDR<->SDR channel zaps don't
+ * re-derive them on the render thread. The cache is created without a log,
+ * as it outlives the instance that first needed it. */
+static struct
+{
+    vlc_mutex_t lock;
+    pl_cache cache;
+    unsigned refs;
+} shared_cache = { .lock = VLC_STATIC_MUTEX };
+
+static pl_cache vlc_placebo_HoldCache(void)
+{
+    vlc_mutex_lock(&shared_cache.lock);
+    if (shared_cache.cache == NULL) {
+        shared_cache.cache = pl_cache_create(pl_cache_params(
+            .max_total_size = VLC_PL_MAX_CACHE_SIZE,
+        ));
+        if (shared_cache.cache != NULL) {
+            FILE *file = vlc_placebo_OpenCache("rb");
+            if (file) {
+                pl_cache_load_file(shared_cache.cache, file);
+                fclose(file);
+            }
+        }
+    }
+    pl_cache cache = shared_cache.cache;
+    if (cache != NULL)
+        shared_cache.refs++;
+    vlc_mutex_unlock(&shared_cache.lock);
+    return cache;
+}
+
+static void vlc_placebo_ReleaseCache(void)
+{
+    vlc_mutex_lock(&shared_cache.lock);
+    if (--shared_cache.refs == 0) {
+        /* Persist, but keep the cache in memory: the next vout reuses it
+         * without re-parsing the file. */
+        FILE *file = vlc_placebo_OpenCache("wb");
+        if (file) {
+            pl_cache_save_file(shared_cache.cache, file);
+            fclose(file);
+        }
+    }
+    vlc_mutex_unlock(&shared_cache.lock);
+}
 #endif
 
 /**
@@ -90,17 +139,10 @@ vlc_placebo_t *vlc_placebo_Create(const vout_display_cfg_t *cfg, const char *nam
         goto delete_log;
 
 #if PL_API_VER >= 320
-    pl->cache = pl_cache_create(pl_cache_params(
-        .log = pl->log,
-        .max_total_size = VLC_PL_MAX_CACHE_SIZE,
-    ));
+    pl->cache = vlc_placebo_HoldCache();
     assert(pl->gpu);
-    pl_gpu_set_cache(pl->gpu, pl->cache);
-    FILE *cache = vlc_placebo_OpenCache("rb");
-    if (cache) {
-        pl_cache_load_file(pl->cache, cache);
-        fclose(cache);
-    }
+    if (pl->cache != NULL)
+        pl_gpu_set_cache(pl->gpu, pl->cache);
 #endif
 
     return pl;
@@ -120,12 +162,9 @@ void vlc_placebo_Release(vlc_placebo_t *pl)
         pl->ops->close(pl);
 
 #if PL_API_VER >= 320
-    FILE *cache = vlc_placebo_OpenCache("wb");
-    if (cache) {
-        pl_cache_save_file(pl->cache, cache);
-        fclose(cache);
-    }
-    pl_cache_destroy(&pl->cache);
+    /* The cache is shared and process-wide, only drop the reference */
+    if (pl->cache != NULL)
+        vlc_placebo_ReleaseCache();
 #endif
 
     pl_log_destroy(&pl->log);
@@ -51,7 +51,7 @@ typedef struct vlc_placebo_t
     pl_gpu gpu;
     pl_swapchain swapchain;
 #if PL_API_VER >= 320
-    pl_cache cache;
+    pl_cache cache; // reference to the process-wide shared cache
 #endif
 
     const struct vlc_placebo_operations *ops;
@@ -71,6 +71,9 @@ vlc_module_begin ()
     add_opengl_submodule_renderer()
 vlc_module_end ()
 
+/* How long to wait at display time for the frame rendering to complete */
+#define FENCE_TIMEOUT_NS UINT64_C(100000000) /* 100 ms */
+
 typedef struct vout_display_sys_t
 {
     vout_display_opengl_t *vgl;
@@ -81,7 +84,12 @@ typedef struct vout_display_sys_t
 
     struct {
         PFNGLFLUSHPROC Flush;
+        /* Optional, all set or all NULL */
+        PFNGLFENCESYNCPROC FenceSync;
+        PFNGLDELETESYNCPROC DeleteSync;
+        PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
     } vt;
+    GLsync fence; /**< tracks the rendering of the prepared frame */
     vlc_viewpoint_t viewpoint;
 } vout_display_sys_t;
 
@@ -241,6 +249,14 @@ static int Open(vout_display_t *vd,
         goto error;
     }
 
+    /* Explicit per-frame fences, when the driver provides them */
+    sys->vt.FenceSync = vlc_gl_GetProcAddress(sys->gl, "glFenceSync");
+    sys->vt.DeleteSync = vlc_gl_GetProcAddress(sys->gl, "glDeleteSync");
+    sys->vt.ClientWaitSync = vlc_gl_GetProcAddress(sys->gl, "glClientWaitSync");
+    if (sys->vt.DeleteSync == NULL || sys->vt.ClientWaitSync == NULL)
+        sys->vt.FenceSync = NULL;
+    sys->fence = NULL;
+
     sys->vgl = vout_display_opengl_New (fmt, &spu_chromas, sys->gl,
                                         &vd->cfg->viewpoint, context);
     vlc_gl_ReleaseCurrent (sys->gl);
@@ -271,6 +287,8 @@ static void Close(vout_display_t *vd)
     vlc_gl_t *gl = sys->gl;
 
     vlc_gl_MakeCurrent (gl);
+    if (sys->fence != NULL)
+        sys->vt.DeleteSync(sys->fence);
     vout_display_opengl_Delete (sys->vgl);
     vlc_gl_ReleaseCurrent (gl);
 
@@ -298,6 +316,14 @@ static void PictureRender (vout_display_t *vd, picture_t *pic,
             sys->place_changed = false;
         }
         vout_display_opengl_Display(sys->vgl);
+        if (sys->vt.FenceSync != NULL)
+        {
+            /* Track the completion of this frame explicitly instead of
+             * relying on driver serialization at swap time */
+            if (sys->fence != NULL)
+                sys->vt.DeleteSync(sys->fence);
+            sys->fence = sys->vt.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
         sys->vt.Flush();
         vlc_gl_ReleaseCurrent (sys->gl);
         sys->is_dirty = true;
@@ -309,9 +335,26 @@ static void PictureDisplay (vout_display_t *vd, picture_t *pic)
     vout_display_sys_t *sys = vd->sys;
     VLC_UNUSED(pic);
 
+    if (!sys->is_dirty)
+        return;
+
+    /* Wait for the frame rendering to complete before queueing the swap,
+     * so that the swap enqueues a finished buffer and the next prepare
+     * overlaps the scanout of this frame instead of blocking behind it */
+    if (sys->fence != NULL && vlc_gl_MakeCurrent(sys->gl) == VLC_SUCCESS)
+    {
+        GLenum ret = sys->vt.ClientWaitSync(sys->fence,
+                                            GL_SYNC_FLUSH_COMMANDS_BIT,
+                                            FENCE_TIMEOUT_NS);
+        if (ret == GL_TIMEOUT_EXPIRED)
+            msg_Dbg(vd, "GPU did not complete the frame in time");
+        sys->vt.DeleteSync(sys->fence);
+        sys->fence = NULL;
+        vlc_gl_ReleaseCurrent(sys->gl);
+    }
+
     /* Present on screen */
-    if (sys->is_dirty)
-        vlc_gl_Swap(sys->gl);
+    vlc_gl_Swap(sys->gl);
 }
 
 static int Control (vout_display_t *vd, int query)
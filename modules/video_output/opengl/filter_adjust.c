@@ -0,0 +1,490 @@
+/*****************************************************************************
+ * filter_adjust.c: adjust/sharpen/grain OpenGL filters
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+/**
+ * GPU ports of the adjust, sharpen and grain CPU video filters.
+ *
+ * Enabling any of the CPU filters on a hardware-decoded stream forces a full
+ * GPU→CPU download through the converter chain; these equivalents run as
+ * fragment shaders inside the OpenGL filter engine instead, so opaque
+ * pictures stay on the GPU end-to-end:
+ *
+ *     ./vlc file.mkv --video-filter='opengl{filter=adjust}'
+ *     ./vlc file.mkv --video-filter='opengl{filter="sharpen:grain"}'
+ *
+ * They reuse the configuration of their CPU counterparts (contrast,
+ * brightness, hue, saturation, gamma, sharpen-sigma, grain-variance), either
+ * inherited or per instance:
+ *
+ *     ./vlc file.mkv --video-filter='opengl{filter=adjust{contrast=1.2}}'
+ *
+ * The math mirrors the CPU filters in a luma/chroma basis, up to the
+ * intermediate RGB conversion performed by the sampler.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <math.h>
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_plugin.h>
+#include <vlc_modules.h>
+#include <vlc_opengl.h>
+#include <vlc_opengl_filter.h>
+
+#include "gl_api.h"
+#include "gl_common.h"
+#include "gl_util.h"
+#include "sampler.h"
+#include "picture.h"
+
+static const char *const adjust_options[] = {
+    "contrast", "brightness", "hue", "saturation", "gamma", NULL
+};
+
+static const char *const sharpen_options[] = { "sharpen-sigma", NULL };
+
+static const char *const grain_options[] = { "grain-variance", NULL };
+
+struct sys {
+    struct vlc_gl_sampler *sampler;
+
+    GLuint program_id;
+
+    GLuint vbo;
+
+    struct {
+        GLint vertex_pos;
+        GLint tex_coords_in;
+
+        /* adjust only */
+        GLint contrast;
+        GLint brightness;
+        GLint gamma_inv;
+        GLint saturation;
+        GLint hue_cs;
+
+        /* sharpen only */
+        GLint sigma;
+        GLint texel;
+
+        /* grain only */
+        GLint amplitude;
+        GLint seed;
+    } loc;
+
+    /* sharpen only: one texel, in texture coordinates */
+    float texel[2];
+};
+
+/* The same full-quad vertex shader as the "draw" filter */
+static const char *const VERTEX_SHADER_BODY =
+    "attribute vec2 vertex_pos;\n"
+    "attribute vec2 tex_coords_in;\n"
+    "varying vec2 tex_coords;\n"
+    "void main() {\n"
+    "  gl_Position = vec4(vertex_pos, 0.0, 1.0);\n"
+    "  tex_coords = tex_coords_in;\n"
+    "}\n";
+
+static int
+DrawQuad(struct vlc_gl_filter *filter, const struct vlc_gl_picture *pic)
+{
+    struct sys *sys = filter->sys;
+
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    struct vlc_gl_sampler *sampler = sys->sampler;
+    vlc_gl_sampler_Update(sampler, pic);
+    vlc_gl_sampler_Load(sampler);
+
+    vt->BindBuffer(GL_ARRAY_BUFFER, sys->vbo);
+
+    if (pic->mtx_has_changed)
+    {
+        float coords[] = {
+            0, 1,
+            0, 0,
+            1, 1,
+            1, 0,
+        };
+
+        /* Transform coordinates in place */
+        vlc_gl_picture_ToTexCoords(pic, 4, coords, coords);
+
+        const float data[] = {
+            -1,  1, coords[0], coords[1],
+            -1, -1, coords[2], coords[3],
+             1,  1, coords[4], coords[5],
+             1, -1, coords[6], coords[7],
+        };
+        vt->BufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
+    }
+
+    const GLsizei stride = 4 * sizeof(float);
+
+    vt->EnableVertexAttribArray(sys->loc.vertex_pos);
+    vt->VertexAttribPointer(sys->loc.vertex_pos, 2, GL_FLOAT, GL_FALSE, stride,
+                            (const void *) 0);
+
+    intptr_t offset = 2 * sizeof(float);
+    vt->EnableVertexAttribArray(sys->loc.tex_coords_in);
+    vt->VertexAttribPointer(sys->loc.tex_coords_in, 2, GL_FLOAT, GL_FALSE,
+                            stride, (const void *) offset);
+
+    vt->Clear(GL_COLOR_BUFFER_BIT);
+    vt->DrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    GL_ASSERT_NOERROR(vt);
+
+    return VLC_SUCCESS;
+}
+
+static void
+Close(struct vlc_gl_filter *filter)
+{
+    struct sys *sys = filter->sys;
+
+    vlc_gl_sampler_Delete(sys->sampler);
+
+    const opengl_vtable_t *vt = &filter->api->vt;
+    vt->DeleteProgram(sys->program_id);
+    vt->DeleteBuffers(1, &sys->vbo);
+
+    free(sys);
+}
+
+/**
+ * Builds the program around \p fragment_body and fetches the locations
+ * common to all three filters.
+ */
+static int
+InitCommon(struct vlc_gl_filter *filter, const struct vlc_gl_format *glfmt,
+           const char *fragment_body)
+{
+    struct vlc_gl_sampler *sampler =
+        vlc_gl_sampler_New(filter->gl, filter->api, glfmt, false);
+    if (!sampler)
+        return VLC_EGENERIC;
+
+    struct sys *sys = filter->sys = malloc(sizeof(*sys));
+    if (!sys)
+    {
+        vlc_gl_sampler_Delete(sampler);
+        return VLC_ENOMEM;
+    }
+
+    sys->sampler = sampler;
+
+    const char *extensions = sampler->shader.extensions
+                           ? sampler->shader.extensions : "";
+
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    const char *vertex_shader[] = {
+        sampler->shader.version,
+        VERTEX_SHADER_BODY,
+    };
+    const char *fragment_shader[] = {
+        sampler->shader.version,
+        extensions,
+        sampler->shader.precision,
+        sampler->shader.body,
+        fragment_body,
+    };
+
+    GLuint program_id =
+        vlc_gl_BuildProgramCached(VLC_OBJECT(filter), filter->api,
+                                  ARRAY_SIZE(vertex_shader), vertex_shader,
+                                  ARRAY_SIZE(fragment_shader), fragment_shader);
+    if (!program_id)
+    {
+        vlc_gl_sampler_Delete(sampler);
+        free(sys);
+        return VLC_EGENERIC;
+    }
+
+    vlc_gl_sampler_FetchLocations(sampler, program_id);
+
+    sys->program_id = program_id;
+
+    sys->loc.vertex_pos = vt->GetAttribLocation(program_id, "vertex_pos");
+    assert(sys->loc.vertex_pos != -1);
+
+    sys->loc.tex_coords_in = vt->GetAttribLocation(program_id, "tex_coords_in");
+    assert(sys->loc.tex_coords_in != -1);
+
+    vt->GenBuffers(1, &sys->vbo);
+
+    return VLC_SUCCESS;
+}
+
+/*** adjust ***/
+
+static int
+DrawAdjust(struct vlc_gl_filter *filter, const struct vlc_gl_picture *pic,
+           const struct vlc_gl_input_meta *meta)
+{
+    (void) meta;
+
+    struct sys *sys = filter->sys;
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    /* Inherited per frame (like the CPU filter reloads its atomics) so that
+     * live changes from the extended settings panel are picked up. */
+    float contrast = var_InheritFloat(filter, "contrast");
+    float brightness = var_InheritFloat(filter, "brightness");
+    float hue = var_InheritFloat(filter, "hue") * (float)(M_PI / 180.);
+    float saturation = var_InheritFloat(filter, "saturation");
+    float gamma = var_InheritFloat(filter, "gamma");
+
+    vt->UseProgram(sys->program_id);
+    vt->Uniform1f(sys->loc.contrast, contrast);
+    vt->Uniform1f(sys->loc.brightness, brightness);
+    vt->Uniform1f(sys->loc.gamma_inv, 1.f / gamma);
+    vt->Uniform1f(sys->loc.saturation, saturation);
+    vt->Uniform2f(sys->loc.hue_cs, cosf(hue), sinf(hue));
+
+    return DrawQuad(filter, pic);
+}
+
+static int
+OpenAdjust(struct vlc_gl_filter *filter, const config_chain_t *config,
+           const struct vlc_gl_format *glfmt, struct vlc_gl_tex_size *size_out)
+{
+    (void) size_out;
+
+    config_ChainParse(filter, "", adjust_options, config);
+
+    /* Same transfer curve as the CPU adjust filter, applied in a (BT.709)
+     * luma/chroma basis:
+     *   y' = pow(clamp(c*y + b - 1 + (1 - c) / 2), 1/gamma)
+     *   (u', v') = saturation * rot(hue) * (u, v)
+     */
+    static const char *const FRAGMENT_SHADER_BODY =
+        "varying vec2 tex_coords;\n"
+        "uniform float contrast;\n"
+        "uniform float brightness;\n"
+        "uniform float gamma_inv;\n"
+        "uniform float saturation;\n"
+        "uniform vec2 hue_cs;\n"
+        "void main() {\n"
+        "  vec4 c = vlc_texture(tex_coords);\n"
+        "  float y = dot(c.rgb, vec3(0.2126, 0.7152, 0.0722));\n"
+        "  float u = dot(c.rgb, vec3(-0.114572, -0.385428, 0.5));\n"
+        "  float v = dot(c.rgb, vec3(0.5, -0.454153, -0.045847));\n"
+        "  y = clamp(y * contrast + brightness - 1.0\n"
+        "            + (1.0 - contrast) / 2.0, 0.0, 1.0);\n"
+        "  y = pow(y, gamma_inv);\n"
+        "  float u2 = (u * hue_cs.x + v * hue_cs.y) * saturation;\n"
+        "  float v2 = (v * hue_cs.x - u * hue_cs.y) * saturation;\n"
+        "  vec3 rgb = vec3(y + 1.5748 * v2,\n"
+        "                  y - 0.187324 * u2 - 0.468124 * v2,\n"
+        "                  y + 1.8556 * u2);\n"
+        "  gl_FragColor = vec4(clamp(rgb, 0.0, 1.0), c.a);\n"
+        "}\n";
+
+    int ret = InitCommon(filter, glfmt, FRAGMENT_SHADER_BODY);
+    if (ret != VLC_SUCCESS)
+        return ret;
+
+    struct sys *sys = filter->sys;
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    sys->loc.contrast = vt->GetUniformLocation(sys->program_id, "contrast");
+    sys->loc.brightness = vt->GetUniformLocation(sys->program_id,
+                                                 "brightness");
+    sys->loc.gamma_inv = vt->GetUniformLocation(sys->program_id, "gamma_inv");
+    sys->loc.saturation = vt->GetUniformLocation(sys->program_id,
+                                                 "saturation");
+    sys->loc.hue_cs = vt->GetUniformLocation(sys->program_id, "hue_cs");
+
+    static const struct vlc_gl_filter_ops ops = {
+        .draw = DrawAdjust,
+        .close = Close,
+    };
+    filter->ops = &ops;
+
+    return VLC_SUCCESS;
+}
+
+/*** sharpen ***/
+
+static int
+DrawSharpen(struct vlc_gl_filter *filter, const struct vlc_gl_picture *pic,
+            const struct vlc_gl_input_meta *meta)
+{
+    (void) meta;
+
+    struct sys *sys = filter->sys;
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    float sigma = var_InheritFloat(filter, "sharpen-sigma");
+
+    vt->UseProgram(sys->program_id);
+    vt->Uniform1f(sys->loc.sigma, sigma);
+    vt->Uniform2f(sys->loc.texel, sys->texel[0], sys->texel[1]);
+
+    return DrawQuad(filter, pic);
+}
+
+static int
+OpenSharpen(struct vlc_gl_filter *filter, const config_chain_t *config,
+            const struct vlc_gl_format *glfmt,
+            struct vlc_gl_tex_size *size_out)
+{
+    (void) size_out;
+
+    config_ChainParse(filter, "", sharpen_options, config);
+
+    /* Same 3×3 unsharp masking kernel as the CPU sharpen filter, applied to
+     * the luma component only to avoid amplifying chroma noise. */
+    static const char *const FRAGMENT_SHADER_BODY =
+        "varying vec2 tex_coords;\n"
+        "uniform float sigma;\n"
+        "uniform vec2 texel;\n"
+        "const vec3 to_y = vec3(0.2126, 0.7152, 0.0722);\n"
+        "void main() {\n"
+        "  vec4 c = vlc_texture(tex_coords);\n"
+        "  float acc = dot(vlc_texture(tex_coords + texel * vec2(-1.0, -1.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2( 0.0, -1.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2( 1.0, -1.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2(-1.0,  0.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2( 1.0,  0.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2(-1.0,  1.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2( 0.0,  1.0)).rgb, to_y)\n"
+        "            + dot(vlc_texture(tex_coords + texel * vec2( 1.0,  1.0)).rgb, to_y);\n"
+        "  float diff = clamp(8.0 * dot(c.rgb, to_y) - acc, -1.0, 1.0);\n"
+        "  gl_FragColor = vec4(clamp(c.rgb + vec3(diff * sigma), 0.0, 1.0), c.a);\n"
+        "}\n";
+
+    int ret = InitCommon(filter, glfmt, FRAGMENT_SHADER_BODY);
+    if (ret != VLC_SUCCESS)
+        return ret;
+
+    struct sys *sys = filter->sys;
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    sys->loc.sigma = vt->GetUniformLocation(sys->program_id, "sigma");
+    sys->loc.texel = vt->GetUniformLocation(sys->program_id, "texel");
+
+    sys->texel[0] = 1.f / glfmt->tex_widths[0];
+    sys->texel[1] = 1.f / glfmt->tex_heights[0];
+
+    static const struct vlc_gl_filter_ops ops = {
+        .draw = DrawSharpen,
+        .close = Close,
+    };
+    filter->ops = &ops;
+
+    return VLC_SUCCESS;
+}
+
+/*** grain ***/
+
+static int
+DrawGrain(struct vlc_gl_filter *filter, const struct vlc_gl_picture *pic,
+          const struct vlc_gl_input_meta *meta)
+{
+    struct sys *sys = filter->sys;
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    float variance = var_InheritFloat(filter, "grain-variance");
+
+    vt->UseProgram(sys->program_id);
+    /* The CPU grain filter adds a noise bank scaled by sqrt(variance) in
+     * 8-bit units; reproduce that amplitude in normalized components. */
+    vt->Uniform1f(sys->loc.amplitude, sqrtf(variance) / 127.f);
+    /* Re-draw the noise pattern for each picture */
+    vt->Uniform1f(sys->loc.seed,
+                  (float)((meta->pts / 1000) % 1000) / 1000.f);
+
+    return DrawQuad(filter, pic);
+}
+
+static int
+OpenGrain(struct vlc_gl_filter *filter, const config_chain_t *config,
+          const struct vlc_gl_format *glfmt, struct vlc_gl_tex_size *size_out)
+{
+    (void) size_out;
+
+    config_ChainParse(filter, "", grain_options, config);
+
+    /* Hash-based pseudo-random noise; the sum of two uniform samples gives a
+     * triangular distribution approximating the CPU filter's gaussian bank. */
+    static const char *const FRAGMENT_SHADER_BODY =
+        "varying vec2 tex_coords;\n"
+        "uniform float amplitude;\n"
+        "uniform float seed;\n"
+        "float rnd(vec2 p) {\n"
+        "  return fract(sin(dot(p, vec2(12.9898, 78.233)) + seed * 17.0)\n"
+        "               * 43758.5453);\n"
+        "}\n"
+        "void main() {\n"
+        "  vec4 c = vlc_texture(tex_coords);\n"
+        "  float noise = rnd(tex_coords) + rnd(tex_coords + vec2(0.1)) - 1.0;\n"
+        "  gl_FragColor = vec4(clamp(c.rgb + vec3(noise * amplitude),\n"
+        "                            0.0, 1.0), c.a);\n"
+        "}\n";
+
+    int ret = InitCommon(filter, glfmt, FRAGMENT_SHADER_BODY);
+    if (ret != VLC_SUCCESS)
+        return ret;
+
+    struct sys *sys = filter->sys;
+    const opengl_vtable_t *vt = &filter->api->vt;
+
+    sys->loc.amplitude = vt->GetUniformLocation(sys->program_id, "amplitude");
+    sys->loc.seed = vt->GetUniformLocation(sys->program_id, "seed");
+
+    static const struct vlc_gl_filter_ops ops = {
+        .draw = DrawGrain,
+        .close = Close,
+    };
+    filter->ops = &ops;
+
+    return VLC_SUCCESS;
+}
+
+vlc_module_begin()
+    set_shortname("adjust")
+    set_description(N_("Image properties OpenGL filter"))
+    set_subcategory(SUBCAT_VIDEO_VFILTER)
+    set_capability("opengl filter", 0)
+    set_callback_opengl_filter(OpenAdjust)
+    add_shortcut("adjust")
+
+    add_submodule()
+        set_shortname("sharpen")
+        set_description(N_("Sharpen OpenGL filter"))
+        set_capability("opengl filter", 0)
+        set_callback_opengl_filter(OpenSharpen)
+        add_shortcut("sharpen")
+
+    add_submodule()
+        set_shortname("grain")
+        set_description(N_("Grain OpenGL filter"))
+        set_capability("opengl filter", 0)
+        set_callback_opengl_filter(OpenGrain)
+        add_shortcut("grain")
+vlc_module_end()
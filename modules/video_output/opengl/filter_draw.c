@@ -185,9 +185,9 @@ Open(struct vlc_gl_filter *filter, const config_chain_t *config,
     };
 
     GLuint program_id =
-        vlc_gl_BuildProgram(VLC_OBJECT(filter), vt,
-                            ARRAY_SIZE(vertex_shader), vertex_shader,
-                            ARRAY_SIZE(fragment_shader), fragment_shader);
+        vlc_gl_BuildProgramCached(VLC_OBJECT(filter), filter->api,
+                                  ARRAY_SIZE(vertex_shader), vertex_shader,
+                                  ARRAY_SIZE(fragment_shader), fragment_shader);
     if (!program_id)
         goto error;
 
@@ -124,6 +124,10 @@ vlc_gl_api_Init(struct vlc_gl_api *api, vlc_gl_t *gl)
     GET_PROC_ADDR(UseProgram);
     GET_PROC_ADDR(DeleteProgram);
 
+    GET_PROC_ADDR_OPTIONAL(GetProgramBinary);
+    GET_PROC_ADDR_OPTIONAL(ProgramBinary);
+    GET_PROC_ADDR_OPTIONAL(ProgramParameteri);
+
     GET_PROC_ADDR(ActiveTexture);
 
     GET_PROC_ADDR(GenBuffers);
@@ -202,5 +206,17 @@ vlc_gl_api_Init(struct vlc_gl_api *api, vlc_gl_t *gl)
             api->glsl_version = 120;
     }
 
+    /* Program binaries need GL>=4.1, GLES>=3.0 or ARB_get_program_binary,
+     * and a driver exposing at least one binary format */
+    api->supports_program_binary = false;
+    if (api->vt.GetProgramBinary != NULL && api->vt.ProgramBinary != NULL
+     && ((api->is_gles && version >= 3)
+      || vlc_gl_HasExtension(&extension_vt, "GL_ARB_get_program_binary")))
+    {
+        GLint num_formats = 0;
+        api->vt.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+        api->supports_program_binary = num_formats > 0;
+    }
+
     return VLC_SUCCESS;
 }
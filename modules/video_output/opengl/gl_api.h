@@ -46,6 +46,9 @@ struct vlc_gl_api {
 
     /* Multisampling for anti-aliasing */
     bool supports_multisample;
+
+    /* glGetProgramBinary/glProgramBinary support */
+    bool supports_program_binary;
 };
 
 int
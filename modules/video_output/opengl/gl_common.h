@@ -100,6 +100,15 @@
 #ifndef GL_RG_INTEGER
 # define GL_RG_INTEGER 0x8228
 #endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+# define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+# define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+# define GL_TIMEOUT_EXPIRED 0x911B
+#endif
 #ifndef GL_RED_INTEGER
 # define GL_RED_INTEGER 0x8D94
 #endif
@@ -196,6 +205,18 @@
 # define GL_NUM_EXTENSIONS 0x821D
 #endif
 
+#if !defined(GL_PROGRAM_BINARY_LENGTH)
+# define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#if !defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+# define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+#if !defined(GL_PROGRAM_BINARY_RETRIEVABLE_HINT)
+# define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
 #ifndef APIENTRY
 # define APIENTRY
 #endif
@@ -324,6 +345,9 @@ typedef void (APIENTRY *PFNGLDELETESYNCPROC) (GLsync sync);
 typedef GLenum (APIENTRY *PFNGLCLIENTWAITSYNCPROC) (GLsync sync, GLbitfield flags, GLuint64 timeout);
 typedef void *(APIENTRY *PFNGLMAPBUFFERPROC)(GLenum, GLbitfield);
 typedef const GLubyte *(APIENTRY *PFNGLGETSTRINGIPROC) (GLenum name, GLint i);
+typedef void (APIENTRY *PFNGLGETPROGRAMBINARYPROC) (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (APIENTRY *PFNGLPROGRAMBINARYPROC) (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (APIENTRY *PFNGLPROGRAMPARAMETERIPROC) (GLuint program, GLenum pname, GLint value);
 #endif
 
 /**
@@ -403,6 +427,11 @@ typedef struct {
     PFNGLDELETEPROGRAMPROC DeleteProgram;
     PFNGLGETATTACHEDSHADERPROC GetAttachedShaders;
 
+    /* Program binary commands (GL>=4.1, GLES>=3.0 or ARB_get_program_binary) */
+    PFNGLGETPROGRAMBINARYPROC  GetProgramBinary; /* can be NULL */
+    PFNGLPROGRAMBINARYPROC     ProgramBinary; /* can be NULL */
+    PFNGLPROGRAMPARAMETERIPROC ProgramParameteri; /* can be NULL */
+
     /* Texture commands */
     PFNGLACTIVETEXTUREPROC ActiveTexture;
 
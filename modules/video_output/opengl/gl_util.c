@@ -24,10 +24,12 @@
 #endif
 
 #include "gl_util.h"
+#include "gl_api.h"
 
 #include <vlc_filter.h>
 #include <vlc_modules.h>
 #include <vlc_configuration.h>
+#include <vlc_fs.h>
 
 #include <vlc_memstream.h>
 
@@ -186,6 +188,16 @@ vlc_gl_BuildProgram(vlc_object_t *obj, const opengl_vtable_t *vt,
     vt->AttachShader(program, vertex_shader);
     vt->AttachShader(program, fragment_shader);
 
+    if (vt->ProgramParameteri != NULL && vt->GetProgramBinary != NULL)
+    {
+        /* Ask the driver to keep the compiled binary retrievable, so that it
+         * can be saved in the program binary cache after linking. */
+        vt->ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                              GL_TRUE);
+        /* The hint may be unknown to the driver, don't leave an error */
+        while (vt->GetError() != GL_NO_ERROR);
+    }
+
     vt->LinkProgram(program);
 
     LogProgramErrors(obj, vt, program);
@@ -207,6 +219,162 @@ finally_1:
     return program;
 }
 
+/* 64-bit FNV-1a, keying the program binary cache */
+static uint64_t
+HashStrings(uint64_t hash, GLsizei count, const GLchar *const *strings)
+{
+    for (GLsizei i = 0; i < count; ++i)
+        for (const GLchar *p = strings[i]; *p != '\0'; ++p)
+        {
+            hash ^= (unsigned char)*p;
+            hash *= UINT64_C(0x100000001b3);
+        }
+    return hash;
+}
+
+static GLuint
+LoadCachedProgram(const opengl_vtable_t *vt, const char *path)
+{
+    GLuint program = 0;
+    void *binary = NULL;
+    FILE *stream = vlc_fopen(path, "rb");
+    if (stream == NULL)
+        return 0;
+
+    uint32_t format;
+    long length;
+    if (fread(&format, sizeof (format), 1, stream) != 1
+     || fseek(stream, 0, SEEK_END) != 0
+     || (length = ftell(stream)) <= (long)sizeof (format))
+        goto out;
+    length -= sizeof (format);
+
+    binary = malloc(length);
+    if (binary == NULL
+     || fseek(stream, sizeof (format), SEEK_SET) != 0
+     || fread(binary, 1, length, stream) != (size_t)length)
+        goto out;
+
+    program = vt->CreateProgram();
+    if (program != 0)
+    {
+        vt->ProgramBinary(program, format, binary, length);
+        /* An unknown format raises an error, don't leave it behind */
+        while (vt->GetError() != GL_NO_ERROR);
+
+        GLint linked;
+        vt->GetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked)
+        {
+            /* Stale binary, typically after a driver update: drop it */
+            vt->DeleteProgram(program);
+            program = 0;
+            vlc_unlink(path);
+        }
+    }
+out:
+    free(binary);
+    fclose(stream);
+    return program;
+}
+
+static void
+StoreCachedProgram(const opengl_vtable_t *vt, GLuint program, const char *path)
+{
+    GLint length = 0;
+    vt->GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return; /* driver does not expose a binary for this program */
+
+    char *binary = malloc(length);
+    if (binary == NULL)
+        return;
+
+    GLsizei written = 0;
+    GLenum glformat = 0;
+    vt->GetProgramBinary(program, length, &written, &glformat, binary);
+    if (written > 0)
+    {
+        char *tmp;
+        if (asprintf(&tmp, "%s.tmp", path) != -1)
+        {
+            FILE *stream = vlc_fopen(tmp, "wb");
+            if (stream != NULL)
+            {
+                const uint32_t format = glformat;
+                bool ok = fwrite(&format, sizeof (format), 1, stream) == 1
+                       && fwrite(binary, 1, written, stream)
+                                                          == (size_t)written;
+                ok &= fclose(stream) == 0;
+                if (ok)
+                    vlc_rename(tmp, path);
+                else
+                    vlc_unlink(tmp);
+            }
+            free(tmp);
+        }
+    }
+    free(binary);
+}
+
+GLuint
+vlc_gl_BuildProgramCached(vlc_object_t *obj, const struct vlc_gl_api *api,
+                          GLsizei vstring_count, const GLchar **vstrings,
+                          GLsizei fstring_count, const GLchar **fstrings)
+{
+    const opengl_vtable_t *vt = &api->vt;
+
+    if (!api->supports_program_binary)
+        return vlc_gl_BuildProgram(obj, vt, vstring_count, vstrings,
+                                   fstring_count, fstrings);
+
+    /* Program binaries are specific to the driver (and usually its version),
+     * so key the cache on the driver identity as well as the sources. */
+    const char *renderer = (const char *)vt->GetString(GL_RENDERER);
+    const char *glversion = (const char *)vt->GetString(GL_VERSION);
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    if (renderer != NULL)
+        hash = HashStrings(hash, 1, &renderer);
+    if (glversion != NULL)
+        hash = HashStrings(hash, 1, &glversion);
+    hash = HashStrings(hash, vstring_count, vstrings);
+    hash = HashStrings(hash, fstring_count, fstrings);
+
+    char *path = NULL;
+    char *dir = config_GetUserDir(VLC_CACHE_DIR);
+    if (dir != NULL
+     && asprintf(&path, "%s" DIR_SEP "glprograms" DIR_SEP "%016" PRIx64,
+                 dir, hash) == -1)
+        path = NULL;
+
+    GLuint program = 0;
+    if (path != NULL)
+        program = LoadCachedProgram(vt, path);
+
+    if (program != 0)
+        msg_Dbg(obj, "using cached program binary %016" PRIx64, hash);
+    else
+    {
+        program = vlc_gl_BuildProgram(obj, vt, vstring_count, vstrings,
+                                      fstring_count, fstrings);
+        if (program != 0 && path != NULL)
+        {
+            char *subdir;
+            if (asprintf(&subdir, "%s" DIR_SEP "glprograms", dir) != -1)
+            {
+                vlc_mkdir(dir, 0700);
+                vlc_mkdir(subdir, 0700);
+                free(subdir);
+            }
+            StoreCachedProgram(vt, program, path);
+        }
+    }
+
+    free(path);
+    free(dir);
+    return program;
+}
+
 module_t *
 vlc_gl_WrapOpenGLFilter(filter_t *filter, const char *opengl_filter_name)
 {
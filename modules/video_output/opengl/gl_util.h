@@ -71,6 +71,21 @@ vlc_gl_BuildProgram(vlc_object_t *obj, const opengl_vtable_t *vt,
                     GLsizei vstring_count, const GLchar **vstrings,
                     GLsizei fstring_count, const GLchar **fstrings);
 
+struct vlc_gl_api;
+
+/**
+ * Build an OpenGL program, reusing a cached program binary when possible
+ *
+ * Behaves like vlc_gl_BuildProgram(), but when the API supports program
+ * binaries, the linked program is stored in a disk cache keyed by the
+ * shader sources and the driver identity, and reloaded from there on
+ * subsequent runs, skipping the (potentially slow) shader compilation.
+ */
+GLuint
+vlc_gl_BuildProgramCached(vlc_object_t *obj, const struct vlc_gl_api *api,
+                          GLsizei vstring_count, const GLchar **vstrings,
+                          GLsizei fstring_count, const GLchar **fstrings);
+
 /**
  * Wrap an OpenGL filter from a video filter
  *
@@ -247,9 +247,9 @@ opengl_link_program(struct vlc_gl_filter *filter)
            sampler->ops->load);
 
     GLuint program_id =
-        vlc_gl_BuildProgram(VLC_OBJECT(filter), vt,
-                            ARRAY_SIZE(vertex_shader), vertex_shader,
-                            ARRAY_SIZE(fragment_shader), fragment_shader);
+        vlc_gl_BuildProgramCached(VLC_OBJECT(filter), filter->api,
+                                  ARRAY_SIZE(vertex_shader), vertex_shader,
+                                  ARRAY_SIZE(fragment_shader), fragment_shader);
     if (!program_id)
         return VLC_EGENERIC;
 
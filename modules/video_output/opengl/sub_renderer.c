@@ -68,6 +68,7 @@ struct vlc_gl_sub_renderer
 
     gl_region_t *regions;
     unsigned region_count;
+    int64_t last_order; /* i_order of the last uploaded subpicture, or -1 */
     unsigned output_width, output_height;
 
     GLuint program_id;
@@ -131,6 +132,7 @@ vlc_gl_sub_renderer_New(vlc_gl_t *gl, const struct vlc_gl_api *api,
     sr->api = api;
     sr->vt = vt;
     sr->region_count = 0;
+    sr->last_order = -1;
     sr->output_width = 0;
     sr->output_height = 0;
     sr->regions = NULL;
@@ -176,9 +178,9 @@ vlc_gl_sub_renderer_New(vlc_gl_t *gl, const struct vlc_gl_api *api,
     };
 
     sr->program_id =
-        vlc_gl_BuildProgram(VLC_OBJECT(sr->gl), vt,
-                            ARRAY_SIZE(vertex_shader), vertex_shader,
-                            ARRAY_SIZE(fragment_shader), fragment_shader);
+        vlc_gl_BuildProgramCached(VLC_OBJECT(sr->gl), api,
+                                  ARRAY_SIZE(vertex_shader), vertex_shader,
+                                  ARRAY_SIZE(fragment_shader), fragment_shader);
     if (!sr->program_id)
         goto error_1;
 
@@ -226,6 +228,17 @@ vlc_gl_sub_renderer_Delete(struct vlc_gl_sub_renderer *sr)
     free(sr);
 }
 
+static void
+UpdateRegionPlace(struct vlc_gl_sub_renderer *sr, gl_region_t *glr,
+                  const struct subpicture_region_rendered *r)
+{
+    glr->alpha  = (float)r->i_alpha / 255;
+    glr->left   =  2.0 * (r->place.x                  ) / sr->output_width  - 1.0;
+    glr->top    = -2.0 * (r->place.y                  ) / sr->output_height + 1.0;
+    glr->right  =  2.0 * (r->place.x + r->place.width ) / sr->output_width  - 1.0;
+    glr->bottom = -2.0 * (r->place.y + r->place.height) / sr->output_height + 1.0;
+}
+
 void
 vlc_gl_sub_renderer_SetOutputSize(struct vlc_gl_sub_renderer *sr,
                                   unsigned width, unsigned height)
@@ -252,6 +265,36 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr,
         int count = subpicture->regions.size;
         const struct subpicture_region_rendered *r;
 
+        /* The same subpicture is usually displayed over several video frames:
+         * recycle the uploaded textures as-is and only refresh the geometry
+         * and alpha, which change on resize and fade. */
+        if (subpicture->i_order == sr->last_order
+         && (unsigned)count == sr->region_count)
+        {
+            bool match = true;
+            int i = 0;
+            vlc_vector_foreach(r, &subpicture->regions) {
+                GLsizei width  = r->p_picture->format.i_visible_width;
+                GLsizei height = r->p_picture->format.i_visible_height;
+                if (!sr->api->supports_npot) {
+                    width  = stdc_bit_ceil(r->p_picture->format.i_visible_width);
+                    height = stdc_bit_ceil(r->p_picture->format.i_visible_height);
+                }
+
+                const gl_region_t *glr = &sr->regions[i++];
+                if (!glr->texture || glr->width != width || glr->height != height) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) {
+                i = 0;
+                vlc_vector_foreach(r, &subpicture->regions)
+                    UpdateRegionPlace(sr, &sr->regions[i++], r);
+                return VLC_SUCCESS;
+            }
+        }
+
         gl_region_t *regions = calloc(count, sizeof(*regions));
         if (!regions)
             return VLC_ENOMEM;
@@ -274,11 +317,7 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr,
                 glr->tex_width  = 1.0;
                 glr->tex_height = 1.0;
             }
-            glr->alpha  = (float)r->i_alpha / 255;
-            glr->left   =  2.0 * (r->place.x                  ) / sr->output_width  - 1.0;
-            glr->top    = -2.0 * (r->place.y                  ) / sr->output_height + 1.0;
-            glr->right  =  2.0 * (r->place.x + r->place.width ) / sr->output_width  - 1.0;
-            glr->bottom = -2.0 * (r->place.y + r->place.height) / sr->output_height + 1.0;
+            UpdateRegionPlace(sr, glr, r);
 
             glr->texture = 0;
             /* Try to recycle the textures allocated by the previous
@@ -318,11 +357,16 @@ vlc_gl_sub_renderer_Prepare(struct vlc_gl_sub_renderer *sr,
                 break;
             i++;
         }
+
+        /* Remember which subpicture the textures hold; retry on the next
+         * frame if an upload failed. */
+        sr->last_order = (i == count) ? subpicture->i_order : -1;
     }
     else
     {
         sr->region_count = 0;
         sr->regions = NULL;
+        sr->last_order = -1;
     }
 
     for (int i = 0; i < last_count; i++) {
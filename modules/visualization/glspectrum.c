@@ -444,6 +444,24 @@ static void *Thread( void *p_data )
     initOpenGLScene(p_filter);
     float height[NB_BANDS] = {0};
 
+    /* Set up the FFT state and window table once for the whole run */
+    fft_state *p_state = visual_fft_init(); /* internal FFT data */
+    DEFINE_WIND_CONTEXT(wind_ctx);          /* internal window data */
+
+    if (!p_state)
+    {
+        msg_Err(p_filter,"unable to initialize FFT transform");
+        vlc_gl_ReleaseCurrent(gl);
+        return NULL;
+    }
+    if (!window_init(FFT_BUFFER_SIZE, &p_sys->wind_param, &wind_ctx))
+    {
+        msg_Err(p_filter,"unable to initialize FFT window");
+        fft_close(p_state);
+        vlc_gl_ReleaseCurrent(gl);
+        return NULL;
+    }
+
     while ((block = vlc_queue_DequeueKillable(&p_sys->queue, &p_sys->dead)))
     {
         unsigned win_width, win_height;
@@ -455,9 +473,6 @@ static void *Thread( void *p_data )
         const unsigned xscale[] = {0,1,2,3,4,5,6,7,8,11,15,20,27,
                                    36,47,62,82,107,141,184,255};
 
-        fft_state *p_state = NULL; /* internal FFT data */
-        DEFINE_WIND_CONTEXT(wind_ctx); /* internal window data */
-
         unsigned i, j;
         float p_output[FFT_BUFFER_SIZE];           /* Raw FFT Result  */
         int16_t p_buffer1[FFT_BUFFER_SIZE];        /* Buffer on which we perform
@@ -502,17 +517,6 @@ static void *Thread( void *p_data )
 
             p_buffl++; p_buffs++;
         }
-        p_state = visual_fft_init();
-        if (!p_state)
-        {
-            msg_Err(p_filter,"unable to initialize FFT transform");
-            goto release;
-        }
-        if (!window_init(FFT_BUFFER_SIZE, &p_sys->wind_param, &wind_ctx))
-        {
-            msg_Err(p_filter,"unable to initialize FFT window");
-            goto release;
-        }
         p_buffs = p_s16_buff;
         for (i = 0 ; i < FFT_BUFFER_SIZE; i++)
         {
@@ -574,10 +578,10 @@ static void *Thread( void *p_data )
         vlc_gl_Swap(gl);
 
 release:
-        window_close(&wind_ctx);
-        fft_close(p_state);
         block_Release(block);
     }
+    window_close(&wind_ctx);
+    fft_close(p_state);
     vlc_gl_ReleaseCurrent(gl);
 
     return NULL;
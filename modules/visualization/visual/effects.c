@@ -47,6 +47,42 @@
 
 #define LOG_OFFSET 0.1
 
+/*
+ * Clip a bar line intensity into the V plane palette used by the spectrum
+ * analysers.
+ */
+static uint8_t spectrum_color( int i_value )
+{
+    if( i_value - 0x0f <= 0 )
+        return 0x10;
+    return ( i_value - 0x0f < 0xff ) ? i_value - 0x0f : 0xff;
+}
+
+/*
+ * Draw one horizontal run of a spectrum bar.  All the pixels of a run share
+ * their colour, so each plane is filled with a single memset() instead of
+ * per-pixel stores.
+ */
+static void spectrum_DrawRow( picture_t *p_picture, int i_row, int i_chroma_row,
+                              int i_col, int i_width, uint8_t i_v )
+{
+    if( i_width <= 0 )
+        return;
+
+    memset( p_picture->p[0].p_pixels + i_row * p_picture->p[0].i_pitch + i_col,
+            0xff, i_width );
+
+    int i_chroma_col = i_col / 2;
+    int i_chroma_width = ( i_col + i_width - 1 ) / 2 - i_chroma_col + 1;
+
+    memset( p_picture->p[1].p_pixels +
+            i_chroma_row * p_picture->p[1].i_pitch + i_chroma_col,
+            0x00, i_chroma_width );
+    memset( p_picture->p[2].p_pixels +
+            i_chroma_row * p_picture->p[2].i_pitch + i_chroma_col,
+            i_v, i_chroma_width );
+}
+
 /*****************************************************************************
  * dummy_Run
  *****************************************************************************/
@@ -76,6 +112,10 @@ typedef struct spectrum_data
     int16_t *p_prev_s16_buff;
 
     window_param wind_param;
+
+    /* FFT state and window table, built once and reused for every frame */
+    fft_state *p_fft;
+    window_context wind_ctx;
 } spectrum_data;
 
 static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
@@ -105,9 +145,6 @@ static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
      110,115,121,130,141,152,163,174,185,200,255};
     const int *xscale;
 
-    fft_state *p_state;                 /* internal FFT data */
-    DEFINE_WIND_CONTEXT( wind_ctx );    /* internal window data */
-
     int i , j , y , k;
     int i_line;
     uint16_t p_dest[FFT_BUFFER_SIZE];     /* Adapted FFT result */
@@ -139,6 +176,28 @@ static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
         p_data->p_prev_s16_buff = NULL;
 
         window_get_param( p_aout, &p_data->wind_param );
+
+        p_data->p_fft = visual_fft_init();
+        if( !p_data->p_fft )
+        {
+            msg_Err( p_aout, "unable to initialize FFT transform" );
+            free( p_data->prev_heights );
+            free( p_data->peaks );
+            free( p_data );
+            p_effect->p_data = NULL;
+            return -1;
+        }
+        if( !window_init( FFT_BUFFER_SIZE, &p_data->wind_param,
+                          &p_data->wind_ctx ) )
+        {
+            msg_Err( p_aout, "unable to initialize FFT window" );
+            fft_close( p_data->p_fft );
+            free( p_data->prev_heights );
+            free( p_data->peaks );
+            free( p_data );
+            p_effect->p_data = NULL;
+            return -1;
+        }
     }
     peaks = (int *)p_data->peaks;
     prev_heights = (int *)p_data->prev_heights;
@@ -187,20 +246,6 @@ static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
 
         p_buffl++ ; p_buffs++ ;
     }
-    p_state  = visual_fft_init();
-    if( !p_state)
-    {
-        free( height );
-        msg_Err(p_aout,"unable to initialize FFT transform");
-        return -1;
-    }
-    if( !window_init( FFT_BUFFER_SIZE, &p_data->wind_param, &wind_ctx ) )
-    {
-        fft_close( p_state );
-        free( height );
-        msg_Err(p_aout,"unable to initialize FFT window");
-        return -1;
-    }
     p_buffs = p_s16_buff;
     for ( i = 0 ; i < FFT_BUFFER_SIZE ; i++)
     {
@@ -212,8 +257,8 @@ static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
             p_buffs = p_s16_buff;
 
     }
-    window_scale_in_place( p_buffer1, &wind_ctx );
-    fft_perform( p_buffer1, p_output, p_state);
+    window_scale_in_place( p_buffer1, &p_data->wind_ctx );
+    fft_perform( p_buffer1, p_output, p_data->p_fft );
     for( i = 0; i< FFT_BUFFER_SIZE ; i++ )
     {
         /* Scale the output between 0 and UINT16MAX */
@@ -276,47 +321,15 @@ static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
                 peaks[i] = p_effect->i_height - 2;
             i_line = peaks[i];
 
-            for( j = 0; j < i_band_width - 1; j++ )
+            /* Draw the peak */
+            for( k = 0; k < 3; k ++ )
             {
-               for( k = 0; k < 3; k ++ )
-               {
-                   /* Draw the peak */
-                   *(p_picture->p[0].p_pixels +
-                    ( p_effect->i_height - i_line -1 -k ) *
-                     p_picture->p[0].i_pitch +
-                     ( i_start + i_band_width*i + j ) )
-                                    = 0xff;
-
-                   *(p_picture->p[1].p_pixels +
-                    ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                     p_picture->p[1].i_pitch +
-                     ( ( i_start + i_band_width * i + j ) /2  ) )
-                                    = 0x00;
-
-                   if( i_line + k - 0x0f > 0 )
-                   {
-                       if ( i_line + k - 0x0f < 0xff )
-                           *(p_picture->p[2].p_pixels  +
-                            ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                             p_picture->p[2].i_pitch +
-                             ( ( i_start + i_band_width * i + j ) /2  ) )
-                                    = ( i_line + k ) - 0x0f;
-                       else
-                           *(p_picture->p[2].p_pixels  +
-                            ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                             p_picture->p[2].i_pitch +
-                             ( ( i_start + i_band_width * i + j ) /2  ) )
-                                    = 0xff;
-                   }
-                   else
-                   {
-                        *(p_picture->p[2].p_pixels  +
-                         ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                         p_picture->p[2].i_pitch +
-                         ( ( i_start + i_band_width * i + j ) /2  ) )
-                               = 0x10 ;
-                   }
-               }
+                spectrum_DrawRow( p_picture,
+                                  p_effect->i_height - i_line - 1 - k,
+                                  ( p_effect->i_height - i_line ) / 2 - 1 - k/2,
+                                  i_start + i_band_width * i,
+                                  i_band_width - 1,
+                                  spectrum_color( i_line + k ) );
             }
         }
 
@@ -325,49 +338,15 @@ static int spectrum_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
 
         for( i_line = 0; i_line < height[i]; i_line++ )
         {
-            for( j = 0 ; j < i_band_width - 1; j++)
-            {
-               *(p_picture->p[0].p_pixels +
-                 (p_effect->i_height - i_line - 1) *
-                  p_picture->p[0].i_pitch +
-                  ( i_start + i_band_width*i + j ) ) = 0xff;
-
-               *(p_picture->p[1].p_pixels +
-                 ( ( p_effect->i_height - i_line ) / 2 - 1) *
-                 p_picture->p[1].i_pitch +
-                 ( ( i_start + i_band_width * i + j ) /2  ) ) = 0x00;
-
-               if( i_line - 0x0f > 0 )
-               {
-                    if( i_line - 0x0f < 0xff )
-                         *(p_picture->p[2].p_pixels  +
-                           ( ( p_effect->i_height - i_line ) / 2 - 1) *
-                           p_picture->p[2].i_pitch +
-                           ( ( i_start + i_band_width * i + j ) /2  ) ) =
-                               i_line - 0x0f;
-                    else
-                         *(p_picture->p[2].p_pixels  +
-                           ( ( p_effect->i_height - i_line ) / 2  - 1) *
-                           p_picture->p[2].i_pitch +
-                           ( ( i_start + i_band_width * i + j ) /2  ) ) =
-                                       0xff;
-               }
-               else
-               {
-                    *(p_picture->p[2].p_pixels  +
-                      ( ( p_effect->i_height - i_line ) / 2  - 1) *
-                      p_picture->p[2].i_pitch +
-                      ( ( i_start + i_band_width * i + j ) /2  ) ) =
-                            0x10;
-               }
-            }
+            spectrum_DrawRow( p_picture,
+                              p_effect->i_height - i_line - 1,
+                              ( p_effect->i_height - i_line ) / 2 - 1,
+                              i_start + i_band_width * i,
+                              i_band_width - 1,
+                              spectrum_color( i_line ) );
         }
     }
 
-    window_close( &wind_ctx );
-
-    fft_close( p_state );
-
     free( height );
 
     return 0;
@@ -379,6 +358,8 @@ static void spectrum_Free( void *data )
 
     if( p_data != NULL )
     {
+        window_close( &p_data->wind_ctx );
+        fft_close( p_data->p_fft );
         free( p_data->peaks );
         free( p_data->prev_heights );
         free( p_data->p_prev_s16_buff );
@@ -398,6 +379,10 @@ typedef struct
     int16_t *p_prev_s16_buff;
 
     window_param wind_param;
+
+    /* FFT state and window table, built once and reused for every frame */
+    fft_state *p_fft;
+    window_context wind_ctx;
 } spectrometer_data;
 
 static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
@@ -447,9 +432,6 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
     const int *xscale;
     const double y_scale =  3.60673760222;  /* (log 256) */
 
-    fft_state *p_state;                 /* internal FFT data */
-    DEFINE_WIND_CONTEXT( wind_ctx );    /* internal window data */
-
     int i , j , k;
     int i_line = 0;
     uint16_t p_dest[FFT_BUFFER_SIZE];     /* Adapted FFT result */
@@ -482,6 +464,24 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
         p_data->i_prev_nb_samples = 0;
         p_data->p_prev_s16_buff = NULL;
         window_get_param( p_aout, &p_data->wind_param );
+
+        p_data->p_fft = visual_fft_init();
+        if( !p_data->p_fft )
+        {
+            msg_Err( p_aout, "unable to initialize FFT transform" );
+            free( p_data->peaks );
+            free( p_data );
+            return -1;
+        }
+        if( !window_init( FFT_BUFFER_SIZE, &p_data->wind_param,
+                          &p_data->wind_ctx ) )
+        {
+            msg_Err( p_aout, "unable to initialize FFT window" );
+            fft_close( p_data->p_fft );
+            free( p_data->peaks );
+            free( p_data );
+            return -1;
+        }
         p_effect->p_data = (void*)p_data;
     }
     peaks = p_data->peaks;
@@ -539,20 +539,6 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
 
         p_buffl++ ; p_buffs++ ;
     }
-    p_state  = visual_fft_init();
-    if( !p_state)
-    {
-        msg_Err(p_aout,"unable to initialize FFT transform");
-        free( height );
-        return -1;
-    }
-    if( !window_init( FFT_BUFFER_SIZE, &p_data->wind_param, &wind_ctx ) )
-    {
-        fft_close( p_state );
-        free( height );
-        msg_Err(p_aout,"unable to initialize FFT window");
-        return -1;
-    }
     p_buffs = p_s16_buff;
     for ( i = 0 ; i < FFT_BUFFER_SIZE; i++)
     {
@@ -563,8 +549,8 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
         if( p_buffs >= &p_s16_buff[p_buffer->i_nb_samples * p_effect->i_nb_chans] )
             p_buffs = p_s16_buff;
     }
-    window_scale_in_place( p_buffer1, &wind_ctx );
-    fft_perform( p_buffer1, p_output, p_state);
+    window_scale_in_place( p_buffer1, &p_data->wind_ctx );
+    fft_perform( p_buffer1, p_output, p_data->p_fft );
     for(i = 0; i < FFT_BUFFER_SIZE; i++)
     {
         int sqrti = sqrt(p_output[i]);
@@ -623,46 +609,15 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
                 peaks[i] = p_effect->i_height - 2;
             i_line = peaks[i];
 
-            for( j = 0 ; j< i_band_width - i_separ; j++)
+            /* Draw the peak */
+            for( k = 0 ; k< 3 ; k ++)
             {
-               for( k = 0 ; k< 3 ; k ++)
-               {
-                   //* Draw the peak
-                     *(p_picture->p[0].p_pixels +
-                    (p_effect->i_height - i_line -1 -k ) *
-                     p_picture->p[0].i_pitch + (i_band_width*i +j) )
-                                    = 0xff;
-
-                    *(p_picture->p[1].p_pixels +
-                     ( ( p_effect->i_height - i_line ) / 2 -1 -k/2 ) *
-                     p_picture->p[1].i_pitch +
-                    ( ( i_band_width * i + j ) /2  ) )
-                                    = 0x00;
-
-                   if( 0x04 * (i_line + k ) - 0x0f > 0 )
-                   {
-                       if ( 0x04 * (i_line + k ) -0x0f < 0xff)
-                           *(p_picture->p[2].p_pixels  +
-                            ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                             p_picture->p[2].i_pitch +
-                             ( ( i_band_width * i + j ) /2  ) )
-                                    = ( 0x04 * ( i_line + k ) ) -0x0f ;
-                       else
-                           *(p_picture->p[2].p_pixels  +
-                            ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                             p_picture->p[2].i_pitch +
-                             ( ( i_band_width * i + j ) /2  ) )
-                                    = 0xff;
-                   }
-                   else
-                   {
-                        *(p_picture->p[2].p_pixels  +
-                         ( ( p_effect->i_height - i_line ) / 2 - 1 -k/2 ) *
-                         p_picture->p[2].i_pitch +
-                         ( ( i_band_width * i + j ) /2  ) )
-                               = 0x10 ;
-                   }
-               }
+                spectrum_DrawRow( p_picture,
+                                  p_effect->i_height - i_line - 1 - k,
+                                  ( p_effect->i_height - i_line ) / 2 - 1 - k/2,
+                                  i_band_width * i,
+                                  i_band_width - i_separ,
+                                  spectrum_color( 0x04 * ( i_line + k ) ) );
             }
         }
         if(height[i] * i_amp > p_effect->i_height)
@@ -670,41 +625,12 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
 
         for(i_line = 0 ; i_line < i_amp * height[i]; i_line ++ )
         {
-            for( j = 0 ; j< i_band_width - i_separ ; j++)
-            {
-               *(p_picture->p[0].p_pixels +
-                 (p_effect->i_height - i_line -1) *
-                  p_picture->p[0].i_pitch + (i_band_width*i +j) ) = 0xff;
-
-                *(p_picture->p[1].p_pixels +
-                 ( ( p_effect->i_height - i_line ) / 2 -1) *
-                 p_picture->p[1].i_pitch +
-                 ( ( i_band_width * i + j ) /2  ) ) = 0x00;
-
-               if( 0x04 * i_line - 0x0f > 0 )
-               {
-                    if( 0x04 * i_line - 0x0f < 0xff )
-                         *(p_picture->p[2].p_pixels  +
-                          ( ( p_effect->i_height - i_line ) / 2 - 1) *
-                           p_picture->p[2].i_pitch +
-                           ( ( i_band_width * i + j ) /2  ) ) =
-                               ( 0x04 * i_line) -0x0f ;
-                    else
-                         *(p_picture->p[2].p_pixels  +
-                          ( ( p_effect->i_height - i_line ) / 2 - 1) *
-                           p_picture->p[2].i_pitch +
-                           ( ( i_band_width * i + j ) /2  ) ) =
-                                       0xff;
-               }
-               else
-               {
-                    *(p_picture->p[2].p_pixels  +
-                     ( ( p_effect->i_height - i_line ) / 2 - 1) *
-                     p_picture->p[2].i_pitch +
-                     ( ( i_band_width * i + j ) /2  ) ) =
-                            0x10 ;
-               }
-            }
+            spectrum_DrawRow( p_picture,
+                              p_effect->i_height - i_line - 1,
+                              ( p_effect->i_height - i_line ) / 2 - 1,
+                              i_band_width * i,
+                              i_band_width - i_separ,
+                              spectrum_color( 0x04 * i_line ) );
         }
         }
     }
@@ -861,10 +787,6 @@ static int spectrometer_Run(visual_effect_t * p_effect, vlc_object_t *p_aout,
         }
     }
 
-    window_close( &wind_ctx );
-
-    fft_close( p_state );
-
     free( height );
 
     return 0;
@@ -876,6 +798,8 @@ static void spectrometer_Free( void *data )
 
     if( p_data != NULL )
     {
+        window_close( &p_data->wind_ctx );
+        fft_close( p_data->p_fft );
         free( p_data->peaks );
         free( p_data->p_prev_s16_buff );
         free( p_data );
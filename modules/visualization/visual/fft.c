@@ -40,7 +40,7 @@
 static void fft_prepare(const sound_sample *input, float * re, float * im,
                         const unsigned int *bitReverse);
 static void fft_calculate(float * re, float * im,
-                          const float *costable, const float *sintable );
+                          const float *twiddle_re, const float *twiddle_im );
 static void fft_output(const float *re, const float *im, float *output);
 static int reverseBits(unsigned int initial);
 
@@ -67,11 +67,15 @@ fft_state *visual_fft_init(void)
     {
         p_state->bitReverse[i] = reverseBits(i);
     }
-    for(i = 0; i < FFT_BUFFER_SIZE / 2; i++)
+    for(i = 1; i < FFT_BUFFER_SIZE; i <<= 1)
     {
-        float j = 2 * PI * i / FFT_BUFFER_SIZE;
-        p_state->costable[i] = cos(j);
-        p_state->sintable[i] = sin(j);
+        unsigned int j;
+        for(j = 0; j < i; j++)
+        {
+            double a = PI * j / i;
+            p_state->twiddle_re[i - 1 + j] = cos(a);
+            p_state->twiddle_im[i - 1 + j] = sin(a);
+        }
     }
 
     return p_state;
@@ -91,7 +95,8 @@ void fft_perform(const sound_sample *input, float *output, fft_state *state) {
     fft_prepare(input, state->real, state->imag, state->bitReverse );
 
     /* Do the actual FFT */
-    fft_calculate(state->real, state->imag, state->costable, state->sintable);
+    fft_calculate(state->real, state->imag,
+                  state->twiddle_re, state->twiddle_im);
 
     /* Convert the FFT output into intensities */
     fft_output(state->real, state->imag, output);
@@ -151,46 +156,38 @@ static void fft_output(const float * re, const float * im, float *output)
 /*
  * Actually perform the FFT
  */
-static void fft_calculate(float * re, float * im, const float *costable, const float *sintable )
+static void fft_calculate(float * re, float * im,
+                          const float *twiddle_re, const float *twiddle_im )
 {
     unsigned int i, j, k;
     unsigned int exchanges;
-    float fact_real, fact_imag;
     float tmp_real, tmp_imag;
-    unsigned int factfact;
 
     /* Set up some variables to reduce calculation in the loops */
     exchanges = 1;
-    factfact = FFT_BUFFER_SIZE / 2;
 
     /* Loop through the divide and conquer steps */
     for(i = FFT_BUFFER_SIZE_LOG; i != 0; i--) {
-        /* In this step, we have 2 ^ (i - 1) exchange groups, each with
-         * 2 ^ (FFT_BUFFER_SIZE_LOG - i) exchanges
-         */
-        /* Loop through the exchanges in a group */
-        for(j = 0; j != exchanges; j++) {
-            /* Work out factor for this exchange
-             * factor ^ (exchanges) = -1
-             * So, real = cos(j * PI / exchanges),
-             *     imag = sin(j * PI / exchanges)
-             */
-            fact_real = costable[j * factfact];
-            fact_imag = sintable[j * factfact];
-
-            /* Loop through all the exchange groups */
-            for(k = j; k < FFT_BUFFER_SIZE; k += exchanges << 1) {
-                int k1 = k + exchanges;
-                tmp_real = fact_real * re[k1] - fact_imag * im[k1];
-                tmp_imag = fact_real * im[k1] + fact_imag * re[k1];
-                re[k1] = re[k] - tmp_real;
-                im[k1] = im[k] - tmp_imag;
-                re[k]  += tmp_real;
-                im[k]  += tmp_imag;
+        /* In this step, we have 2 ^ (i - 1) groups of 2 ^
+         * (FFT_BUFFER_SIZE_LOG - i) butterflies each. The butterflies of a
+         * group are contiguous and read contiguous twiddle factors, so
+         * everything below runs with unit stride and vectorizes. */
+        const float *tw_re = twiddle_re + exchanges - 1;
+        const float *tw_im = twiddle_im + exchanges - 1;
+
+        for(k = 0; k < FFT_BUFFER_SIZE; k += exchanges << 1) {
+            for(j = 0; j != exchanges; j++) {
+                unsigned int k0 = k + j;
+                unsigned int k1 = k0 + exchanges;
+                tmp_real = tw_re[j] * re[k1] - tw_im[j] * im[k1];
+                tmp_imag = tw_re[j] * im[k1] + tw_im[j] * re[k1];
+                re[k1] = re[k0] - tmp_real;
+                im[k1] = im[k0] - tmp_imag;
+                re[k0] += tmp_real;
+                im[k0] += tmp_imag;
             }
         }
         exchanges <<= 1;
-        factfact >>= 1;
     }
 }
 
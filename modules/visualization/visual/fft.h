@@ -43,10 +43,12 @@ struct _struct_fft_state {
      /* */
      unsigned int bitReverse[FFT_BUFFER_SIZE];
 
-     /* The next two tables could be made to use less space in memory, since they
-      * overlap hugely, but hey. */
-     float sintable[FFT_BUFFER_SIZE / 2];
-     float costable[FFT_BUFFER_SIZE / 2];
+     /* Twiddle factors, packed per stage: the stage pairing elements
+      * "exchanges" apart starts at index (exchanges - 1) and holds
+      * "exchanges" contiguous entries, so the butterfly loop reads them
+      * with unit stride and the compiler can vectorize it. */
+     float twiddle_re[FFT_BUFFER_SIZE];
+     float twiddle_im[FFT_BUFFER_SIZE];
 };
 
 /* FFT prototypes */
@@ -65,6 +65,9 @@ struct vlc_aout_stream
         float rate; /**< Play-out speed rate */
         vlc_tick_t resamp_start_drift; /**< Resampler drift absolute value */
         int resamp_type; /**< Resampler mode (FIXME: redundant / resampling) */
+        int resamp_step; /**< Resampler adjustment per buffer (Hz) */
+        vlc_tick_t drift_avg; /**< Smoothed drift, for proactive correction */
+        bool low_water; /**< Output queue below the underrun low-water mark */
         bool played;
         vlc_tick_t request_delay;
         vlc_tick_t delay;
@@ -72,10 +75,12 @@ struct vlc_aout_stream
 
     struct
     {
-        vlc_mutex_t lock; /* Guard first_pts, last_drift, rate_system_ts,
-                             rate_audio_ts, system_ts, audio_ts */
+        vlc_mutex_t lock; /* Serialize the writers: rate_system_ts,
+                             rate_audio_ts and the (system_ts, audio_ts)
+                             point. The decoder thread reads the point
+                             without the lock, via the sequence counter. */
 
-        vlc_tick_t last_drift;
+        _Atomic vlc_tick_t last_drift;
 
         vlc_tick_t first_pts;
         int64_t played_samples; /* Used for stream_GetDelay() emulation */
@@ -83,8 +88,14 @@ struct vlc_aout_stream
         vlc_tick_t rate_system_ts;
         vlc_tick_t rate_audio_ts;
 
-        vlc_tick_t system_ts;
-        vlc_tick_t audio_ts;
+        /* Last timing point, published with a sequence lock: the counter is
+         * odd while a writer updates the pair, and changes across a
+         * complete update. Readers retry instead of blocking, so the
+         * per-block timing queries of the decoder thread never contend with
+         * the output timing reports or with pause/rate control. */
+        atomic_uint seq;
+        _Atomic vlc_tick_t system_ts;
+        _Atomic vlc_tick_t audio_ts;
 
         vlc_tick_t pause_date;
         float rate;
@@ -110,6 +121,7 @@ struct vlc_aout_stream
 
     atomic_uint buffers_lost;
     atomic_uint buffers_played;
+    atomic_uint underruns_predicted;
 };
 
 static inline aout_owner_t *aout_stream_owner(vlc_aout_stream *stream)
@@ -128,6 +140,48 @@ static inline struct vlc_tracer *aout_stream_tracer(vlc_aout_stream *stream)
         vlc_object_get_tracer(VLC_OBJECT(aout_stream_aout(stream)));
 }
 
+/**
+ * Publishes a new timing point. The timing lock must be held.
+ */
+static void stream_TimingPublish(vlc_aout_stream *stream,
+                                 vlc_tick_t system_ts, vlc_tick_t audio_ts)
+{
+    atomic_fetch_add_explicit(&stream->timing.seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&stream->timing.system_ts, system_ts,
+                          memory_order_relaxed);
+    atomic_store_explicit(&stream->timing.audio_ts, audio_ts,
+                          memory_order_relaxed);
+    atomic_fetch_add_explicit(&stream->timing.seq, 1, memory_order_release);
+}
+
+/**
+ * Fetches a consistent snapshot of the last timing point, without blocking.
+ *
+ * \return false if no timing point has been reported yet
+ */
+static bool stream_TimingFetch(vlc_aout_stream *stream,
+                               vlc_tick_t *system_ts, vlc_tick_t *audio_ts)
+{
+    for (;;)
+    {
+        unsigned seq = atomic_load_explicit(&stream->timing.seq,
+                                            memory_order_acquire);
+        if (seq & 1)
+            continue; /* a writer is in the middle of an update */
+
+        *system_ts = atomic_load_explicit(&stream->timing.system_ts,
+                                          memory_order_relaxed);
+        *audio_ts = atomic_load_explicit(&stream->timing.audio_ts,
+                                         memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&stream->timing.seq,
+                                 memory_order_relaxed) == seq)
+            return *system_ts != VLC_TICK_INVALID;
+    }
+}
+
 static int stream_GetDelay(vlc_aout_stream *stream, vlc_tick_t *delay)
 {
     audio_output_t *aout = aout_stream_aout(stream);
@@ -135,15 +189,9 @@ static int stream_GetDelay(vlc_aout_stream *stream, vlc_tick_t *delay)
     if (aout->time_get != NULL)
         return aout->time_get(aout, delay);
 
-    vlc_mutex_lock(&stream->timing.lock);
-    vlc_tick_t system_ts = stream->timing.system_ts;
-    vlc_tick_t audio_ts = stream->timing.audio_ts;
-    if (system_ts == VLC_TICK_INVALID)
-    {
-        vlc_mutex_unlock(&stream->timing.lock);
+    vlc_tick_t system_ts, audio_ts;
+    if (!stream_TimingFetch(stream, &system_ts, &audio_ts))
         return -1;
-    }
-    vlc_mutex_unlock(&stream->timing.lock);
 
     /* Interpolate the last updated point. */
     vlc_tick_t system_now = vlc_tick_now();
@@ -276,12 +324,14 @@ static int stream_HandleDiscontinuity(vlc_aout_stream *stream, block_t *block)
 static void stream_ResetTimings(vlc_aout_stream *stream)
 {
     stream->sync.played = false;
+    stream->sync.low_water = false;
 
-    vlc_mutex_lock(&stream->timing.lock);
     stream->timing.first_pts = VLC_TICK_INVALID;
-    stream->timing.last_drift = VLC_TICK_INVALID;
-    stream->timing.system_ts = VLC_TICK_INVALID;
-    stream->timing.audio_ts = VLC_TICK_INVALID;
+    atomic_store_explicit(&stream->timing.last_drift, VLC_TICK_INVALID,
+                          memory_order_relaxed);
+
+    vlc_mutex_lock(&stream->timing.lock);
+    stream_TimingPublish(stream, VLC_TICK_INVALID, VLC_TICK_INVALID);
     vlc_mutex_unlock(&stream->timing.lock);
 
     stream->timing.pause_date = VLC_TICK_INVALID;
@@ -396,9 +446,15 @@ vlc_aout_stream * vlc_aout_stream_New(audio_output_t *p_aout,
     stream->timing.rate = 1.f;
 
     vlc_mutex_init(&stream->timing.lock);
+    atomic_init(&stream->timing.seq, 0);
+    atomic_init(&stream->timing.last_drift, VLC_TICK_INVALID);
+    atomic_init(&stream->timing.system_ts, VLC_TICK_INVALID);
+    atomic_init(&stream->timing.audio_ts, VLC_TICK_INVALID);
 
     stream->sync.rate = 1.f;
     stream->sync.resamp_type = AOUT_RESAMPLING_NONE;
+    stream->sync.resamp_step = 0;
+    stream->sync.drift_avg = 0;
     stream->sync.delay = stream->sync.request_delay = 0;
 
     stream->discontinuity.draining = false;
@@ -406,6 +462,7 @@ vlc_aout_stream * vlc_aout_stream_New(audio_output_t *p_aout,
 
     atomic_init (&stream->buffers_lost, 0);
     atomic_init (&stream->buffers_played, 0);
+    atomic_init (&stream->underruns_predicted, 0);
     atomic_store_explicit(&owner->vp.update, true, memory_order_relaxed);
 
     atomic_init(&stream->drained, false);
@@ -470,6 +527,12 @@ void vlc_aout_stream_Delete (vlc_aout_stream *stream)
     if (stream->discontinuity.draining)
         stream_ResetDiscontinuity(stream);
 
+    unsigned underruns = atomic_load_explicit(&stream->underruns_predicted,
+                                              memory_order_relaxed);
+    if (underruns > 0)
+        msg_Dbg(aout, "output ran below the low-water mark %u times",
+                underruns);
+
     free(stream);
 }
 
@@ -523,6 +586,7 @@ static int stream_CheckReady (vlc_aout_stream *stream)
 
         msg_Dbg (aout, "restarting filters...");
         stream->sync.resamp_type = AOUT_RESAMPLING_NONE;
+        stream->sync.drift_avg = 0;
 
         if (stream->mixer_format.i_format && !owner->bitexact)
         {
@@ -569,6 +633,7 @@ static void stream_StopResampling(vlc_aout_stream *stream)
     assert(stream->filters);
 
     stream->sync.resamp_type = AOUT_RESAMPLING_NONE;
+    stream->sync.drift_avg = 0;
     aout_FiltersAdjustResampling (stream->filters, 0);
 }
 
@@ -670,6 +735,12 @@ static void stream_HandleDrift(vlc_aout_stream *stream, vlc_tick_t drift,
     if (!aout_FiltersCanResample(stream->filters))
         return;
 
+    /* Instantaneous drift measurements are dominated by the output callback
+     * jitter of bursty devices (e.g. USB DACs). The running average filters
+     * that jitter out and exposes the underlying trend long before any
+     * single measurement crosses the reactive thresholds. */
+    stream->sync.drift_avg = (stream->sync.drift_avg * 7 + drift) / 8;
+
     /* Resampling */
     if (drift > +AOUT_MAX_PTS_DELAY
      && stream->sync.resamp_type != AOUT_RESAMPLING_UP)
@@ -679,6 +750,7 @@ static void stream_HandleDrift(vlc_aout_stream *stream, vlc_tick_t drift,
         msg_Warn (aout, "playback too late (%"PRId64"): up-sampling",
                   drift);
         stream->sync.resamp_type = AOUT_RESAMPLING_UP;
+        stream->sync.resamp_step = 2;
         stream->sync.resamp_start_drift = +drift;
     }
     if (drift < -AOUT_MAX_PTS_ADVANCE
@@ -689,11 +761,38 @@ static void stream_HandleDrift(vlc_aout_stream *stream, vlc_tick_t drift,
         msg_Warn (aout, "playback too early (%"PRId64"): down-sampling",
                   drift);
         stream->sync.resamp_type = AOUT_RESAMPLING_DOWN;
+        stream->sync.resamp_step = 2;
         stream->sync.resamp_start_drift = -drift;
     }
 
     if (stream->sync.resamp_type == AOUT_RESAMPLING_NONE)
-        return; /* Everything is fine. Nothing to do. */
+    {
+        /* Proactive micro-stretch: once the smoothed drift shows a steady
+         * trend, start correcting at half the reactive thresholds with half
+         * the step. The correction is spread over several seconds at a rate
+         * deviation of a few Hz, well below audibility, instead of waiting
+         * for the drift to require a correction large enough to be heard. */
+        vlc_tick_t avg = stream->sync.drift_avg;
+
+        if (avg > +AOUT_MAX_PTS_DELAY / 2)
+            stream->sync.resamp_type = AOUT_RESAMPLING_UP;
+        else if (avg < -AOUT_MAX_PTS_ADVANCE / 2)
+            stream->sync.resamp_type = AOUT_RESAMPLING_DOWN;
+        else
+            return; /* Everything is fine. Nothing to do. */
+
+        if (tracer != NULL)
+            vlc_tracer_TraceEvent(tracer, "RENDER", stream->str_id,
+                                  "micro_stretch");
+        msg_Dbg (aout, "drift trend (%"PRId64"): micro-stretching", avg);
+        stream->sync.resamp_step = 1;
+        stream->sync.resamp_start_drift = llabs (avg);
+    }
+
+    if (stream->sync.resamp_step == 1)
+        /* Micro-stretch control runs on the smoothed drift: one jittery
+         * measurement must not flip a correction this small. */
+        drift = stream->sync.drift_avg;
 
     if (llabs (drift) > 2 * stream->sync.resamp_start_drift)
     {   /* If the drift is ever increasing, then something is seriously wrong.
@@ -710,7 +809,8 @@ static void stream_HandleDrift(vlc_aout_stream *stream, vlc_tick_t drift,
     /* Resampling has been triggered earlier. This checks if it needs to be
      * increased or decreased. Resampling rate changes must be kept slow for
      * the comfort of listeners. */
-    int adj = (stream->sync.resamp_type == AOUT_RESAMPLING_UP) ? +2 : -2;
+    int adj = (stream->sync.resamp_type == AOUT_RESAMPLING_UP)
+            ? +stream->sync.resamp_step : -stream->sync.resamp_step;
 
     if (2 * llabs (drift) <= stream->sync.resamp_start_drift)
         /* If the drift has been reduced from more than half its initial
@@ -727,6 +827,28 @@ static void stream_HandleDrift(vlc_aout_stream *stream, vlc_tick_t drift,
     }
 }
 
+static void stream_CheckUnderrun(vlc_aout_stream *stream, vlc_tick_t delay)
+{
+    /* Predict output starvation before it becomes audible: with less than
+     * AOUT_MIN_PREPARE_TIME of queued audio, a single late decoder wakeup or
+     * bursty device callback is enough to drain the buffer. */
+    if (delay < AOUT_MIN_PREPARE_TIME)
+    {
+        if (stream->sync.low_water)
+            return;
+        stream->sync.low_water = true;
+        atomic_fetch_add_explicit(&stream->underruns_predicted, 1,
+                                  memory_order_relaxed);
+
+        struct vlc_tracer *tracer = aout_stream_tracer(stream);
+        if (tracer != NULL)
+            vlc_tracer_TraceEvent(tracer, "RENDER", stream->str_id,
+                                  "underrun_predicted");
+    }
+    else if (delay > 2 * AOUT_MIN_PREPARE_TIME)
+        stream->sync.low_water = false;
+}
+
 static void stream_Synchronize(vlc_aout_stream *stream, vlc_tick_t system_now,
                                vlc_tick_t play_date, vlc_tick_t dec_pts)
 {
@@ -752,20 +874,25 @@ static void stream_Synchronize(vlc_aout_stream *stream, vlc_tick_t system_now,
 
     if (aout->time_get == NULL)
     {
-        vlc_mutex_lock(&stream->timing.lock);
-        if (stream->sync.rate != stream->timing.rate)
+        /* timing.rate and first_pts are only written from this thread: the
+         * per-block fast path stays lock-free and only the rare rate change
+         * needs to synchronize with vlc_aout_stream_NotifyTiming(). */
+        if (unlikely(stream->sync.rate != stream->timing.rate))
         {
             /* Save the first timing point seeing a rate change */
+            vlc_mutex_lock(&stream->timing.lock);
             stream->timing.rate_system_ts = play_date;
             stream->timing.rate_audio_ts = dec_pts;
             stream->timing.rate = stream->sync.rate;
+            vlc_mutex_unlock(&stream->timing.lock);
         }
 
         if (stream->timing.first_pts == VLC_TICK_INVALID)
             stream->timing.first_pts = dec_pts;
 
-        bool is_drifting = stream->timing.last_drift != VLC_TICK_INVALID;
-        vlc_mutex_unlock(&stream->timing.lock);
+        bool is_drifting =
+            atomic_load_explicit(&stream->timing.last_drift,
+                                 memory_order_relaxed) != VLC_TICK_INVALID;
 
         if (!is_drifting)
         {
@@ -810,6 +937,9 @@ static void stream_Synchronize(vlc_aout_stream *stream, vlc_tick_t system_now,
         vlc_clock_Unlock(stream->sync.clock);
     }
 
+    if (stream->sync.played)
+        stream_CheckUnderrun(stream, delay);
+
     stream_HandleDrift(stream, drift, dec_pts);
 }
 
@@ -835,13 +965,13 @@ void vlc_aout_stream_NotifyTiming(vlc_aout_stream *stream, vlc_tick_t system_ts,
                    * stream->timing.rate;
     }
 
-    stream->timing.system_ts = system_ts;
-    stream->timing.audio_ts = audio_ts;
+    stream_TimingPublish(stream, system_ts, audio_ts);
     vlc_clock_Lock(stream->sync.clock);
-    stream->timing.last_drift =
-        vlc_clock_Update(stream->sync.clock, system_ts,
-                         audio_ts, stream->timing.rate);
+    vlc_tick_t drift = vlc_clock_Update(stream->sync.clock, system_ts,
+                                        audio_ts, stream->timing.rate);
     vlc_clock_Unlock(stream->sync.clock);
+    atomic_store_explicit(&stream->timing.last_drift, drift,
+                          memory_order_relaxed);
     vlc_mutex_unlock(&stream->timing.lock);
 }
 
@@ -996,8 +1126,15 @@ void vlc_aout_stream_ChangePause(vlc_aout_stream *stream, bool paused, vlc_tick_
              * by stream_GetDelay() until the module updates its next point
              * after being resumed. */
             vlc_mutex_lock(&stream->timing.lock);
-            if (stream->timing.system_ts != VLC_TICK_INVALID)
-                stream->timing.system_ts += date - stream->timing.pause_date;
+            vlc_tick_t system_ts =
+                atomic_load_explicit(&stream->timing.system_ts,
+                                     memory_order_relaxed);
+            if (system_ts != VLC_TICK_INVALID)
+                stream_TimingPublish(stream,
+                                     system_ts + date
+                                     - stream->timing.pause_date,
+                                     atomic_load_explicit(&stream->timing.audio_ts,
+                                                          memory_order_relaxed));
             vlc_mutex_unlock(&stream->timing.lock);
             stream->timing.pause_date = VLC_TICK_INVALID;
         }
@@ -38,6 +38,14 @@
 
 #define MAX_PCR_DELAY VLC_TICK_FROM_SEC(60)
 
+/* Number of points of the coeff moving average */
+#define COEFF_AVG_RANGE 10
+/* Faster convergence for the low-latency profile */
+#define COEFF_AVG_RANGE_LOW_LATENCY 3
+/* Offset jump tolerated between two points before the low-latency profile
+ * drops the smoothing history and converges from the new point */
+#define LOW_LATENCY_DRIFT_WINDOW VLC_TICK_FROM_MS(100)
+
 struct vlc_clock_listener_id
 {
     vlc_clock_t *clock;
@@ -79,6 +87,9 @@ struct vlc_clock_main_t
     vlc_tick_t delay;
     struct vlc_clock_context *context;
 
+    bool low_latency;
+    vlc_tick_t last_drift; /* Last drift measured by a slave output */
+
     vlc_tick_t pause_date;
 
     unsigned wait_sync_ref_priority;
@@ -347,6 +358,7 @@ static void vlc_clock_main_reset(vlc_clock_main_t *main_clock)
     context_reset(ctx);
     AvgResetAndFill(&main_clock->coeff_avg, ctx->coeff);
 
+    main_clock->last_drift = VLC_TICK_INVALID;
     main_clock->wait_sync_ref_priority = UINT_MAX;
     vlc_cond_broadcast(&main_clock->cond);
 }
@@ -435,8 +447,33 @@ static void vlc_clock_master_update_coeff(
         vlc_clock_SendEvent(main_clock, discontinuity);
     }
 
+    const vlc_tick_t prev_offset = ctx->offset;
     ctx->offset = system_now - ((vlc_tick_t) (ts * ctx->coeff / rate));
 
+    if (main_clock->low_latency && prev_offset != VLC_TICK_INVALID)
+    {
+        vlc_tick_t jump = ctx->offset - prev_offset;
+        if (jump > LOW_LATENCY_DRIFT_WINDOW || jump < -LOW_LATENCY_DRIFT_WINDOW)
+        {
+            /* The source stepped outside the tolerated drift window (network
+             * stall, buffer creep). Drop the smoothing history so that the
+             * next points converge from here instead of being averaged with
+             * the stale slope. */
+            AvgResetAndFill(&main_clock->coeff_avg, ctx->coeff);
+
+            if (main_clock->logger != NULL)
+                vlc_warning(main_clock->logger, "low-latency: offset jumped "
+                            "by %"PRId64" us, dropping smoothing history",
+                            US_FROM_VLC_TICK(jump));
+            if (main_clock->tracer != NULL && clock->track_str_id != NULL)
+                vlc_tracer_TraceEvent(main_clock->tracer, "RENDER",
+                                      clock->track_str_id,
+                                      "low_latency_resync");
+
+            vlc_clock_SendEvent(main_clock, discontinuity);
+        }
+    }
+
     if (main_clock->tracer != NULL && clock->track_str_id != NULL)
         vlc_tracer_Trace(main_clock->tracer,
                          VLC_TRACE("type", "RENDER"),
@@ -636,6 +673,7 @@ static vlc_tick_t vlc_clock_slave_update(vlc_clock_t *clock,
     vlc_tick_t computed = clock->ops->to_system(clock, ctx, system_now, ts, rate);
 
     vlc_tick_t drift = computed - system_now;
+    clock->owner->last_drift = drift;
     vlc_clock_on_update(clock, computed, ts, drift, rate,
                         frame_rate, frame_rate_base);
     return drift;
@@ -740,8 +778,10 @@ vlc_clock_main_t *vlc_clock_main_New(struct vlc_logger *parent_logger, struct vl
     main_clock->pause_date = VLC_TICK_INVALID;
     main_clock->input_dejitter = DEFAULT_PTS_DELAY;
     main_clock->output_dejitter = AOUT_MAX_PTS_ADVANCE * 2;
+    main_clock->low_latency = false;
+    main_clock->last_drift = VLC_TICK_INVALID;
 
-    AvgInit(&main_clock->coeff_avg, 10);
+    AvgInit(&main_clock->coeff_avg, COEFF_AVG_RANGE);
     AvgResetAndFill(&main_clock->coeff_avg, ctx->coeff);
 
     vlc_vector_init(&main_clock->listeners);
@@ -806,6 +846,39 @@ void vlc_clock_main_SetDejitter(vlc_clock_main_t *main_clock,
     main_clock->output_dejitter = dejitter;
 }
 
+void vlc_clock_main_SetLowLatency(vlc_clock_main_t *main_clock, bool enabled)
+{
+    vlc_mutex_assert(&main_clock->lock);
+
+    if (main_clock->low_latency == enabled)
+        return;
+    main_clock->low_latency = enabled;
+
+    /* Shorten (or restore) the coeff moving average while keeping the
+     * current estimate. Note: AvgRescale() scales the value with the range
+     * and would corrupt the average here. */
+    const double coeff = AvgGet(&main_clock->coeff_avg);
+    AvgInit(&main_clock->coeff_avg,
+            enabled ? COEFF_AVG_RANGE_LOW_LATENCY : COEFF_AVG_RANGE);
+    AvgResetAndFill(&main_clock->coeff_avg, coeff);
+
+    if (main_clock->logger != NULL)
+        vlc_debug(main_clock->logger, "low-latency profile %s",
+                  enabled ? "enabled" : "disabled");
+}
+
+void vlc_clock_main_GetState(vlc_clock_main_t *main_clock,
+                             struct vlc_clock_main_state *state)
+{
+    vlc_mutex_assert(&main_clock->lock);
+    const struct vlc_clock_context *ctx = main_clock->context;
+
+    state->coeff = ctx->coeff;
+    state->rate = ctx->rate;
+    state->offset = ctx->offset;
+    state->drift = main_clock->last_drift;
+}
+
 void vlc_clock_main_ChangePause(vlc_clock_main_t *main_clock, vlc_tick_t now,
                                 bool paused)
 {
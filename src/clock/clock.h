@@ -133,6 +133,39 @@ void vlc_clock_main_SetInputDejitter(vlc_clock_main_t *main_clock,
  */
 void vlc_clock_main_SetDejitter(vlc_clock_main_t *main_clock, vlc_tick_t dejitter);
 
+/**
+ * Enable or disable the low-latency profile
+ *
+ * When enabled, the stream-to-system regression converges with a shorter
+ * moving average and drops its smoothing history whenever the source steps
+ * outside a bounded drift window, instead of slowly averaging the step in.
+ * Meant for sub-second latency live feeds.
+ *
+ * @param main_clock the locked main_clock
+ */
+void vlc_clock_main_SetLowLatency(vlc_clock_main_t *main_clock, bool enabled);
+
+/**
+ * Snapshot of the main clock state, cf. vlc_clock_main_GetState()
+ */
+struct vlc_clock_main_state
+{
+    double coeff; /**< Smoothed stream-to-system slope, around 1.0 */
+    double rate; /**< Playback rate of the last master update */
+    vlc_tick_t offset; /**< Stream-to-system origin, VLC_TICK_INVALID if unset */
+    vlc_tick_t drift; /**< Last drift measured by a slave output,
+                           VLC_TICK_INVALID if none */
+};
+
+/**
+ * Get a snapshot of the current clock state, for observability
+ *
+ * @param main_clock the locked main_clock
+ * @param state filled with the current state
+ */
+void vlc_clock_main_GetState(vlc_clock_main_t *main_clock,
+                             struct vlc_clock_main_state *state);
+
 
 /**
  * This function allows changing the pause status.
@@ -53,6 +53,8 @@ struct vlc_param *vlc_param_Find(const char *name);
 int vlc_param_SetString(struct vlc_param *param, const char *value);
 
 int  config_AutoSaveConfigFile( libvlc_int_t * );
+void config_AutoSaveStart( libvlc_int_t * );
+void config_AutoSaveStop( libvlc_int_t * );
 
 void config_Free(struct vlc_param *, size_t);
 
@@ -60,6 +62,9 @@ void config_CmdLineEarlyScan( libvlc_int_t *, int, const char *[] );
 
 int config_LoadCmdLine   ( libvlc_int_t *, int, const char *[], int * );
 int config_LoadConfigFile( libvlc_int_t * );
+char *config_GetConfigFile( libvlc_int_t * ) VLC_USED VLC_MALLOC;
+void config_PrefetchConfigFile( const char *psz_filename );
+void config_InvalidateFileStamp( void );
 bool config_PrintHelp (libvlc_int_t *);
 void config_Lock(void);
 void config_Unlock(void);
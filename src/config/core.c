@@ -27,6 +27,7 @@
 #include <stdatomic.h>
 #include <vlc_common.h>
 #include <vlc_actions.h>
+#include <vlc_arrays.h>
 #include <vlc_modules.h>
 #include <vlc_plugin.h>
 #include <vlc_threads.h>
@@ -43,6 +44,31 @@
 static vlc_mutex_t config_lock = VLC_STATIC_MUTEX;
 static atomic_bool config_dirty = false;
 
+/** Delay between the last settings change and the automatic write-back. */
+#define CONFIG_AUTOSAVE_DELAY VLC_TICK_FROM_SEC(3)
+
+static vlc_mutex_t autosave_lock = VLC_STATIC_MUTEX;
+static vlc_timer_t autosave_timer;
+static libvlc_int_t *autosave_obj = NULL;
+
+/**
+ * Marks the configuration as modified.
+ *
+ * This schedules a deferred write-back to the configuration file, so that
+ * callers of config_Put*() never block on disk I/O. Changes are still
+ * flushed synchronously on exit by config_AutoSaveConfigFile().
+ */
+static void config_Dirty(void)
+{
+    atomic_store_explicit(&config_dirty, true, memory_order_release);
+
+    vlc_mutex_lock(&autosave_lock);
+    if (autosave_obj != NULL)
+        vlc_timer_schedule(autosave_timer, false, CONFIG_AUTOSAVE_DELAY,
+                           VLC_TIMER_FIRE_ONCE);
+    vlc_mutex_unlock(&autosave_lock);
+}
+
 void config_Lock(void)
 {
     vlc_mutex_lock(&config_lock);
@@ -148,7 +174,7 @@ void config_PutPsz(const char *psz_name, const char *psz_value)
     vlc_mutex_lock(&config_lock);
     vlc_param_SetString(vlc_param_Find(psz_name), psz_value);
     vlc_mutex_unlock(&config_lock);
-    atomic_store_explicit(&config_dirty, true, memory_order_release);
+    config_Dirty();
 }
 
 void config_PutInt(const char *name, int64_t i_value)
@@ -169,7 +195,7 @@ void config_PutInt(const char *name, int64_t i_value)
     vlc_mutex_lock(&config_lock);
     p_config->value.i = i_value;
     vlc_mutex_unlock(&config_lock);
-    atomic_store_explicit(&config_dirty, true, memory_order_release);
+    config_Dirty();
 }
 
 void config_PutFloat(const char *name, float f_value)
@@ -193,7 +219,7 @@ void config_PutFloat(const char *name, float f_value)
     vlc_mutex_lock(&config_lock);
     p_config->value.f = f_value;
     vlc_mutex_unlock(&config_lock);
-    atomic_store_explicit(&config_dirty, true, memory_order_release);
+    config_Dirty();
 }
 
 ssize_t config_GetIntChoices(const char *name,
@@ -260,11 +286,15 @@ static ssize_t config_ListModules (const char *cap, char ***restrict values,
                                    char ***restrict texts)
 {
     module_t *const *list;
+
+    vlc_rcu_read_lock();
+
     size_t n = module_list_cap(&list, cap);
     char **vals = malloc ((n + 2) * sizeof (*vals));
     char **txts = malloc ((n + 2) * sizeof (*txts));
     if (!vals || !txts)
     {
+        vlc_rcu_read_unlock();
         free (vals);
         free (txts);
         *values = *texts = NULL;
@@ -292,11 +322,13 @@ static ssize_t config_ListModules (const char *cap, char ***restrict values,
     if( !vals[i] || !txts[i])
         goto error;
 
+    vlc_rcu_read_unlock();
     *values = vals;
     *texts = txts;
     return i + 1;
 
 error:
+    vlc_rcu_read_unlock();
     for (size_t j = 0; j <= i; ++j)
     {
         free (vals[j]);
@@ -403,6 +435,9 @@ static struct
     size_t count;
 } config = { NULL, 0 };
 
+static vlc_dictionary_t config_dict;
+static bool config_hashed = false;
+
 /**
  * Index the configuration items by name for faster lookups.
  */
@@ -437,6 +472,16 @@ int config_SortConfig (void)
 
     config.list = clist;
     config.count = nconf;
+
+    /* Also hash the items by name: lookups during module probing and option
+     * inheritance are frequent enough that constant time pays off. On
+     * failure, vlc_param_Find() falls back to binary search. */
+    vlc_dictionary_init(&config_dict, (nconf > 0) ? (int)nconf : 1);
+    config_hashed = (config_dict.p_entries != NULL);
+    if (config_hashed)
+        for (size_t i = 0; i < nconf; i++)
+            vlc_dictionary_insert(&config_dict, clist[i]->item.psz_name,
+                                  clist[i]);
     return VLC_SUCCESS;
 }
 
@@ -444,6 +489,12 @@ void config_UnsortConfig (void)
 {
     struct vlc_param **clist;
 
+    if (config_hashed)
+    {
+        vlc_dictionary_clear(&config_dict, NULL, NULL);
+        config_hashed = false;
+    }
+
     clist = config.list;
     config.list = NULL;
     config.count = 0;
@@ -456,6 +507,9 @@ struct vlc_param *vlc_param_Find(const char *name)
     struct vlc_param *const *p;
 
     assert(name != NULL);
+    if (config_hashed)
+        return vlc_dictionary_value_for_key(&config_dict, name);
+
     p = bsearch (name, config.list, config.count, sizeof (*p), confnamecmp);
     return (p != NULL) ? *p : NULL;
 }
@@ -525,9 +579,52 @@ void config_ResetAll(void)
         }
     }
     vlc_mutex_unlock(&config_lock);
-    atomic_store_explicit(&config_dirty, true, memory_order_release);
+    config_Dirty();
+}
+
+
+static void config_AutoSaveTimer(void *data)
+{
+    config_AutoSaveConfigFile(data);
 }
 
+void config_AutoSaveStart( libvlc_int_t *p_this )
+{
+    vlc_timer_t timer;
+
+    assert( p_this );
+
+    if (vlc_timer_create(&timer, config_AutoSaveTimer, p_this))
+        return; /* changes will still be written out on exit */
+
+    vlc_mutex_lock(&autosave_lock);
+    if (autosave_obj == NULL)
+    {
+        autosave_timer = timer;
+        autosave_obj = p_this;
+        timer = NULL;
+    }
+    vlc_mutex_unlock(&autosave_lock);
+
+    if (timer != NULL) /* another libvlc instance already handles saving */
+        vlc_timer_destroy(timer);
+}
+
+void config_AutoSaveStop( libvlc_int_t *p_this )
+{
+    assert( p_this );
+
+    vlc_mutex_lock(&autosave_lock);
+    if (autosave_obj != p_this)
+    {
+        vlc_mutex_unlock(&autosave_lock);
+        return;
+    }
+    autosave_obj = NULL;
+    vlc_mutex_unlock(&autosave_lock);
+
+    vlc_timer_destroy(autosave_timer);
+}
 
 int config_AutoSaveConfigFile( libvlc_int_t *p_this )
 {
@@ -52,7 +52,7 @@
 /**
  * Get the user's configuration file
  */
-static char *config_GetConfigFile( libvlc_int_t *obj )
+char *config_GetConfigFile( libvlc_int_t *obj )
 {
     char *psz_file = var_InheritString( obj, "config" );
     if( psz_file == NULL )
@@ -134,6 +134,70 @@ static FILE *config_OpenConfigFile( libvlc_int_t *p_obj )
     return p_stream;
 }
 
+/**
+ * Reads the configuration file into the page cache and throws the bytes
+ * away. Meant to run on a background thread while the plugins cache is
+ * being scanned, so that config_LoadConfigFile() does not block on disk
+ * afterwards. The path must be resolved beforehand by the caller with
+ * config_GetConfigFile(): the parameter table is not usable while the
+ * plugins scan rebuilds it. Errors are ignored: the actual load reports
+ * them.
+ */
+void config_PrefetchConfigFile( const char *psz_filename )
+{
+    int fd = vlc_open( psz_filename, O_RDONLY );
+    if( fd == -1 )
+        return;
+
+    char buf[4096];
+    while( read( fd, buf, sizeof (buf) ) > 0 );
+    vlc_close( fd );
+}
+
+/* Stamp of the last successfully parsed configuration file. The parameter
+ * table it was parsed into is shared process-wide with the module bank, so
+ * additional LibVLC instances need not re-parse an unchanged file. */
+static struct
+{
+    bool valid;
+    dev_t dev;
+    ino_t ino;
+    time_t mtime;
+    off_t size;
+} config_file_stamp = { .valid = false };
+
+static bool config_IsFileFresh(const struct stat *st)
+{
+    config_Lock();
+    bool fresh = config_file_stamp.valid
+              && config_file_stamp.dev == st->st_dev
+              && config_file_stamp.ino == st->st_ino
+              && config_file_stamp.mtime == st->st_mtime
+              && config_file_stamp.size == st->st_size;
+    config_Unlock();
+    return fresh;
+}
+
+static void config_SetFileStamp(const struct stat *st)
+{
+    config_Lock();
+    config_file_stamp.valid = true;
+    config_file_stamp.dev = st->st_dev;
+    config_file_stamp.ino = st->st_ino;
+    config_file_stamp.mtime = st->st_mtime;
+    config_file_stamp.size = st->st_size;
+    config_Unlock();
+}
+
+/* Called when the parameter table goes away with the module bank: the stamp
+ * no longer describes any loaded values. */
+void config_InvalidateFileStamp(void)
+{
+    config_Lock();
+    config_file_stamp.valid = false;
+    config_Unlock();
+}
+
 static int64_t vlc_strtoi (const char *str)
 {
     char *end;
@@ -169,6 +233,15 @@ int config_LoadConfigFile( libvlc_int_t *p_this )
     if (file == NULL)
         return VLC_EGENERIC;
 
+    struct stat st;
+    bool b_stamp = fstat (fileno (file), &st) == 0;
+    if (b_stamp && config_IsFileFresh (&st))
+    {
+        msg_Dbg (p_this, "configuration file unchanged, reusing loaded values");
+        fclose (file);
+        return 0;
+    }
+
     /* Skip UTF-8 Byte Order Mark if present */
     char bom[3];
     if (fread (bom, 1, 3, file) != 3 || memcmp (bom, "\xEF\xBB\xBF", 3))
@@ -262,6 +335,8 @@ int config_LoadConfigFile( libvlc_int_t *p_this )
                  vlc_strerror_c(errno));
         clearerr (file);
     }
+    else if (b_stamp)
+        config_SetFileStamp (&st);
     fclose (file);
 
     if (loc != (locale_t)0)
@@ -258,6 +258,25 @@ static ssize_t AStreamReadStream(stream_t *s, void *buf, size_t len)
     return val;
 }
 
+static ssize_t AStreamReadVec(stream_t *s, const struct vlc_stream_extent *extents,
+                              unsigned count)
+{
+    stream_t *access = s->p_sys;
+
+    ssize_t val = vlc_stream_ReadVec(access, extents, count);
+
+    if (val > 0)
+    {
+        struct vlc_access_stream_private *priv = vlc_stream_Private(s);
+        struct input_stats *stats =
+            priv->input ? input_priv(priv->input)->stats : NULL;
+        if (stats != NULL)
+            input_rate_Add(&stats->input_bitrate, val);
+    }
+
+    return val;
+}
+
 /* Common */
 static int AStreamSeek(stream_t *s, uint64_t offset)
 {
@@ -319,6 +338,8 @@ stream_t *stream_AccessNew(vlc_object_t *parent, input_thread_t *input,
             s->pf_block = AStreamReadBlock;
         if (access->pf_read != NULL)
             s->pf_read = AStreamReadStream;
+        if (access->pf_readvec != NULL)
+            s->pf_readvec = AStreamReadVec;
 
         s->pf_seek = AStreamSeek;
         s->pf_control = AStreamControl;
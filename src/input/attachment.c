@@ -25,13 +25,111 @@
 #include <vlc_common.h>
 #include <vlc_input.h>
 #include <vlc_atomic.h>
+#include <vlc_arrays.h>
+#include <vlc_hash.h>
+#include <vlc_strings.h>
+
+/* Minimum payload size to go through the deduplication store. Embedded art
+ * and fonts are tens of kilobytes; hashing every tiny blob would just
+ * pollute the store. */
+#define ATTACHMENT_DEDUP_MIN 1024
+
+/* Refcounted payload, shared between attachments carrying identical data
+ * (typically the same album art embedded in every track of an album) */
+struct attachment_payload
+{
+    vlc_atomic_rc_t rc;
+    char key[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    size_t size;
+    void *data; /* malloc()ed, owned */
+};
+
+/* Content-hash keyed store of the payloads currently alive */
+static vlc_mutex_t payloads_lock = VLC_STATIC_MUTEX;
+static vlc_dictionary_t payloads = { 0, NULL };
 
 struct input_attachment_priv
 {
     input_attachment_t a;
+    struct attachment_payload *payload; /* NULL if the data is owned */
     vlc_atomic_rc_t rc;
 };
 
+/* Looks up or registers a payload. With b_take, ownership of the (heap)
+ * buffer is transferred: it is either adopted as-is, or freed when an
+ * identical payload is already alive or on allocation failure. */
+static struct attachment_payload *
+attachment_payload_Get( const void *p_data, size_t i_data, bool b_take )
+{
+    char key[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    vlc_hash_md5_t md5;
+    vlc_hash_md5_Init( &md5 );
+    vlc_hash_md5_Update( &md5, p_data, i_data );
+    vlc_hash_FinishHex( &md5, key );
+
+    vlc_mutex_lock( &payloads_lock );
+    struct attachment_payload *p =
+        vlc_dictionary_value_for_key( &payloads, key );
+    if( p != NULL && p->size == i_data
+     && memcmp( p->data, p_data, i_data ) == 0 )
+    {
+        vlc_atomic_rc_inc( &p->rc );
+        vlc_mutex_unlock( &payloads_lock );
+        if( b_take )
+            free( (void *)p_data );
+        return p;
+    }
+    /* Not found (or hash collision: leave the previous entry alone) */
+    bool collided = p != NULL;
+
+    p = malloc( sizeof( *p ) );
+    if( likely(p != NULL) )
+    {
+        if( b_take )
+            p->data = (void *)p_data;
+        else
+        {
+            p->data = malloc( i_data );
+            if( unlikely(p->data == NULL) )
+            {
+                free( p );
+                p = NULL;
+            }
+            else
+                memcpy( p->data, p_data, i_data );
+        }
+    }
+    if( likely(p != NULL) )
+    {
+        vlc_atomic_rc_init( &p->rc );
+        memcpy( p->key, key, sizeof( key ) );
+        p->size = i_data;
+        if( !collided )
+            vlc_dictionary_insert( &payloads, key, p );
+    }
+    else if( b_take )
+        free( (void *)p_data );
+    vlc_mutex_unlock( &payloads_lock );
+    return p;
+}
+
+static void attachment_payload_Release( struct attachment_payload *p )
+{
+    vlc_mutex_lock( &payloads_lock );
+    if( !vlc_atomic_rc_dec( &p->rc ) )
+    {
+        vlc_mutex_unlock( &payloads_lock );
+        return;
+    }
+    if( vlc_dictionary_value_for_key( &payloads, p->key ) == p )
+        vlc_dictionary_remove_value_for_key( &payloads, p->key, NULL, NULL );
+    if( vlc_dictionary_is_empty( &payloads ) )
+        vlc_dictionary_clear( &payloads, NULL, NULL );
+    vlc_mutex_unlock( &payloads_lock );
+    free( p->data );
+    free( p );
+}
+
 static struct input_attachment_priv* input_attachment_priv( input_attachment_t* a )
 {
     return container_of( a, struct input_attachment_priv, a );
@@ -47,31 +145,49 @@ void vlc_input_attachment_Release( input_attachment_t *a )
     if( !vlc_atomic_rc_dec( &p->rc ) )
         return;
 
-    free( a->p_data );
+    if( p->payload != NULL )
+        attachment_payload_Release( p->payload );
+    else
+        free( a->p_data );
     free( a->psz_description );
     free( a->psz_mime );
     free( a->psz_name );
     free( p );
 }
 
-input_attachment_t *vlc_input_attachment_New( const char *psz_name,
-                                              const char *psz_mime,
-                                              const char *psz_description,
-                                              const void *p_data,
-                                              size_t i_data )
+static input_attachment_t *attachment_New( const char *psz_name,
+                                           const char *psz_mime,
+                                           const char *psz_description,
+                                           const void *p_data,
+                                           size_t i_data, bool b_take )
 {
     struct input_attachment_priv *a = (struct input_attachment_priv *)malloc( sizeof (*a) );
     if( unlikely(a == NULL) )
+    {
+        if( b_take )
+            free( (void *)p_data );
         return NULL;
+    }
 
     vlc_atomic_rc_init( &a->rc );
     a->a.psz_name = strdup( psz_name ? psz_name : "" );
     a->a.psz_mime = strdup( psz_mime ? psz_mime : "" );
     a->a.psz_description = strdup( psz_description ? psz_description : "" );
     a->a.i_data = i_data;
-    a->a.p_data = malloc( i_data );
-    if( i_data > 0 && likely(a->a.p_data != NULL) )
-        memcpy( a->a.p_data, p_data, i_data );
+    a->payload = NULL;
+    if( i_data >= ATTACHMENT_DEDUP_MIN )
+    {
+        a->payload = attachment_payload_Get( p_data, i_data, b_take );
+        a->a.p_data = ( a->payload != NULL ) ? a->payload->data : NULL;
+    }
+    else if( b_take )
+        a->a.p_data = (void *)p_data;
+    else
+    {
+        a->a.p_data = malloc( i_data );
+        if( i_data > 0 && likely(a->a.p_data != NULL) )
+            memcpy( a->a.p_data, p_data, i_data );
+    }
 
     if( unlikely(a->a.psz_name == NULL || a->a.psz_mime == NULL
               || a->a.psz_description == NULL || (i_data > 0 && a->a.p_data == NULL)) )
@@ -82,6 +198,26 @@ input_attachment_t *vlc_input_attachment_New( const char *psz_name,
     return &a->a;
 }
 
+input_attachment_t *vlc_input_attachment_New( const char *psz_name,
+                                              const char *psz_mime,
+                                              const char *psz_description,
+                                              const void *p_data,
+                                              size_t i_data )
+{
+    return attachment_New( psz_name, psz_mime, psz_description,
+                           p_data, i_data, false );
+}
+
+input_attachment_t *vlc_input_attachment_NewFromData( const char *psz_name,
+                                                      const char *psz_mime,
+                                                      const char *psz_description,
+                                                      void *p_data,
+                                                      size_t i_data )
+{
+    return attachment_New( psz_name, psz_mime, psz_description,
+                           p_data, i_data, true );
+}
+
 input_attachment_t *vlc_input_attachment_Hold( input_attachment_t *a )
 {
     struct input_attachment_priv* p = input_attachment_priv( a );
@@ -32,6 +32,7 @@
 #include <stdatomic.h>
 
 #include <vlc_common.h>
+#include <vlc_ancillary.h>
 #include <vlc_block.h>
 #include <vlc_vout.h>
 #include <vlc_aout.h>
@@ -51,6 +52,7 @@
 #include "../clock/clock.h"
 #include "input_internal.h"
 #include "decoder.h"
+#include "decoder_pool.h"
 #include "resource.h"
 #include "libvlc.h"
 
@@ -122,6 +124,9 @@ struct vlc_input_decoder_t
     const char *psz_id;
 
     bool hw_dec;
+    /* Counted against the instance-wide video decode thread budget,
+     * cf. DecoderAcquireThreadBudget() */
+    bool b_thread_budget;
 
     const struct vlc_input_decoder_callbacks *cbs;
     void *cbs_userdata;
@@ -131,9 +136,37 @@ struct vlc_input_decoder_t
 
     sout_stream_t           *p_sout;
     sout_packetizer_input_t *p_sout_input;
+    /* The demuxer already delimits frames: forward them to the stream
+     * output without running the packetizer on every frame */
+    bool                     b_sout_passthrough;
 
     vlc_thread_t     thread;
 
+    /* Shared worker pool servicing this decoder instead of a dedicated
+     * thread, or NULL. Cf. "dec-workers" and decoder_pool.c. */
+    vlc_decoder_pool_t *pool;
+    struct vlc_decoder_pool_client pool_client;
+
+    /* CPU time consumed by the decoder thread and not yet reported through
+     * the stats callbacks, which run from the ModuleThread */
+    atomic_uintmax_t cpu_pending;
+
+    /* Per-frame QoS ledger ("frame-qos"): input-side stamps recorded by
+     * frame date and recovered when the matching decoded picture is queued,
+     * since decoder modules reorder frames and don't forward the input frame
+     * ancillaries. All members are guarded by the fifo lock. */
+    struct
+    {
+        bool enabled;
+        struct frame_qos_input
+        {
+            vlc_tick_t date;
+            vlc_tick_t demux_out;
+            vlc_tick_t decode_start;
+        } ring[64];
+        size_t next;
+    } qos;
+
     /* Some decoders require already packetized data (ie. not truncated) */
     decoder_t *p_packetizer;
     es_format_t pktz_fmt_in;
@@ -378,6 +411,41 @@ static void Decoder_UpdateOutState(vlc_input_decoder_t *owner)
         Decoder_ChangeOutputDelay(owner, owner->delay);
 }
 
+/* Shared software decode thread budget: each new video decoder gets an
+ * even share of the machine cores, based on how many video decoders the
+ * libvlc instance is already running. With a single stream the share is
+ * the full core count; with a dozen streams each internal codec thread
+ * pool shrinks accordingly instead of oversubscribing every core twelve
+ * times. Decoder modules inherit the hint through the
+ * "decoder-thread-budget" variable; modules that do not spawn their own
+ * pool (e.g. hardware decoders) simply ignore it. */
+static void DecoderAcquireThreadBudget( vlc_input_decoder_t *p_owner )
+{
+    decoder_t *p_dec = &p_owner->dec;
+    libvlc_priv_t *priv = libvlc_priv( vlc_object_instance( p_dec ) );
+
+    unsigned users = atomic_fetch_add_explicit( &priv->video_decoders, 1,
+                                                memory_order_relaxed ) + 1;
+    unsigned cpus = __MAX( 1, vlc_GetCPUCount() );
+    unsigned budget = __MAX( 1, cpus / users );
+
+    p_owner->b_thread_budget = true;
+    if( var_Create( p_dec, "decoder-thread-budget", VLC_VAR_INTEGER ) == VLC_SUCCESS )
+        var_SetInteger( p_dec, "decoder-thread-budget", budget );
+}
+
+static void DecoderReleaseThreadBudget( vlc_input_decoder_t *p_owner )
+{
+    if( !p_owner->b_thread_budget )
+        return;
+
+    libvlc_priv_t *priv =
+        libvlc_priv( vlc_object_instance( &p_owner->dec ) );
+    atomic_fetch_sub_explicit( &priv->video_decoders, 1,
+                               memory_order_relaxed );
+    p_owner->b_thread_budget = false;
+}
+
 /**
  * Load a decoder module
  */
@@ -408,7 +476,7 @@ static int LoadDecoder(decoder_t *p_dec, bool b_packetizer, es_format_t *fmt_in)
     return 0;
 }
 
-static int DecoderThread_Reload( vlc_input_decoder_t *p_owner,
+static VLC_COLD int DecoderThread_Reload( vlc_input_decoder_t *p_owner,
                                  const es_format_t *restrict p_fmt,
                                  enum reload reload )
 {
@@ -464,8 +532,7 @@ static void DecoderUpdateFormatLocked( vlc_input_decoder_t *p_owner )
 
     vlc_fifo_Assert(p_owner->p_fifo);
 
-    es_format_Clean( &p_owner->fmt );
-    es_format_Copy( &p_owner->fmt, &p_dec->fmt_out );
+    es_format_Update( &p_owner->fmt, &p_dec->fmt_out );
 
     assert( p_owner->fmt.i_cat == p_dec->fmt_in->i_cat );
 
@@ -611,6 +678,79 @@ static int ModuleThread_UpdateAudioFormat( decoder_t *p_dec )
 
 static int CreateVoutIfNeeded(vlc_input_decoder_t *);
 
+/**
+ * Predicts the decoded picture buffer depth from the level and coded
+ * dimensions signalled by the demuxer or packetizer, per H.264 Table A-1
+ * (MaxDpbMbs) and HEVC A.4.2 (MaxLumaPs). This lets the decoder pool be
+ * sized once before the first picture comes out, instead of committing the
+ * 16-frame worst case on every stream.
+ *
+ * Returns 0 when the level is unknown (the caller then falls back to the
+ * worst case).
+ */
+static unsigned PredictDpbSize( const decoder_t *p_dec )
+{
+    const video_format_t *fmt = &p_dec->fmt_out.video;
+    int i_level = p_dec->fmt_in->i_level;
+
+    if( i_level <= 0 || fmt->i_width == 0 || fmt->i_height == 0 )
+        return 0;
+
+    if( p_dec->fmt_in->i_codec == VLC_CODEC_H264 )
+    {
+        static const struct
+        {
+            uint8_t i_level;
+            uint32_t i_max_dpb_mbs;
+        } limits[] = {
+            {  9,     396 }, /* level 1b */
+            { 10,     396 }, { 11,     900 }, { 12,    2376 }, { 13,    2376 },
+            { 20,    2376 }, { 21,    4752 }, { 22,    8100 }, { 30,    8100 },
+            { 31,   18000 }, { 32,   20480 }, { 40,   32768 }, { 41,   32768 },
+            { 42,   34816 }, { 50,  110400 }, { 51,  184320 }, { 52,  184320 },
+            { 60,  696320 }, { 61, 1392640 }, { 62, 2764800 },
+        };
+        unsigned i_mbs = ((fmt->i_width + 15) / 16) * ((fmt->i_height + 15) / 16);
+
+        for( size_t i = 0; i < ARRAY_SIZE(limits); i++ )
+            if( limits[i].i_level == i_level )
+                return __MIN( limits[i].i_max_dpb_mbs / i_mbs, 16 );
+        return 0;
+    }
+
+    if( p_dec->fmt_in->i_codec == VLC_CODEC_HEVC )
+    {
+        static const struct
+        {
+            uint8_t i_level; /* general_level_idc */
+            uint32_t i_max_luma_ps;
+        } limits[] = {
+            {  30,    36864 }, {  60,   122880 }, {  63,   245760 },
+            {  90,   552960 }, {  93,   983040 }, { 120,  2228224 },
+            { 123,  2228224 }, { 150,  8912896 }, { 153,  8912896 },
+            { 156,  8912896 }, { 180, 35651584 }, { 183, 35651584 },
+            { 186, 35651584 },
+        };
+        uint64_t i_luma_ps = (uint64_t)fmt->i_width * fmt->i_height;
+
+        for( size_t i = 0; i < ARRAY_SIZE(limits); i++ )
+        {
+            if( limits[i].i_level != i_level )
+                continue;
+            /* A.4.2: MaxDpbSize with maxDpbPicBuf = 6 */
+            if( i_luma_ps <= limits[i].i_max_luma_ps / 4 )
+                return 16;
+            if( i_luma_ps <= limits[i].i_max_luma_ps / 2 )
+                return 12;
+            if( i_luma_ps <= limits[i].i_max_luma_ps * 3 / 4 )
+                return 8;
+            return 6;
+        }
+        return 0;
+    }
+
+    return 0;
+}
 
 static int ModuleThread_UpdateVideoFormat( decoder_t *p_dec, vlc_video_context *vctx )
 {
@@ -640,6 +780,15 @@ static int ModuleThread_UpdateVideoFormat( decoder_t *p_dec, vlc_video_context *
         {
         case VLC_CODEC_HEVC:
         case VLC_CODEC_H264:
+            dpb_size = PredictDpbSize( p_dec );
+            if( dpb_size != 0 )
+            {
+                /* Same slack over the DPB as the worst case carries over
+                 * its 16-frame maximum */
+                dpb_size += 2;
+                break;
+            }
+            /* fall through */
         case VLC_CODEC_DIRAC: /* FIXME valid ? */
         case VLC_CODEC_VVC:
             dpb_size = 18;
@@ -1010,6 +1159,23 @@ static float ModuleThread_GetDisplayRate( decoder_t *p_dec )
     return rate;
 }
 
+static vlc_fourcc_t ModuleThread_GetDisplayChroma( decoder_t *p_dec )
+{
+    vlc_input_decoder_t *p_owner = dec_get_owner( p_dec );
+
+    vlc_fifo_Lock( p_owner->p_fifo );
+    vout_thread_t *p_vout =
+        p_owner->vout_started ? vout_Hold( p_owner->p_vout ) : NULL;
+    vlc_fifo_Unlock( p_owner->p_fifo );
+
+    if( p_vout == NULL )
+        return 0;
+
+    vlc_fourcc_t chroma = vout_GetDisplayChroma( p_vout );
+    vout_Release( p_vout );
+    return chroma;
+}
+
 /*****************************************************************************
  * Public functions
  *****************************************************************************/
@@ -1127,6 +1293,36 @@ static void DecoderSendSubstream(vlc_input_decoder_t *p_owner)
     }
 }
 
+static int DecoderThread_CreateSoutInput( vlc_input_decoder_t *p_owner )
+{
+    decoder_t *p_dec = &p_owner->dec;
+
+    vlc_fifo_Lock(p_owner->p_fifo);
+    DecoderUpdateFormatLocked( p_owner );
+
+    p_owner->fmt.i_group = p_dec->fmt_in->i_group;
+    p_owner->fmt.i_id = p_dec->fmt_in->i_id;
+    if( p_dec->fmt_in->psz_language )
+    {
+        free( p_owner->fmt.psz_language );
+        p_owner->fmt.psz_language =
+            strdup( p_dec->fmt_in->psz_language );
+    }
+    vlc_fifo_Unlock(p_owner->p_fifo);
+
+    p_owner->p_sout_input =
+        sout_InputNew( p_owner->p_sout, &p_owner->fmt, p_owner->psz_id );
+
+    if( p_owner->p_sout_input == NULL )
+    {
+        msg_Err( p_dec, "cannot create packetized sout output (%4.4s)",
+                 (char *)&p_owner->fmt.i_codec );
+        p_owner->error = true;
+        return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
 /* This function process a frame for sout
  */
 static void DecoderThread_ProcessSout( vlc_input_decoder_t *p_owner, vlc_frame_t *frame )
@@ -1135,39 +1331,41 @@ static void DecoderThread_ProcessSout( vlc_input_decoder_t *p_owner, vlc_frame_t
     vlc_frame_t *sout_frame;
     vlc_frame_t **ppframe = frame ? &frame : NULL;
 
-    while( ( sout_frame =
-                 p_dec->pf_packetize( p_dec, ppframe ) ) )
+    if( p_owner->b_sout_passthrough )
     {
-        if( p_owner->p_sout_input == NULL )
-        {
-            vlc_fifo_Lock(p_owner->p_fifo);
-            DecoderUpdateFormatLocked( p_owner );
-
-            p_owner->fmt.i_group = p_dec->fmt_in->i_group;
-            p_owner->fmt.i_id = p_dec->fmt_in->i_id;
-            if( p_dec->fmt_in->psz_language )
-            {
-                free( p_owner->fmt.psz_language );
-                p_owner->fmt.psz_language =
-                    strdup( p_dec->fmt_in->psz_language );
-            }
-            vlc_fifo_Unlock(p_owner->p_fifo);
+        /* The frame is already a complete access unit: hand it to the mux
+         * as-is, the packetizer holds no state and has nothing to drain. */
+        if( frame == NULL )
+            return;
 
-            p_owner->p_sout_input =
-                sout_InputNew( p_owner->p_sout, &p_owner->fmt, p_owner->psz_id );
+        if( p_owner->p_sout_input == NULL &&
+            DecoderThread_CreateSoutInput( p_owner ) != VLC_SUCCESS )
+        {
+            block_Release( frame );
+            return;
+        }
 
-            if( p_owner->p_sout_input == NULL )
-            {
-                msg_Err( p_dec, "cannot create packetized sout output (%4.4s)",
-                         (char *)&p_owner->fmt.i_codec );
-                p_owner->error = true;
+        if( sout_InputSendBuffer( p_owner->p_sout, p_owner->p_sout_input,
+                                  frame ) == VLC_EGENERIC )
+        {
+            msg_Err( p_dec, "cannot continue streaming due to errors with codec %4.4s",
+                            (char *)&p_owner->fmt.i_codec );
+            p_owner->error = true;
+        }
+        return;
+    }
 
-                if(frame)
-                    block_Release(frame);
+    while( ( sout_frame =
+                 p_dec->pf_packetize( p_dec, ppframe ) ) )
+    {
+        if( p_owner->p_sout_input == NULL &&
+            DecoderThread_CreateSoutInput( p_owner ) != VLC_SUCCESS )
+        {
+            if(frame)
+                block_Release(frame);
 
-                block_ChainRelease(sout_frame);
-                break;
-            }
+            block_ChainRelease(sout_frame);
+            break;
         }
 
         while( sout_frame )
@@ -1319,6 +1517,65 @@ static void ModuleThread_QueueCc( decoder_t *p_videodec, vlc_frame_t *p_cc,
     vlc_fifo_Unlock(p_owner->p_fifo);
 }
 
+/* Called with the fifo locked */
+static void FrameQosStamp( vlc_input_decoder_t *p_owner,
+                           const vlc_frame_t *frame,
+                           enum vlc_frame_qos_stage stage )
+{
+    const vlc_tick_t date = frame->i_pts != VLC_TICK_INVALID ? frame->i_pts
+                          : frame->i_dts;
+    if( date == VLC_TICK_INVALID )
+        return;
+
+    struct frame_qos_input *entry = NULL;
+    for( size_t i = 0; i < ARRAY_SIZE(p_owner->qos.ring); i++ )
+        if( p_owner->qos.ring[i].date == date )
+        {
+            entry = &p_owner->qos.ring[i];
+            break;
+        }
+
+    if( entry == NULL )
+    {
+        if( stage != VLC_FRAME_QOS_DEMUX_OUT )
+            return; /* the entry got recycled, drop the stamp */
+        entry = &p_owner->qos.ring[p_owner->qos.next];
+        p_owner->qos.next = (p_owner->qos.next + 1)
+                          % ARRAY_SIZE(p_owner->qos.ring);
+        entry->date = date;
+        entry->decode_start = VLC_TICK_INVALID;
+    }
+
+    if( stage == VLC_FRAME_QOS_DEMUX_OUT )
+        entry->demux_out = vlc_tick_now();
+    else
+        entry->decode_start = vlc_tick_now();
+}
+
+/* Called with the fifo locked */
+static void FrameQosAttach( vlc_input_decoder_t *p_owner, picture_t *p_pic )
+{
+    vlc_frame_qos_t *qos = picture_AttachNewAncillary( p_pic,
+            VLC_ANCILLARY_ID_FRAMEQOS, sizeof (*qos) );
+    if( unlikely(qos == NULL) )
+        return;
+
+    for( int i = 0; i < VLC_FRAME_QOS_STAGE_COUNT; i++ )
+        qos->stages[i] = VLC_TICK_INVALID;
+    qos->stages[VLC_FRAME_QOS_DECODE_END] = vlc_tick_now();
+
+    for( size_t i = 0; i < ARRAY_SIZE(p_owner->qos.ring); i++ )
+        if( p_owner->qos.ring[i].date == p_pic->date )
+        {
+            qos->stages[VLC_FRAME_QOS_DEMUX_OUT] =
+                p_owner->qos.ring[i].demux_out;
+            qos->stages[VLC_FRAME_QOS_DECODE_START] =
+                p_owner->qos.ring[i].decode_start;
+            p_owner->qos.ring[i].date = VLC_TICK_INVALID;
+            break;
+        }
+}
+
 static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_picture )
 {
     decoder_t *p_dec = &p_owner->dec;
@@ -1394,7 +1651,7 @@ static int ModuleThread_PlayVideo( vlc_input_decoder_t *p_owner, picture_t *p_pi
     return VLC_SUCCESS;
 }
 
-static void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
+static VLC_HOT void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
 {
     assert( p_pic );
     vlc_input_decoder_t *p_owner = dec_get_owner( p_dec );
@@ -1408,6 +1665,9 @@ static void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
 
     vlc_fifo_Lock( p_owner->p_fifo );
 
+    if( unlikely(p_owner->qos.enabled) )
+        FrameQosAttach( p_owner, p_pic );
+
     int success = ModuleThread_PlayVideo( p_owner, p_pic );
 
     unsigned displayed = 0;
@@ -1422,7 +1682,11 @@ static void ModuleThread_QueueVideo( decoder_t *p_dec, picture_t *p_pic )
 
     vlc_fifo_Unlock(p_owner->p_fifo);
 
-    decoder_Notify(p_owner, on_new_video_stats, 1, vout_lost, displayed, vout_late);
+    vlc_tick_t cputime =
+        atomic_exchange_explicit( &p_owner->cpu_pending, 0,
+                                  memory_order_relaxed );
+    decoder_Notify(p_owner, on_new_video_stats, 1, vout_lost, displayed,
+                   vout_late, cputime);
 }
 
 static vlc_decoder_device * thumbnailer_get_device( decoder_t *p_dec )
@@ -1532,7 +1796,7 @@ static int ModuleThread_PlayAudio( vlc_input_decoder_t *p_owner, vlc_frame_t *p_
     return VLC_SUCCESS;
 }
 
-static void ModuleThread_QueueAudio( decoder_t *p_dec, vlc_frame_t *p_aout_buf )
+static VLC_HOT void ModuleThread_QueueAudio( decoder_t *p_dec, vlc_frame_t *p_aout_buf )
 {
     vlc_input_decoder_t *p_owner = dec_get_owner( p_dec );
     struct vlc_tracer *tracer = vlc_object_get_tracer( &p_dec->obj );
@@ -1558,7 +1822,10 @@ static void ModuleThread_QueueAudio( decoder_t *p_dec, vlc_frame_t *p_aout_buf )
 
     vlc_fifo_Unlock(p_owner->p_fifo);
 
-    decoder_Notify(p_owner, on_new_audio_stats, 1, aout_lost, played);
+    vlc_tick_t cputime =
+        atomic_exchange_explicit( &p_owner->cpu_pending, 0,
+                                  memory_order_relaxed );
+    decoder_Notify(p_owner, on_new_audio_stats, 1, aout_lost, played, cputime);
 }
 
 static void ModuleThread_PlaySpu( vlc_input_decoder_t *p_owner, subpicture_t *p_subpic )
@@ -1613,20 +1880,32 @@ static void ModuleThread_QueueSpu( decoder_t *p_dec, subpicture_t *p_spu )
 }
 
 static void DecoderThread_ProcessInput( vlc_input_decoder_t *p_owner, vlc_frame_t *frame );
-static void DecoderThread_DecodeBlock( vlc_input_decoder_t *p_owner, vlc_frame_t *frame )
+static VLC_HOT void DecoderThread_DecodeBlock( vlc_input_decoder_t *p_owner, vlc_frame_t *frame )
 {
     decoder_t *p_dec = &p_owner->dec;
     struct vlc_tracer *tracer = vlc_object_get_tracer( &p_dec->obj );
 
+    if( unlikely(p_owner->qos.enabled) && frame != NULL )
+        FrameQosStamp( p_owner, frame, VLC_FRAME_QOS_DECODE_START );
+
     vlc_fifo_Unlock(p_owner->p_fifo);
 
+    int ret;
     if ( tracer != NULL && frame != NULL )
     {
+        /* The frame is consumed by the decoder: save its id for the span */
+        const vlc_tick_t i_frame_dts = frame->i_dts;
+
         vlc_tracer_TraceStreamDTS( tracer, "DEC", p_owner->psz_id, "IN",
                             frame->i_pts, frame->i_dts );
+        vlc_tracer_TraceSpanBegin( tracer, "DEC", p_owner->psz_id, "decode",
+                                   i_frame_dts );
+        ret = p_dec->pf_decode( p_dec, frame );
+        vlc_tracer_TraceSpanEnd( tracer, "DEC", p_owner->psz_id, "decode",
+                                 i_frame_dts );
     }
-
-    int ret = p_dec->pf_decode( p_dec, frame );
+    else
+        ret = p_dec->pf_decode( p_dec, frame );
 
     vlc_fifo_Lock(p_owner->p_fifo);
     switch( ret )
@@ -1659,7 +1938,7 @@ static void DecoderThread_DecodeBlock( vlc_input_decoder_t *p_owner, vlc_frame_t
  * \param p_owner the input decoder object
  * \param frame the block to decode
  */
-static void DecoderThread_ProcessInput( vlc_input_decoder_t *p_owner, vlc_frame_t *frame )
+static VLC_HOT void DecoderThread_ProcessInput( vlc_input_decoder_t *p_owner, vlc_frame_t *frame )
 {
     decoder_t *p_dec = &p_owner->dec;
 
@@ -1775,6 +2054,115 @@ static void DecoderThread_Flush( vlc_input_decoder_t *p_owner )
         p_dec->pf_flush( p_dec );
 }
 
+enum decoder_run
+{
+    DECODER_RUN_AGAIN,   /* Some work was done, call again */
+    DECODER_RUN_IDLE,    /* Nothing to do until the next wake-up */
+    DECODER_RUN_STOPPED, /* The decoder is aborting */
+};
+
+/**
+ * One step of the decoding main loop
+ *
+ * Called with the fifo locked; may unlock it temporarily. When can_wait
+ * is false, the function returns DECODER_RUN_IDLE instead of blocking on
+ * the fifo condition, so that a shared pool worker can go service
+ * another decoder, cf. vlc_input_decoder_PoolService().
+ */
+static enum decoder_run DecoderThread_RunOnce( vlc_input_decoder_t *p_owner,
+                                               bool can_wait )
+{
+    vlc_fifo_Assert( p_owner->p_fifo );
+
+    if( p_owner->aborting && !p_owner->flushing )
+        return DECODER_RUN_STOPPED;
+
+    if( p_owner->flushing )
+    {   /* Flush before/regardless of pause. We do not want to resume just
+         * for the sake of flushing (glitches could otherwise happen). */
+        vlc_fifo_Unlock( p_owner->p_fifo );
+
+        /* Flush the decoder (and the output) */
+        DecoderThread_Flush( p_owner );
+
+        vlc_fifo_Lock( p_owner->p_fifo );
+
+        /* Reset flushing after DecoderThread_ProcessInput in case vlc_input_decoder_Flush
+         * is called again. This will avoid a second useless flush (but
+         * harmless). */
+        p_owner->flushing = false;
+        p_owner->i_preroll_end = PREROLL_NONE;
+        return DECODER_RUN_AGAIN;
+    }
+
+    if( p_owner->paused != p_owner->output_paused )
+    {   /* Update playing/paused status of the output */
+        Decoder_ChangeOutputPause( p_owner, p_owner->paused, p_owner->pause_date );
+        return DECODER_RUN_AGAIN;
+    }
+
+    if( p_owner->rate != p_owner->output_rate )
+    {
+        Decoder_ChangeOutputRate( p_owner, p_owner->rate );
+        return DECODER_RUN_AGAIN;
+    }
+
+    if( p_owner->delay != p_owner->output_delay )
+    {
+        Decoder_ChangeOutputDelay( p_owner, p_owner->delay );
+        return DECODER_RUN_AGAIN;
+    }
+
+    if( p_owner->paused && p_owner->frames_countdown == 0 )
+    {   /* Wait for resumption from pause */
+        if( !can_wait )
+            return DECODER_RUN_IDLE;
+        p_owner->b_idle = true;
+        vlc_cond_signal( &p_owner->wait_acknowledge );
+        vlc_fifo_Wait( p_owner->p_fifo );
+        p_owner->b_idle = false;
+        return DECODER_RUN_AGAIN;
+    }
+
+    vlc_cond_signal( &p_owner->wait_fifo );
+
+    vlc_frame_t *frame = vlc_fifo_DequeueUnlocked( p_owner->p_fifo );
+    if( frame == NULL )
+    {
+        if( likely(!p_owner->b_draining) )
+        {   /* Wait for a block to decode (or a request to drain) */
+            if( !can_wait )
+                return DECODER_RUN_IDLE;
+            p_owner->b_idle = true;
+            vlc_cond_signal( &p_owner->wait_acknowledge );
+            vlc_fifo_Wait( p_owner->p_fifo );
+            p_owner->b_idle = false;
+            return DECODER_RUN_AGAIN;
+        }
+        /* We have emptied the FIFO and there is a pending request to
+         * drain. Pass frame = NULL to decoder just once. */
+    }
+
+    /* DecoderThread_ProcessInput will unlock when playing to the decoders
+     * but will ensure it re-locks in the end. This is necessary to handle
+     * reloading, CC and packetizing. */
+    DecoderThread_ProcessInput( p_owner, frame );
+
+    if( p_owner->b_draining && frame == NULL )
+    {
+        p_owner->b_draining = false;
+
+        if( p_owner->dec.fmt_in->i_cat == AUDIO_ES && p_owner->p_astream != NULL )
+        {   /* Draining: the decoder is drained and all decoded buffers are
+             * queued to the output at this point. Now drain the output. */
+            vlc_aout_stream_Drain( p_owner->p_astream );
+        }
+    }
+
+    vlc_cond_signal( &p_owner->wait_acknowledge );
+    return DECODER_RUN_AGAIN;
+}
+
 /**
  * The decoding main loop
  *
@@ -1796,94 +2184,68 @@ static void *DecoderThread( void *p_data )
 
     vlc_thread_set_name(thread_name);
 
+    if( var_InheritBool( &p_owner->dec, "decoder-core-affinity" ) )
+        vlc_thread_SetCoreClass( VLC_OBJECT( &p_owner->dec ),
+                                 p_owner->dec.fmt_in->i_cat == VIDEO_ES );
+
+    vlc_tick_t cputime = input_stats_ThreadCpuTime();
+
     /* The decoder's main loop */
     vlc_fifo_Lock( p_owner->p_fifo );
 
-    while( !p_owner->aborting || p_owner->flushing )
+    while( DecoderThread_RunOnce( p_owner, true ) != DECODER_RUN_STOPPED )
     {
-        if( p_owner->flushing )
-        {   /* Flush before/regardless of pause. We do not want to resume just
-             * for the sake of flushing (glitches could otherwise happen). */
-            vlc_fifo_Unlock( p_owner->p_fifo );
-
-            /* Flush the decoder (and the output) */
-            DecoderThread_Flush( p_owner );
-
-            vlc_fifo_Lock( p_owner->p_fifo );
-
-            /* Reset flushing after DecoderThread_ProcessInput in case vlc_input_decoder_Flush
-             * is called again. This will avoid a second useless flush (but
-             * harmless). */
-            p_owner->flushing = false;
-            p_owner->i_preroll_end = PREROLL_NONE;
-            continue;
-        }
-
-        if( p_owner->paused != p_owner->output_paused )
-        {   /* Update playing/paused status of the output */
-            Decoder_ChangeOutputPause( p_owner, p_owner->paused, p_owner->pause_date );
-            continue;
-        }
-
-        if( p_owner->rate != p_owner->output_rate )
-        {
-            Decoder_ChangeOutputRate( p_owner, p_owner->rate );
-            continue;
-        }
-
-        if( p_owner->delay != p_owner->output_delay )
-        {
-            Decoder_ChangeOutputDelay( p_owner, p_owner->delay );
-            continue;
-        }
-
-        if( p_owner->paused && p_owner->frames_countdown == 0 )
-        {   /* Wait for resumption from pause */
-            p_owner->b_idle = true;
-            vlc_cond_signal( &p_owner->wait_acknowledge );
-            vlc_fifo_Wait( p_owner->p_fifo );
-            p_owner->b_idle = false;
-            continue;
-        }
-
-        vlc_cond_signal( &p_owner->wait_fifo );
+        /* Account the CPU time consumed since the last sample. The CPU clock
+         * does not progress while the thread is blocked, so the waits inside
+         * the loop do not inflate the figure. */
+        vlc_tick_t now = input_stats_ThreadCpuTime();
+        atomic_fetch_add_explicit( &p_owner->cpu_pending, now - cputime,
+                                   memory_order_relaxed );
+        cputime = now;
+    }
 
-        vlc_frame_t *frame = vlc_fifo_DequeueUnlocked( p_owner->p_fifo );
-        if( frame == NULL )
-        {
-            if( likely(!p_owner->b_draining) )
-            {   /* Wait for a block to decode (or a request to drain) */
-                p_owner->b_idle = true;
-                vlc_cond_signal( &p_owner->wait_acknowledge );
-                vlc_fifo_Wait( p_owner->p_fifo );
-                p_owner->b_idle = false;
-                continue;
-            }
-            /* We have emptied the FIFO and there is a pending request to
-             * drain. Pass frame = NULL to decoder just once. */
-        }
+    vlc_fifo_Unlock( p_owner->p_fifo );
+    return NULL;
+}
 
-        /* DecoderThread_ProcessInput will unlock when playing to the decoders
-         * but will ensure it re-locks in the end. This is necessary to handle
-         * reloading, CC and packetizing. */
-        DecoderThread_ProcessInput( p_owner, frame );
+void vlc_input_decoder_PoolService( vlc_input_decoder_t *p_owner )
+{
+    vlc_tick_t cputime = input_stats_ThreadCpuTime();
 
-        if( p_owner->b_draining && frame == NULL )
-        {
-            p_owner->b_draining = false;
+    vlc_fifo_Lock( p_owner->p_fifo );
+    p_owner->b_idle = false;
 
-            if( p_owner->dec.fmt_in->i_cat == AUDIO_ES && p_owner->p_astream != NULL )
-            {   /* Draining: the decoder is drained and all decoded buffers are
-                 * queued to the output at this point. Now drain the output. */
-                vlc_aout_stream_Drain( p_owner->p_astream );
-            }
-        }
+    enum decoder_run run;
+    while( ( run = DecoderThread_RunOnce( p_owner, false ) )
+            == DECODER_RUN_AGAIN )
+    {
+        /* Same CPU time accounting as in DecoderThread() */
+        vlc_tick_t now = input_stats_ThreadCpuTime();
+        atomic_fetch_add_explicit( &p_owner->cpu_pending, now - cputime,
+                                   memory_order_relaxed );
+        cputime = now;
+    }
 
+    if( run == DECODER_RUN_IDLE )
+    {   /* Mimic the dedicated thread going to sleep, so that the deadlock
+         * prevention in vlc_input_decoder_Wait() keeps working. */
+        p_owner->b_idle = true;
         vlc_cond_signal( &p_owner->wait_acknowledge );
     }
-
     vlc_fifo_Unlock( p_owner->p_fifo );
-    return NULL;
+}
+
+/**
+ * Requests service from the worker pool, if the decoder uses it
+ *
+ * Called with the fifo locked, in place of (or in addition to) signaling
+ * the fifo for a dedicated decoder thread.
+ */
+static void PoolNotify( vlc_input_decoder_t *p_owner, vlc_tick_t deadline )
+{
+    if( p_owner->pool != NULL )
+        vlc_decoder_pool_Notify( p_owner->pool, &p_owner->pool_client,
+                                 deadline );
 }
 
 static const struct decoder_owner_callbacks dec_video_cbs =
@@ -1896,6 +2258,7 @@ static const struct decoder_owner_callbacks dec_video_cbs =
         .queue_cc = ModuleThread_QueueCc,
         .get_display_date = ModuleThread_GetDisplayDate,
         .get_display_rate = ModuleThread_GetDisplayRate,
+        .get_display_chroma = ModuleThread_GetDisplayChroma,
     },
     .get_attachments = InputThread_GetInputAttachments,
 };
@@ -1954,6 +2317,7 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
     p_owner->i_preroll_end = PREROLL_NONE;
     p_owner->p_resource = cfg->resource;
     p_owner->hw_dec = cfg->hw_dec;
+    p_owner->b_thread_budget = false;
     p_owner->cbs = cfg->cbs;
     p_owner->cbs_userdata = cfg->cbs_data;
     p_owner->p_aout = NULL;
@@ -1964,8 +2328,20 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
     p_owner->i_spu_order = 0;
     p_owner->p_sout = cfg->sout;
     p_owner->p_sout_input = NULL;
+    /* Already packetized frames can bypass the packetizer and go straight
+     * from the demuxer to the mux */
+    p_owner->b_sout_passthrough = cfg->sout != NULL && fmt->b_packetized;
     p_owner->p_packetizer = NULL;
 
+    p_owner->qos.enabled = fmt->i_cat == VIDEO_ES
+                        && var_InheritBool( p_parent, "frame-qos" );
+    if( unlikely(p_owner->qos.enabled) )
+    {
+        for( size_t i = 0; i < ARRAY_SIZE(p_owner->qos.ring); i++ )
+            p_owner->qos.ring[i].date = VLC_TICK_INVALID;
+        p_owner->qos.next = 0;
+    }
+
     p_owner->b_fmt_description = false;
     p_owner->p_description = NULL;
 
@@ -1985,6 +2361,8 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
     p_owner->b_draining = false;
     atomic_init( &p_owner->reload, RELOAD_NO_REQUEST );
     p_owner->b_idle = false;
+    atomic_init( &p_owner->cpu_pending, 0 );
+    p_owner->pool = NULL;
 
     p_owner->mouse_event = NULL;
     p_owner->mouse_opaque = NULL;
@@ -2046,6 +2424,10 @@ CreateDecoder( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
 
     /* Find a suitable decoder/packetizer module */
     decoder_Init(p_dec, &p_owner->dec_fmt_in, fmt);
+    if( fmt->i_cat == VIDEO_ES && cfg->input_type == INPUT_TYPE_THUMBNAILING )
+        p_dec->b_thumbnailing = true;
+    if( fmt->i_cat == VIDEO_ES )
+        DecoderAcquireThreadBudget( p_owner );
     if (LoadDecoder(p_dec, cfg->sout != NULL, &p_owner->dec_fmt_in))
         return p_owner;
 
@@ -2100,6 +2482,8 @@ static void DeleteDecoder( vlc_input_decoder_t *p_owner, enum es_format_category
 
     decoder_Clean( p_dec );
 
+    DecoderReleaseThreadBudget( p_owner );
+
     if ( p_owner->out_pool )
     {
         picture_pool_Release( p_owner->out_pool );
@@ -2243,8 +2627,22 @@ decoder_New( vlc_object_t *p_parent, const struct vlc_input_decoder_cfg *cfg )
 
     if( !vlc_input_decoder_IsSynchronous( p_owner ) )
     {
+        /* Lightweight ES can be multiplexed onto the shared worker pool
+         * instead of getting a dedicated thread, cf. "dec-workers". */
+        if( p_dec->fmt_in->i_cat == AUDIO_ES || p_dec->fmt_in->i_cat == SPU_ES )
+            p_owner->pool = vlc_decoder_pool_Get( p_parent );
+
+        if( p_owner->pool != NULL )
+        {
+            vlc_decoder_pool_Attach( p_owner->pool, &p_owner->pool_client,
+                                     p_owner );
+            /* The pool services the decoder on demand: flag it idle so
+             * that vlc_input_decoder_Wait() does not wait for a wake-up
+             * that will not come. */
+            p_owner->b_idle = true;
+        }
         /* Spawn the decoder thread in asynchronous scenario. */
-        if( vlc_clone( &p_owner->thread, DecoderThread, p_owner ) )
+        else if( vlc_clone( &p_owner->thread, DecoderThread, p_owner ) )
         {
             msg_Err( p_dec, "cannot spawn decoder thread" );
             DeleteDecoder( p_owner, p_dec->fmt_in->i_cat );
@@ -2319,7 +2717,12 @@ void vlc_input_decoder_Delete( vlc_input_decoder_t *p_owner )
     vlc_fifo_Unlock( p_owner->p_fifo );
 
     if( !vlc_input_decoder_IsSynchronous( p_owner ) )
-        vlc_join( p_owner->thread, NULL );
+    {
+        if( p_owner->pool != NULL )
+            vlc_decoder_pool_Detach( p_owner->pool, &p_owner->pool_client );
+        else
+            vlc_join( p_owner->thread, NULL );
+    }
 
 #ifndef NDEBUG
     vlc_mutex_lock(&p_owner->subdecs.lock);
@@ -2430,6 +2833,8 @@ void vlc_input_decoder_DecodeWithStatus(vlc_input_decoder_t *p_owner, vlc_frame_
         /* DecoderThread's fifo should be empty as no decoder thread is running. */
         assert( vlc_fifo_IsEmpty( p_owner->p_fifo ) );
         vlc_fifo_Lock(p_owner->p_fifo);
+        if( unlikely(p_owner->qos.enabled) )
+            FrameQosStamp( p_owner, frame, VLC_FRAME_QOS_DEMUX_OUT );
         DecoderThread_ProcessInput( p_owner, frame );
         if (status != NULL)
             GetStatusLocked(p_owner, status);
@@ -2460,7 +2865,16 @@ void vlc_input_decoder_DecodeWithStatus(vlc_input_decoder_t *p_owner, vlc_frame_
             vlc_fifo_WaitCond( p_owner->p_fifo, &p_owner->wait_fifo );
     }
 
+    /* The earliest pending frame date drives the worker pool scheduling */
+    vlc_tick_t deadline = frame->i_pts != VLC_TICK_INVALID ? frame->i_pts
+                        : frame->i_dts != VLC_TICK_INVALID ? frame->i_dts
+                        : VLC_DECODER_POOL_NOW;
+
+    if( unlikely(p_owner->qos.enabled) )
+        FrameQosStamp( p_owner, frame, VLC_FRAME_QOS_DEMUX_OUT );
+
     vlc_fifo_QueueUnlocked( p_owner->p_fifo, frame );
+    PoolNotify( p_owner, deadline );
     if (status != NULL)
         GetStatusLocked(p_owner, status);
     vlc_fifo_Unlock( p_owner->p_fifo );
@@ -2512,6 +2926,7 @@ void vlc_input_decoder_Drain( vlc_input_decoder_t *p_owner )
     vlc_fifo_Lock( p_owner->p_fifo );
     p_owner->b_draining = true;
     vlc_fifo_Signal( p_owner->p_fifo );
+    PoolNotify( p_owner, VLC_DECODER_POOL_NOW );
     vlc_fifo_Unlock( p_owner->p_fifo );
 }
 
@@ -2559,6 +2974,7 @@ void vlc_input_decoder_Flush( vlc_input_decoder_t *p_owner )
         }
     }
     vlc_fifo_Signal( p_owner->p_fifo );
+    PoolNotify( p_owner, VLC_DECODER_POOL_NOW );
 
     if (unlikely(p_owner->b_waiting && p_owner->b_has_data))
     {
@@ -2632,6 +3048,7 @@ void vlc_input_decoder_ChangePause( vlc_input_decoder_t *p_owner,
     p_owner->pause_date = i_date;
     p_owner->frames_countdown = 0;
     vlc_fifo_Signal( p_owner->p_fifo );
+    PoolNotify( p_owner, VLC_DECODER_POOL_NOW );
     vlc_fifo_Unlock( p_owner->p_fifo );
 }
 
@@ -2639,6 +3056,7 @@ void vlc_input_decoder_ChangeRate( vlc_input_decoder_t *owner, float rate )
 {
     vlc_fifo_Lock( owner->p_fifo );
     owner->rate = rate;
+    PoolNotify( owner, VLC_DECODER_POOL_NOW );
     vlc_fifo_Unlock( owner->p_fifo );
 }
 
@@ -2646,6 +3064,7 @@ void vlc_input_decoder_ChangeDelay( vlc_input_decoder_t *owner, vlc_tick_t delay
 {
     vlc_fifo_Lock( owner->p_fifo );
     owner->delay = delay;
+    PoolNotify( owner, VLC_DECODER_POOL_NOW );
     vlc_fifo_Unlock( owner->p_fifo );
 }
 
@@ -2706,6 +3125,7 @@ void vlc_input_decoder_FrameNext( vlc_input_decoder_t *p_owner )
     vlc_fifo_Lock( p_owner->p_fifo );
     p_owner->frames_countdown++;
     vlc_fifo_Signal( p_owner->p_fifo );
+    PoolNotify( p_owner, VLC_DECODER_POOL_NOW );
     vlc_fifo_Unlock( p_owner->p_fifo );
 
     vlc_fifo_Lock(p_owner->p_fifo);
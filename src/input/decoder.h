@@ -40,11 +40,14 @@ struct vlc_input_decoder_callbacks {
     void (*on_thumbnail_ready)(vlc_input_decoder_t *decoder, picture_t *pic,
                                void *userdata);
 
+    /* cputime is the CPU time consumed by the decoder thread since the last
+     * notification, cf. input_stats_ThreadCpuTime() */
     void (*on_new_video_stats)(vlc_input_decoder_t *decoder, unsigned decoded,
                                unsigned lost, unsigned displayed, unsigned late,
-                               void *userdata);
+                               vlc_tick_t cputime, void *userdata);
     void (*on_new_audio_stats)(vlc_input_decoder_t *decoder, unsigned decoded,
-                               unsigned lost, unsigned played, void *userdata);
+                               unsigned lost, unsigned played,
+                               vlc_tick_t cputime, void *userdata);
 
     /* requests */
     int (*get_attachments)(vlc_input_decoder_t *decoder,
@@ -0,0 +1,225 @@
+/*****************************************************************************
+ * decoder_pool.c: shared decoder worker pool
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_decoder.h>
+
+#include "decoder_pool.h"
+#include "libvlc.h"
+
+struct vlc_decoder_pool
+{
+    vlc_mutex_t lock;
+    /* Signals ready list insertions, service completions and closing.
+     * Shared by workers and vlc_decoder_pool_Detach(), hence always
+     * broadcast. */
+    vlc_cond_t wait;
+    struct vlc_list ready; /**< clients waiting for a worker */
+    bool closing;
+    unsigned nthreads;
+    vlc_thread_t threads[];
+};
+
+static void *DecoderPoolThread(void *data)
+{
+    vlc_decoder_pool_t *pool = data;
+
+    vlc_thread_set_name("vlc-dec-pool");
+
+    vlc_mutex_lock(&pool->lock);
+    for (;;)
+    {
+        struct vlc_decoder_pool_client *client = NULL, *it;
+
+        /* Earliest deadline first. The ready list stays short (bounded
+         * by the attached decoder count), a linear scan is fine. */
+        vlc_list_foreach(it, &pool->ready, node)
+            if (client == NULL || it->deadline < client->deadline)
+                client = it;
+
+        if (client == NULL)
+        {
+            if (pool->closing)
+                break;
+            vlc_cond_wait(&pool->wait, &pool->lock);
+            continue;
+        }
+
+        vlc_list_remove(&client->node);
+        client->queued = false;
+        client->running = true;
+        client->pending = false;
+        vlc_mutex_unlock(&pool->lock);
+
+        vlc_input_decoder_PoolService(client->owner);
+
+        vlc_mutex_lock(&pool->lock);
+        client->running = false;
+        if (client->pending && client->attached)
+        {   /* Notified during the service: run it again. */
+            client->queued = true;
+            vlc_list_append(&client->node, &pool->ready);
+        }
+        vlc_cond_broadcast(&pool->wait);
+    }
+    vlc_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Guards the lazy creation of the per-instance pool singleton */
+static vlc_mutex_t pool_creation_lock = VLC_STATIC_MUTEX;
+
+vlc_decoder_pool_t *vlc_decoder_pool_Get(vlc_object_t *obj)
+{
+    int64_t workers = var_InheritInteger(obj, "dec-workers");
+    if (workers <= 0)
+        return NULL;
+
+    libvlc_priv_t *priv = libvlc_priv(vlc_object_instance(obj));
+
+    vlc_mutex_lock(&pool_creation_lock);
+    vlc_decoder_pool_t *pool = priv->decoder_pool;
+    if (pool == NULL)
+    {
+        pool = malloc(sizeof (*pool)
+                      + workers * sizeof (pool->threads[0]));
+        if (likely(pool != NULL))
+        {
+            vlc_mutex_init(&pool->lock);
+            vlc_cond_init(&pool->wait);
+            vlc_list_init(&pool->ready);
+            pool->closing = false;
+            pool->nthreads = 0;
+
+            for (int64_t i = 0; i < workers; i++)
+            {
+                if (vlc_clone(&pool->threads[pool->nthreads],
+                              DecoderPoolThread, pool))
+                    break;
+                pool->nthreads++;
+            }
+
+            if (pool->nthreads > 0)
+            {
+                msg_Dbg(obj, "using decoder worker pool (%u threads)",
+                        pool->nthreads);
+                priv->decoder_pool = pool;
+            }
+            else
+            {
+                free(pool);
+                pool = NULL;
+            }
+        }
+    }
+    vlc_mutex_unlock(&pool_creation_lock);
+    return pool;
+}
+
+void vlc_decoder_pool_Destroy(libvlc_int_t *libvlc)
+{
+    libvlc_priv_t *priv = libvlc_priv(libvlc);
+    vlc_decoder_pool_t *pool = priv->decoder_pool;
+
+    if (pool == NULL)
+        return;
+    priv->decoder_pool = NULL;
+
+    vlc_mutex_lock(&pool->lock);
+    /* All decoders are deleted by now, so the ready list is empty and
+     * the workers exit as soon as they wake up. */
+    assert(vlc_list_is_empty(&pool->ready));
+    pool->closing = true;
+    vlc_cond_broadcast(&pool->wait);
+    vlc_mutex_unlock(&pool->lock);
+
+    for (unsigned i = 0; i < pool->nthreads; i++)
+        vlc_join(pool->threads[i], NULL);
+    free(pool);
+}
+
+void vlc_decoder_pool_Attach(vlc_decoder_pool_t *pool,
+                             struct vlc_decoder_pool_client *client,
+                             vlc_input_decoder_t *owner)
+{
+    /* The client is not reachable by the workers until the first
+     * vlc_decoder_pool_Notify(), no need for the pool lock here. */
+    (void) pool;
+    client->owner = owner;
+    client->deadline = VLC_TICK_MAX;
+    client->queued = false;
+    client->running = false;
+    client->pending = false;
+    client->attached = true;
+}
+
+void vlc_decoder_pool_Detach(vlc_decoder_pool_t *pool,
+                             struct vlc_decoder_pool_client *client)
+{
+    vlc_mutex_lock(&pool->lock);
+    client->attached = false;
+    client->pending = false;
+    if (client->queued)
+    {
+        vlc_list_remove(&client->node);
+        client->queued = false;
+    }
+    /* The ongoing service holds a reference to the decoder, wait for
+     * it. This cannot last: the decoder is aborting by now so the
+     * service loop bails out at the next step. */
+    while (client->running)
+        vlc_cond_wait(&pool->wait, &pool->lock);
+    vlc_mutex_unlock(&pool->lock);
+}
+
+void vlc_decoder_pool_Notify(vlc_decoder_pool_t *pool,
+                             struct vlc_decoder_pool_client *client,
+                             vlc_tick_t deadline)
+{
+    vlc_mutex_lock(&pool->lock);
+    assert(client->attached);
+
+    if (client->running)
+    {
+        client->pending = true;
+        if (deadline < client->deadline)
+            client->deadline = deadline;
+    }
+    else if (client->queued)
+    {
+        if (deadline < client->deadline)
+            client->deadline = deadline;
+    }
+    else
+    {
+        client->deadline = deadline;
+        client->queued = true;
+        vlc_list_append(&client->node, &pool->ready);
+        vlc_cond_broadcast(&pool->wait);
+    }
+    vlc_mutex_unlock(&pool->lock);
+}
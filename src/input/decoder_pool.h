@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * decoder_pool.h: shared decoder worker pool
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef LIBVLC_INPUT_DECODER_POOL_H
+#define LIBVLC_INPUT_DECODER_POOL_H 1
+
+#include <vlc_decoder.h>
+#include <vlc_list.h>
+
+/**
+ * \file src/input/decoder_pool.h
+ *
+ * Shared worker pool multiplexing lightweight (audio, subtitles)
+ * elementary stream decoders onto a fixed number of threads, instead of
+ * one dedicated thread per ES. The pool is a per-libvlc-instance
+ * singleton, created on first use when the "dec-workers" option is
+ * positive, and sized by that option.
+ *
+ * Scheduling is deadline-driven: each service request carries the date
+ * of the earliest pending frame, and workers always pick the attached
+ * decoder with the earliest deadline next.
+ */
+
+typedef struct vlc_decoder_pool vlc_decoder_pool_t;
+
+/**
+ * Per-decoder pool bookkeeping, embedded in the input decoder.
+ *
+ * All fields except \ref owner are guarded by the pool lock.
+ */
+struct vlc_decoder_pool_client
+{
+    vlc_input_decoder_t *owner;
+    struct vlc_list node; /**< node in the pool ready list, if queued */
+    vlc_tick_t deadline;
+    bool queued;   /**< waiting in the ready list for a worker */
+    bool running;  /**< currently serviced by a worker */
+    bool pending;  /**< notified while running, needs another service */
+    bool attached;
+};
+
+/** Deadline requesting service as soon as possible, e.g. for control
+ * requests that are not tied to a frame date. */
+#define VLC_DECODER_POOL_NOW VLC_TICK_MIN
+
+/**
+ * Returns the shared decoder pool of the libvlc instance.
+ *
+ * The pool is created on first call. This fails gracefully: worker pool
+ * mode is merely an optimization and the caller falls back to a
+ * dedicated decoder thread.
+ *
+ * \return the pool, or NULL if "dec-workers" is zero or on error
+ */
+vlc_decoder_pool_t *vlc_decoder_pool_Get(vlc_object_t *obj);
+
+/**
+ * Joins the pool workers and destroys the pool, if any.
+ *
+ * All clients must have been detached beforehand, i.e. this must run
+ * after every input decoder of the instance has been deleted.
+ */
+void vlc_decoder_pool_Destroy(libvlc_int_t *libvlc);
+
+/**
+ * Registers a decoder with the pool.
+ *
+ * Must be called before the first vlc_decoder_pool_Notify() for this
+ * client. No service runs until the decoder is notified.
+ */
+void vlc_decoder_pool_Attach(vlc_decoder_pool_t *pool,
+                             struct vlc_decoder_pool_client *client,
+                             vlc_input_decoder_t *owner);
+
+/**
+ * Unregisters a decoder from the pool.
+ *
+ * Cancels any queued service request and waits for an ongoing service
+ * to complete, so that no worker references the decoder on return.
+ */
+void vlc_decoder_pool_Detach(vlc_decoder_pool_t *pool,
+                             struct vlc_decoder_pool_client *client);
+
+/**
+ * Requests (more) service for a decoder.
+ *
+ * Can be called with the decoder fifo locked. Requests coalesce: the
+ * earliest deadline wins, and a notification during an ongoing service
+ * schedules exactly one more.
+ *
+ * \param deadline date of the earliest pending frame, or
+ *                 VLC_DECODER_POOL_NOW
+ */
+void vlc_decoder_pool_Notify(vlc_decoder_pool_t *pool,
+                             struct vlc_decoder_pool_client *client,
+                             vlc_tick_t deadline);
+
+/**
+ * Runs the decoding loop of a pool-scheduled decoder until it goes
+ * idle. Implemented in decoder.c, called from the pool workers.
+ */
+void vlc_input_decoder_PoolService(vlc_input_decoder_t *owner);
+
+#endif
@@ -28,6 +28,7 @@
 #include <limits.h>
 
 #include "demux.h"
+#include "stream.h"
 #include <libvlc.h>
 #include <vlc_codec.h>
 #include <vlc_configuration.h>
@@ -35,6 +36,9 @@
 #include <vlc_url.h>
 #include <vlc_modules.h>
 #include <vlc_strings.h>
+#include <vlc_fs.h>
+#include <vlc_tracer.h>
+#include <sys/stat.h>
 #include "input_internal.h"
 
 typedef const struct
@@ -177,6 +181,32 @@ demux_t *demux_NewAdvanced( vlc_object_t *p_obj, input_thread_t *p_input,
         strict = false;
     }
 
+    /* Look up the persistent probe cache for unchanged local files */
+    char *cached = NULL;
+    uint64_t cache_mtime = 0, cache_size = 0;
+    bool cacheable = false;
+
+    if (strcasecmp(module, "any") == 0 && p_demux->psz_filepath != NULL
+     && var_InheritBool(p_obj, "demux-probe-cache"))
+    {
+        struct stat st;
+
+        if (vlc_stat(p_demux->psz_filepath, &st) == 0 && S_ISREG(st.st_mode))
+        {
+            cacheable = true;
+            cache_mtime = st.st_mtime;
+            cache_size = st.st_size;
+            cached = demux_CacheLookup(p_demux->psz_filepath,
+                                       cache_mtime, cache_size);
+            if (cached != NULL)
+            {   /* Probe the previous winner first, fall back on the
+                 * normal probe loop if it no longer accepts the file. */
+                module = cached;
+                strict = false;
+            }
+        }
+    }
+
     if (strcasecmp(module, "any") == 0 && p_demux->psz_filepath != NULL)
     {
         const char *ext = strrchr(p_demux->psz_filepath, '.');
@@ -193,12 +223,25 @@ demux_t *demux_NewAdvanced( vlc_object_t *p_obj, input_thread_t *p_input,
         strict = false;
     }
 
+    if (!strict)
+        /* Several demuxers will be probed: read the probe window once so
+         * that all of them peek from the cache */
+        stream_ProbePrefetch(s);
+
     priv->module = vlc_module_load(vlc_object_logger(p_demux), "demux", module,
                                    strict, demux_Probe, p_demux);
     free(modbuf);
 
     if (priv->module == NULL)
+    {
+        free(cached);
         goto error;
+    }
+
+    if (cacheable)
+        demux_CacheStore(p_demux->psz_filepath, cache_mtime, cache_size,
+                         module_get_object(priv->module));
+    free(cached);
 
     var_Create(p_demux, "module-name", VLC_VAR_STRING);
     var_SetString(p_demux, "module-name", module_get_object(priv->module));
@@ -217,10 +260,43 @@ static int demux_ReadDir( stream_t *s, input_item_node_t *p_node )
     return (s->ops != NULL ? s->ops->demux.readdir : s->pf_readdir)( s, p_node );
 }
 
+/* input_item_node_Flush() backend: detach the children gathered so far into
+ * a fresh subtree and post it, so that large playlists become playable while
+ * their tail is still being parsed. */
+static void demux_ReadDirFlush( input_item_node_t *node, void *opaque )
+{
+    demux_t *demux = opaque;
+    input_item_node_t *sub = input_item_node_Create(demux->p_input_item);
+
+    if (unlikely(sub == NULL))
+        return; /* children stay queued for the final post */
+
+    sub->i_children = node->i_children;
+    sub->pp_children = node->pp_children;
+    node->i_children = 0;
+    node->pp_children = NULL;
+
+    if (es_out_Control(demux->out, ES_OUT_POST_SUBNODE, sub))
+        input_item_node_Delete(sub);
+}
+
 int demux_Demux(demux_t *demux)
 {
     if (demux->pf_demux != NULL || (demux->ops != NULL && demux->ops->demux.demux != NULL))
-        return (demux->ops != NULL ? demux->ops->demux.demux : demux->pf_demux)(demux);
+    {
+        int (*pf_demux)(demux_t *) =
+            demux->ops != NULL ? demux->ops->demux.demux : demux->pf_demux;
+        struct vlc_tracer *tracer = vlc_object_get_tracer(VLC_OBJECT(demux));
+
+        if (tracer == NULL)
+            return pf_demux(demux);
+
+        const char *id = demux->psz_url != NULL ? demux->psz_url : "demux";
+        vlc_tracer_TraceSpanBegin(tracer, "DMX", id, "demux", 0);
+        int ret = pf_demux(demux);
+        vlc_tracer_TraceSpanEnd(tracer, "DMX", id, "demux", 0);
+        return ret;
+    }
 
     if ((demux->pf_readdir != NULL || (demux->ops != NULL && demux->ops->demux.readdir != NULL)) && demux->p_input_item != NULL) {
         input_item_node_t *node = input_item_node_Create(demux->p_input_item);
@@ -228,6 +304,9 @@ int demux_Demux(demux_t *demux)
         if (unlikely(node == NULL))
             return VLC_DEMUXER_EGENERIC;
 
+        node->pf_flush = demux_ReadDirFlush;
+        node->p_flush_opaque = demux;
+
         if (demux_ReadDir(demux, node)) {
              input_item_node_Delete(node);
              return VLC_DEMUXER_EGENERIC;
@@ -241,6 +320,14 @@ int demux_Demux(demux_t *demux)
     return VLC_DEMUXER_SUCCESS;
 }
 
+int demux_SendBatch(demux_t *demux, es_out_id_t *id, block_t *chain)
+{
+    if (chain == NULL)
+        return VLC_SUCCESS;
+
+    return es_out_SendBatch(demux->out, id, chain);
+}
+
 #define static_control_match(foo) \
     static_assert((unsigned) DEMUX_##foo == STREAM_##foo, "Mismatch")
 
@@ -35,6 +35,21 @@ demux_t *demux_NewAdvanced( vlc_object_t *p_obj, input_thread_t *p_parent_input,
                             stream_t *s, es_out_t *out, bool );
 
 unsigned demux_TestAndClearFlags( demux_t *, unsigned );
+
+/**
+ * Looks up the persistent demuxer probe cache.
+ *
+ * @return the name of the demuxer that last accepted this (path, mtime,
+ * size) triplet, to be released with free(), or NULL on cache miss.
+ */
+char *demux_CacheLookup( const char *filepath, uint64_t mtime,
+                         uint64_t size ) VLC_USED;
+
+/**
+ * Records the winning demuxer for a file in the persistent probe cache.
+ */
+void demux_CacheStore( const char *filepath, uint64_t mtime, uint64_t size,
+                       const char *module );
 int demux_GetTitle( demux_t * );
 int demux_GetSeekpoint( demux_t * );
 
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * demux_cache.c: persistent demuxer probe cache
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_configuration.h>
+#include <vlc_fs.h>
+
+#include "demux.h"
+
+/* One line per probed file, most recent entry last:
+ *   <mtime> <size> <module> <path>
+ * The path comes last so that it may contain spaces. The file is append-only
+ * at run time; stale entries for a path are simply superseded by later ones
+ * and dropped whenever the cache is rewritten because it grew too large. */
+#define DEMUX_CACHE_FILE   "demux-probe-cache"
+#define DEMUX_CACHE_MAX    (1u << 20)
+
+static char *demux_CacheGetPath(void)
+{
+    char *cachedir = config_GetUserDir(VLC_CACHE_DIR);
+    char *path;
+
+    if (unlikely(cachedir == NULL))
+        return NULL;
+
+    if (asprintf(&path, "%s" DIR_SEP DEMUX_CACHE_FILE, cachedir) == -1)
+        path = NULL;
+    free(cachedir);
+    return path;
+}
+
+char *demux_CacheLookup(const char *filepath, uint64_t mtime, uint64_t size)
+{
+    char *cachepath = demux_CacheGetPath();
+    if (cachepath == NULL)
+        return NULL;
+
+    FILE *stream = vlc_fopen(cachepath, "rt");
+    free(cachepath);
+    if (stream == NULL)
+        return NULL;
+
+    char *module = NULL;
+    char *line = NULL;
+    size_t linecap = 0;
+    ssize_t linelen;
+
+    while ((linelen = getline(&line, &linecap, stream)) >= 0)
+    {
+        if (linelen > 0 && line[linelen - 1] == '\n')
+            line[--linelen] = '\0';
+
+        uint64_t entry_mtime, entry_size;
+        int offset;
+
+        if (sscanf(line, "%"SCNu64" %"SCNu64" %n",
+                   &entry_mtime, &entry_size, &offset) != 2)
+            continue;
+
+        char *entry_path = strchr(line + offset, ' ');
+        if (entry_path == NULL)
+            continue;
+        *(entry_path++) = '\0';
+
+        if (strcmp(entry_path, filepath) != 0)
+            continue;
+
+        /* Later entries supersede earlier ones */
+        free(module);
+        module = NULL;
+        if (entry_mtime == mtime && entry_size == size)
+            module = strdup(line + offset);
+    }
+
+    free(line);
+    fclose(stream);
+    return module;
+}
+
+void demux_CacheStore(const char *filepath, uint64_t mtime, uint64_t size,
+                      const char *module)
+{
+    char *cachepath = demux_CacheGetPath();
+    if (cachepath == NULL)
+        return;
+
+    /* Drop oversized caches rather than scanning them forever */
+    struct stat st;
+    if (vlc_stat(cachepath, &st) == 0 && st.st_size > DEMUX_CACHE_MAX)
+        vlc_unlink(cachepath);
+
+    FILE *stream = vlc_fopen(cachepath, "at");
+    free(cachepath);
+    if (stream == NULL)
+        return;
+
+    fprintf(stream, "%"PRIu64" %"PRIu64" %s %s\n", mtime, size, module,
+            filepath);
+    fclose(stream);
+}
@@ -29,8 +29,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <vlc_common.h>
+#include <vlc_block.h>
 #include <vlc_demux.h>
 #include "demux.h"
+#include "stream.h"
 
 struct vlc_demux_chained_t
 {
@@ -40,6 +42,16 @@ struct vlc_demux_chained_t
     vlc_thread_t thread;
     vlc_mutex_t  lock;
 
+    /* Pull mode (writer is NULL): the inner demuxer runs on the caller
+     * thread of vlc_demux_chained_Send(). */
+    bool pull;
+    bool failed;
+    demux_t *demux;
+    block_t *chain;
+    block_t **pp_chain_last;
+    size_t avail;
+    vlc_tick_t next_update;
+
     struct
     {
         double  position;
@@ -99,6 +111,166 @@ static void *vlc_demux_chained_Thread(void *data)
     return NULL;
 }
 
+/* Do not probe the inner demuxer until that much input is buffered, so that
+ * format detection does not fail on a truncated peek (e.g. a few MPEG-TS
+ * packets or an Ogg page). */
+#define VLC_DEMUX_CHAINED_PULL_MIN 4096
+
+struct vlc_demux_chained_pull_private
+{
+    vlc_demux_chained_t *dc;
+};
+
+static void vlc_demux_chained_PullDestroy(stream_t *s)
+{
+    (void) s; /* The block chain belongs to the chained demuxer */
+}
+
+static block_t *vlc_demux_chained_PullBlock(stream_t *s, bool *restrict eof)
+{
+    struct vlc_demux_chained_pull_private *sys = vlc_stream_Private(s);
+    vlc_demux_chained_t *dc = sys->dc;
+    block_t *block = dc->chain;
+
+    if (block == NULL)
+    {   /* Starved: report a transient end-of-stream. The stream layer does
+         * not latch it, so demuxing resumes once more data is queued. */
+        *eof = true;
+        return NULL;
+    }
+
+    dc->chain = block->p_next;
+    if (dc->chain == NULL)
+        dc->pp_chain_last = &dc->chain;
+    block->p_next = NULL;
+    dc->avail -= block->i_buffer;
+    return block;
+}
+
+static int vlc_demux_chained_PullStreamControl(stream_t *s, int query,
+                                               va_list ap)
+{
+    (void) s;
+
+    switch (query)
+    {
+        case STREAM_CAN_SEEK:
+        case STREAM_CAN_FASTSEEK:
+        case STREAM_CAN_PAUSE:
+        case STREAM_CAN_CONTROL_PACE:
+            *va_arg(ap, bool *) = false;
+            break;
+
+        case STREAM_GET_PTS_DELAY:
+            *va_arg(ap, vlc_tick_t *) = DEFAULT_PTS_DELAY;
+            break;
+
+        default:
+            return VLC_EGENERIC;
+    }
+    return VLC_SUCCESS;
+}
+
+static void vlc_demux_chained_PullDemux(vlc_demux_chained_t *dc, bool force)
+{
+    if (dc->failed)
+        return;
+
+    if (dc->demux == NULL)
+    {
+        if (dc->avail < VLC_DEMUX_CHAINED_PULL_MIN && !force)
+            return;
+
+        dc->demux = demux_New(VLC_OBJECT(dc->reader), dc->name, "vlc://nop",
+                              dc->reader, dc->out);
+        if (dc->demux == NULL)
+        {
+            vlc_stream_Delete(dc->reader);
+            dc->reader = NULL;
+            dc->failed = true;
+            return;
+        }
+
+        /* The input stream cannot apply DVB filters.
+         * Get all programs and let the E/S output sort them out. */
+        demux_Control(dc->demux, DEMUX_SET_GROUP_ALL);
+    }
+
+    int ret;
+
+    do
+    {
+        if (demux_TestAndClearFlags(dc->demux, UINT_MAX)
+         || vlc_tick_now() >= dc->next_update)
+        {
+            double newpos;
+            vlc_tick_t newlen;
+            vlc_tick_t newtime;
+
+            if (demux_Control(dc->demux, DEMUX_GET_POSITION, &newpos))
+                newpos = 0.;
+            if (demux_Control(dc->demux, DEMUX_GET_LENGTH, &newlen))
+                newlen = 0;
+            if (demux_Control(dc->demux, DEMUX_GET_TIME, &newtime))
+                newtime = 0;
+
+            vlc_mutex_lock(&dc->lock);
+            dc->stats.position = newpos;
+            dc->stats.length = newlen;
+            dc->stats.time = newtime;
+            vlc_mutex_unlock(&dc->lock);
+
+            dc->next_update = vlc_tick_now() + VLC_TICK_FROM_MS(250);
+        }
+
+        ret = demux_Demux(dc->demux);
+    }
+    while (ret > 0);
+
+    if (ret < 0)
+        dc->failed = true;
+}
+
+vlc_demux_chained_t *vlc_demux_chained_NewPull(vlc_object_t *parent,
+                                               const char *name, es_out_t *out)
+{
+    vlc_demux_chained_t *dc = malloc(sizeof (*dc) + strlen(name) + 1);
+    if (unlikely(dc == NULL))
+        return NULL;
+
+    struct vlc_demux_chained_pull_private *sys;
+    dc->reader = vlc_stream_CustomNew(parent, vlc_demux_chained_PullDestroy,
+                                      sizeof (*sys), "stream");
+    if (unlikely(dc->reader == NULL))
+    {
+        free(dc);
+        return NULL;
+    }
+
+    sys = vlc_stream_Private(dc->reader);
+    sys->dc = dc;
+    dc->reader->pf_block = vlc_demux_chained_PullBlock;
+    dc->reader->pf_seek = NULL;
+    dc->reader->pf_control = vlc_demux_chained_PullStreamControl;
+
+    dc->writer = NULL;
+    dc->pull = true;
+    dc->failed = false;
+    dc->demux = NULL;
+    dc->chain = NULL;
+    dc->pp_chain_last = &dc->chain;
+    dc->avail = 0;
+    dc->next_update = 0;
+    dc->stats.position = 0.;
+    dc->stats.length = 0;
+    dc->stats.time = 0;
+    dc->out = out;
+    strcpy(dc->name, name);
+
+    vlc_mutex_init(&dc->lock);
+    return dc;
+}
+
 vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
                                            const char *name, es_out_t *out)
 {
@@ -113,6 +285,7 @@ vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
         return NULL;
     }
 
+    dc->pull = false;
     dc->stats.position = 0.;
     dc->stats.length = 0;
     dc->stats.time = 0;
@@ -133,6 +306,22 @@ vlc_demux_chained_t *vlc_demux_chained_New(vlc_object_t *parent,
 
 void vlc_demux_chained_Send(vlc_demux_chained_t *dc, block_t *block)
 {
+    if (dc->pull)
+    {
+        if (dc->failed)
+        {
+            block_ChainRelease(block);
+            return;
+        }
+
+        for (block_t *b = block; b != NULL; b = b->p_next)
+            dc->avail += b->i_buffer;
+        block_ChainLastAppend(&dc->pp_chain_last, block);
+
+        vlc_demux_chained_PullDemux(dc, false);
+        return;
+    }
+
     vlc_stream_fifo_Queue(dc->writer, block);
 }
 
@@ -163,6 +352,23 @@ int vlc_demux_chained_ControlVa(vlc_demux_chained_t *dc, int query, va_list ap)
 
 void vlc_demux_chained_Delete(vlc_demux_chained_t *dc)
 {
+    if (dc->pull)
+    {
+        /* Drain data still queued, forcing the demuxer open if the whole
+         * stream was shorter than the probing threshold. */
+        if (dc->chain != NULL)
+            vlc_demux_chained_PullDemux(dc, true);
+
+        if (dc->demux != NULL)
+            demux_Delete(dc->demux); /* also deletes dc->reader */
+        else if (dc->reader != NULL)
+            vlc_stream_Delete(dc->reader);
+
+        block_ChainRelease(dc->chain);
+        free(dc);
+        return;
+    }
+
     vlc_stream_fifo_Close(dc->writer);
     vlc_join(dc->thread, NULL);
     free(dc);
@@ -168,6 +168,7 @@ typedef struct
 
     /* Parameters used for es selection */
     bool        b_autoselect; /* if we want to select an es when no user prefs */
+    bool        b_on_demand;  /* don't auto-create decoders, wait for an explicit selection */
     char        *str_ids; /* List of string id generated by EsOutCreateStrId() (delimited by ',') */
     int         i_demux_id; /* same as previous, demuxer set default value */
     int         i_channel;  /* es number in creation order */
@@ -186,6 +187,9 @@ typedef struct
 
     /* all programs */
     struct vlc_list programs;
+    /* Programs ordered by (source, id) for binary search lookups; TS
+     * captures can carry hundreds of programs, each PCR needs a lookup */
+    struct VLC_VECTOR(es_out_pgrm_t *) pgrm_index;
     es_out_pgrm_t *p_pgrm;  /* Master program */
 
     enum vlc_clock_master_source user_clock_source;
@@ -230,6 +234,13 @@ typedef struct
     vlc_tick_t  i_buffering_extra_stream;
     vlc_tick_t  i_buffering_extra_system;
 
+    /* Adaptive buffering policy (--adaptive-caching) */
+    bool        b_adaptive_caching;
+    unsigned    i_rebuffer_count;
+    vlc_tick_t  i_last_rebuffer_date;
+    float       f_fill_rate_avg; /* running mean of buffering fill rate */
+    float       f_fill_rate_var; /* running variance of the fill rate */
+
     /* Record */
     sout_stream_t *p_sout_record;
 
@@ -422,7 +433,8 @@ decoder_on_thumbnail_ready(vlc_input_decoder_t *decoder, picture_t *pic, void *u
 
 static void
 decoder_on_new_video_stats(vlc_input_decoder_t *decoder, unsigned decoded, unsigned lost,
-                           unsigned displayed, unsigned late, void *userdata)
+                           unsigned displayed, unsigned late,
+                           vlc_tick_t cputime, void *userdata)
 {
     (void) decoder;
 
@@ -445,11 +457,13 @@ decoder_on_new_video_stats(vlc_input_decoder_t *decoder, unsigned decoded, unsig
                               memory_order_relaxed);
     atomic_fetch_add_explicit(&stats->late_pictures, late,
                               memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->decoder_cpu, cputime,
+                              memory_order_relaxed);
 }
 
 static void
 decoder_on_new_audio_stats(vlc_input_decoder_t *decoder, unsigned decoded, unsigned lost,
-                           unsigned played, void *userdata)
+                           unsigned played, vlc_tick_t cputime, void *userdata)
 {
     (void) decoder;
 
@@ -470,6 +484,8 @@ decoder_on_new_audio_stats(vlc_input_decoder_t *decoder, unsigned decoded, unsig
                               memory_order_relaxed);
     atomic_fetch_add_explicit(&stats->played_abuffers, played,
                               memory_order_relaxed);
+    atomic_fetch_add_explicit(&stats->decoder_cpu, cputime,
+                              memory_order_relaxed);
 }
 
 static int
@@ -538,6 +554,7 @@ static void EsOutPropsInit( es_out_es_props_t *p_props,
     p_props->e_policy = e_default_policy;
     p_props->i_count = 0;
     p_props->b_autoselect = autoselect;
+    p_props->b_on_demand = false;
     p_props->str_ids = (psz_trackidvar) ? var_GetNonEmptyString( p_input, psz_trackidvar ) : NULL;
     p_props->i_channel = (psz_trackvar) ? var_GetInteger( p_input, psz_trackvar ): -1;
     p_props->i_demux_id = -1;
@@ -621,6 +638,7 @@ static void EsOutDelete(es_out_t *out)
     assert(vlc_list_is_empty(&p_sys->es_slaves));
     assert(vlc_list_is_empty(&p_sys->programs));
     assert(p_sys->p_pgrm == NULL);
+    vlc_vector_destroy(&p_sys->pgrm_index);
     EsOutPropsCleanup( &p_sys->video );
     EsOutPropsCleanup( &p_sys->audio );
     EsOutPropsCleanup( &p_sys->sub );
@@ -667,6 +685,7 @@ static void EsOutTerminate(es_out_sys_t *p_sys)
         input_SendEventProgramDel( p_sys->p_input, p_pgrm->i_id );
         ProgramDelete(p_pgrm);
     }
+    vlc_vector_clear(&p_sys->pgrm_index);
 
     p_sys->p_pgrm = NULL;
 
@@ -956,6 +975,86 @@ static void EsOutStopFreeVout(es_out_sys_t *p_sys)
         input_resource_StopFreeVout( input_priv(p_sys->p_input)->p_resource );
 }
 
+static void EsOutBufferingPolicyRebuffer(es_out_sys_t *p_sys)
+{
+    if( !p_sys->b_adaptive_caching )
+        return;
+    p_sys->i_rebuffer_count++;
+    p_sys->i_last_rebuffer_date = vlc_tick_now();
+}
+
+/* Called when a buffering step completes. The fill rate (how much faster
+ * than real time the buffer filled up) and the recent rebuffering history
+ * drive the prebuffer target: marginal or bursty links get a larger jitter
+ * term so the next underrun is absorbed, while steadily fast links see any
+ * extra delay decay back down instead of sticking forever. */
+static void EsOutBufferingPolicyUpdate(es_out_sys_t *p_sys,
+                                       vlc_tick_t i_stream_duration,
+                                       vlc_tick_t i_system_duration)
+{
+    if( !p_sys->b_adaptive_caching || i_system_duration <= 0 )
+        return;
+
+    /* A rate of 1.0 means the link barely keeps up with real time */
+    const float f_rate = (float)i_stream_duration / i_system_duration;
+    const float f_delta = f_rate - p_sys->f_fill_rate_avg;
+    p_sys->f_fill_rate_avg += 0.25f * f_delta;
+    p_sys->f_fill_rate_var += 0.25f * ( f_delta * f_delta - p_sys->f_fill_rate_var );
+
+    /* Forgive one rebuffering event per minute without underruns */
+    const vlc_tick_t now = vlc_tick_now();
+    if( p_sys->i_rebuffer_count > 0 &&
+        now - p_sys->i_last_rebuffer_date > VLC_TICK_FROM_SEC(60) )
+    {
+        p_sys->i_rebuffer_count--;
+        p_sys->i_last_rebuffer_date = now;
+    }
+
+    /* The link is at risk when the mean fill rate minus one standard
+     * deviation leaves less than 25% headroom over real time (compared in
+     * squared form to avoid sqrt) or when underruns were recorded. */
+    const float f_headroom = p_sys->f_fill_rate_avg - 1.25f;
+    const bool b_at_risk = p_sys->i_rebuffer_count > 0 || f_headroom <= 0 ||
+                           f_headroom * f_headroom <= p_sys->f_fill_rate_var;
+
+    const input_thread_private_t *priv = input_priv(p_sys->p_input);
+    vlc_tick_t i_target = p_sys->i_pts_jitter;
+    if( b_at_risk )
+    {
+        /* Grow the target by half the configured caching per recorded
+         * underrun, within the same bounds as the reactive jitter path */
+        i_target = __MAX( i_target,
+                          (vlc_tick_t)(p_sys->i_rebuffer_count + 1) * p_sys->i_pts_delay / 2 );
+        if( i_target > priv->i_jitter_max )
+            i_target = priv->i_jitter_max;
+        if( p_sys->i_pts_delay + i_target > INPUT_PTS_DELAY_MAX )
+            i_target = INPUT_PTS_DELAY_MAX - p_sys->i_pts_delay;
+    }
+    else
+    {
+        /* Healthy link: decay a quarter at a time so a transient bad patch
+         * does not inflate latency for the rest of the playback */
+        i_target -= i_target / 4;
+        if( i_target < VLC_TICK_FROM_MS(10) )
+            i_target = 0;
+    }
+
+    if( i_target == p_sys->i_pts_jitter )
+        return;
+
+    msg_Dbg( p_sys->p_input, "buffering policy: fill rate %.2f (var %.3f), "
+             "%u underrun(s), extra delay %d ms -> %d ms",
+             p_sys->f_fill_rate_avg, p_sys->f_fill_rate_var,
+             p_sys->i_rebuffer_count,
+             (int)MS_FROM_VLC_TICK(p_sys->i_pts_jitter),
+             (int)MS_FROM_VLC_TICK(i_target) );
+
+    EsOutPrivControlLocked( p_sys, NULL, ES_OUT_PRIV_SET_JITTER,
+                            p_sys->i_pts_delay, i_target, p_sys->i_cr_average );
+    var_SetInteger( p_sys->p_input, "adaptive-caching-delay",
+                    MS_FROM_VLC_TICK(p_sys->i_pts_delay + i_target) );
+}
+
 static void EsOutDecodersStopBuffering(es_out_sys_t *p_sys, bool b_forced)
 {
     es_out_id_t *p_es;
@@ -1016,6 +1115,8 @@ static void EsOutDecodersStopBuffering(es_out_sys_t *p_sys, bool b_forced)
     p_sys->i_preroll_end = -1;
     p_sys->i_prev_stream_level = -1;
 
+    EsOutBufferingPolicyUpdate( p_sys, i_stream_duration, i_system_duration );
+
     if( p_sys->i_buffering_extra_initial > 0 )
     {
         /* FIXME wrong ? */
@@ -1488,6 +1589,33 @@ static void EsOutProgramSelect(es_out_sys_t *p_sys, es_out_pgrm_t *p_pgrm)
     }
 }
 
+/* EsOutProgramIndexLookup:
+ *  Binary search in the (source, id) ordered program index. Returns the
+ *  position of the program, or the insertion position when not found.
+ */
+static size_t EsOutProgramIndexLookup(es_out_sys_t *p_sys, const input_source_t *source,
+                                      int i_group, bool *pb_found)
+{
+    size_t lo = 0, hi = p_sys->pgrm_index.size;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        const es_out_pgrm_t *pgrm = p_sys->pgrm_index.data[mid];
+
+        if (pgrm->source < source
+         || (pgrm->source == source && pgrm->i_id < i_group))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    *pb_found = lo < p_sys->pgrm_index.size
+             && p_sys->pgrm_index.data[lo]->source == source
+             && p_sys->pgrm_index.data[lo]->i_id == i_group;
+    return lo;
+}
+
 /* EsOutAddProgram:
  *  Add a program
  */
@@ -1545,10 +1673,23 @@ static es_out_pgrm_t *EsOutProgramAdd(es_out_sys_t *p_sys, input_source_t *sourc
      * some audio/video glitches when starting, but low-delay is more important
      * than the visual quality if the user chose this option. */
     if (input_priv(p_input)->b_low_delay)
+    {
         vlc_clock_main_SetDejitter(p_pgrm->clocks.main, 0);
+        vlc_clock_main_SetLowLatency(p_pgrm->clocks.main, true);
+    }
     vlc_clock_main_Unlock(p_pgrm->clocks.main);
 
     /* Append it */
+    bool found;
+    size_t pos = EsOutProgramIndexLookup(p_sys, source, i_group, &found);
+    assert(!found);
+    if (!vlc_vector_insert(&p_sys->pgrm_index, pos, p_pgrm))
+    {
+        input_clock_Delete( p_pgrm->p_input_clock );
+        vlc_clock_main_Delete(p_pgrm->clocks.main);
+        free( p_pgrm );
+        return NULL;
+    }
     vlc_list_append(&p_pgrm->node, &p_sys->programs);
 
     /* Update "program" variable */
@@ -1567,13 +1708,10 @@ static es_out_pgrm_t *EsOutProgramAdd(es_out_sys_t *p_sys, input_source_t *sourc
 static es_out_pgrm_t *EsOutProgramSearch(es_out_sys_t *p_sys, input_source_t *source,
                                          int i_group)
 {
-    es_out_pgrm_t *pgrm;
+    bool found;
+    size_t pos = EsOutProgramIndexLookup(p_sys, source, i_group, &found);
 
-    vlc_list_foreach(pgrm, &p_sys->programs, node)
-        if (pgrm->i_id == i_group && pgrm->source == source)
-            return pgrm;
-
-    return NULL;
+    return found ? p_sys->pgrm_index.data[pos] : NULL;
 }
 
 /* EsOutProgramInsert
@@ -1620,6 +1758,11 @@ static int EsOutProgramDel(es_out_sys_t *p_sys, input_source_t *source, int i_gr
 
     vlc_list_remove(&p_pgrm->node);
 
+    bool found;
+    size_t pos = EsOutProgramIndexLookup(p_sys, source, i_group, &found);
+    assert(found);
+    vlc_vector_remove(&p_sys->pgrm_index, pos);
+
     /* If program is selected we need to unselect it */
     if( p_sys->p_pgrm == p_pgrm )
         p_sys->p_pgrm = NULL;
@@ -2621,6 +2764,11 @@ static void EsOutSelect(es_out_sys_t *p_sys, es_out_id_t *es, bool b_force)
         return;
     }
 
+    /* On-demand category: the ES stays tracked and its events are still
+     * delivered, but no decoder is created until an explicit selection */
+    if( p_esprops->b_on_demand && !b_force )
+        return;
+
     enum es_out_policy_e policy = p_esprops->e_policy;
     if( policy == ES_OUT_ES_POLICY_AUTO )
     {
@@ -2881,18 +3029,12 @@ static void EsOutCreateSubESes(es_out_sys_t *sys,
 }
 
 /**
- * Send a block for the given es_out
- *
- * \param out the es_out to send from
- * \param es the es_out_id
- * \param p_block the data block to send
+ * Account a demuxed block in the tracer and input statistics
  */
-static int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
+static void EsOutSendStats(es_out_sys_t *p_sys, es_out_id_t *es,
+                           const block_t *p_block)
 {
-    es_out_sys_t *p_sys = PRIV(out);
     input_thread_t *p_input = p_sys->p_input;
-
-    assert( p_block->p_next == NULL );
     struct vlc_tracer *tracer = vlc_object_get_tracer( &p_input->obj );
 
     if ( tracer != NULL )
@@ -2916,8 +3058,18 @@ static int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
             atomic_fetch_add_explicit(&stats->demux_discontinuity, 1,
                                       memory_order_relaxed);
     }
+}
 
-    vlc_mutex_lock( &p_sys->lock );
+/**
+ * Send a block for the given es_out, with the es_out lock held
+ */
+static VLC_HOT int EsOutSendLocked(es_out_t *out, es_out_id_t *es, block_t *p_block )
+{
+    es_out_sys_t *p_sys = PRIV(out);
+    input_thread_t *p_input = p_sys->p_input;
+
+    assert( p_block->p_next == NULL );
+    vlc_mutex_assert( &p_sys->lock );
 
     /* Shift all slaves timestamps with the main source normal time. This will
      * allow to synchronize 2 demuxers with different time bases. Remove the
@@ -2942,7 +3094,6 @@ static int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
     if( p_sys->p_next_frame_es != NULL && p_sys->p_next_frame_es != es )
     {
         block_Release( p_block );
-        vlc_mutex_unlock( &p_sys->lock );
         return VLC_SUCCESS;
     }
 
@@ -2976,7 +3127,6 @@ static int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
     if( !es->p_dec )
     {
         block_Release( p_block );
-        vlc_mutex_unlock( &p_sys->lock );
         return VLC_SUCCESS;
     }
 
@@ -3026,9 +3176,64 @@ static int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
 
     vlc_subdec_desc_Clean(&status.subdec_desc);
 
+    return VLC_SUCCESS;
+}
+
+/**
+ * Send a block for the given es_out
+ *
+ * \param out the es_out to send from
+ * \param es the es_out_id
+ * \param p_block the data block to send
+ */
+static VLC_HOT int EsOutSend(es_out_t *out, es_out_id_t *es, block_t *p_block )
+{
+    es_out_sys_t *p_sys = PRIV(out);
+    int ret;
+
+    EsOutSendStats( p_sys, es, p_block );
+
+    vlc_mutex_lock( &p_sys->lock );
+    ret = EsOutSendLocked( out, es, p_block );
     vlc_mutex_unlock( &p_sys->lock );
 
-    return VLC_SUCCESS;
+    return ret;
+}
+
+/**
+ * Send a chain of blocks for the given es_out in a single locked transaction
+ *
+ * Compared with calling EsOutSend() once per block, the es_out lock is only
+ * taken once for the whole chain, which matters for demuxers producing many
+ * small blocks (e.g. TS captures with small PES payloads).
+ *
+ * \param out the es_out to send from
+ * \param es the es_out_id
+ * \param p_chain a \ref vlc_frame_t chain, ownership is transferred
+ */
+static VLC_HOT int EsOutSendBatch(es_out_t *out, es_out_id_t *es, block_t *p_chain )
+{
+    es_out_sys_t *p_sys = PRIV(out);
+    int ret = VLC_SUCCESS;
+
+    for( block_t *b = p_chain; b != NULL; b = b->p_next )
+        EsOutSendStats( p_sys, es, b );
+
+    vlc_mutex_lock( &p_sys->lock );
+    while( p_chain != NULL )
+    {
+        block_t *p_block = p_chain;
+
+        p_chain = p_block->p_next;
+        p_block->p_next = NULL;
+
+        int err = EsOutSendLocked( out, es, p_block );
+        if( err != VLC_SUCCESS )
+            ret = err;
+    }
+    vlc_mutex_unlock( &p_sys->lock );
+
+    return ret;
 }
 
 static void
@@ -3473,6 +3678,7 @@ static int EsOutVaControlLocked(es_out_sys_t *p_sys, input_source_t *source,
         }
 
         /* Force a rebufferization when we are too late */
+        EsOutBufferingPolicyRebuffer(p_sys);
         EsOutControlLocked(p_sys, source, ES_OUT_RESET_PCR);
 
         EsOutPrivControlLocked(p_sys, source, ES_OUT_PRIV_SET_JITTER,
@@ -3513,8 +3719,7 @@ static int EsOutVaControlLocked(es_out_sys_t *p_sys, input_source_t *source,
             return VLC_EGENERIC;
 
         const int i_id = es->fmt.i_id;
-        es_format_Clean( &es->fmt );
-        int ret = es_format_Copy( &es->fmt, p_fmt );
+        int ret = es_format_Update( &es->fmt, p_fmt );
         if( ret != VLC_SUCCESS )
             return ret;
         es->fmt.i_id = i_id;
@@ -3763,6 +3968,15 @@ static int EsOutVaPrivControlLocked(es_out_sys_t *p_sys, input_source_t *source,
 
         return VLC_SUCCESS;
     }
+    case ES_OUT_PRIV_SET_ES_CAT_ON_DEMAND:
+    {
+        enum es_format_category_e cat = va_arg( args, enum es_format_category_e );
+        bool b_on_demand = va_arg( args, int );
+        es_out_es_props_t *p_esprops = GetPropsByCat( p_sys, cat );
+        if( p_esprops != NULL )
+            p_esprops->b_on_demand = b_on_demand;
+        return VLC_SUCCESS;
+    }
     case ES_OUT_PRIV_GET_WAKE_UP:
     {
         vlc_tick_t *pi_wakeup = va_arg( args, vlc_tick_t* );
@@ -4043,6 +4257,7 @@ static const struct es_out_callbacks es_out_cbs =
 {
     .add = EsOutAdd,
     .send = EsOutSend,
+    .send_batch = EsOutSendBatch,
     .del = EsOutDel,
     .control = EsOutControl,
     .destroy = EsOutDelete,
@@ -4075,6 +4290,7 @@ input_EsOutNew(input_thread_t *p_input, input_source_t *main_source, float rate,
     p_sys->input_type = input_type;
 
     vlc_list_init(&p_sys->programs);
+    vlc_vector_init(&p_sys->pgrm_index);
     vlc_list_init(&p_sys->es);
     vlc_list_init(&p_sys->es_slaves);
 
@@ -4103,6 +4319,13 @@ input_EsOutNew(input_thread_t *p_input, input_source_t *main_source, float rate,
     p_sys->i_preroll_end = -1;
     p_sys->i_prev_stream_level = -1;
 
+    p_sys->b_adaptive_caching = var_InheritBool( p_input, "adaptive-caching" );
+    if( p_sys->b_adaptive_caching )
+    {
+        /* Queryable policy state: current effective caching target in ms */
+        var_Create( p_input, "adaptive-caching-delay", VLC_VAR_INTEGER );
+    }
+
     return &p_sys->out;
 }
 
@@ -4240,8 +4463,7 @@ static int EsOutEsUpdateFmt(es_out_id_t *es,
         update.p_extra_languages = es->fmt.p_extra_languages;
     }
 
-    es_format_Clean(&es->fmt_out);
-    int ret = es_format_Copy(&es->fmt_out, &update);
+    int ret = es_format_Update(&es->fmt_out, &update);
     if (ret == VLC_SUCCESS)
         EsOutUpdateEsLanguageTitle(es, &es->fmt_out);
 
@@ -58,6 +58,10 @@ enum es_out_query_private_e
 
     ES_OUT_PRIV_SET_ES_CAT_IDS, /* arg1=es_format_category_e arg2=const char *, res=cannot fail */
 
+    /* Mark an ES category as on-demand: tracks are listed but decoders are
+     * only created on an explicit selection */
+    ES_OUT_PRIV_SET_ES_CAT_ON_DEMAND, /* arg1=es_format_category_e arg2=int(bool), res=cannot fail */
+
     /* Stop all selected ES and save the stopped state in a context.
      * Call ES_OUT_PRIV_START_ALL_ES to release the context. */
     ES_OUT_PRIV_STOP_ALL_ES,                        /* arg1=vlc_es_id_t *** */
@@ -188,6 +192,15 @@ es_out_SetEsCatIds(struct vlc_input_es_out *out,
     assert( ret == VLC_SUCCESS );
 }
 
+static inline void
+es_out_SetEsCatOnDemand(struct vlc_input_es_out *out,
+                        enum es_format_category_e cat, bool on_demand)
+{
+    int ret = es_out_PrivControl(out, ES_OUT_PRIV_SET_ES_CAT_ON_DEMAND,
+                                 cat, (int)on_demand);
+    assert( ret == VLC_SUCCESS );
+}
+
 static inline int
 es_out_StopAllEs(struct vlc_input_es_out *out,
                  vlc_es_id_t ***context)
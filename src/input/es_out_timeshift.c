@@ -36,6 +36,9 @@
 #endif
 #include <sys/stat.h>
 #include <unistd.h>
+#ifdef HAVE_POSIX_FADVISE
+#  include <fcntl.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_arrays.h>
@@ -197,6 +200,7 @@ struct ts_storage_t
     ts_storage_t *p_next;
 
     /* */
+    bool    b_memory;   /* Blocks are kept in RAM, no backing file */
 #ifdef _WIN32
     char    *psz_file;  /* Filename */
 #endif
@@ -204,6 +208,10 @@ struct ts_storage_t
     int64_t i_file_size;/* Current size in bytes */
     FILE    *p_filew;   /* FILE handle for data writing */
     FILE    *p_filer;   /* FILE handle for data reading */
+#ifdef HAVE_POSIX_FADVISE
+    uint64_t i_read_advised; /* Offset up to which consumed spill data has
+                              * been dropped from the page cache */
+#endif
 
     /* */
     uint8_t *p_cmd_r;
@@ -220,6 +228,7 @@ typedef struct
     es_out_t       *p_tsout;
     struct vlc_input_es_out *p_out;
     int64_t        i_tmp_size_max;
+    int64_t        i_ram_size_max;
     const char     *psz_tmp_path;
 
     /* Lock for all following fields */
@@ -227,6 +236,10 @@ typedef struct
     vlc_cond_t     wait;
     vlc_sem_t      done;
 
+    /* */
+    int64_t        i_ram_used; /* Bytes held by RAM tier storages */
+    int64_t        i_file_used;/* Bytes spilled to disk, not yet replayed */
+
     /* */
     bool           b_paused;
     vlc_tick_t     i_pause_date;
@@ -260,6 +273,7 @@ struct es_out_timeshift
 
     /* Configuration */
     int64_t        i_tmp_size_max;    /* Maximal temporary file size in byte */
+    int64_t        i_ram_size_max;    /* RAM absorbed before spilling to disk */
     char           *psz_tmp_path;     /* Path for temporary files */
 
     /* Lock for all following fields */
@@ -294,10 +308,14 @@ static bool         TsHasCmd( ts_thread_t * );
 static bool         TsIsUnused( ts_thread_t * );
 static int          TsChangePause( ts_thread_t *, bool b_source_paused, bool b_paused, vlc_tick_t i_date );
 static int          TsChangeRate( ts_thread_t *, float src_rate, float rate );
+static void         TsUpdateStats( ts_thread_t * );
+
+/* Minimum RAM budget left for which opening a memory storage is worthwhile */
+#define TS_STORAGE_RAM_MIN (1u << 20)
 
 static void         *TsRun( void * );
 
-static ts_storage_t *TsStorageNew( const char *psz_path, int64_t i_tmp_size_max );
+static ts_storage_t *TsStorageNew( const char *psz_path, int64_t i_tmp_size_max, bool b_memory );
 static void         TsStorageDelete( ts_storage_t * );
 static void         TsStoragePack( ts_storage_t *p_storage );
 static bool         TsStorageIsFull( ts_storage_t *, const ts_cmd_t *p_cmd );
@@ -804,6 +822,7 @@ static int PrivControlLocked(struct vlc_input_es_out *p_tsout,
     case ES_OUT_PRIV_UNSET_ES:
     case ES_OUT_PRIV_RESTART_ES:
     case ES_OUT_PRIV_SET_ES_CAT_IDS:
+    case ES_OUT_PRIV_SET_ES_CAT_ON_DEMAND:
     case ES_OUT_PRIV_SET_ES_LIST:
     case ES_OUT_PRIV_STOP_ALL_ES:
     case ES_OUT_PRIV_START_ALL_ES:
@@ -884,6 +903,14 @@ input_EsOutTimeshiftNew(input_thread_t *p_input,
     msg_Dbg( p_input, "using timeshift granularity of %d MiB",
              (int)p_sys->i_tmp_size_max/(1024*1024) );
 
+    const int64_t i_ram_size_max = var_CreateGetInteger( p_input, "input-timeshift-ram-size" );
+    if( i_ram_size_max < 0 )
+        p_sys->i_ram_size_max = 32*1024*1024;
+    else
+        p_sys->i_ram_size_max = i_ram_size_max;
+    msg_Dbg( p_input, "using timeshift RAM buffer of %d MiB",
+             (int)(p_sys->i_ram_size_max/(1024*1024)) );
+
     p_sys->psz_tmp_path = var_InheritString( p_input, "input-timeshift-path" );
 #if defined (_WIN32)
     if( p_sys->psz_tmp_path == NULL )
@@ -962,6 +989,7 @@ static int TsStart(struct es_out_timeshift *p_sys)
         return VLC_EGENERIC;
 
     p_ts->i_tmp_size_max = p_sys->i_tmp_size_max;
+    p_ts->i_ram_size_max = p_sys->i_ram_size_max;
     p_ts->psz_tmp_path = p_sys->psz_tmp_path;
     p_ts->p_input = p_sys->p_input;
     p_ts->ts = p_sys;
@@ -1027,17 +1055,39 @@ static void TsStop( ts_thread_t *p_ts )
     assert( !p_ts->p_storage_r || !p_ts->p_storage_r->p_next );
     if( p_ts->p_storage_r )
         TsStorageDelete( p_ts->p_storage_r );
+    p_ts->i_ram_used = 0;
+    p_ts->i_file_used = 0;
+    TsUpdateStats( p_ts );
     vlc_mutex_unlock( &p_ts->lock );
 
     TsDestroy( p_ts );
 }
+static void TsUpdateStats( ts_thread_t *p_ts )
+{
+    struct input_stats *stats = input_priv(p_ts->p_input)->stats;
+
+    vlc_mutex_assert( &p_ts->lock );
+    if( stats == NULL )
+        return;
+    atomic_store_explicit( &stats->timeshift_ram_bytes, p_ts->i_ram_used,
+                           memory_order_relaxed );
+    atomic_store_explicit( &stats->timeshift_spill_bytes, p_ts->i_file_used,
+                           memory_order_relaxed );
+}
 static void TsPushCmd( ts_thread_t *p_ts, ts_cmd_t *p_cmd )
 {
     vlc_mutex_lock( &p_ts->lock );
 
     if( !p_ts->p_storage_w || TsStorageIsFull( p_ts->p_storage_w, p_cmd ) )
     {
-        ts_storage_t *p_storage = TsStorageNew( p_ts->psz_tmp_path, p_ts->i_tmp_size_max );
+        /* Short timeshifts are absorbed by a RAM tier; data goes to the
+         * temporary file only once the memory budget is exhausted */
+        const int64_t i_ram_left = p_ts->i_ram_size_max - p_ts->i_ram_used;
+        const bool b_memory = i_ram_left >= TS_STORAGE_RAM_MIN;
+        ts_storage_t *p_storage =
+            TsStorageNew( p_ts->psz_tmp_path,
+                          b_memory ? __MIN( i_ram_left, p_ts->i_tmp_size_max )
+                                   : p_ts->i_tmp_size_max, b_memory );
 
         if( !p_storage )
         {
@@ -1059,9 +1109,23 @@ static void TsPushCmd( ts_thread_t *p_ts, ts_cmd_t *p_cmd )
         }
     }
 
+    /* The block is consumed (either kept or released) by the push */
+    int64_t i_send_size = 0;
+    if( p_cmd->header.i_type == C_SEND )
+        i_send_size = sizeof(*p_cmd->send.p_block) + p_cmd->send.p_block->i_buffer;
+
     /* TODO return error and warn the user (but only once) */
     TsStoragePushCmd( p_ts->p_storage_w, p_cmd, p_ts->p_storage_r == p_ts->p_storage_w );
 
+    if( i_send_size > 0 )
+    {
+        if( p_ts->p_storage_w->b_memory )
+            p_ts->i_ram_used += i_send_size;
+        else
+            p_ts->i_file_used += i_send_size;
+        TsUpdateStats( p_ts );
+    }
+
     vlc_cond_signal( &p_ts->wait );
 
     vlc_mutex_unlock( &p_ts->lock );
@@ -1073,8 +1137,18 @@ static int TsPopCmdLocked( ts_thread_t *p_ts, ts_cmd_t *p_cmd, bool b_flush )
     if( TsStorageIsEmpty( p_ts->p_storage_r ) )
         return VLC_EGENERIC;
 
+    const bool b_memory = p_ts->p_storage_r->b_memory;
     TsStoragePopCmd( p_ts->p_storage_r, p_cmd, b_flush );
 
+    if( p_cmd->header.i_type == C_SEND && p_cmd->send.p_block != NULL )
+    {
+        int64_t *pi_used = b_memory ? &p_ts->i_ram_used : &p_ts->i_file_used;
+        int64_t i_size = sizeof(*p_cmd->send.p_block) + p_cmd->send.p_block->i_buffer;
+
+        *pi_used = __MAX( *pi_used - i_size, 0 );
+        TsUpdateStats( p_ts );
+    }
+
     while( TsStorageIsEmpty( p_ts->p_storage_r ) )
     {
         ts_storage_t *p_next = p_ts->p_storage_r->p_next;
@@ -1275,6 +1349,13 @@ static void *TsRun( void *p_data )
 #define MAX_COMMAND_SIZE sizeof(ts_cmd_t)
 #define TS_STORAGE_COMMAND_PREALLOC 30000
 
+/* Spill data is written through a large stdio buffer so that the many small
+ * block header + payload writes coalesce into few big sequential ones. */
+#define TS_STORAGE_WRITE_BUFFER (1u << 20)
+/* Consumed spill data is dropped from the page cache in spans of this size,
+ * so a high bitrate timeshift does not evict more useful pages. */
+#define TS_STORAGE_ADVISE_CHUNK (4u << 20)
+
 static const size_t TsStorageSizeofCommand[] =
 {
     [C_ADD] = sizeof(ts_cmd_add_t),
@@ -1284,19 +1365,12 @@ static const size_t TsStorageSizeofCommand[] =
     [C_PRIVCONTROL] = sizeof(ts_cmd_privcontrol_t)
 };
 
-static ts_storage_t *TsStorageNew( const char *psz_tmp_path, int64_t i_tmp_size_max )
+static int TsStorageOpenFile( ts_storage_t *p_storage, const char *psz_tmp_path )
 {
-    ts_storage_t *p_storage = malloc( sizeof (*p_storage) );
-    if( unlikely(p_storage == NULL) )
-        return NULL;
-
     char *psz_file;
     int fd = GetTmpFile( &psz_file, psz_tmp_path );
     if( fd == -1 )
-    {
-        free( p_storage );
-        return NULL;
-    }
+        return VLC_EGENERIC;
 
     p_storage->p_filew = fdopen( fd, "w+b" );
     if( p_storage->p_filew == NULL )
@@ -1306,6 +1380,8 @@ static ts_storage_t *TsStorageNew( const char *psz_tmp_path, int64_t i_tmp_size_
         goto error;
     }
 
+    setvbuf( p_storage->p_filew, NULL, _IOFBF, TS_STORAGE_WRITE_BUFFER );
+
     p_storage->p_filer = vlc_fopen( psz_file, "rb" );
     if( p_storage->p_filer == NULL )
     {
@@ -1314,12 +1390,50 @@ static ts_storage_t *TsStorageNew( const char *psz_tmp_path, int64_t i_tmp_size_
         goto error;
     }
 
+#ifdef HAVE_POSIX_FADVISE
+    /* The spill file is written and read back exactly once, sequentially */
+    posix_fadvise( fd, 0, 0, POSIX_FADV_NOREUSE );
+    posix_fadvise( fileno( p_storage->p_filer ), 0, 0, POSIX_FADV_SEQUENTIAL );
+    p_storage->i_read_advised = 0;
+#endif
+
 #ifndef _WIN32
     vlc_unlink( psz_file );
     free( psz_file );
 #else
     p_storage->psz_file = psz_file;
 #endif
+    return VLC_SUCCESS;
+error:
+    free( psz_file );
+    return VLC_EGENERIC;
+}
+
+static ts_storage_t *TsStorageNew( const char *psz_tmp_path, int64_t i_tmp_size_max,
+                                   bool b_memory )
+{
+    ts_storage_t *p_storage = malloc( sizeof (*p_storage) );
+    if( unlikely(p_storage == NULL) )
+        return NULL;
+
+    p_storage->b_memory = b_memory;
+    if( b_memory )
+    {
+        /* RAM tier: the blocks stay live in the command buffer */
+        p_storage->p_filew = NULL;
+        p_storage->p_filer = NULL;
+#ifdef _WIN32
+        p_storage->psz_file = NULL;
+#endif
+#ifdef HAVE_POSIX_FADVISE
+        p_storage->i_read_advised = 0;
+#endif
+    }
+    else if( TsStorageOpenFile( p_storage, psz_tmp_path ) )
+    {
+        free( p_storage );
+        return NULL;
+    }
     p_storage->p_next = NULL;
 
     /* */
@@ -1339,10 +1453,6 @@ static ts_storage_t *TsStorageNew( const char *psz_tmp_path, int64_t i_tmp_size_
         return NULL;
     }
     return p_storage;
-error:
-    free( psz_file );
-    free( p_storage );
-    return NULL;
 }
 
 static void TsStorageDelete( ts_storage_t *p_storage )
@@ -1357,12 +1467,15 @@ static void TsStorageDelete( ts_storage_t *p_storage )
     }
     free( p_storage->p_cmd_buf );
 
-    fclose( p_storage->p_filer );
-    fclose( p_storage->p_filew );
+    if( !p_storage->b_memory )
+    {
+        fclose( p_storage->p_filer );
+        fclose( p_storage->p_filew );
 #ifdef _WIN32
-    vlc_unlink( p_storage->psz_file );
-    free( p_storage->psz_file );
+        vlc_unlink( p_storage->psz_file );
+        free( p_storage->psz_file );
 #endif
+    }
     free( p_storage );
 }
 
@@ -1410,28 +1523,38 @@ static void TsStoragePushCmd( ts_storage_t *p_storage, const ts_cmd_t *p_cmd, bo
     {
         block_t *p_block = cmd.send.p_block;
 
-        cmd.send.p_block = NULL;
-        cmd.send.i_offset = ftell( p_storage->p_filew );
-
-        if( fwrite( p_block, sizeof(*p_block), 1, p_storage->p_filew ) != 1 )
+        if( p_storage->b_memory )
         {
-            block_Release( p_block );
-            return;
+            /* The block itself is the storage: keep it live in the command
+             * buffer and account for it so TsStorageIsFull() keeps the RAM
+             * tier within its budget */
+            p_storage->i_file_size += sizeof(*p_block) + p_block->i_buffer;
         }
-        p_storage->i_file_size += sizeof(*p_block);
-        if( p_block->i_buffer > 0 )
+        else
         {
-            if( fwrite( p_block->p_buffer, p_block->i_buffer, 1, p_storage->p_filew ) != 1 )
+            cmd.send.p_block = NULL;
+            cmd.send.i_offset = ftell( p_storage->p_filew );
+
+            if( fwrite( p_block, sizeof(*p_block), 1, p_storage->p_filew ) != 1 )
             {
                 block_Release( p_block );
                 return;
             }
-        }
-        p_storage->i_file_size += p_block->i_buffer;
-        block_Release( p_block );
+            p_storage->i_file_size += sizeof(*p_block);
+            if( p_block->i_buffer > 0 )
+            {
+                if( fwrite( p_block->p_buffer, p_block->i_buffer, 1, p_storage->p_filew ) != 1 )
+                {
+                    block_Release( p_block );
+                    return;
+                }
+            }
+            p_storage->i_file_size += p_block->i_buffer;
+            block_Release( p_block );
 
-        if( b_flush )
-            fflush( p_storage->p_filew );
+            if( b_flush )
+                fflush( p_storage->p_filew );
+        }
     }
     size_t i_cmdsize = TsStorageSizeofCommand[ cmd.header.i_type ];
     memcpy( p_storage->p_cmd_w, &cmd, i_cmdsize );
@@ -1451,6 +1574,10 @@ static void TsStoragePopCmd( ts_storage_t *p_storage, ts_cmd_t *p_cmd, bool b_fl
     {
         block_t block;
 
+        if( p_storage->b_memory )
+            /* The popped command already carries the live block */
+            return;
+
         if( !b_flush &&
             !fseek( p_storage->p_filer, p_cmd->send.i_offset, SEEK_SET ) &&
             fread( &block, sizeof(block), 1, p_storage->p_filer ) == 1 )
@@ -1466,6 +1593,21 @@ static void TsStoragePopCmd( ts_storage_t *p_storage, ts_cmd_t *p_cmd, bool b_fl
                 p_block->i_buffer = fread( p_block->p_buffer, 1, block.i_buffer, p_storage->p_filer );
             }
             p_cmd->send.p_block = p_block;
+
+#ifdef HAVE_POSIX_FADVISE
+            /* A command is popped at most once: whole consumed spans can be
+             * evicted without hurting the reader */
+            long i_pos = ftell( p_storage->p_filer );
+            if( i_pos > 0 && (uint64_t)i_pos >=
+                    p_storage->i_read_advised + TS_STORAGE_ADVISE_CHUNK )
+            {
+                posix_fadvise( fileno( p_storage->p_filer ),
+                               p_storage->i_read_advised,
+                               i_pos - p_storage->i_read_advised,
+                               POSIX_FADV_DONTNEED );
+                p_storage->i_read_advised = i_pos;
+            }
+#endif
         }
         else
         {
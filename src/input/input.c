@@ -74,6 +74,8 @@ static int ControlPopEarly(input_thread_t *input, int *type,
                            input_control_param_t *param);
 static void       ControlRelease( int i_type, const input_control_param_t *p_param );
 static bool       ControlIsSeekRequest( int i_type );
+static bool       ControlIsAbsoluteSeek( int i_type );
+static bool       ControlHasPendingAbsoluteSeek( input_thread_t * );
 static bool       Control( input_thread_t *, int, input_control_param_t );
 static void       ControlPause( input_thread_t *, vlc_tick_t );
 
@@ -608,6 +610,11 @@ static void MainLoopStatistics( input_thread_t *p_input )
     if (priv->stats != NULL)
     {
         struct input_stats_t new_stats;
+
+        /* The input thread performs the demuxing, publish its CPU usage */
+        atomic_store_explicit(&priv->stats->demux_cpu,
+                              input_stats_ThreadCpuTime(),
+                              memory_order_relaxed);
         input_stats_Compute(priv->stats, &new_stats);
 
         vlc_mutex_lock(&priv->p_item->lock);
@@ -732,6 +739,16 @@ static void MainLoop( input_thread_t *p_input, bool b_interactive )
                 break; /* Wake-up time reached */
             }
 
+            /* Coalesce seek bursts (e.g. timeline scrubbing): an absolute
+             * seek is obsolete once a newer one is queued, so skip the
+             * costly flush and preroll decode for all but the last target. */
+            if( ControlIsAbsoluteSeek( i_type )
+             && ControlHasPendingAbsoluteSeek( p_input ) )
+            {
+                ControlRelease( i_type, &param );
+                continue;
+            }
+
             if( Control( p_input, i_type, param ) )
             {
                 if( ControlIsSeekRequest( i_type ) )
@@ -1625,6 +1642,28 @@ static bool ControlIsSeekRequest( int i_type )
     }
 }
 
+static bool ControlIsAbsoluteSeek( int i_type )
+{
+    return i_type == INPUT_CONTROL_SET_POSITION
+        || i_type == INPUT_CONTROL_SET_TIME;
+}
+
+static bool ControlHasPendingAbsoluteSeek( input_thread_t *p_input )
+{
+    input_thread_private_t *sys = input_priv(p_input);
+    bool b_pending = false;
+
+    vlc_mutex_lock( &sys->lock_control );
+    for( size_t i = 0; i < sys->i_control; i++ )
+        if( ControlIsAbsoluteSeek( sys->control[i].i_type ) )
+        {
+            b_pending = true;
+            break;
+        }
+    vlc_mutex_unlock( &sys->lock_control );
+    return b_pending;
+}
+
 static bool ControlTypeIsEarly(int type)
 {
     /* These controls can and should be processed before the access/demux
@@ -1636,6 +1675,7 @@ static bool ControlTypeIsEarly(int type)
         case INPUT_CONTROL_SET_PROGRAM:
         case INPUT_CONTROL_SET_CATEGORY_DELAY:
         case INPUT_CONTROL_SET_ES_CAT_IDS:
+        case INPUT_CONTROL_SET_ES_CAT_ON_DEMAND:
             return true;
         default:
             return false;
@@ -1861,6 +1901,15 @@ void input_SetEsCatIds(input_thread_t *input, enum es_format_category_e cat,
     input_ControlPush(input, INPUT_CONTROL_SET_ES_CAT_IDS, &param);
 }
 
+void input_SetEsCatOnDemand(input_thread_t *input,
+                            enum es_format_category_e cat, bool on_demand)
+{
+    const input_control_param_t param = {
+        .cat_on_demand = { cat, on_demand }
+    };
+    input_ControlPush(input, INPUT_CONTROL_SET_ES_CAT_ON_DEMAND, &param);
+}
+
 static void ControlSetEsList(input_thread_t *input,
                              enum es_format_category_e cat,
                              vlc_es_id_t **ids)
@@ -2144,6 +2193,11 @@ static bool Control( input_thread_t *p_input,
             es_out_SetEsCatIds( priv->p_es_out_display, param.cat_ids.cat,
                                 param.cat_ids.str_ids );
             break;
+        case INPUT_CONTROL_SET_ES_CAT_ON_DEMAND:
+            es_out_SetEsCatOnDemand( priv->p_es_out_display,
+                                     param.cat_on_demand.cat,
+                                     param.cat_on_demand.enabled );
+            break;
 
         case INPUT_CONTROL_SET_VIEWPOINT:
         case INPUT_CONTROL_SET_INITIAL_VIEWPOINT:
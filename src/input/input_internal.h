@@ -431,6 +431,11 @@ typedef union
         char *str_ids;
     } cat_ids;
     struct
+    {
+        enum es_format_category_e cat;
+        bool enabled;
+    } cat_on_demand;
+    struct
     {
         vlc_es_id_t *id;
         vlc_tick_t delay;
@@ -570,6 +575,7 @@ enum input_control_e
     INPUT_CONTROL_UNSET_ES,
     INPUT_CONTROL_RESTART_ES,
     INPUT_CONTROL_SET_ES_CAT_IDS,
+    INPUT_CONTROL_SET_ES_CAT_ON_DEMAND,
 
     INPUT_CONTROL_SET_VIEWPOINT,    // new absolute viewpoint
     INPUT_CONTROL_SET_INITIAL_VIEWPOINT, // set initial viewpoint (generally from video)
@@ -660,6 +666,16 @@ int input_SetEsCatDelay(input_thread_t *input, enum es_format_category_e cat,
 void input_SetEsCatIds(input_thread_t *, enum es_format_category_e cat,
                        const char *str_ids);
 
+/**
+ * Set whether a category should only get decoders on explicit selection
+ *
+ * cf. ES_OUT_PRIV_SET_ES_CAT_ON_DEMAND
+ * This function can be called before start or while started.
+ * This function is not thread-safe, the caller should handle the locking.
+ */
+void input_SetEsCatOnDemand(input_thread_t *, enum es_format_category_e cat,
+                            bool on_demand);
+
 bool input_Stopped( input_thread_t * );
 
 int input_GetAttachments(input_thread_t *input, input_attachment_t ***attachments);
@@ -735,6 +751,10 @@ struct input_stats {
     atomic_uintmax_t displayed_pictures;
     atomic_uintmax_t late_pictures;
     atomic_uintmax_t lost_pictures;
+    atomic_uintmax_t demux_cpu;
+    atomic_uintmax_t decoder_cpu;
+    atomic_uintmax_t timeshift_ram_bytes;
+    atomic_uintmax_t timeshift_spill_bytes;
 };
 
 struct input_stats *input_stats_Create(void);
@@ -742,4 +762,10 @@ void input_stats_Destroy(struct input_stats *);
 void input_rate_Add(input_rate_t *, uintmax_t);
 void input_stats_Compute(struct input_stats *, input_stats_t*);
 
+/**
+ * Returns the CPU time consumed so far by the calling thread, or 0 if the
+ * platform cannot report per-thread CPU usage.
+ */
+vlc_tick_t input_stats_ThreadCpuTime(void);
+
 #endif
@@ -36,6 +36,7 @@
 #include "item.h"
 #include "info.h"
 #include "input_internal.h"
+#include "string_intern.h"
 
 #include <vlc_charset.h>
 
@@ -288,8 +289,8 @@ void input_item_SetURI( input_item_t *p_i, const char *psz_uri )
                  __func__, psz_uri );
 #endif
     vlc_mutex_lock( &p_i->lock );
-    free( p_i->psz_uri );
-    p_i->psz_uri = strdup( psz_uri );
+    vlc_strintern_Release( p_i->psz_uri );
+    p_i->psz_uri = vlc_strintern( psz_uri );
 
     p_i->i_type = GuessType( p_i, &p_i->b_net );
 
@@ -414,7 +415,7 @@ void input_item_Release( input_item_t *p_item )
         return;
 
     free( p_item->psz_name );
-    free( p_item->psz_uri );
+    vlc_strintern_Release( p_item->psz_uri );
     free( p_item->p_stats );
     vlc_meta_Delete( p_item->p_meta );
 
@@ -794,6 +795,39 @@ void input_item_MergeInfos( input_item_t *p_item, info_category_t *p_cat )
     vlc_mutex_unlock( &p_item->lock );
 }
 
+/* Looks up an event in a table, by id. The table is sorted by start time,
+ * so try a bisect at the updated event's start time first: event updates
+ * keep their start time in practice, which makes the common case O(log n)
+ * during EIT floods. */
+static ssize_t EpgFindEventbyId( const vlc_epg_t *p_epg,
+                                 const vlc_epg_event_t *p_epg_evt )
+{
+    size_t i_lower = 0;
+    size_t i_upper = p_epg->i_event;
+
+    while( i_lower < i_upper )
+    {
+        size_t i_split = ( i_lower + i_upper ) / 2;
+
+        if( p_epg->pp_event[i_split]->i_start < p_epg_evt->i_start )
+            i_lower = i_split + 1;
+        else
+            i_upper = i_split;
+    }
+
+    if( i_lower < p_epg->i_event &&
+        p_epg->pp_event[i_lower]->i_start == p_epg_evt->i_start &&
+        p_epg->pp_event[i_lower]->i_id == p_epg_evt->i_id )
+        return i_lower;
+
+    /* Unusual case: the event moved, or several share a start time */
+    for( size_t j = 0; j < p_epg->i_event; j++ )
+        if( p_epg->pp_event[j]->i_id == p_epg_evt->i_id )
+            return j;
+
+    return -1;
+}
+
 void input_item_SetEpgEvent( input_item_t *p_item, const vlc_epg_event_t *p_epg_evt )
 {
     vlc_mutex_lock( &p_item->lock );
@@ -801,20 +835,17 @@ void input_item_SetEpgEvent( input_item_t *p_item, const vlc_epg_event_t *p_epg_
     for( int i = 0; i < p_item->i_epg; i++ )
     {
         vlc_epg_t *p_epg = p_item->pp_epg[i];
-        for( size_t j = 0; j < p_epg->i_event; j++ )
+        /* Same event can exist in more than one table */
+        ssize_t j = EpgFindEventbyId( p_epg, p_epg_evt );
+        if( j >= 0 )
         {
-            /* Same event can exist in more than one table */
-            if( p_epg->pp_event[j]->i_id == p_epg_evt->i_id )
+            vlc_epg_event_t *p_dup = vlc_epg_event_Duplicate( p_epg_evt );
+            if( p_dup )
             {
-                vlc_epg_event_t *p_dup = vlc_epg_event_Duplicate( p_epg_evt );
-                if( p_dup )
-                {
-                    if( p_epg->p_current == p_epg->pp_event[j] )
-                        p_epg->p_current = p_dup;
-                    vlc_epg_event_Delete( p_epg->pp_event[j] );
-                    p_epg->pp_event[j] = p_dup;
-                }
-                break;
+                if( p_epg->p_current == p_epg->pp_event[j] )
+                    p_epg->p_current = p_dup;
+                vlc_epg_event_Delete( p_epg->pp_event[j] );
+                p_epg->pp_event[j] = p_dup;
             }
         }
     }
@@ -1179,10 +1210,18 @@ input_item_node_t *input_item_node_Create( input_item_t *p_input )
 
     p_node->i_children = 0;
     p_node->pp_children = NULL;
+    p_node->pf_flush = NULL;
+    p_node->p_flush_opaque = NULL;
 
     return p_node;
 }
 
+void input_item_node_Flush( input_item_node_t *p_node )
+{
+    if( p_node->pf_flush != NULL && p_node->i_children > 0 )
+        p_node->pf_flush( p_node, p_node->p_flush_opaque );
+}
+
 void input_item_node_Delete( input_item_node_t *p_node )
 {
     for( int i = 0; i < p_node->i_children; i++ )
@@ -33,13 +33,14 @@
 #include <vlc_modules.h>
 
 #include "input_internal.h"
+#include "string_intern.h"
 #include "../preparser/art.h"
 #include <vlc_charset.h>
 
 struct vlc_meta_value
 {
     vlc_meta_priority_t priority;
-    char *value;
+    char *value; /* interned */
 };
 
 struct vlc_meta_t
@@ -121,25 +122,25 @@ static void vlc_meta_InsertExtra( vlc_meta_t *m, const char *psz_name, const cha
     struct vlc_meta_value *meta_value = malloc( sizeof(*meta_value) );
     if( meta_value )
     {
-        meta_value->value = strdup(psz_value);
+        meta_value->value = vlc_strintern(psz_value);
         meta_value->priority = priority;
         vlc_dictionary_insert( &m->extra_tags, psz_name, meta_value );
     }
 }
 
-/* Free a dictionary key allocated by strdup() in vlc_meta_SetExtraWithPriority() */
+/* Free a dictionary value allocated by vlc_meta_InsertExtra() */
 static void vlc_meta_FreeExtraKey( void *p_data, void *p_obj )
 {
     VLC_UNUSED( p_obj );
     struct vlc_meta_value *meta_value = p_data;
-    free( meta_value->value );
+    vlc_strintern_Release( meta_value->value );
     free( meta_value );
 }
 
 void vlc_meta_Delete( vlc_meta_t *m )
 {
     for( int i = 0; i < VLC_META_TYPE_COUNT ; i++ )
-        free( m->meta[i].value );
+        vlc_strintern_Release( m->meta[i].value );
     vlc_dictionary_clear( &m->extra_tags, vlc_meta_FreeExtraKey, NULL );
     free( m );
 }
@@ -152,9 +153,9 @@ void vlc_meta_Delete( vlc_meta_t *m )
 
 void vlc_meta_SetWithPriority( vlc_meta_t *p_meta, vlc_meta_type_t meta_type, const char *psz_val, vlc_meta_priority_t priority )
 {
-    free( p_meta->meta[meta_type].value );
+    vlc_strintern_Release( p_meta->meta[meta_type].value );
     assert( psz_val == NULL || IsUTF8( psz_val ) );
-    p_meta->meta[meta_type].value = psz_val ? strdup( psz_val ) : NULL;
+    p_meta->meta[meta_type].value = vlc_strintern( psz_val );
     p_meta->meta[meta_type].priority = priority;
 }
 
@@ -192,6 +193,20 @@ char** vlc_meta_CopyExtraNames( const vlc_meta_t *m )
     return vlc_dictionary_all_keys(&m->extra_tags);
 }
 
+void vlc_meta_ForeachExtra( const vlc_meta_t *m,
+                            void (*cb)( const char *psz_name,
+                                        const char *psz_value, void *data ),
+                            void *data )
+{
+    for( int i = 0; i < m->extra_tags.i_size; i++ )
+        for( const vlc_dictionary_entry_t *p_entry = m->extra_tags.p_entries[i];
+             p_entry != NULL; p_entry = p_entry->p_next )
+        {
+            const struct vlc_meta_value *meta_value = p_entry->p_value;
+            cb( p_entry->psz_key, meta_value->value, data );
+        }
+}
+
 /**
  * vlc_meta status (see vlc_meta_status_e)
  */
@@ -220,8 +235,8 @@ void vlc_meta_Merge( vlc_meta_t *dst, const vlc_meta_t *src )
            greater than or equal to the priority of dst */
         if( src->meta[i].value && src->meta[i].priority >= dst->meta[i].priority )
         {
-            free( dst->meta[i].value );
-            dst->meta[i].value = strdup( src->meta[i].value );
+            vlc_strintern_Release( dst->meta[i].value );
+            dst->meta[i].value = vlc_strintern_Hold( src->meta[i].value );
             dst->meta[i].priority = src->meta[i].priority;
         }
     }
@@ -26,6 +26,10 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifdef _WIN32
+# include <windows.h>
+#endif
 
 #include <vlc_common.h>
 #include "input/input_internal.h"
@@ -68,6 +72,10 @@ struct input_stats *input_stats_Create(void)
     atomic_init(&stats->displayed_pictures, 0);
     atomic_init(&stats->late_pictures, 0);
     atomic_init(&stats->lost_pictures, 0);
+    atomic_init(&stats->demux_cpu, 0);
+    atomic_init(&stats->decoder_cpu, 0);
+    atomic_init(&stats->timeshift_ram_bytes, 0);
+    atomic_init(&stats->timeshift_spill_bytes, 0);
     return stats;
 }
 
@@ -111,6 +119,41 @@ void input_stats_Compute(struct input_stats *stats, input_stats_t *st)
                                                     memory_order_relaxed);
     st->i_lost_pictures = atomic_load_explicit(&stats->lost_pictures,
                                                memory_order_relaxed);
+
+    /* CPU */
+    st->i_demux_cpu = atomic_load_explicit(&stats->demux_cpu,
+                                           memory_order_relaxed);
+    st->i_decoder_cpu = atomic_load_explicit(&stats->decoder_cpu,
+                                             memory_order_relaxed);
+
+    /* Timeshift */
+    st->i_timeshift_ram_bytes = atomic_load_explicit(
+                    &stats->timeshift_ram_bytes, memory_order_relaxed);
+    st->i_timeshift_spill_bytes = atomic_load_explicit(
+                    &stats->timeshift_spill_bytes, memory_order_relaxed);
+}
+
+vlc_tick_t input_stats_ThreadCpuTime(void)
+{
+#if defined (_WIN32)
+    FILETIME create, exit, kernel, user;
+
+    if (GetThreadTimes(GetCurrentThread(), &create, &exit, &kernel, &user))
+    {
+        ULARGE_INTEGER k = { .LowPart = kernel.dwLowDateTime,
+                             .HighPart = kernel.dwHighDateTime };
+        ULARGE_INTEGER u = { .LowPart = user.dwLowDateTime,
+                             .HighPart = user.dwHighDateTime };
+        /* FILETIME is expressed in 100ns units */
+        return VLC_TICK_FROM_US((k.QuadPart + u.QuadPart) / 10);
+    }
+#elif defined (CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return vlc_tick_from_timespec(&ts);
+#endif
+    return 0;
 }
 
 /** Update a counter element with new values
@@ -529,6 +529,43 @@ ssize_t vlc_stream_Read(stream_t *s, void *buf, size_t len)
     return copied;
 }
 
+ssize_t vlc_stream_ReadVec(stream_t *s, const struct vlc_stream_extent *extents,
+                           unsigned count)
+{
+    ssize_t (*readvec)(stream_t *, const struct vlc_stream_extent *, unsigned);
+
+    readvec = (s->ops != NULL) ? s->ops->stream.readvec : s->pf_readvec;
+    if (readvec != NULL)
+    {
+        if (vlc_killed())
+            return 0;
+        return readvec(s, extents, count);
+    }
+
+    /* Emulation: seek to each extent in turn. Works on top of any seekable
+     * stream or filter chain, at the cost of one round trip per extent. */
+    ssize_t total = 0;
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (extents[i].length == 0)
+            continue;
+
+        if (vlc_stream_Seek(s, extents[i].offset) != VLC_SUCCESS)
+            return (total > 0) ? total : -1;
+
+        ssize_t ret = vlc_stream_Read(s, extents[i].buf, extents[i].length);
+        if (ret < 0)
+            return (total > 0) ? total : ret;
+
+        total += ret;
+        if ((size_t)ret < extents[i].length)
+            break; /* end of stream or fatal error */
+    }
+
+    return total;
+}
+
 ssize_t vlc_stream_Peek(stream_t *s, const uint8_t **restrict bufp, size_t len)
 {
     stream_priv_t *priv = stream_priv(s);
@@ -583,6 +620,22 @@ ssize_t vlc_stream_Peek(stream_t *s, const uint8_t **restrict bufp, size_t len)
     return len;
 }
 
+#define STREAM_PROBE_WINDOW 16384
+
+void stream_ProbePrefetch(stream_t *s)
+{
+    bool fast = false;
+    const uint8_t *peek;
+
+    /* On live or paced streams, filling a whole window up front would delay
+     * start-up more than the repeated short reads it is meant to avoid. */
+    vlc_stream_Control(s, STREAM_CAN_FASTSEEK, &fast);
+    if (!fast)
+        return;
+
+    (void) vlc_stream_Peek(s, &peek, STREAM_PROBE_WINDOW);
+}
+
 block_t *vlc_stream_ReadBlock(stream_t *s)
 {
     stream_priv_t *priv = stream_priv(s);
@@ -37,6 +37,17 @@ void *vlc_stream_Private(stream_t *stream);
 /* */
 void stream_CommonDelete( stream_t *s );
 
+/**
+ * Prefetches the stream probe window.
+ *
+ * Reads the head of the stream into the peek cache in one go, so that the
+ * many small, growing peeks issued by module probe callbacks are all served
+ * from memory rather than each growing the cache with its own buffered read
+ * (one round trip apiece on slow mounts). Only fast-seekable streams are
+ * prefetched; for other streams this is a no-op.
+ */
+void stream_ProbePrefetch( stream_t *s );
+
 stream_t *vlc_stream_AttachmentNew(vlc_object_t *p_this,
                                    input_attachment_t *attachment);
 
@@ -97,6 +97,9 @@ stream_t *stream_FilterAutoNew( stream_t *p_source )
     /* Limit number of entries to avoid infinite recursion. */
     for( unsigned i = 0; i < 16; i++ )
     {
+        /* Let every probe of this round hit the same peek window */
+        stream_ProbePrefetch( p_source );
+
         stream_t *p_filter = vlc_stream_FilterNew( p_source, NULL );
         if( p_filter == NULL )
             break;
@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * string_intern.c: refcounted hash-consed strings for input items
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_threads.h>
+
+#include "string_intern.h"
+
+struct intern_entry
+{
+    struct intern_entry *next;
+    uint32_t hash;
+    unsigned refs;
+    char str[];
+};
+
+/* A single process-wide table: metadata is written at preparse/playback
+ * rates, far below any contention level that would justify sharding. */
+static struct
+{
+    struct intern_entry **buckets;
+    size_t size; /* bucket count, power of two */
+    size_t count;
+} table;
+
+static vlc_mutex_t lock = VLC_STATIC_MUTEX;
+
+#define INTERN_MIN_BUCKETS 1024
+
+static uint32_t StringHash(const char *str)
+{
+    /* FNV-1a */
+    uint32_t hash = UINT32_C(2166136261);
+    for (const unsigned char *p = (const unsigned char *)str; *p; p++)
+    {
+        hash ^= *p;
+        hash *= UINT32_C(16777619);
+    }
+    return hash;
+}
+
+static struct intern_entry *EntryOfString(char *str)
+{
+    return (struct intern_entry *)(void *)
+        (str - offsetof(struct intern_entry, str));
+}
+
+static void Rehash(size_t size)
+{
+    struct intern_entry **buckets = calloc(size, sizeof (*buckets));
+    if (buckets == NULL)
+        return; /* keep the (denser) current table */
+
+    for (size_t i = 0; i < table.size; i++)
+    {
+        for (struct intern_entry *entry = table.buckets[i], *next;
+             entry != NULL; entry = next)
+        {
+            next = entry->next;
+            entry->next = buckets[entry->hash & (size - 1)];
+            buckets[entry->hash & (size - 1)] = entry;
+        }
+    }
+
+    free(table.buckets);
+    table.buckets = buckets;
+    table.size = size;
+}
+
+char *vlc_strintern(const char *str)
+{
+    if (str == NULL)
+        return NULL;
+
+    const uint32_t hash = StringHash(str);
+    char *ret = NULL;
+
+    vlc_mutex_lock(&lock);
+    if (table.size == 0)
+        Rehash(INTERN_MIN_BUCKETS);
+    if (unlikely(table.size == 0))
+    {
+        vlc_mutex_unlock(&lock);
+        return NULL;
+    }
+
+    struct intern_entry *entry;
+    for (entry = table.buckets[hash & (table.size - 1)];
+         entry != NULL; entry = entry->next)
+        if (entry->hash == hash && strcmp(entry->str, str) == 0)
+            break;
+
+    if (entry != NULL)
+    {
+        entry->refs++;
+        ret = entry->str;
+    }
+    else
+    {
+        entry = malloc(sizeof (*entry) + strlen(str) + 1);
+        if (likely(entry != NULL))
+        {
+            entry->hash = hash;
+            entry->refs = 1;
+            strcpy(entry->str, str);
+            entry->next = table.buckets[hash & (table.size - 1)];
+            table.buckets[hash & (table.size - 1)] = entry;
+
+            if (++table.count > 2 * table.size)
+                Rehash(2 * table.size);
+            ret = entry->str;
+        }
+    }
+    vlc_mutex_unlock(&lock);
+
+    return ret;
+}
+
+char *vlc_strintern_Hold(char *str)
+{
+    if (str == NULL)
+        return NULL;
+
+    struct intern_entry *entry = EntryOfString(str);
+
+    vlc_mutex_lock(&lock);
+    assert(entry->refs > 0);
+    entry->refs++;
+    vlc_mutex_unlock(&lock);
+
+    return str;
+}
+
+void vlc_strintern_Release(char *str)
+{
+    if (str == NULL)
+        return;
+
+    struct intern_entry *entry = EntryOfString(str);
+
+    vlc_mutex_lock(&lock);
+    assert(entry->refs > 0);
+    if (--entry->refs == 0)
+    {
+        struct intern_entry **pp = &table.buckets[entry->hash
+                                                  & (table.size - 1)];
+        while (*pp != entry)
+            pp = &(*pp)->next;
+        *pp = entry->next;
+        table.count--;
+
+        if (table.count == 0)
+        {   /* last input item gone: drop the buckets as well */
+            free(table.buckets);
+            table.buckets = NULL;
+            table.size = 0;
+        }
+    }
+    else
+        entry = NULL;
+    vlc_mutex_unlock(&lock);
+
+    free(entry);
+}
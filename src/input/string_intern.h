@@ -0,0 +1,70 @@
+/*****************************************************************************
+ * string_intern.h: refcounted hash-consed strings for input items
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef LIBVLC_INPUT_STRING_INTERN_H
+#define LIBVLC_INPUT_STRING_INTERN_H 1
+
+/**
+ * \defgroup string_intern Interned strings
+ *
+ * Refcounted, hash-consed immutable strings.
+ *
+ * Input item metadata (titles, artists, URIs...) is highly repetitive on
+ * large collections: the same album, artist or directory prefix is
+ * duplicated across thousands of items. Interning stores a single
+ * refcounted copy of each distinct value, with the characters allocated
+ * inline with the entry header, so equal values share one allocation.
+ *
+ * Interned strings are immutable: they may be shared between unrelated
+ * holders and must never be modified nor passed to free().
+ *
+ * @{
+ */
+
+/**
+ * Interns a string.
+ *
+ * Returns a reference to the shared copy of the value, creating it on
+ * first use. The reference must be dropped with vlc_strintern_Release().
+ *
+ * \param str string to intern (may be NULL)
+ * \return the interned string, or NULL on allocation failure or NULL input
+ */
+char *vlc_strintern(const char *str);
+
+/**
+ * Adds a reference to an already interned string.
+ *
+ * \param str string returned by vlc_strintern() (may be NULL)
+ * \return str
+ */
+char *vlc_strintern_Hold(char *str);
+
+/**
+ * Drops a reference to an interned string, freeing the shared copy when
+ * it was the last one.
+ *
+ * \param str string returned by vlc_strintern() (may be NULL)
+ */
+void vlc_strintern_Release(char *str);
+
+/** @} */
+
+#endif
@@ -504,6 +504,34 @@ static const char *const fit_descriptions[] = {
     "This drops frames that are late (arrive to the video output after " \
     "their intended display date)." )
 
+#define TIMER_SLACK_TEXT N_("Video output timer slack (ns)")
+#define TIMER_SLACK_LONGTEXT N_( \
+    "Timer slack applied to the video output thread, in nanoseconds. " \
+    "Lower values reduce frame pacing jitter at the cost of more wakeups. " \
+    "Use -1 to keep the system default." )
+
+#define NUMA_INTERLEAVE_TEXT N_("Interleave picture memory across NUMA nodes")
+#define NUMA_INTERLEAVE_LONGTEXT N_( \
+    "Spread the memory pages of software video pictures evenly over all " \
+    "NUMA nodes, instead of placing them on the node of the thread that " \
+    "first touches them. This evens out cross-node memory traffic when the " \
+    "decoder and the video output run on different sockets. The setting " \
+    "applies process-wide (Linux only).")
+
+#define VOUT_AFFINITY_TEXT N_("Video output CPU affinity")
+#define VOUT_AFFINITY_LONGTEXT N_( \
+    "Comma-separated list of CPU indexes or ranges (e.g. \"0,2,8-11\") the " \
+    "video output thread is restricted to. This can be used to keep video " \
+    "rendering on the NUMA node closest to the display adapter " \
+    "(Linux only).")
+
+#define FRAME_QOS_TEXT N_("Per-frame QoS ledger")
+#define FRAME_QOS_LONGTEXT N_( \
+    "Stamp every video frame with timestamps at each pipeline stage (demux " \
+    "out, decode, filter, render, display) and log per-stage latency " \
+    "histograms when the video output stops. Debugging aid to find which " \
+    "stage was late.")
+
 #define KEYBOARD_EVENTS_TEXT N_("Key press events")
 #define KEYBOARD_EVENTS_LONGTEXT N_( \
     "This enables VLC hotkeys from the (non-embedded) video window." )
@@ -538,6 +566,12 @@ static const char *const fit_descriptions[] = {
 #define NETWORK_CACHING_LONGTEXT N_( \
     "Caching value for network resources, in milliseconds." )
 
+#define ADAPTIVE_CACHING_TEXT N_("Adaptive caching")
+#define ADAPTIVE_CACHING_LONGTEXT N_( \
+    "Adjust the effective caching target dynamically from the measured " \
+    "buffering fill rate and rebuffering history: slow or bursty links get " \
+    "more prebuffering, fast links keep latency low.")
+
 #define CR_AVERAGE_TEXT N_("Clock reference average counter")
 #define CR_AVERAGE_LONGTEXT N_( \
     "When using the PVR input (or a very irregular source), you should " \
@@ -586,6 +620,11 @@ static const char *const ppsz_clock_descriptions[] =
 /* Should be less than 1500 - 8[ppp] - 40[ip6] - 8[udp] in any case. */
 #define MTU_DEFAULT 1400
 
+#define DNS_CACHE_TTL_TEXT N_("DNS cache lifetime (sec)")
+#define DNS_CACHE_TTL_LONGTEXT N_( \
+    "Successful host name resolutions are reused for this many seconds " \
+    "before the resolver is queried again (0 = disable the cache).")
+
 #define TTL_TEXT N_("Hop limit (TTL)")
 #define TTL_LONGTEXT N_( \
     "This is the hop limit (also known as \"Time-To-Live\" or TTL) of " \
@@ -760,6 +799,13 @@ static const char* const ppsz_restore_playback_desc[] = {
     "This is the maximum size in bytes of the temporary files " \
     "that will be used to store the timeshifted streams." )
 
+#define INPUT_TIMESHIFT_RAM_TEXT N_("Timeshift memory buffer size")
+#define INPUT_TIMESHIFT_RAM_LONGTEXT N_( \
+    "This is the maximum amount of memory in bytes used to buffer " \
+    "timeshifted streams before spilling them to temporary files. " \
+    "Short pauses are then absorbed without any disk access. " \
+    "0 disables the memory buffer." )
+
 #define INPUT_TITLE_FORMAT_TEXT N_( "Change title according to current media" )
 #define INPUT_TITLE_FORMAT_LONGTEXT N_( "This option allows you to set the title according to what's being played<br>"  \
     "$a: Artist<br>$b: Album<br>$c: Copyright<br>$t: Title<br>$g: Genre<br>"  \
@@ -1007,6 +1053,29 @@ static const char* const ppsz_restore_playback_desc[] = {
 #define DEC_DEV_TEXT N_("Preferred decoder hardware device")
 #define DEC_DEV_LONGTEXT N_("This allows hardware decoding when available.")
 
+#define IMAGE_ENC_TEXT N_("Preferred image encoders list")
+#define IMAGE_ENC_LONGTEXT N_( \
+    "List of image encoder modules that VLC will try in priority when " \
+    "writing snapshots and scene pictures, for instance a hardware " \
+    "accelerated encoder. VLC falls back automatically to the other image " \
+    "encoders when none of them can handle the picture." )
+
+#define DEC_WORKERS_TEXT N_("Decoder worker threads")
+#define DEC_WORKERS_LONGTEXT N_( \
+    "Multiplex audio and subtitle decoding onto a shared pool of this many " \
+    "worker threads, scheduled by frame deadline, instead of one dedicated " \
+    "thread per elementary stream. Video decoding keeps dedicated threads. " \
+    "This reduces the thread count when playing many inputs at once, e.g. " \
+    "in headless probing deployments. Use 0 (the default) to keep a " \
+    "dedicated thread per elementary stream. Note that a decoder blocked " \
+    "on its output occupies a worker for that long.")
+
+#define DEC_CORE_AFFINITY_TEXT N_("Topology-aware decoder CPU affinity")
+#define DEC_CORE_AFFINITY_LONGTEXT N_( \
+    "On asymmetric (big.LITTLE) CPUs, pin video decoder threads to the " \
+    "performance cores and audio/subtitle decoder threads to the " \
+    "efficiency cores. This has no effect on symmetric systems.")
+
 /*****************************************************************************
  * Sout
  ****************************************************************************/
@@ -1090,6 +1159,12 @@ static const char* const ppsz_restore_playback_desc[] = {
     "the correct demuxer is not automatically detected. You should not "\
     "set this as a global option unless you really know what you are doing." )
 
+#define DEMUX_CACHE_TEXT N_("Demuxer probe cache")
+#define DEMUX_CACHE_LONGTEXT N_( \
+    "Remember which demuxer accepted each local file so that unchanged " \
+    "files skip the module probe loop on the next run. Mostly useful for " \
+    "repeated scans of large media libraries." )
+
 #define TRACER_TEXT N_("Tracer module")
 #define TRACER_LONGTEXT N_( \
     "This allow to select which tracer module you want to use." )
@@ -1130,6 +1205,20 @@ static const char* const ppsz_restore_playback_desc[] = {
 #define ONEINSTANCEWHENSTARTEDFROMFILE_TEXT N_( \
     "Use only one instance when started from file manager")
 
+#define MEMORY_BUDGET_TEXT N_("Memory budget (MiB)")
+#define MEMORY_BUDGET_LONGTEXT N_( \
+    "Shared memory ceiling for the caches and queues of this VLC instance, " \
+    "in MiB. When the sum of their usage exceeds the budget, the largest " \
+    "consumers are asked to shrink (read-ahead, queued data). 0 disables " \
+    "the budget." )
+
+#define FRAME_HUGEPAGES_TEXT N_("Use huge pages for frame buffers")
+#define FRAME_HUGEPAGES_LONGTEXT N_( \
+    "Back the recycled frame buffer pools with pre-faulted, hugepage-backed " \
+    "memory. This flattens the page fault and TLB miss latency spikes seen " \
+    "on high-bitrate capture inputs (DVB, UDP). Only effective on platforms " \
+    "with huge page support." )
+
 #define HPRIORITY_TEXT N_("Increase the priority of the process")
 #define HPRIORITY_LONGTEXT N_( \
     "Increasing the priority of the process will very likely improve your " \
@@ -1252,6 +1341,13 @@ static const char *const psz_recursive_list_text[] = {
 #define SP_LONGTEXT N_( \
     "Pause each item in the playlist on the first frame." )
 
+#define GAPLESS_PREROLL_TEXT N_("Gapless preroll (ms)")
+#define GAPLESS_PREROLL_LONGTEXT N_( \
+    "Open, probe and prime the next playlist item in the background when " \
+    "less than this much time is left on the current one, so playback can " \
+    "switch at the boundary without an opening gap. 0 disables the " \
+    "speculative preroll." )
+
 #define AUTOSTART_TEXT N_( "Auto start" )
 #define AUTOSTART_LONGTEXT N_( "Automatically start playing the playlist " \
                 "content once it's loaded." )
@@ -1650,6 +1746,13 @@ vlc_module_begin ()
         change_private ()
     add_bool( "drop-late-frames", true, DROP_LATE_FRAMES_TEXT,
               DROP_LATE_FRAMES_LONGTEXT )
+    add_integer( "vout-timer-slack", 20000, TIMER_SLACK_TEXT,
+              TIMER_SLACK_LONGTEXT )
+    add_bool( "numa-interleave", false, NUMA_INTERLEAVE_TEXT,
+              NUMA_INTERLEAVE_LONGTEXT )
+    add_string( "vout-cpu-affinity", NULL, VOUT_AFFINITY_TEXT,
+              VOUT_AFFINITY_LONGTEXT )
+    add_bool( "frame-qos", false, FRAME_QOS_TEXT, FRAME_QOS_LONGTEXT )
     /* Used in vout_synchro */
     add_obsolete_bool( "skip-frames" ) /* since 4.0.0 */
     add_obsolete_bool( "quiet-synchro" ) /* since 4.0.0 */
@@ -1901,6 +2004,9 @@ vlc_module_begin ()
     add_integer( "ipv4-timeout", 5 * 1000, TIMEOUT_TEXT,
                  TIMEOUT_LONGTEXT )
         change_integer_range( 0, INT_MAX )
+    add_integer( "dns-cache-ttl", 60, DNS_CACHE_TTL_TEXT,
+                 DNS_CACHE_TTL_LONGTEXT )
+        change_integer_range( 0, INT_MAX )
 
     add_string( "http-host", NULL, HTTP_HOST_TEXT, HOST_LONGTEXT )
     add_integer( "http-port", 8080, HTTP_PORT_TEXT, HTTP_PORT_LONGTEXT )
@@ -1978,6 +2084,9 @@ vlc_module_begin ()
                  NETWORK_CACHING_TEXT, NETWORK_CACHING_LONGTEXT )
         change_integer_range( 0, 60000 )
         change_safe()
+    add_bool( "adaptive-caching", false,
+              ADAPTIVE_CACHING_TEXT, ADAPTIVE_CACHING_LONGTEXT )
+        change_safe()
 
     add_integer( "cr-average", 40, CR_AVERAGE_TEXT,
                  CR_AVERAGE_LONGTEXT )
@@ -2000,6 +2109,8 @@ vlc_module_begin ()
                   INPUT_TIMESHIFT_PATH_TEXT, INPUT_TIMESHIFT_PATH_LONGTEXT)
     add_integer( "input-timeshift-granularity", -1, INPUT_TIMESHIFT_GRANULARITY_TEXT,
                  INPUT_TIMESHIFT_GRANULARITY_LONGTEXT )
+    add_integer( "input-timeshift-ram-size", -1, INPUT_TIMESHIFT_RAM_TEXT,
+                 INPUT_TIMESHIFT_RAM_LONGTEXT )
 
     add_string( "input-title-format", "$Z", INPUT_TITLE_FORMAT_TEXT, INPUT_TITLE_FORMAT_LONGTEXT )
 
@@ -2013,6 +2124,8 @@ vlc_module_begin ()
 
     add_module("demux", "demux", "any", DEMUX_TEXT, DEMUX_LONGTEXT)
     add_string( "demux-filter", NULL, DEMUX_FILTER_TEXT, DEMUX_FILTER_LONGTEXT )
+    add_bool( "demux-probe-cache", false, DEMUX_CACHE_TEXT,
+              DEMUX_CACHE_LONGTEXT )
 
     //set_subcategory( SUBCAT_INPUT_ACODEC )
     set_subcategory( SUBCAT_INPUT_VCODEC )
@@ -2020,7 +2133,12 @@ vlc_module_begin ()
     add_string( "codec", "any", CODEC_TEXT, CODEC_LONGTEXT )
     add_bool( "hw-dec", true, HW_DEC_TEXT, HW_DEC_LONGTEXT )
     add_obsolete_string( "encoder" ) /* since 4.0.0 */
+    add_string( "image-encoder", "any", IMAGE_ENC_TEXT, IMAGE_ENC_LONGTEXT )
     add_module("dec-dev", "decoder device", "any", DEC_DEV_TEXT, DEC_DEV_LONGTEXT)
+    add_integer( "dec-workers", 0, DEC_WORKERS_TEXT, DEC_WORKERS_LONGTEXT )
+        change_integer_range( 0, 64 )
+    add_bool( "decoder-core-affinity", false, DEC_CORE_AFFINITY_TEXT,
+              DEC_CORE_AFFINITY_LONGTEXT )
 
     //set_subcategory( SUBCAT_INPUT_SCODEC )
     set_subcategory( SUBCAT_INPUT_STREAM_FILTER )
@@ -2098,6 +2216,13 @@ vlc_module_begin ()
     add_obsolete_bool( "inhibit" ) /* since 3.0.0 */
 #endif
 
+    add_integer( "memory-budget", 0, MEMORY_BUDGET_TEXT,
+              MEMORY_BUDGET_LONGTEXT )
+        change_integer_range( 0, SIZE_MAX >> 21 )
+
+    add_bool( "frame-hugepages", false, FRAME_HUGEPAGES_TEXT,
+              FRAME_HUGEPAGES_LONGTEXT )
+
 #if defined(_WIN32) || defined(__OS2__)
     add_bool( "high-priority", false, HPRIORITY_TEXT,
               HPRIORITY_LONGTEXT )
@@ -2126,6 +2251,9 @@ vlc_module_begin ()
     add_bool( "play-and-pause", false, PAP_TEXT, PAP_LONGTEXT )
         change_safe()
     add_bool( "start-paused", false, SP_TEXT, SP_LONGTEXT )
+    add_integer( "gapless-preroll", 0, GAPLESS_PREROLL_TEXT,
+                 GAPLESS_PREROLL_LONGTEXT )
+        change_integer_range( 0, 60000 )
     add_bool( "playlist-autostart", true,
               AUTOSTART_TEXT, AUTOSTART_LONGTEXT )
     add_bool( "playlist-cork", true, CORK_TEXT, CORK_LONGTEXT )
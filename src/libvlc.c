@@ -41,7 +41,11 @@
 
 #include "modules/modules.h"
 #include "config/configuration.h"
+#include "input/decoder_pool.h"
 #include "media_source/media_source.h"
+#include "misc/frame.h"
+#include "misc/membudget.h"
+#include "misc/picture.h"
 
 #include <stdio.h>                                              /* sprintf() */
 #include <string.h>
@@ -76,6 +80,45 @@
  *****************************************************************************/
 static void GetFilenames  ( libvlc_int_t *, unsigned, const char *const [] );
 
+/*
+ * Startup steps that are independent of the rest of the initialization
+ * sequence run on background threads; each entry point below is one such
+ * step. The spawner enforces the ordering constraints: all of them need
+ * the module bank and the configuration, none of their results are read
+ * before the matching vlc_join().
+ */
+static void *ConfigPrefetchThread( void *data )
+{
+    char *psz_filename = data;
+
+    vlc_thread_set_name("vlc-cfg-fetch");
+    config_PrefetchConfigFile( psz_filename );
+    free( psz_filename );
+    return NULL;
+}
+
+static void *KeystoreInitThread( void *data )
+{
+    libvlc_int_t *p_libvlc = data;
+
+    vlc_thread_set_name("vlc-keystore");
+    if( libvlc_InternalKeystoreInit( p_libvlc ) != VLC_SUCCESS )
+        msg_Warn( p_libvlc, "memory keystore init failed" );
+    return NULL;
+}
+
+static void *MediaLibraryInitThread( void *data )
+{
+    libvlc_int_t *p_libvlc = data;
+    libvlc_priv_t *priv = libvlc_priv( p_libvlc );
+
+    vlc_thread_set_name("vlc-ml-init");
+    priv->p_media_library = libvlc_MlCreate( p_libvlc );
+    if( priv->p_media_library == NULL )
+        msg_Warn( p_libvlc, "Media library initialization failed" );
+    return NULL;
+}
+
 /**
  * Allocate a blank libvlc instance, also setting the exit handler.
  * Vlc's threading system must have been initialized first
@@ -96,6 +139,9 @@ libvlc_int_t * libvlc_InternalCreate( void )
     priv->main_playlist = NULL;
     priv->p_vlm = NULL;
     priv->media_source_provider = NULL;
+    priv->decoder_pool = NULL;
+    priv->membudget = NULL;
+    atomic_init(&priv->video_decoders, 0);
 
     vlc_ExitInit( &priv->exit );
 
@@ -133,6 +179,8 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     libvlc_priv_t *priv = libvlc_priv (p_libvlc);
     char        *psz_val;
     int          i_ret = VLC_EGENERIC;
+    vlc_thread_t keystore_thread, ml_thread;
+    bool         b_keystore_thread = false, b_ml_thread = false;
 
     if (unlikely(vlc_LogPreinit(p_libvlc)))
         return VLC_ENOMEM;
@@ -158,9 +206,33 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
      * We need to do this here such that option sets from plugins are added to
      * the config system in order that full commandline argument parsing and
      * saved settings handling can function properly.
+     *
+     * While the plugins (cache) are scanned, pull the configuration file
+     * into the page cache on a background thread: the file cannot be
+     * parsed before the plugin options exist, but it can be read. The
+     * path is resolved here, on this thread, as the parameter table is
+     * not usable while the plugins scan rebuilds it.
      */
+    vlc_thread_t prefetch_thread;
+    bool b_prefetch_thread = false;
+    if( !var_InheritBool( p_libvlc, "ignore-config" ) )
+    {
+        char *psz_config_path = config_GetConfigFile( p_libvlc );
+        if( psz_config_path != NULL )
+        {
+            b_prefetch_thread = vlc_clone( &prefetch_thread,
+                                           ConfigPrefetchThread,
+                                           psz_config_path ) == 0;
+            if( !b_prefetch_thread )
+                free( psz_config_path );
+        }
+    }
+
     module_LoadPlugins (p_libvlc);
 
+    if( b_prefetch_thread )
+        vlc_join( prefetch_thread, NULL );
+
     /*
      * Fully process command line settings.
      * Results are stored as runtime state within `p_libvlc` object variables.
@@ -178,6 +250,9 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
             config_SaveConfigFile( p_libvlc ); /* Save default config */
         else
             config_LoadConfigFile( p_libvlc );
+
+        /* Write settings changes back asynchronously from now on */
+        config_AutoSaveStart( p_libvlc );
     }
 
     vlc_LogInit(p_libvlc);
@@ -209,16 +284,32 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
 
     if( libvlc_InternalDialogInit( p_libvlc ) != VLC_SUCCESS )
         goto error;
-    if( libvlc_InternalKeystoreInit( p_libvlc ) != VLC_SUCCESS )
+
+    /* The keystore and media library initializations are I/O bound (module
+     * probe, database open) and nothing below depends on them: run them in
+     * the background and join before returning or bailing out. */
+    b_keystore_thread =
+        vlc_clone( &keystore_thread, KeystoreInitThread, p_libvlc ) == 0;
+    if( !b_keystore_thread &&
+        libvlc_InternalKeystoreInit( p_libvlc ) != VLC_SUCCESS )
         msg_Warn( p_libvlc, "memory keystore init failed" );
 
     vlc_CPU_dump( VLC_OBJECT(p_libvlc) );
 
+    picture_SetNumaInterleave( var_InheritBool( p_libvlc, "numa-interleave" ) );
+
+    vlc_frame_SetHugePages( var_InheritBool( p_libvlc, "frame-hugepages" ) );
+
     if( var_InheritBool( p_libvlc, "media-library") )
     {
-        priv->p_media_library = libvlc_MlCreate( p_libvlc );
-        if ( priv->p_media_library == NULL )
-            msg_Warn( p_libvlc, "Media library initialization failed" );
+        b_ml_thread =
+            vlc_clone( &ml_thread, MediaLibraryInitThread, p_libvlc ) == 0;
+        if( !b_ml_thread )
+        {
+            priv->p_media_library = libvlc_MlCreate( p_libvlc );
+            if ( priv->p_media_library == NULL )
+                msg_Warn( p_libvlc, "Media library initialization failed" );
+        }
     }
 
     /*
@@ -263,6 +354,19 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     /* System specific configuration */
     system_Configure( p_libvlc, i_argc - vlc_optind, ppsz_argv + vlc_optind );
 
+    /* VLM and the interfaces below may use the keystore and the media
+     * library as soon as they start: the background steps must be done. */
+    if( b_keystore_thread )
+    {
+        vlc_join( keystore_thread, NULL );
+        b_keystore_thread = false;
+    }
+    if( b_ml_thread )
+    {
+        vlc_join( ml_thread, NULL );
+        b_ml_thread = false;
+    }
+
 #ifdef ENABLE_VLM
     /* Initialize VLM if vlm-conf is specified */
     char *psz_parser = var_InheritString( p_libvlc, "vlm-conf" );
@@ -327,6 +431,10 @@ int libvlc_InternalInit( libvlc_int_t *p_libvlc, int i_argc,
     return VLC_SUCCESS;
 
 error:
+    if( b_keystore_thread )
+        vlc_join( keystore_thread, NULL );
+    if( b_ml_thread )
+        vlc_join( ml_thread, NULL );
     libvlc_InternalCleanup( p_libvlc );
     return i_ret;
 }
@@ -366,6 +474,12 @@ void libvlc_InternalCleanup( libvlc_int_t *p_libvlc )
     if (priv->main_playlist)
         vlc_playlist_Delete(priv->main_playlist);
 
+    /* All players are gone, their decoders with them */
+    vlc_decoder_pool_Destroy( p_libvlc );
+
+    /* All inputs are gone, no memory consumer is left attached */
+    vlc_membudget_Destroy( p_libvlc );
+
     if ( priv->p_media_library )
         libvlc_MlRelease( priv->p_media_library );
 
@@ -377,6 +491,7 @@ void libvlc_InternalCleanup( libvlc_int_t *p_libvlc )
     libvlc_InternalActionsClean( p_libvlc );
 
     /* Save the configuration */
+    config_AutoSaveStop( p_libvlc );
     if( !var_InheritBool( p_libvlc, "ignore-config" ) )
         config_AutoSaveConfigFile( p_libvlc );
 
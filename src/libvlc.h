@@ -26,6 +26,8 @@
 
 #include <vlc_input_item.h>
 
+#include <stdatomic.h>
+
 # ifdef __cplusplus
 extern "C" {
 # endif
@@ -43,12 +45,17 @@ void system_Configure ( libvlc_int_t *, int, const char *const [] );
 void system_End(void);
 #endif
 void vlc_CPU_dump(vlc_object_t *);
+#ifdef __linux__
+# include <sched.h>
+bool vlc_CPU_LittleBig(cpu_set_t *restrict big, cpu_set_t *restrict little);
+#endif
 
 /*
  * Threads subsystem
  */
 
 void vlc_threads_setup (libvlc_int_t *);
+void vlc_thread_SetCoreClass(vlc_object_t *, bool performance);
 
 void vlc_trace (const char *fn, const char *file, unsigned line);
 #define vlc_backtrace() vlc_trace(__func__, __FILE__, __LINE__)
@@ -187,6 +194,9 @@ typedef struct libvlc_priv_t
     vlc_actions_t *actions; ///< Hotkeys handler
     struct vlc_medialibrary_t *p_media_library; ///< Media library instance
     struct vlc_tracer *tracer; ///< Tracer callbacks
+    struct vlc_decoder_pool *decoder_pool; ///< Shared decoder worker pool (or NULL)
+    struct vlc_membudget *membudget; ///< Shared memory budget (or NULL)
+    atomic_uint video_decoders; ///< Video decoders sharing the decode thread budget
 
     /* Exit callback */
     vlc_exit_t       exit;
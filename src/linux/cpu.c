@@ -22,8 +22,11 @@
 # include "config.h"
 #endif
 
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
+#include <sched.h>
+#include <unistd.h>
 #ifdef HAVE_SYS_AUXV_H
 # include <sys/auxv.h>
 #endif
@@ -33,6 +36,8 @@
 #include <vlc_common.h>
 #include <vlc_cpu.h>
 
+#include "../libvlc.h"
+
 #if defined (__aarch64__)
 unsigned vlc_CPU_raw(void)
 {
@@ -134,6 +139,8 @@ unsigned vlc_CPU_raw(void)
                 core_caps |= VLC_CPU_AVX;
             if (!strcmp (cap, "avx2"))
                 core_caps |= VLC_CPU_AVX2;
+            if (!strcmp (cap, "fma"))
+                core_caps |= VLC_CPU_FMA3;
         }
 
         /* Take the intersection of capabilities of each processor */
@@ -148,3 +155,63 @@ unsigned vlc_CPU_raw(void)
     return all_caps;
 }
 #endif
+
+static bool vlc_CPU_ReadMaxFreq(long cpu, unsigned long *restrict freq)
+{
+    char path[sizeof ("/sys/devices/system/cpu/cpu9223372036854775807"
+                      "/cpufreq/cpuinfo_max_freq")];
+
+    snprintf(path, sizeof (path),
+             "/sys/devices/system/cpu/cpu%ld/cpufreq/cpuinfo_max_freq", cpu);
+
+    FILE *stream = fopen(path, "rte");
+    if (stream == NULL)
+        return false;
+
+    int ret = fscanf(stream, "%lu", freq);
+    fclose(stream);
+    return ret == 1;
+}
+
+/* Classify cores by their cpufreq ceiling: on asymmetric (big.LITTLE,
+ * DynamIQ) systems, the performance cluster advertises a higher
+ * cpuinfo_max_freq than the efficiency cluster. */
+bool vlc_CPU_LittleBig(cpu_set_t *restrict big, cpu_set_t *restrict little)
+{
+    long ncpu = sysconf(_SC_NPROCESSORS_CONF);
+    if (ncpu <= 1)
+        return false;
+    if (ncpu > CPU_SETSIZE)
+        ncpu = CPU_SETSIZE;
+
+    unsigned long top = 0, bottom = ULONG_MAX;
+
+    for (long cpu = 0; cpu < ncpu; cpu++)
+    {
+        unsigned long freq;
+
+        if (!vlc_CPU_ReadMaxFreq(cpu, &freq))
+            return false;
+        if (freq > top)
+            top = freq;
+        if (freq < bottom)
+            bottom = freq;
+    }
+
+    if (top == bottom) /* symmetric system */
+        return false;
+
+    CPU_ZERO(big);
+    CPU_ZERO(little);
+
+    for (long cpu = 0; cpu < ncpu; cpu++)
+    {
+        unsigned long freq;
+
+        if (!vlc_CPU_ReadMaxFreq(cpu, &freq))
+            return false;
+        CPU_SET(cpu, (freq == top) ? big : little);
+    }
+
+    return true;
+}
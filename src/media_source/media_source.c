@@ -35,6 +35,20 @@
 #define vlc_module_name "test"
 #endif /* TEST_MEDIA_SOURCE */
 
+/* Batch and rate-limit services discovery additions: a large server
+ * announcing thousands of items then triggers a few grouped
+ * on_children_added events instead of one callback per item. */
+#define SD_BATCH_DELAY VLC_TICK_FROM_MS(50)
+#define SD_BATCH_MAX 256
+
+struct sd_pending_add
+{
+    input_item_t *parent; /**< held, NULL for the root node */
+    input_item_t *media; /**< held */
+};
+
+typedef struct VLC_VECTOR(struct sd_pending_add) sd_pending_vector;
+
 typedef struct
 {
     vlc_media_source_t public_data;
@@ -43,6 +57,13 @@ typedef struct
     size_t rc;
     vlc_media_source_provider_t *owner;
     struct vlc_list node;
+
+    vlc_timer_t flush_timer;
+    vlc_mutex_t pending_lock;
+    sd_pending_vector pending;
+    bool flush_scheduled;
+    bool draining; /**< deliver synchronously, the timer is gone */
+
     char name[];
 } media_source_private_t;
 
@@ -55,39 +76,161 @@ struct vlc_media_source_provider_t
     struct vlc_list media_sources;
 };
 
+static void
+media_source_AddDirect(vlc_media_tree_t *tree, input_item_t *parent,
+                       input_item_t *media)
+{
+    input_item_node_t *parent_node;
+    if (parent)
+    {
+        if (!vlc_media_tree_Find(tree, parent, &parent_node, NULL))
+            /* the parent node probably failed to be allocated */
+            return;
+    }
+    else
+        parent_node = &tree->root;
+
+    vlc_media_tree_Add(tree, parent_node, media);
+}
+
+/* Deliver all queued additions to the tree, grouping consecutive items
+ * sharing a parent into a single listener notification */
+static void
+media_source_FlushPending(media_source_private_t *priv)
+{
+    vlc_media_source_t *ms = &priv->public_data;
+    vlc_media_tree_t *tree = ms->tree;
+
+    vlc_mutex_lock(&priv->pending_lock);
+    sd_pending_vector batch = priv->pending;
+    vlc_vector_init(&priv->pending);
+    priv->flush_scheduled = false;
+    vlc_mutex_unlock(&priv->pending_lock);
+
+    if (batch.size == 0)
+    {
+        vlc_vector_destroy(&batch);
+        return;
+    }
+
+    input_item_t **medias = vlc_alloc(batch.size, sizeof(*medias));
+
+    vlc_media_tree_Lock(tree);
+    size_t i = 0;
+    while (i < batch.size)
+    {
+        input_item_t *parent = batch.data[i].parent;
+        size_t end = i + 1;
+        while (end < batch.size && batch.data[end].parent == parent)
+            end++;
+
+        if (medias == NULL)
+        {
+            /* deliver one by one */
+            for (size_t j = i; j < end; ++j)
+                media_source_AddDirect(tree, parent, batch.data[j].media);
+            i = end;
+            continue;
+        }
+
+        input_item_node_t *parent_node;
+        if (parent)
+        {
+            if (!vlc_media_tree_Find(tree, parent, &parent_node, NULL))
+            {
+                /* the parent node probably failed to be allocated */
+                i = end;
+                continue;
+            }
+        }
+        else
+            parent_node = &tree->root;
+
+        for (size_t j = i; j < end; ++j)
+            medias[j - i] = batch.data[j].media;
+        vlc_media_tree_AddMany(tree, parent_node, medias, end - i);
+        i = end;
+    }
+    vlc_media_tree_Unlock(tree);
+
+    free(medias);
+    for (size_t j = 0; j < batch.size; ++j)
+    {
+        if (batch.data[j].parent)
+            input_item_Release(batch.data[j].parent);
+        input_item_Release(batch.data[j].media);
+    }
+    vlc_vector_destroy(&batch);
+}
+
+static void
+media_source_FlushTimer(void *userdata)
+{
+    media_source_FlushPending(userdata);
+}
+
 /* A new item has been added to a certain services discovery */
 static void
 services_discovery_item_added(services_discovery_t *sd,
                               input_item_t *parent, input_item_t *media)
 {
     vlc_media_source_t *ms = sd->owner.sys;
+    media_source_private_t *priv = ms_priv(ms);
     vlc_media_tree_t *tree = ms->tree;
 
     msg_Dbg(sd, "adding: %s", media->psz_name ? media->psz_name : "(null)");
 
-    vlc_media_tree_Lock(tree);
+    struct sd_pending_add entry = {
+        .parent = parent ? input_item_Hold(parent) : NULL,
+        .media = input_item_Hold(media),
+    };
 
-    input_item_node_t *parent_node;
-    if (parent)
-        vlc_media_tree_Find(tree, parent, &parent_node, NULL);
-    else
-        parent_node = &tree->root;
+    vlc_mutex_lock(&priv->pending_lock);
+    bool direct = priv->draining;
+    bool flush_now = false;
+    if (!direct)
+    {
+        if (unlikely(!vlc_vector_push(&priv->pending, entry)))
+            /* queued items must be delivered first to keep ordering */
+            direct = flush_now = true;
+        else if (priv->pending.size >= SD_BATCH_MAX)
+            flush_now = true;
+        else if (!priv->flush_scheduled)
+        {
+            vlc_timer_schedule(priv->flush_timer, false, SD_BATCH_DELAY,
+                               VLC_TIMER_FIRE_ONCE);
+            priv->flush_scheduled = true;
+        }
+    }
+    vlc_mutex_unlock(&priv->pending_lock);
 
-    bool added = vlc_media_tree_Add(tree, parent_node, media) != NULL;
-    if (unlikely(!added))
-        msg_Err(sd, "could not allocate media tree node");
+    if (flush_now)
+        media_source_FlushPending(priv);
 
-    vlc_media_tree_Unlock(tree);
+    if (direct)
+    {
+        vlc_media_tree_Lock(tree);
+        media_source_AddDirect(tree, parent, media);
+        vlc_media_tree_Unlock(tree);
+
+        if (entry.parent)
+            input_item_Release(entry.parent);
+        input_item_Release(entry.media);
+    }
 }
 
 static void
 services_discovery_item_removed(services_discovery_t *sd, input_item_t *media)
 {
     vlc_media_source_t *ms = sd->owner.sys;
+    media_source_private_t *priv = ms_priv(ms);
     vlc_media_tree_t *tree = ms->tree;
 
     msg_Dbg(sd, "removing: %s", media->psz_name ? media->psz_name : "(null)");
 
+    /* deliver queued additions first: the item may still be pending */
+    media_source_FlushPending(priv);
+
     vlc_media_tree_Lock(tree);
     bool removed = vlc_media_tree_Remove(tree, media);
     vlc_media_tree_Unlock(tree);
@@ -124,6 +267,17 @@ vlc_media_source_New(vlc_media_source_provider_t *provider, const char *name)
         return NULL;
     }
 
+    vlc_mutex_init(&priv->pending_lock);
+    vlc_vector_init(&priv->pending);
+    priv->flush_scheduled = false;
+    priv->draining = false;
+    if (vlc_timer_create(&priv->flush_timer, media_source_FlushTimer, priv))
+    {
+        vlc_media_tree_Release(ms->tree);
+        free(priv);
+        return NULL;
+    }
+
     strcpy(priv->name, name);
 
     struct services_discovery_owner_t owner = {
@@ -134,6 +288,8 @@ vlc_media_source_New(vlc_media_source_provider_t *provider, const char *name)
     priv->sd = vlc_sd_Create(provider, name, &owner);
     if (unlikely(!priv->sd))
     {
+        vlc_timer_destroy(priv->flush_timer);
+        media_source_FlushPending(priv);
         vlc_media_tree_Release(ms->tree);
         free(priv);
         return NULL;
@@ -153,6 +309,14 @@ vlc_media_source_Delete(vlc_media_source_t *ms)
 {
     media_source_private_t *priv = ms_priv(ms);
 
+    vlc_mutex_lock(&priv->pending_lock);
+    priv->draining = true;
+    vlc_mutex_unlock(&priv->pending_lock);
+    vlc_timer_destroy(priv->flush_timer);
+
+    /* deliver what was queued: the SD may remove items while closing */
+    media_source_FlushPending(priv);
+
     vlc_sd_Destroy(priv->sd);
     vlc_media_tree_Release(ms->tree);
     free(priv);
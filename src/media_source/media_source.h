@@ -30,4 +30,13 @@ vlc_media_source_provider_New(vlc_object_t *parent);
 
 void vlc_media_source_provider_Delete(vlc_media_source_provider_t *msp);
 
+/**
+ * Add several medias under the given parent at once, notifying listeners
+ * with a single on_children_added event (batched services discovery
+ * delivery).
+ */
+void
+vlc_media_tree_AddMany(vlc_media_tree_t *tree, input_item_node_t *parent,
+                       input_item_t *const medias[], size_t count);
+
 #endif
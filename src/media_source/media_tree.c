@@ -31,7 +31,9 @@
 #include <vlc_input_item.h>
 #include <vlc_threads.h>
 #include <vlc_preparser.h>
+#include <vlc_vector.h>
 #include "libvlc.h"
+#include "media_source.h"
 
 struct vlc_media_tree_listener_id
 {
@@ -40,11 +42,22 @@ struct vlc_media_tree_listener_id
     struct vlc_list node; /**< node of media_tree_private_t.listeners */
 };
 
+/* Entry of the incremental index, sorted by media pointer value, so that
+ * lookups do not require a full tree traversal */
+struct vlc_media_tree_index_entry
+{
+    const input_item_t *media;
+    input_item_node_t *node;
+    input_item_node_t *parent;
+};
+
 typedef struct
 {
     vlc_media_tree_t public_data;
 
     struct vlc_list listeners; /**< list of vlc_media_tree_listener_id.node */
+    struct VLC_VECTOR(struct vlc_media_tree_index_entry) index;
+    bool index_failed; /**< on allocation failure, fall back to traversals */
     vlc_mutex_t lock;
     vlc_atomic_rc_t rc;
 } media_tree_private_t;
@@ -61,6 +74,8 @@ vlc_media_tree_New(void)
     vlc_mutex_init(&priv->lock);
     vlc_atomic_rc_init(&priv->rc);
     vlc_list_init(&priv->listeners);
+    vlc_vector_init(&priv->index);
+    priv->index_failed = false;
 
     vlc_media_tree_t *tree = &priv->public_data;
     input_item_node_t *root = &tree->root;
@@ -94,6 +109,79 @@ do { \
         vlc_media_tree_NotifyListener(tree, listener, event, ##__VA_ARGS__); \
 } while (0)
 
+static bool
+vlc_media_tree_IndexLookup(media_tree_private_t *priv,
+                           const input_item_t *media, size_t *pos)
+{
+    size_t lo = 0, hi = priv->index.size;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        const input_item_t *entry = priv->index.data[mid].media;
+        if (entry == media)
+        {
+            *pos = mid;
+            return true;
+        }
+        if ((uintptr_t) entry < (uintptr_t) media)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *pos = lo;
+    return false;
+}
+
+static void
+vlc_media_tree_IndexInsert(media_tree_private_t *priv,
+                           input_item_node_t *parent, input_item_node_t *node)
+{
+    if (priv->index_failed)
+        return;
+
+    size_t pos;
+    vlc_media_tree_IndexLookup(priv, node->p_item, &pos);
+    struct vlc_media_tree_index_entry entry = { node->p_item, node, parent };
+    if (unlikely(!vlc_vector_insert(&priv->index, pos, entry)))
+    {
+        /* degraded mode: lookups traverse the whole tree */
+        vlc_vector_clear(&priv->index);
+        priv->index_failed = true;
+    }
+}
+
+static void
+vlc_media_tree_IndexRemove(media_tree_private_t *priv,
+                           const input_item_node_t *node)
+{
+    size_t pos;
+    if (priv->index_failed ||
+        !vlc_media_tree_IndexLookup(priv, node->p_item, &pos))
+        return;
+
+    /* several entries may share a media: match the exact node */
+    while (pos > 0 && priv->index.data[pos - 1].media == node->p_item)
+        pos--;
+    for (; pos < priv->index.size &&
+           priv->index.data[pos].media == node->p_item; ++pos)
+    {
+        if (priv->index.data[pos].node == node)
+        {
+            vlc_vector_remove(&priv->index, pos);
+            return;
+        }
+    }
+}
+
+static void
+vlc_media_tree_IndexRemoveSubtree(media_tree_private_t *priv,
+                                  input_item_node_t *node)
+{
+    for (int i = 0; i < node->i_children; ++i)
+        vlc_media_tree_IndexRemoveSubtree(priv, node->pp_children[i]);
+    vlc_media_tree_IndexRemove(priv, node);
+}
+
 static bool
 vlc_media_tree_FindNodeByMedia(input_item_node_t *parent,
                                const input_item_t *media,
@@ -119,27 +207,34 @@ vlc_media_tree_FindNodeByMedia(input_item_node_t *parent,
 }
 
 static input_item_node_t *
-vlc_media_tree_AddChild(input_item_node_t *parent, input_item_t *media);
+vlc_media_tree_AddChild(vlc_media_tree_t *tree, input_item_node_t *parent,
+                        input_item_t *media);
 
 static void
-vlc_media_tree_AddSubtree(input_item_node_t *to, input_item_node_t *from)
+vlc_media_tree_AddSubtree(vlc_media_tree_t *tree, input_item_node_t *to,
+                          input_item_node_t *from)
 {
     for (int i = 0; i < from->i_children; ++i)
     {
         input_item_node_t *child = from->pp_children[i];
-        input_item_node_t *node = vlc_media_tree_AddChild(to, child->p_item);
+        input_item_node_t *node = vlc_media_tree_AddChild(tree, to,
+                                                          child->p_item);
         if (unlikely(!node))
             break; /* what could we do? */
 
-        vlc_media_tree_AddSubtree(node, child);
+        vlc_media_tree_AddSubtree(tree, node, child);
     }
 }
 
 static void
-vlc_media_tree_ClearChildren(input_item_node_t *root)
+vlc_media_tree_ClearChildren(vlc_media_tree_t *tree, input_item_node_t *root)
 {
+    media_tree_private_t *priv = mt_priv(tree);
     for (int i = 0; i < root->i_children; ++i)
+    {
+        vlc_media_tree_IndexRemoveSubtree(priv, root->pp_children[i]);
         input_item_node_Delete(root->pp_children[i]);
+    }
 
     free(root->pp_children);
     root->pp_children = NULL;
@@ -154,17 +249,15 @@ media_subtree_changed(input_item_t *media, input_item_node_t *node,
 
     vlc_media_tree_Lock(tree);
     input_item_node_t *subtree_root;
-    /* TODO retrieve the node without traversing the tree */
-    bool found = vlc_media_tree_FindNodeByMedia(&tree->root, media,
-                                                &subtree_root, NULL);
+    bool found = vlc_media_tree_Find(tree, media, &subtree_root, NULL);
     if (!found) {
         /* the node probably failed to be allocated */
         vlc_media_tree_Unlock(tree);
         return;
     }
 
-    vlc_media_tree_ClearChildren(subtree_root);
-    vlc_media_tree_AddSubtree(subtree_root, node);
+    vlc_media_tree_ClearChildren(tree, subtree_root);
+    vlc_media_tree_AddSubtree(tree, subtree_root, node);
     vlc_media_tree_Notify(tree, on_children_reset, subtree_root);
     vlc_media_tree_Unlock(tree);
 }
@@ -176,9 +269,7 @@ media_subtree_preparse_ended(input_item_t *media, int status, void *user_data)
 
     vlc_media_tree_Lock(tree);
     input_item_node_t *subtree_root;
-    /* TODO retrieve the node without traversing the tree */
-    bool found = vlc_media_tree_FindNodeByMedia(&tree->root, media,
-                                                &subtree_root, NULL);
+    bool found = vlc_media_tree_Find(tree, media, &subtree_root, NULL);
     if (!found) {
         /* the node probably failed to be allocated */
         vlc_media_tree_Unlock(tree);
@@ -191,7 +282,7 @@ media_subtree_preparse_ended(input_item_t *media, int status, void *user_data)
 static inline void
 vlc_media_tree_DestroyRootNode(vlc_media_tree_t *tree)
 {
-    vlc_media_tree_ClearChildren(&tree->root);
+    vlc_media_tree_ClearChildren(tree, &tree->root);
 }
 
 static void
@@ -203,6 +294,7 @@ vlc_media_tree_Delete(vlc_media_tree_t *tree)
         free(listener);
     vlc_list_init(&priv->listeners); /* reset */
     vlc_media_tree_DestroyRootNode(tree);
+    vlc_vector_destroy(&priv->index);
     free(tree);
 }
 
@@ -236,13 +328,15 @@ vlc_media_tree_Unlock(vlc_media_tree_t *tree)
 }
 
 static input_item_node_t *
-vlc_media_tree_AddChild(input_item_node_t *parent, input_item_t *media)
+vlc_media_tree_AddChild(vlc_media_tree_t *tree, input_item_node_t *parent,
+                        input_item_t *media)
 {
     input_item_node_t *node = input_item_node_Create(media);
     if (unlikely(!node))
         return NULL;
 
     input_item_node_AppendNode(parent, node);
+    vlc_media_tree_IndexInsert(mt_priv(tree), parent, node);
 
     return node;
 }
@@ -295,7 +389,7 @@ vlc_media_tree_Add(vlc_media_tree_t *tree, input_item_node_t *parent,
 {
     vlc_media_tree_AssertLocked(tree);
 
-    input_item_node_t *node = vlc_media_tree_AddChild(parent, media);
+    input_item_node_t *node = vlc_media_tree_AddChild(tree, parent, media);
     if (unlikely(!node))
         return NULL;
 
@@ -304,6 +398,23 @@ vlc_media_tree_Add(vlc_media_tree_t *tree, input_item_node_t *parent,
     return node;
 }
 
+void
+vlc_media_tree_AddMany(vlc_media_tree_t *tree, input_item_node_t *parent,
+                       input_item_t *const medias[], size_t count)
+{
+    vlc_media_tree_AssertLocked(tree);
+
+    int first = parent->i_children;
+    for (size_t i = 0; i < count; ++i)
+        if (unlikely(!vlc_media_tree_AddChild(tree, parent, medias[i])))
+            break;
+
+    int added = parent->i_children - first;
+    if (added > 0)
+        vlc_media_tree_Notify(tree, on_children_added, parent,
+                              &parent->pp_children[first], (size_t) added);
+}
+
 bool
 vlc_media_tree_Find(vlc_media_tree_t *tree, const input_item_t *media,
                     input_item_node_t **result,
@@ -311,7 +422,19 @@ vlc_media_tree_Find(vlc_media_tree_t *tree, const input_item_t *media,
 {
     vlc_media_tree_AssertLocked(tree);
 
-    /* quick & dirty depth-first O(n) implementation, with n the number of nodes
+    media_tree_private_t *priv = mt_priv(tree);
+    if (likely(!priv->index_failed))
+    {
+        size_t pos;
+        if (!vlc_media_tree_IndexLookup(priv, media, &pos))
+            return false;
+        *result = priv->index.data[pos].node;
+        if (result_parent)
+            *result_parent = priv->index.data[pos].parent;
+        return true;
+    }
+
+    /* quick & dirty depth-first O(n) fallback, with n the number of nodes
      * in the tree */
     return vlc_media_tree_FindNodeByMedia(&tree->root, media, result,
                                           result_parent);
@@ -324,9 +447,10 @@ vlc_media_tree_Remove(vlc_media_tree_t *tree, input_item_t *media)
 
     input_item_node_t *node;
     input_item_node_t *parent;
-    if (!vlc_media_tree_FindNodeByMedia(&tree->root, media, &node, &parent))
+    if (!vlc_media_tree_Find(tree, media, &node, &parent))
         return false;
 
+    vlc_media_tree_IndexRemoveSubtree(mt_priv(tree), node);
     input_item_node_RemoveNode(parent, node);
     vlc_media_tree_Notify(tree, on_children_removed, parent, &node, 1);
     input_item_node_Delete(node);
@@ -78,33 +78,76 @@ vlc_ancillary_GetData(const struct vlc_ancillary *ancillary)
     return ancillary->data;
 }
 
-void
-vlc_ancillary_array_Clear(struct vlc_ancillary ***array)
+/*
+ * The entries are prefixed by a hidden refcounted header so that
+ * duplicating the ancillaries of a frame/picture copy or clone is a
+ * single reference increment, and the container is only copied when a
+ * shared one is mutated (copy-on-write). It is allocated with room for
+ * VLC_ANCILLARY_ARRAY_MIN_CAP entries up front since HDR pipelines
+ * attach one or two ancillaries (HDR10+ metadata, Dolby Vision RPU) to
+ * every single picture: in the steady state, forwarding them along the
+ * pipeline does not allocate at all.
+ */
+#define VLC_ANCILLARY_ARRAY_MIN_CAP 2
+
+struct vlc_ancillary_array_hdr
 {
-    if (*array != NULL)
-    {
-        for (struct vlc_ancillary **ancillary = *array;
-             *ancillary != NULL; ancillary++)
-        {
-            vlc_ancillary_Release(*ancillary);
-        }
+    vlc_atomic_rc_t rc;
+    size_t count;
+    size_t capacity;
+    struct vlc_ancillary *entries[];
+};
 
-        free(*array);
-        *array = NULL;
-    }
+static struct vlc_ancillary_array_hdr *
+vlc_ancillary_array_ToHdr(struct vlc_ancillary **array)
+{
+    return (struct vlc_ancillary_array_hdr *)
+        ((char *)array - offsetof(struct vlc_ancillary_array_hdr, entries));
+}
+
+static struct vlc_ancillary_array_hdr *
+vlc_ancillary_array_New(size_t capacity)
+{
+    struct vlc_ancillary_array_hdr *hdr =
+        malloc(sizeof(*hdr) + capacity * sizeof(hdr->entries[0]));
+    if (hdr == NULL)
+        return NULL;
+
+    vlc_atomic_rc_init(&hdr->rc);
+    hdr->count = 0;
+    hdr->capacity = capacity;
+    return hdr;
+}
+
+static struct vlc_ancillary_array_hdr *
+vlc_ancillary_array_CopyHdr(const struct vlc_ancillary_array_hdr *hdr,
+                            size_t capacity)
+{
+    assert(capacity >= hdr->count);
+    struct vlc_ancillary_array_hdr *copy = vlc_ancillary_array_New(capacity);
+    if (copy == NULL)
+        return NULL;
+
+    for (size_t i = 0; i < hdr->count; ++i)
+        copy->entries[i] = vlc_ancillary_Hold(hdr->entries[i]);
+    copy->count = hdr->count;
+    return copy;
 }
 
-static size_t
-vlc_ancillary_array_Count(struct vlc_ancillary **array)
+void
+vlc_ancillary_array_Clear(struct vlc_ancillary ***arrayp)
 {
-    size_t count = 0;
-    for (struct vlc_ancillary **ancillary = array;
-         *ancillary != NULL; ancillary++)
+    if (*arrayp != NULL)
     {
-        count++;
+        struct vlc_ancillary_array_hdr *hdr = vlc_ancillary_array_ToHdr(*arrayp);
+        if (vlc_atomic_rc_dec(&hdr->rc))
+        {
+            for (size_t i = 0; i < hdr->count; ++i)
+                vlc_ancillary_Release(hdr->entries[i]);
+            free(hdr);
+        }
+        *arrayp = NULL;
     }
-
-    return count;
 }
 
 int
@@ -117,21 +160,10 @@ vlc_ancillary_array_Dup(struct vlc_ancillary ***dst_arrayp,
     if (*src_arrayp == NULL)
         return VLC_SUCCESS;
 
-    struct vlc_ancillary **src_array = *src_arrayp;
-    size_t count = vlc_ancillary_array_Count(src_array);
-
-    struct vlc_ancillary **dst_array =
-        vlc_alloc(count + 1, sizeof(struct vlc_ancillary *));
-    if (dst_array == NULL)
-        return VLC_ENOMEM;
-
-    for (size_t i = 0; i < count; ++i)
-    {
-        dst_array[i] = vlc_ancillary_Hold(src_array[i]);
-        assert(dst_array[i] != NULL);
-    }
-    dst_array[count] = NULL;
-    *dst_arrayp = dst_array;
+    /* Share the container, it will be unshared on the next insertion */
+    struct vlc_ancillary_array_hdr *hdr = vlc_ancillary_array_ToHdr(*src_arrayp);
+    vlc_atomic_rc_inc(&hdr->rc);
+    *dst_arrayp = hdr->entries;
 
     return VLC_SUCCESS;
 }
@@ -143,42 +175,69 @@ vlc_ancillary_array_Insert(struct vlc_ancillary ***arrayp,
     /* First case: the array is empty */
     if (*arrayp == NULL)
     {
-        struct vlc_ancillary **array = vlc_alloc(2, sizeof(struct vlc_ancillary *));
-        if (array == NULL)
+        struct vlc_ancillary_array_hdr *hdr =
+            vlc_ancillary_array_New(VLC_ANCILLARY_ARRAY_MIN_CAP);
+        if (hdr == NULL)
             return VLC_ENOMEM;
 
-        array[0] = vlc_ancillary_Hold(ancillary);
-        array[1] = NULL;
+        hdr->entries[0] = vlc_ancillary_Hold(ancillary);
+        hdr->count = 1;
 
-        *arrayp = array;
+        *arrayp = hdr->entries;
 
         return VLC_SUCCESS;
     }
 
-    struct vlc_ancillary **array = *arrayp;
-    size_t count = vlc_ancillary_array_Count(array);
+    struct vlc_ancillary_array_hdr *hdr = vlc_ancillary_array_ToHdr(*arrayp);
+
+    /* The container is shared with other frames/pictures and must not be
+     * mutated: replace it with a private copy. Observing a count of 1 is
+     * stable since incrementing it requires holding a reference. */
+    if (vlc_atomic_rc_get(&hdr->rc) > 1)
+    {
+        struct vlc_ancillary_array_hdr *copy =
+            vlc_ancillary_array_CopyHdr(hdr, hdr->count + 1);
+        if (copy == NULL)
+            return VLC_ENOMEM;
+
+        if (vlc_atomic_rc_dec(&hdr->rc))
+        {
+            /* The other owners vanished meanwhile */
+            for (size_t i = 0; i < hdr->count; ++i)
+                vlc_ancillary_Release(hdr->entries[i]);
+            free(hdr);
+        }
+        hdr = copy;
+        *arrayp = hdr->entries;
+    }
 
     /* Second case: the array has already an ancillary of the same id (very
      * unlikely) */
-    for (size_t i = 0; i < count; ++i)
+    for (size_t i = 0; i < hdr->count; ++i)
     {
-        if (array[i]->id == ancillary->id)
+        if (hdr->entries[i]->id == ancillary->id)
         {
-            vlc_ancillary_Release(array[i]);
-            array[i] = vlc_ancillary_Hold(ancillary);
+            vlc_ancillary_Release(hdr->entries[i]);
+            hdr->entries[i] = vlc_ancillary_Hold(ancillary);
             return VLC_SUCCESS;
         }
     }
 
-    /* Third case: realloc the array to add the new ancillary */
-    array = vlc_reallocarray(array, count + 2, sizeof(struct vlc_ancillary *));
-    if (array == NULL)
-        return VLC_ENOMEM;
+    /* Third case: grow the container to add the new ancillary */
+    if (hdr->count == hdr->capacity)
+    {
+        struct vlc_ancillary_array_hdr *grown =
+            realloc(hdr, sizeof(*hdr) +
+                    2 * hdr->capacity * sizeof(hdr->entries[0]));
+        if (grown == NULL)
+            return VLC_ENOMEM;
 
-    array[count] = vlc_ancillary_Hold(ancillary);
-    array[count + 1] = NULL;
+        grown->capacity *= 2;
+        hdr = grown;
+        *arrayp = hdr->entries;
+    }
 
-    *arrayp = array;
+    hdr->entries[hdr->count++] = vlc_ancillary_Hold(ancillary);
 
     return VLC_SUCCESS;
 }
@@ -190,12 +249,12 @@ vlc_ancillary_array_Get(struct vlc_ancillary ** const*arrayp,
     if (*arrayp == NULL)
         return NULL;
 
-    struct vlc_ancillary **array = *arrayp;
-    for (struct vlc_ancillary **ancillary = array;
-         *ancillary != NULL; ancillary++)
+    const struct vlc_ancillary_array_hdr *hdr =
+        vlc_ancillary_array_ToHdr(*arrayp);
+    for (size_t i = 0; i < hdr->count; ++i)
     {
-        if ((*ancillary)->id == id)
-            return *ancillary;
+        if (hdr->entries[i]->id == id)
+            return hdr->entries[i];
     }
     return NULL;
 }
@@ -24,11 +24,11 @@
 #include <vlc_ancillary.h>
 
 /*
- * A NULL terminated array of struct vlc_ancillary *. We don't use a
- * vlc_vector here in orer to gain few bytes (2 * size_t) for each
- * ancillary users (each vlc_frame_t/picture_t). Users will likely have one
- * or zero ancillary so the optimisations of the vlc_vector are not
- * important here.
+ * An array of struct vlc_ancillary *, prefixed by a hidden refcounted
+ * header (cf. ancillary.c). We don't use a vlc_vector here in orer to gain
+ * few bytes (2 * size_t) for each ancillary users (each
+ * vlc_frame_t/picture_t). Duplicating the array only increments the header
+ * refcount; the storage is copied when a shared array is mutated.
  */
 
 static inline void
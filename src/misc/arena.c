@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * misc/arena.c: region-based memory allocator
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_arena.h>
+
+/* Every allocation is rounded up so that the next one stays aligned for any
+ * built-in type, like malloc() guarantees. */
+#define ARENA_ALIGN alignof(max_align_t)
+
+struct vlc_arena_chunk
+{
+    struct vlc_arena_chunk *next;
+    size_t used;
+    size_t size;
+    /* chunk memory follows, aligned on ARENA_ALIGN */
+    max_align_t data[];
+};
+
+struct vlc_arena
+{
+    struct vlc_arena_chunk *chunks;
+    size_t chunk_size;
+};
+
+vlc_arena_t *vlc_arena_New(size_t chunk_size)
+{
+    assert(chunk_size > 0);
+
+    vlc_arena_t *arena = malloc(sizeof (*arena));
+    if (unlikely(arena == NULL))
+        return NULL;
+
+    arena->chunks = NULL;
+    arena->chunk_size = chunk_size;
+    return arena;
+}
+
+void *vlc_arena_Alloc(vlc_arena_t *arena, size_t size)
+{
+    if (unlikely(size > SIZE_MAX - ARENA_ALIGN))
+        return NULL;
+    size = (size + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1);
+
+    struct vlc_arena_chunk *chunk = arena->chunks;
+    if (chunk == NULL || chunk->size - chunk->used < size)
+    {
+        size_t chunk_size = size > arena->chunk_size ? size
+                                                     : arena->chunk_size;
+        chunk = malloc(sizeof (*chunk) + chunk_size);
+        if (unlikely(chunk == NULL))
+            return NULL;
+
+        chunk->used = 0;
+        chunk->size = chunk_size;
+        if (arena->chunks != NULL && chunk_size > arena->chunk_size)
+        {
+            /* dedicated oversized chunk: keep serving small allocations
+             * from the partially filled chunk on top */
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        }
+        else
+        {
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
+    }
+
+    void *ptr = (unsigned char *)chunk->data + chunk->used;
+    chunk->used += size;
+    return ptr;
+}
+
+void vlc_arena_Delete(vlc_arena_t *arena)
+{
+    for (struct vlc_arena_chunk *chunk = arena->chunks; chunk != NULL;)
+    {
+        struct vlc_arena_chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
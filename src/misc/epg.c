@@ -131,40 +131,34 @@ static void vlc_epg_Clean( vlc_epg_t *p_epg )
     free( p_epg->psz_name );
 }
 
-bool vlc_epg_AddEvent( vlc_epg_t *p_epg, vlc_epg_event_t *p_evt )
+/* Bisects for the first event starting at or after i_start.
+ * Returns p_epg->i_event when they all start before it. The event table
+ * is kept sorted by start time, so queries stay O(log n). */
+static size_t vlc_epg_Lowerbound( const vlc_epg_t *p_epg, int64_t i_start )
 {
-    ssize_t i_pos = -1;
+    size_t i_lower = 0;
+    size_t i_upper = p_epg->i_event;
 
-    /* Insertions are supposed in sequential order first */
-    if( p_epg->i_event )
+    while( i_lower < i_upper )
     {
-        if( p_epg->pp_event[0]->i_start > p_evt->i_start )
-        {
-            i_pos = 0;
-        }
-        else if ( p_epg->pp_event[p_epg->i_event - 1]->i_start >= p_evt->i_start )
-        {
-            /* Do bisect search lower start time entry */
-            size_t i_lower = 0;
-            size_t i_upper = p_epg->i_event - 1;
-
-            while( i_lower < i_upper )
-            {
-                size_t i_split = ( i_lower + i_upper ) / 2;
-                vlc_epg_event_t *p_cur = p_epg->pp_event[i_split];
+        size_t i_split = ( i_lower + i_upper ) / 2;
 
-                if( p_cur->i_start < p_evt->i_start )
-                {
-                    i_lower = i_split + 1;
-                }
-                else if ( p_cur->i_start >= p_evt->i_start )
-                {
-                    i_upper = i_split;
-                }
-            }
-            i_pos = i_lower;
-        }
+        if( p_epg->pp_event[i_split]->i_start < i_start )
+            i_lower = i_split + 1;
+        else
+            i_upper = i_split;
     }
+    return i_lower;
+}
+
+bool vlc_epg_AddEvent( vlc_epg_t *p_epg, vlc_epg_event_t *p_evt )
+{
+    ssize_t i_pos = -1;
+
+    /* Insertions are supposed in sequential order first */
+    if( p_epg->i_event &&
+        p_epg->pp_event[p_epg->i_event - 1]->i_start >= p_evt->i_start )
+        i_pos = vlc_epg_Lowerbound( p_epg, p_evt->i_start );
 
     if( i_pos != -1 )
     {
@@ -204,19 +198,13 @@ void vlc_epg_Delete( vlc_epg_t *p_epg )
 
 void vlc_epg_SetCurrent( vlc_epg_t *p_epg, int64_t i_start )
 {
-    size_t i;
     p_epg->p_current = NULL;
     if( i_start < 0 )
         return;
 
-    for( i = 0; i < p_epg->i_event; i++ )
-    {
-        if( p_epg->pp_event[i]->i_start == i_start )
-        {
-            p_epg->p_current = p_epg->pp_event[i];
-            break;
-        }
-    }
+    const size_t i_pos = vlc_epg_Lowerbound( p_epg, i_start );
+    if( i_pos < p_epg->i_event && p_epg->pp_event[i_pos]->i_start == i_start )
+        p_epg->p_current = p_epg->pp_event[i_pos];
 }
 
 vlc_epg_t * vlc_epg_Duplicate( const vlc_epg_t *p_src )
@@ -421,6 +421,82 @@ void es_format_Clean(es_format_t *fmt)
     es_format_Init(fmt, UNKNOWN_ES, 0);
 }
 
+static bool str_Equal(const char *a, const char *b)
+{
+    return (a == NULL) ? (b == NULL) : (b != NULL && strcmp(a, b) == 0);
+}
+
+static bool video_format_IsIdentical(const video_format_t *a,
+                                     const video_format_t *b)
+{
+    video_format_t va = *a, vb = *b;
+
+    va.p_palette = vb.p_palette = NULL;
+    if (memcmp(&va, &vb, sizeof (va)) != 0)
+        return false;
+    if (a->p_palette == NULL || b->p_palette == NULL)
+        return a->p_palette == b->p_palette;
+    return memcmp(a->p_palette, b->p_palette, sizeof (*a->p_palette)) == 0;
+}
+
+static bool subs_format_IsIdentical(const subs_format_t *a,
+                                    const subs_format_t *b)
+{
+    subs_format_t sa = *a, sb = *b;
+
+    sa.psz_encoding = sb.psz_encoding = NULL;
+    return memcmp(&sa, &sb, sizeof (sa)) == 0
+        && str_Equal(a->psz_encoding, b->psz_encoding);
+}
+
+/* Exact deep equality, unlike es_format_IsSimilar(). Padding bytes can make
+ * the memcmp()s fail on otherwise equal formats, which only costs the copy
+ * that would have been performed anyway. */
+static bool es_format_IsIdentical(const es_format_t *a, const es_format_t *b)
+{
+    if (a->i_cat != b->i_cat || a->i_codec != b->i_codec
+     || a->i_original_fourcc != b->i_original_fourcc
+     || a->i_id != b->i_id || a->i_group != b->i_group
+     || a->i_priority != b->i_priority || a->i_bitrate != b->i_bitrate
+     || a->i_profile != b->i_profile || a->i_level != b->i_level
+     || a->b_packetized != b->b_packetized)
+        return false;
+
+    if (!str_Equal(a->psz_language, b->psz_language)
+     || !str_Equal(a->psz_description, b->psz_description))
+        return false;
+
+    if (a->i_extra != b->i_extra
+     || (a->i_extra > 0 && memcmp(a->p_extra, b->p_extra, a->i_extra) != 0))
+        return false;
+
+    if (a->i_extra_languages != b->i_extra_languages)
+        return false;
+    for (unsigned i = 0; i < a->i_extra_languages; i++)
+        if (!str_Equal(a->p_extra_languages[i].psz_language,
+                       b->p_extra_languages[i].psz_language)
+         || !str_Equal(a->p_extra_languages[i].psz_description,
+                       b->p_extra_languages[i].psz_description))
+            return false;
+
+    if (memcmp(&a->audio, &b->audio, sizeof (a->audio)) != 0
+     || memcmp(&a->audio_replay_gain, &b->audio_replay_gain,
+               sizeof (a->audio_replay_gain)) != 0)
+        return false;
+
+    return video_format_IsIdentical(&a->video, &b->video)
+        && subs_format_IsIdentical(&a->subs, &b->subs);
+}
+
+int es_format_Update(es_format_t *restrict dst, const es_format_t *src)
+{
+    if (es_format_IsIdentical(dst, src))
+        return VLC_SUCCESS;
+
+    es_format_Clean(dst);
+    return es_format_Copy(dst, src);
+}
+
 bool es_format_IsSimilar( const es_format_t *p_fmt1, const es_format_t *p_fmt2 )
 {
     if( p_fmt1->i_cat != p_fmt2->i_cat ||
@@ -80,12 +80,33 @@ struct vlc_executor {
     bool closing;
 };
 
+/* The pending queue is kept sorted by deadline (ties in submission order),
+ * so taking the next runnable stays O(1) and deadline-less runnables
+ * (deadline == VLC_TICK_MAX) keep plain FIFO semantics. */
 static void
 QueuePush(vlc_executor_t *executor, struct vlc_runnable *runnable)
 {
+    struct vlc_runnable *it;
+
     vlc_mutex_assert(&executor->lock);
 
+    vlc_list_foreach(it, &executor->queue, node)
+        if (it->deadline > runnable->deadline)
+        {
+            vlc_list_add_before(&runnable->node, &it->node);
+            goto inserted;
+        }
     vlc_list_append(&runnable->node, &executor->queue);
+inserted:
+    vlc_cond_signal(&executor->queue_wait);
+}
+
+static void
+QueuePushFront(vlc_executor_t *executor, struct vlc_runnable *runnable)
+{
+    vlc_mutex_assert(&executor->lock);
+
+    vlc_list_prepend(&runnable->node, &executor->queue);
     vlc_cond_signal(&executor->queue_wait);
 }
 
@@ -206,14 +227,19 @@ vlc_executor_New(unsigned max_threads)
     return executor;
 }
 
-void
-vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable)
+static void
+Submit(vlc_executor_t *executor, struct vlc_runnable *runnable, bool urgent,
+       vlc_tick_t deadline)
 {
     vlc_mutex_lock(&executor->lock);
 
     assert(!executor->closing);
 
-    QueuePush(executor, runnable);
+    runnable->deadline = deadline;
+    if (urgent)
+        QueuePushFront(executor, runnable);
+    else
+        QueuePush(executor, runnable);
 
     if (++executor->unfinished > executor->nthreads
             && executor->nthreads < executor->max_threads)
@@ -223,6 +249,27 @@ vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable)
     vlc_mutex_unlock(&executor->lock);
 }
 
+void
+vlc_executor_Submit(vlc_executor_t *executor, struct vlc_runnable *runnable)
+{
+    Submit(executor, runnable, false, VLC_TICK_MAX);
+}
+
+void
+vlc_executor_SubmitUrgent(vlc_executor_t *executor,
+                          struct vlc_runnable *runnable)
+{
+    Submit(executor, runnable, true, VLC_TICK_MIN);
+}
+
+void
+vlc_executor_SubmitDeadline(vlc_executor_t *executor,
+                            struct vlc_runnable *runnable,
+                            vlc_tick_t deadline)
+{
+    Submit(executor, runnable, false, deadline);
+}
+
 bool
 vlc_executor_Cancel(vlc_executor_t *executor, struct vlc_runnable *runnable)
 {
@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * fifo_spsc.c: lock-free single-producer/single-consumer frame FIFO
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_frame.h>
+
+#include "fifo_spsc.h"
+
+/* Keep the producer and consumer cursors on separate cache lines so that
+ * pushes and pops do not false-share. 64 bytes covers every architecture we
+ * currently target (x86, ARMv8, POWER). */
+#define SPSC_CACHE_ALIGN 64
+
+struct vlc_fifo_spsc
+{
+    alignas(SPSC_CACHE_ALIGN) atomic_size_t head; /* next write (producer) */
+    alignas(SPSC_CACHE_ALIGN) atomic_size_t tail; /* next read (consumer) */
+    alignas(SPSC_CACHE_ALIGN) size_t mask;
+    vlc_frame_t *ring[];
+};
+
+vlc_fifo_spsc_t *vlc_fifo_spsc_New(size_t capacity)
+{
+    /* Round up to a power of two so indexes wrap with a mask. */
+    size_t cap = 2;
+
+    assert(capacity >= 2);
+    while (cap < capacity)
+        cap *= 2;
+
+    if (unlikely(cap > (SIZE_MAX - sizeof (vlc_fifo_spsc_t))
+                       / sizeof (vlc_frame_t *)))
+        return NULL;
+
+    /* aligned_alloc() requires the size to be a multiple of the alignment */
+    size_t size = sizeof (vlc_fifo_spsc_t) + cap * sizeof (vlc_frame_t *);
+    size = (size + SPSC_CACHE_ALIGN - 1) & ~((size_t)SPSC_CACHE_ALIGN - 1);
+
+    vlc_fifo_spsc_t *fifo = aligned_alloc(SPSC_CACHE_ALIGN, size);
+    if (unlikely(fifo == NULL))
+        return NULL;
+
+    atomic_init(&fifo->head, 0);
+    atomic_init(&fifo->tail, 0);
+    fifo->mask = cap - 1;
+    return fifo;
+}
+
+void vlc_fifo_spsc_Delete(vlc_fifo_spsc_t *fifo)
+{
+    vlc_frame_t *frame;
+
+    while ((frame = vlc_fifo_spsc_Pop(fifo)) != NULL)
+        vlc_frame_Release(frame);
+    free(fifo);
+}
+
+bool vlc_fifo_spsc_Push(vlc_fifo_spsc_t *fifo, vlc_frame_t *frame)
+{
+    size_t head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+
+    assert(frame != NULL);
+
+    if (head - tail > fifo->mask)
+        return false; /* full */
+
+    fifo->ring[head & fifo->mask] = frame;
+    /* Publish the slot before the consumer can observe the new head. */
+    atomic_store_explicit(&fifo->head, head + 1, memory_order_release);
+    return true;
+}
+
+vlc_frame_t *vlc_fifo_spsc_Pop(vlc_fifo_spsc_t *fifo)
+{
+    size_t tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+
+    if (head == tail)
+        return NULL; /* empty */
+
+    vlc_frame_t *frame = fifo->ring[tail & fifo->mask];
+    /* Release the slot back to the producer. */
+    atomic_store_explicit(&fifo->tail, tail + 1, memory_order_release);
+    return frame;
+}
+
+size_t vlc_fifo_spsc_Count(const vlc_fifo_spsc_t *fifo)
+{
+    size_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+
+    return head - tail;
+}
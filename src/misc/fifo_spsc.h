@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * fifo_spsc.h: lock-free single-producer/single-consumer frame FIFO
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VLC_FIFO_SPSC_H
+#define VLC_FIFO_SPSC_H 1
+
+#include <vlc_frame.h>
+
+/**
+ * \defgroup fifo_spsc Lock-free SPSC frame FIFO (core private)
+ *
+ * Bounded wait-free ring buffer carrying \ref vlc_frame_t pointers between
+ * exactly one producer thread and one consumer thread, e.g. the
+ * demux-to-decoder hand-over. Unlike \ref vlc_fifo_t, no lock is taken on
+ * either side; callers needing multiple producers or consumers, or blocking
+ * semantics, must keep using \ref vlc_fifo_t.
+ * @{
+ */
+
+typedef struct vlc_fifo_spsc vlc_fifo_spsc_t;
+
+/**
+ * Creates a bounded SPSC frame FIFO.
+ *
+ * \param capacity maximum number of queued frames (rounded up to a power
+ *                 of two)
+ * \return a FIFO or NULL on allocation failure
+ */
+vlc_fifo_spsc_t *vlc_fifo_spsc_New(size_t capacity) VLC_USED VLC_MALLOC;
+
+/**
+ * Destroys an SPSC FIFO, releasing any frames still queued.
+ *
+ * No other thread may access the FIFO concurrently.
+ */
+void vlc_fifo_spsc_Delete(vlc_fifo_spsc_t *);
+
+/**
+ * Queues one frame (producer side only).
+ *
+ * \retval true the frame was queued
+ * \retval false the FIFO is full (ownership is left to the caller)
+ */
+bool vlc_fifo_spsc_Push(vlc_fifo_spsc_t *, vlc_frame_t *frame);
+
+/**
+ * Dequeues the oldest frame, if any (consumer side only).
+ *
+ * \return a frame owned by the caller, or NULL if the FIFO is empty
+ */
+vlc_frame_t *vlc_fifo_spsc_Pop(vlc_fifo_spsc_t *) VLC_USED;
+
+/**
+ * Approximate number of queued frames.
+ *
+ * Exact when called from either endpoint thread while the other side is
+ * quiescent; otherwise a snapshot that may be stale by one element.
+ */
+size_t vlc_fifo_spsc_Count(const vlc_fifo_spsc_t *);
+
+/** @} */
+
+#endif
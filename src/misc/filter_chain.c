@@ -122,6 +122,7 @@ typedef struct chained_filter_t
     /* Public part of the filter structure */
     filter_t filter;
     struct vlc_list node;
+    const char *capability; /**< Capability the module was loaded with */
     vlc_mouse_t mouse;
     vlc_picture_chain_t pending;
 } chained_filter_t;
@@ -280,6 +281,93 @@ void filter_chain_Reset( filter_chain_t *p_chain,
     es_format_Copy( &p_chain->fmt_out, p_fmt_out );
 }
 
+static int ChangeFilterFormat( chained_filter_t *chained,
+                               const es_format_t *fmt_in,
+                               vlc_video_context *vctx_in )
+{
+    filter_t *filter = &chained->filter;
+
+    if( es_format_IsSimilar( &filter->fmt_in, fmt_in )
+     && filter->vctx_in == vctx_in )
+        return VLC_SUCCESS; /* nothing changed upstream of this filter */
+
+    /* Pending pictures carry the previous format */
+    FilterDeletePictures( &chained->pending );
+    filter_Flush( filter );
+
+    if( filter->ops->change_fmt != NULL
+     && filter->ops->change_fmt( filter, fmt_in, vctx_in ) == VLC_SUCCESS )
+        return VLC_SUCCESS;
+
+    /* The filter cannot adopt the format in place: re-create it, reusing
+     * the same module so that no probe round is paid. A filter whose output
+     * format followed its input keeps following it; a converter keeps its
+     * output target. */
+    bool follows = es_format_IsSimilar( &filter->fmt_in, &filter->fmt_out );
+    char *module = strdup( module_get_object( filter->p_module ) );
+    if( unlikely(module == NULL) )
+        return VLC_ENOMEM;
+
+    vlc_filter_UnloadModule( filter );
+
+    es_format_Clean( &filter->fmt_in );
+    es_format_Copy( &filter->fmt_in, fmt_in );
+    filter->vctx_in = vctx_in;
+    if( follows )
+    {
+        es_format_Clean( &filter->fmt_out );
+        es_format_Copy( &filter->fmt_out, fmt_in );
+    }
+
+    filter->p_module = vlc_filter_LoadModule( filter, chained->capability,
+                                              module, true );
+    free( module );
+    return (filter->p_module != NULL) ? VLC_SUCCESS : VLC_EGENERIC;
+}
+
+int filter_chain_ChangeFormat( filter_chain_t *p_chain,
+                               const es_format_t *p_fmt_in,
+                               vlc_video_context *vctx_in,
+                               const es_format_t *p_fmt_out )
+{
+    assert( p_fmt_in != NULL );
+    assert( p_fmt_out != NULL );
+
+    /* Changing the downstream target would invalidate the converters
+     * towards the output, which this shortcut cannot fix up. */
+    if( !p_chain->b_allow_fmt_out_change
+     && !es_format_IsSimilar( &p_chain->fmt_out, p_fmt_out ) )
+        return VLC_EGENERIC;
+
+    const es_format_t *fmt = p_fmt_in;
+    vlc_video_context *vctx = vctx_in;
+    chained_filter_t *chained;
+
+    vlc_list_foreach( chained, &p_chain->filter_list, node )
+    {
+        if( ChangeFilterFormat( chained, fmt, vctx ) != VLC_SUCCESS )
+            return VLC_EGENERIC;
+
+        fmt = &chained->filter.fmt_out;
+        vctx = chained->filter.vctx_out;
+    }
+
+    /* The renegotiated chain must still produce what downstream expects */
+    if( !p_chain->b_allow_fmt_out_change
+     && !es_format_IsSimilar( fmt, p_fmt_out ) )
+        return VLC_EGENERIC;
+
+    es_format_Clean( &p_chain->fmt_in );
+    es_format_Copy( &p_chain->fmt_in, p_fmt_in );
+    if( p_chain->vctx_in )
+        vlc_video_context_Release( p_chain->vctx_in );
+    p_chain->vctx_in = vctx_in ? vlc_video_context_Hold( vctx_in ) : NULL;
+
+    es_format_Clean( &p_chain->fmt_out );
+    es_format_Copy( &p_chain->fmt_out, p_fmt_out );
+    return VLC_SUCCESS;
+}
+
 static filter_t *filter_chain_AppendInner( filter_chain_t *chain,
     const char *name, const char *capability, const config_chain_t *cfg,
     const es_format_t *fmt_out )
@@ -345,6 +433,7 @@ static filter_t *filter_chain_AppendInner( filter_chain_t *chain,
 
     vlc_list_append( &chained->node, &chain->filter_list );
 
+    chained->capability = capability;
     vlc_mouse_Init( &chained->mouse );
     vlc_picture_chain_Init( &chained->pending );
 
@@ -35,24 +35,52 @@
 
 #include "fourcc_tables.h"
 
-static int fourcc_cmp(const void *key, const void *ent)
+/* Must match hash_fourcc() in misc/fourcc_gen.c. The bytes are combined in
+ * memory order so that the generated tables are endian-neutral. */
+static uint32_t fourcc_hash(const void *key)
 {
-    return memcmp(key, ent, 4);
+    const unsigned char *b = key;
+    uint32_t u = (uint32_t)b[0] | ((uint32_t)b[1] << 8)
+               | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+    return u * 2654435761U; /* Knuth multiplicative hash */
+}
+
+/* Looks a FourCC up in an entry array through its generated hash index
+ * table (see print_hashtab() in misc/fourcc_gen.c). The index tables are
+ * never full, so probing always terminates on an empty slot. */
+static const void *fourcc_find(const void *key,
+                               const void *entv, size_t entsize,
+                               const uint16_t *hashtab, uint32_t mask)
+{
+    for (uint32_t h = fourcc_hash(key) & mask;; h = (h + 1) & mask)
+    {
+        uint16_t idx = hashtab[h];
+
+        if (idx == 0xffff)
+            return NULL;
+
+        const void *ent = (const char *)entv + (idx * entsize);
+        if (memcmp(key, ent, 4) == 0)
+            return ent;
+    }
 }
 
 static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
-                           const struct fourcc_mapping *mapv, size_t mapc,
-                           const struct fourcc_desc *dscv, size_t dscc)
+                           const struct fourcc_mapping *mapv,
+                           const uint16_t *maptab, uint32_t mapmask,
+                           const struct fourcc_desc *dscv,
+                           const uint16_t *dsctab, uint32_t dscmask)
 {
     const struct fourcc_mapping *mapping;
     const struct fourcc_desc *desc;
 
-    mapping = bsearch(&fourcc, mapv, mapc, sizeof (*mapv), fourcc_cmp);
+    mapping = fourcc_find(&fourcc, mapv, sizeof (*mapv), maptab, mapmask);
     if (mapping != NULL)
     {
         if (dsc != NULL)
         {
-            desc = bsearch(&fourcc, dscv, dscc, sizeof (*dscv), fourcc_cmp);
+            desc = fourcc_find(&fourcc, dscv, sizeof (*dscv),
+                               dsctab, dscmask);
             if (desc != NULL)
             {
                 *dsc = desc->desc;
@@ -62,7 +90,7 @@ static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
         fourcc = mapping->fourcc;
     }
 
-    desc = bsearch(&fourcc, dscv, dscc, sizeof (*dscv), fourcc_cmp);
+    desc = fourcc_find(&fourcc, dscv, sizeof (*dscv), dsctab, dscmask);
     if (desc == NULL)
         return 0; /* Unknown FourCC */
     if (dsc != NULL)
@@ -70,22 +98,25 @@ static vlc_fourcc_t Lookup(vlc_fourcc_t fourcc, const char **restrict dsc,
     return fourcc; /* Known FourCC (has a description) */
 }
 
+#define LOOKUP(fourcc, dsc, cat) \
+    Lookup(fourcc, dsc, mapping_##cat, hashtab_mapping_##cat, \
+           ARRAY_SIZE(hashtab_mapping_##cat) - 1, \
+           desc_##cat, hashtab_desc_##cat, \
+           ARRAY_SIZE(hashtab_desc_##cat) - 1)
+
 static vlc_fourcc_t LookupVideo(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_video, ARRAY_SIZE(mapping_video),
-                  desc_video, ARRAY_SIZE(desc_video));
+    return LOOKUP(fourcc, dsc, video);
 }
 
 static vlc_fourcc_t LookupAudio(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_audio, ARRAY_SIZE(mapping_audio),
-                  desc_audio, ARRAY_SIZE(desc_audio));
+    return LOOKUP(fourcc, dsc, audio);
 }
 
 static vlc_fourcc_t LookupSpu(vlc_fourcc_t fourcc, const char **restrict dsc)
 {
-    return Lookup(fourcc, dsc, mapping_spu, ARRAY_SIZE(mapping_spu),
-                  desc_spu, ARRAY_SIZE(desc_spu));
+    return LOOKUP(fourcc, dsc, spu);
 }
 
 static vlc_fourcc_t LookupCat(vlc_fourcc_t fourcc, const char **restrict dsc,
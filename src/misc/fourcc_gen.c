@@ -55,6 +55,52 @@ struct entry
     const char *desc;
 };
 
+/* Must match fourcc_hash() in misc/fourcc.c. The bytes are combined in
+ * memory order so that the generated tables are endian-neutral. */
+static uint32_t hash_fourcc(const char b[4])
+{
+    uint32_t u = (uint32_t)(unsigned char)b[0]
+               | ((uint32_t)(unsigned char)b[1] << 8)
+               | ((uint32_t)(unsigned char)b[2] << 16)
+               | ((uint32_t)(unsigned char)b[3] << 24);
+    return u * 2654435761U; /* Knuth multiplicative hash */
+}
+
+/* Prints an open-addressing hash table of indexes into the named entry
+ * array, keyed by the entry alias, so that run-time lookups are O(1).
+ * Load factor is kept at or below one half. */
+static void print_hashtab(const char *prefix, const char *name,
+                          const struct entry *v, size_t n)
+{
+    size_t size = 1;
+
+    assert(n < 0xffff);
+    while (size < 2 * n)
+        size *= 2;
+
+    uint16_t *tab = malloc(size * sizeof (*tab));
+    if (tab == NULL)
+        abort();
+    memset(tab, 0xff, size * sizeof (*tab));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t h = hash_fourcc(v[i].alias) & (size - 1);
+
+        while (tab[h] != 0xffff)
+            h = (h + 1) & (size - 1);
+        tab[h] = i;
+    }
+
+    printf("static const uint16_t hashtab_%s_%s[%zu] = {", prefix, name,
+           size);
+    for (size_t i = 0; i < size; i++)
+        printf("%s%u,", (i % 8) ? " " : "\n    ", tab[i]);
+    puts("\n};");
+
+    free(tab);
+}
+
 static int cmp_entry(const void *a, const void *b)
 {
     const struct entry *ea = a, *eb = b;
@@ -105,29 +151,45 @@ static void process_list(const char *name, const staticentry_t *list, size_t n)
     if (dups > 0)
         exit(1);
 
-    printf("static const struct fourcc_mapping mapping_%s[] = {\n", name);
+    struct entry *subset = malloc(sizeof (*subset) * n);
+    if (subset == NULL)
+        abort();
+    size_t count = 0;
+
     for (size_t i = 0; i < n; i++)
     {
         if (!memcmp(entries[i].fourcc, entries[i].alias, 4))
             continue;
+        subset[count++] = entries[i];
+    }
+
+    printf("static const struct fourcc_mapping mapping_%s[] = {\n", name);
+    for (size_t i = 0; i < count; i++)
         printf("    { { { 0x%02hhx, 0x%02hhx, 0x%02hhx, 0x%02hhx } }, "
                "{ { 0x%02hhx, 0x%02hhx, 0x%02hhx, 0x%02hhx } } },\n",
-               entries[i].alias[0], entries[i].alias[1], entries[i].alias[2],
-               entries[i].alias[3], entries[i].fourcc[0], entries[i].fourcc[1],
-               entries[i].fourcc[2], entries[i].fourcc[3]);
-    }
+               subset[i].alias[0], subset[i].alias[1], subset[i].alias[2],
+               subset[i].alias[3], subset[i].fourcc[0], subset[i].fourcc[1],
+               subset[i].fourcc[2], subset[i].fourcc[3]);
     puts("};");
-    printf("static const struct fourcc_desc desc_%s[] = {\n", name);
+    print_hashtab("mapping", name, subset, count);
+
+    count = 0;
     for (size_t i = 0; i < n; i++)
     {
         if (entries[i].desc == NULL)
             continue;
-        printf("    { { { 0x%02hhx, 0x%02hhx, 0x%02hhx, 0x%02hhx } }, "
-               "\"%s\" },\n", entries[i].alias[0], entries[i].alias[1],
-               entries[i].alias[2], entries[i].alias[3], entries[i].desc);
+        subset[count++] = entries[i];
     }
+
+    printf("static const struct fourcc_desc desc_%s[] = {\n", name);
+    for (size_t i = 0; i < count; i++)
+        printf("    { { { 0x%02hhx, 0x%02hhx, 0x%02hhx, 0x%02hhx } }, "
+               "\"%s\" },\n", subset[i].alias[0], subset[i].alias[1],
+               subset[i].alias[2], subset[i].alias[3], subset[i].desc);
     puts("};");
+    print_hashtab("desc", name, subset, count);
 
+    free(subset);
     free(entries);
     fprintf(stderr, "%s: %zu entries\n", name, n);
 }
@@ -28,18 +28,25 @@
 #include <sys/stat.h>
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
+#include <stdio.h>
 #include <unistd.h>
 #include <fcntl.h>
 #ifdef _WIN32
 # include <windows.h>
 #endif
 
+#ifdef HAVE_MMAP
+# include <sys/mman.h>
+#endif
+
 #include <vlc_common.h>
 #include <vlc_atomic.h>
 #include <vlc_frame.h>
 #include <vlc_fs.h>
 
 #include "ancillary.h"
+#include "frame.h"
 
 #ifndef NDEBUG
 static void vlc_frame_Check (vlc_frame_t *frame)
@@ -112,6 +119,440 @@ vlc_frame_t *vlc_frame_Init(vlc_frame_t *restrict f, const struct vlc_frame_call
 /** Initial reserved header and footer size. */
 #define VLC_FRAME_PADDING      32
 
+#ifdef HAVE_ALIGNED_ALLOC
+/*
+ * Size-class pools for vlc_frame_Alloc().
+ *
+ * Demux/decode/filter pipelines allocate and free millions of frames per
+ * minute with highly repetitive sizes (TS packets, RTP datagrams, compressed
+ * pictures). Small frames are therefore carved from pooled blocks holding
+ * the frame header and its buffer in one allocation, rounded up to a power
+ * of two. Freed blocks go to a lock-free-enough per-thread cache, spilling
+ * to (and refilling from) a mutex-protected global pool in batches, so that
+ * producer threads allocating and consumer threads releasing still recycle
+ * memory without a lock round-trip per frame.
+ *
+ * Setting VLC_FRAME_POOL=0 in the environment disables the pools (frames
+ * then take the plain heap path below); VLC_FRAME_POOL_STATS=1 prints
+ * per-class hit rates at exit.
+ */
+
+/** Pooled block header size: the vlc_frame_t rounded up so that the buffer
+ * right after it keeps the VLC_FRAME_ALIGN guarantee. */
+#define FRAME_POOL_HEADER \
+    ((sizeof (vlc_frame_t) + VLC_FRAME_ALIGN - 1) & ~(size_t)(VLC_FRAME_ALIGN - 1))
+
+#define FRAME_POOL_CLASS_MIN     9u /* 512 bytes */
+#define FRAME_POOL_CLASS_MAX    16u /* 64 KiB; larger frames are not pooled */
+#define FRAME_POOL_CLASSES (FRAME_POOL_CLASS_MAX - FRAME_POOL_CLASS_MIN + 1u)
+#define FRAME_POOL_CACHE_MAX    32u /* per-thread blocks per class */
+#define FRAME_POOL_BATCH        16u /* blocks per global pool transfer */
+#define FRAME_POOL_GLOBAL_BYTES (4u << 20) /* per-class global pool cap */
+
+struct frame_pool_block
+{
+    struct frame_pool_block *next;
+};
+
+#if defined (HAVE_MMAP) && defined (MADV_HUGEPAGE)
+/*
+ * Optional hugepage backing ("frame-hugepages" option).
+ *
+ * High-bitrate capture inputs (DVB, UDP multicast) allocate blocks in tight
+ * bursts; first-touch page faults and TLB misses in fresh allocations show
+ * up as periodic latency spikes. When enabled, pool refills carve blocks
+ * from pre-faulted slabs sized to one huge page, so that recycled capture
+ * buffers never fault again and span few TLB entries. Slab memory stays
+ * committed for the lifetime of the process, hence the modest hard cap.
+ */
+# define FRAME_POOL_HUGE 1
+# define FRAME_POOL_SLAB_SIZE (size_t)(2u << 20)
+# define FRAME_POOL_SLAB_MAX 16u /* 32 MiB hard cap */
+
+static struct
+{
+    vlc_mutex_t lock;
+    void *base[FRAME_POOL_SLAB_MAX];
+    unsigned count;
+    bool enabled;
+} frame_pool_slabs = { .lock = VLC_STATIC_MUTEX };
+
+/** Whether \p block was carved from a slab (and thus must never be freed) */
+static bool frame_pool_IsPinned(const void *block)
+{
+    bool pinned = false;
+
+    vlc_mutex_lock(&frame_pool_slabs.lock);
+    for (unsigned i = 0; i < frame_pool_slabs.count; i++)
+        if ((uintptr_t)block - (uintptr_t)frame_pool_slabs.base[i]
+                < FRAME_POOL_SLAB_SIZE)
+        {
+            pinned = true;
+            break;
+        }
+    vlc_mutex_unlock(&frame_pool_slabs.lock);
+    return pinned;
+}
+#endif
+
+struct frame_pool_cache
+{
+    struct frame_pool_block *head[FRAME_POOL_CLASSES];
+    unsigned count[FRAME_POOL_CLASSES];
+};
+
+static struct
+{
+    vlc_mutex_t lock;
+    struct frame_pool_block *head;
+    unsigned count;
+} frame_pool_global[FRAME_POOL_CLASSES];
+
+static vlc_threadvar_t frame_pool_tls;
+static vlc_once_t frame_pool_once = VLC_STATIC_ONCE;
+static bool frame_pool_disabled = false;
+static bool frame_pool_stats = false;
+static atomic_uint frame_pool_hits[FRAME_POOL_CLASSES];
+static atomic_uint frame_pool_refills[FRAME_POOL_CLASSES];
+static atomic_uint frame_pool_mallocs[FRAME_POOL_CLASSES];
+
+static size_t frame_pool_ClassSize(unsigned cls)
+{
+    return (size_t)1 << (cls + FRAME_POOL_CLASS_MIN);
+}
+
+/** Maps a total block size to a size class, or UINT_MAX if not pooled. */
+static unsigned frame_pool_ClassOf(size_t total)
+{
+    if (total > frame_pool_ClassSize(FRAME_POOL_CLASSES - 1))
+        return UINT_MAX;
+
+    unsigned cls = 0;
+    while (frame_pool_ClassSize(cls) < total)
+        cls++;
+    return cls;
+}
+
+/** Returns a block that cannot stay in the bounded pools to the system.
+ * Slab-carved blocks are permanently committed and go back to the global
+ * pool (past its cap) instead, since they cannot be freed individually. */
+static void frame_pool_FreeBlock(struct frame_pool_block *block, unsigned cls)
+{
+#ifdef FRAME_POOL_HUGE
+    if (frame_pool_IsPinned(block))
+    {
+        vlc_mutex_lock(&frame_pool_global[cls].lock);
+        block->next = frame_pool_global[cls].head;
+        frame_pool_global[cls].head = block;
+        frame_pool_global[cls].count++;
+        vlc_mutex_unlock(&frame_pool_global[cls].lock);
+        return;
+    }
+#else
+    (void) cls;
+#endif
+    free(block);
+}
+
+#ifdef FRAME_POOL_HUGE
+/** Allocates a pre-faulted, hugepage-backed slab and carves it into blocks
+ * of the class size. All but the returned block go to the global pool. */
+static struct frame_pool_block *frame_pool_CarveSlab(unsigned cls)
+{
+    vlc_mutex_lock(&frame_pool_slabs.lock);
+    if (!frame_pool_slabs.enabled
+     || frame_pool_slabs.count >= FRAME_POOL_SLAB_MAX)
+    {
+        vlc_mutex_unlock(&frame_pool_slabs.lock);
+        return NULL;
+    }
+
+    void *slab = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    /* Reserved huge pages, if the system provides any. MAP_POPULATE makes
+     * the kernel commit (and thus pre-fault) the pages upfront. */
+    slab = mmap(NULL, FRAME_POOL_SLAB_SIZE, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | MAP_HUGETLB,
+                -1, 0);
+#endif
+    if (slab == MAP_FAILED)
+    {   /* Transparent huge pages: advise before faulting so that the
+         * first touch below can populate huge pages directly. */
+        slab = mmap(NULL, FRAME_POOL_SLAB_SIZE, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (slab == MAP_FAILED)
+        {
+            vlc_mutex_unlock(&frame_pool_slabs.lock);
+            return NULL;
+        }
+        madvise(slab, FRAME_POOL_SLAB_SIZE, MADV_HUGEPAGE);
+        memset(slab, 0, FRAME_POOL_SLAB_SIZE);
+    }
+    frame_pool_slabs.base[frame_pool_slabs.count++] = slab;
+    vlc_mutex_unlock(&frame_pool_slabs.lock);
+
+    const size_t size = frame_pool_ClassSize(cls);
+    struct frame_pool_block *head = NULL, *tail = NULL;
+    unsigned carved = 0;
+
+    for (size_t off = size; off + size <= FRAME_POOL_SLAB_SIZE; off += size)
+    {
+        struct frame_pool_block *block = (void *)((char *)slab + off);
+
+        if (head == NULL)
+            tail = block;
+        block->next = head;
+        head = block;
+        carved++;
+    }
+
+    vlc_mutex_lock(&frame_pool_global[cls].lock);
+    tail->next = frame_pool_global[cls].head;
+    frame_pool_global[cls].head = head;
+    frame_pool_global[cls].count += carved;
+    vlc_mutex_unlock(&frame_pool_global[cls].lock);
+
+    return slab; /* the first block of the slab */
+}
+#endif
+
+static void frame_pool_DumpStats(void)
+{
+    for (unsigned cls = 0; cls < FRAME_POOL_CLASSES; cls++)
+    {
+        unsigned hits = atomic_load_explicit(&frame_pool_hits[cls],
+                                             memory_order_relaxed);
+        unsigned refills = atomic_load_explicit(&frame_pool_refills[cls],
+                                                memory_order_relaxed);
+        unsigned mallocs = atomic_load_explicit(&frame_pool_mallocs[cls],
+                                                memory_order_relaxed);
+
+        if (hits == 0 && mallocs == 0)
+            continue;
+        fprintf(stderr, "frame pool: %6zu bytes: %u cache hits "
+                "(%u global refills), %u heap allocations\n",
+                frame_pool_ClassSize(cls), hits, refills, mallocs);
+    }
+}
+
+/** Flushes and deletes a per-thread cache (threadvar destructor). */
+static void frame_pool_DestroyCache(void *data)
+{
+    struct frame_pool_cache *cache = data;
+
+    for (unsigned cls = 0; cls < FRAME_POOL_CLASSES; cls++)
+    {
+        struct frame_pool_block *block = cache->head[cls], *next;
+        unsigned limit = FRAME_POOL_GLOBAL_BYTES
+                         >> (cls + FRAME_POOL_CLASS_MIN);
+
+        vlc_mutex_lock(&frame_pool_global[cls].lock);
+        while (block != NULL && frame_pool_global[cls].count < limit)
+        {
+            next = block->next;
+            block->next = frame_pool_global[cls].head;
+            frame_pool_global[cls].head = block;
+            frame_pool_global[cls].count++;
+            block = next;
+        }
+        vlc_mutex_unlock(&frame_pool_global[cls].lock);
+
+        for (; block != NULL; block = next)
+        {
+            next = block->next;
+            frame_pool_FreeBlock(block, cls);
+        }
+    }
+    free(cache);
+}
+
+static void frame_pool_Init(void *opaque)
+{
+    (void) opaque;
+
+    for (unsigned cls = 0; cls < FRAME_POOL_CLASSES; cls++)
+        vlc_mutex_init(&frame_pool_global[cls].lock);
+
+    const char *env = getenv("VLC_FRAME_POOL");
+    if ((env != NULL && atoi(env) == 0)
+     || vlc_threadvar_create(&frame_pool_tls, frame_pool_DestroyCache))
+        frame_pool_disabled = true;
+
+    if (!frame_pool_disabled && getenv("VLC_FRAME_POOL_STATS") != NULL)
+    {
+        frame_pool_stats = true;
+        atexit(frame_pool_DumpStats);
+    }
+}
+
+static struct frame_pool_cache *frame_pool_GetCache(void)
+{
+    struct frame_pool_cache *cache = vlc_threadvar_get(frame_pool_tls);
+
+    if (unlikely(cache == NULL))
+    {
+        cache = calloc(1, sizeof (*cache));
+        if (cache != NULL && vlc_threadvar_set(frame_pool_tls, cache) != 0)
+        {
+            free(cache);
+            cache = NULL;
+        }
+    }
+    return cache;
+}
+
+/** Moves up to a batch of blocks from the global pool to \p cache. */
+static void frame_pool_Refill(struct frame_pool_cache *cache, unsigned cls)
+{
+    struct frame_pool_block *block;
+    unsigned moved = 0;
+
+    vlc_mutex_lock(&frame_pool_global[cls].lock);
+    while (moved < FRAME_POOL_BATCH
+        && (block = frame_pool_global[cls].head) != NULL)
+    {
+        frame_pool_global[cls].head = block->next;
+        frame_pool_global[cls].count--;
+        block->next = cache->head[cls];
+        cache->head[cls] = block;
+        moved++;
+    }
+    vlc_mutex_unlock(&frame_pool_global[cls].lock);
+
+    cache->count[cls] += moved;
+    if (frame_pool_stats && moved > 0)
+        atomic_fetch_add_explicit(&frame_pool_refills[cls], 1,
+                                  memory_order_relaxed);
+}
+
+/** Spills a batch of blocks from \p cache to the global pool. */
+static void frame_pool_Spill(struct frame_pool_cache *cache, unsigned cls)
+{
+    struct frame_pool_block *head = cache->head[cls], *tail = head;
+
+    for (unsigned i = 1; i < FRAME_POOL_BATCH; i++)
+        tail = tail->next;
+    cache->head[cls] = tail->next;
+    cache->count[cls] -= FRAME_POOL_BATCH;
+    tail->next = NULL;
+
+    unsigned limit = FRAME_POOL_GLOBAL_BYTES >> (cls + FRAME_POOL_CLASS_MIN);
+
+    vlc_mutex_lock(&frame_pool_global[cls].lock);
+    if (frame_pool_global[cls].count < limit)
+    {
+        tail->next = frame_pool_global[cls].head;
+        frame_pool_global[cls].head = head;
+        frame_pool_global[cls].count += FRAME_POOL_BATCH;
+        head = NULL;
+    }
+    vlc_mutex_unlock(&frame_pool_global[cls].lock);
+
+    for (struct frame_pool_block *next; head != NULL; head = next)
+    {   /* memory pressure: the global pool is full, give back to the heap */
+        next = head->next;
+        frame_pool_FreeBlock(head, cls);
+    }
+}
+
+static void vlc_frame_pool_Release(vlc_frame_t *frame)
+{
+    /* i_size is never modified after allocation, so the class is implied */
+    unsigned cls = frame_pool_ClassOf(FRAME_POOL_HEADER + frame->i_size);
+    struct frame_pool_block *block = (struct frame_pool_block *)frame;
+    struct frame_pool_cache *cache = frame_pool_GetCache();
+
+    assert(cls != UINT_MAX);
+    if (unlikely(cache == NULL))
+    {
+        free(block);
+        return;
+    }
+
+    if (cache->count[cls] >= FRAME_POOL_CACHE_MAX)
+        frame_pool_Spill(cache, cls);
+
+    block->next = cache->head[cls];
+    cache->head[cls] = block;
+    cache->count[cls]++;
+}
+
+static const struct vlc_frame_callbacks vlc_frame_pool_cbs =
+{
+    vlc_frame_pool_Release,
+};
+
+static vlc_frame_t *vlc_frame_pool_Alloc(size_t size)
+{
+    vlc_once(&frame_pool_once, frame_pool_Init, NULL);
+    if (frame_pool_disabled)
+        return NULL;
+
+    size_t total = FRAME_POOL_HEADER + (2 * VLC_FRAME_PADDING) + size;
+    unsigned cls = frame_pool_ClassOf(total);
+    if (cls == UINT_MAX)
+        return NULL;
+
+    struct frame_pool_cache *cache = frame_pool_GetCache();
+    struct frame_pool_block *block = NULL;
+
+    if (likely(cache != NULL))
+    {
+        if (cache->count[cls] == 0)
+            frame_pool_Refill(cache, cls);
+
+        block = cache->head[cls];
+        if (likely(block != NULL))
+        {
+            cache->head[cls] = block->next;
+            cache->count[cls]--;
+            if (frame_pool_stats)
+                atomic_fetch_add_explicit(&frame_pool_hits[cls], 1,
+                                          memory_order_relaxed);
+        }
+    }
+
+#ifdef FRAME_POOL_HUGE
+    if (block == NULL)
+        block = frame_pool_CarveSlab(cls);
+#endif
+    if (block == NULL)
+    {
+        block = aligned_alloc(VLC_FRAME_ALIGN, frame_pool_ClassSize(cls));
+        if (unlikely(block == NULL))
+            return NULL;
+        if (frame_pool_stats)
+            atomic_fetch_add_explicit(&frame_pool_mallocs[cls], 1,
+                                      memory_order_relaxed);
+    }
+
+    unsigned char *buf = ((unsigned char *)block) + FRAME_POOL_HEADER;
+    vlc_frame_t *f = vlc_frame_Init((vlc_frame_t *)block, &vlc_frame_pool_cbs,
+                                    buf, frame_pool_ClassSize(cls)
+                                         - FRAME_POOL_HEADER);
+    f->p_buffer = buf + VLC_FRAME_PADDING;
+    f->i_buffer = size;
+    return f;
+}
+#else /* !HAVE_ALIGNED_ALLOC */
+static vlc_frame_t *vlc_frame_pool_Alloc(size_t size)
+{
+    (void) size; /* cannot guarantee buffer alignment within a pooled block */
+    return NULL;
+}
+#endif
+
+void vlc_frame_SetHugePages(bool enable)
+{
+#ifdef FRAME_POOL_HUGE
+    vlc_mutex_lock(&frame_pool_slabs.lock);
+    frame_pool_slabs.enabled = enable;
+    vlc_mutex_unlock(&frame_pool_slabs.lock);
+#else
+    (void) enable;
+#endif
+}
+
 vlc_frame_t *vlc_frame_Alloc (size_t size)
 {
     if (unlikely(size >> 28))
@@ -123,6 +564,10 @@ vlc_frame_t *vlc_frame_Alloc (size_t size)
     static_assert ((VLC_FRAME_PADDING % VLC_FRAME_ALIGN) == 0,
                    "VLC_FRAME_PADDING must be a multiple of VLC_FRAME_ALIGN");
 
+    vlc_frame_t *f = vlc_frame_pool_Alloc(size);
+    if (likely(f != NULL))
+        return f;
+
     /* 2 * VLC_FRAME_PADDING: pre + post padding */
     size_t capacity = (2 * VLC_FRAME_PADDING) + size;
     unsigned char *buf;
@@ -136,7 +581,7 @@ vlc_frame_t *vlc_frame_Alloc (size_t size)
     if (unlikely(buf == NULL))
         return NULL;
 
-    vlc_frame_t *f = vlc_frame_heap_Alloc(buf, capacity);
+    f = vlc_frame_heap_Alloc(buf, capacity);
     if (likely(f != NULL)) {
 #ifndef HAVE_ALIGNED_ALLOC
         /* Alignment */
@@ -0,0 +1,29 @@
+/*****************************************************************************
+ * frame.h: frame internals
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#include <stdbool.h>
+
+/**
+ * Enables or disables backing the vlc_frame_Alloc() size-class pools with
+ * pre-faulted, hugepage-backed memory. Process-wide setting, read from the
+ * "frame-hugepages" option at LibVLC initialization. No-op on platforms
+ * without huge page support.
+ */
+void vlc_frame_SetHugePages(bool enable);
@@ -45,6 +45,7 @@
 #include <vlc_stream.h>
 #include <vlc_fs.h>
 #include <vlc_sout.h>
+#include <vlc_hash.h>
 #include <libvlc.h>
 #include <vlc_modules.h>
 
@@ -147,6 +148,162 @@ static void ImageQueueVideo( decoder_t *p_dec, picture_t *p_pic )
     picture_fifo_Push( p_owner->p_image->outfifo, p_pic );
 }
 
+/*****************************************************************************
+ * Decoded picture cache
+ *****************************************************************************
+ * Media library scans and meta fetching decode the same embedded covers over
+ * and over, each time through a full decoder round trip. Decoded pictures are
+ * kept in a small process-wide LRU keyed by a digest of the coded bytes, so
+ * every image handler shares the cache. Entries store the raw decoder output,
+ * before any conversion, and hand out clones so callers can adjust picture
+ * properties without touching the cached copy.
+ *****************************************************************************/
+
+typedef struct image_cache_entry
+{
+    struct image_cache_entry *p_next;
+    vlc_fourcc_t i_codec;
+    size_t i_data;                          /**< Size of the coded data */
+    uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE]; /**< Digest of the coded data */
+    picture_t *p_pic;                       /**< Core-allocated copy */
+    video_format_t fmt;                     /**< Decoder output format */
+} image_cache_entry_t;
+
+static struct
+{
+    vlc_mutex_t lock;
+    image_cache_entry_t *p_entries;         /**< Most recently used first */
+    unsigned i_count;
+    bool b_flush_registered;
+} image_cache = { VLC_STATIC_MUTEX, NULL, 0, false };
+
+#define IMAGE_CACHE_MAX_ENTRIES 16
+/* Above this coded size it is likely a snapshot, not cover art */
+#define IMAGE_CACHE_MAX_DATA    (8 << 20)
+
+static void ImageCacheEntryDelete( image_cache_entry_t *p_entry )
+{
+    picture_Release( p_entry->p_pic );
+    video_format_Clean( &p_entry->fmt );
+    free( p_entry );
+}
+
+static void ImageCacheFlush( void )
+{
+    vlc_mutex_lock( &image_cache.lock );
+    image_cache_entry_t *p_entry = image_cache.p_entries;
+    image_cache.p_entries = NULL;
+    image_cache.i_count = 0;
+    vlc_mutex_unlock( &image_cache.lock );
+
+    while( p_entry != NULL )
+    {
+        image_cache_entry_t *p_next = p_entry->p_next;
+        ImageCacheEntryDelete( p_entry );
+        p_entry = p_next;
+    }
+}
+
+static bool ImageCacheable( const block_t *p_block, vlc_fourcc_t i_codec )
+{
+    return i_codec != 0 && p_block->i_buffer > 0 &&
+           p_block->i_buffer <= IMAGE_CACHE_MAX_DATA;
+}
+
+static void ImageCacheDigest( const block_t *p_block,
+                              uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE] )
+{
+    vlc_hash_md5_t md5;
+    vlc_hash_md5_Init( &md5 );
+    vlc_hash_md5_Update( &md5, p_block->p_buffer, p_block->i_buffer );
+    vlc_hash_md5_Finish( &md5, digest, VLC_HASH_MD5_DIGEST_SIZE );
+}
+
+static picture_t *ImageCacheGet( vlc_fourcc_t i_codec,
+                                 const uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE],
+                                 size_t i_data, es_format_t *p_fmt )
+{
+    picture_t *p_pic = NULL;
+
+    vlc_mutex_lock( &image_cache.lock );
+    for( image_cache_entry_t **pp_entry = &image_cache.p_entries;
+         *pp_entry != NULL; pp_entry = &(*pp_entry)->p_next )
+    {
+        image_cache_entry_t *p_entry = *pp_entry;
+        if( p_entry->i_codec != i_codec || p_entry->i_data != i_data ||
+            memcmp( p_entry->digest, digest, VLC_HASH_MD5_DIGEST_SIZE ) )
+            continue;
+
+        /* Move to the front of the LRU */
+        *pp_entry = p_entry->p_next;
+        p_entry->p_next = image_cache.p_entries;
+        image_cache.p_entries = p_entry;
+
+        p_pic = picture_Clone( p_entry->p_pic );
+        if( p_pic != NULL )
+            es_format_InitFromVideo( p_fmt, &p_entry->fmt );
+        break;
+    }
+    vlc_mutex_unlock( &image_cache.lock );
+
+    return p_pic;
+}
+
+static void ImageCacheStore( vlc_fourcc_t i_codec,
+                             const uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE],
+                             size_t i_data, const picture_t *p_pic,
+                             const video_format_t *p_fmt )
+{
+    image_cache_entry_t *p_entry = malloc( sizeof(*p_entry) );
+    if( unlikely(p_entry == NULL) )
+        return;
+
+    /* Keep a core-allocated copy rather than a reference: the decoder plugin
+     * owning the original buffers may be unloaded while the cache outlives
+     * its handler. */
+    p_entry->p_pic = picture_NewFromFormat( &p_pic->format );
+    if( unlikely(p_entry->p_pic == NULL) )
+    {
+        free( p_entry );
+        return;
+    }
+    picture_Copy( p_entry->p_pic, p_pic );
+
+    if( video_format_Copy( &p_entry->fmt, p_fmt ) != VLC_SUCCESS )
+    {
+        picture_Release( p_entry->p_pic );
+        free( p_entry );
+        return;
+    }
+    p_entry->i_codec = i_codec;
+    p_entry->i_data = i_data;
+    memcpy( p_entry->digest, digest, VLC_HASH_MD5_DIGEST_SIZE );
+
+    image_cache_entry_t *p_evicted = NULL;
+
+    vlc_mutex_lock( &image_cache.lock );
+    if( !image_cache.b_flush_registered )
+    {
+        atexit( ImageCacheFlush );
+        image_cache.b_flush_registered = true;
+    }
+    p_entry->p_next = image_cache.p_entries;
+    image_cache.p_entries = p_entry;
+    if( ++image_cache.i_count > IMAGE_CACHE_MAX_ENTRIES )
+    {
+        image_cache_entry_t **pp_last = &image_cache.p_entries;
+        while( (*pp_last)->p_next != NULL )
+            pp_last = &(*pp_last)->p_next;
+        p_evicted = *pp_last;
+        *pp_last = NULL;
+        image_cache.i_count--;
+    }
+    vlc_mutex_unlock( &image_cache.lock );
+
+    if( p_evicted != NULL )
+        ImageCacheEntryDelete( p_evicted );
+}
+
 static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
                              const es_format_t *p_es_in,
                              video_format_t *p_fmt_out )
@@ -159,6 +316,24 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
         return NULL;
     }
 
+    /* Probe the decoded picture cache before spinning up a decoder */
+    uint8_t digest[VLC_HASH_MD5_DIGEST_SIZE];
+    const vlc_fourcc_t i_codec = p_es_in->video.i_chroma;
+    const size_t i_data = p_block->i_buffer;
+    const bool b_cacheable = ImageCacheable( p_block, i_codec );
+    es_format_t fmt_dec;
+
+    if( b_cacheable )
+    {
+        ImageCacheDigest( p_block, digest );
+        p_pic = ImageCacheGet( i_codec, digest, i_data, &fmt_dec );
+        if( p_pic != NULL )
+        {
+            block_Release( p_block );
+            goto decoded;
+        }
+    }
+
     /* Check if we can reuse the current decoder */
     if( p_image->p_dec &&
         p_image->p_dec->fmt_in->i_codec != p_es_in->video.i_chroma )
@@ -216,44 +391,53 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
         return 0;
     }
 
+    if( es_format_Copy( &fmt_dec, &p_image->p_dec->fmt_out ) != VLC_SUCCESS )
+    {
+        picture_Release( p_pic );
+        return NULL;
+    }
+    if( b_cacheable )
+        ImageCacheStore( i_codec, digest, i_data, p_pic, &fmt_dec.video );
+
+decoded:
     if( !p_fmt_out->i_chroma )
-        p_fmt_out->i_chroma = p_image->p_dec->fmt_out.video.i_chroma;
+        p_fmt_out->i_chroma = fmt_dec.video.i_chroma;
     if( !p_fmt_out->i_width && p_fmt_out->i_height )
-        p_fmt_out->i_width = (int64_t)p_image->p_dec->fmt_out.video.i_width *
-                             p_image->p_dec->fmt_out.video.i_sar_num *
+        p_fmt_out->i_width = (int64_t)fmt_dec.video.i_width *
+                             fmt_dec.video.i_sar_num *
                              p_fmt_out->i_height /
-                             p_image->p_dec->fmt_out.video.i_height /
-                             p_image->p_dec->fmt_out.video.i_sar_den;
+                             fmt_dec.video.i_height /
+                             fmt_dec.video.i_sar_den;
 
     if( !p_fmt_out->i_height && p_fmt_out->i_width )
-        p_fmt_out->i_height = (int64_t)p_image->p_dec->fmt_out.video.i_height *
-                              p_image->p_dec->fmt_out.video.i_sar_den *
+        p_fmt_out->i_height = (int64_t)fmt_dec.video.i_height *
+                              fmt_dec.video.i_sar_den *
                               p_fmt_out->i_width /
-                              p_image->p_dec->fmt_out.video.i_width /
-                              p_image->p_dec->fmt_out.video.i_sar_num;
+                              fmt_dec.video.i_width /
+                              fmt_dec.video.i_sar_num;
     if( !p_fmt_out->i_width )
-        p_fmt_out->i_width = p_image->p_dec->fmt_out.video.i_width;
+        p_fmt_out->i_width = fmt_dec.video.i_width;
     if( !p_fmt_out->i_height )
-        p_fmt_out->i_height = p_image->p_dec->fmt_out.video.i_height;
+        p_fmt_out->i_height = fmt_dec.video.i_height;
     if( !p_fmt_out->i_visible_width )
         p_fmt_out->i_visible_width = p_fmt_out->i_width;
     if( !p_fmt_out->i_visible_height )
         p_fmt_out->i_visible_height = p_fmt_out->i_height;
     if( p_fmt_out->transfer == TRANSFER_FUNC_UNDEF )
-        p_fmt_out->transfer = p_image->p_dec->fmt_out.video.transfer;
+        p_fmt_out->transfer = fmt_dec.video.transfer;
     if( p_fmt_out->primaries == COLOR_PRIMARIES_UNDEF )
-        p_fmt_out->primaries = p_image->p_dec->fmt_out.video.primaries;
+        p_fmt_out->primaries = fmt_dec.video.primaries;
     if( p_fmt_out->space == COLOR_SPACE_UNDEF )
-        p_fmt_out->space = p_image->p_dec->fmt_out.video.space;
+        p_fmt_out->space = fmt_dec.video.space;
 
     /* Check if we need chroma conversion or resizing */
-    if( !video_format_IsSameChroma( &p_image->p_dec->fmt_out.video, p_fmt_out ) ||
-        p_image->p_dec->fmt_out.video.i_width != p_fmt_out->i_width ||
-        p_image->p_dec->fmt_out.video.i_height != p_fmt_out->i_height )
+    if( !video_format_IsSameChroma( &fmt_dec.video, p_fmt_out ) ||
+        fmt_dec.video.i_width != p_fmt_out->i_width ||
+        fmt_dec.video.i_height != p_fmt_out->i_height )
     {
         if( p_image->p_converter &&
             ( !video_format_IsSameChroma( &p_image->p_converter->fmt_in.video,
-                                          &p_image->p_dec->fmt_out.video ) ||
+                                          &fmt_dec.video ) ||
               !video_format_IsSameChroma( &p_image->p_converter->fmt_out.video, p_fmt_out ) ) )
         {
             /* We need to restart a new filter */
@@ -265,12 +449,13 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
         if( !p_image->p_converter )
         {
             p_image->p_converter =
-                CreateConverter( p_image->p_parent, &p_image->p_dec->fmt_out,
+                CreateConverter( p_image->p_parent, &fmt_dec,
                                  picture_GetVideoContext(p_pic), p_fmt_out );
 
             if( !p_image->p_converter )
             {
                 picture_Release( p_pic );
+                es_format_Clean( &fmt_dec );
                 return NULL;
             }
         }
@@ -278,7 +463,7 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
         {
             /* Filters should handle on-the-fly size changes */
             es_format_Clean( &p_image->p_converter->fmt_in );
-            es_format_Copy( &p_image->p_converter->fmt_in, &p_image->p_dec->fmt_out );
+            es_format_Copy( &p_image->p_converter->fmt_in, &fmt_dec );
             video_format_Clean( &p_image->p_converter->fmt_out.video );
             video_format_Copy( &p_image->p_converter->fmt_out.video, p_fmt_out);
         }
@@ -289,9 +474,10 @@ static picture_t *ImageRead( image_handler_t *p_image, block_t *p_block,
     else
     {
         video_format_Clean( p_fmt_out );
-        video_format_Copy( p_fmt_out, &p_image->p_dec->fmt_out.video );
+        video_format_Copy( p_fmt_out, &fmt_dec.video );
     }
 
+    es_format_Clean( &fmt_dec );
     return p_pic;
 }
 
@@ -735,8 +921,11 @@ static encoder_t *CreateEncoder( vlc_object_t *p_this, const video_format_t *fmt
     p_enc->fmt_out.video.i_height = p_enc->fmt_in.video.i_height;
     p_enc->ops = NULL;
 
-    /* Find a suitable decoder module */
-    p_enc->p_module = module_need( p_enc, "image encoder", NULL, false );
+    /* Find a suitable encoder module: the "image-encoder" list lets a
+     * deployment prefer e.g. a hardware accelerated encoder, with automatic
+     * fallback to the other image encoders. */
+    p_enc->p_module = module_need_var( p_enc, "image encoder",
+                                       "image-encoder" );
     if( !p_enc->p_module )
     {
         msg_Err( p_enc, "no suitable encoder module for fourcc `%4.4s'.\n"
@@ -191,11 +191,24 @@ void vlc_interrupt_kill(vlc_interrupt_t *ctx)
     vlc_interrupt_raise(ctx);
 }
 
+/**
+ * Checks for termination without taking the context lock.
+ *
+ * The kill flag is monotonic (vlc_interrupt_kill() is not reversible) and
+ * only polled opportunistically, so a relaxed load suffices: the flag itself
+ * carries no data dependency, and threads blocked in a wait are woken up
+ * through the locked callback path of vlc_interrupt_raise() anyway.
+ */
+static bool vlc_interrupt_killed(vlc_interrupt_t *ctx)
+{
+    return atomic_load_explicit(&ctx->killed, memory_order_relaxed);
+}
+
 bool vlc_killed(void)
 {
     vlc_interrupt_t *ctx = vlc_interrupt_var;
 
-    return (ctx != NULL) && atomic_load(&ctx->killed);
+    return (ctx != NULL) && vlc_interrupt_killed(ctx);
 }
 
 static void vlc_interrupt_sem(void *opaque)
@@ -209,6 +222,11 @@ int vlc_sem_wait_i11e(vlc_sem_t *sem)
     if (ctx == NULL)
         return vlc_sem_wait(sem), 0;
 
+    /* Dead context: do not bother registering, the wait would only be
+     * interrupted right away. */
+    if (vlc_interrupt_killed(ctx))
+        return EINTR;
+
     vlc_interrupt_prepare(ctx, vlc_interrupt_sem, sem);
 
     vlc_cleanup_push(vlc_interrupt_cleanup, ctx);
@@ -237,6 +255,9 @@ int vlc_mwait_i11e(vlc_tick_t deadline)
     if (ctx == NULL)
         return vlc_tick_wait(deadline), 0;
 
+    if (vlc_interrupt_killed(ctx))
+        return EINTR;
+
     vlc_cond_t wait;
     vlc_cond_init(&wait);
 
@@ -395,6 +416,15 @@ int vlc_poll_i11e(struct pollfd *fds, unsigned nfds, int timeout)
     if (ctx == NULL)
         return poll(fds, nfds, timeout);
 
+    /* Dead context: skip the wake-up pipe and registration round trip, the
+     * poll would only be interrupted right away. This keeps termination
+     * cheap for the tight read loops polling through here. */
+    if (vlc_interrupt_killed(ctx))
+    {
+        errno = EINTR;
+        return -1;
+    }
+
     int ret;
 
     if (likely(nfds < 255))
@@ -458,6 +488,12 @@ int vlc_poll_i11e(struct pollfd *fds, unsigned nfds, int timeout)
     if (ctx == NULL)
         return vlc_poll(fds, nfds, timeout);
 
+    if (vlc_interrupt_killed(ctx))
+    {
+        errno = EINTR;
+        return -1;
+    }
+
     int ret = -1;
     HANDLE th;
 
@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * membudget.c: LibVLC instance memory budget
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <vlc_common.h>
+#include <vlc_membudget.h>
+
+#include "membudget.h"
+#include "../libvlc.h"
+
+struct vlc_membudget
+{
+    /* Recursive: trim callbacks run under the lock and are allowed to
+     * update their own usage. */
+    vlc_mutex_t lock;
+    size_t limit;
+    size_t total;
+    unsigned epoch; /**< guards one trim request per client and pass */
+    bool trimming;
+    struct vlc_list clients;
+};
+
+/* Guards the lazy creation of the per-instance budget singleton */
+static vlc_mutex_t budget_creation_lock = VLC_STATIC_MUTEX;
+
+static struct vlc_membudget *vlc_membudget_Get(vlc_object_t *obj)
+{
+    int64_t mebibytes = var_InheritInteger(obj, "memory-budget");
+    if (mebibytes <= 0)
+        return NULL;
+
+    libvlc_priv_t *priv = libvlc_priv(vlc_object_instance(obj));
+
+    vlc_mutex_lock(&budget_creation_lock);
+    struct vlc_membudget *budget = priv->membudget;
+    if (budget == NULL)
+    {
+        budget = malloc(sizeof (*budget));
+        if (likely(budget != NULL))
+        {
+            vlc_mutex_init_recursive(&budget->lock);
+            budget->limit = (size_t)mebibytes << 20;
+            budget->total = 0;
+            budget->epoch = 0;
+            budget->trimming = false;
+            vlc_list_init(&budget->clients);
+            priv->membudget = budget;
+
+            msg_Dbg(obj, "using %"PRId64" MiB memory budget", mebibytes);
+        }
+    }
+    vlc_mutex_unlock(&budget_creation_lock);
+    return budget;
+}
+
+void vlc_membudget_Destroy(libvlc_int_t *libvlc)
+{
+    libvlc_priv_t *priv = libvlc_priv(libvlc);
+    struct vlc_membudget *budget = priv->membudget;
+
+    if (budget == NULL)
+        return;
+    priv->membudget = NULL;
+
+    /* All consumers outlive neither their input nor the instance. */
+    assert(vlc_list_is_empty(&budget->clients));
+    free(budget);
+}
+
+/**
+ * Sheds the overage by asking the largest consumers to trim, one at a
+ * time, largest first. Runs with the budget lock held; each client is
+ * asked at most once per pass so a consumer that cannot (or will not)
+ * shrink right away does not stall the loop.
+ */
+static void vlc_membudget_Enforce(struct vlc_membudget *budget)
+{
+    if (budget->trimming)
+        return; /* re-entered from a trim callback updating its usage */
+
+    budget->trimming = true;
+    budget->epoch++;
+
+    while (budget->total > budget->limit)
+    {
+        struct vlc_membudget_client *victim = NULL, *it;
+
+        vlc_list_foreach(it, &budget->clients, node)
+            if (it->cbs != NULL && it->usage > 0 && it->epoch != budget->epoch
+             && (victim == NULL || it->usage > victim->usage))
+                victim = it;
+
+        if (victim == NULL)
+            break; /* every consumer has been asked already */
+
+        size_t overage = budget->total - budget->limit;
+        size_t target = (victim->usage > overage)
+                      ? victim->usage - overage : 0;
+
+        victim->epoch = budget->epoch;
+        victim->cbs->trim(victim->data, target);
+    }
+
+    budget->trimming = false;
+}
+
+void vlc_membudget_Attach(vlc_object_t *obj,
+                          struct vlc_membudget_client *client,
+                          const char *name,
+                          const struct vlc_membudget_cbs *cbs, void *data)
+{
+    client->budget = vlc_membudget_Get(obj);
+    client->name = name;
+    client->cbs = cbs;
+    client->data = data;
+    client->usage = 0;
+    client->epoch = 0;
+
+    if (client->budget == NULL)
+        return;
+
+    vlc_mutex_lock(&client->budget->lock);
+    vlc_list_append(&client->node, &client->budget->clients);
+    vlc_mutex_unlock(&client->budget->lock);
+}
+
+void vlc_membudget_Detach(struct vlc_membudget_client *client)
+{
+    struct vlc_membudget *budget = client->budget;
+
+    if (budget == NULL)
+        return;
+
+    vlc_mutex_lock(&budget->lock);
+    assert(budget->total >= client->usage);
+    budget->total -= client->usage;
+    vlc_list_remove(&client->node);
+    vlc_mutex_unlock(&budget->lock);
+}
+
+void vlc_membudget_SetUsage(struct vlc_membudget_client *client, size_t usage)
+{
+    struct vlc_membudget *budget = client->budget;
+
+    if (budget == NULL)
+        return;
+
+    vlc_mutex_lock(&budget->lock);
+    assert(budget->total >= client->usage);
+    budget->total = budget->total - client->usage + usage;
+    client->usage = usage;
+
+    if (budget->total > budget->limit)
+        vlc_membudget_Enforce(budget);
+    vlc_mutex_unlock(&budget->lock);
+}
+
+size_t vlc_membudget_Enum(vlc_object_t *obj,
+                          void (*cb)(void *, const char *, size_t),
+                          void *opaque)
+{
+    libvlc_priv_t *priv = libvlc_priv(vlc_object_instance(obj));
+    struct vlc_membudget *budget = priv->membudget;
+
+    if (budget == NULL)
+        return 0;
+
+    vlc_mutex_lock(&budget->lock);
+    struct vlc_membudget_client *it;
+    vlc_list_foreach(it, &budget->clients, node)
+        cb(opaque, it->name, it->usage);
+    size_t total = budget->total;
+    vlc_mutex_unlock(&budget->lock);
+    return total;
+}
@@ -116,6 +116,8 @@ static void vlc_LogCallback(vlc_logger_t *logger, int type,
     va_end(ap);
 }
 
+static bool vlc_LogSwitchFiltered(struct vlc_logger *logger, int type);
+
 void vlc_vaLog(struct vlc_logger *const *loggerp, int type,
                const char *typename, const char *module,
                const char *file, unsigned line, const char *func,
@@ -126,6 +128,11 @@ void vlc_vaLog(struct vlc_logger *const *loggerp, int type,
         // nothing to do
         return;
 
+    /* Drop the message early if the back-end would discard it anyway,
+     * before spending any time on the message metadata. */
+    if (vlc_LogSwitchFiltered(logger, type))
+        return;
+
     /* Get basename from the module filename */
     char *p = strrchr(module, '/');
     if (p != NULL)
@@ -288,6 +295,7 @@ static struct vlc_logger discard_log = { &discard_ops };
  */
 struct vlc_logger_switch {
     struct vlc_logger *_Atomic backend;
+    _Atomic int filter; /**< Highest message type the back-end consumes */
     struct vlc_logger frontend;
 };
 
@@ -299,13 +307,17 @@ static void vlc_vaLogSwitch(void *d, int type, const vlc_log_t *item,
         container_of(logger, struct vlc_logger_switch, frontend);
     struct vlc_logger *backend;
 
+    if (type > atomic_load_explicit(&logswitch->filter, memory_order_relaxed))
+        return;
+
     vlc_rcu_read_lock();
     backend = atomic_load_explicit(&logswitch->backend, memory_order_acquire);
     backend->ops->log(backend, type, item, format, ap);
     vlc_rcu_read_unlock();
 }
 
-static void vlc_LogSwitch(vlc_logger_t *logger, vlc_logger_t *new_logger);
+static void vlc_LogSwitch(vlc_logger_t *logger, vlc_logger_t *new_logger,
+                          int filter);
 
 static void vlc_LogSwitchClose(void *d)
 {
@@ -314,7 +326,7 @@ static void vlc_LogSwitchClose(void *d)
         container_of(logger, struct vlc_logger_switch, frontend);
 
     /* Discard any further messages. */
-    vlc_LogSwitch(logger, &discard_log);
+    vlc_LogSwitch(logger, &discard_log, VLC_MSG_INFO - 1);
     free(logswitch);
 }
 
@@ -323,7 +335,26 @@ static const struct vlc_logger_operations switch_ops = {
     vlc_LogSwitchClose,
 };
 
-static void vlc_LogSwitch(vlc_logger_t *logger, vlc_logger_t *new_logger)
+/**
+ * Checks if a message would be dropped by the current log back-end.
+ *
+ * This only applies to the switchable log: other logs cannot tell the fate of
+ * a message without dispatching it.
+ */
+static bool vlc_LogSwitchFiltered(struct vlc_logger *logger, int type)
+{
+    if (logger->ops != &switch_ops)
+        return false;
+
+    struct vlc_logger_switch *logswitch =
+        container_of(logger, struct vlc_logger_switch, frontend);
+
+    return type > atomic_load_explicit(&logswitch->filter,
+                                       memory_order_relaxed);
+}
+
+static void vlc_LogSwitch(vlc_logger_t *logger, vlc_logger_t *new_logger,
+                          int filter)
 {
     struct vlc_logger_switch *logswitch =
         container_of(logger, struct vlc_logger_switch, frontend);
@@ -331,9 +362,12 @@ static void vlc_LogSwitch(vlc_logger_t *logger, vlc_logger_t *new_logger)
 
     assert(logger->ops == &switch_ops);
 
-    if (new_logger == NULL)
+    if (new_logger == NULL) {
         new_logger = &discard_log;
+        filter = VLC_MSG_INFO - 1;
+    }
 
+    atomic_store_explicit(&logswitch->filter, filter, memory_order_relaxed);
     old_logger = atomic_exchange_explicit(&logswitch->backend, new_logger,
                                           memory_order_acq_rel);
     vlc_rcu_synchronize();
@@ -348,6 +382,7 @@ static struct vlc_logger *vlc_LogSwitchCreate(void)
 
     logswitch->frontend.ops = &switch_ops;
     atomic_init(&logswitch->backend, &discard_log);
+    atomic_init(&logswitch->filter, VLC_MSG_DBG);
     return &logswitch->frontend;
 }
 
@@ -359,16 +394,19 @@ struct vlc_logger_module {
     struct vlc_logger frontend;
     const struct vlc_logger_operations *ops;
     void *opaque;
+    int max_type; /**< Highest message type the sink consumes */
 };
 
 static int vlc_logger_load(void *func, bool forced, va_list ap)
 {
-    const struct vlc_logger_operations *(*activate)(vlc_object_t *,
-                                                    void **) = func;
+    const struct vlc_logger_operations *(*activate)(vlc_object_t *, void **,
+                                                    int *restrict) = func;
     struct vlc_logger_module *module = va_arg(ap, struct vlc_logger_module *);
 
     (void) forced;
-    module->ops = activate(VLC_OBJECT(module), &module->opaque);
+    module->max_type = VLC_MSG_DBG;
+    module->ops = activate(VLC_OBJECT(module), &module->opaque,
+                           &module->max_type);
     return (module->ops != NULL) ? VLC_SUCCESS : VLC_EGENERIC;
 }
 
@@ -399,7 +437,8 @@ static const struct vlc_logger_operations module_ops = {
     vlc_LogModuleClose,
 };
 
-static struct vlc_logger *vlc_LogModuleCreate(vlc_object_t *parent)
+static struct vlc_logger *vlc_LogModuleCreate(vlc_object_t *parent,
+                                              int *restrict max_type)
 {
     struct vlc_logger_module *module;
 
@@ -415,6 +454,7 @@ static struct vlc_logger *vlc_LogModuleCreate(vlc_object_t *parent)
     }
 
     module->frontend.ops = &module_ops;
+    *max_type = module->max_type;
     return &module->frontend;
 }
 
@@ -424,11 +464,13 @@ static struct vlc_logger *vlc_LogModuleCreate(vlc_object_t *parent)
  */
 void vlc_LogInit(libvlc_int_t *vlc)
 {
-    struct vlc_logger *logger = vlc_LogModuleCreate(VLC_OBJECT(vlc));
+    int max_type = VLC_MSG_INFO - 1;
+    struct vlc_logger *logger = vlc_LogModuleCreate(VLC_OBJECT(vlc),
+                                                    &max_type);
     if (logger == NULL)
         logger = &discard_log;
 
-    vlc_LogSwitch(vlc->obj.logger, logger);
+    vlc_LogSwitch(vlc->obj.logger, logger, max_type);
 }
 
 /**
@@ -449,7 +491,7 @@ int vlc_LogPreinit(libvlc_int_t *vlc)
 
     struct vlc_logger *early = vlc_LogEarlyOpen(logger);
     if (early != NULL) {
-        vlc_LogSwitch(logger, early);
+        vlc_LogSwitch(logger, early, VLC_MSG_DBG);
         vlc_LogSpam(VLC_OBJECT(vlc));
     }
     return 0;
@@ -563,7 +605,8 @@ void vlc_LogSet(libvlc_int_t *vlc, const struct vlc_logger_operations *ops,
     if (logger == NULL)
         logger = &discard_log;
 
-    vlc_LogSwitch(vlc->obj.logger, logger);
+    vlc_LogSwitch(vlc->obj.logger, logger,
+                  (logger != &discard_log) ? VLC_MSG_DBG : (VLC_MSG_INFO - 1));
     vlc_LogSpam(VLC_OBJECT(vlc));
 }
 
@@ -68,12 +68,57 @@ char *vlc_tick_to_str( char *psz_buffer, vlc_tick_t ticks )
  * Date management (internal and external)
  */
 
+/* Precomputes the per-sample tick increment and the fixed-point
+ * reciprocal of the divider, so that date_Increment()/date_Decrement()
+ * convert sample counts with multiplications on the fast path. */
+static void date_UpdateDivider( date_t *p_date )
+{
+    if( p_date->i_divider_num == 0 )
+    {
+        p_date->i_tick_inc = 0;
+        p_date->i_tick_rem = 0;
+        p_date->i_divider_inv = 0;
+        return;
+    }
+
+    uint64_t i_dividend = (uint64_t)CLOCK_FREQ * p_date->i_divider_den;
+    p_date->i_tick_inc = i_dividend / p_date->i_divider_num;
+    p_date->i_tick_rem = i_dividend % p_date->i_divider_num;
+    /* ceil(2^64 / num); wraps to 0 for num == 1, cf. date_DivMod() */
+    p_date->i_divider_inv = UINT64_MAX / p_date->i_divider_num + 1;
+}
+
+/* Exact Euclidean division of r by the date divider. For 32-bit operands
+ * the quotient and remainder come from the precomputed reciprocal with
+ * two multiplications (division by invariant multiplication, cf. Lemire,
+ * "Faster remainder by direct computation", 2019). */
+static inline uint64_t date_DivMod( const date_t *p_date, uint64_t r,
+                                    uint32_t *p_rem )
+{
+    if( unlikely(p_date->i_divider_num == 1) )
+    {
+        *p_rem = 0;
+        return r;
+    }
+#ifdef __SIZEOF_INT128__
+    if( likely(r <= UINT32_MAX) )
+    {
+        uint64_t lowbits = p_date->i_divider_inv * (uint32_t)r;
+        *p_rem = ((unsigned __int128)lowbits * p_date->i_divider_num) >> 64;
+        return ((unsigned __int128)p_date->i_divider_inv * (uint32_t)r) >> 64;
+    }
+#endif
+    *p_rem = r % p_date->i_divider_num;
+    return r / p_date->i_divider_num;
+}
+
 void date_Init( date_t *p_date, uint32_t i_divider_n, uint32_t i_divider_d )
 {
     p_date->date = VLC_TICK_INVALID;
     p_date->i_divider_num = i_divider_n;
     p_date->i_divider_den = i_divider_d;
     p_date->i_remainder = 0;
+    date_UpdateDivider( p_date );
 }
 
 void date_Change( date_t *p_date, uint32_t i_divider_n, uint32_t i_divider_d )
@@ -83,6 +128,7 @@ void date_Change( date_t *p_date, uint32_t i_divider_n, uint32_t i_divider_d )
     p_date->i_remainder = p_date->i_remainder * i_divider_n / p_date->i_divider_num;
     p_date->i_divider_num = i_divider_n;
     p_date->i_divider_den = i_divider_d;
+    date_UpdateDivider( p_date );
 }
 
 vlc_tick_t date_Increment( date_t *p_date, uint32_t i_nb_samples )
@@ -90,19 +136,20 @@ vlc_tick_t date_Increment( date_t *p_date, uint32_t i_nb_samples )
     if(unlikely(p_date->date == VLC_TICK_INVALID))
         return VLC_TICK_INVALID;
     assert( p_date->i_divider_num != 0 );
-    vlc_tick_t i_dividend = i_nb_samples * CLOCK_FREQ * p_date->i_divider_den;
-    lldiv_t d = lldiv( i_dividend, p_date->i_divider_num );
 
-    p_date->date += d.quot;
-    p_date->i_remainder += (int)d.rem;
+    /* This is Bresenham algorithm, using the quotient and remainder of
+     * (CLOCK_FREQ * den) / num cached by date_UpdateDivider(). */
+    uint64_t r = p_date->i_remainder
+               + (uint64_t)i_nb_samples * p_date->i_tick_rem;
 
-    if( p_date->i_remainder >= p_date->i_divider_num )
+    p_date->date += (vlc_tick_t)((uint64_t)i_nb_samples * p_date->i_tick_inc);
+    if( r >= p_date->i_divider_num )
     {
-        /* This is Bresenham algorithm. */
-        assert( p_date->i_remainder < 2*p_date->i_divider_num);
-        p_date->date += 1;
-        p_date->i_remainder -= p_date->i_divider_num;
+        uint32_t i_remainder;
+        p_date->date += date_DivMod( p_date, r, &i_remainder );
+        r = i_remainder;
     }
+    p_date->i_remainder = (uint32_t)r;
 
     return p_date->date;
 }
@@ -111,9 +158,12 @@ vlc_tick_t date_Decrement( date_t *p_date, uint32_t i_nb_samples )
 {
     if(unlikely(p_date->date == VLC_TICK_INVALID))
         return VLC_TICK_INVALID;
-    vlc_tick_t i_dividend = (vlc_tick_t)i_nb_samples * CLOCK_FREQ * p_date->i_divider_den;
-    p_date->date -= i_dividend / p_date->i_divider_num;
-    unsigned i_rem_adjust = i_dividend % p_date->i_divider_num;
+
+    uint32_t i_rem_adjust;
+    uint64_t i_quot = (uint64_t)i_nb_samples * p_date->i_tick_inc
+        + date_DivMod( p_date, (uint64_t)i_nb_samples * p_date->i_tick_rem,
+                       &i_rem_adjust );
+    p_date->date -= i_quot;
 
     if( p_date->i_remainder < i_rem_adjust )
     {
@@ -68,7 +68,9 @@ int vlc_object_init(vlc_object_t *restrict obj, vlc_object_t *parent,
 
     priv->parent = parent;
     priv->typename = typename;
-    priv->var_root = NULL;
+    priv->var_table = NULL;
+    priv->var_count = 0;
+    priv->var_size = 0;
     vlc_mutex_init (&priv->var_lock);
     priv->resources = NULL;
 
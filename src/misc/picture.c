@@ -34,6 +34,13 @@
 #include <limits.h>
 #include <stdckdint.h>
 
+#ifdef __linux__
+# include <stdio.h>
+# include <unistd.h>
+# include <sys/syscall.h>
+# include <linux/mempolicy.h>
+#endif
+
 #include <vlc_common.h>
 #include "picture.h"
 #include <vlc_image.h>
@@ -41,6 +48,63 @@
 
 #include "ancillary.h"
 
+#if defined (__linux__) && defined (SYS_mbind)
+/* Bit mask of the NUMA nodes to interleave picture memory over, or 0 when
+ * interleaving is disabled (including on single-node machines). */
+static atomic_ulong picture_numa_mask = 0;
+
+void picture_SetNumaInterleave(bool enable)
+{
+    unsigned long mask = 0;
+
+    if (enable) {
+        /* Possible nodes, as a list of ranges, e.g. "0-3" */
+        FILE *f = fopen("/sys/devices/system/node/possible", "rte");
+
+        if (f != NULL) {
+            unsigned long first, last;
+
+            while (fscanf(f, "%lu", &first) == 1) {
+                last = first;
+                if (fscanf(f, "-%lu", &last) != 1)
+                    last = first;
+                for (unsigned long n = first;
+                     n <= last && n < sizeof (mask) * CHAR_BIT; n++)
+                    mask |= 1ul << n;
+                if (getc(f) != ',')
+                    break;
+            }
+            fclose(f);
+        }
+
+        /* Interleaving over a single node is a pointless system call */
+        if ((mask & (mask - 1)) == 0)
+            mask = 0;
+    }
+
+    atomic_store_explicit(&picture_numa_mask, mask, memory_order_relaxed);
+}
+
+static void picture_NumaApply(void *base, size_t size)
+{
+    unsigned long mask = atomic_load_explicit(&picture_numa_mask,
+                                              memory_order_relaxed);
+
+    if (likely(mask == 0))
+        return;
+    /* Best effort: pages already touched keep their location */
+    syscall(SYS_mbind, base, size, MPOL_INTERLEAVE, &mask,
+            sizeof (mask) * CHAR_BIT, 0);
+}
+#else
+void picture_SetNumaInterleave(bool enable)
+{
+    (void) enable;
+}
+
+# define picture_NumaApply(base, size) ((void)0)
+#endif
+
 static void PictureDestroyContext( picture_t *p_picture )
 {
     picture_context_t *ctx = p_picture->context;
@@ -315,6 +379,7 @@ picture_t *picture_NewFromFormat(const video_format_t *restrict fmt)
     unsigned char *buf = picture_Allocate(&res->fd, pic_size);
     if (unlikely(buf == NULL))
         goto error;
+    picture_NumaApply(buf, pic_size);
 
     res->base = buf;
     res->size = pic_size;
@@ -18,6 +18,7 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
  *****************************************************************************/
 
+#include <stdalign.h>
 #include <stdatomic.h>
 #include <stddef.h>
 
@@ -34,7 +35,11 @@ typedef struct
         void *opaque;
     } gc;
 
-    void *pool; /* Only used by picture_pool.c */
+    /* Keep the pool bookkeeping away from the cache line holding the
+     * reference count at the tail of picture_t: the refcount is hammered by
+     * decoder and vout threads while the pool fields are guarded by the pool
+     * shard locks. */
+    alignas(64) void *pool; /* Only used by picture_pool.c */
     struct vlc_list pool_node; /* Only used by picture_pool.c */
 
     /** Private ancillary struct. Don't use it directly, but use it via
@@ -45,4 +50,11 @@ typedef struct
 void *picture_Allocate(int *, size_t);
 void picture_Deallocate(int, void *, size_t);
 
+/**
+ * Enables or disables interleaving of software picture memory across NUMA
+ * nodes. Process-wide setting, read from the "numa-interleave" option at
+ * LibVLC initialization. No-op on platforms without NUMA support.
+ */
+void picture_SetNumaInterleave(bool enable);
+
 picture_t * picture_InternalClone(picture_t *, void (*pf_destroy)(picture_t *), void *);
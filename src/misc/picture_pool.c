@@ -27,6 +27,7 @@
 #endif
 #include <assert.h>
 #include <limits.h>
+#include <stdalign.h>
 #include <stdatomic.h>
 #include <stdbit.h>
 #include <stdlib.h>
@@ -40,6 +41,16 @@
 
 #define POOL_MAX 256
 
+/* Number of free-list shards; threads hash onto a shard by their thread
+ * identifier so the vout and decoder threads usually touch distinct
+ * cache lines and locks. Must be a power of two. */
+#define POOL_SHARDS 4
+
+struct pool_shard {
+    alignas(64) vlc_mutex_t lock;
+    struct vlc_list available_list;
+};
+
 struct picture_pool_t {
     vlc_mutex_t lock;
     vlc_cond_t  wait;
@@ -47,16 +58,47 @@ struct picture_pool_t {
     vlc_atomic_rc_t    refs;
     bool released;
     struct vlc_list inuse_list;
-    struct vlc_list available_list;
+    struct pool_shard shards[POOL_SHARDS];
+    unsigned next_shard; /* round-robin distribution at creation time */
 };
 
+static unsigned picture_pool_ShardSelf(void)
+{
+    return vlc_thread_id() & (POOL_SHARDS - 1);
+}
+
+/* Pops an available picture, preferring the calling thread's shard and
+ * stealing from the other shards when it is empty. */
+static picture_priv_t *picture_pool_PopAvailable(picture_pool_t *pool)
+{
+    unsigned self = picture_pool_ShardSelf();
+
+    for (unsigned i = 0; i < POOL_SHARDS; i++) {
+        struct pool_shard *shard =
+            &pool->shards[(self + i) & (POOL_SHARDS - 1)];
+
+        vlc_mutex_lock(&shard->lock);
+        picture_priv_t *priv =
+            vlc_list_first_entry_or_null(&shard->available_list,
+                                         picture_priv_t, pool_node);
+        if (priv != NULL)
+            vlc_list_remove(&priv->pool_node);
+        vlc_mutex_unlock(&shard->lock);
+
+        if (priv != NULL)
+            return priv;
+    }
+    return NULL;
+}
+
 static void picture_pool_Destroy(picture_pool_t *pool)
 {
     if (!vlc_atomic_rc_dec(&pool->refs))
         return;
 
     assert(vlc_list_is_empty(&pool->inuse_list));
-    assert(vlc_list_is_empty(&pool->available_list));
+    for (unsigned i = 0; i < POOL_SHARDS; i++)
+        assert(vlc_list_is_empty(&pool->shards[i].available_list));
 
     free(pool);
 }
@@ -66,9 +108,13 @@ void picture_pool_Release(picture_pool_t *pool)
     vlc_mutex_lock(&pool->lock);
 
     /* Release pictures from both available and in-use lists */
-    for (size_t i = 0; i < 2; ++i)
+    for (size_t i = 0; i < POOL_SHARDS + 1; ++i)
     {
-        struct vlc_list *list = i == 0 ? &pool->available_list : &pool->inuse_list;
+        struct vlc_list *list = i < POOL_SHARDS
+            ? &pool->shards[i].available_list : &pool->inuse_list;
+
+        if (i < POOL_SHARDS)
+            vlc_mutex_lock(&pool->shards[i].lock);
 
         picture_priv_t *priv;
         vlc_list_foreach(priv, list, pool_node)
@@ -77,6 +123,9 @@ void picture_pool_Release(picture_pool_t *pool)
             vlc_list_remove(&priv->pool_node);
             picture_Release(&priv->picture);
         }
+
+        if (i < POOL_SHARDS)
+            vlc_mutex_unlock(&pool->shards[i].lock);
     }
     /* Prevent in-use cloned pictures to be added back to lists */
     pool->released = true;
@@ -99,8 +148,12 @@ static void picture_pool_ReleaseClone(picture_t *clone)
 
     if (!pool->released)
     {
+        struct pool_shard *shard = &pool->shards[picture_pool_ShardSelf()];
+
         vlc_list_remove(&original_priv->pool_node);
-        vlc_list_append(&original_priv->pool_node, &pool->available_list);
+        vlc_mutex_lock(&shard->lock);
+        vlc_list_append(&original_priv->pool_node, &shard->available_list);
+        vlc_mutex_unlock(&shard->lock);
         vlc_cond_signal(&pool->wait);
     }
 
@@ -126,8 +179,12 @@ static picture_t *picture_pool_ClonePicture(picture_pool_t *pool,
 static void picture_pool_AppendPic(picture_pool_t *pool, picture_t *pic)
 {
     picture_priv_t *priv = container_of(pic, picture_priv_t, picture);
+    struct pool_shard *shard;
+
     assert(priv->pool == NULL);
-    vlc_list_append(&priv->pool_node, &pool->available_list);
+    /* Spread the initial pictures over the shards */
+    shard = &pool->shards[(pool->next_shard++) & (POOL_SHARDS - 1)];
+    vlc_list_append(&priv->pool_node, &shard->available_list);
     priv->pool = pool;
 }
 
@@ -140,7 +197,11 @@ picture_pool_NewCommon(void)
         return NULL;
 
     vlc_list_init(&pool->inuse_list);
-    vlc_list_init(&pool->available_list);
+    for (unsigned i = 0; i < POOL_SHARDS; i++) {
+        vlc_mutex_init(&pool->shards[i].lock);
+        vlc_list_init(&pool->shards[i].available_list);
+    }
+    pool->next_shard = 0;
 
     vlc_mutex_init(&pool->lock);
     vlc_cond_init(&pool->wait);
@@ -190,51 +251,43 @@ picture_pool_t *picture_pool_NewFromFormat(const video_format_t *fmt,
     return pool;
 }
 
-static picture_t *picture_pool_GetAvailableLocked(picture_pool_t *pool)
+static picture_t *picture_pool_MarkInUse(picture_pool_t *pool,
+                                         picture_priv_t *priv)
 {
-    picture_priv_t *priv = vlc_list_first_entry_or_null(&pool->available_list,
-                                                        picture_priv_t,
-                                                        pool_node);
-    assert(priv != NULL);
-
     assert(priv->pool == pool);
 
-    vlc_list_remove(&priv->pool_node);
+    vlc_mutex_lock(&pool->lock);
     vlc_list_append(&priv->pool_node, &pool->inuse_list);
+    vlc_mutex_unlock(&pool->lock);
 
     return &priv->picture;
 }
 
 picture_t *picture_pool_Get(picture_pool_t *pool)
 {
-
-    vlc_mutex_lock(&pool->lock);
     assert(vlc_atomic_rc_get(&pool->refs) > 0);
 
-    if (vlc_list_is_empty(&pool->available_list))
-    {
-        vlc_mutex_unlock(&pool->lock);
+    picture_priv_t *priv = picture_pool_PopAvailable(pool);
+    if (priv == NULL)
         return NULL;
-    }
-
-    picture_t *pic = picture_pool_GetAvailableLocked(pool);
 
-    vlc_mutex_unlock(&pool->lock);
+    picture_t *pic = picture_pool_MarkInUse(pool, priv);
 
     return picture_pool_ClonePicture(pool, pic);
 }
 
 picture_t *picture_pool_Wait(picture_pool_t *pool)
 {
-    vlc_mutex_lock(&pool->lock);
+    picture_priv_t *priv;
+
     assert(vlc_atomic_rc_get(&pool->refs) > 0);
 
-    while (vlc_list_is_empty(&pool->available_list))
+    vlc_mutex_lock(&pool->lock);
+    while ((priv = picture_pool_PopAvailable(pool)) == NULL)
         vlc_cond_wait(&pool->wait, &pool->lock);
-
-    picture_t *pic = picture_pool_GetAvailableLocked(pool);
-
     vlc_mutex_unlock(&pool->lock);
 
+    picture_t *pic = picture_pool_MarkInUse(pool, priv);
+
     return picture_pool_ClonePicture(pool, pic);
 }
@@ -531,3 +531,28 @@ void vlc_once_complete(vlc_once_t *restrict once)
             vlc_assert_unreachable();
     }
 }
+
+/*** Thread CPU core class ***/
+
+/* Restrict the calling thread to one class of an asymmetric (big.LITTLE)
+ * CPU: the performance cores for latency-critical work, the efficiency
+ * cores for the rest. No-op on symmetric systems. */
+void vlc_thread_SetCoreClass(vlc_object_t *obj, bool performance)
+{
+#ifdef __linux__
+    cpu_set_t big, little;
+
+    if (!vlc_CPU_LittleBig(&big, &little))
+        return;
+
+    const cpu_set_t *cpus = performance ? &big : &little;
+
+    if (sched_setaffinity(0, sizeof (*cpus), cpus) != 0)
+        msg_Warn(obj, "cannot set CPU affinity: %s", vlc_strerror_c(errno));
+    else
+        msg_Dbg(obj, "thread bound to %s cores",
+                performance ? "performance" : "efficiency");
+#else
+    (void) obj; (void) performance;
+#endif
+}
@@ -27,9 +27,6 @@
 # include "config.h"
 #endif
 
-#ifdef HAVE_SEARCH_H
-# include <search.h>
-#endif
 #include <assert.h>
 #include <float.h>
 #include <math.h>
@@ -67,7 +64,8 @@ typedef struct variable_ops_t
  */
 struct variable_t
 {
-    char *       psz_name; /**< The variable unique name (must be first) */
+    struct variable_t *next; /**< Next variable in the same hash bucket */
+    uint32_t     hash;     /**< Hash of the variable name */
 
     /** The variable's exported value */
     vlc_value_t  val;
@@ -98,6 +96,8 @@ struct variable_t
     callback_entry_t    *list_callbacks;
 
     vlc_cond_t   wait;
+
+    char         psz_name[]; /**< The variable unique name */
 };
 
 static int CmpBool( vlc_value_t v, vlc_value_t w )
@@ -138,23 +138,68 @@ int_ops    = { CmpInt,     DupDummy,  FreeDummy,  },
 string_ops = { CmpString,  DupString, FreeString, },
 coords_ops = { NULL,       DupDummy,  FreeDummy,  };
 
-static int varcmp( const void *a, const void *b )
+/* Initial number of hash buckets, must be a power of two */
+#define VAR_TABLE_SIZE_MIN 16
+
+static uint32_t VarHash( const char *psz_name )
 {
-    const variable_t *va = a, *vb = b;
+    uint32_t hash = 5381;
+
+    for( const unsigned char *p = (const unsigned char *)psz_name; *p; p++ )
+        hash = (hash * 33) ^ *p;
+    return hash;
+}
 
-    /* psz_name must be first */
-    assert( va == (const void *)&va->psz_name );
-    return strcmp( va->psz_name, vb->psz_name );
+static variable_t **VarBucket( vlc_object_internals_t *priv, uint32_t hash )
+{
+    return &priv->var_table[hash & (priv->var_size - 1)];
+}
+
+static variable_t *Find( vlc_object_internals_t *priv,
+                         const char *psz_name, uint32_t hash )
+{
+    if( priv->var_size == 0 )
+        return NULL;
+
+    variable_t *p_var = *VarBucket( priv, hash );
+    while( p_var != NULL
+        && ( p_var->hash != hash || strcmp( p_var->psz_name, psz_name ) ) )
+        p_var = p_var->next;
+    return p_var;
 }
 
 static variable_t *Lookup( vlc_object_t *obj, const char *psz_name )
 {
     vlc_object_internals_t *priv = vlc_internals( obj );
-    void **pp_var;
+    uint32_t hash = VarHash( psz_name );
 
     vlc_mutex_lock(&priv->var_lock);
-    pp_var = tfind( &psz_name, &priv->var_root, varcmp );
-    return (pp_var != NULL) ? *pp_var : NULL;
+    return Find( priv, psz_name, hash );
+}
+
+static void VarTableGrow( vlc_object_internals_t *priv )
+{
+    size_t newsize = (priv->var_size != 0) ? priv->var_size * 2
+                                           : VAR_TABLE_SIZE_MIN;
+    variable_t **newtab = calloc( newsize, sizeof (*newtab) );
+    if( unlikely(newtab == NULL) )
+        return; /* keep the current (denser) table */
+
+    for( size_t i = 0; i < priv->var_size; i++ )
+    {
+        for( variable_t *p_var = priv->var_table[i], *p_next;
+             p_var != NULL; p_var = p_next )
+        {
+            variable_t **pp_bucket = &newtab[p_var->hash & (newsize - 1)];
+
+            p_next = p_var->next;
+            p_var->next = *pp_bucket;
+            *pp_bucket = p_var;
+        }
+    }
+    free( priv->var_table );
+    priv->var_table = newtab;
+    priv->var_size = newsize;
 }
 
 static void Destroy( variable_t *p_var )
@@ -169,7 +214,6 @@ static void Destroy( variable_t *p_var )
     free(p_var->choices);
     free(p_var->choices_text);
 
-    free( p_var->psz_name );
     free( p_var->psz_text );
     while (unlikely(p_var->value_callbacks != NULL))
     {
@@ -232,6 +276,37 @@ static void WaitUnused(vlc_object_t *obj, variable_t *var)
         vlc_cond_wait(&var->wait, &priv->var_lock);
 }
 
+/* Number of callbacks dispatched from the stack in one batch */
+#define VAR_CB_BATCH 8
+
+/**
+ * Snapshots the registered callbacks into a dense local array while the lock
+ * is still held, so dispatch does not chase the shared list with the lock
+ * released. The list itself cannot change while b_incallback is set.
+ */
+static size_t BatchCallbacks(const callback_entry_t *entry,
+                             callback_entry_t *batch, size_t max,
+                             callback_entry_t **restrict table)
+{
+    size_t count = 0;
+
+    for (const callback_entry_t *e = entry; e != NULL; e = e->next)
+        count++;
+
+    *table = batch;
+    if (count > max)
+    {
+        *table = vlc_alloc(count, sizeof (**table));
+        if (unlikely(*table == NULL))
+            return 0; /* fall back to walking the list */
+    }
+
+    size_t i = 0;
+    for (const callback_entry_t *e = entry; e != NULL; e = e->next)
+        (*table)[i++] = *e;
+    return count;
+}
+
 static void TriggerCallback(vlc_object_t *obj, variable_t *var,
                             const char *name, vlc_value_t prev)
 {
@@ -241,13 +316,20 @@ static void TriggerCallback(vlc_object_t *obj, variable_t *var,
     if (entry == NULL)
         return;
 
+    callback_entry_t batch[VAR_CB_BATCH], *table;
+    size_t count = BatchCallbacks(entry, batch, ARRAY_SIZE(batch), &table);
+
     vlc_object_internals_t *priv = vlc_internals(obj);
 
     assert(!var->b_incallback);
     var->b_incallback = true;
     vlc_mutex_unlock(&priv->var_lock);
 
-    do
+    if (likely(count > 0))
+        for (size_t i = 0; i < count; i++)
+            table[i].pf_value_callback(obj, name, prev, var->val,
+                                       table[i].p_data);
+    else do
     {
         entry->pf_value_callback(obj, name, prev, var->val, entry->p_data);
         entry = entry->next;
@@ -257,6 +339,9 @@ static void TriggerCallback(vlc_object_t *obj, variable_t *var,
     vlc_mutex_lock(&priv->var_lock);
     var->b_incallback = false;
     vlc_cond_broadcast(&var->wait);
+
+    if (table != batch)
+        free(table);
 }
 
 static void TriggerListCallback(vlc_object_t *obj, variable_t *var,
@@ -268,13 +353,19 @@ static void TriggerListCallback(vlc_object_t *obj, variable_t *var,
     if (entry == NULL)
         return;
 
+    callback_entry_t batch[VAR_CB_BATCH], *table;
+    size_t count = BatchCallbacks(entry, batch, ARRAY_SIZE(batch), &table);
+
     vlc_object_internals_t *priv = vlc_internals(obj);
 
     assert(!var->b_incallback);
     var->b_incallback = true;
     vlc_mutex_unlock(&priv->var_lock);
 
-    do
+    if (likely(count > 0))
+        for (size_t i = 0; i < count; i++)
+            table[i].pf_list_callback(obj, name, action, val, table[i].p_data);
+    else do
     {
         entry->pf_list_callback(obj, name, action, val, entry->p_data);
         entry = entry->next;
@@ -284,17 +375,21 @@ static void TriggerListCallback(vlc_object_t *obj, variable_t *var,
     vlc_mutex_lock(&priv->var_lock);
     var->b_incallback = false;
     vlc_cond_broadcast(&var->wait);
+
+    if (table != batch)
+        free(table);
 }
 
 int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
 {
     assert( p_this );
 
-    variable_t *p_var = calloc( 1, sizeof( *p_var ) );
+    variable_t *p_var = calloc( 1, sizeof( *p_var ) + strlen( psz_name ) + 1 );
     if( p_var == NULL )
         return VLC_ENOMEM;
 
-    p_var->psz_name = strdup( psz_name );
+    strcpy( p_var->psz_name, psz_name );
+    p_var->hash = VarHash( psz_name );
     p_var->psz_text = NULL;
 
     p_var->i_type = i_type & ~VLC_VAR_DOINHERIT;
@@ -354,23 +449,34 @@ int (var_Create)( vlc_object_t *p_this, const char *psz_name, int i_type )
         var_Inherit(p_this, psz_name, i_type, &p_var->val);
 
     vlc_object_internals_t *p_priv = vlc_internals( p_this );
-    void **pp_var;
     variable_t *p_oldvar;
     int ret = VLC_SUCCESS;
 
     vlc_mutex_lock( &p_priv->var_lock );
 
-    pp_var = tsearch( p_var, &p_priv->var_root, varcmp );
-    if( unlikely(pp_var == NULL) )
-        ret = VLC_ENOMEM;
-    else if( (p_oldvar = *pp_var) == p_var ) /* Variable create */
-        p_var = NULL; /* Variable created */
-    else /* Variable already exists */
+    p_oldvar = Find( p_priv, psz_name, p_var->hash );
+    if( p_oldvar != NULL ) /* Variable already exists */
     {
         assert (((i_type ^ p_oldvar->i_type) & VLC_VAR_CLASS) == 0);
         p_oldvar->i_usage++;
         p_oldvar->i_type |= i_type & VLC_VAR_ISCOMMAND;
     }
+    else
+    {
+        if( p_priv->var_count >= p_priv->var_size )
+            VarTableGrow( p_priv );
+        if( unlikely(p_priv->var_size == 0) )
+            ret = VLC_ENOMEM;
+        else /* Variable created */
+        {
+            variable_t **pp_bucket = VarBucket( p_priv, p_var->hash );
+
+            p_var->next = *pp_bucket;
+            *pp_bucket = p_var;
+            p_priv->var_count++;
+            p_var = NULL;
+        }
+    }
     vlc_mutex_unlock( &p_priv->var_lock );
 
     /* If we did not need to create a new variable, free everything... */
@@ -394,7 +500,12 @@ void (var_Destroy)(vlc_object_t *p_this, const char *psz_name)
     else if( --p_var->i_usage == 0 )
     {
         assert(!p_var->b_incallback);
-        tdelete( p_var, &p_priv->var_root, varcmp );
+
+        variable_t **pp_var = VarBucket( p_priv, p_var->hash );
+        while( *pp_var != p_var )
+            pp_var = &(*pp_var)->next;
+        *pp_var = p_var->next;
+        p_priv->var_count--;
     }
     else
     {
@@ -407,17 +518,23 @@ void (var_Destroy)(vlc_object_t *p_this, const char *psz_name)
         Destroy( p_var );
 }
 
-static void CleanupVar( void *var )
-{
-    Destroy( var );
-}
-
 void var_DestroyAll( vlc_object_t *obj )
 {
     vlc_object_internals_t *priv = vlc_internals( obj );
 
-    tdestroy( priv->var_root, CleanupVar );
-    priv->var_root = NULL;
+    for( size_t i = 0; i < priv->var_size; i++ )
+    {
+        for( variable_t *p_var = priv->var_table[i], *p_next;
+             p_var != NULL; p_var = p_next )
+        {
+            p_next = p_var->next;
+            Destroy( p_var );
+        }
+    }
+    free( priv->var_table );
+    priv->var_table = NULL;
+    priv->var_count = 0;
+    priv->var_size = 0;
 }
 
 int (var_Change)(vlc_object_t *p_this, const char *psz_name, int i_action, ...)
@@ -1135,21 +1252,6 @@ error:
     return VLC_EGENERIC;
 }
 
-static thread_local void *twalk_ctx;
-
-static void TwalkGetNames(const void *data, const VISIT which, const int depth)
-{
-    if (which != postorder && which != leaf)
-        return;
-    (void) depth;
-
-    const variable_t *var = *(const variable_t **)data;
-    DECL_ARRAY(char *) *names = twalk_ctx;
-    char *dup = strdup(var->psz_name);
-    if (dup != NULL)
-        ARRAY_APPEND(*names, dup);
-}
-
 char **var_GetAllNames(vlc_object_t *obj)
 {
     vlc_object_internals_t *priv = vlc_internals(obj);
@@ -1157,9 +1259,15 @@ char **var_GetAllNames(vlc_object_t *obj)
     DECL_ARRAY(char *) names;
     ARRAY_INIT(names);
 
-    twalk_ctx = &names;
     vlc_mutex_lock(&priv->var_lock);
-    twalk(priv->var_root, TwalkGetNames);
+    for (size_t i = 0; i < priv->var_size; i++)
+        for (const variable_t *var = priv->var_table[i]; var != NULL;
+             var = var->next)
+        {
+            char *dup = strdup(var->psz_name);
+            if (dup != NULL)
+                ARRAY_APPEND(names, dup);
+        }
     vlc_mutex_unlock(&priv->var_lock);
 
     if (names.i_size == 0)
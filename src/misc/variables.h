@@ -26,6 +26,7 @@
 # include <vlc_list.h>
 
 struct vlc_res;
+struct variable_t;
 
 /**
  * Private LibVLC data for each object.
@@ -38,7 +39,9 @@ struct vlc_object_internals
     const char *typename; /**< Object type human-readable name */
 
     /* Object variables */
-    void           *var_root;
+    struct variable_t **var_table; /**< Hash table of variables */
+    size_t          var_count;     /**< Number of variables */
+    size_t          var_size;      /**< Number of hash buckets */
     vlc_mutex_t     var_lock;
 
     /* Object resources */
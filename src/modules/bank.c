@@ -47,6 +47,7 @@
 #include <vlc_block.h>
 #include "libvlc.h"
 #include "config/configuration.h"
+#include "misc/rcu.h"
 #include "modules/modules.h"
 
 /** Core module */
@@ -94,14 +95,87 @@ static void vlc_modcap_sort(const void *node, const VISIT which,
     (void) depth;
 }
 
+/**
+ * Interned capability table.
+ *
+ * Open-addressed hash table over the distinct capability names, built once
+ * the bank is fully loaded and published via RCU. A capability lookup costs
+ * one hash and normally a single string compare, where the search tree costs
+ * one compare per level — and filter chains re-probe their capabilities on
+ * every format change.
+ */
+struct vlc_caps_table
+{
+    size_t size; /**< Power of two slot count */
+    const vlc_modcap_t *tab[]; /**< NULL = empty slot */
+};
+
+static size_t vlc_cap_hash(const char *name)
+{
+    /* FNV-1a */
+    size_t h = 2166136261u;
+
+    for (const unsigned char *p = (const unsigned char *)name; *p != '\0'; p++)
+        h = (h ^ *p) * 16777619u;
+    return h;
+}
+
 static struct
 {
     vlc_mutex_t lock;
     block_t *caches;
     void *caps_tree;
+    size_t caps_count; /**< Number of distinct capabilities in the tree */
+    /** RCU-published capability table built from \ref caps_tree */
+    struct vlc_caps_table *_Atomic caps;
     size_t count;
     unsigned usage;
-} modules = { VLC_STATIC_MUTEX, NULL, NULL, 0, 0 };
+} modules = { VLC_STATIC_MUTEX, NULL, NULL, 0, NULL, 0, 0 };
+
+/** Table under construction by vlc_caps_table_insert() (twalk() carries no
+ * user data; the bank lock is held while building) */
+static struct vlc_caps_table *caps_table_build;
+
+static void vlc_caps_table_insert(const void *node, const VISIT which,
+                                  const int depth)
+{
+    const vlc_modcap_t *const *cp = node, *cap = *cp;
+    struct vlc_caps_table *table = caps_table_build;
+
+    if (which != postorder && which != leaf)
+        return;
+
+    size_t i = vlc_cap_hash(cap->name) & (table->size - 1);
+
+    while (table->tab[i] != NULL)
+        i = (i + 1) & (table->size - 1);
+    table->tab[i] = cap;
+    (void) depth;
+}
+
+static struct vlc_caps_table *vlc_caps_table_create(void)
+{
+    vlc_mutex_assert(&modules.lock);
+
+    /* Keep the load factor at or below 50% so probe chains stay short */
+    size_t size = 16;
+    while (size < 2 * modules.caps_count)
+        size *= 2;
+
+    struct vlc_caps_table *table = malloc(sizeof (*table)
+                                          + size * sizeof (table->tab[0]));
+    if (unlikely(table == NULL))
+        return NULL;
+
+    table->size = size;
+    for (size_t i = 0; i < size; i++)
+        table->tab[i] = NULL;
+
+    caps_table_build = table;
+    twalk(modules.caps_tree, vlc_caps_table_insert);
+    caps_table_build = NULL;
+    return table;
+}
 
 vlc_plugin_t *vlc_plugins = NULL;
 
@@ -131,6 +205,8 @@ static int vlc_module_store(module_t *mod)
         vlc_modcap_free(cap);
         cap = *cp;
     }
+    else
+        modules.caps_count++;
 
     module_t **modv = realloc(cap->modv, sizeof (*modv) * (cap->modc + 1));
     if (unlikely(modv == NULL))
@@ -758,6 +834,7 @@ void module_EndBank (bool b_plugins)
     vlc_plugin_t *libs = NULL;
     block_t *caches = NULL;
     void *caps_tree = NULL;
+    struct vlc_caps_table *caps_table = NULL;
 
     /* If plugins were _not_ loaded, then the caller still has the bank lock
      * from module_InitBank(). */
@@ -769,19 +846,33 @@ void module_EndBank (bool b_plugins)
     assert (modules.usage > 0);
     if (--modules.usage == 0)
     {
+        config_InvalidateFileStamp ();
         config_UnsortConfig ();
         libs = vlc_plugins;
         caches = modules.caches;
         caps_tree = modules.caps_tree;
+        caps_table = atomic_load_explicit(&modules.caps, memory_order_relaxed);
         vlc_plugins = NULL;
         modules.caches = NULL;
         modules.caps_tree = NULL;
+        modules.caps_count = 0;
+        atomic_store_explicit(&modules.caps, NULL, memory_order_relaxed);
         modules.count = 0;
     }
     vlc_mutex_unlock (&modules.lock);
 
+    if (caps_table != NULL)
+        /* Wait for lock-free lookups of the capability table to complete */
+        vlc_rcu_synchronize();
+
+    free(caps_table);
     tdestroy(caps_tree, vlc_modcap_free);
 
+    if (libs != NULL)
+        /* The learned probe priors only make sense for the plug-in set
+         * that was just unloaded */
+        module_ClearPriors();
+
     while (libs != NULL)
     {
         vlc_plugin_t *lib = libs;
@@ -815,6 +906,13 @@ void module_LoadPlugins(libvlc_int_t *obj)
         config_SortConfig ();
 
         twalk(modules.caps_tree, vlc_modcap_sort);
+
+        /* Publish the (now read-only) capability table for lock-free
+         * lookups. On allocation failure the table stays unpublished and
+         * lookups simply find no modules, as with an empty bank. */
+        struct vlc_caps_table *table = vlc_caps_table_create();
+        if (likely(table != NULL))
+            atomic_store_explicit(&modules.caps, table, memory_order_release);
     }
     vlc_mutex_unlock (&modules.lock);
 
@@ -852,20 +950,25 @@ module_t **module_list_get (size_t *n)
 
 size_t module_list_cap(module_t *const **restrict list, const char *name)
 {
-    vlc_modcap_t key;
+    const struct vlc_caps_table *table =
+        atomic_load_explicit(&modules.caps, memory_order_acquire);
 
+    assert(vlc_rcu_read_held());
     assert(name != NULL);
-    key.name = (char *)name;
 
-    const void **cp = tfind(&key, &modules.caps_tree, vlc_modcap_cmp);
-    if (cp == NULL)
+    if (table != NULL)
     {
-        *list = NULL;
-        return 0;
-    }
+        size_t i = vlc_cap_hash(name) & (table->size - 1);
 
-    const vlc_modcap_t *cap = *cp;
+        for (const vlc_modcap_t *cap; (cap = table->tab[i]) != NULL;
+             i = (i + 1) & (table->size - 1))
+            if (strcmp(cap->name, name) == 0)
+            {
+                *list = cap->modv;
+                return cap->modc;
+            }
+    }
 
-    *list = cap->modv;
-    return cap->modc;
+    *list = NULL;
+    return 0;
 }
@@ -205,12 +205,13 @@ static int vlc_cache_load_config(struct vlc_param *param, block_t *file)
 
         if (cfg->list_count)
             cfg->list.psz = xmalloc (cfg->list_count * sizeof (char *));
+        else
+            cfg->list.psz = NULL;
         for (unsigned i = 0; i < cfg->list_count; i++)
         {
             LOAD_STRING (cfg->list.psz[i]);
-            if (cfg->list.psz[i] == NULL /* NULL -> empty string */
-             && (cfg->list.psz[i] = calloc (1, 1)) == NULL)
-                goto error;
+            if (cfg->list.psz[i] == NULL) /* NULL -> empty string */
+                cfg->list.psz[i] = (char *)"";
         }
     }
     else
@@ -234,13 +235,15 @@ static int vlc_cache_load_config(struct vlc_param *param, block_t *file)
         LOAD_ARRAY(cfg->list.i, cfg->list_count);
     }
 
-    cfg->list_text = xmalloc (cfg->list_count * sizeof (char *));
+    if (cfg->list_count)
+        cfg->list_text = xmalloc (cfg->list_count * sizeof (char *));
+    else
+        cfg->list_text = NULL;
     for (unsigned i = 0; i < cfg->list_count; i++)
     {
         LOAD_STRING (cfg->list_text[i]);
-        if (cfg->list_text[i] == NULL /* NULL -> empty string */
-         && (cfg->list_text[i] = calloc (1, 1)) == NULL)
-            goto error;
+        if (cfg->list_text[i] == NULL) /* NULL -> empty string */
+            cfg->list_text[i] = (char *)"";
     }
 
     return 0;
@@ -307,13 +310,15 @@ static int vlc_cache_load_module(vlc_plugin_t *plugin, block_t *file)
     LOAD_IMMEDIATE(module->i_shortcuts);
     if (module->i_shortcuts > MODULE_SHORTCUT_MAX)
         goto error;
-    else
+    else if (module->i_shortcuts > 0)
     {
         module->pp_shortcuts =
             xmalloc (sizeof (*module->pp_shortcuts) * module->i_shortcuts);
         for (unsigned j = 0; j < module->i_shortcuts; j++)
             LOAD_STRING(module->pp_shortcuts[j]);
     }
+    else
+        module->pp_shortcuts = NULL;
 
     LOAD_STRING(module->activate_name);
     LOAD_STRING(module->deactivate_name);
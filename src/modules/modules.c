@@ -40,6 +40,7 @@
 #include "libvlc.h"
 #include "config/configuration.h"
 #include "vlc_arrays.h"
+#include "misc/rcu.h"
 #include "modules/modules.h"
 
 bool module_provides (const module_t *m, const char *cap)
@@ -97,6 +98,95 @@ const char *module_gettext (const module_t *m, const char *str)
 #endif
 }
 
+/*****************************************************************************
+ * Probe priors: per-capability hit counts of modules that won earlier
+ * probes. On most set-ups, the same few modules win nearly every probe,
+ * so trying the historical winners first cuts the average probe walk.
+ *****************************************************************************/
+struct module_prior
+{
+    char *name; /**< Module object name (not owned by the plug-in) */
+    unsigned hits; /**< Number of successful probes */
+};
+
+struct module_prior_list
+{
+    struct module_prior *tab;
+    size_t count;
+};
+
+static vlc_mutex_t priors_lock = VLC_STATIC_MUTEX;
+static vlc_dictionary_t priors = { 0, NULL }; /**< Keyed by capability */
+
+static unsigned module_PriorHits(const struct module_prior_list *list,
+                                 const module_t *m)
+{
+    const char *name = module_get_object(m);
+
+    for (size_t i = 0; i < list->count; i++)
+        if (strcmp(list->tab[i].name, name) == 0)
+            return list->tab[i].hits;
+    return 0;
+}
+
+static void module_RecordWin(const char *capability, module_t *module)
+{
+    const char *name = module_get_object(module);
+
+    vlc_mutex_lock(&priors_lock);
+
+    struct module_prior_list *list =
+        vlc_dictionary_value_for_key(&priors, capability);
+    if (list == kVLCDictionaryNotFound)
+    {
+        list = malloc(sizeof (*list));
+        if (unlikely(list == NULL))
+            goto out;
+        list->tab = NULL;
+        list->count = 0;
+        vlc_dictionary_insert(&priors, capability, list);
+    }
+
+    for (size_t i = 0; i < list->count; i++)
+        if (strcmp(list->tab[i].name, name) == 0)
+        {
+            list->tab[i].hits++;
+            goto out;
+        }
+
+    struct module_prior *tab = vlc_reallocarray(list->tab, list->count + 1,
+                                                sizeof (*tab));
+    if (unlikely(tab == NULL))
+        goto out;
+    list->tab = tab;
+    tab[list->count].name = strdup(name);
+    if (likely(tab[list->count].name != NULL))
+    {
+        tab[list->count].hits = 1;
+        list->count++;
+    }
+out:
+    vlc_mutex_unlock(&priors_lock);
+}
+
+static void module_PriorListFree(void *value, void *data)
+{
+    struct module_prior_list *list = value;
+
+    for (size_t i = 0; i < list->count; i++)
+        free(list->tab[i].name);
+    free(list->tab);
+    free(list);
+    (void) data;
+}
+
+void module_ClearPriors(void)
+{
+    vlc_mutex_lock(&priors_lock);
+    vlc_dictionary_clear(&priors, module_PriorListFree, NULL);
+    vlc_mutex_unlock(&priors_lock);
+}
+
 static bool module_match_name(const module_t *m, const char *name, size_t len)
 {
      for (size_t i = 0; i < m->i_shortcuts; i++)
@@ -112,6 +202,9 @@ ssize_t vlc_module_match(const char *capability, const char *names,
                          size_t *restrict strict_matches)
 {
     module_t *const *tab;
+
+    vlc_rcu_read_lock();
+
     size_t total = module_list_cap(&tab, capability);
     module_t **unsorted = malloc(total * sizeof (*unsorted));
     module_t **sorted = malloc(total * sizeof (*sorted));
@@ -119,6 +212,7 @@ ssize_t vlc_module_match(const char *capability, const char *names,
 
     if (total > 0) {
         if (unlikely(unsorted == NULL || sorted == NULL)) {
+            vlc_rcu_read_unlock();
             free(unsorted);
             free(sorted);
             *modules = NULL;
@@ -127,6 +221,11 @@ ssize_t vlc_module_match(const char *capability, const char *names,
         memcpy(unsorted, tab, total * sizeof (*unsorted));
     }
 
+    /* The modules themselves are owned by the plug-ins, whose lifetime is
+     * covered by the bank usage count, so only the candidate table copy
+     * needs to happen within the read-side critical section. */
+    vlc_rcu_read_unlock();
+
     *modules = sorted;
 
     /* Go through the list of module shortcut names. */
@@ -166,6 +265,8 @@ ssize_t vlc_module_match(const char *capability, const char *names,
         *strict_matches = matches;
 
     if (!strict) {
+        size_t base = matches;
+
         /* List remaining modules with strictly positive score. */
         for (size_t i = 0; i < total; i++) {
             module_t *cand = unsorted[i];
@@ -181,6 +282,29 @@ ssize_t vlc_module_match(const char *capability, const char *names,
                 sorted[matches++] = cand;
             }
         }
+
+        /* Try historical winners first. The sort is stable, so candidates
+         * without recorded wins keep their static score order and the
+         * fallback behaviour is unchanged. Name matches above are not
+         * reordered: an explicit request takes precedence over history. */
+        vlc_mutex_lock(&priors_lock);
+
+        const struct module_prior_list *list =
+            vlc_dictionary_value_for_key(&priors, capability);
+        if (list != kVLCDictionaryNotFound && matches > base + 1) {
+            for (size_t i = base + 1; i < matches; i++) {
+                module_t *cand = sorted[i];
+                unsigned hits = module_PriorHits(list, cand);
+                size_t j = i;
+
+                while (j > base && module_PriorHits(list, sorted[j - 1]) < hits) {
+                    sorted[j] = sorted[j - 1];
+                    j--;
+                }
+                sorted[j] = cand;
+            }
+        }
+        vlc_mutex_unlock(&priors_lock);
     }
 
     free(unsorted);
@@ -235,6 +359,7 @@ module_t *(vlc_module_load)(struct vlc_logger *log, const char *capability,
                 vlc_debug(log, "using %s module \"%s\"", capability,
                           module_get_object(cand));
                 module = cand;
+                module_RecordWin(capability, cand);
                 /* fall through */
             case VLC_ETIMEOUT:
                 goto done;
@@ -111,6 +111,7 @@ int vlc_plugin_resolve(vlc_plugin_t *, vlc_plugin_cb);
 void module_InitBank (void);
 void module_LoadPlugins(libvlc_int_t *);
 void module_EndBank (bool);
+void module_ClearPriors (void);
 int vlc_plugin_Map(struct vlc_logger *, vlc_plugin_t *);
 void *vlc_plugin_Symbol(struct vlc_logger *, vlc_plugin_t *, const char *name);
 
@@ -124,6 +125,10 @@ void *vlc_plugin_Symbol(struct vlc_logger *, vlc_plugin_t *, const char *name);
  * \note This function cannot fail. It returns zero if, and only if, no
  * modules match the requested capability inside the module bank.
  *
+ * \note The caller must be within an RCU read-side critical section
+ * (see \ref vlc_rcu_read_lock()); the returned table is only valid until
+ * the critical section ends.
+ *
  * @param tab pointer to the table of modules [OUT]
  * @param name capability nul-terminated string (cannot be NULL)
  * @return the number of entries in the table
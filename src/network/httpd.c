@@ -149,6 +149,9 @@ struct httpd_client_t
     bool    b_stream_mode;
     uint8_t i_state;
 
+    int     i_pollfd; /**< index in the poll set, or -1 */
+    short   i_revents; /**< events returned by the last poll() */
+
     vlc_tick_t i_timeout_date;
 
     /* buffer for reading header */
@@ -1270,6 +1273,8 @@ static httpd_client_t *httpd_ClientNew(vlc_tls_t *sock)
     cl->p_buffer = xmalloc(cl->i_buffer_size);
     cl->i_keyframe_wait_to_pass = -1;
     cl->b_stream_mode = false;
+    cl->i_pollfd = -1;
+    cl->i_revents = 0;
 
     httpd_MsgInit(&cl->query);
     httpd_MsgInit(&cl->answer);
@@ -1635,8 +1640,21 @@ static int httpd_ClientSend(httpd_client_t *cl)
         cl->i_buffer_size = (uint8_t*)p - cl->p_buffer;
     }
 
-    i_len = httpd_NetSend(cl, &cl->p_buffer[cl->i_buffer],
-                           cl->i_buffer_size - cl->i_buffer);
+    /* Coalesce the header with the body (when already known) in a single
+     * send, saving a syscall and a poll round-trip per answer */
+    struct iovec iov[2] = {
+        { .iov_base = &cl->p_buffer[cl->i_buffer],
+          .iov_len = cl->i_buffer_size - cl->i_buffer },
+    };
+    int iovcnt = 1;
+
+    if (cl->answer.i_body > 0) {
+        iov[1].iov_base = cl->answer.p_body;
+        iov[1].iov_len = cl->answer.i_body;
+        iovcnt++;
+    }
+
+    i_len = cl->sock->ops->writev(cl->sock, iov, iovcnt);
 
     if (i_len < 0) {
 #if defined(_WIN32)
@@ -1665,14 +1683,20 @@ static int httpd_ClientSend(httpd_client_t *cl)
         }
 
         if (cl->answer.i_body != 0) {
-            /* send the body data */
+            /* send the body data; part of it may already have gone out
+             * with the header above */
+            int i_sent = cl->i_buffer - cl->i_buffer_size;
+
             free(cl->p_buffer);
             cl->p_buffer = cl->answer.p_body;
             cl->i_buffer_size = cl->answer.i_body;
-            cl->i_buffer = 0;
+            cl->i_buffer = i_sent;
 
             cl->answer.i_body = 0;
             cl->answer.p_body = NULL;
+
+            if (cl->i_buffer >= cl->i_buffer_size)
+                cl->i_state = HTTPD_CLIENT_SEND_DONE;
         } else /* send finished */
             cl->i_state = HTTPD_CLIENT_SEND_DONE;
     }
@@ -1746,16 +1770,24 @@ static void httpdLoop(httpd_host_t *host)
     int delay = -1;
     httpd_client_t *cl;
 
+    /* TLS sessions may hold decrypted data in their own buffers, so their
+     * I/O cannot be driven by socket readiness alone */
+    const bool b_event_driven = host->p_tls == NULL;
+
     int canc = vlc_savecancel();
     vlc_list_foreach(cl, &host->clients, node) {
         int val = -1;
 
         switch (cl->i_state) {
             case HTTPD_CLIENT_RECEIVING:
-                val = httpd_ClientRecv(cl);
+                if (!b_event_driven ||
+                    (cl->i_revents & (POLLIN|POLLERR|POLLHUP)))
+                    val = httpd_ClientRecv(cl);
                 break;
             case HTTPD_CLIENT_SENDING:
-                val = httpd_ClientSend(cl);
+                if (!b_event_driven ||
+                    (cl->i_revents & (POLLOUT|POLLERR|POLLHUP)))
+                    val = httpd_ClientSend(cl);
                 break;
             case HTTPD_CLIENT_TLS_HS_IN:
             case HTTPD_CLIENT_TLS_HS_OUT:
@@ -2000,10 +2032,14 @@ static void httpdLoop(httpd_host_t *host)
         pufd->fd = vlc_tls_GetPollFD(cl->sock, &pufd->events);
 
         if (pufd->events != 0)
-            nfd++;
-        /* we will wait 20ms (not too big) if HTTPD_CLIENT_WAITING */
-        else if (delay != 0)
-            delay = 20;
+            cl->i_pollfd = nfd++;
+        else
+        {
+            cl->i_pollfd = -1;
+            /* we will wait 20ms (not too big) if HTTPD_CLIENT_WAITING */
+            if (delay != 0)
+                delay = 20;
+        }
     }
     vlc_mutex_unlock(&host->lock);
     vlc_restorecancel(canc);
@@ -2017,61 +2053,66 @@ static void httpdLoop(httpd_host_t *host)
     canc = vlc_savecancel();
     vlc_mutex_lock(&host->lock);
 
+    /* Hand the poll results over to the next pass; the client list cannot
+     * have changed as only this thread adds and removes clients */
+    vlc_list_foreach(cl, &host->clients, node)
+        cl->i_revents = (cl->i_pollfd >= 0) ? ufd[cl->i_pollfd].revents : 0;
+
     /* Handle client sockets */
     now = vlc_tick_now();
     nfd = host->nfd;
 
     /* Handle server sockets (accept new connections) */
     for (nfd = 0; nfd < host->nfd; nfd++) {
-        int fd = ufd[nfd].fd;
-
-        assert (fd == host->fds[nfd]);
+        assert (ufd[nfd].fd == host->fds[nfd]);
 
         if (ufd[nfd].revents == 0)
             continue;
 
-        /* */
-        fd = vlc_accept (fd, NULL, NULL, true);
-        if (fd == -1)
-            continue;
-        setsockopt (fd, SOL_SOCKET, SO_REUSEADDR,
-                &(int){ 1 }, sizeof(int));
+        /* Drain the whole backlog, not one connection per pass */
+        for (;;) {
+            int fd = vlc_accept (host->fds[nfd], NULL, NULL, true);
+            if (fd == -1)
+                break;
+            setsockopt (fd, SOL_SOCKET, SO_REUSEADDR,
+                    &(int){ 1 }, sizeof(int));
 
-        vlc_tls_t *sk = vlc_tls_SocketOpen(fd);
-        if (unlikely(sk == NULL))
-        {
-            vlc_close(fd);
-            continue;
-        }
+            vlc_tls_t *sk = vlc_tls_SocketOpen(fd);
+            if (unlikely(sk == NULL))
+            {
+                vlc_close(fd);
+                continue;
+            }
 
-        if (host->p_tls != NULL)
-        {
-            const char *alpn[] = { "http/1.1", NULL };
-            vlc_tls_t *tls;
+            if (host->p_tls != NULL)
+            {
+                const char *alpn[] = { "http/1.1", NULL };
+                vlc_tls_t *tls;
+
+                tls = vlc_tls_ServerSessionCreate(host->p_tls, sk, alpn);
+                if (tls == NULL)
+                {
+                    vlc_tls_SessionDelete(sk);
+                    continue;
+                }
+                sk = tls;
+            }
+
+            cl = httpd_ClientNew(sk);
 
-            tls = vlc_tls_ServerSessionCreate(host->p_tls, sk, alpn);
-            if (tls == NULL)
+            if (unlikely(cl == NULL))
             {
-                vlc_tls_SessionDelete(sk);
+                vlc_tls_Close(sk);
                 continue;
             }
-            sk = tls;
-        }
 
-        cl = httpd_ClientNew(sk);
+            if (host->p_tls != NULL)
+                cl->i_state = HTTPD_CLIENT_TLS_HS_OUT;
 
-        if (unlikely(cl == NULL))
-        {
-            vlc_tls_Close(sk);
-            continue;
+            cl->i_timeout_date = now + VLC_TICK_FROM_SEC(host->timeout_sec);
+            host->client_count++;
+            vlc_list_append(&cl->node, &host->clients);
         }
-
-        if (host->p_tls != NULL)
-            cl->i_state = HTTPD_CLIENT_TLS_HS_OUT;
-
-        cl->i_timeout_date = now + VLC_TICK_FROM_SEC(host->timeout_sec);
-        host->client_count++;
-        vlc_list_append(&cl->node, &host->clients);
     }
 
     vlc_mutex_unlock(&host->lock);
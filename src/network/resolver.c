@@ -0,0 +1,310 @@
+/*****************************************************************************
+ * resolver.c: cached host name resolution
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <vlc_common.h>
+#include <vlc_threads.h>
+#include <vlc_tick.h>
+#include <vlc_network.h>
+#include <vlc_configuration.h>
+
+/**
+ * \file
+ * Process-wide cache on top of vlc_getaddrinfo_i11e().
+ *
+ * Zapping between streams on the same server resolves the same few host
+ * names over and over, and each resolution can stall connection setup for
+ * hundreds of milliseconds. getaddrinfo() does not expose the DNS record
+ * TTL, so a single configurable lifetime (--dns-cache-ttl) is applied to
+ * all entries instead; concurrent lookups for the same name share one
+ * resolution.
+ *
+ * Cached lists are returned as private deep copies: passing them to
+ * freeaddrinfo() would be undefined, hence the vlc_resolver_Free()
+ * counterpart.
+ */
+
+struct resolver_entry
+{
+    struct resolver_entry *next;
+    int family;
+    int socktype;
+    int protocol;
+    int flags;
+    struct addrinfo *list; /* single-block copy, ports cleared */
+    vlc_tick_t expiry;
+    bool resolving;
+    char host[];
+};
+
+static struct
+{
+    struct resolver_entry *entries;
+    unsigned count;
+} cache;
+
+static vlc_mutex_t lock = VLC_STATIC_MUTEX;
+static vlc_cond_t resolved_wait = VLC_STATIC_COND;
+
+#define RESOLVER_CACHE_MAX 64
+
+/**
+ * Deep-copies an addrinfo list into a single heap block.
+ *
+ * The copy carries no canonical name and its socket addresses all get
+ * \p port as port number (in particular zero to normalize a list for
+ * caching). It can be freed with a plain free(), which is what
+ * vlc_resolver_Free() does.
+ */
+static struct addrinfo *resolver_CopyList(const struct addrinfo *src,
+                                          unsigned port)
+{
+    size_t n = 0;
+
+    for (const struct addrinfo *p = src; p != NULL; p = p->ai_next)
+        n++;
+    assert(n > 0);
+
+    struct addrinfo *ai = malloc(n * sizeof (*ai)
+                                 + n * sizeof (struct sockaddr_storage));
+    if (unlikely(ai == NULL))
+        return NULL;
+
+    struct sockaddr_storage *addrs = (struct sockaddr_storage *)(ai + n);
+    size_t i = 0;
+
+    for (const struct addrinfo *p = src; p != NULL; p = p->ai_next, i++)
+    {
+        ai[i].ai_flags = p->ai_flags;
+        ai[i].ai_family = p->ai_family;
+        ai[i].ai_socktype = p->ai_socktype;
+        ai[i].ai_protocol = p->ai_protocol;
+        ai[i].ai_addrlen = p->ai_addrlen;
+        ai[i].ai_addr = (struct sockaddr *)(addrs + i);
+        ai[i].ai_canonname = NULL;
+        ai[i].ai_next = (p->ai_next != NULL) ? (ai + i + 1) : NULL;
+
+        memset(addrs + i, 0, sizeof (addrs[i]));
+        memcpy(addrs + i, p->ai_addr,
+               (p->ai_addrlen <= sizeof (addrs[i])) ? p->ai_addrlen
+                                                    : sizeof (addrs[i]));
+
+        switch (ai[i].ai_family)
+        {
+            case AF_INET:
+                ((struct sockaddr_in *)(addrs + i))->sin_port = htons(port);
+                break;
+#ifdef AF_INET6
+            case AF_INET6:
+                ((struct sockaddr_in6 *)(addrs + i))->sin6_port = htons(port);
+                break;
+#endif
+        }
+    }
+    return ai;
+}
+
+/** Uncached resolution, normalized to a vlc_resolver_Free()-able list. */
+static int resolver_Resolve(const char *node, unsigned port,
+                            const struct addrinfo *hints,
+                            struct addrinfo **restrict res)
+{
+    struct addrinfo *sys;
+    int val = vlc_getaddrinfo_i11e(node, port, hints, &sys);
+    if (val != 0)
+        return val;
+
+    *res = resolver_CopyList(sys, port);
+    freeaddrinfo(sys);
+    return (*res != NULL) ? 0 : EAI_MEMORY;
+}
+
+static bool resolver_Cacheable(const char *node, const struct addrinfo *hints)
+{
+    if (node == NULL)
+        return false;
+    /* Wildcard and numeric resolutions do not hit DNS; canonical names are
+     * not preserved by resolver_CopyList(). */
+    if (hints != NULL
+     && (hints->ai_flags & (AI_PASSIVE|AI_NUMERICHOST|AI_CANONNAME)))
+        return false;
+    return true;
+}
+
+static struct resolver_entry *resolver_Find(const char *host,
+                                            const struct addrinfo *hints)
+{
+    const struct addrinfo none = { 0 };
+
+    if (hints == NULL)
+        hints = &none;
+
+    for (struct resolver_entry *e = cache.entries; e != NULL; e = e->next)
+        if (e->family == hints->ai_family
+         && e->socktype == hints->ai_socktype
+         && e->protocol == hints->ai_protocol
+         && e->flags == hints->ai_flags
+         && strcmp(e->host, host) == 0)
+            return e;
+    return NULL;
+}
+
+static void resolver_Remove(struct resolver_entry *entry)
+{
+    struct resolver_entry **pp = &cache.entries;
+
+    while (*pp != entry)
+        pp = &(*pp)->next;
+    *pp = entry->next;
+    cache.count--;
+
+    free(entry->list);
+    free(entry);
+}
+
+static struct resolver_entry *resolver_Add(const char *host,
+                                           const struct addrinfo *hints)
+{
+    if (cache.count >= RESOLVER_CACHE_MAX)
+    {   /* Evict the stalest completed entry to make room. */
+        struct resolver_entry *victim = NULL;
+
+        for (struct resolver_entry *e = cache.entries; e != NULL; e = e->next)
+            if (!e->resolving
+             && (victim == NULL || e->expiry < victim->expiry))
+                victim = e;
+        if (victim == NULL)
+            return NULL; /* everything is in flight - do not cache */
+        resolver_Remove(victim);
+    }
+
+    struct resolver_entry *entry = malloc(sizeof (*entry)
+                                          + strlen(host) + 1);
+    if (unlikely(entry == NULL))
+        return NULL;
+
+    const struct addrinfo none = { 0 };
+
+    if (hints == NULL)
+        hints = &none;
+
+    entry->family = hints->ai_family;
+    entry->socktype = hints->ai_socktype;
+    entry->protocol = hints->ai_protocol;
+    entry->flags = hints->ai_flags;
+    entry->list = NULL;
+    entry->expiry = 0;
+    entry->resolving = true;
+    strcpy(entry->host, host);
+
+    entry->next = cache.entries;
+    cache.entries = entry;
+    cache.count++;
+    return entry;
+}
+
+int vlc_resolver_Lookup(const char *node, unsigned port,
+                        const struct addrinfo *hints,
+                        struct addrinfo **restrict res)
+{
+    int64_t ttl = config_GetInt("dns-cache-ttl");
+
+    if (ttl <= 0 || !resolver_Cacheable(node, hints))
+        return resolver_Resolve(node, port, hints, res);
+
+    vlc_mutex_lock(&lock);
+
+    struct resolver_entry *entry;
+
+    for (;;)
+    {
+        entry = resolver_Find(node, hints);
+        if (entry == NULL)
+            break;
+        if (entry->resolving)
+        {   /* Another thread resolves this name: share its result. */
+            vlc_cond_wait(&resolved_wait, &lock);
+            continue;
+        }
+        if (vlc_tick_now() >= entry->expiry)
+        {
+            resolver_Remove(entry);
+            entry = NULL;
+        }
+        break;
+    }
+
+    if (entry != NULL)
+    {
+        struct addrinfo *list = resolver_CopyList(entry->list, port);
+
+        vlc_mutex_unlock(&lock);
+        *res = list;
+        return (list != NULL) ? 0 : EAI_MEMORY;
+    }
+
+    entry = resolver_Add(node, hints);
+    vlc_mutex_unlock(&lock);
+
+    if (entry == NULL) /* cache full of in-flight entries, or no memory */
+        return resolver_Resolve(node, port, hints, res);
+
+    struct addrinfo *sys = NULL, *list = NULL, *copy = NULL;
+    int val = vlc_getaddrinfo_i11e(node, port, hints, &sys);
+
+    if (val == 0)
+    {
+        list = resolver_CopyList(sys, 0);
+        copy = resolver_CopyList(sys, port);
+        freeaddrinfo(sys);
+    }
+
+    vlc_mutex_lock(&lock);
+    if (val == 0 && list != NULL)
+    {
+        entry->list = list;
+        entry->expiry = vlc_tick_now() + vlc_tick_from_sec(ttl);
+        entry->resolving = false;
+    }
+    else /* Failures are not cached: most resolution errors are transient. */
+        resolver_Remove(entry);
+    vlc_cond_broadcast(&resolved_wait);
+    vlc_mutex_unlock(&lock);
+
+    if (val != 0)
+        return val;
+    if (copy == NULL)
+        return EAI_MEMORY;
+    *res = copy;
+    return 0;
+}
+
+void vlc_resolver_Free(struct addrinfo *res)
+{
+    free(res);
+}
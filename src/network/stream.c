@@ -440,7 +440,7 @@ vlc_tls_t *vlc_tls_SocketOpenTCP(vlc_object_t *obj, const char *name,
     assert(name != NULL);
     msg_Dbg(obj, "resolving %s ...", name);
 
-    int val = vlc_getaddrinfo_i11e(name, port, &hints, &res);
+    int val = vlc_resolver_Lookup(name, port, &hints, &res);
     if (val != 0)
     {   /* TODO: C locale for gai_strerror() */
         msg_Err(obj, "cannot resolve %s port %u: %s", name, port,
@@ -460,10 +460,10 @@ vlc_tls_t *vlc_tls_SocketOpenTCP(vlc_object_t *obj, const char *name,
             continue;
         }
 
-        freeaddrinfo(res);
+        vlc_resolver_Free(res);
         return tls;
     }
 
-    freeaddrinfo(res);
+    vlc_resolver_Free(res);
     return NULL;
 }
@@ -147,26 +147,44 @@ static void cleanup_tls(void *data)
     vlc_tls_SessionDelete (session);
 }
 
+vlc_tls_t *vlc_tls_ClientSessionOpen(vlc_tls_client_t *crd, vlc_tls_t *sock,
+                                     const char *host, const char *const *alpn)
+{
+    int canc = vlc_savecancel();
+    vlc_tls_t *session = crd->ops->open(crd, sock, host, alpn);
+    vlc_restorecancel(canc);
+
+    if (session != NULL)
+        session->p = sock;
+    return session;
+}
+
+int vlc_tls_ClientSessionHandshake(vlc_tls_client_t *crd, vlc_tls_t *session,
+                                   const char *host, const char *service,
+                                   char **alp)
+{
+    int canc = vlc_savecancel();
+    int val = crd->ops->handshake(session, host, service, alp);
+    vlc_restorecancel(canc);
+    return val;
+}
+
 vlc_tls_t *vlc_tls_ClientSessionCreate(vlc_tls_client_t *crd, vlc_tls_t *sock,
                                        const char *host, const char *service,
                                        const char *const *alpn, char **alp)
 {
     int val;
-    int canc = vlc_savecancel();
-    vlc_tls_t *session = crd->ops->open(crd, sock, host, alpn);
-    vlc_restorecancel(canc);
+    vlc_tls_t *session = vlc_tls_ClientSessionOpen(crd, sock, host, alpn);
 
     if (session == NULL)
         return NULL;
 
-    session->p = sock;
-
-    canc = vlc_savecancel();
     vlc_tick_t deadline = vlc_tick_now ();
     deadline += VLC_TICK_FROM_MS( var_InheritInteger (crd, "ipv4-timeout") );
 
     vlc_cleanup_push (cleanup_tls, session);
-    while ((val = crd->ops->handshake(session, host, service, alp)) != 0)
+    while ((val = vlc_tls_ClientSessionHandshake(crd, session, host, service,
+                                                 alp)) != 0)
     {
         struct pollfd ufd[1];
 
@@ -189,9 +207,7 @@ error:
         ufd[0].events = (val == 1) ? POLLIN : POLLOUT;
         ufd[0].fd = vlc_tls_GetPollFD(sock, &ufd->events);
 
-        vlc_restorecancel(canc);
         val = vlc_poll_i11e(ufd, 1, MS_FROM_VLC_TICK(deadline - now));
-        canc = vlc_savecancel();
         if (val == 0)
         {
             msg_Err(crd, "TLS session handshake timeout");
@@ -199,7 +215,6 @@ error:
         }
     }
     vlc_cleanup_pop();
-    vlc_restorecancel(canc);
     return session;
 }
 
@@ -227,7 +242,7 @@ vlc_tls_t *vlc_tls_SocketOpenTLS(vlc_tls_client_t *creds, const char *name,
 
     msg_Dbg(creds, "resolving %s ...", name);
 
-    int val = vlc_getaddrinfo_i11e(name, port, &hints, &res);
+    int val = vlc_resolver_Lookup(name, port, &hints, &res);
     if (val != 0)
     {   /* TODO: C locale for gai_strerror() */
         msg_Err(creds, "cannot resolve %s port %u: %s", name, port,
@@ -248,7 +263,7 @@ vlc_tls_t *vlc_tls_SocketOpenTLS(vlc_tls_client_t *creds, const char *name,
                                                      alpn, alp);
         if (tls != NULL)
         {   /* Success! */
-            freeaddrinfo(res);
+            vlc_resolver_Free(res);
             return tls;
         }
 
@@ -257,6 +272,6 @@ vlc_tls_t *vlc_tls_SocketOpenTLS(vlc_tls_client_t *creds, const char *name,
     }
 
     /* Failure! */
-    freeaddrinfo(res);
+    vlc_resolver_Free(res);
     return NULL;
 }
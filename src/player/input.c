@@ -26,6 +26,9 @@
 #include <vlc_memstream.h>
 #include "player.h"
 
+static void
+vlc_player_input_CheckPreroll(struct vlc_player_input *input);
+
 struct vlc_player_track_priv *
 vlc_player_input_FindTrackById(struct vlc_player_input *input, vlc_es_id_t *id,
                                size_t *idx)
@@ -98,6 +101,9 @@ vlc_player_input_UpdateTime(struct vlc_player_input *input)
 int
 vlc_player_input_Start(struct vlc_player_input *input)
 {
+    if (input->started) /* Already running: promoted preroll input */
+        return VLC_SUCCESS;
+
     int ret = input_Start(input->thread);
     if (ret != VLC_SUCCESS)
         return ret;
@@ -215,6 +221,14 @@ vlc_player_input_HandleState(struct vlc_player_input *input,
 {
     vlc_player_t *player = input->player;
 
+    /* A prerolling input must never drive the player state machine; only
+     * remember where it is for the teardown path. */
+    if (input->prerolling)
+    {
+        input->state = state;
+        return;
+    }
+
     /* The STOPPING state can be set earlier by the player. In that case,
      * ignore all future events except the STOPPED one */
     if (input->state == VLC_PLAYER_STATE_STOPPING
@@ -886,6 +900,8 @@ input_thread_Events(input_thread_t *input_thread,
     /* No player lock for this event */
     if (event->type == INPUT_EVENT_OUTPUT_CLOCK)
     {
+        if (input->prerolling)
+            return;
         if (event->output_clock.system_ts != VLC_TICK_INVALID)
         {
             const struct vlc_player_timer_point point = {
@@ -912,6 +928,37 @@ input_thread_Events(input_thread_t *input_thread,
 
     vlc_mutex_lock(&player->lock);
 
+    if (input->prerolling)
+    {
+        switch (event->type)
+        {
+            case INPUT_EVENT_STATE:
+            case INPUT_EVENT_TIMES:
+            case INPUT_EVENT_CACHE:
+            case INPUT_EVENT_STATISTICS:
+            case INPUT_EVENT_SIGNAL:
+            case INPUT_EVENT_RECORD:
+            case INPUT_EVENT_VOUT:
+                /* Not promoted yet: must not drive the player state machine,
+                 * the timers nor the buffering indication */
+                vlc_mutex_unlock(&player->lock);
+                return;
+            case INPUT_EVENT_DEAD:
+                /* The preroll failed or was discarded: drop the input and
+                 * let the regular open path retry the media at the boundary */
+                if (player->next_input == input)
+                    player->next_input = NULL;
+                input->started = false;
+                vlc_player_destructor_AddJoinableInput(player, input);
+                vlc_mutex_unlock(&player->lock);
+                return;
+            default:
+                /* Tracks, programs, titles and metadata accumulate on the
+                 * input as usual so they are there once promoted */
+                break;
+        }
+    }
+
     switch (event->type)
     {
         case INPUT_EVENT_STATE:
@@ -944,8 +991,9 @@ input_thread_Events(input_thread_t *input_thread,
                 input->position = event->times.position;
                 system_date = vlc_tick_now();
                 changed = true;
-                vlc_player_SendEvent(player, on_position_changed,
-                                     input->time, input->position);
+                /* High frequency event, delivered from the relay thread so
+                 * a slow listener cannot stall the input thread */
+                vlc_player_RelayPosition(player, input->time, input->position);
 
                 vlc_player_input_UpdateTime(input);
             }
@@ -975,6 +1023,7 @@ input_thread_Events(input_thread_t *input_thread,
                 vlc_player_UpdateTimer(player, NULL, false, &point,
                                        input->normal_time, 0, 0, priv->i_start);
             }
+            vlc_player_input_CheckPreroll(input);
             break;
         }
         case INPUT_EVENT_PROGRAM:
@@ -1009,7 +1058,7 @@ input_thread_Events(input_thread_t *input_thread,
                                             VLC_PLAYER_TIMER_EVENT_DISCONTINUITY,
                                             VLC_TICK_INVALID);
             input->cache = event->cache;
-            vlc_player_SendEvent(player, on_buffering_changed, event->cache);
+            vlc_player_RelayBuffering(player, event->cache);
             break;
         case INPUT_EVENT_VOUT:
             vlc_player_input_HandleVoutEvent(input, &event->vout);
@@ -1111,6 +1160,7 @@ vlc_player_input_New(vlc_player_t *player, input_item_t *item)
 
     input->player = player;
     input->started = false;
+    input->prerolling = false;
     input->playing = false;
 
     input->state = VLC_PLAYER_STATE_STOPPED;
@@ -1189,6 +1239,15 @@ vlc_player_input_New(vlc_player_t *player, input_item_t *item)
         vlc_player_input_SelectTracksByStringIds(input, SPU_ES,
                                                  player->sub_string_ids);
 
+    if (player->video_on_demand)
+        input_SetEsCatOnDemand(input->thread, VIDEO_ES, true);
+
+    if (player->audio_on_demand)
+        input_SetEsCatOnDemand(input->thread, AUDIO_ES, true);
+
+    if (player->sub_on_demand)
+        input_SetEsCatOnDemand(input->thread, SPU_ES, true);
+
     /* Initial sub/audio delay */
     const vlc_tick_t cat_delays[DATA_ES] = {
         [AUDIO_ES] =
@@ -1211,6 +1270,38 @@ vlc_player_input_New(vlc_player_t *player, input_item_t *item)
     return input;
 }
 
+/* Speculative preroll: when the current input is about to end, open, probe
+ * and prime (paused) an input for the next media, so that
+ * vlc_player_OpenNextMedia() can promote it at the boundary instead of
+ * starting from scratch. */
+static void
+vlc_player_input_CheckPreroll(struct vlc_player_input *input)
+{
+    vlc_player_t *player = input->player;
+
+    if (player->preroll_length <= 0 || input != player->input
+     || !player->started || player->next_input != NULL
+     || player->next_media == NULL
+     || input->time == VLC_TICK_INVALID || input->length == VLC_TICK_INVALID
+     || input->length - input->time > player->preroll_length)
+        return;
+
+    struct vlc_player_input *next =
+        vlc_player_input_New(player, player->next_media);
+    if (next == NULL)
+        return;
+
+    next->prerolling = true;
+    var_Create(next->thread, "start-paused", VLC_VAR_BOOL);
+    var_SetBool(next->thread, "start-paused", true);
+    if (vlc_player_input_Start(next) != VLC_SUCCESS)
+    {
+        vlc_player_input_Delete(next);
+        return;
+    }
+    player->next_input = next;
+}
+
 void
 vlc_player_input_Delete(struct vlc_player_input *input)
 {
@@ -65,7 +65,17 @@ vlc_player_input_RestoreMlStates(struct vlc_player_input* input, bool force_pos)
     if (restore_pos == VLC_PLAYER_RESTORE_PLAYBACK_POS_ALWAYS &&
             input->ml.states.current_title == -1 &&
             media->f_progress > .0f)
-        input_SetPosition(input->thread, media->f_progress, false);
+    {
+        /* When the duration is known, seek during the input initialization
+         * ("start-time") rather than queueing a seek control: the input
+         * then starts buffering and decoding directly at the resume point
+         * instead of prerolling from the beginning and flushing. */
+        if (media->i_duration > 0 && !input->started)
+            var_SetFloat(input->thread, "start-time",
+                         media->f_progress * (media->i_duration / 1000.));
+        else
+            input_SetPosition(input->thread, media->f_progress, false);
+    }
     else if (restore_pos == VLC_PLAYER_RESTORE_PLAYBACK_POS_ASK &&
              media->f_progress > .0f)
     {
@@ -51,6 +51,9 @@ static_assert(VLC_PLAYER_TITLE_MENU == INPUT_TITLE_MENU &&
 #define vlc_player_foreach_inputs(it) \
     for (struct vlc_player_input *it = player->input; it != NULL; it = NULL)
 
+static void
+vlc_player_DiscardNextInput(vlc_player_t *player);
+
 int
 vlc_player_OpenNextMedia(vlc_player_t *player)
 {
@@ -81,13 +84,37 @@ vlc_player_OpenNextMedia(vlc_player_t *player)
         player->media = player->next_media;
         player->next_media = NULL;
 
-        struct vlc_player_input *input = player->input =
-            vlc_player_input_New(player, player->media);
-        if (!input)
+        if (player->next_input != NULL)
         {
-            input_item_Release(player->media);
-            player->media = NULL;
-            ret = VLC_ENOMEM;
+            if (player->started
+             && input_GetItem(player->next_input->thread) == player->media)
+            {
+                /* Promote the input opened ahead of time (speculative
+                 * preroll) and unpause it: it is already probed and primed */
+                struct vlc_player_input *input = player->next_input;
+                player->next_input = NULL;
+                player->input = input;
+                input->prerolling = false;
+                vlc_player_input_HandleState(input, VLC_PLAYER_STATE_STARTED,
+                                             VLC_TICK_INVALID);
+                vlc_value_t val = { .i_int = PLAYING_S };
+                input_ControlPushHelper(input->thread,
+                                        INPUT_CONTROL_SET_STATE, &val);
+            }
+            else /* Prerolled for a media that is no longer the next one */
+                vlc_player_DiscardNextInput(player);
+        }
+
+        if (player->input == NULL)
+        {
+            struct vlc_player_input *input = player->input =
+                vlc_player_input_New(player, player->media);
+            if (!input)
+            {
+                input_item_Release(player->media);
+                player->media = NULL;
+                ret = VLC_ENOMEM;
+            }
         }
     }
     vlc_player_SendEvent(player, on_current_media_changed, player->media);
@@ -146,6 +173,18 @@ vlc_player_destructor_AddInput(vlc_player_t *player,
     vlc_cond_signal(&input->player->destructor.wait);
 }
 
+/* Drop the speculatively prerolled input, if any. It keeps its prerolling
+ * flag, so its termination is invisible to the player state machine. */
+static void
+vlc_player_DiscardNextInput(vlc_player_t *player)
+{
+    struct vlc_player_input *input = player->next_input;
+    if (input == NULL)
+        return;
+    player->next_input = NULL;
+    vlc_player_destructor_AddInput(player, input);
+}
+
 void
 vlc_player_destructor_AddStoppingInput(vlc_player_t *player,
                                        struct vlc_player_input *input)
@@ -210,7 +249,8 @@ vlc_player_destructor_Thread(void *data)
              * that will call this function. */
             input_item_t *media = input_GetItem(input->thread);
             input_Stop(input->thread);
-            vlc_player_SendEvent(player, on_stopping_current_media, media);
+            if (!input->prerolling)
+                vlc_player_SendEvent(player, on_stopping_current_media, media);
         }
 
         bool keep_sout = true;
@@ -218,7 +258,8 @@ vlc_player_destructor_Thread(void *data)
             !vlc_list_is_empty(&player->destructor.joinable_inputs);
         vlc_list_foreach(input, &player->destructor.joinable_inputs, node)
         {
-            vlc_player_UpdateMLStates(player, input);
+            if (!input->prerolling) /* never actually played */
+                vlc_player_UpdateMLStates(player, input);
 
             keep_sout = var_GetBool(input->thread, "sout-keep");
 
@@ -244,6 +285,76 @@ vlc_player_destructor_Thread(void *data)
     return NULL;
 }
 
+/* Delivers the coalesced high frequency events to the listeners without
+ * blocking the thread that emitted them. Only the latest pending value of
+ * each event is kept: a listener slower than the input sees fewer
+ * intermediate positions, but can never stall the input thread. */
+static void *
+vlc_player_relay_Thread(void *data)
+{
+    vlc_player_t *player = data;
+
+    vlc_thread_set_name("vlc-player-ev");
+
+    vlc_mutex_lock(&player->relay.lock);
+    for (;;)
+    {
+        while (!player->relay.closing
+            && !player->relay.position.pending
+            && !player->relay.buffering.pending)
+            vlc_cond_wait(&player->relay.wait, &player->relay.lock);
+        if (player->relay.closing)
+            break;
+
+        const bool position_pending = player->relay.position.pending;
+        const vlc_tick_t time = player->relay.position.time;
+        const double position = player->relay.position.position;
+        const bool buffering_pending = player->relay.buffering.pending;
+        const float cache = player->relay.buffering.cache;
+        player->relay.position.pending = false;
+        player->relay.buffering.pending = false;
+        vlc_mutex_unlock(&player->relay.lock);
+
+        vlc_mutex_lock(&player->lock);
+        /* Events outliving their input are dropped */
+        if (player->input != NULL)
+        {
+            if (buffering_pending)
+                vlc_player_SendEvent(player, on_buffering_changed, cache);
+            if (position_pending)
+                vlc_player_SendEvent(player, on_position_changed, time,
+                                     position);
+        }
+        vlc_mutex_unlock(&player->lock);
+
+        vlc_mutex_lock(&player->relay.lock);
+    }
+    vlc_mutex_unlock(&player->relay.lock);
+    return NULL;
+}
+
+void
+vlc_player_RelayPosition(vlc_player_t *player, vlc_tick_t time,
+                         double position)
+{
+    vlc_mutex_lock(&player->relay.lock);
+    player->relay.position.pending = true;
+    player->relay.position.time = time;
+    player->relay.position.position = position;
+    vlc_cond_signal(&player->relay.wait);
+    vlc_mutex_unlock(&player->relay.lock);
+}
+
+void
+vlc_player_RelayBuffering(vlc_player_t *player, float cache)
+{
+    vlc_mutex_lock(&player->relay.lock);
+    player->relay.buffering.pending = true;
+    player->relay.buffering.cache = cache;
+    vlc_cond_signal(&player->relay.wait);
+    vlc_mutex_unlock(&player->relay.lock);
+}
+
 size_t
 vlc_player_GetProgramCount(vlc_player_t *player)
 {
@@ -596,6 +707,29 @@ vlc_player_SelectTracksByStringIds(vlc_player_t *player,
         vlc_player_input_SelectTracksByStringIds(input, cat, str_ids);
 }
 
+void
+vlc_player_SetTrackCategoryOnDemand(vlc_player_t *player,
+                                    enum es_format_category_e cat,
+                                    bool on_demand)
+{
+    vlc_player_assert_locked(player);
+    bool *cat_on_demand;
+
+    switch (cat)
+    {
+        case VIDEO_ES: cat_on_demand = &player->video_on_demand; break;
+        case AUDIO_ES: cat_on_demand = &player->audio_on_demand; break;
+        case SPU_ES:   cat_on_demand = &player->sub_on_demand; break;
+        default: return;
+    }
+
+    *cat_on_demand = on_demand;
+
+    struct vlc_player_input *input = vlc_player_get_input_locked(player);
+    if (input)
+        input_SetEsCatOnDemand(input->thread, cat, on_demand);
+}
+
 void
 vlc_player_CycleTrack(vlc_player_t *player, enum es_format_category_e cat,
                       enum vlc_vout_order vout_order, bool next)
@@ -1002,6 +1136,7 @@ vlc_player_InvalidateNextMedia(vlc_player_t *player)
         input_item_Release(player->next_media);
         player->next_media = NULL;
     }
+    vlc_player_DiscardNextInput(player);
 }
 
 int
@@ -1057,6 +1192,11 @@ vlc_player_SetNextMedia(vlc_player_t *player, input_item_t *media)
         input_item_Release(player->next_media);
 
     player->next_media = next_media;
+
+    if (player->next_input != NULL
+     && (next_media == NULL
+      || input_GetItem(player->next_input->thread) != next_media))
+        vlc_player_DiscardNextInput(player);
 }
 
 input_item_t *
@@ -1854,6 +1994,8 @@ vlc_player_InitLocks(vlc_player_t *player, enum vlc_player_lock_type lock_type)
     vlc_mutex_init(&player->aout_listeners_lock);
     vlc_cond_init(&player->start_delay_cond);
     vlc_cond_init(&player->destructor.wait);
+    vlc_mutex_init(&player->relay.lock);
+    vlc_cond_init(&player->relay.wait);
 }
 
 void
@@ -1866,6 +2008,7 @@ vlc_player_Delete(vlc_player_t *player)
         vlc_player_destructor_AddInput(player, player->input);
         player->input = NULL;
     }
+    vlc_player_DiscardNextInput(player);
 
     player->deleting = true;
     vlc_cond_signal(&player->destructor.wait);
@@ -1879,6 +2022,12 @@ vlc_player_Delete(vlc_player_t *player)
 
     vlc_join(player->destructor.thread, NULL);
 
+    vlc_mutex_lock(&player->relay.lock);
+    player->relay.closing = true;
+    vlc_cond_signal(&player->relay.wait);
+    vlc_mutex_unlock(&player->relay.lock);
+    vlc_join(player->relay.thread, NULL);
+
     if (player->media)
         input_item_Release(player->media);
     if (player->next_media)
@@ -1938,6 +2087,9 @@ vlc_player_New(vlc_object_t *parent, enum vlc_player_lock_type lock_type)
 
     player->releasing_media = false;
     player->next_media = NULL;
+    player->next_input = NULL;
+    player->preroll_length =
+        VLC_TICK_FROM_MS(var_InheritInteger(parent, "gapless-preroll"));
 
     player->video_string_ids = player->audio_string_ids =
     player->sub_string_ids = NULL;
@@ -1994,12 +2146,25 @@ vlc_player_New(vlc_object_t *parent, enum vlc_player_lock_type lock_type)
     var_AddCallback(player, "corks", vlc_player_CorkCallback, player);
 
     player->deleting = false;
+    player->relay.closing = false;
     vlc_player_InitLocks(player, lock_type);
     vlc_player_InitTimer(player);
 
+    if (vlc_clone(&player->relay.thread, vlc_player_relay_Thread,
+                  player) != 0)
+    {
+        vlc_player_DestroyTimer(player);
+        goto error;
+    }
+
     if (vlc_clone(&player->destructor.thread, vlc_player_destructor_Thread,
                   player) != 0)
     {
+        vlc_mutex_lock(&player->relay.lock);
+        player->relay.closing = true;
+        vlc_cond_signal(&player->relay.wait);
+        vlc_mutex_unlock(&player->relay.lock);
+        vlc_join(player->relay.thread, NULL);
         vlc_player_DestroyTimer(player);
         goto error;
     }
@@ -59,6 +59,11 @@ struct vlc_player_input
     vlc_player_t *player;
     bool started;
 
+    /* Input opened ahead of the end of the current one ("gapless-preroll"):
+     * the player state machine and timers must ignore it until it is
+     * promoted by vlc_player_OpenNextMedia() */
+    bool prerolling;
+
     /* Monitor the OPENING_S -> PLAYING_S transition. */
     bool playing;
 
@@ -259,11 +264,21 @@ struct vlc_player_t
 
     bool releasing_media;
     input_item_t *next_media;
+    /* Input speculatively opened, probed and primed (paused) for next_media,
+     * or NULL. Bounded by the input caching budget of a single input. */
+    struct vlc_player_input *next_input;
+    /* Time left on the current input below which next_media is prerolled,
+     * 0 disables the speculative preroll */
+    vlc_tick_t preroll_length;
 
     char *video_string_ids;
     char *audio_string_ids;
     char *sub_string_ids;
 
+    bool video_on_demand;
+    bool audio_on_demand;
+    bool sub_on_demand;
+
     enum vlc_player_state global_state;
     bool started;
 
@@ -288,6 +303,29 @@ struct vlc_player_t
     } destructor;
 
     struct vlc_player_timer timer;
+
+    /* Asynchronous fan-out of the high frequency scalar events: the
+     * emitting (input) thread only stores the latest value here, the relay
+     * thread delivers it to the listeners, so a slow listener callback can
+     * coalesce updates but never stall the input. */
+    struct
+    {
+        vlc_thread_t thread;
+        vlc_mutex_t lock;
+        vlc_cond_t wait;
+        bool closing;
+        struct
+        {
+            bool pending;
+            vlc_tick_t time;
+            double position;
+        } position;
+        struct
+        {
+            bool pending;
+            float cache;
+        } buffering;
+    } relay;
 };
 
 #ifndef NDEBUG
@@ -353,6 +391,13 @@ void
 vlc_player_destructor_AddJoinableInput(vlc_player_t *player,
                                        struct vlc_player_input *input);
 
+void
+vlc_player_RelayPosition(vlc_player_t *player, vlc_tick_t time,
+                         double position);
+
+void
+vlc_player_RelayBuffering(vlc_player_t *player, float cache);
+
 /*
  * player_track.c
  */
@@ -24,6 +24,7 @@
 
 #include "notify.h"
 
+#include <vlc_diffutil.h>
 #include "item.h"
 #include "playlist.h"
 
@@ -101,6 +102,113 @@ vlc_playlist_state_NotifyChanges(vlc_playlist_t *playlist,
         vlc_playlist_Notify(playlist, on_has_next_changed, playlist->has_next);
 }
 
+/* Below this size, a full on_items_reset is cheap enough that computing a
+ * diff is not worth it (and interfaces would not notice the difference). */
+#define PLAYLIST_REORDER_DIFF_MIN_SIZE 100
+/* The Myers diff is quadratic in the worst case; past this window size a
+ * reset is both cheaper to compute and cheaper to apply. */
+#define PLAYLIST_REORDER_MAX_WINDOW 1024
+
+struct vlc_playlist_reorder_view {
+    vlc_playlist_item_t *const *items;
+    size_t count;
+};
+
+static uint32_t
+reorder_view_Size(const void *list)
+{
+    return ((const struct vlc_playlist_reorder_view *) list)->count;
+}
+
+static bool
+reorder_view_IsSame(const void *listOld, uint32_t oldIndex,
+                    const void *listNew, uint32_t newIndex)
+{
+    const struct vlc_playlist_reorder_view *old = listOld;
+    const struct vlc_playlist_reorder_view *new = listNew;
+    return old->items[oldIndex] == new->items[newIndex];
+}
+
+static bool
+vlc_playlist_NotifyReorderDiff(vlc_playlist_t *playlist,
+                               vlc_playlist_item_t *const items[],
+                               size_t offset, size_t count)
+{
+    struct vlc_playlist_reorder_view old = { &items[offset], count };
+    struct vlc_playlist_reorder_view new = {
+        &playlist->items.data[offset], count
+    };
+    vlc_diffutil_callback_t diffop = {
+        .getOldSize = reorder_view_Size,
+        .getNewSize = reorder_view_Size,
+        .isSame = reorder_view_IsSame,
+    };
+
+    diffutil_snake_t *snake = vlc_diffutil_build_snake(&diffop, &old, &new);
+    if (unlikely(!snake))
+        return false;
+
+    vlc_diffutil_changelist_t *changes =
+        vlc_diffutil_build_change_list(snake, &diffop, &old, &new,
+                                       VLC_DIFFUTIL_RESULT_AGGREGATE);
+    vlc_diffutil_free_snake(snake);
+    if (unlikely(!changes))
+        return false;
+
+    for (size_t i = 0; i < changes->size; ++i)
+    {
+        const vlc_diffutil_change_t *op = &changes->data[i];
+        switch (op->type)
+        {
+            case VLC_DIFFUTIL_OP_INSERT:
+                vlc_playlist_Notify(playlist, on_items_added,
+                                    offset + op->op.insert.index,
+                                    &new.items[op->op.insert.y], op->count);
+                break;
+            case VLC_DIFFUTIL_OP_REMOVE:
+                vlc_playlist_Notify(playlist, on_items_removed,
+                                    offset + op->op.remove.index, op->count);
+                break;
+            default:
+                vlc_assert_unreachable();
+        }
+    }
+
+    vlc_diffutil_free_change_list(changes);
+    return true;
+}
+
+void
+vlc_playlist_NotifyReorder(vlc_playlist_t *playlist,
+                           vlc_playlist_item_t *const items[], size_t count)
+{
+    vlc_playlist_AssertLocked(playlist);
+    assert(!items || count == playlist->items.size);
+
+    if (items && playlist->items.size >= PLAYLIST_REORDER_DIFF_MIN_SIZE)
+    {
+        /* restrict the diff to the range that actually changed */
+        size_t lo = 0;
+        while (lo < count && items[lo] == playlist->items.data[lo])
+            lo++;
+        if (lo == count)
+            /* the permutation was a no-op */
+            return;
+
+        size_t hi = count;
+        while (hi > lo && items[hi - 1] == playlist->items.data[hi - 1])
+            hi--;
+
+        if (hi - lo <= PLAYLIST_REORDER_MAX_WINDOW
+                && vlc_playlist_NotifyReorderDiff(playlist, items, lo,
+                                                  hi - lo))
+            return;
+    }
+
+    vlc_playlist_Notify(playlist, on_items_reset, playlist->items.data,
+                        playlist->items.size);
+}
+
 static inline bool
 vlc_playlist_HasItemUpdatedListeners(vlc_playlist_t *playlist)
 {
@@ -25,6 +25,7 @@
 #include <vlc_list.h>
 
 typedef struct vlc_playlist vlc_playlist_t;
+typedef struct vlc_playlist_item vlc_playlist_item_t;
 
 struct vlc_playlist_listener_id
 {
@@ -67,4 +68,18 @@ vlc_playlist_state_NotifyChanges(vlc_playlist_t *playlist,
 void
 vlc_playlist_NotifyMediaUpdated(vlc_playlist_t *playlist, input_item_t *media);
 
+/**
+ * Notify that the playlist content has been reordered (sorted or shuffled).
+ *
+ * The new order is read from the playlist; @a items is the previous content
+ * (of the same size). When the playlist is large and only a bounded range
+ * actually changed, a minimal list of on_items_removed/on_items_added events
+ * is emitted instead of on_items_reset, so that interfaces displaying huge
+ * playlists do not rebuild their whole model. @a items may be NULL to force
+ * a plain on_items_reset notification.
+ */
+void
+vlc_playlist_NotifyReorder(vlc_playlist_t *playlist,
+                           vlc_playlist_item_t *const items[], size_t count);
+
 #endif
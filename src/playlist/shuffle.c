@@ -41,6 +41,13 @@ vlc_playlist_Shuffle(vlc_playlist_t *playlist)
                                  ? playlist->items.data[playlist->current]
                                  : NULL;
 
+    /* keep a snapshot of the old order to notify a minimal diff (on failure,
+     * a full on_items_reset is notified instead) */
+    vlc_playlist_item_t **old = vlc_alloc(playlist->items.size, sizeof(*old));
+    if (old)
+        memcpy(old, playlist->items.data,
+               playlist->items.size * sizeof(*old));
+
     /* initialize separately instead of using vlc_lrand48() to avoid locking the
      * mutex once for each item */
     unsigned short xsubi[3];
@@ -67,8 +74,11 @@ vlc_playlist_Shuffle(vlc_playlist_t *playlist)
         playlist->has_next = vlc_playlist_ComputeHasNext(playlist);
     }
 
-    vlc_playlist_Notify(playlist, on_items_reset, playlist->items.data,
-                        playlist->items.size);
+    vlc_playlist_Notify(playlist, on_update_begin);
+    vlc_playlist_NotifyReorder(playlist, old, playlist->items.size);
     if (current)
         vlc_playlist_state_NotifyChanges(playlist, &state);
+    vlc_playlist_Notify(playlist, on_update_end);
+
+    free(old);
 }
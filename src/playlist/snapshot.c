@@ -0,0 +1,214 @@
+/*****************************************************************************
+ * playlist/snapshot.c
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <vlc_common.h>
+#include <vlc_playlist.h>
+#include <vlc_input_item.h>
+#include <vlc_frame.h>
+#include <vlc_fs.h>
+#include "playlist.h"
+
+/*
+ * Binary playlist snapshot: a header, one fixed-size record per item and
+ * a string table. Unlike the M3U/XSPF "playlist export" modules, which
+ * remain the interchange formats, restoring a snapshot does not parse any
+ * text: the file is mapped read-only (vlc_frame_FilePath) and the items
+ * are built in one linear pass over the records, with string offsets
+ * resolved directly into the mapping. The format is native-endian and
+ * per-user, like the plugins cache.
+ */
+
+#define SNAPSHOT_MAGIC      "VLCPLST1"
+#define SNAPSHOT_NO_STRING  UINT64_MAX
+#define SNAPSHOT_MAX_ITEMS  (UINT64_C(1) << 32) /* sanity bound */
+
+struct snapshot_header
+{
+    char     magic[8];
+    uint64_t count;         /**< number of records */
+    uint64_t strings_size;  /**< size of the string table, in bytes */
+};
+
+struct snapshot_record
+{
+    uint64_t uri;       /**< offset of the URI in the string table */
+    uint64_t name;      /**< offset of the name, or SNAPSHOT_NO_STRING */
+    int64_t  duration;  /**< in vlc_tick_t, VLC_TICK_INVALID if unknown */
+};
+
+static uint64_t
+snapshot_AddString(uint64_t *strings_size, const char *str)
+{
+    if (str == NULL)
+        return SNAPSHOT_NO_STRING;
+
+    uint64_t offset = *strings_size;
+    *strings_size += strlen(str) + 1;
+    return offset;
+}
+
+int
+vlc_playlist_SaveSnapshot(vlc_playlist_t *playlist, const char *filename)
+{
+    vlc_playlist_AssertLocked(playlist);
+
+    const size_t count = vlc_playlist_Count(playlist);
+    if (count >= SNAPSHOT_MAX_ITEMS)
+        return VLC_EGENERIC;
+
+    char *tmpname;
+    if (asprintf(&tmpname, "%s.tmp", filename) == -1)
+        return VLC_ENOMEM;
+
+    FILE *file = vlc_fopen(tmpname, "wb");
+    if (file == NULL)
+    {
+        free(tmpname);
+        return VLC_EGENERIC;
+    }
+
+    struct snapshot_header header = { .count = count };
+    memcpy(header.magic, SNAPSHOT_MAGIC, 8);
+
+    /* First pass: lay out the records and compute the table size */
+    struct snapshot_record *records = NULL;
+    bool ok = count < SIZE_MAX / sizeof(*records) &&
+        (records = vlc_alloc(count, sizeof(*records))) != NULL;
+
+    for (size_t i = 0; ok && i < count; ++i)
+    {
+        input_item_t *media =
+            vlc_playlist_item_GetMedia(vlc_playlist_Get(playlist, i));
+        vlc_mutex_lock(&media->lock);
+        records[i].uri = snapshot_AddString(&header.strings_size,
+                                            media->psz_uri);
+        records[i].name = snapshot_AddString(&header.strings_size,
+                                             media->psz_name);
+        records[i].duration = media->i_duration;
+        vlc_mutex_unlock(&media->lock);
+        ok = records[i].uri != SNAPSHOT_NO_STRING;
+    }
+
+    ok = ok && fwrite(&header, sizeof(header), 1, file) == 1 &&
+        (count == 0 || fwrite(records, sizeof(*records), count, file) == count);
+
+    /* Second pass: the string table itself */
+    for (size_t i = 0; ok && i < count; ++i)
+    {
+        input_item_t *media =
+            vlc_playlist_item_GetMedia(vlc_playlist_Get(playlist, i));
+        vlc_mutex_lock(&media->lock);
+        ok = fwrite(media->psz_uri, strlen(media->psz_uri) + 1, 1, file) == 1
+          && (media->psz_name == NULL ||
+              fwrite(media->psz_name, strlen(media->psz_name) + 1, 1,
+                     file) == 1);
+        vlc_mutex_unlock(&media->lock);
+    }
+
+    free(records);
+    if (fclose(file) != 0)
+        ok = false;
+
+    int ret = VLC_EGENERIC;
+    if (ok && vlc_rename(tmpname, filename) == 0)
+        ret = VLC_SUCCESS;
+    else
+        vlc_unlink(tmpname);
+    free(tmpname);
+    return ret;
+}
+
+static const char *
+snapshot_GetString(const char *strings, uint64_t strings_size, uint64_t offset)
+{
+    if (offset >= strings_size)
+        return NULL;
+    return strings + offset; /* the table is checked to end with a NUL */
+}
+
+int
+vlc_playlist_LoadSnapshot(vlc_playlist_t *playlist, const char *filename)
+{
+    vlc_playlist_AssertLocked(playlist);
+
+    vlc_frame_t *frame = vlc_frame_FilePath(filename, false);
+    if (frame == NULL)
+        return VLC_EGENERIC;
+
+    int ret = VLC_EGENERIC;
+    input_item_t **media = NULL;
+    size_t loaded = 0;
+
+    const struct snapshot_header *header = (void *)frame->p_buffer;
+    if (frame->i_buffer < sizeof(*header) ||
+        memcmp(header->magic, SNAPSHOT_MAGIC, 8) != 0 ||
+        header->count >= SNAPSHOT_MAX_ITEMS ||
+        header->strings_size > frame->i_buffer ||
+        frame->i_buffer - sizeof(*header) <
+            header->count * sizeof(struct snapshot_record) + header->strings_size)
+        goto out;
+
+    const struct snapshot_record *records = (void *)(header + 1);
+    const char *strings = (const char *)(records + header->count);
+    const size_t count = header->count;
+
+    /* Guarantees that every in-range offset yields a terminated string */
+    if (header->strings_size == 0 || strings[header->strings_size - 1] != '\0')
+        goto out;
+
+    media = vlc_alloc(count, sizeof(*media));
+    if (media == NULL)
+        goto out;
+
+    for (loaded = 0; loaded < count; ++loaded)
+    {
+        const struct snapshot_record *record = &records[loaded];
+        const char *uri = snapshot_GetString(strings, header->strings_size,
+                                             record->uri);
+        if (uri == NULL)
+            goto out;
+        const char *name = record->name != SNAPSHOT_NO_STRING
+            ? snapshot_GetString(strings, header->strings_size, record->name)
+            : NULL;
+
+        media[loaded] = input_item_NewExt(uri, name, record->duration,
+                                          ITEM_TYPE_UNKNOWN, ITEM_NET_UNKNOWN);
+        if (media[loaded] == NULL)
+            goto out;
+    }
+
+    vlc_playlist_Clear(playlist);
+    ret = vlc_playlist_Append(playlist, media, count);
+
+out:
+    if (media != NULL)
+        for (size_t i = 0; i < loaded; ++i)
+            input_item_Release(media[i]);
+    free(media);
+    vlc_frame_Release(frame);
+    return ret;
+}
@@ -22,6 +22,8 @@
 # include "config.h"
 #endif
 
+#include <ctype.h>
+
 #include <vlc_common.h>
 #include <vlc_rand.h>
 #include <vlc_sort.h>
@@ -71,6 +73,27 @@ vlc_playlist_item_meta_CopyString(const char **to, const char *from)
     return VLC_SUCCESS;
 }
 
+/* Copy a string case-folded, so that the case-insensitive criteria can
+ * compare collation keys with plain strcmp() instead of running
+ * strcasecmp() O(n log n) times. Byte-wise folding orders exactly like
+ * strcasecmp(). */
+static int
+vlc_playlist_item_meta_CopyStringFolded(const char **to, const char *from)
+{
+    if (from)
+    {
+        char *copy = strdup(from);
+        if (unlikely(!copy))
+            return VLC_ENOMEM;
+        for (char *p = copy; *p != '\0'; ++p)
+            *p = tolower((unsigned char) *p);
+        *to = copy;
+    }
+    else
+        *to = NULL;
+    return VLC_SUCCESS;
+}
+
 static int
 vlc_playlist_item_meta_GetNumber(const char * str, int64_t * to)
 {
@@ -122,7 +145,8 @@ vlc_playlist_item_meta_InitField(struct vlc_playlist_item_meta *meta,
         {
             const char *value = input_item_GetMetaLocked(media,
                                                          vlc_meta_Artist);
-            return vlc_playlist_item_meta_CopyString(&meta->artist, value);
+            return vlc_playlist_item_meta_CopyStringFolded(&meta->artist,
+                                                           value);
         }
         case VLC_PLAYLIST_SORT_KEY_ALBUM:
         {
@@ -133,13 +157,13 @@ vlc_playlist_item_meta_InitField(struct vlc_playlist_item_meta *meta,
         {
             const char *value = input_item_GetMetaLocked(media,
                                                          vlc_meta_AlbumArtist);
-            return vlc_playlist_item_meta_CopyString(&meta->album_artist,
-                                                     value);
+            return vlc_playlist_item_meta_CopyStringFolded(&meta->album_artist,
+                                                           value);
         }
         case VLC_PLAYLIST_SORT_KEY_GENRE:
         {
             const char *value = input_item_GetMetaLocked(media, vlc_meta_Genre);
-            return vlc_playlist_item_meta_CopyString(&meta->genre, value);
+            return vlc_playlist_item_meta_CopyStringFolded(&meta->genre, value);
         }
         case VLC_PLAYLIST_SORT_KEY_DATE:
         {
@@ -276,8 +300,10 @@ vlc_playlist_item_meta_Delete(struct vlc_playlist_item_meta *meta)
 static inline int
 CompareStrings(const char *a, const char *b)
 {
+    /* the operands are case-folded collation keys, see
+     * vlc_playlist_item_meta_CopyStringFolded() */
     if (a && b)
-        return strcasecmp(a, b);
+        return strcmp(a, b);
     if (!a && !b)
         return 0;
     return a ? 1 : -1;
@@ -441,6 +467,132 @@ vlc_playlist_NewMetaArray(vlc_playlist_t *playlist,
     return array;
 }
 
+/* Minimum number of items before sorting is spread over worker threads:
+ * below this, the comparator cost does not amortize the thread setup. */
+#define VLC_PLAYLIST_SORT_PARALLEL_MIN 10000
+/* Upper bound on worker threads (and stack-allocated slice bookkeeping) */
+#define VLC_PLAYLIST_SORT_MAX_SLICES 8
+
+struct sort_slice
+{
+    struct vlc_playlist_item_meta **array;
+    size_t count;
+    struct sort_request *req;
+};
+
+static void *
+vlc_playlist_SortSliceRun(void *userdata)
+{
+    struct sort_slice *slice = userdata;
+    vlc_qsort(slice->array, slice->count, sizeof(*slice->array), compare_meta,
+              slice->req);
+    return NULL;
+}
+
+static void
+vlc_playlist_MergeRuns(struct vlc_playlist_item_meta **dst,
+                       struct vlc_playlist_item_meta **a, size_t na,
+                       struct vlc_playlist_item_meta **b, size_t nb,
+                       struct sort_request *req)
+{
+    while (na > 0 && nb > 0)
+    {
+        if (compare_meta(a, b, req) <= 0)
+        {
+            *dst++ = *a++;
+            --na;
+        }
+        else
+        {
+            *dst++ = *b++;
+            --nb;
+        }
+    }
+    if (na > 0)
+        memcpy(dst, a, na * sizeof(*dst));
+    if (nb > 0)
+        memcpy(dst, b, nb * sizeof(*dst));
+}
+
+/* Sort the meta array, using several threads for large playlists: sort
+ * independent slices concurrently, then merge them pairwise. As the
+ * comparator is a strict total order (ties are broken on the original
+ * index), the result is identical to a single-threaded sort. */
+static void
+vlc_playlist_SortMetaArray(struct vlc_playlist_item_meta **array, size_t size,
+                           struct sort_request *req)
+{
+    unsigned slices = 1;
+    if (size >= VLC_PLAYLIST_SORT_PARALLEL_MIN)
+    {
+        unsigned cpus = vlc_GetCPUCount();
+        while (slices * 2 <= cpus && slices * 2 <= VLC_PLAYLIST_SORT_MAX_SLICES
+            && size / (slices * 2) >= VLC_PLAYLIST_SORT_PARALLEL_MIN / 2)
+            slices *= 2;
+    }
+
+    struct vlc_playlist_item_meta **tmp = NULL;
+    if (slices > 1)
+        tmp = vlc_alloc(size, sizeof(*tmp));
+    if (tmp == NULL)
+    {
+        /* small playlist, or allocation failure */
+        vlc_qsort(array, size, sizeof(*array), compare_meta, req);
+        return;
+    }
+
+    struct sort_slice slice[VLC_PLAYLIST_SORT_MAX_SLICES];
+    size_t offset[VLC_PLAYLIST_SORT_MAX_SLICES];
+    size_t count[VLC_PLAYLIST_SORT_MAX_SLICES];
+    size_t base = 0;
+    for (unsigned i = 0; i < slices; ++i)
+    {
+        count[i] = size / slices + (i < size % slices ? 1 : 0);
+        offset[i] = base;
+        slice[i] = (struct sort_slice) { array + base, count[i], req };
+        base += count[i];
+    }
+
+    vlc_thread_t threads[VLC_PLAYLIST_SORT_MAX_SLICES];
+    bool spawned[VLC_PLAYLIST_SORT_MAX_SLICES];
+    for (unsigned i = 1; i < slices; ++i)
+        spawned[i] = vlc_clone(&threads[i], vlc_playlist_SortSliceRun,
+                               &slice[i]) == 0;
+
+    /* sort the first slice on the calling thread */
+    vlc_playlist_SortSliceRun(&slice[0]);
+
+    for (unsigned i = 1; i < slices; ++i)
+    {
+        if (spawned[i])
+            vlc_join(threads[i], NULL);
+        else /* thread creation failure: sort the slice here instead */
+            vlc_playlist_SortSliceRun(&slice[i]);
+    }
+
+    /* pairwise merges, ping-ponging between the array and the temporary */
+    struct vlc_playlist_item_meta **src = array, **dst = tmp;
+    for (unsigned runs = slices; runs > 1; runs /= 2)
+    {
+        for (unsigned i = 0; i < runs; i += 2)
+        {
+            vlc_playlist_MergeRuns(dst + offset[i],
+                                   src + offset[i], count[i],
+                                   src + offset[i + 1], count[i + 1], req);
+            offset[i / 2] = offset[i];
+            count[i / 2] = count[i] + count[i + 1];
+        }
+
+        struct vlc_playlist_item_meta **swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != array)
+        memcpy(array, src, size * sizeof(*array));
+    free(tmp);
+}
+
 int
 vlc_playlist_Sort(vlc_playlist_t *playlist,
                   const struct vlc_playlist_sort_criterion criteria[],
@@ -460,7 +612,14 @@ vlc_playlist_Sort(vlc_playlist_t *playlist,
 
     struct sort_request req = { criteria, count };
 
-    vlc_qsort(array, playlist->items.size, sizeof(*array), compare_meta, &req);
+    vlc_playlist_SortMetaArray(array, playlist->items.size, &req);
+
+    /* keep a snapshot of the old order to notify a minimal diff (on failure,
+     * a full on_items_reset is notified instead) */
+    vlc_playlist_item_t **old = vlc_alloc(playlist->items.size, sizeof(*old));
+    if (old)
+        memcpy(old, playlist->items.data,
+               playlist->items.size * sizeof(*old));
 
     /* apply the sorting result to the playlist */
     for (size_t i = 0; i < playlist->items.size; ++i)
@@ -478,10 +637,13 @@ vlc_playlist_Sort(vlc_playlist_t *playlist,
         playlist->has_next = vlc_playlist_ComputeHasNext(playlist);
     }
 
-    vlc_playlist_Notify(playlist, on_items_reset, playlist->items.data,
-                        playlist->items.size);
+    vlc_playlist_Notify(playlist, on_update_begin);
+    vlc_playlist_NotifyReorder(playlist, old, playlist->items.size);
     if (current)
         vlc_playlist_state_NotifyChanges(playlist, &state);
+    vlc_playlist_Notify(playlist, on_update_end);
+
+    free(old);
 
     return VLC_SUCCESS;
 }
@@ -25,9 +25,11 @@
 #endif
 
 #include <stdio.h>
+#include <unistd.h>
 #include "item.h"
 #include "playlist.h"
 #include "preparse.h"
+#include <vlc_fs.h>
 
 /* the playlist lock is the one of the player */
 # define vlc_playlist_Lock(p) VLC_UNUSED(p);
@@ -399,6 +401,8 @@ struct callback_ctx
                                                   vec_current_index_changed;
     struct VLC_VECTOR(struct has_prev_changed_report)      vec_has_prev_changed;
     struct VLC_VECTOR(struct has_next_changed_report)      vec_has_next_changed;
+    size_t update_begin_count;
+    size_t update_end_count;
 };
 
 #define CALLBACK_CTX_INITIALIZER \
@@ -426,6 +430,8 @@ callback_ctx_reset(struct callback_ctx *ctx)
     vlc_vector_clear(&ctx->vec_current_index_changed);
     vlc_vector_clear(&ctx->vec_has_prev_changed);
     vlc_vector_clear(&ctx->vec_has_next_changed);
+    ctx->update_begin_count = 0;
+    ctx->update_end_count = 0;
 };
 
 static inline void
@@ -560,6 +566,22 @@ callback_on_has_next_changed(vlc_playlist_t *playlist, bool has_next,
     vlc_vector_push(&ctx->vec_has_next_changed, report);
 }
 
+static void
+callback_on_update_begin(vlc_playlist_t *playlist, void *userdata)
+{
+    VLC_UNUSED(playlist);
+    struct callback_ctx *ctx = userdata;
+    ctx->update_begin_count++;
+}
+
+static void
+callback_on_update_end(vlc_playlist_t *playlist, void *userdata)
+{
+    VLC_UNUSED(playlist);
+    struct callback_ctx *ctx = userdata;
+    ctx->update_end_count++;
+}
+
 static void
 test_items_added_callbacks(void)
 {
@@ -2423,8 +2445,146 @@ test_stable_sort(void)
     vlc_playlist_Delete(playlist);
 }
 
+static void
+test_sort_minimal_diff(void)
+{
+    vlc_playlist_t *playlist = vlc_playlist_New(NULL, VLC_PLAYLIST_PREPARSING_DISABLED, 0, 0);
+    assert(playlist);
+
+    input_item_t *media[150];
+    CreateDummyMediaArray(media, 150);
+    for (int i = 0; i < 150; ++i)
+        media[i]->i_duration = i + 1;
+
+    /* append in sorted-by-duration order, except items 70 and 74 swapped */
+    input_item_t *ordered[150];
+    for (int i = 0; i < 150; ++i)
+        ordered[i] = media[i];
+    ordered[70] = media[74];
+    ordered[74] = media[70];
+
+    int ret = vlc_playlist_Append(playlist, ordered, 150);
+    assert(ret == VLC_SUCCESS);
+
+    struct vlc_playlist_callbacks cbs = {
+        .on_items_reset = callback_on_items_reset,
+        .on_items_added = callback_on_items_added,
+        .on_items_removed = callback_on_items_removed,
+        .on_update_begin = callback_on_update_begin,
+        .on_update_end = callback_on_update_end,
+    };
+
+    struct callback_ctx ctx = CALLBACK_CTX_INITIALIZER;
+    vlc_playlist_listener_id *listener =
+            vlc_playlist_AddListener(playlist, &cbs, &ctx, false);
+    assert(listener);
+
+    struct vlc_playlist_sort_criterion criteria[] = {
+        { VLC_PLAYLIST_SORT_KEY_DURATION, VLC_PLAYLIST_SORT_ORDER_ASCENDING },
+    };
+    vlc_playlist_Sort(playlist, criteria, 1);
+
+    for (int i = 0; i < 150; ++i)
+        EXPECT_AT(i, i);
+
+    /* the playlist is large and only a small range changed: the reorder must
+     * be notified as a minimal diff surrounded by on_update_begin/end, not as
+     * a full reset */
+    assert(ctx.vec_items_reset.size == 0);
+    assert(ctx.vec_items_added.size > 0);
+    assert(ctx.vec_items_removed.size > 0);
+    assert(ctx.update_begin_count == 1);
+    assert(ctx.update_end_count == 1);
+
+    /* every diff event must stay within the changed range [70, 75), with a
+     * few indices of slack since insertions may temporarily shift the tail of
+     * the range while the diff is being applied */
+    for (size_t i = 0; i < ctx.vec_items_added.size; ++i)
+    {
+        assert(ctx.vec_items_added.data[i].index >= 70);
+        assert(ctx.vec_items_added.data[i].index
+                + ctx.vec_items_added.data[i].count <= 80);
+    }
+    for (size_t i = 0; i < ctx.vec_items_removed.size; ++i)
+    {
+        assert(ctx.vec_items_removed.data[i].index >= 70);
+        assert(ctx.vec_items_removed.data[i].index
+                + ctx.vec_items_removed.data[i].count <= 80);
+    }
+
+    callback_ctx_reset(&ctx);
+
+    /* sorting an already-sorted playlist must not notify any item event */
+    vlc_playlist_Sort(playlist, criteria, 1);
+
+    assert(ctx.vec_items_reset.size == 0);
+    assert(ctx.vec_items_added.size == 0);
+    assert(ctx.vec_items_removed.size == 0);
+    assert(ctx.update_begin_count == 1);
+    assert(ctx.update_end_count == 1);
+
+    callback_ctx_destroy(&ctx);
+    vlc_playlist_RemoveListener(playlist, listener);
+    DestroyMediaArray(media, 150);
+    vlc_playlist_Delete(playlist);
+}
+
 #undef EXPECT_AT
 
+static void
+test_snapshot(void)
+{
+    vlc_playlist_t *playlist = vlc_playlist_New(NULL, VLC_PLAYLIST_PREPARSING_DISABLED, 0, 0);
+    assert(playlist);
+
+    input_item_t *media[20];
+    CreateDummyMediaArray(media, 20);
+    for (int i = 0; i < 20; ++i)
+        media[i]->i_duration = i + 1;
+
+    int ret = vlc_playlist_Append(playlist, media, 20);
+    assert(ret == VLC_SUCCESS);
+
+    char path[] = "/tmp/libvlc_XXXXXX";
+    int fd = vlc_mkstemp(path);
+    assert(fd != -1);
+    close(fd);
+
+    ret = vlc_playlist_SaveSnapshot(playlist, path);
+    assert(ret == VLC_SUCCESS);
+
+    vlc_playlist_t *restored = vlc_playlist_New(NULL, VLC_PLAYLIST_PREPARSING_DISABLED, 0, 0);
+    assert(restored);
+
+    ret = vlc_playlist_LoadSnapshot(restored, path);
+    assert(ret == VLC_SUCCESS);
+    assert(vlc_playlist_Count(restored) == 20);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        input_item_t *copy = vlc_playlist_Get(restored, i)->media;
+        assert(copy != media[i]); /* new items, same content */
+        assert(!strcmp(copy->psz_uri, media[i]->psz_uri));
+        assert(!strcmp(copy->psz_name, media[i]->psz_name));
+        assert(copy->i_duration == media[i]->i_duration);
+    }
+
+    /* a corrupted snapshot is rejected and leaves the playlist intact */
+    FILE *file = fopen(path, "wb");
+    assert(file);
+    fwrite("garbage", 1, 7, file);
+    fclose(file);
+
+    ret = vlc_playlist_LoadSnapshot(restored, path);
+    assert(ret != VLC_SUCCESS);
+    assert(vlc_playlist_Count(restored) == 20);
+
+    unlink(path);
+    DestroyMediaArray(media, 20);
+    vlc_playlist_Delete(playlist);
+    vlc_playlist_Delete(restored);
+}
+
 int main(void)
 {
     test_append();
@@ -2458,7 +2618,9 @@ int main(void)
     test_random();
     test_shuffle();
     test_sort();
+    test_sort_minimal_diff();
     test_stable_sort();
+    test_snapshot();
     return 0;
 }
 
@@ -27,6 +27,9 @@
 
 #include <sys/stat.h>
 #include <errno.h>
+#ifndef _WIN32
+# include <unistd.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_configuration.h>
@@ -168,6 +171,54 @@ end:
     return psz_filename;
 }
 
+/* Path of the content-addressed canonical copy of an art blob. Identical
+ * art fetched for different items is stored there once and hard-linked
+ * into each per-item cache name. */
+static char *ArtCacheContentPath( const void *data, size_t length,
+                                  const char *psz_type )
+{
+    char *psz_cachedir = config_GetUserDir(VLC_CACHE_DIR);
+    if (unlikely(psz_cachedir == NULL))
+        return NULL;
+
+    char psz_hex[VLC_HASH_MD5_DIGEST_HEX_SIZE];
+    vlc_hash_md5_t md5;
+    vlc_hash_md5_Init( &md5 );
+    vlc_hash_md5_Update( &md5, data, length );
+    vlc_hash_FinishHex( &md5, psz_hex );
+
+    char *psz_file = NULL;
+    char *psz_ext = strdup( psz_type ? psz_type : "" );
+    if( likely(psz_ext != NULL) )
+    {
+        filename_sanitize( psz_ext );
+
+        char *psz_dir;
+        if( asprintf( &psz_dir, "%s" DIR_SEP "art" DIR_SEP "by-content",
+                      psz_cachedir ) != -1 )
+        {
+            ArtCacheCreateDir( psz_dir );
+            if( asprintf( &psz_file, "%s" DIR_SEP "%s%s",
+                          psz_dir, psz_hex, psz_ext ) == -1 )
+                psz_file = NULL;
+            free( psz_dir );
+        }
+        free( psz_ext );
+    }
+    free( psz_cachedir );
+    return psz_file;
+}
+
+static int ArtCacheLink( const char *psz_from, const char *psz_to )
+{
+#ifdef _WIN32
+    (void) psz_from; (void) psz_to;
+    return -1;
+#else
+    return link( psz_from, psz_to );
+#endif
+}
+
 /* */
 int input_FindArtInCache( input_item_t *p_item )
 {
@@ -302,20 +353,58 @@ int input_SaveArt( vlc_object_t *obj, input_item_t *p_item,
         return VLC_SUCCESS;
     }
 
-    /* Dump it otherwise */
-    FILE *f = vlc_fopen( psz_filename, "wb" );
-    if( f )
+    /* Dump it otherwise. Write (or reuse) the canonical content-addressed
+     * copy and hard-link it into the per-item name, so that duplicate art
+     * only consumes disk space once. */
+    bool b_saved = false;
+    char *psz_blob = ArtCacheContentPath( data, length, psz_type );
+    if( psz_blob != NULL )
     {
-        if( fwrite( data, 1, length, f ) != length )
+        bool b_blob_ok = !vlc_stat( psz_blob, &s );
+        if( !b_blob_ok )
         {
-            msg_Err( obj, "%s: %s", psz_filename, vlc_strerror_c(errno) );
+            FILE *f = vlc_fopen( psz_blob, "wb" );
+            if( f )
+            {
+                if( fwrite( data, 1, length, f ) != length )
+                {
+                    msg_Err( obj, "%s: %s", psz_blob, vlc_strerror_c(errno) );
+                    fclose( f );
+                    vlc_unlink( psz_blob );
+                }
+                else
+                {
+                    fclose( f );
+                    b_blob_ok = true;
+                }
+            }
         }
-        else
+        if( b_blob_ok && ArtCacheLink( psz_blob, psz_filename ) == 0 )
         {
             msg_Dbg( obj, "album art saved to %s", psz_filename );
             input_item_SetArtURL( p_item, psz_uri );
+            b_saved = true;
+        }
+        free( psz_blob );
+    }
+
+    if( !b_saved )
+    {
+        /* No hard links (Windows, cross-device cache): plain copy */
+        FILE *f = vlc_fopen( psz_filename, "wb" );
+        if( f )
+        {
+            if( fwrite( data, 1, length, f ) != length )
+            {
+                msg_Err( obj, "%s: %s", psz_filename, vlc_strerror_c(errno) );
+            }
+            else
+            {
+                msg_Dbg( obj, "album art saved to %s", psz_filename );
+                input_item_SetArtURL( p_item, psz_uri );
+            }
+            fclose( f );
         }
-        fclose( f );
     }
     free( psz_uri );
 
@@ -334,7 +423,7 @@ int input_SaveArt( vlc_object_t *obj, input_item_t *p_item,
 
     if ( psz_byuidfile )
     {
-        f = vlc_fopen( psz_byuidfile, "wb" );
+        FILE *f = vlc_fopen( psz_byuidfile, "wb" );
         if ( f )
         {
             if( fputs( "file://", f ) < 0 || fputs( psz_filename, f ) < 0 )
@@ -45,12 +45,19 @@ struct input_fetcher_t {
     vlc_executor_t *executor_downloader;
 
     vlc_dictionary_t album_cache;
+    vlc_dictionary_t negative_cache; /**< keys of failed network searches */
+    vlc_dictionary_t pending; /**< in-flight fetch per key, see FetcherCoalesce */
     vlc_object_t* owner;
 
     vlc_mutex_t lock;
     struct vlc_list submitted_tasks; /**< list of struct task */
 };
 
+/** In-flight fetch that identical requests coalesce behind */
+struct pending_fetch {
+    struct vlc_list waiters; /**< list of struct task.waiter_node */
+};
+
 struct task {
     input_fetcher_t *fetcher;
     vlc_executor_t *executor;
@@ -61,6 +68,9 @@ struct task {
 
     vlc_interrupt_t interrupt;
 
+    bool waiting; /**< parked behind an identical in-flight fetch */
+    struct vlc_list waiter_node; /**< node of struct pending_fetch.waiters */
+
     struct vlc_runnable runnable; /**< to be passed to the executor */
     struct vlc_list node; /**< node of input_fetcher_t.submitted_tasks */
 };
@@ -84,6 +94,7 @@ TaskNew(input_fetcher_t *fetcher, vlc_executor_t *executor, input_item_t *item,
     task->options = options;
     task->cbs = cbs;
     task->userdata = userdata;
+    task->waiting = false;
 
     vlc_interrupt_init(&task->interrupt);
 
@@ -216,6 +227,65 @@ static void AddAlbumCache( input_fetcher_t* fetcher, input_item_t* item,
     free( key );
 }
 
+/**
+ * Coalesces identical fetches: if a fetch for the same key is already
+ * running, parks the task behind it and returns true. Otherwise registers
+ * the task as the fetch leader and returns false; the caller must then
+ * call FetcherResolvePending() with the same key once the fetch is over,
+ * which resubmits the parked tasks (their results are then served from
+ * the caches the leader just filled).
+ */
+static bool FetcherCoalesce( input_fetcher_t* fetcher, struct task* task,
+                             char const* key )
+{
+    vlc_mutex_lock( &fetcher->lock );
+
+    struct pending_fetch* pending =
+        vlc_dictionary_value_for_key( &fetcher->pending, key );
+    if( pending != NULL )
+    {
+        task->waiting = true;
+        vlc_list_append( &task->waiter_node, &pending->waiters );
+        vlc_mutex_unlock( &fetcher->lock );
+        return true;
+    }
+
+    pending = malloc( sizeof( *pending ) );
+    if( likely( pending != NULL ) )
+    {
+        vlc_list_init( &pending->waiters );
+        vlc_dictionary_insert( &fetcher->pending, key, pending );
+    }
+    /* On allocation failure, simply fetch without coalescing */
+
+    vlc_mutex_unlock( &fetcher->lock );
+    return false;
+}
+
+static void FetcherResolvePending( input_fetcher_t* fetcher, char const* key )
+{
+    vlc_mutex_lock( &fetcher->lock );
+
+    struct pending_fetch* pending =
+        vlc_dictionary_value_for_key( &fetcher->pending, key );
+    if( pending != NULL )
+    {
+        vlc_dictionary_remove_value_for_key( &fetcher->pending, key,
+                                             NULL, NULL );
+
+        struct task* task;
+        vlc_list_foreach( task, &pending->waiters, waiter_node )
+        {
+            task->waiting = false;
+            vlc_list_remove( &task->waiter_node );
+            vlc_executor_Submit( task->executor, &task->runnable );
+        }
+        free( pending );
+    }
+
+    vlc_mutex_unlock( &fetcher->lock );
+}
+
 static int InvokeModule( input_fetcher_t* fetcher, input_item_t* item,
                          int scope, char const* type )
 {
@@ -303,8 +373,7 @@ static void RunDownloader(void *userdata)
     bool fetched = false;
     struct task *task = userdata;
     input_fetcher_t *fetcher = task->fetcher;
-
-    vlc_interrupt_set(&task->interrupt);
+    char *key = NULL;
 
     ReadAlbumCache( fetcher, task->item );
 
@@ -319,6 +388,19 @@ static void RunDownloader(void *userdata)
         goto out; /* no fetch required */
     }
 
+    /* Coalesce on the URL: one download per distinct art, the waiters are
+     * then served from the album cache the leader updates on success. */
+    if( asprintf( &key, "dl:%s", psz_arturl ) < 0 )
+        key = NULL;
+    if( key != NULL && FetcherCoalesce( fetcher, task, key ) )
+    {   /* Resubmitted by the leader once its download is over */
+        free( key );
+        free( psz_arturl );
+        return;
+    }
+
+    vlc_interrupt_set(&task->interrupt);
+
     stream_t* source = vlc_stream_NewURL( fetcher->owner, psz_arturl );
 
     if( !source )
@@ -362,6 +444,11 @@ out:
 
     if( fetched )
         input_item_SetArtFetched( task->item, true );
+    if( key != NULL )
+    {
+        FetcherResolvePending( fetcher, key );
+        free( key );
+    }
     free( psz_arturl );
     NotifyArtFetchEnded(task, fetched);
     FetcherRemoveTask(fetcher, task);
@@ -405,6 +492,31 @@ static void RunSearchNetwork(void *userdata)
     vlc_thread_set_name("vlc-run-searchn");
 
     struct task *task = userdata;
+    input_fetcher_t *fetcher = task->fetcher;
+    char *key = CreateCacheKey( task->item );
+
+    if( key != NULL )
+    {
+        vlc_mutex_lock( &fetcher->lock );
+        bool negative = vlc_dictionary_has_key( &fetcher->negative_cache, key );
+        vlc_mutex_unlock( &fetcher->lock );
+
+        if( negative )
+        {   /* A previous network search for this album already failed */
+            free( key );
+            input_item_SetArtNotFound( task->item, true );
+            NotifyArtFetchEnded(task, false);
+            FetcherRemoveTask(fetcher, task);
+            TaskDelete(task);
+            return;
+        }
+
+        if( FetcherCoalesce( fetcher, task, key ) )
+        {   /* Resubmitted by the leader once its search is over */
+            free( key );
+            return;
+        }
+    }
 
     vlc_interrupt_set(&task->interrupt);
 
@@ -412,11 +524,23 @@ static void RunSearchNetwork(void *userdata)
     {
         input_item_SetArtNotFound( task->item, true );
         NotifyArtFetchEnded(task, false);
+
+        if( key != NULL )
+        {
+            vlc_mutex_lock( &fetcher->lock );
+            if( !vlc_dictionary_has_key( &fetcher->negative_cache, key ) )
+                vlc_dictionary_insert( &fetcher->negative_cache, key, NULL );
+            vlc_mutex_unlock( &fetcher->lock );
+        }
     }
 
     vlc_interrupt_set(NULL);
 
-    input_fetcher_t *fetcher = task->fetcher;
+    if( key != NULL )
+    {
+        FetcherResolvePending( fetcher, key );
+        free( key );
+    }
     FetcherRemoveTask(fetcher, task);
     TaskDelete(task);
 }
@@ -478,6 +602,8 @@ input_fetcher_t* input_fetcher_New( vlc_object_t* owner,
     vlc_list_init(&fetcher->submitted_tasks);
 
     vlc_dictionary_init( &fetcher->album_cache, 0 );
+    vlc_dictionary_init( &fetcher->negative_cache, 0 );
+    vlc_dictionary_init( &fetcher->pending, 0 );
 
     return fetcher;
 }
@@ -507,6 +633,15 @@ CancelAllTasks(input_fetcher_t *fetcher)
     struct task *task;
     vlc_list_foreach(task, &fetcher->submitted_tasks, node)
     {
+        if (task->waiting)
+        {   /* Parked behind an in-flight fetch, not queued in the executor */
+            vlc_list_remove(&task->waiter_node);
+            NotifyArtFetchEnded(task, false);
+            vlc_list_remove(&task->node);
+            TaskDelete(task);
+            continue;
+        }
+
         bool canceled = vlc_executor_Cancel(task->executor, &task->runnable);
         if (canceled)
         {
@@ -532,5 +667,7 @@ void input_fetcher_Delete( input_fetcher_t* fetcher )
     vlc_executor_Delete(fetcher->executor_downloader);
 
     vlc_dictionary_clear( &fetcher->album_cache, FreeCacheEntry, NULL );
+    vlc_dictionary_clear( &fetcher->negative_cache, NULL, NULL );
+    vlc_dictionary_clear( &fetcher->pending, FreeCacheEntry, NULL );
     free( fetcher );
 }
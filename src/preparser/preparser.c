@@ -680,7 +680,10 @@ vlc_preparser_req_id vlc_preparser_Push( vlc_preparser_t *preparser, input_item_
     {
         vlc_preparser_req_id id = PreparserAddTask(preparser, task);
 
-        vlc_executor_Submit(preparser->parser, &task->runnable);
+        if (type_options & VLC_PREPARSER_OPTION_URGENT)
+            vlc_executor_SubmitUrgent(preparser->parser, &task->runnable);
+        else
+            vlc_executor_Submit(preparser->parser, &task->runnable);
 
         return id;
     }
@@ -40,6 +40,11 @@
 #include "snapshot.h"
 #include "vout_internal.h"
 
+/* Maximum number of queued asynchronous save requests per vout */
+#define VOUT_SNAPSHOT_PENDING_MAX 4
+/* Queued requests not serviced within this delay are dropped */
+#define VOUT_SNAPSHOT_STALE_DELAY VLC_TICK_FROM_SEC(2)
+
 struct vout_snapshot {
     vlc_mutex_t lock;
     vlc_cond_t  wait;
@@ -47,6 +52,17 @@ struct vout_snapshot {
     bool        is_available;
     int         request_count;
     vlc_picture_chain_t pics;
+
+    /* Asynchronous save worker */
+    struct {
+        vlc_thread_t  thread;
+        bool          running;
+        bool          exiting;
+        vout_thread_t *vout;
+        void        (*save)(vout_thread_t *);
+        unsigned      pending;
+        vlc_tick_t    dates[VOUT_SNAPSHOT_PENDING_MAX];
+    } worker;
 };
 
 vout_snapshot_t *vout_snapshot_New(void)
@@ -61,14 +77,33 @@ vout_snapshot_t *vout_snapshot_New(void)
     snap->is_available = true;
     snap->request_count = 0;
     vlc_picture_chain_Init( &snap->pics );
+
+    snap->worker.running = false;
+    snap->worker.exiting = false;
+    snap->worker.pending = 0;
     return snap;
 }
 
+static void vout_snapshot_StopWorker(vout_snapshot_t *snap)
+{
+    vlc_mutex_lock(&snap->lock);
+    snap->worker.exiting = true;
+    const bool join = snap->worker.running;
+    snap->worker.running = false;
+    vlc_cond_broadcast(&snap->wait);
+    vlc_mutex_unlock(&snap->lock);
+
+    if (join)
+        vlc_join(snap->worker.thread, NULL);
+}
+
 void vout_snapshot_Destroy(vout_snapshot_t *snap)
 {
     if (snap == NULL)
         return;
 
+    vout_snapshot_StopWorker(snap);
+
     while ( !vlc_picture_chain_IsEmpty( &snap->pics ) ) {
         picture_t *picture = vlc_picture_chain_PopFront( &snap->pics );
         picture_Release(picture);
@@ -88,6 +123,10 @@ void vout_snapshot_End(vout_snapshot_t *snap)
 
     vlc_cond_broadcast(&snap->wait);
     vlc_mutex_unlock(&snap->lock);
+
+    /* The vout is being closed, pending requests cannot be serviced
+     * anymore (vout_snapshot_Get() will fail immediately). */
+    vout_snapshot_StopWorker(snap);
 }
 
 /* */
@@ -154,6 +193,75 @@ void vout_snapshot_Set(vout_snapshot_t *snap,
     vlc_cond_broadcast(&snap->wait);
     vlc_mutex_unlock(&snap->lock);
 }
+static void *vout_snapshot_WorkerThread(void *data)
+{
+    vout_snapshot_t *snap = data;
+
+    vlc_thread_set_name("vlc-snapshot");
+
+    vlc_mutex_lock(&snap->lock);
+    for (;;) {
+        while (!snap->worker.exiting && snap->worker.pending == 0)
+            vlc_cond_wait(&snap->wait, &snap->lock);
+        if (snap->worker.exiting)
+            break;
+
+        const vlc_tick_t date = snap->worker.dates[0];
+        snap->worker.pending--;
+        memmove(&snap->worker.dates[0], &snap->worker.dates[1],
+                snap->worker.pending * sizeof (snap->worker.dates[0]));
+
+        /* Stale requests are worthless, the snapshot would no longer show
+         * what was on screen when it was asked for. */
+        if (vlc_tick_now() - date > VOUT_SNAPSHOT_STALE_DELAY)
+            continue;
+
+        vout_thread_t *vout = snap->worker.vout;
+        void (*save)(vout_thread_t *) = snap->worker.save;
+        vlc_mutex_unlock(&snap->lock);
+
+        save(vout);
+
+        vlc_mutex_lock(&snap->lock);
+    }
+    vlc_mutex_unlock(&snap->lock);
+    return NULL;
+}
+
+int vout_snapshot_SaveAsync(vout_snapshot_t *snap, vout_thread_t *vout,
+                            void (*save)(vout_thread_t *))
+{
+    if (snap == NULL)
+        return VLC_EGENERIC;
+
+    vlc_mutex_lock(&snap->lock);
+    if (!snap->is_available || snap->worker.exiting) {
+        vlc_mutex_unlock(&snap->lock);
+        return VLC_EGENERIC;
+    }
+
+    if (!snap->worker.running) {
+        snap->worker.vout = vout;
+        snap->worker.save = save;
+        if (vlc_clone(&snap->worker.thread,
+                      vout_snapshot_WorkerThread, snap)) {
+            vlc_mutex_unlock(&snap->lock);
+            return VLC_EGENERIC;
+        }
+        snap->worker.running = true;
+    }
+    assert(snap->worker.vout == vout && snap->worker.save == save);
+
+    /* Bounded queue: coalesce requests when the worker cannot keep up */
+    if (snap->worker.pending < VOUT_SNAPSHOT_PENDING_MAX) {
+        snap->worker.dates[snap->worker.pending++] = vlc_tick_now();
+        vlc_cond_broadcast(&snap->wait);
+    }
+    vlc_mutex_unlock(&snap->lock);
+
+    return VLC_SUCCESS;
+}
+
 /* */
 char *vout_snapshot_GetDirectory(void)
 {
@@ -50,6 +50,17 @@ bool vout_snapshot_IsRequested(vout_snapshot_t *);
  */
 void vout_snapshot_Set(vout_snapshot_t *, const video_format_t *, picture_t *);
 
+/**
+ * It queues a snapshot request serviced by a dedicated worker thread.
+ *
+ * The save callback runs outside of the calling and vout threads, so neither
+ * is stalled by the picture conversion and image encoding. Requests beyond an
+ * internal bound are coalesced, and requests the worker could not service in
+ * time are dropped.
+ */
+int vout_snapshot_SaveAsync(vout_snapshot_t *, vout_thread_t *,
+                            void (*save)(vout_thread_t *));
+
 /**
  * This function will return the directory used for snapshots
  */
@@ -24,6 +24,28 @@
 # define LIBVLC_VOUT_STATISTIC_H
 # include <stdatomic.h>
 
+# include <vlc_ancillary.h>
+
+/* Frame pacing error histogram: |display date - actual wakeup| buckets,
+ * plus the number of early wakeups and the worst error seen. Upper bucket
+ * bounds, the last one being a catch-all. */
+# define VOUT_STATISTIC_PACING_BUCKETS 5
+static const vlc_tick_t vout_statistic_pacing_bounds[VOUT_STATISTIC_PACING_BUCKETS - 1] = {
+    VLC_TICK_FROM_US(50), VLC_TICK_FROM_US(200),
+    VLC_TICK_FROM_MS(1),  VLC_TICK_FROM_MS(5),
+};
+
+/* Per-frame QoS ledger ("frame-qos"): latency histograms between consecutive
+ * pipeline stages of the vlc_frame_qos_t stamps. Upper bucket bounds, the
+ * last one being a catch-all. */
+# define VOUT_STATISTIC_QOS_SPANS (VLC_FRAME_QOS_STAGE_COUNT - 1)
+# define VOUT_STATISTIC_QOS_BUCKETS 8
+static const vlc_tick_t vout_statistic_qos_bounds[VOUT_STATISTIC_QOS_BUCKETS - 1] = {
+    VLC_TICK_FROM_MS(1),  VLC_TICK_FROM_MS(2),  VLC_TICK_FROM_MS(5),
+    VLC_TICK_FROM_MS(10), VLC_TICK_FROM_MS(20), VLC_TICK_FROM_MS(50),
+    VLC_TICK_FROM_MS(100),
+};
+
 /* NOTE: Both statistics are atomic on their own, so one might be older than
  * the other one. Currently, only one of them is updated at a time, so this
  * is a non-issue. */
@@ -31,6 +53,10 @@ typedef struct {
     atomic_uint displayed;
     atomic_uint lost;
     atomic_uint late;
+    atomic_uint pacing_early;
+    atomic_uint pacing[VOUT_STATISTIC_PACING_BUCKETS];
+    atomic_llong pacing_worst;
+    atomic_uint qos[VOUT_STATISTIC_QOS_SPANS][VOUT_STATISTIC_QOS_BUCKETS];
 } vout_statistic_t;
 
 static inline void vout_statistic_Init(vout_statistic_t *stat)
@@ -38,6 +64,13 @@ static inline void vout_statistic_Init(vout_statistic_t *stat)
     atomic_init(&stat->displayed, 0);
     atomic_init(&stat->lost, 0);
     atomic_init(&stat->late, 0);
+    atomic_init(&stat->pacing_early, 0);
+    for (int i = 0; i < VOUT_STATISTIC_PACING_BUCKETS; i++)
+        atomic_init(&stat->pacing[i], 0);
+    atomic_init(&stat->pacing_worst, 0);
+    for (int span = 0; span < VOUT_STATISTIC_QOS_SPANS; span++)
+        for (int i = 0; i < VOUT_STATISTIC_QOS_BUCKETS; i++)
+            atomic_init(&stat->qos[span][i], 0);
 }
 
 static inline void vout_statistic_Clean(vout_statistic_t *stat)
@@ -73,4 +106,86 @@ static inline void vout_statistic_AddLate(vout_statistic_t *stat, int late)
     atomic_fetch_add_explicit(&stat->late, late, memory_order_relaxed);
 }
 
+/**
+ * Records one frame pacing measurement.
+ *
+ * \param error difference between the actual wakeup and the intended
+ *              display date, negative when the thread woke up early
+ */
+static inline void vout_statistic_AddPacing(vout_statistic_t *stat,
+                                            vlc_tick_t error)
+{
+    if (error < 0)
+    {
+        atomic_fetch_add_explicit(&stat->pacing_early, 1,
+                                  memory_order_relaxed);
+        error = -error;
+    }
+
+    int bucket = 0;
+    while (bucket < VOUT_STATISTIC_PACING_BUCKETS - 1
+        && error >= vout_statistic_pacing_bounds[bucket])
+        bucket++;
+    atomic_fetch_add_explicit(&stat->pacing[bucket], 1, memory_order_relaxed);
+
+    long long worst = atomic_load_explicit(&stat->pacing_worst,
+                                           memory_order_relaxed);
+    while (error > worst
+        && !atomic_compare_exchange_weak_explicit(&stat->pacing_worst, &worst,
+                                                  error, memory_order_relaxed,
+                                                  memory_order_relaxed));
+}
+
+/**
+ * Aggregates one displayed frame QoS ledger into the stage histograms.
+ *
+ * Stages that were never stamped (or stamped out of order, e.g. after a
+ * preroll flush) are skipped.
+ */
+static inline void vout_statistic_AddFrameQos(vout_statistic_t *stat,
+                                              const vlc_frame_qos_t *qos)
+{
+    for (int span = 0; span < VOUT_STATISTIC_QOS_SPANS; span++)
+    {
+        vlc_tick_t from = qos->stages[span];
+        vlc_tick_t to = qos->stages[span + 1];
+        if (from == VLC_TICK_INVALID || to == VLC_TICK_INVALID || to < from)
+            continue;
+
+        int bucket = 0;
+        while (bucket < VOUT_STATISTIC_QOS_BUCKETS - 1
+            && to - from >= vout_statistic_qos_bounds[bucket])
+            bucket++;
+        atomic_fetch_add_explicit(&stat->qos[span][bucket], 1,
+                                  memory_order_relaxed);
+    }
+}
+
+/**
+ * Snapshots the frame QoS stage histograms.
+ */
+static inline void vout_statistic_GetFrameQos(vout_statistic_t *stat,
+        unsigned counts[VOUT_STATISTIC_QOS_SPANS][VOUT_STATISTIC_QOS_BUCKETS])
+{
+    for (int span = 0; span < VOUT_STATISTIC_QOS_SPANS; span++)
+        for (int i = 0; i < VOUT_STATISTIC_QOS_BUCKETS; i++)
+            counts[span][i] = atomic_load_explicit(&stat->qos[span][i],
+                                                   memory_order_relaxed);
+}
+
+/**
+ * Snapshots the pacing error histogram.
+ */
+static inline void vout_statistic_GetPacing(vout_statistic_t *stat,
+                                            unsigned buckets[VOUT_STATISTIC_PACING_BUCKETS],
+                                            unsigned *restrict early,
+                                            vlc_tick_t *restrict worst)
+{
+    for (int i = 0; i < VOUT_STATISTIC_PACING_BUCKETS; i++)
+        buckets[i] = atomic_load_explicit(&stat->pacing[i],
+                                          memory_order_relaxed);
+    *early = atomic_load_explicit(&stat->pacing_early, memory_order_relaxed);
+    *worst = atomic_load_explicit(&stat->pacing_worst, memory_order_relaxed);
+}
+
 #endif
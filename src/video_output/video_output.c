@@ -42,6 +42,12 @@
 #include <string.h>
 #include <assert.h>
 
+#ifdef __linux__
+# include <sched.h>
+# include <errno.h>
+# include <sys/prctl.h>
+#endif
+
 #include <vlc_vout.h>
 
 #include <vlc_filter.h>
@@ -143,6 +149,7 @@ typedef struct vout_thread_sys_t
     bool            window_enabled;
     unsigned        window_width; /* protected by display_lock */
     unsigned        window_height; /* protected by display_lock */
+    atomic_uint     window_resize_gen; /* latest resize request, to coalesce storms */
     vlc_mutex_t     window_lock;
     vlc_decoder_device *dec_device;
 
@@ -440,6 +447,13 @@ int vout_GetSnapshot(vout_thread_t *vout,
     return VLC_SUCCESS;
 }
 
+int vout_RequestSnapshot(vout_thread_t *vout, void (*save)(vout_thread_t *))
+{
+    vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
+    assert(!sys->dummy);
+    return vout_snapshot_SaveAsync(sys->snapshot, vout, save);
+}
+
 /* vout_Control* are usable by anyone at anytime */
 void vout_ChangeFullscreen(vout_thread_t *vout, const char *id)
 {
@@ -478,16 +492,30 @@ void vout_ChangeDisplaySize(vout_thread_t *vout,
 
     assert(!sys->dummy);
 
+    /* Window providers may emit resize events faster than the display can
+     * resize (e.g. during interactive window drags). Resizing is
+     * last-writer-wins, so tag each request and only apply the most recent
+     * one; superseded requests are merely acknowledged. This keeps the
+     * display lock critical section of stale requests trivial and thus
+     * bounds how long a resize storm can delay the rendering thread. */
+    unsigned gen = atomic_fetch_add_explicit(&sys->window_resize_gen, 1,
+                                             memory_order_relaxed) + 1;
+
     VoutRenderWakeUpUrgent(sys);
 
     /* DO NOT call this outside the vout window callbacks */
     vlc_queuedmutex_lock(&sys->display_lock);
 
-    sys->window_width = width;
-    sys->window_height = height;
+    if (atomic_load_explicit(&sys->window_resize_gen,
+                             memory_order_relaxed) == gen)
+    {
+        sys->window_width = width;
+        sys->window_height = height;
 
-    if (sys->display != NULL)
-        vout_display_SetSize(sys->display, width, height);
+        if (sys->display != NULL)
+            vout_display_SetSize(sys->display, width, height);
+    }
+    /* else a newer resize request is pending: let its owner apply it */
 
     if (cb != NULL)
         cb(opaque);
@@ -1053,7 +1081,25 @@ static picture_t *PreparePicture(vout_thread_sys_t *vout, bool reuse_decoded,
                 vlc_video_context *pic_vctx = picture_GetVideoContext(decoded);
                 sys->filter.src_vctx = pic_vctx ? vlc_video_context_Hold(pic_vctx) : NULL;
 
-                ChangeFilters(vout);
+                /* Try renegotiating the existing filters in place first: a
+                 * full rebuild pays module probing for every filter and shows
+                 * up as a gap on adaptive streams switching formats. */
+                es_format_t fmt_src;
+                es_format_InitFromVideo(&fmt_src, &sys->filter.src_fmt);
+
+                if (filter_chain_ChangeFormat(sys->filter.chain_static,
+                                              &fmt_src, sys->filter.src_vctx,
+                                              &fmt_src) != VLC_SUCCESS
+                 || filter_chain_ChangeFormat(sys->filter.chain_interactive,
+                            filter_chain_GetFmtOut(sys->filter.chain_static),
+                            filter_chain_GetVideoCtxOut(sys->filter.chain_static),
+                            &fmt_src) != VLC_SUCCESS
+                 || !es_format_IsSimilar(
+                            filter_chain_GetFmtOut(sys->filter.chain_interactive),
+                            &fmt_src))
+                    ChangeFilters(vout);
+
+                es_format_Clean(&fmt_src);
             }
         }
 
@@ -1343,6 +1389,19 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
     if (!filtered)
         return VLC_EGENERIC;
 
+    /* Per-frame QoS ledger: hold the ancillary since the blend/convert
+     * steps below may release the filtered picture before the display. */
+    struct vlc_ancillary *qos_anc =
+        picture_GetAncillary(filtered, VLC_ANCILLARY_ID_FRAMEQOS);
+    vlc_frame_qos_t *qos = NULL;
+    if (unlikely(qos_anc != NULL))
+    {
+        vlc_ancillary_Hold(qos_anc);
+        qos = vlc_ancillary_GetData(qos_anc);
+        if (qos->stages[VLC_FRAME_QOS_FILTER_END] == VLC_TICK_INVALID)
+            qos->stages[VLC_FRAME_QOS_FILTER_END] = vlc_tick_now();
+    }
+
     vlc_clock_Lock(sys->clock);
     sys->clock_nowait = false;
     vlc_clock_Unlock(sys->clock);
@@ -1354,6 +1413,8 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
     if (ret != VLC_SUCCESS)
     {
         vlc_queuedmutex_unlock(&sys->display_lock);
+        if (qos_anc != NULL)
+            vlc_ancillary_Release(qos_anc);
         return ret;
     }
 
@@ -1374,12 +1435,25 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
     const unsigned frame_rate = todisplay->format.i_frame_rate;
     const unsigned frame_rate_base = todisplay->format.i_frame_rate_base;
 
+    struct vlc_tracer *tracer = GetTracer(sys);
+
     if (vd->ops->prepare != NULL)
+    {
+        if (tracer != NULL)
+            vlc_tracer_TraceSpanBegin(tracer, "RENDER", sys->str_id,
+                                      "prepare", pts);
         vd->ops->prepare(vd, todisplay, subpic, system_pts);
+        if (tracer != NULL)
+            vlc_tracer_TraceSpanEnd(tracer, "RENDER", sys->str_id,
+                                    "prepare", pts);
+    }
 
     vout_chrono_Stop(&sys->chrono.render);
 
-    struct vlc_tracer *tracer = GetTracer(sys);
+    if (unlikely(qos != NULL)
+     && qos->stages[VLC_FRAME_QOS_RENDER] == VLC_TICK_INVALID)
+        qos->stages[VLC_FRAME_QOS_RENDER] = vlc_tick_now();
+
     system_now = vlc_tick_now();
     if (!render_now)
     {
@@ -1432,6 +1506,13 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
                 timed_out = vlc_clock_Wait(sys->clock, deadline);
             }
             vlc_clock_Unlock(sys->clock);
+
+            /* Measure the frame pacing error: how far from the display
+             * date the thread actually resumed. Redisplay polls clamped
+             * to max_deadline are not frame deadlines, skip them. */
+            if (timed_out && system_pts != max_deadline)
+                vout_statistic_AddPacing(&sys->statistic,
+                                         vlc_tick_now() - system_pts);
         }
         sys->displayed.date = system_pts;
     }
@@ -1441,7 +1522,13 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
     }
 
     /* Display the direct buffer returned by vout_RenderPicture */
+    if (tracer != NULL)
+        vlc_tracer_TraceSpanBegin(tracer, "RENDER", sys->str_id,
+                                  "display", pts);
     vout_display_Display(vd, todisplay);
+    if (tracer != NULL)
+        vlc_tracer_TraceSpanEnd(tracer, "RENDER", sys->str_id,
+                                "display", pts);
     vlc_clock_Lock(sys->clock);
     vlc_tick_t drift = vlc_clock_UpdateVideo(sys->clock,
                                              vlc_tick_now(),
@@ -1458,6 +1545,17 @@ static int RenderPicture(vout_thread_sys_t *sys, bool render_now)
 
     vout_statistic_AddDisplayed(&sys->statistic, 1);
 
+    if (unlikely(qos != NULL))
+    {
+        /* Aggregate once per frame, not per redisplay */
+        if (qos->stages[VLC_FRAME_QOS_DISPLAY] == VLC_TICK_INVALID)
+        {
+            qos->stages[VLC_FRAME_QOS_DISPLAY] = vlc_tick_now();
+            vout_statistic_AddFrameQos(&sys->statistic, qos);
+        }
+        vlc_ancillary_Release(qos_anc);
+    }
+
     if (tracer != NULL && system_pts != VLC_TICK_MAX)
         vlc_tracer_TraceWithTs(tracer, system_pts,
                                VLC_TRACE("type", "RENDER"),
@@ -1888,6 +1986,111 @@ error:
  * terminated. It handles the pictures arriving in the video heap and the
  * display device events.
  *****************************************************************************/
+static void DumpPacingStatistics(vout_thread_sys_t *sys)
+{
+    unsigned buckets[VOUT_STATISTIC_PACING_BUCKETS];
+    unsigned early;
+    vlc_tick_t worst;
+
+    vout_statistic_GetPacing(&sys->statistic, buckets, &early, &worst);
+
+    unsigned total = 0;
+    for (int i = 0; i < VOUT_STATISTIC_PACING_BUCKETS; i++)
+        total += buckets[i];
+    if (total == 0)
+        return;
+
+    msg_Dbg(&sys->obj, "frame pacing: %u waits, worst error %"PRId64" us, "
+            "%u early wakeups", total, US_FROM_VLC_TICK(worst), early);
+    msg_Dbg(&sys->obj, "frame pacing histogram: <50us: %u, <200us: %u, "
+            "<1ms: %u, <5ms: %u, >=5ms: %u",
+            buckets[0], buckets[1], buckets[2], buckets[3], buckets[4]);
+}
+
+static void DumpFrameQosStatistics(vout_thread_sys_t *sys)
+{
+    /* Consecutive vlc_frame_qos_stage spans */
+    static const char *const span_names[VOUT_STATISTIC_QOS_SPANS] = {
+        "decoder fifo wait", "decode", "vout queue + static filters",
+        "interactive filters + prepare", "display wait",
+    };
+    unsigned counts[VOUT_STATISTIC_QOS_SPANS][VOUT_STATISTIC_QOS_BUCKETS];
+
+    vout_statistic_GetFrameQos(&sys->statistic, counts);
+
+    for (int span = 0; span < VOUT_STATISTIC_QOS_SPANS; span++)
+    {
+        unsigned total = 0;
+        for (int i = 0; i < VOUT_STATISTIC_QOS_BUCKETS; i++)
+            total += counts[span][i];
+        if (total == 0)
+            continue;
+
+        msg_Dbg(&sys->obj, "frame qos (%s): %u frames, <1ms: %u, <2ms: %u, "
+                "<5ms: %u, <10ms: %u, <20ms: %u, <50ms: %u, <100ms: %u, "
+                ">=100ms: %u", span_names[span], total,
+                counts[span][0], counts[span][1], counts[span][2],
+                counts[span][3], counts[span][4], counts[span][5],
+                counts[span][6], counts[span][7]);
+    }
+}
+
+#ifdef __linux__
+/* Restrict the calling thread to the CPU set described by the
+ * "vout-cpu-affinity" list, e.g. "0,2,8-11". */
+static void ThreadSetAffinity(vout_thread_sys_t *vout)
+{
+    char *conf = var_InheritString(&vout->obj, "vout-cpu-affinity");
+    if (conf == NULL)
+        return;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+
+    bool valid = false;
+    const char *p = conf;
+    while (*p != '\0') {
+        char *end;
+        unsigned long first = strtoul(p, &end, 10);
+        if (end == p) {
+            valid = false;
+            break;
+        }
+
+        unsigned long last = first;
+        if (*end == '-') {
+            p = end + 1;
+            last = strtoul(p, &end, 10);
+            if (end == p || last < first) {
+                valid = false;
+                break;
+            }
+        }
+
+        for (unsigned long cpu = first; cpu <= last; cpu++)
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+                valid = true;
+            }
+
+        if (*end == '\0')
+            break;
+        if (*end != ',') {
+            valid = false;
+            break;
+        }
+        p = end + 1;
+    }
+
+    if (!valid)
+        msg_Warn(&vout->obj, "invalid CPU affinity list \"%s\"", conf);
+    else if (sched_setaffinity(0, sizeof (cpus), &cpus) != 0)
+        msg_Warn(&vout->obj, "cannot set CPU affinity: %s",
+                 vlc_strerror_c(errno));
+    free(conf);
+}
+#endif
+
 static void *Thread(void *object)
 {
     vout_thread_sys_t *vout = object;
@@ -1895,6 +2098,19 @@ static void *Thread(void *object)
 
     vlc_thread_set_name("vlc-vout");
 
+#if defined(__linux__) && defined(PR_SET_TIMERSLACK)
+    /* The default timer slack lets the kernel coalesce our pacing waits
+     * with other timers, which shows up as milliseconds of judder on low
+     * frame rate content when no vsync throttles the display. */
+    int64_t slack = var_InheritInteger(&vout->obj, "vout-timer-slack");
+    if (slack >= 0)
+        prctl(PR_SET_TIMERSLACK, (unsigned long)slack, 0, 0, 0);
+
+    /* Keep rendering on the requested CPUs (e.g. the NUMA node close to the
+     * display adapter) on multi-socket machines. */
+    ThreadSetAffinity(vout);
+#endif
+
     vlc_tick_t deadline = VLC_TICK_INVALID;
 
     for (;;) {
@@ -1916,6 +2132,9 @@ static void *Thread(void *object)
 
         vout_SetInterlacingState(&vout->obj, &sys->interlacing, picture_interlaced);
     }
+
+    DumpPacingStatistics(sys);
+    DumpFrameQosStatistics(sys);
     return NULL;
 }
 
@@ -2174,6 +2393,7 @@ vout_thread_t *vout_Create(vlc_object_t *object)
 
     /* Window */
     sys->window_width = sys->window_height = 0;
+    atomic_init(&sys->window_resize_gen, 0);
     sys->display_cfg.window = vout_display_window_New(vout);
     if (sys->display_cfg.window == NULL) {
         if (sys->spu)
@@ -2386,3 +2606,15 @@ vlc_decoder_device *vout_GetDevice(vout_thread_t *vout)
     vlc_mutex_unlock(&sys->window_lock);
     return dec_device;
 }
+
+vlc_fourcc_t vout_GetDisplayChroma(vout_thread_t *vout)
+{
+    vout_thread_sys_t *sys = VOUT_THREAD_TO_SYS(vout);
+    vlc_fourcc_t chroma = 0;
+
+    vlc_queuedmutex_lock(&sys->display_lock);
+    if (sys->display != NULL)
+        chroma = sys->display->fmt->i_chroma;
+    vlc_queuedmutex_unlock(&sys->display_lock);
+    return chroma;
+}
@@ -60,6 +60,14 @@ vout_thread_t *vout_CreateDummy(vlc_object_t *obj) VLC_USED;
  */
 vlc_decoder_device *vout_GetDevice(vout_thread_t *vout);
 
+/**
+ * Get the chroma of the running display.
+ *
+ * \param vout the vout to query
+ * \return the display chroma, or 0 when the display is not started
+ */
+vlc_fourcc_t vout_GetDisplayChroma(vout_thread_t *vout);
+
 /**
  * Returns a suitable vout or release the given one.
  *
@@ -171,6 +179,14 @@ void vout_IntfReinit( vout_thread_t * );
 void vout_IntfDeinit(vlc_object_t *);
 enum vlc_video_fitting var_InheritFit(vlc_object_t *);
 
+/**
+ * Queues an asynchronous snapshot save request.
+ *
+ * \param save callback performing the actual save, called from the snapshot
+ *             worker thread, cf. vout_snapshot_SaveAsync()
+ */
+int vout_RequestSnapshot(vout_thread_t *, void (*save)(vout_thread_t *));
+
 /* */
 ssize_t vout_RegisterSubpictureChannelInternal( vout_thread_t *,
                                                 vlc_clock_t *clock,
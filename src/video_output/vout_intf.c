@@ -672,7 +672,10 @@ static int SnapshotCallback( vlc_object_t *p_this, char const *psz_cmd,
     VLC_UNUSED(psz_cmd); VLC_UNUSED(oldval);
     VLC_UNUSED(newval); VLC_UNUSED(p_data);
 
-    VoutSaveSnapshot( p_vout );
+    /* Save asynchronously so that neither the caller nor the vout get
+     * stalled by the conversion and encoding of the picture */
+    if( vout_RequestSnapshot( p_vout, VoutSaveSnapshot ) )
+        VoutSaveSnapshot( p_vout );
     return VLC_SUCCESS;
 }
 
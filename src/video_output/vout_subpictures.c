@@ -31,6 +31,7 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <stdatomic.h>
 
 #include <vlc_common.h>
 #include <vlc_filter.h>
@@ -75,6 +76,7 @@ struct spu_channel {
 typedef struct VLC_VECTOR(struct spu_channel) spu_channel_vector;
 typedef struct VLC_VECTOR(subpicture_t *) spu_prerender_vector;
 #define SPU_CHROMALIST_COUNT 10
+#define SPU_TEXT_CACHE_SIZE 8
 
 struct subtitle_position_cache
 {
@@ -93,6 +95,22 @@ struct spu_private_t {
     int channel;             /**< number of subpicture channels registered */
     filter_t *text;                              /**< text renderer module */
     vlc_mutex_t textlock;
+    /* Rendered text regions cache, keyed by a hash of the text segments and
+     * rendering parameters, guarded by \ref textlock. Avoids re-rasterizing
+     * identical cues re-submitted by sub sources (marquee, OSD) or decoders. */
+    struct spu_text_cache_entry {
+        uint64_t hash;
+        uint64_t age;
+        picture_t *picture;                   /**< NULL for unused entries */
+        video_format_t fmt;
+        bool b_absolute;
+        int i_x, i_y;
+        int i_align;
+        int i_alpha;
+        int text_flags;
+        int i_max_width, i_max_height;
+    } text_cache[SPU_TEXT_CACHE_SIZE];
+    uint64_t text_cache_age;
     filter_t *scale_yuvp;                     /**< scaling module for YUVP */
     filter_t *scale;                    /**< scaling module (all but YUVP) */
     bool force_crop;                     /**< force cropping of subpicture */
@@ -140,6 +158,12 @@ struct spu_private_t {
         bool            live;
     } prerender;
 
+    /* Region sharing statistics, reported at destruction. Output regions
+     * reference the source (or cached scaled) pixels; a pixel copy only
+     * happens when the scaler has to run. */
+    atomic_uint_least64_t stat_regions_output; /**< regions sent to display */
+    atomic_uint_least64_t stat_regions_scaled;  /**< scaler pixel copies */
+
     /* */
     vlc_tick_t          last_sort_date;
     vout_thread_t       *vout;
@@ -398,6 +422,175 @@ static void region_FixFmt(subpicture_region_t *region)
         region->p_picture->format.color_range = COLOR_RANGE_FULL;
 }
 
+/* FNV-1a */
+static uint64_t spu_TextHash(uint64_t h, const void *data, size_t len)
+{
+    const unsigned char *p = data;
+
+    while (len-- > 0)
+        h = (h ^ *p++) * UINT64_C(0x100000001b3);
+    return h;
+}
+
+static uint64_t spu_TextHashString(uint64_t h, const char *str)
+{
+    /* Include the terminator so that NULL, "" and concatenations differ */
+    unsigned char nul = 0xff;
+
+    if (str != NULL)
+        h = spu_TextHash(h, str, strlen(str) + 1);
+    return spu_TextHash(h, &nul, 1);
+}
+
+static uint64_t spu_TextStyleHash(uint64_t h, const text_style_t *style)
+{
+    if (style == NULL)
+        return spu_TextHashString(h, NULL);
+
+    h = spu_TextHashString(h, style->psz_fontname);
+    h = spu_TextHashString(h, style->psz_monofontname);
+#define HASH_FIELD(f) h = spu_TextHash(h, &style->f, sizeof (style->f))
+    HASH_FIELD(i_features);
+    HASH_FIELD(i_style_flags);
+    HASH_FIELD(f_font_relsize);
+    HASH_FIELD(i_font_size);
+    HASH_FIELD(i_font_color);
+    HASH_FIELD(i_font_alpha);
+    HASH_FIELD(i_spacing);
+    HASH_FIELD(i_outline_color);
+    HASH_FIELD(i_outline_alpha);
+    HASH_FIELD(i_outline_width);
+    HASH_FIELD(i_shadow_color);
+    HASH_FIELD(i_shadow_alpha);
+    HASH_FIELD(i_shadow_width);
+    HASH_FIELD(i_background_color);
+    HASH_FIELD(i_background_alpha);
+    HASH_FIELD(e_wrapinfo);
+#undef HASH_FIELD
+    return h;
+}
+
+static uint64_t spu_TextRegionHash(const subpicture_region_t *region,
+                                   unsigned output_width,
+                                   unsigned output_height,
+                                   const vlc_fourcc_t *chroma_list)
+{
+    uint64_t h = UINT64_C(0xcbf29ce484222325);
+
+#define HASH_FIELD(f) h = spu_TextHash(h, &region->f, sizeof (region->f))
+    HASH_FIELD(b_absolute);
+    HASH_FIELD(i_x);
+    HASH_FIELD(i_y);
+    HASH_FIELD(i_align);
+    HASH_FIELD(i_alpha);
+    HASH_FIELD(text_flags);
+    HASH_FIELD(i_max_width);
+    HASH_FIELD(i_max_height);
+#undef HASH_FIELD
+    h = spu_TextHash(h, &output_width, sizeof (output_width));
+    h = spu_TextHash(h, &output_height, sizeof (output_height));
+    for (int i = 0; chroma_list[i] != 0; i++)
+        h = spu_TextHash(h, &chroma_list[i], sizeof (chroma_list[i]));
+
+    for (const text_segment_t *seg = region->p_text;
+         seg != NULL; seg = seg->p_next)
+    {
+        h = spu_TextHashString(h, seg->psz_text);
+        h = spu_TextStyleHash(h, seg->style);
+        for (const text_segment_ruby_t *ruby = seg->p_ruby;
+             ruby != NULL; ruby = ruby->p_next)
+        {
+            h = spu_TextHashString(h, ruby->psz_base);
+            h = spu_TextHashString(h, ruby->psz_rt);
+        }
+    }
+    return h;
+}
+
+static subpicture_region_t *spu_TextCacheGet(spu_private_t *sys, uint64_t hash)
+{
+    vlc_mutex_assert(&sys->textlock);
+
+    for (size_t i = 0; i < ARRAY_SIZE(sys->text_cache); i++) {
+        struct spu_text_cache_entry *entry = &sys->text_cache[i];
+
+        if (entry->picture == NULL || entry->hash != hash)
+            continue;
+
+        subpicture_region_t *region =
+            subpicture_region_ForPicture(&entry->fmt, entry->picture);
+        if (unlikely(region == NULL))
+            return NULL;
+
+        region->b_absolute   = entry->b_absolute;
+        region->i_x          = entry->i_x;
+        region->i_y          = entry->i_y;
+        region->i_align      = entry->i_align;
+        region->i_alpha      = entry->i_alpha;
+        region->text_flags   = entry->text_flags;
+        region->i_max_width  = entry->i_max_width;
+        region->i_max_height = entry->i_max_height;
+
+        entry->age = ++sys->text_cache_age;
+        return region;
+    }
+    return NULL;
+}
+
+static void spu_TextCachePut(spu_private_t *sys, uint64_t hash,
+                             const subpicture_region_t *rendered)
+{
+    vlc_mutex_assert(&sys->textlock);
+
+    if (rendered->p_picture == NULL)
+        return;
+
+    /* Evict the least recently used entry */
+    struct spu_text_cache_entry *entry = &sys->text_cache[0];
+    for (size_t i = 1; i < ARRAY_SIZE(sys->text_cache); i++) {
+        if (sys->text_cache[i].picture == NULL) {
+            entry = &sys->text_cache[i];
+            break;
+        }
+        if (sys->text_cache[i].age < entry->age)
+            entry = &sys->text_cache[i];
+    }
+
+    if (entry->picture != NULL) {
+        picture_Release(entry->picture);
+        video_format_Clean(&entry->fmt);
+        entry->picture = NULL;
+    }
+
+    if (video_format_Copy(&entry->fmt, &rendered->fmt) != VLC_SUCCESS)
+        return;
+
+    entry->picture      = picture_Hold(rendered->p_picture);
+    entry->hash         = hash;
+    entry->age          = ++sys->text_cache_age;
+    entry->b_absolute   = rendered->b_absolute;
+    entry->i_x          = rendered->i_x;
+    entry->i_y          = rendered->i_y;
+    entry->i_align      = rendered->i_align;
+    entry->i_alpha      = rendered->i_alpha;
+    entry->text_flags   = rendered->text_flags;
+    entry->i_max_width  = rendered->i_max_width;
+    entry->i_max_height = rendered->i_max_height;
+}
+
+static void spu_TextCacheFlush(spu_private_t *sys)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(sys->text_cache); i++) {
+        struct spu_text_cache_entry *entry = &sys->text_cache[i];
+
+        if (entry->picture != NULL) {
+            picture_Release(entry->picture);
+            video_format_Clean(&entry->fmt);
+            entry->picture = NULL;
+        }
+    }
+}
+
 static subpicture_region_t *SpuRenderText(spu_t *spu,
                           const subpicture_region_t *region,
                           unsigned output_width,
@@ -409,7 +602,18 @@ static subpicture_region_t *SpuRenderText(spu_t *spu,
     if ( region->p_text == NULL )
         return NULL;
 
+    const uint64_t hash = spu_TextRegionHash(region, output_width,
+                                             output_height, chroma_list);
+
     vlc_mutex_lock(&sys->textlock);
+
+    subpicture_region_t *cached = spu_TextCacheGet(sys, hash);
+    if (cached != NULL)
+    {
+        vlc_mutex_unlock(&sys->textlock);
+        return cached;
+    }
+
     filter_t *text = sys->text;
     if(unlikely(text == NULL))
     {
@@ -428,6 +632,9 @@ static subpicture_region_t *SpuRenderText(spu_t *spu,
     subpicture_region_t *rendered_region = text->ops->render(text, region, chroma_list);
     assert(rendered_region == NULL || !subpicture_region_IsText(rendered_region));
 
+    if (rendered_region != NULL)
+        spu_TextCachePut(sys, hash, rendered_region);
+
     vlc_mutex_unlock(&sys->textlock);
     return rendered_region;
 }
@@ -1187,6 +1394,9 @@ static struct subpicture_region_rendered *SpuRenderRegion(spu_t *spu,
                 assert(picture == NULL || !picture_HasChainedPics(picture)); // no chaining
                 if (!picture)
                     msg_Err(spu, "scaling failed");
+                else
+                    atomic_fetch_add_explicit(&sys->stat_regions_scaled, 1,
+                                              memory_order_relaxed);
             }
 
             /* */
@@ -1257,12 +1467,16 @@ static struct subpicture_region_rendered *SpuRenderRegion(spu_t *spu,
     struct subpicture_region_rendered *dst = calloc(1, sizeof(*dst));
     if (unlikely(dst == NULL))
         return NULL;
+    /* The clone shares the pixel planes of the source (or cached scaled)
+     * picture: every display consuming this render reads the same buffers */
     dst->p_picture = picture_Clone(region_picture);
     if (unlikely(dst->p_picture == NULL))
     {
         free(dst);
         return NULL;
     }
+    atomic_fetch_add_explicit(&sys->stat_regions_output, 1,
+                              memory_order_relaxed);
     assert(region_fmt.i_x_offset + region_fmt.i_visible_width  <= dst->p_picture->format.i_width);
     assert(region_fmt.i_y_offset + region_fmt.i_visible_height <= dst->p_picture->format.i_height);
     dst->p_picture->format.i_x_offset       = region_fmt.i_x_offset;
@@ -1814,9 +2028,20 @@ static void spu_Cleanup(spu_t *spu)
 {
     spu_private_t *sys = spu->p;
 
+    uint64_t output = atomic_load_explicit(&sys->stat_regions_output,
+                                           memory_order_relaxed);
+    uint64_t scaled = atomic_load_explicit(&sys->stat_regions_scaled,
+                                           memory_order_relaxed);
+    if (output > 0)
+        msg_Dbg(spu, "rendered %"PRIu64" regions, %"PRIu64" shared without "
+                "pixel copy, %"PRIu64" scaled", output,
+                output > scaled ? output - scaled : 0, scaled);
+
     if (sys->text)
         vlc_filter_Delete(sys->text);
 
+    spu_TextCacheFlush(sys);
+
     if (sys->scale_yuvp)
         vlc_filter_Delete(sys->scale_yuvp);
 
@@ -1927,9 +2152,14 @@ spu_t *spu_Create(vlc_object_t *object, vout_thread_t *vout)
     sys->prerender.chroma_list[SPU_CHROMALIST_COUNT] = 0;
     sys->prerender.live = true;
 
+    atomic_init(&sys->stat_regions_output, 0);
+    atomic_init(&sys->stat_regions_scaled, 0);
+
     /* Load text and scale module */
     sys->text = SpuRenderCreateAndLoadText(spu);
     vlc_mutex_init(&sys->textlock);
+    memset(sys->text_cache, 0, sizeof (sys->text_cache));
+    sys->text_cache_age = 0;
 
     /* XXX spu->p_scale is used for all conversion/scaling except yuvp to
      * yuva/rgba */
@@ -1978,6 +2208,8 @@ void spu_Attach(spu_t *spu, input_thread_t *input)
         vlc_mutex_lock(&spu->p->textlock);
         if (spu->p->text)
             vlc_filter_Delete(spu->p->text);
+        /* Rendering settings may change with the renderer instance */
+        spu_TextCacheFlush(spu->p);
         spu->p->text = SpuRenderCreateAndLoadText(spu);
         vlc_mutex_unlock(&spu->p->textlock);
     }
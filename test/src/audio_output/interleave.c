@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * interleave.c: test and microbenchmark for audio (de)interleaving
+ *****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#undef NDEBUG
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vlc_common.h>
+#include <vlc_aout.h>
+#include <vlc_tick.h>
+
+/* Odd count on purpose, to exercise the vectorized paths and their
+ * scalar tails */
+#define SAMPLES  1021
+#define MAX_CHANS   8
+
+static const vlc_fourcc_t formats[] = {
+    VLC_CODEC_U8, VLC_CODEC_S16N, VLC_CODEC_FL32, VLC_CODEC_S32N,
+    VLC_CODEC_FL64,
+};
+
+static void test_roundtrip(vlc_fourcc_t fourcc, unsigned chans)
+{
+    size_t size = aout_BitsPerSample(fourcc) / 8;
+    unsigned char *planar = malloc(SAMPLES * chans * size);
+    unsigned char *ileaved = malloc(SAMPLES * chans * size);
+    unsigned char *back = malloc(SAMPLES * chans * size);
+    const void *srcv[MAX_CHANS];
+
+    assert(planar != NULL && ileaved != NULL && back != NULL);
+
+    for (size_t i = 0; i < SAMPLES * chans * size; i++)
+        planar[i] = i * 2654435761U >> 13;
+    for (unsigned c = 0; c < chans; c++)
+        srcv[c] = planar + c * SAMPLES * size;
+
+    aout_Interleave(ileaved, srcv, SAMPLES, chans, fourcc);
+
+    /* Spot-check the sample placement, independently of aout_Deinterleave() */
+    for (unsigned c = 0; c < chans; c++)
+        for (unsigned j = 0; j < SAMPLES; j += 97)
+            assert(memcmp(ileaved + (j * chans + c) * size,
+                          planar + (c * SAMPLES + j) * size, size) == 0);
+
+    aout_Deinterleave(back, ileaved, SAMPLES, chans, fourcc);
+    assert(memcmp(back, planar, SAMPLES * chans * size) == 0);
+
+    free(back);
+    free(ileaved);
+    free(planar);
+}
+
+static void bench(vlc_fourcc_t fourcc, unsigned chans, unsigned rounds)
+{
+    size_t size = aout_BitsPerSample(fourcc) / 8;
+    unsigned char *planar = malloc(SAMPLES * chans * size);
+    unsigned char *ileaved = malloc(SAMPLES * chans * size);
+    const void *srcv[MAX_CHANS];
+
+    assert(planar != NULL && ileaved != NULL);
+    memset(planar, 0x55, SAMPLES * chans * size);
+    for (unsigned c = 0; c < chans; c++)
+        srcv[c] = planar + c * SAMPLES * size;
+
+    vlc_tick_t start = vlc_tick_now();
+    for (unsigned i = 0; i < rounds; i++)
+        aout_Interleave(ileaved, srcv, SAMPLES, chans, fourcc);
+    vlc_tick_t mid = vlc_tick_now();
+    for (unsigned i = 0; i < rounds; i++)
+        aout_Deinterleave(planar, ileaved, SAMPLES, chans, fourcc);
+    vlc_tick_t end = vlc_tick_now();
+
+    printf("%4.4s %uch: interleave %5"PRId64" us, deinterleave %5"PRId64
+           " us (%u x %u samples)\n", (const char *)&fourcc, chans,
+           US_FROM_VLC_TICK(mid - start), US_FROM_VLC_TICK(end - mid),
+           rounds, SAMPLES);
+
+    free(ileaved);
+    free(planar);
+}
+
+int main(int argc, char *argv[])
+{
+    for (size_t f = 0; f < ARRAY_SIZE(formats); f++)
+        for (unsigned chans = 1; chans <= MAX_CHANS; chans++)
+            test_roundtrip(formats[f], chans);
+
+    /* Run with an argument for rough timing figures; correctness does not
+     * depend on it, so the benchmark stays out of the test suite runtime. */
+    if (argc > 1)
+    {
+        unsigned rounds = atoi(argv[1]) > 0 ? atoi(argv[1]) : 10000;
+
+        for (size_t f = 0; f < ARRAY_SIZE(formats); f++)
+        {
+            bench(formats[f], 2, rounds);
+            bench(formats[f], 6, rounds);
+        }
+    }
+    return 0;
+}
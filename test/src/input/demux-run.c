@@ -33,6 +33,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#if defined (__unix__) || defined (__APPLE__)
+# include <sys/resource.h>
+#endif
 
 #include <vlc_common.h>
 #include <vlc_access.h>
@@ -335,6 +339,289 @@ static int demux_process_stream(const struct vlc_run_args *args, stream_t *s)
     return val == VLC_DEMUXER_EOF ? 0 : -1;
 }
 
+/*****************************************************************************
+ * Replay benchmark
+ *****************************************************************************
+ * The sample is held in memory and demuxed once through a recording stream
+ * wrapper, capturing the demuxer's read/seek pattern and timing. The same
+ * input is then demuxed again at maximum speed: the wrapper checks that the
+ * access pattern replays identically (a demuxer over a memory stream is
+ * expected to be deterministic) while CPU time and allocations are sampled
+ * around every run. The delays observed while recording are summed into a
+ * virtual clock instead of being slept, so the report can relate the
+ * full-speed runs to the originally observed timing.
+ */
+
+struct trace_op
+{
+    unsigned char type; /* 'r' = read, 's' = seek */
+    uint64_t arg;       /* requested byte count, or seek target offset */
+    int64_t ret;        /* bytes read, or seek return value */
+};
+
+struct trace
+{
+    struct trace_op *ops;
+    size_t count;
+    size_t size;
+    bool recording;
+    bool oom;
+
+    size_t pos;          /* replay cursor */
+    size_t mismatches;
+
+    uint64_t reads;
+    uint64_t read_bytes;
+    uint64_t seeks;
+    vlc_tick_t last;     /* previous operation (while recording) */
+    vlc_tick_t recorded; /* virtual clock fed with the recorded delays */
+};
+
+static void trace_log(struct trace *t, unsigned char type, uint64_t arg,
+                      int64_t ret)
+{
+    if (t->recording)
+    {
+        vlc_tick_t now = vlc_tick_now();
+        t->recorded += now - t->last;
+        t->last = now;
+
+        if (type == 'r')
+        {
+            t->reads++;
+            if (ret > 0)
+                t->read_bytes += ret;
+        }
+        else
+            t->seeks++;
+
+        if (t->count == t->size)
+        {
+            size_t size = t->size ? t->size * 2 : 4096;
+            struct trace_op *ops = realloc(t->ops, size * sizeof (*ops));
+            if (ops == NULL)
+            {
+                t->oom = true;
+                return;
+            }
+            t->ops = ops;
+            t->size = size;
+        }
+        t->ops[t->count].type = type;
+        t->ops[t->count].arg = arg;
+        t->ops[t->count].ret = ret;
+        t->count++;
+    }
+    else
+    {
+        if (t->pos >= t->count
+         || t->ops[t->pos].type != type || t->ops[t->pos].arg != arg
+         || t->ops[t->pos].ret != ret)
+            t->mismatches++;
+        t->pos++;
+    }
+}
+
+struct bench_stream
+{
+    stream_t *inner;
+    struct trace *trace;
+};
+
+static ssize_t BenchStreamRead(stream_t *s, void *buf, size_t len)
+{
+    struct bench_stream *sys = s->p_sys;
+    ssize_t val = vlc_stream_Read(sys->inner, buf, len);
+
+    trace_log(sys->trace, 'r', len, val);
+    return val;
+}
+
+static int BenchStreamSeek(stream_t *s, uint64_t offset)
+{
+    struct bench_stream *sys = s->p_sys;
+    int val = vlc_stream_Seek(sys->inner, offset);
+
+    trace_log(sys->trace, 's', offset, val);
+    return val;
+}
+
+static int BenchStreamControl(stream_t *s, int query, va_list args)
+{
+    struct bench_stream *sys = s->p_sys;
+
+    return vlc_stream_vaControl(sys->inner, query, args);
+}
+
+static void BenchStreamDestroy(stream_t *s)
+{
+    struct bench_stream *sys = s->p_sys;
+
+    vlc_stream_Delete(sys->inner);
+    free(sys);
+}
+
+static stream_t *bench_stream_create(stream_t *inner, struct trace *trace)
+{
+    struct bench_stream *sys = malloc(sizeof (*sys));
+    if (sys == NULL)
+        return NULL;
+
+    sys->inner = inner;
+    sys->trace = trace;
+
+    stream_t *s = vlc_stream_CommonNew(vlc_object_parent(inner),
+                                       BenchStreamDestroy);
+    if (s == NULL)
+    {
+        free(sys);
+        return NULL;
+    }
+    s->pf_read = BenchStreamRead;
+    s->pf_seek = BenchStreamSeek;
+    s->pf_control = BenchStreamControl;
+    s->p_sys = sys;
+    return s;
+}
+
+static vlc_tick_t bench_cpu_time(void)
+{
+#if defined (CLOCK_PROCESS_CPUTIME_ID)
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0)
+        return vlc_tick_from_timespec(&ts);
+#endif
+    return 0;
+}
+
+static long bench_peak_rss_kib(void)
+{
+#if defined (__unix__) || defined (__APPLE__)
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return usage.ru_maxrss;
+#endif
+    return 0;
+}
+
+#define BENCH_MS(t) ((t) / (double)(CLOCK_FREQ / 1000))
+
+int vlc_demux_bench_path(const struct vlc_run_args *args, const char *path,
+                         const struct vlc_demux_bench *bench)
+{
+    /* Hold the whole sample in memory: page cache state would otherwise
+     * leak into the numbers */
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: cannot open %s\n", path);
+        return -1;
+    }
+
+    long length = fseek(f, 0, SEEK_END) == 0 ? ftell(f) : -1;
+    unsigned char *buf = length >= 0 ? malloc(length ? length : 1) : NULL;
+    rewind(f);
+    if (buf == NULL || fread(buf, 1, length, f) != (size_t)length)
+    {
+        fprintf(stderr, "Error: cannot read %s\n", path);
+        free(buf);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+
+    struct measure
+    {
+        vlc_tick_t wall;
+        vlc_tick_t cpu;
+        uint64_t allocs;
+    } *m = calloc(bench->runs + 1, sizeof (*m));
+
+    libvlc_instance_t *vlc = m != NULL ? libvlc_create(args) : NULL;
+    if (vlc == NULL)
+    {
+        free(m);
+        free(buf);
+        return -1;
+    }
+
+    struct trace trace = { .recording = true };
+    int ret = 0;
+
+    for (unsigned i = 0; ret == 0 && i <= bench->runs; i++)
+    {
+        trace.recording = (i == 0);
+        trace.pos = 0;
+        trace.last = vlc_tick_now();
+
+        stream_t *s = vlc_stream_MemoryNew(VLC_OBJECT(vlc->p_libvlc_int),
+                                           buf, length, true);
+        stream_t *ws = s != NULL ? bench_stream_create(s, &trace) : NULL;
+        if (ws == NULL)
+        {
+            if (s != NULL)
+                vlc_stream_Delete(s);
+            ret = -1;
+            break;
+        }
+
+        uint64_t allocs = bench->allocs != NULL ? bench->allocs() : 0;
+        vlc_tick_t cpu = bench_cpu_time();
+        vlc_tick_t wall = vlc_tick_now();
+
+        ret = demux_process_stream(args, ws);
+
+        m[i].wall = vlc_tick_now() - wall;
+        m[i].cpu = bench_cpu_time() - cpu;
+        m[i].allocs = (bench->allocs != NULL ? bench->allocs() : 0) - allocs;
+
+        if (i == 0 && trace.oom)
+        {
+            fprintf(stderr, "Error: out of memory recording the trace\n");
+            ret = -1;
+        }
+    }
+
+    if (ret == 0)
+    {
+        /* Best run: the least preempted one, the number worth tracking */
+        unsigned best = bench->runs ? 1 : 0;
+        for (unsigned i = best + 1; i <= bench->runs; i++)
+            if (m[i].cpu < m[best].cpu)
+                best = i;
+
+        fprintf(bench->json,
+                "{\"file\": \"%s\", \"demux\": \"%s\", \"bytes\": %ld,\n"
+                "  \"ops\": %zu, \"reads\": %" PRIu64
+                ", \"read_bytes\": %" PRIu64 ", \"seeks\": %" PRIu64 ",\n"
+                "  \"recorded_ms\": %.1f, \"replay_mismatches\": %zu,\n"
+                "  \"runs\": [",
+                path, args->name != NULL ? args->name : "any", length,
+                trace.count, trace.reads, trace.read_bytes, trace.seeks,
+                BENCH_MS(trace.recorded), trace.mismatches);
+
+        for (unsigned i = 1; i <= bench->runs; i++)
+            fprintf(bench->json, "%s\n    {\"wall_ms\": %.1f, "
+                    "\"cpu_ms\": %.1f, \"allocations\": %" PRIu64 "}",
+                    i > 1 ? "," : "",
+                    BENCH_MS(m[i].wall), BENCH_MS(m[i].cpu), m[i].allocs);
+
+        fprintf(bench->json, "],\n  \"cpu_ms_best\": %.1f, "
+                "\"speedup\": %.1f, \"peak_rss_kib\": %ld}\n",
+                BENCH_MS(m[best].cpu),
+                m[best].wall > 0 ? (double)trace.recorded / m[best].wall : 0.,
+                bench_peak_rss_kib());
+    }
+
+    libvlc_release(vlc);
+    free(trace.ops);
+    free(m);
+    free(buf);
+    return ret;
+}
+
 int vlc_demux_process_url(const struct vlc_run_args *args, const char *url)
 {
     libvlc_instance_t *vlc = libvlc_create(args);
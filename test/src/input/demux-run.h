@@ -28,6 +28,17 @@
 
 int vlc_demux_process_url(const struct vlc_run_args *, const char *url);
 int vlc_demux_process_path(const struct vlc_run_args *, const char *path);
+
+/* Replay benchmark (see vlc_demux_bench_path()) */
+struct vlc_demux_bench
+{
+    unsigned runs;            /* measured runs after the recording run */
+    uint64_t (*allocs)(void); /* process-wide allocation counter, or NULL */
+    FILE *json;               /* report destination */
+};
+
+int vlc_demux_bench_path(const struct vlc_run_args *, const char *path,
+                         const struct vlc_demux_bench *);
 int vlc_demux_process_memory(const struct vlc_run_args *,
                              const unsigned char *buf, size_t length);
 int libvlc_demux_process_memory(libvlc_instance_t *vlc,
@@ -0,0 +1,99 @@
+/*****************************************************************************
+ * arena.c: test for the region-based memory allocator
+ *****************************************************************************
+ * Copyright (C) 2026 the VideoLAN team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_arena.h>
+
+#include <assert.h>
+#include <stdalign.h>
+#include <string.h>
+
+#define CHUNK_SIZE 256
+#define ALLOC_COUNT 1000
+
+static void test_basic(void)
+{
+    vlc_arena_t *arena = vlc_arena_New(CHUNK_SIZE);
+    assert(arena != NULL);
+
+    /* many small allocations spanning several chunks, all aligned and
+     * non-overlapping */
+    unsigned *ptrs[ALLOC_COUNT];
+    for (unsigned i = 0; i < ALLOC_COUNT; i++)
+    {
+        ptrs[i] = vlc_arena_Alloc(arena, sizeof (unsigned) + i % 7);
+        assert(ptrs[i] != NULL);
+        assert(((uintptr_t)ptrs[i] % alignof (max_align_t)) == 0);
+        *ptrs[i] = i;
+    }
+    for (unsigned i = 0; i < ALLOC_COUNT; i++)
+        assert(*ptrs[i] == i);
+
+    vlc_arena_Delete(arena);
+}
+
+static void test_oversized(void)
+{
+    vlc_arena_t *arena = vlc_arena_New(CHUNK_SIZE);
+    assert(arena != NULL);
+
+    /* allocations larger than the chunk granularity must still succeed,
+     * without breaking smaller allocations around them */
+    char *small = vlc_arena_Alloc(arena, 16);
+    assert(small != NULL);
+    memset(small, 'a', 16);
+
+    char *big = vlc_arena_Alloc(arena, 4 * CHUNK_SIZE);
+    assert(big != NULL);
+    memset(big, 'b', 4 * CHUNK_SIZE);
+
+    char *after = vlc_arena_Alloc(arena, 16);
+    assert(after != NULL);
+    memset(after, 'c', 16);
+
+    for (size_t i = 0; i < 16; i++)
+        assert(small[i] == 'a');
+    for (size_t i = 0; i < 4 * CHUNK_SIZE; i++)
+        assert(big[i] == 'b');
+    for (size_t i = 0; i < 16; i++)
+        assert(after[i] == 'c');
+
+    vlc_arena_Delete(arena);
+}
+
+static void test_empty(void)
+{
+    /* deleting an arena with no allocation must be valid */
+    vlc_arena_t *arena = vlc_arena_New(CHUNK_SIZE);
+    assert(arena != NULL);
+    vlc_arena_Delete(arena);
+}
+
+int main(void)
+{
+    test_basic();
+    test_oversized();
+    test_empty();
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*****************************************************************************
+ * fifo_spsc.c: test for the lock-free SPSC frame FIFO
+ *****************************************************************************
+ * Copyright (C) 2026 the VideoLAN team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <vlc_common.h>
+#include <vlc_frame.h>
+
+#include <assert.h>
+
+#include "../../../src/misc/fifo_spsc.h"
+
+#define RING_CAPACITY 8
+#define STRESS_COUNT  100000
+
+static void test_single_thread(void)
+{
+    vlc_fifo_spsc_t *fifo = vlc_fifo_spsc_New(RING_CAPACITY);
+    assert(fifo != NULL);
+
+    assert(vlc_fifo_spsc_Count(fifo) == 0);
+    assert(vlc_fifo_spsc_Pop(fifo) == NULL);
+
+    for (size_t i = 0; i < RING_CAPACITY; i++)
+    {
+        vlc_frame_t *frame = vlc_frame_Alloc(1);
+        assert(frame != NULL);
+        frame->p_buffer[0] = i;
+        assert(vlc_fifo_spsc_Push(fifo, frame));
+    }
+    assert(vlc_fifo_spsc_Count(fifo) == RING_CAPACITY);
+
+    /* The ring is bounded: an extra push must be refused. */
+    vlc_frame_t *extra = vlc_frame_Alloc(1);
+    assert(extra != NULL);
+    assert(!vlc_fifo_spsc_Push(fifo, extra));
+    vlc_frame_Release(extra);
+
+    for (size_t i = 0; i < RING_CAPACITY; i++)
+    {
+        vlc_frame_t *frame = vlc_fifo_spsc_Pop(fifo);
+        assert(frame != NULL);
+        assert(frame->p_buffer[0] == i);
+        vlc_frame_Release(frame);
+    }
+    assert(vlc_fifo_spsc_Pop(fifo) == NULL);
+
+    /* Deletion must release still-queued frames. */
+    vlc_frame_t *leftover = vlc_frame_Alloc(1);
+    assert(leftover != NULL);
+    assert(vlc_fifo_spsc_Push(fifo, leftover));
+    vlc_fifo_spsc_Delete(fifo);
+}
+
+static void *producer_thread(void *opaque)
+{
+    vlc_fifo_spsc_t *fifo = opaque;
+
+    for (uint32_t i = 0; i < STRESS_COUNT;)
+    {
+        vlc_frame_t *frame = vlc_frame_Alloc(sizeof (uint32_t));
+        assert(frame != NULL);
+        memcpy(frame->p_buffer, &i, sizeof (i));
+
+        if (vlc_fifo_spsc_Push(fifo, frame))
+            i++;
+        else
+            vlc_frame_Release(frame);
+    }
+    return NULL;
+}
+
+static void test_two_threads(void)
+{
+    vlc_fifo_spsc_t *fifo = vlc_fifo_spsc_New(RING_CAPACITY);
+    assert(fifo != NULL);
+
+    vlc_thread_t producer;
+    int ret = vlc_clone(&producer, producer_thread, fifo);
+    assert(ret == 0);
+
+    for (uint32_t expected = 0; expected < STRESS_COUNT;)
+    {
+        vlc_frame_t *frame = vlc_fifo_spsc_Pop(fifo);
+        if (frame == NULL)
+            continue;
+
+        uint32_t value;
+        memcpy(&value, frame->p_buffer, sizeof (value));
+        assert(value == expected);
+        expected++;
+        vlc_frame_Release(frame);
+    }
+
+    vlc_join(producer, NULL);
+    assert(vlc_fifo_spsc_Count(fifo) == 0);
+    vlc_fifo_spsc_Delete(fifo);
+}
+
+int main(void)
+{
+    test_single_thread();
+    test_two_threads();
+    return 0;
+}
@@ -1266,6 +1266,42 @@ test_programs(struct ctx *ctx)
     test_end(ctx);
 }
 
+static void
+test_es_stress(struct ctx *ctx)
+{
+    test_log("es_stress\n");
+
+    vlc_player_t *player = ctx->player;
+    /* 100 programs of 2 tracks each: 200 ES total, stressing the es_out
+     * program lookups done for every PCR and group control */
+    struct media_params params = DEFAULT_MEDIA_PARAMS(VLC_TICK_FROM_SEC(100));
+    params.program_count = 100;
+    params.track_count[VIDEO_ES] = 1;
+    params.track_count[AUDIO_ES] = 1;
+    params.track_count[SPU_ES] = 0;
+    player_set_next_mock_media(ctx, "media1", &params);
+
+    player_start(ctx);
+
+    {
+        vec_on_program_list_changed *vec = &ctx->report.on_program_list_changed;
+        while (vec_on_program_list_get_action_count(vec, VLC_PLAYER_LIST_ADDED)
+               != params.program_count)
+            vlc_player_CondWait(player, &ctx->wait);
+    }
+    assert(vlc_player_GetProgramCount(player) == params.program_count);
+    for (size_t i = 0; i < params.program_count; ++i)
+    {
+        const struct vlc_player_program *prgm =
+            vlc_player_GetProgramAt(player, i);
+        assert(prgm);
+        assert(prgm == vlc_player_GetProgram(player, prgm->group_id));
+    }
+
+    test_prestop(ctx);
+    test_end(ctx);
+}
+
 static size_t
 vec_on_track_list_get_action_count(vec_on_track_list_changed *vec,
                                    enum vlc_player_list_action action)
@@ -3163,6 +3199,7 @@ main(void)
     test_tracks(&ctx, false);
     test_tracks_ids(&ctx);
     test_programs(&ctx);
+    test_es_stress(&ctx);
     test_timers(&ctx);
     test_teletext(&ctx);
     test_attachments(&ctx);
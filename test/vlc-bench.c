@@ -0,0 +1,446 @@
+/**
+ * @file vlc-bench.c
+ *
+ * Headless playback pipeline benchmark. Runs media samples through
+ * demux-only, demux+decode or full (decode + render to memory) scenarios
+ * at faster-than-realtime rate and reports throughput, frame time
+ * percentiles, allocations and peak RSS as machine-readable JSON, so that
+ * releases can be compared number-to-number instead of bisecting
+ * performance regressions by hand.
+ */
+/*****************************************************************************
+ * Copyright (C) 2026 VLC authors and VideoLAN
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston MA 02110-1301, USA.
+ *****************************************************************************/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+# include <sys/resource.h>
+#endif
+#include <unistd.h>
+
+#include <vlc/vlc.h>
+#include <vlc_common.h>
+#include <vlc_threads.h>
+
+/* Allocation accounting: glibc lets the executable preempt the allocator
+ * entry points, which is enough to count every allocation made by the
+ * whole process (core, plugins and this tool alike). The forwarding
+ * wrappers deliberately skip free() so only allocation events are
+ * counted. Other C runtimes simply report no allocation numbers. */
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t);
+extern void *__libc_calloc(size_t, size_t);
+extern void *__libc_realloc(void *, size_t);
+
+static _Atomic uint64_t alloc_count;
+
+void *malloc(size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+static uint64_t bench_alloc_count(void)
+{
+    return atomic_load_explicit(&alloc_count, memory_order_relaxed);
+}
+#else
+static uint64_t bench_alloc_count(void)
+{
+    return 0;
+}
+#endif
+
+enum bench_scenario
+{
+    BENCH_DEMUX,   /* demux only, no ES selected */
+    BENCH_DECODE,  /* demux + decode, pictures dropped by the dummy vout */
+    BENCH_FULL,    /* demux + decode + render into memory buffers */
+    BENCH_SCENARIO_COUNT
+};
+
+static const char *const scenario_names[BENCH_SCENARIO_COUNT] =
+    { "demux", "decode", "full" };
+
+struct bench_run
+{
+    vlc_sem_t done;
+    atomic_bool error;
+
+    /* vmem rendering for the full scenario */
+    unsigned char *buffer;
+    void *planes[3];
+
+    /* one libvlc_clock() sample per displayed frame */
+    int64_t *frame_times;
+    size_t i_frame_times;
+    size_t i_frame_times_size;
+    vlc_mutex_t frame_lock;
+};
+
+static void on_stopped(const struct libvlc_event_t *event, void *opaque)
+{
+    struct bench_run *run = opaque;
+    (void) event;
+    vlc_sem_post(&run->done);
+}
+
+static void on_error(const struct libvlc_event_t *event, void *opaque)
+{
+    struct bench_run *run = opaque;
+    (void) event;
+    atomic_store(&run->error, true);
+}
+
+/*****************************************************************************
+ * Full scenario: render into memory, timestamping every displayed frame
+ *****************************************************************************/
+
+static unsigned video_format_cb(void **opaque, char *chroma,
+                                unsigned *width, unsigned *height,
+                                unsigned *pitches, unsigned *lines)
+{
+    struct bench_run *run = *opaque;
+
+    /* Force planar 4:2:0: it matches most decoder output, keeping the
+     * conversion cost out of the measurement */
+    memcpy(chroma, "I420", 4);
+    pitches[0] = (*width + 31) & ~31;
+    pitches[1] = pitches[2] = ((*width + 1) / 2 + 31) & ~31;
+    lines[0] = (*height + 1) & ~1;
+    lines[1] = lines[2] = ((*height + 1) / 2 + 1) & ~1;
+
+    free(run->buffer);
+    run->buffer = malloc(pitches[0] * (size_t)lines[0] +
+                         2 * (pitches[1] * (size_t)lines[1]));
+    if (run->buffer == NULL)
+        return 0;
+    run->planes[0] = run->buffer;
+    run->planes[1] = run->buffer + pitches[0] * (size_t)lines[0];
+    run->planes[2] = (unsigned char *)run->planes[1]
+                   + pitches[1] * (size_t)lines[1];
+    return 1;
+}
+
+static void *video_lock_cb(void *opaque, void **planes)
+{
+    struct bench_run *run = opaque;
+    for (int i = 0; i < 3; i++)
+        planes[i] = run->planes[i];
+    return run;
+}
+
+static void video_display_cb(void *opaque, void *picture)
+{
+    struct bench_run *run = opaque;
+    (void) picture;
+
+    vlc_mutex_lock(&run->frame_lock);
+    if (run->i_frame_times == run->i_frame_times_size)
+    {
+        size_t size = run->i_frame_times_size ? run->i_frame_times_size * 2
+                                              : 512;
+        int64_t *times = realloc(run->frame_times, size * sizeof (*times));
+        if (times == NULL)
+        {
+            vlc_mutex_unlock(&run->frame_lock);
+            return;
+        }
+        run->frame_times = times;
+        run->i_frame_times_size = size;
+    }
+    run->frame_times[run->i_frame_times++] = libvlc_clock();
+    vlc_mutex_unlock(&run->frame_lock);
+}
+
+/*****************************************************************************
+ * Reporting
+ *****************************************************************************/
+
+static int cmp_int64(const void *a, const void *b)
+{
+    int64_t d = *(const int64_t *)a - *(const int64_t *)b;
+    return (d > 0) - (d < 0);
+}
+
+static double percentile(const int64_t *sorted, size_t count, double p)
+{
+    size_t idx = (size_t)(p * (count - 1));
+    return sorted[idx] / 1000.;
+}
+
+static long peak_rss_kib(void)
+{
+#ifdef HAVE_SYS_RESOURCE_H
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return usage.ru_maxrss;
+#endif
+    return 0;
+}
+
+static void report_run(FILE *out, const char *sample,
+                       enum bench_scenario scenario, float rate,
+                       int64_t elapsed_us, const libvlc_media_stats_t *stats,
+                       uint64_t allocs, struct bench_run *run, bool first)
+{
+    double elapsed_s = elapsed_us / 1e6;
+    uint64_t frames = stats->i_decoded_video;
+
+    fprintf(out, "%s{\"sample\": \"%s\", \"scenario\": \"%s\", "
+            "\"rate\": %.2f, \"error\": %s,\n"
+            "  \"wall_ms\": %.1f, \"demux_bytes\": %"PRIu64", "
+            "\"frames_decoded\": %"PRIu64", \"frames_displayed\": %"PRIu64", "
+            "\"frames_late\": %"PRIu64", \"frames_lost\": %"PRIu64",\n"
+            "  \"audio_buffers_played\": %"PRIu64", \"fps\": %.2f, "
+            "\"allocations\": %"PRIu64", \"allocations_per_frame\": %.1f, "
+            "\"peak_rss_kib\": %ld",
+            first ? "" : ",\n", sample, scenario_names[scenario],
+            rate, atomic_load(&run->error) ? "true" : "false",
+            elapsed_us / 1000., stats->i_demux_read_bytes,
+            stats->i_decoded_video, stats->i_displayed_pictures,
+            stats->i_late_pictures, stats->i_lost_pictures,
+            stats->i_played_abuffers,
+            elapsed_s > 0. ? frames / elapsed_s : 0.,
+            allocs, frames ? (double)allocs / frames : 0.,
+            peak_rss_kib());
+
+    if (run->i_frame_times >= 2)
+    {
+        size_t count = run->i_frame_times - 1;
+        int64_t *deltas = malloc(count * sizeof (*deltas));
+        if (deltas != NULL)
+        {
+            for (size_t i = 0; i < count; i++)
+                deltas[i] = run->frame_times[i + 1] - run->frame_times[i];
+            qsort(deltas, count, sizeof (*deltas), cmp_int64);
+            fprintf(out, ",\n  \"frame_ms\": {\"p50\": %.3f, \"p90\": %.3f, "
+                    "\"p99\": %.3f, \"max\": %.3f}",
+                    percentile(deltas, count, .50),
+                    percentile(deltas, count, .90),
+                    percentile(deltas, count, .99),
+                    deltas[count - 1] / 1000.);
+            free(deltas);
+        }
+    }
+    fprintf(out, "}");
+}
+
+/*****************************************************************************
+ * Benchmark driver
+ *****************************************************************************/
+
+static int bench_one(FILE *out, const char *sample,
+                     enum bench_scenario scenario, float rate, bool first)
+{
+    const char *argv[8];
+    int argc = 0;
+
+    argv[argc++] = "--ignore-config";
+    argv[argc++] = "--quiet";
+    argv[argc++] = "--vout=dummy";
+    argv[argc++] = "--aout=dummy";
+    if (scenario == BENCH_DEMUX)
+    {
+        argv[argc++] = "--no-video";
+        argv[argc++] = "--no-audio";
+        argv[argc++] = "--no-spu";
+    }
+
+    libvlc_instance_t *vlc = libvlc_new(argc, argv);
+    if (vlc == NULL)
+    {
+        fprintf(stderr, "Error: cannot initialize LibVLC.\n");
+        return -1;
+    }
+
+    libvlc_media_t *media = libvlc_media_new_path(sample);
+    if (media == NULL)
+    {
+        libvlc_release(vlc);
+        return -1;
+    }
+
+    libvlc_media_player_t *mp = libvlc_media_player_new_from_media(vlc, media);
+    if (mp == NULL)
+    {
+        libvlc_media_release(media);
+        libvlc_release(vlc);
+        return -1;
+    }
+
+    struct bench_run run = { .i_frame_times = 0 };
+    vlc_sem_init(&run.done, 0);
+    atomic_init(&run.error, false);
+    vlc_mutex_init(&run.frame_lock);
+
+    if (scenario == BENCH_FULL)
+    {
+        libvlc_video_set_callbacks(mp, video_lock_cb, NULL, video_display_cb,
+                                   &run);
+        libvlc_video_set_format_callbacks(mp, video_format_cb, NULL);
+    }
+
+    libvlc_event_manager_t *em = libvlc_media_player_event_manager(mp);
+    libvlc_event_attach(em, libvlc_MediaPlayerStopped, on_stopped, &run);
+    libvlc_event_attach(em, libvlc_MediaPlayerEncounteredError, on_error, &run);
+
+    libvlc_media_player_set_rate(mp, rate);
+
+    uint64_t allocs_before = bench_alloc_count();
+    int64_t start = libvlc_clock();
+
+    int ret = libvlc_media_player_play(mp);
+    if (ret == 0)
+        vlc_sem_wait(&run.done); /* natural end of stream or error */
+    else
+        atomic_store(&run.error, true);
+
+    int64_t elapsed_us = libvlc_clock() - start;
+    uint64_t allocs = bench_alloc_count() - allocs_before;
+
+    libvlc_media_stats_t stats;
+    memset(&stats, 0, sizeof (stats));
+    libvlc_media_get_stats(media, &stats);
+
+    report_run(out, sample, scenario, rate, elapsed_us, &stats, allocs, &run,
+               first);
+
+    libvlc_event_detach(em, libvlc_MediaPlayerStopped, on_stopped, &run);
+    libvlc_event_detach(em, libvlc_MediaPlayerEncounteredError, on_error, &run);
+    libvlc_media_player_release(mp);
+    libvlc_media_release(media);
+    libvlc_release(vlc);
+
+    free(run.frame_times);
+    free(run.buffer);
+
+    return atomic_load(&run.error) ? -1 : 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [-s demux|decode|full] [-r rate] [-o output.json] "
+            "<sample>...\n"
+            "Plays each sample headless and writes one JSON record per run.\n"
+            "Without -s, all scenarios are run. The playback rate defaults\n"
+            "to 8x; late/lost frame counts tell when a machine cannot keep\n"
+            "up and the rate needs lowering for comparable numbers.\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef TOP_BUILDDIR
+    setenv("VLC_PLUGIN_PATH", TOP_BUILDDIR"/modules", 1);
+    setenv("VLC_DATA_PATH", TOP_SRCDIR"/share", 1);
+#endif
+
+    int scenario = -1;
+    float rate = 8.f;
+    const char *output = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:r:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 's':
+                for (int i = 0; i < BENCH_SCENARIO_COUNT; i++)
+                    if (!strcmp(optarg, scenario_names[i]))
+                        scenario = i;
+                if (scenario == -1)
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'r':
+                rate = atof(optarg);
+                if (rate <= 0.f)
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return opt != 'h';
+        }
+    }
+
+    if (optind >= argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if (output != NULL)
+    {
+        out = fopen(output, "w");
+        if (out == NULL)
+        {
+            perror(output);
+            return 1;
+        }
+    }
+
+    fprintf(out, "[\n");
+
+    int ret = 0;
+    bool first = true;
+    for (int i = optind; i < argc; i++)
+    {
+        for (int s = 0; s < BENCH_SCENARIO_COUNT; s++)
+        {
+            if (scenario != -1 && scenario != s)
+                continue;
+            if (bench_one(out, argv[i], s, rate, first))
+                ret = 1;
+            first = false;
+        }
+    }
+
+    fprintf(out, "\n]\n");
+    if (out != stdout)
+        fclose(out);
+    return ret;
+}
@@ -28,24 +28,98 @@
 # include "config.h"
 #endif
 
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 #include "src/input/demux-run.h"
 
+/* Allocation accounting for the benchmark mode: glibc lets the executable
+ * preempt the allocator entry points, counting every allocation made in
+ * the process, plugins included. free() is deliberately not intercepted,
+ * only allocation events matter here. */
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t);
+extern void *__libc_calloc(size_t, size_t);
+extern void *__libc_realloc(void *, size_t);
+
+static _Atomic uint64_t alloc_count;
+
+void *malloc(size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+static uint64_t demux_run_allocs(void)
+{
+    return atomic_load_explicit(&alloc_count, memory_order_relaxed);
+}
+#define DEMUX_RUN_ALLOCS demux_run_allocs
+#else
+#define DEMUX_RUN_ALLOCS NULL
+#endif
+
 int main(int argc, char *argv[])
 {
-    const char *filename;
     struct vlc_run_args args;
     vlc_run_args_init(&args);
 
-    switch (argc)
+    bool benchmark = false;
+    unsigned runs = 4;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "bn:")) != -1)
+        switch (opt)
+        {
+            case 'b':
+                benchmark = true;
+                break;
+            case 'n':
+                runs = strtoul(optarg, NULL, 10);
+                if (runs == 0)
+                    goto usage;
+                benchmark = true;
+                break;
+            default:
+                goto usage;
+        }
+
+    if (optind + 1 != argc)
+        goto usage;
+
+    if (benchmark)
     {
-        case 2:
-            filename = argv[argc - 1];
-            break;
-        default:
-            fprintf(stderr, "Usage: [VLC_TARGET=demux] %s <filename>\n", argv[0]);
-            return 1;
+        struct vlc_demux_bench bench = {
+            .runs = runs,
+            .allocs = DEMUX_RUN_ALLOCS,
+            .json = stdout,
+        };
+        return -vlc_demux_bench_path(&args, argv[optind], &bench);
     }
 
-    return -vlc_demux_process_path(&args, filename);
+    return -vlc_demux_process_path(&args, argv[optind]);
+
+usage:
+    fprintf(stderr,
+            "Usage: [VLC_TARGET=demux] %s [-b [-n runs]] <filename>\n"
+            "  -b  benchmark: record the demuxer's access pattern, replay\n"
+            "      it at full speed and report CPU, allocations and peak\n"
+            "      memory as JSON\n"
+            "  -n  number of measured replay runs (default 4, implies -b)\n",
+            argv[0]);
+    return 1;
 }